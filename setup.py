@@ -2,6 +2,7 @@
 
 """
 import os
+import sys
 from distutils.sysconfig import get_config_vars
 from distutils.util import convert_path
 from setuptools import find_packages, setup
@@ -54,6 +55,10 @@ links = []
 if int(os.environ.get('PY_USEOMP', 0)):
     options.append('-fopenmp')
     links.append('-fopenmp')
+if int(os.environ.get('PY_USEZLIB', 0)):
+    links.append('-lz')
+if int(os.environ.get('PY_USEZSTD', 0)):
+    links.append('-lzstd')
 
 # Suppress irrelevant compiler warnings.
 config_vars = get_config_vars()
@@ -89,6 +94,10 @@ self_macros = [
 if int(os.environ.get('PY_USEOMP', 0)):
     self_macros.append(('TRV_USE_OMP', None))
     self_macros.append(('TRV_USE_FFTWOMP', None))
+if int(os.environ.get('PY_USEZLIB', 0)):
+    self_macros.append(('TRV_USE_ZLIB', None))
+if int(os.environ.get('PY_USEZSTD', 0)):
+    self_macros.append(('TRV_USE_ZSTD', None))
 if int(os.environ.get('PY_DBGPARS', 0)):
     self_macros.append(('DBG_MODE', None))
     self_macros.append(('DBG_PARS', None))
@@ -99,6 +108,56 @@ npy_macros = [
 
 macros = self_macros + npy_macros
 
+# Build the program monitor (which holds process-wide state, e.g. the
+# FFTW planner lock) once as a shared library loaded by all extension
+# modules, instead of duplicating it in each of them.
+monitor_lib = 'trvmonitor'
+monitor_src = os.path.join(self_modulesrc, "monitor.cpp")
+
+if sys.platform == 'darwin':
+    monitor_links = ['-Wl,-rpath,@loader_path',]
+else:
+    monitor_links = ['-Wl,-rpath,$ORIGIN',]
+
+
+class BuildExt(build_ext):
+    """Build extension modules after the shared program monitor library.
+
+    """
+
+    def build_extensions(self):
+        # Place the library next to the extension modules (also for
+        # in-place builds).
+        libdir = os.path.dirname(
+            self.get_ext_fullpath(f'{pkgdir}.parameters')
+        )
+        libfile = self.compiler.library_filename(monitor_lib, 'shared')
+
+        lib_links = list(links)
+        if sys.platform == 'darwin':
+            lib_links.append(f'-Wl,-install_name,@rpath/{libfile}')
+
+        objects = self.compiler.compile(
+            [monitor_src,],
+            output_dir=self.build_temp,
+            macros=macros,
+            include_dirs=includes,
+            extra_postargs=options + ['-fPIC',],
+        )
+        self.compiler.link_shared_object(
+            objects, libfile,
+            output_dir=libdir,
+            libraries=libraries,
+            extra_postargs=lib_links,
+            target_lang=language,
+        )
+
+        for ext in self.extensions:
+            ext.library_dirs.append(libdir)
+
+        super().build_extensions()
+
+
 # Define extension modules.
 modules = [
     Extension(
@@ -106,12 +165,12 @@ modules = [
         sources=[
             os.path.join(pkgdir, "parameters.pyx"),
             os.path.join(self_modulesrc, "parameters.cpp"),
-            os.path.join(self_modulesrc, "monitor.cpp"),
         ],
         language=language,
         extra_compile_args=options,
-        extra_link_args=links,
+        extra_link_args=links + monitor_links,
         include_dirs=includes,
+        libraries=[monitor_lib,],
         define_macros=macros,
     ),
     Extension(
@@ -120,12 +179,12 @@ modules = [
             os.path.join(pkgdir, "dataobjs.pyx"),
             os.path.join(self_modulesrc, "dataobjs.cpp"),
             os.path.join(self_modulesrc, "parameters.cpp"),
-            os.path.join(self_modulesrc, "monitor.cpp"),
         ],
         language=language,
         extra_compile_args=options,
-        extra_link_args=links,
+        extra_link_args=links + monitor_links,
         include_dirs=includes,
+        libraries=[monitor_lib,],
         define_macros=macros,
     ),
     Extension(
@@ -133,12 +192,12 @@ modules = [
         sources=[
             os.path.join(pkgdir, "_particles.pyx"),
             os.path.join(self_modulesrc, "particles.cpp"),
-            os.path.join(self_modulesrc, "monitor.cpp"),
         ],
         language=language,
         extra_compile_args=options,
-        extra_link_args=links,
+        extra_link_args=links + monitor_links,
         include_dirs=includes,
+        libraries=[monitor_lib,],
         define_macros=macros,
     ),
     Extension(
@@ -146,7 +205,6 @@ modules = [
         sources=[
             os.path.join(pkgdir, "_twopt.pyx"),
             os.path.join(self_modulesrc, "twopt.cpp"),
-            os.path.join(self_modulesrc, "monitor.cpp"),
             os.path.join(self_modulesrc, "maths.cpp"),
             os.path.join(self_modulesrc, "parameters.cpp"),
             os.path.join(self_modulesrc, "dataobjs.cpp"),
@@ -155,9 +213,9 @@ modules = [
         ],
         language=language,
         extra_compile_args=options,
-        extra_link_args=links,
+        extra_link_args=links + monitor_links,
         include_dirs=includes,
-        libraries=libraries,
+        libraries=[monitor_lib,] + libraries,
         define_macros=macros,
     ),
     Extension(
@@ -165,7 +223,6 @@ modules = [
         sources=[
             os.path.join(pkgdir, "_threept.pyx"),
             os.path.join(self_modulesrc, "threept.cpp"),
-            os.path.join(self_modulesrc, "monitor.cpp"),
             os.path.join(self_modulesrc, "maths.cpp"),
             os.path.join(self_modulesrc, "parameters.cpp"),
             os.path.join(self_modulesrc, "dataobjs.cpp"),
@@ -175,9 +232,27 @@ modules = [
         ],
         language=language,
         extra_compile_args=options,
-        extra_link_args=links,
+        extra_link_args=links + monitor_links,
+        include_dirs=includes,
+        libraries=[monitor_lib,] + libraries,
+        define_macros=macros,
+    ),
+    Extension(
+        f'{pkgdir}.field',
+        sources=[
+            os.path.join(pkgdir, "field.pyx"),
+            os.path.join(self_modulesrc, "field.cpp"),
+            os.path.join(self_modulesrc, "maths.cpp"),
+            os.path.join(self_modulesrc, "parameters.cpp"),
+            os.path.join(self_modulesrc, "dataobjs.cpp"),
+            os.path.join(self_modulesrc, "particles.cpp"),
+            os.path.join(self_modulesrc, "twopt.cpp"),
+        ],
+        language=language,
+        extra_compile_args=options,
+        extra_link_args=links + monitor_links,
         include_dirs=includes,
-        libraries=libraries,
+        libraries=[monitor_lib,] + libraries,
         define_macros=macros,
     ),
     Extension(
@@ -185,15 +260,14 @@ modules = [
         sources=[
             os.path.join(pkgdir, "_fftlog.pyx"),
             os.path.join(self_modulesrc, "fftlog.cpp"),
-            os.path.join(self_modulesrc, "monitor.cpp"),
             os.path.join(self_modulesrc, "maths.cpp"),
             os.path.join(self_modulesrc, "arrayops.cpp"),
         ],
         language=language,
         extra_compile_args=options,
-        extra_link_args=links,
+        extra_link_args=links + monitor_links,
         include_dirs=includes,
-        libraries=libraries,
+        libraries=[monitor_lib,] + libraries,
         define_macros=macros,
     ),
 ]
@@ -226,7 +300,7 @@ setup(
     python_requires='>=3.6',
     install_requires=requirements,
     packages=find_packages(),
-    cmdclass={'build_ext': build_ext},
+    cmdclass={'build_ext': BuildExt},
     ext_modules=cythonize(
         modules,
         language_level='3',
@@ -5,6 +5,10 @@ FFTLog algorithm (:mod:`~triumvirate._fftlog`)
 Implementation of the FFTLog algorithm for Hankel-related transforms.
 
 """
+from libcpp cimport bool as bool_t
+from libcpp.string cimport string
+from libcpp.vector cimport vector
+
 import numpy as np
 cimport numpy as np
 
@@ -28,6 +32,37 @@ cdef extern from "include/fftlog.hpp":
             int ell, int N, double* r, double* xi, double* k, double* pk
         )
 
+    void transform_bispec_to_3pcf_cpp "trv::transform_bispec_to_3pcf" (
+        int ell1, int ell2, int N, double* k, double* bk,
+        int N_ext, const string& extrap, double* r, double* zeta
+    ) except + nogil
+
+    void transform_3pcf_to_bispec_cpp "trv::transform_3pcf_to_bispec" (
+        int ell1, int ell2, int N, double* r, double* zeta,
+        int N_ext, const string& extrap, double* k, double* bk
+    ) except + nogil
+
+    cdef cppclass CppHankelTransformer "trv::maths::HankelTransformer":
+        double mu
+        double q
+        int N
+        double L
+        double kr_c
+        vector[double] r
+        vector[double] k
+
+        CppHankelTransformer(
+            double mu, double q, double kr_c, int N, bool_t lowring,
+            const double* r
+        ) except +
+
+        void transform(
+            int nbatch, const np.complex128_t* a, np.complex128_t* b
+        ) nogil
+        void sj_transform(
+            double n, int nbatch, const double* a, double* b
+        ) nogil
+
 
 def sj_transform(
         int ell, int m, int N,
@@ -83,3 +118,178 @@ def trans_corrfunc_to_powspec_multipole(
     )
 
     return k, pk
+
+
+def trans_bispec_to_3pcf(
+        int ell1, int ell2,
+        np.ndarray[double, ndim=1, mode='c'] k not None,
+        np.ndarray[double, ndim=2, mode='c'] bk not None,
+        int n_ext=0, extrap='zero'
+    ):
+    cdef int N = k.shape[0]
+    cdef int N_samp = N + 2 * n_ext
+    cdef string extrap_ = extrap.encode('utf-8')
+
+    if bk.shape[0] != N or bk.shape[1] != N:
+        raise ValueError("Bispectrum samples must be a square 2-d array.")
+
+    cdef np.ndarray[double, ndim=1, mode='c'] r = np.zeros(N_samp)
+    cdef np.ndarray[double, ndim=2, mode='c'] zeta = \
+        np.zeros((N_samp, N_samp))
+
+    with nogil:
+        transform_bispec_to_3pcf_cpp(
+            ell1, ell2, N, &k[0], &bk[0, 0], n_ext, extrap_,
+            &r[0], &zeta[0, 0]
+        )
+
+    return r, zeta
+
+
+def trans_3pcf_to_bispec(
+        int ell1, int ell2,
+        np.ndarray[double, ndim=1, mode='c'] r not None,
+        np.ndarray[double, ndim=2, mode='c'] zeta not None,
+        int n_ext=0, extrap='zero'
+    ):
+    cdef int N = r.shape[0]
+    cdef int N_samp = N + 2 * n_ext
+    cdef string extrap_ = extrap.encode('utf-8')
+
+    if zeta.shape[0] != N or zeta.shape[1] != N:
+        raise ValueError("3PCF samples must be a square 2-d array.")
+
+    cdef np.ndarray[double, ndim=1, mode='c'] k = np.zeros(N_samp)
+    cdef np.ndarray[double, ndim=2, mode='c'] bk = \
+        np.zeros((N_samp, N_samp))
+
+    with nogil:
+        transform_3pcf_to_bispec_cpp(
+            ell1, ell2, N, &r[0], &zeta[0, 0], n_ext, extrap_,
+            &k[0], &bk[0, 0]
+        )
+
+    return k, bk
+
+
+cdef class HankelTransformer:
+    """Hankel transformer with precomputed FFTLog kernel and plans.
+
+    For repeated transforms with the same order, bias index and
+    pre-transform sample points, the kernel coefficients, post-transform
+    sample points and FFT plans are computed once on construction.
+
+    Parameters
+    ----------
+    mu : float
+        Order of the Hankel transform.
+    q : float
+        FFTLog power-law bias index.
+    x : 1-d array of float
+        Pre-transform sample points (log-linearly spaced).
+    kr_c : float, optional
+        (Initial) pivot value (default is 1.).
+    lowring : bool, optional
+        Low-ringing condition (default is `True`).
+
+    Attributes
+    ----------
+    N : int
+        Sample number.
+    y : 1-d array of float
+        Post-transform sample points.
+
+    Notes
+    -----
+    The transform ``sj_transform(ell, m, N, x, fx)`` is equivalent to
+    ``HankelTransformer(ell + 1./2, 0., x).sj_transform(m, fx)``.
+
+    """
+
+    cdef CppHankelTransformer* thisptr
+
+    def __cinit__(self, double mu, double q,
+                  const double[::1] x not None,
+                  double kr_c=1., bool_t lowring=True):
+        if x.shape[0] < 2:
+            raise ValueError("At least two sample points are required.")
+
+        self.thisptr = new CppHankelTransformer(
+            mu, q, kr_c, x.shape[0], lowring, &x[0]
+        )
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    @property
+    def N(self):
+        return self.thisptr.N
+
+    @property
+    def y(self):
+        return np.array(self.thisptr.k)
+
+    def _as_batch(self, fx, dtype):
+        a = np.ascontiguousarray(np.atleast_2d(fx), dtype=dtype)
+        if a.ndim != 2 or a.shape[1] != self.thisptr.N or a.shape[0] == 0:
+            raise ValueError(
+                "Pre-transform samples must be a 1-d array or a batch "
+                "of 1-d arrays of the sample number."
+            )
+        return a
+
+    def transform(self, fx):
+        """Perform the (forward) Hankel transform.
+
+        Parameters
+        ----------
+        fx : (N,) or (nbatch, N) array of complex
+            Pre-transform sample values (or a batch of them).
+
+        Returns
+        -------
+        y : (N,) array of float
+            Post-transform sample points.
+        gy : (N,) or (nbatch, N) array of complex
+            Post-transform sample values (or a batch of them).
+
+        """
+        cdef np.ndarray[np.complex128_t, ndim=2, mode='c'] a = \
+            self._as_batch(fx, complex)
+        cdef np.ndarray[np.complex128_t, ndim=2, mode='c'] b = \
+            np.empty_like(a)
+        cdef int nbatch = a.shape[0]
+
+        with nogil:
+            self.thisptr.transform(nbatch, &a[0, 0], &b[0, 0])
+
+        return self.y, (b if np.ndim(fx) == 2 else b[0])
+
+    def sj_transform(self, double n, fx):
+        """Perform the (forward) spherical Fourier--Bessel transform
+        of order ``mu - 1/2`` (for ``q = 0``).
+
+        Parameters
+        ----------
+        n : float
+            Dimensional power-law index.
+        fx : (N,) or (nbatch, N) array of float
+            Pre-transform sample values (or a batch of them).
+
+        Returns
+        -------
+        y : (N,) array of float
+            Post-transform sample points.
+        gy : (N,) or (nbatch, N) array of float
+            Post-transform sample values (or a batch of them).
+
+        """
+        cdef np.ndarray[double, ndim=2, mode='c'] a = \
+            self._as_batch(fx, float)
+        cdef np.ndarray[double, ndim=2, mode='c'] b = np.empty_like(a)
+        cdef int nbatch = a.shape[0]
+
+        with nogil:
+            self.thisptr.sj_transform(n, nbatch, &a[0, 0], &b[0, 0])
+
+        return self.y, (b if np.ndim(fx) == 2 else b[0])
@@ -2,14 +2,18 @@
 data-loading method.
 
 """
+from libcpp.string cimport string
 from libcpp.vector cimport vector
 
 
 cdef extern from "include/particles.hpp":
     cdef cppclass CppParticleCatalogue "trv::ParticleCatalogue":
+        int ntotal
+        double pos_observer[3]
+
         CppParticleCatalogue()
 
-        # int initialise_particles(const int num)
+        void initialise_particles(const int num) except +
         # int finalise_particles()
 
         int load_particle_data(
@@ -17,6 +21,19 @@ cdef extern from "include/particles.hpp":
             vector[double] nz, vector[double] ws, vector[double] wc
         ) except +
 
+        int load_particle_data(
+            const double* x, const double* y, const double* z,
+            const double* nz, const double* ws, const double* wc,
+            const int num
+        ) except +
+
+        int load_particle_data_column(
+            const string& name, const double* values, const int num
+        ) except +
+
+        void calc_wtotal() except +
+        void calc_pos_min_and_max()
+
 
 cdef class _ParticleCatalogue:
     cdef CppParticleCatalogue* thisptr
@@ -5,26 +5,102 @@ Catalogue Parser (:mod:`~triumvirate._particles`)
 Parse Python catalogue objects into C++ particle catalogues.
 
 """
-cimport numpy as np
+import numpy as np
 
 from ._particles cimport CppParticleCatalogue
 
 
 cdef class _ParticleCatalogue:
 
-    def __cinit__(
+    def __cinit__(self, *args, **kwargs):
+        self.thisptr = new CppParticleCatalogue()
+
+    def __init__(
         self,
-        np.ndarray[double, ndim=1, mode='c'] x not None,
-        np.ndarray[double, ndim=1, mode='c'] y not None,
-        np.ndarray[double, ndim=1, mode='c'] z not None,
-        np.ndarray[double, ndim=1, mode='c'] nz not None,
-        np.ndarray[double, ndim=1, mode='c'] ws not None,
-        np.ndarray[double, ndim=1, mode='c'] wc not None
+        const double[::1] x not None,
+        const double[::1] y not None,
+        const double[::1] z not None,
+        const double[::1] nz not None,
+        const double[::1] ws not None,
+        const double[::1] wc not None,
+        observer=None
     ):
+        cdef int num = x.shape[0]
+        if not (
+            y.shape[0] == num and z.shape[0] == num
+            and nz.shape[0] == num and ws.shape[0] == num
+            and wc.shape[0] == num
+        ):
+            raise ValueError(
+                "Inconsistent particle data dimensions (source=extdata)."
+            )
+        if num == 0:
+            raise ValueError("Number of particles is non-positive.")
 
-        self.thisptr = new CppParticleCatalogue()
+        # Pass the buffers through without intermediate copies.
+        self.thisptr.load_particle_data(
+            &x[0], &y[0], &z[0], &nz[0], &ws[0], &wc[0], num
+        )
+
+        self._set_observer(observer)
+
+    @classmethod
+    def _from_columns(cls, int num, get_column, observer=None):
+        """Construct from particle data columns read in one at a time.
+
+        Each column is converted to contiguous double precision only
+        if needed, and released once read in, so that at most one
+        converted column is held alongside the particle data.
+
+        Parameters
+        ----------
+        num : int
+            Number of particles.
+        get_column : callable
+            Function returning a particle data column by name
+            (one of 'x', 'y', 'z', 'nz', 'ws' and 'wc').
+        observer : array-like of float, optional
+            Observer position in the particle coordinates.
+
+        Returns
+        -------
+        :class:`~triumvirate._particles._ParticleCatalogue`
+            C++-wrapped catalogue.
+
+        """
+        cdef _ParticleCatalogue self
+        cdef const double[::1] column
+
+        if num <= 0:
+            raise ValueError("Number of particles is non-positive.")
+
+        self = cls.__new__(cls)
+        self.thisptr.initialise_particles(num)
+
+        # NOTE: 'ws' is read in before 'wc' to set the overall weights.
+        for name in ('x', 'y', 'z', 'nz', 'ws', 'wc'):
+            column = np.ascontiguousarray(get_column(name), dtype=float)
+            if column.shape[0] != num:
+                raise ValueError(
+                    "Inconsistent particle data dimensions (source=extdata)."
+                )
+            self.thisptr.load_particle_data_column(
+                name.encode('utf-8'), &column[0], num
+            )
+            column = None
+
+        self.thisptr.calc_wtotal()
+        self.thisptr.calc_pos_min_and_max()
+
+        self._set_observer(observer)
+
+        return self
 
-        self.thisptr.load_particle_data(x, y, z, nz, ws, wc)
+    def _set_observer(self, observer):
+        # Set the observer position in the particle coordinates.
+        if observer is not None:
+            for iaxis in range(3):
+                self.thisptr.pos_observer[iaxis] = observer[iaxis]
 
     def __dealloc__(self):
         del self.thisptr
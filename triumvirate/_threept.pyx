@@ -6,7 +6,6 @@ Declaration and wrapping of three-point statistic algorithms.
 
 """
 from cython.operator cimport dereference as deref
-from libc.stdlib cimport free, malloc
 from libcpp cimport bool as bool_t
 
 import numpy as np
@@ -16,12 +15,15 @@ from triumvirate._particles cimport CppParticleCatalogue, _ParticleCatalogue
 from triumvirate.dataobjs cimport (
     Binning, CppBinning,
     LineOfSight,
+    GlobalLineOfSight, RadialLineOfSight, StoredLineOfSight,
     BispecMeasurements, ThreePCFMeasurements, ThreePCFWindowMeasurements
 )
 from triumvirate.parameters cimport CppParameterSet, ParameterSet
 
+from triumvirate.dataobjs import _parse_los_spec
 
-cdef extern from "include/threept.hpp":
+
+cdef extern from "include/threept.hpp" nogil:
     # --------------------------------------------------------------------
     # Normalisation
     # --------------------------------------------------------------------
@@ -31,7 +33,7 @@ cdef extern from "include/threept.hpp":
             CppParticleCatalogue& catalogue,
             CppParameterSet& params,
             double alpha
-        )
+        ) except +
 
     double calc_bispec_normalisation_from_particles_cpp \
         "trv::calc_bispec_normalisation_from_particles" (
@@ -44,25 +46,25 @@ cdef extern from "include/threept.hpp":
     # Full statistics
     # --------------------------------------------------------------------
 
-    BispecMeasurements compute_bispec_cpp "trv::compute_bispec" (
+    BispecMeasurements compute_bispec_cpp "trv::compute_bispec" [LoSPolicy](
         CppParticleCatalogue& particles_data,
         CppParticleCatalogue& particles_rand,
-        LineOfSight* los_data,
-        LineOfSight* los_rand,
+        LoSPolicy los_data,
+        LoSPolicy los_rand,
         CppParameterSet& params,
         CppBinning& kbinning,
         double norm_factor
-    )
+    ) except +
 
-    ThreePCFMeasurements compute_3pcf_cpp "trv::compute_3pcf" (
+    ThreePCFMeasurements compute_3pcf_cpp "trv::compute_3pcf" [LoSPolicy](
         CppParticleCatalogue& particles_data,
         CppParticleCatalogue& particles_rand,
-        LineOfSight* los_data,
-        LineOfSight* los_rand,
+        LoSPolicy los_data,
+        LoSPolicy los_rand,
         CppParameterSet& params,
         CppBinning& rbinning,
         double norm_factor
-    )
+    ) except +
 
     BispecMeasurements compute_bispec_in_gpp_box_cpp \
         "trv::compute_bispec_in_gpp_box" (
@@ -70,7 +72,7 @@ cdef extern from "include/threept.hpp":
             CppParameterSet& params,
             CppBinning& kbinning,
             double norm_factor
-        )
+        ) except +
 
     ThreePCFMeasurements compute_3pcf_in_gpp_box_cpp \
         "trv::compute_3pcf_in_gpp_box" (
@@ -78,18 +80,18 @@ cdef extern from "include/threept.hpp":
             CppParameterSet& params,
             CppBinning& rbinning,
             double norm_factor
-        )
+        ) except +
 
     ThreePCFWindowMeasurements compute_3pcf_window_cpp \
-        "trv::compute_3pcf_window" (
+        "trv::compute_3pcf_window" [LoSPolicy](
             CppParticleCatalogue& particles_rand,
-            LineOfSight* los_rand,
+            LoSPolicy los_rand,
             CppParameterSet& params,
             CppBinning& rbinning,
             double alpha,
             double norm_factor,
             bool_t wide_angle
-        )
+        ) except +
 
     # BispecMeasurements compute_bispec_for_los_choice_cpp \
     #     "trv::compute_bispec_for_los_choice" (
@@ -109,55 +111,78 @@ def _calc_bispec_normalisation_from_mesh(
         ParameterSet params not None,
         double alpha
     ):
-    return calc_bispec_normalisation_from_mesh_cpp(
-        deref(catalogue.thisptr), deref(params.thisptr), alpha
-    )
+    cdef double norm_factor
+    with nogil:
+        norm_factor = calc_bispec_normalisation_from_mesh_cpp(
+            deref(catalogue.thisptr), deref(params.thisptr), alpha
+        )
+    return norm_factor
 
 
 def _calc_bispec_normalisation_from_particles(
         _ParticleCatalogue catalogue not None, double alpha
     ):
-    return calc_bispec_normalisation_from_particles_cpp(
-        deref(catalogue.thisptr), alpha
-    )
+    cdef double norm_factor
+    with nogil:
+        norm_factor = calc_bispec_normalisation_from_particles_cpp(
+            deref(catalogue.thisptr), alpha
+        )
+    return norm_factor
 
 
 def _compute_bispec(
         _ParticleCatalogue particles_data not None,
         _ParticleCatalogue particles_rand not None,
-        np.ndarray[double, ndim=2, mode='c'] los_data not None,
-        np.ndarray[double, ndim=2, mode='c'] los_rand not None,
+        los_data,
+        los_rand,
         ParameterSet params not None,
         Binning kbinning not None,
         double norm_factor
     ):
-    # Parse lines of sight per particle.
-    cdef LineOfSight* los_data_cpp = <LineOfSight*>malloc(
-        len(los_data) * sizeof(LineOfSight)
-    )
-    for pid, (los_x, los_y, los_z) in enumerate(los_data):
-        los_data_cpp[pid].pos[0] = los_x
-        los_data_cpp[pid].pos[1] = los_y
-        los_data_cpp[pid].pos[2] = los_z
-
-    cdef LineOfSight* los_rand_cpp = <LineOfSight*>malloc(
-        len(los_rand) * sizeof(LineOfSight)
-    )
-    for pid, (los_x, los_y, los_z) in enumerate(los_rand):
-        los_rand_cpp[pid].pos[0] = los_x
-        los_rand_cpp[pid].pos[1] = los_y
-        los_rand_cpp[pid].pos[2] = los_z
+    # Parse lines of sight into a line-of-sight policy.
+    cdef double[::1] los_data_axis, los_rand_axis
+    cdef double[:, ::1] los_data_arr, los_rand_arr
+
+    los_type, (los_data, los_rand) = _parse_los_spec(los_data, los_rand)
 
     # Run algorithm.
     cdef BispecMeasurements results
-    results = compute_bispec_cpp(
-        deref(particles_data.thisptr), deref(particles_rand.thisptr),
-        los_data_cpp, los_rand_cpp,
-        deref(params.thisptr), deref(kbinning.thisptr),
-        norm_factor
-    )
-
-    free(los_data_cpp); free(los_rand_cpp)
+    if los_type == 'radial':
+        with nogil:
+            results = compute_bispec_cpp[RadialLineOfSight](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                RadialLineOfSight(particles_data.thisptr.pos_observer),
+                RadialLineOfSight(particles_rand.thisptr.pos_observer),
+                deref(params.thisptr), deref(kbinning.thisptr),
+                norm_factor
+            )
+    elif los_type == 'global':
+        los_data_axis, los_rand_axis = los_data, los_rand
+        with nogil:
+            results = compute_bispec_cpp[GlobalLineOfSight](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                GlobalLineOfSight(&los_data_axis[0]),
+                GlobalLineOfSight(&los_rand_axis[0]),
+                deref(params.thisptr), deref(kbinning.thisptr),
+                norm_factor
+            )
+    else:
+        los_data_arr, los_rand_arr = los_data, los_rand
+        if (
+            los_data_arr.shape[0] != particles_data.thisptr.ntotal
+            or los_rand_arr.shape[0] != particles_rand.thisptr.ntotal
+        ):
+            raise ValueError(
+                "Lines of sight do not match the catalogue sizes."
+            )
+        with nogil:
+            results = compute_bispec_cpp[StoredLineOfSight](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                StoredLineOfSight(<LineOfSight*>&los_data_arr[0, 0]),
+                StoredLineOfSight(<LineOfSight*>&los_rand_arr[0, 0]),
+                deref(params.thisptr), deref(kbinning.thisptr),
+                norm_factor
+            )
 
     return {
         'k1bin': np.array(results.k1bin),
@@ -173,39 +198,56 @@ def _compute_bispec(
 def _compute_3pcf(
         _ParticleCatalogue particles_data not None,
         _ParticleCatalogue particles_rand not None,
-        np.ndarray[double, ndim=2, mode='c'] los_data not None,
-        np.ndarray[double, ndim=2, mode='c'] los_rand not None,
+        los_data,
+        los_rand,
         ParameterSet params not None,
         Binning rbinning not None,
         double norm_factor
     ):
-    # Parse lines of sight per particle.
-    cdef LineOfSight* los_data_cpp = <LineOfSight*>malloc(
-        len(los_data) * sizeof(LineOfSight)
-    )
-    for pid, (los_x, los_y, los_z) in enumerate(los_data):
-        los_data_cpp[pid].pos[0] = los_x
-        los_data_cpp[pid].pos[1] = los_y
-        los_data_cpp[pid].pos[2] = los_z
-
-    cdef LineOfSight* los_rand_cpp = <LineOfSight*>malloc(
-        len(los_rand) * sizeof(LineOfSight)
-    )
-    for pid, (los_x, los_y, los_z) in enumerate(los_rand):
-        los_rand_cpp[pid].pos[0] = los_x
-        los_rand_cpp[pid].pos[1] = los_y
-        los_rand_cpp[pid].pos[2] = los_z
+    # Parse lines of sight into a line-of-sight policy.
+    cdef double[::1] los_data_axis, los_rand_axis
+    cdef double[:, ::1] los_data_arr, los_rand_arr
+
+    los_type, (los_data, los_rand) = _parse_los_spec(los_data, los_rand)
 
     # Run algorithm.
     cdef ThreePCFMeasurements results
-    results = compute_3pcf_cpp(
-        deref(particles_data.thisptr), deref(particles_rand.thisptr),
-        los_data_cpp, los_rand_cpp,
-        deref(params.thisptr), deref(rbinning.thisptr),
-        norm_factor
-    )
-
-    free(los_data_cpp); free(los_rand_cpp)
+    if los_type == 'radial':
+        with nogil:
+            results = compute_3pcf_cpp[RadialLineOfSight](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                RadialLineOfSight(particles_data.thisptr.pos_observer),
+                RadialLineOfSight(particles_rand.thisptr.pos_observer),
+                deref(params.thisptr), deref(rbinning.thisptr),
+                norm_factor
+            )
+    elif los_type == 'global':
+        los_data_axis, los_rand_axis = los_data, los_rand
+        with nogil:
+            results = compute_3pcf_cpp[GlobalLineOfSight](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                GlobalLineOfSight(&los_data_axis[0]),
+                GlobalLineOfSight(&los_rand_axis[0]),
+                deref(params.thisptr), deref(rbinning.thisptr),
+                norm_factor
+            )
+    else:
+        los_data_arr, los_rand_arr = los_data, los_rand
+        if (
+            los_data_arr.shape[0] != particles_data.thisptr.ntotal
+            or los_rand_arr.shape[0] != particles_rand.thisptr.ntotal
+        ):
+            raise ValueError(
+                "Lines of sight do not match the catalogue sizes."
+            )
+        with nogil:
+            results = compute_3pcf_cpp[StoredLineOfSight](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                StoredLineOfSight(<LineOfSight*>&los_data_arr[0, 0]),
+                StoredLineOfSight(<LineOfSight*>&los_rand_arr[0, 0]),
+                deref(params.thisptr), deref(rbinning.thisptr),
+                norm_factor
+            )
 
     return {
         'r1bin': np.array(results.r1bin),
@@ -225,11 +267,12 @@ def _compute_bispec_in_gpp_box(
         double norm_factor
     ):
     cdef BispecMeasurements results
-    results = compute_bispec_in_gpp_box_cpp(
-        deref(particles_data.thisptr),
-        deref(params.thisptr), deref(kbinning.thisptr),
-        norm_factor
-    )
+    with nogil:
+        results = compute_bispec_in_gpp_box_cpp(
+            deref(particles_data.thisptr),
+            deref(params.thisptr), deref(kbinning.thisptr),
+            norm_factor
+        )
 
     return {
         'k1bin': np.array(results.k1bin),
@@ -249,11 +292,12 @@ def _compute_3pcf_in_gpp_box(
         double norm_factor
     ):
     cdef ThreePCFMeasurements results
-    results = compute_3pcf_in_gpp_box_cpp(
-        deref(particles_data.thisptr),
-        deref(params.thisptr), deref(rbinning.thisptr),
-        norm_factor
-    )
+    with nogil:
+        results = compute_3pcf_in_gpp_box_cpp(
+            deref(particles_data.thisptr),
+            deref(params.thisptr), deref(rbinning.thisptr),
+            norm_factor
+        )
 
     return {
         'r1bin': np.array(results.r1bin),
@@ -268,32 +312,54 @@ def _compute_3pcf_in_gpp_box(
 
 def _compute_3pcf_window(
         _ParticleCatalogue particles_rand not None,
-        np.ndarray[double, ndim=2, mode='c'] los_rand not None,
+        los_rand,
         ParameterSet params not None,
         Binning rbinning not None,
         double alpha,
         double norm_factor,
         bool_t wide_angle
     ):
-    # Parse lines of sight per particle.
-    cdef LineOfSight* los_rand_cpp = <LineOfSight*>malloc(
-        len(los_rand) * sizeof(LineOfSight)
-    )
-    for pid, (los_x, los_y, los_z) in enumerate(los_rand):
-        los_rand_cpp[pid].pos[0] = los_x
-        los_rand_cpp[pid].pos[1] = los_y
-        los_rand_cpp[pid].pos[2] = los_z
+    # Parse lines of sight into a line-of-sight policy.
+    cdef double[::1] los_rand_axis
+    cdef double[:, ::1] los_rand_arr
+
+    los_type, (los_rand,) = _parse_los_spec(los_rand)
 
     # Run algorithm.
     cdef ThreePCFWindowMeasurements results
-    results = compute_3pcf_window_cpp(
-        deref(particles_rand.thisptr), los_rand_cpp,
-        deref(params.thisptr), deref(rbinning.thisptr),
-        alpha, norm_factor,
-        wide_angle
-    )
-
-    free(los_rand_cpp)
+    if los_type == 'radial':
+        with nogil:
+            results = compute_3pcf_window_cpp[RadialLineOfSight](
+                deref(particles_rand.thisptr),
+                RadialLineOfSight(particles_rand.thisptr.pos_observer),
+                deref(params.thisptr), deref(rbinning.thisptr),
+                alpha, norm_factor,
+                wide_angle
+            )
+    elif los_type == 'global':
+        los_rand_axis = los_rand
+        with nogil:
+            results = compute_3pcf_window_cpp[GlobalLineOfSight](
+                deref(particles_rand.thisptr),
+                GlobalLineOfSight(&los_rand_axis[0]),
+                deref(params.thisptr), deref(rbinning.thisptr),
+                alpha, norm_factor,
+                wide_angle
+            )
+    else:
+        los_rand_arr = los_rand
+        if los_rand_arr.shape[0] != particles_rand.thisptr.ntotal:
+            raise ValueError(
+                "Lines of sight do not match the catalogue size."
+            )
+        with nogil:
+            results = compute_3pcf_window_cpp[StoredLineOfSight](
+                deref(particles_rand.thisptr),
+                StoredLineOfSight(<LineOfSight*>&los_rand_arr[0, 0]),
+                deref(params.thisptr), deref(rbinning.thisptr),
+                alpha, norm_factor,
+                wide_angle
+            )
 
     return {
         'r1bin': np.array(results.r1bin),
@@ -6,7 +6,7 @@ Declaration and wrapping of two-point statistic algorithms.
 
 """
 from cython.operator cimport dereference as deref
-from libc.stdlib cimport free, malloc
+from libcpp.vector cimport vector
 
 import numpy as np
 cimport numpy as np
@@ -15,12 +15,16 @@ from triumvirate._particles cimport CppParticleCatalogue, _ParticleCatalogue
 from triumvirate.dataobjs cimport (
     Binning, CppBinning,
     LineOfSight,
-    PowspecMeasurements, TwoPCFMeasurements, TwoPCFWindowMeasurements
+    GlobalLineOfSight, RadialLineOfSight, StoredLineOfSight,
+    PowspecMeasurements, PowspecWedgeMeasurements,
+    TwoPCFMeasurements, TwoPCFWindowMeasurements
 )
 from triumvirate.parameters cimport CppParameterSet, ParameterSet
 
+from triumvirate.dataobjs import _parse_los_spec
 
-cdef extern from "include/twopt.hpp":
+
+cdef extern from "include/twopt.hpp" nogil:
     # --------------------------------------------------------------------
     # Normalisation
     # --------------------------------------------------------------------
@@ -30,7 +34,7 @@ cdef extern from "include/twopt.hpp":
             CppParticleCatalogue& catalogue,
             CppParameterSet& params,
             double alpha
-        )
+        ) except +
 
     double calc_powspec_normalisation_from_particles_cpp \
         "trv::calc_powspec_normalisation_from_particles" (
@@ -43,33 +47,57 @@ cdef extern from "include/twopt.hpp":
     # Full statistics
     # --------------------------------------------------------------------
 
-    PowspecMeasurements compute_powspec_cpp "trv::compute_powspec" (
+    PowspecMeasurements compute_powspec_cpp "trv::compute_powspec" [LoSPolicy](
         CppParticleCatalogue& particles_data,
         CppParticleCatalogue& particles_rand,
-        LineOfSight* los_data,
-        LineOfSight* los_rand,
+        LoSPolicy los_data,
+        LoSPolicy los_rand,
         CppParameterSet& params,
         CppBinning& kbinning,
-        double norm_factor
-    )
+        double norm_factor,
+        PowspecWedgeMeasurements* wedges_out
+    ) except +
 
-    TwoPCFMeasurements compute_corrfunc_cpp "trv::compute_corrfunc" (
+    vector[PowspecMeasurements] compute_powspec_multipoles_cpp \
+        "trv::compute_powspec_multipoles" [LoSPolicy](
+            CppParticleCatalogue& particles_data,
+            CppParticleCatalogue& particles_rand,
+            LoSPolicy los_data,
+            LoSPolicy los_rand,
+            CppParameterSet& params,
+            vector[int]& ells,
+            CppBinning& kbinning,
+            double norm_factor
+        ) except +
+
+    TwoPCFMeasurements compute_corrfunc_cpp "trv::compute_corrfunc" [LoSPolicy](
         CppParticleCatalogue& particles_data,
         CppParticleCatalogue& particles_rand,
-        LineOfSight* los_data,
-        LineOfSight* los_rand,
+        LoSPolicy los_data,
+        LoSPolicy los_rand,
         CppParameterSet& params,
         CppBinning& rbinning,
         double norm_factor
-    )
+    ) except +
 
     PowspecMeasurements compute_powspec_in_gpp_box_cpp \
         "trv::compute_powspec_in_gpp_box" (
             CppParticleCatalogue& particles_data,
             CppParameterSet& params,
             CppBinning& kbinning,
-            double norm_factor
-        )
+            double norm_factor,
+            PowspecWedgeMeasurements* wedges_out
+        ) except +
+
+    vector[PowspecMeasurements] compute_powspec_multipoles_in_gpp_box_cpp \
+        "trv::compute_powspec_multipoles_in_gpp_box" (
+            CppParticleCatalogue& particles_data,
+            CppParameterSet& params,
+            vector[int]& ells,
+            CppBinning& kbinning,
+            double norm_factor,
+            PowspecWedgeMeasurements* wedges_out
+        ) except +
 
     TwoPCFMeasurements compute_corrfunc_in_gpp_box_cpp \
         "trv::compute_corrfunc_in_gpp_box" (
@@ -77,17 +105,29 @@ cdef extern from "include/twopt.hpp":
             CppParameterSet& params,
             CppBinning& rbinning,
             double norm_factor
-        )
+        ) except +
 
     TwoPCFWindowMeasurements compute_corrfunc_window_cpp \
-        "trv::compute_corrfunc_window" (
+        "trv::compute_corrfunc_window" [LoSPolicy](
             CppParticleCatalogue& particles_rand,
-            LineOfSight* los_rand,
+            LoSPolicy los_rand,
             CppParameterSet& params,
             CppBinning& rbinning,
             double alpha,
             double norm_factor
-        )
+        ) except +
+
+
+cdef dict _convert_powspec_wedges(PowspecWedgeMeasurements& wedges):
+    return {
+        'kbin': np.array(wedges.kbin),
+        'mubin': np.array(wedges.mubin),
+        'keff': np.array(wedges.keff),
+        'mueff': np.array(wedges.mueff),
+        'nmodes': np.array(wedges.nmodes),
+        'pk_raw': np.array(wedges.pk_raw),
+        'pk_shot': np.array(wedges.pk_shot),
+    }
 
 
 def _calc_powspec_normalisation_from_mesh(
@@ -95,101 +135,219 @@ def _calc_powspec_normalisation_from_mesh(
         ParameterSet params not None,
         double alpha
     ):
-    return calc_powspec_normalisation_from_mesh_cpp(
-        deref(catalogue.thisptr), deref(params.thisptr), alpha
-    )
+    cdef double norm_factor
+    with nogil:
+        norm_factor = calc_powspec_normalisation_from_mesh_cpp(
+            deref(catalogue.thisptr), deref(params.thisptr), alpha
+        )
+    return norm_factor
 
 
 def _calc_powspec_normalisation_from_particles(
         _ParticleCatalogue catalogue not None, double alpha
     ):
-    return calc_powspec_normalisation_from_particles_cpp(
-        deref(catalogue.thisptr), alpha
-    )
+    cdef double norm_factor
+    with nogil:
+        norm_factor = calc_powspec_normalisation_from_particles_cpp(
+            deref(catalogue.thisptr), alpha
+        )
+    return norm_factor
 
 
 def _compute_powspec(
         _ParticleCatalogue particles_data not None,
         _ParticleCatalogue particles_rand not None,
-        np.ndarray[double, ndim=2, mode='c'] los_data not None,
-        np.ndarray[double, ndim=2, mode='c'] los_rand not None,
+        los_data,
+        los_rand,
         ParameterSet params not None,
         Binning kbinning not None,
         double norm_factor
     ):
-    # Parse lines of sight per particle.
-    cdef LineOfSight* los_data_cpp = <LineOfSight*>malloc(
-        len(los_data) * sizeof(LineOfSight)
-    )
-    for pid, (los_x, los_y, los_z) in enumerate(los_data):
-        los_data_cpp[pid].pos[0] = los_x
-        los_data_cpp[pid].pos[1] = los_y
-        los_data_cpp[pid].pos[2] = los_z
-
-    cdef LineOfSight* los_rand_cpp = <LineOfSight*>malloc(
-        len(los_rand) * sizeof(LineOfSight)
-    )
-    for pid, (los_x, los_y, los_z) in enumerate(los_rand):
-        los_rand_cpp[pid].pos[0] = los_x
-        los_rand_cpp[pid].pos[1] = los_y
-        los_rand_cpp[pid].pos[2] = los_z
-
-    # Run algorithm.
-    cdef PowspecMeasurements results
-    results = compute_powspec_cpp(
-        deref(particles_data.thisptr), deref(particles_rand.thisptr),
-        los_data_cpp, los_rand_cpp,
-        deref(params.thisptr), deref(kbinning.thisptr),
-        norm_factor
-    )
+    # Parse lines of sight into a line-of-sight policy.
+    cdef double[::1] los_data_axis, los_rand_axis
+    cdef double[:, ::1] los_data_arr, los_rand_arr
 
-    free(los_data_cpp); free(los_rand_cpp)
+    los_type, (los_data, los_rand) = _parse_los_spec(los_data, los_rand)
 
-    return {
+    # Run algorithm, with wedges measured with respect to a global line
+    # of sight if requested.
+    cdef PowspecMeasurements results
+    cdef PowspecWedgeMeasurements wedges
+    cdef PowspecWedgeMeasurements* wedges_out = NULL
+    if los_type == 'global' and params.thisptr.num_mu_bins > 0:
+        wedges_out = &wedges
+
+    if los_type == 'radial':
+        with nogil:
+            results = compute_powspec_cpp[RadialLineOfSight](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                RadialLineOfSight(particles_data.thisptr.pos_observer),
+                RadialLineOfSight(particles_rand.thisptr.pos_observer),
+                deref(params.thisptr), deref(kbinning.thisptr),
+                norm_factor, wedges_out
+            )
+    elif los_type == 'global':
+        los_data_axis, los_rand_axis = los_data, los_rand
+        with nogil:
+            results = compute_powspec_cpp[GlobalLineOfSight](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                GlobalLineOfSight(&los_data_axis[0]),
+                GlobalLineOfSight(&los_rand_axis[0]),
+                deref(params.thisptr), deref(kbinning.thisptr),
+                norm_factor, wedges_out
+            )
+    else:
+        los_data_arr, los_rand_arr = los_data, los_rand
+        if (
+            los_data_arr.shape[0] != particles_data.thisptr.ntotal
+            or los_rand_arr.shape[0] != particles_rand.thisptr.ntotal
+        ):
+            raise ValueError(
+                "Lines of sight do not match the catalogue sizes."
+            )
+        with nogil:
+            results = compute_powspec_cpp[StoredLineOfSight](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                StoredLineOfSight(<LineOfSight*>&los_data_arr[0, 0]),
+                StoredLineOfSight(<LineOfSight*>&los_rand_arr[0, 0]),
+                deref(params.thisptr), deref(kbinning.thisptr),
+                norm_factor, wedges_out
+            )
+
+    measurements = {
         'kbin': np.array(results.kbin),
         'keff': np.array(results.keff),
         'nmodes': np.array(results.nmodes),
         'pk_raw': np.array(results.pk_raw),
         'pk_shot': np.array(results.pk_shot),
     }
+    if wedges_out != NULL:
+        measurements['wedges'] = _convert_powspec_wedges(wedges)
+
+    return measurements
+
+
+def _compute_powspec_multipoles(
+        _ParticleCatalogue particles_data not None,
+        _ParticleCatalogue particles_rand not None,
+        los_data,
+        los_rand,
+        ParameterSet params not None,
+        degrees,
+        Binning kbinning not None,
+        double norm_factor
+    ):
+    # Parse lines of sight into a line-of-sight policy.
+    cdef double[::1] los_data_axis, los_rand_axis
+    cdef double[:, ::1] los_data_arr, los_rand_arr
+
+    los_type, (los_data, los_rand) = _parse_los_spec(los_data, los_rand)
+
+    # Run algorithm.
+    cdef vector[int] ells = list(degrees)
+    cdef vector[PowspecMeasurements] results
+    if los_type == 'radial':
+        with nogil:
+            results = compute_powspec_multipoles_cpp[RadialLineOfSight](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                RadialLineOfSight(particles_data.thisptr.pos_observer),
+                RadialLineOfSight(particles_rand.thisptr.pos_observer),
+                deref(params.thisptr), ells, deref(kbinning.thisptr),
+                norm_factor
+            )
+    elif los_type == 'global':
+        los_data_axis, los_rand_axis = los_data, los_rand
+        with nogil:
+            results = compute_powspec_multipoles_cpp[GlobalLineOfSight](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                GlobalLineOfSight(&los_data_axis[0]),
+                GlobalLineOfSight(&los_rand_axis[0]),
+                deref(params.thisptr), ells, deref(kbinning.thisptr),
+                norm_factor
+            )
+    else:
+        los_data_arr, los_rand_arr = los_data, los_rand
+        if (
+            los_data_arr.shape[0] != particles_data.thisptr.ntotal
+            or los_rand_arr.shape[0] != particles_rand.thisptr.ntotal
+        ):
+            raise ValueError(
+                "Lines of sight do not match the catalogue sizes."
+            )
+        with nogil:
+            results = compute_powspec_multipoles_cpp[StoredLineOfSight](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                StoredLineOfSight(<LineOfSight*>&los_data_arr[0, 0]),
+                StoredLineOfSight(<LineOfSight*>&los_rand_arr[0, 0]),
+                deref(params.thisptr), ells, deref(kbinning.thisptr),
+                norm_factor
+            )
+
+    return {
+        ell: {
+            'kbin': np.array(results[iell].kbin),
+            'keff': np.array(results[iell].keff),
+            'nmodes': np.array(results[iell].nmodes),
+            'pk_raw': np.array(results[iell].pk_raw),
+            'pk_shot': np.array(results[iell].pk_shot),
+        }
+        for iell, ell in enumerate(ells)
+    }
 
 
 def _compute_corrfunc(
         _ParticleCatalogue particles_data not None,
         _ParticleCatalogue particles_rand not None,
-        np.ndarray[double, ndim=2, mode='c'] los_data not None,
-        np.ndarray[double, ndim=2, mode='c'] los_rand not None,
+        los_data,
+        los_rand,
         ParameterSet params not None,
         Binning rbinning not None,
         double norm_factor
     ):
-    # Parse lines of sight per particle.
-    cdef LineOfSight* los_data_cpp = <LineOfSight*>malloc(
-        len(los_data) * sizeof(LineOfSight)
-    )
-    for pid, (los_x, los_y, los_z) in enumerate(los_data):
-        los_data_cpp[pid].pos[0] = los_x
-        los_data_cpp[pid].pos[1] = los_y
-        los_data_cpp[pid].pos[2] = los_z
-
-    cdef LineOfSight* los_rand_cpp = <LineOfSight*>malloc(
-        len(los_rand) * sizeof(LineOfSight)
-    )
-    for pid, (los_x, los_y, los_z) in enumerate(los_rand):
-        los_rand_cpp[pid].pos[0] = los_x
-        los_rand_cpp[pid].pos[1] = los_y
-        los_rand_cpp[pid].pos[2] = los_z
+    # Parse lines of sight into a line-of-sight policy.
+    cdef double[::1] los_data_axis, los_rand_axis
+    cdef double[:, ::1] los_data_arr, los_rand_arr
+
+    los_type, (los_data, los_rand) = _parse_los_spec(los_data, los_rand)
 
     # Run algorithm.
     cdef TwoPCFMeasurements results
-    results = compute_corrfunc_cpp(
-        deref(particles_data.thisptr), deref(particles_rand.thisptr),
-        los_data_cpp, los_rand_cpp,
-        deref(params.thisptr), deref(rbinning.thisptr),
-        norm_factor
-    )
-
-    free(los_data_cpp); free(los_rand_cpp)
+    if los_type == 'radial':
+        with nogil:
+            results = compute_corrfunc_cpp[RadialLineOfSight](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                RadialLineOfSight(particles_data.thisptr.pos_observer),
+                RadialLineOfSight(particles_rand.thisptr.pos_observer),
+                deref(params.thisptr), deref(rbinning.thisptr),
+                norm_factor
+            )
+    elif los_type == 'global':
+        los_data_axis, los_rand_axis = los_data, los_rand
+        with nogil:
+            results = compute_corrfunc_cpp[GlobalLineOfSight](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                GlobalLineOfSight(&los_data_axis[0]),
+                GlobalLineOfSight(&los_rand_axis[0]),
+                deref(params.thisptr), deref(rbinning.thisptr),
+                norm_factor
+            )
+    else:
+        los_data_arr, los_rand_arr = los_data, los_rand
+        if (
+            los_data_arr.shape[0] != particles_data.thisptr.ntotal
+            or los_rand_arr.shape[0] != particles_rand.thisptr.ntotal
+        ):
+            raise ValueError(
+                "Lines of sight do not match the catalogue sizes."
+            )
+        with nogil:
+            results = compute_corrfunc_cpp[StoredLineOfSight](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                StoredLineOfSight(<LineOfSight*>&los_data_arr[0, 0]),
+                StoredLineOfSight(<LineOfSight*>&los_rand_arr[0, 0]),
+                deref(params.thisptr), deref(rbinning.thisptr),
+                norm_factor
+            )
 
     return {
         'rbin': np.array(results.rbin),
@@ -206,19 +364,66 @@ def _compute_powspec_in_gpp_box(
         double norm_factor
     ):
     cdef PowspecMeasurements results
-    results = compute_powspec_in_gpp_box_cpp(
-        deref(particles_data.thisptr),
-        deref(params.thisptr), deref(kbinning.thisptr),
-        norm_factor
-    )
+    cdef PowspecWedgeMeasurements wedges
+    cdef PowspecWedgeMeasurements* wedges_out = NULL
+    if params.thisptr.num_mu_bins > 0:
+        wedges_out = &wedges
+
+    with nogil:
+        results = compute_powspec_in_gpp_box_cpp(
+            deref(particles_data.thisptr),
+            deref(params.thisptr), deref(kbinning.thisptr),
+            norm_factor, wedges_out
+        )
 
-    return {
+    measurements = {
         'kbin': np.array(results.kbin),
         'keff': np.array(results.keff),
         'nmodes': np.array(results.nmodes),
         'pk_raw': np.array(results.pk_raw),
         'pk_shot': np.array(results.pk_shot),
     }
+    if wedges_out != NULL:
+        measurements['wedges'] = _convert_powspec_wedges(wedges)
+
+    return measurements
+
+
+def _compute_powspec_multipoles_in_gpp_box(
+        _ParticleCatalogue particles_data not None,
+        ParameterSet params not None,
+        degrees,
+        Binning kbinning not None,
+        double norm_factor
+    ):
+    cdef vector[int] ells = list(degrees)
+    cdef vector[PowspecMeasurements] results
+    cdef PowspecWedgeMeasurements wedges
+    cdef PowspecWedgeMeasurements* wedges_out = NULL
+    if params.thisptr.num_mu_bins > 0:
+        wedges_out = &wedges
+
+    with nogil:
+        results = compute_powspec_multipoles_in_gpp_box_cpp(
+            deref(particles_data.thisptr),
+            deref(params.thisptr), ells, deref(kbinning.thisptr),
+            norm_factor, wedges_out
+        )
+
+    measurements = {
+        ell: {
+            'kbin': np.array(results[iell].kbin),
+            'keff': np.array(results[iell].keff),
+            'nmodes': np.array(results[iell].nmodes),
+            'pk_raw': np.array(results[iell].pk_raw),
+            'pk_shot': np.array(results[iell].pk_shot),
+        }
+        for iell, ell in enumerate(ells)
+    }
+    if wedges_out != NULL:
+        measurements['wedges'] = _convert_powspec_wedges(wedges)
+
+    return measurements
 
 
 def _compute_corrfunc_in_gpp_box(
@@ -228,11 +433,12 @@ def _compute_corrfunc_in_gpp_box(
         double norm_factor
     ):
     cdef TwoPCFMeasurements results
-    results = compute_corrfunc_in_gpp_box_cpp(
-        deref(particles_data.thisptr),
-        deref(params.thisptr), deref(rbinning.thisptr),
-        norm_factor
-    )
+    with nogil:
+        results = compute_corrfunc_in_gpp_box_cpp(
+            deref(particles_data.thisptr),
+            deref(params.thisptr), deref(rbinning.thisptr),
+            norm_factor
+        )
 
     return {
         'rbin': np.array(results.rbin),
@@ -244,30 +450,50 @@ def _compute_corrfunc_in_gpp_box(
 
 def _compute_corrfunc_window(
         _ParticleCatalogue particles_rand not None,
-        np.ndarray[double, ndim=2, mode='c'] los_rand not None,
+        los_rand,
         ParameterSet params not None,
         Binning rbinning not None,
         double alpha,
         double norm_factor
     ):
-    # Parse lines of sight per particle.
-    cdef LineOfSight* los_rand_cpp = <LineOfSight*>malloc(
-        len(los_rand) * sizeof(LineOfSight)
-    )
-    for pid, (los_x, los_y, los_z) in enumerate(los_rand):
-        los_rand_cpp[pid].pos[0] = los_x
-        los_rand_cpp[pid].pos[1] = los_y
-        los_rand_cpp[pid].pos[2] = los_z
+    # Parse lines of sight into a line-of-sight policy.
+    cdef double[::1] los_rand_axis
+    cdef double[:, ::1] los_rand_arr
+
+    los_type, (los_rand,) = _parse_los_spec(los_rand)
 
     # Run algorithm.
     cdef TwoPCFWindowMeasurements results
-    results = compute_corrfunc_window_cpp(
-        deref(particles_rand.thisptr), los_rand_cpp,
-        deref(params.thisptr), deref(rbinning.thisptr),
-        alpha, norm_factor
-    )
-
-    free(los_rand_cpp)
+    if los_type == 'radial':
+        with nogil:
+            results = compute_corrfunc_window_cpp[RadialLineOfSight](
+                deref(particles_rand.thisptr),
+                RadialLineOfSight(particles_rand.thisptr.pos_observer),
+                deref(params.thisptr), deref(rbinning.thisptr),
+                alpha, norm_factor
+            )
+    elif los_type == 'global':
+        los_rand_axis = los_rand
+        with nogil:
+            results = compute_corrfunc_window_cpp[GlobalLineOfSight](
+                deref(particles_rand.thisptr),
+                GlobalLineOfSight(&los_rand_axis[0]),
+                deref(params.thisptr), deref(rbinning.thisptr),
+                alpha, norm_factor
+            )
+    else:
+        los_rand_arr = los_rand
+        if los_rand_arr.shape[0] != particles_rand.thisptr.ntotal:
+            raise ValueError(
+                "Lines of sight do not match the catalogue size."
+            )
+        with nogil:
+            results = compute_corrfunc_window_cpp[StoredLineOfSight](
+                deref(particles_rand.thisptr),
+                StoredLineOfSight(<LineOfSight*>&los_rand_arr[0, 0]),
+                deref(params.thisptr), deref(rbinning.thisptr),
+                alpha, norm_factor
+            )
 
     return {
         'rbin': np.array(results.rbin),
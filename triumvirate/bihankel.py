@@ -340,12 +340,76 @@ def extrap2d_bipad(a, ncol_ext, nrow_ext=None, a_const_col=0., a_const_row=None)
     return a_out
 
 
+def _check_loglin_spacing(a, rtol=1.e-5):
+    """Check the input 1-d array is log-linearly spaced.
+
+    Parameters
+    ----------
+    a : 1-d array of float
+        Input 1-d array.
+    rtol : float, optional
+        Relative tolerance (default is 1.e-5) for the spacing.
+
+    Raises
+    ------
+    ValueError
+        When the input array is not log-linearly spaced.
+
+    """
+    if len(a) < 2 or np.any(a <= 0.):
+        raise ValueError(
+            "Input sample points are not log-linearly spaced; "
+            "set `n_fftlog` to interpolate."
+        )
+
+    dlna = np.diff(np.log(a))
+    if not np.allclose(dlna, dlna[0], rtol=rtol, atol=0.):
+        raise ValueError(
+            "Input sample points are not log-linearly spaced; "
+            "set `n_fftlog` to interpolate."
+        )
+
+
+def _check_extrap(extrap, n_extrap):
+    """Check the extrapolation options.
+
+    Parameters
+    ----------
+    extrap : {'lin', 'loglin', 'zero'} or None
+        Extrapolation option.
+    n_extrap : int or None
+        Extrapolation sample number (one-sided).
+
+    Returns
+    -------
+    n_ext : int
+        Extrapolation sample number (one-sided), which is zero
+        if `extrap` is `None`.
+
+    Raises
+    ------
+    ValueError
+        When `n_extrap` is not set but `extrap` is.
+    ValueError
+        When `extrap` is not a recognised option.
+
+    """
+    if extrap is None:
+        return 0
+    if n_extrap is None:
+        raise ValueError("`n_extrap` must be provided if `extrap` is set.")
+    if extrap not in {'lin', 'loglin', 'zero'}:
+        raise ValueError(f"Unknown `extrap` option: {extrap}.")
+
+    return n_extrap
+
+
 # ========================================================================
 # Transforms
 # ========================================================================
 
 def transform_bispec_to_3pcf(ell1, ell2, k_in, bk_in, r_out,
-                             n_fftlog, extrap=None, n_extrap=None):
+                             n_fftlog=None, extrap=None, n_extrap=None):
     """Transform bispectrum samples to three-point correlation function
     (3PCF) samples using double 1-d FFTLog operations.
 
@@ -364,8 +428,11 @@ def transform_bispec_to_3pcf(ell1, ell2, k_in, bk_in, r_out,
         Input bispectrum.
     r_out : 1-d array of float
         Output separations.
-    n_fftlog : int
-        FFTLog sample number.
+    n_fftlog : int, optional
+        FFTLog sample number.  If `None` (default), the input wavenumbers
+        `k_in` must be log-linearly spaced and are used directly as
+        the FFTLog samples, and both extrapolation and transform are
+        performed natively in the backend without interpolation.
     extrap : {'lin', 'loglin', 'zero'}, optional
         If not `None` (default), set one of the following options:
             * 'lin' -- input bispectrum is extrapolated linearly;
@@ -392,65 +459,62 @@ def transform_bispec_to_3pcf(ell1, ell2, k_in, bk_in, r_out,
     ------
     ValueError
         When `n_extrap` is not set but `extrap` is.
+    ValueError
+        When `n_fftlog` is not set but the input sample points are not
+        log-linearly spaced.
 
     """
-    # Prepare samples.
-    if extrap is not None:
-        if n_extrap is None:
-            raise ValueError("`n_extrap` must be provided if `extrap` is set.")
-        k_sample = extrap_loglin(k_in, n_extrap)
-
-        if extrap == 'lin':
-            bk_sample = extrap2d_bilin(bk_in, n_extrap)
-        elif extrap == 'loglin':
-            bk_sample = extrap2d_logbilin(bk_in, n_extrap)
-        elif extrap == 'zero':
-            bk_sample = extrap2d_bipad(bk_in, n_extrap)
-        else:
-            raise ValueError(f"Unknown `extrap` option: {extrap}.")
-    else:
-        k_sample, bk_sample = k_in, bk_in
-
-    n_sample = len(k_sample)
-
-    # Perform FFTLog transform.
-    # CAVEAT: The choice of interpolator is discretionary but should
-    # have no effect.
-    k_fftlog = np.logspace(*np.log(k_sample[[0, -1]]), n_fftlog, base=np.e)
-
-    zeta_mesh_partial = np.zeros((n_sample, n_fftlog))
-    for i in range(n_sample):
-        interpolator_bk = interpolate.interp1d(
-            k_sample, bk_sample[i, :],
-            fill_value='extrapolate', kind='cubic'
+    # Perform the native transform directly on log-linearly spaced
+    # input samples.
+    if n_fftlog is None:
+        k_in = _check_1d_array(k_in)
+        _check_loglin_spacing(k_in)
+        n_ext = _check_extrap(extrap, n_extrap)
+
+        r_fftlog, zeta_fftlog = _fftlog.trans_bispec_to_3pcf(
+            ell1, ell2,
+            np.ascontiguousarray(k_in, dtype=float),
+            np.ascontiguousarray(_check_2d_array(bk_in), dtype=float),
+            n_ext=n_ext, extrap=extrap or 'zero'
         )
-        bk_fftlog = interpolator_bk(k_fftlog)
-
-        r_fftlog, zeta_fftlog = _fftlog.sj_transform(
-            ell2, 2, n_fftlog, k_fftlog, bk_fftlog
+        n_fftlog = len(r_fftlog)
+    else:
+        # Prepare samples.
+        if extrap is not None:
+            _check_extrap(extrap, n_extrap)
+            k_sample = extrap_loglin(k_in, n_extrap)
+
+            if extrap == 'lin':
+                bk_sample = extrap2d_bilin(bk_in, n_extrap)
+            elif extrap == 'loglin':
+                bk_sample = extrap2d_logbilin(bk_in, n_extrap)
+            elif extrap == 'zero':
+                bk_sample = extrap2d_bipad(bk_in, n_extrap)
+        else:
+            k_sample, bk_sample = k_in, bk_in
+
+        # Interpolate onto FFTLog samples.  The interpolation along
+        # each dimension commutes with the transform along the other.
+        # CAVEAT: The choice of interpolator is discretionary but should
+        # have no effect.
+        k_fftlog = np.logspace(
+            *np.log(k_sample[[0, -1]]), n_fftlog, base=np.e
         )
 
-        zeta_mesh_partial[i, :] = zeta_fftlog
-
-    zeta_mesh_full = np.zeros((n_fftlog, n_fftlog))
-    for j in range(n_fftlog):
-        interpolator_bk = interpolate.interp1d(
-            k_sample, zeta_mesh_partial[:, j],
+        bk_fftlog = interpolate.interp1d(
+            k_sample, bk_sample, axis=1,
             fill_value='extrapolate', kind='cubic'
-        )
-        bk_fftlog = interpolator_bk(k_fftlog)
+        )(k_fftlog)
+        bk_fftlog = interpolate.interp1d(
+            k_sample, bk_fftlog, axis=0,
+            fill_value='extrapolate', kind='cubic'
+        )(k_fftlog)
 
-        r_fftlog, zeta_fftlog = _fftlog.sj_transform(
-            ell1, 2, n_fftlog, k_fftlog, bk_fftlog
+        # Perform FFTLog transform.
+        r_fftlog, zeta_fftlog = _fftlog.trans_bispec_to_3pcf(
+            ell1, ell2, k_fftlog, np.ascontiguousarray(bk_fftlog)
         )
 
-        zeta_mesh_full[:, j] = zeta_fftlog
-
-    # An overall complex `parity` is needed here as it is not included
-    # in the backend transforms to avoid redundant computation.
-    parity = np.real(1j ** (ell1 + ell2))
-    zeta_fftlog = parity * zeta_mesh_full
-
     # Prepare output.
     interpolator2d_zeta = interpolate.RectBivariateSpline(
         r_fftlog, r_fftlog, zeta_fftlog
@@ -476,7 +540,7 @@ def transform_bispec_to_3pcf(ell1, ell2, k_in, bk_in, r_out,
 
 
 def transform_3pcf_to_bispec(ell1, ell2, r_in, zeta_in, k_out,
-                             n_fftlog, extrap=None, n_extrap=None):
+                             n_fftlog=None, extrap=None, n_extrap=None):
     """Transform three-point correlation function (3PCF) samples to
     bispectrum samples using double 1-d FFTLog operations.
 
@@ -495,8 +559,11 @@ def transform_3pcf_to_bispec(ell1, ell2, r_in, zeta_in, k_out,
         Input 3PCF.
     k_out : 1-d array of float
         Output wavenumbers.
-    n_fftlog : int
-        FFTLog sample number.
+    n_fftlog : int, optional
+        FFTLog sample number.  If `None` (default), the input separations
+        `r_in` must be log-linearly spaced and are used directly as
+        the FFTLog samples, and both extrapolation and transform are
+        performed natively in the backend without interpolation.
     extrap : {'lin', 'loglin', 'zero'}, optional
         If not `None` (default), set one of the following options:
             * 'lin' -- input 3PCF is extrapolated linearly;
@@ -524,67 +591,62 @@ def transform_3pcf_to_bispec(ell1, ell2, r_in, zeta_in, k_out,
     ------
     ValueError
         When `n_extrap` is not set but `extrap` is.
+    ValueError
+        When `n_fftlog` is not set but the input sample points are not
+        log-linearly spaced.
 
     """
-    # Prepare samples.
-    if extrap is not None:
-        if n_extrap is None:
-            raise ValueError("`n_extrap` must be provided if `extrap` is set.")
-        r_sample = extrap_loglin(r_in, n_extrap)
-
-        if extrap == 'lin':
-            zeta_sample = extrap2d_bilin(zeta_in, n_extrap)
-        elif extrap == 'loglin':
-            zeta_sample = extrap2d_logbilin(zeta_in, n_extrap)
-        elif extrap == 'zero':
-            zeta_sample = extrap2d_bipad(zeta_in, n_extrap)
-        else:
-            raise ValueError(f"Unknown `extrap` option: {extrap}.")
-    else:
-        r_sample, zeta_sample = r_in, zeta_in
-
-    n_sample = len(r_sample)
-
-    # Perform FFTLog transform.
-    # CAVEAT: The choice of interpolator is discretionary but should
-    # have no effect.
-    r_fftlog = np.logspace(*np.log(r_sample[[0, -1]]), n_fftlog, base=np.e)
-
-    bk_mesh_partial = np.zeros((n_sample, n_fftlog))
-    for i in range(n_sample):
-        interpolator_zeta = interpolate.interp1d(
-            r_sample, zeta_sample[i, :],
-            fill_value='extrapolate', kind='cubic'
+    # Perform the native transform directly on log-linearly spaced
+    # input samples.
+    if n_fftlog is None:
+        r_in = _check_1d_array(r_in)
+        _check_loglin_spacing(r_in)
+        n_ext = _check_extrap(extrap, n_extrap)
+
+        k_fftlog, bk_fftlog = _fftlog.trans_3pcf_to_bispec(
+            ell1, ell2,
+            np.ascontiguousarray(r_in, dtype=float),
+            np.ascontiguousarray(_check_2d_array(zeta_in), dtype=float),
+            n_ext=n_ext, extrap=extrap or 'zero'
         )
-        zeta_fftlog = interpolator_zeta(r_fftlog)
-
-        k_fftlog, bk_fftlog = _fftlog.sj_transform(
-            ell2, 2, n_fftlog, r_fftlog, zeta_fftlog
+        n_fftlog = len(k_fftlog)
+    else:
+        # Prepare samples.
+        if extrap is not None:
+            _check_extrap(extrap, n_extrap)
+            r_sample = extrap_loglin(r_in, n_extrap)
+
+            if extrap == 'lin':
+                zeta_sample = extrap2d_bilin(zeta_in, n_extrap)
+            elif extrap == 'loglin':
+                zeta_sample = extrap2d_logbilin(zeta_in, n_extrap)
+            elif extrap == 'zero':
+                zeta_sample = extrap2d_bipad(zeta_in, n_extrap)
+        else:
+            r_sample, zeta_sample = r_in, zeta_in
+
+        # Interpolate onto FFTLog samples.  The interpolation along
+        # each dimension commutes with the transform along the other.
+        # CAVEAT: The choice of interpolator is discretionary but should
+        # have no effect.
+        r_fftlog = np.logspace(
+            *np.log(r_sample[[0, -1]]), n_fftlog, base=np.e
         )
 
-        bk_mesh_partial[i, :] = bk_fftlog
-
-    bk_mesh_full = np.zeros((n_fftlog, n_fftlog))
-    for j in range(n_fftlog):
-        interpolator_zeta = interpolate.interp1d(
-            r_sample, bk_mesh_partial[:, j],
+        zeta_fftlog = interpolate.interp1d(
+            r_sample, zeta_sample, axis=1,
             fill_value='extrapolate', kind='cubic'
-        )
-        zeta_fftlog = interpolator_zeta(r_fftlog)
+        )(r_fftlog)
+        zeta_fftlog = interpolate.interp1d(
+            r_sample, zeta_fftlog, axis=0,
+            fill_value='extrapolate', kind='cubic'
+        )(r_fftlog)
 
-        k_fftlog, bk_fftlog = _fftlog.sj_transform(
-            ell1, 2, n_fftlog, r_fftlog, zeta_fftlog
+        # Perform FFTLog transform.
+        k_fftlog, bk_fftlog = _fftlog.trans_3pcf_to_bispec(
+            ell1, ell2, r_fftlog, np.ascontiguousarray(zeta_fftlog)
         )
 
-        bk_mesh_full[:, j] = bk_fftlog
-
-    # An overall complex `parity` is needed here as it is not included
-    # in the backend transforms to avoid redundant computation.
-    # Factors of pi are needed here because the forward transform is used
-    # in the backend as the backward transform.
-    parity = np.real((-1j) ** (ell1 + ell2))
-    bk_fftlog = (2*np.pi) ** 6 * parity * bk_mesh_full
-
     # Prepare output.
     interpolator2d_bk = interpolate.RectBivariateSpline(
         k_fftlog, k_fftlog, bk_fftlog
@@ -95,6 +95,8 @@ class ParticleCatalogue:
         # Compute catalogue properties.
         self._calc_bounds(init=True)
 
+        self._observer = np.zeros(3)
+
         self.ntotal = len(self._pdata)
         self.wtotal = self._compute(self._pdata['ws'].sum())
 
@@ -215,6 +217,8 @@ class ParticleCatalogue:
         # Compute catalogue properties.
         self._calc_bounds(init=True)
 
+        self._observer = np.zeros(3)
+
         self.ntotal = len(self._pdata)
         self.wtotal = self._compute(self._pdata['ws'].sum())
 
@@ -269,22 +273,26 @@ class ParticleCatalogue:
     def compute_los(self):
         """Compute the line of sight to each particle.
 
+        The line of sight is radial from the observer, which is placed
+        at the original coordinate origin and tracked through any
+        coordinate offsets.
+
         Returns
         -------
         los : (N, 3) :class:`numpy.ndarray`
             Normalised line-of-sight vectors.
 
         """
-        los_norm = np.sqrt(
-            self._pdata['x']**2 + self._pdata['y']**2 + self._pdata['z']**2
-        )
+        los_x = self._pdata['x'] - self._observer[0]
+        los_y = self._pdata['y'] - self._observer[1]
+        los_z = self._pdata['z'] - self._observer[2]
+
+        los_norm = np.sqrt(los_x**2 + los_y**2 + los_z**2)
 
         los_norm[los_norm == 0.] = 1.
 
         los = np.transpose([
-            self._pdata['x'] / los_norm,
-            self._pdata['y'] / los_norm,
-            self._pdata['z'] / los_norm
+            los_x / los_norm, los_y / los_norm, los_z / los_norm
         ])
 
         return self._compute(los)
@@ -447,6 +455,8 @@ class ParticleCatalogue:
         for axis, coord in zip(['x', 'y', 'z'], origin):
             self._pdata[axis] -= coord
 
+        self._observer = self._observer - np.asarray(origin, dtype=float)
+
         self._calc_bounds()
 
     def _calc_bounds(self, init=False):
@@ -493,14 +503,14 @@ class ParticleCatalogue:
             C++-wrapped catalogue.
 
         """
-        x = self._compute(self._pdata['x'])
-        y = self._compute(self._pdata['y'])
-        z = self._compute(self._pdata['z'])
-        nz = self._compute(self._pdata['nz'])
-        ws = self._compute(self._pdata['ws'])
-        wc = self._compute(self._pdata['wc'])
-
-        return _ParticleCatalogue(x, y, z, nz, ws, wc)
+        # Columns are computed and converted one at a time, so that at
+        # most one converted column is held alongside the C++ particle
+        # data; contiguous double-precision columns are read in without
+        # copying.
+        return _ParticleCatalogue._from_columns(
+            self.ntotal, lambda name: self._compute(self._pdata[name]),
+            observer=self._observer
+        )
 
     def _compute(self, quant):
         """Return a quantity in standard form (i.e. apply
@@ -7,7 +7,7 @@ from libcpp.vector cimport vector
 cimport numpy as np
 
 
-cdef extern from "include/dataobjs.hpp":
+cdef extern from "include/dataobjs.hpp" nogil:
     # --------------------------------------------------------------------
     # Binning schemes
     # --------------------------------------------------------------------
@@ -35,6 +35,17 @@ cdef extern from "include/dataobjs.hpp":
     struct LineOfSight "trv::LineOfSight":
         double pos[3]
 
+    cdef cppclass StoredLineOfSight "trv::StoredLineOfSight":
+        StoredLineOfSight(const LineOfSight* los)
+
+    cdef cppclass RadialLineOfSight "trv::RadialLineOfSight":
+        RadialLineOfSight()
+        RadialLineOfSight(const double* observer)
+
+    cdef cppclass GlobalLineOfSight "trv::GlobalLineOfSight":
+        GlobalLineOfSight()
+        GlobalLineOfSight(const double* axis)
+
 
     # --------------------------------------------------------------------
     # Clustering statistics
@@ -49,6 +60,15 @@ cdef extern from "include/dataobjs.hpp":
         vector[np.complex128_t] pk_raw
         vector[np.complex128_t] pk_shot
 
+    struct PowspecWedgeMeasurements "trv::PowspecWedgeMeasurements":
+        vector[double] kbin
+        vector[double] mubin
+        vector[double] keff
+        vector[double] mueff
+        vector[int] nmodes
+        vector[np.complex128_t] pk_raw
+        vector[np.complex128_t] pk_shot
+
     struct TwoPCFMeasurements "trv::TwoPCFMeasurements":
         vector[double] rbin
         vector[double] reff
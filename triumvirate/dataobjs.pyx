@@ -164,3 +164,52 @@ cdef class Binning:
         self.thisptr.bin_edges = self.bin_edges
         self.thisptr.bin_centres = self.bin_centres
         self.thisptr.bin_widths = self.bin_widths
+
+
+def _parse_los_spec(*los_specs):
+    """Parse line-of-sight specifications into a line-of-sight policy.
+
+    Parameters
+    ----------
+    *los_specs : (N, 3) or (3,) array of float, or None
+        Line-of-sight specification for each catalogue.  If all are
+        `None`, lines of sight are radial from the observer and
+        evaluated on the fly; if all are (3,) arrays, each is a fixed
+        global line-of-sight axis; if all are (N, 3) arrays, they are
+        stored lines of sight to each particle.
+
+    Returns
+    -------
+    los_type : {'radial', 'global', 'stored'}
+        Line-of-sight policy type.
+    los_specs : tuple of (N, 3) or (3,) array of float, or None
+        Contiguous line-of-sight specifications.
+
+    Raises
+    ------
+    ValueError
+        If the line-of-sight specifications are inconsistent
+        or unsupported.
+
+    """
+    if all(los is None for los in los_specs):
+        return 'radial', los_specs
+    if any(los is None for los in los_specs):
+        raise ValueError(
+            "Lines of sight must be specified for either all or none "
+            "of the catalogues."
+        )
+
+    los_specs = tuple(
+        np.ascontiguousarray(los, dtype=float) for los in los_specs
+    )
+
+    if all(los.shape == (3,) for los in los_specs):
+        return 'global', los_specs
+    if all(los.ndim == 2 and los.shape[-1] == 3 for los in los_specs):
+        return 'stored', los_specs
+
+    raise ValueError(
+        "Unsupported line-of-sight specifications: expected (N, 3) "
+        "or (3,) arrays for all catalogues."
+    )
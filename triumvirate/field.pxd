@@ -0,0 +1,116 @@
+"""Declaration of :cpp:class:`trv::MeshField` and
+:cpp:class:`trv::FieldStats` and their members and methods.
+
+"""
+from libcpp.vector cimport vector
+
+cimport numpy as np
+
+from triumvirate._particles cimport CppParticleCatalogue
+from triumvirate.dataobjs cimport CppBinning
+from triumvirate.parameters cimport CppParameterSet
+
+
+cdef extern from "fftw3.h":
+    ctypedef double fftw_complex[2]
+
+
+cdef extern from "include/field.hpp" nogil:
+    # --------------------------------------------------------------------
+    # Mesh field
+    # --------------------------------------------------------------------
+
+    cdef cppclass CppMeshField "trv::MeshField":
+        CppParameterSet params
+        fftw_complex* field
+        double dr[3]
+        double dk[3]
+        double vol
+        double vol_cell
+        int local_x_begin
+        int local_x_end
+        int local_nmesh
+
+        CppMeshField(CppParameterSet& params) except +
+
+        void initialise_density_field() except +
+
+        void compute_unweighted_field(
+            CppParticleCatalogue& particles
+        ) except +
+        void compute_unweighted_field_fluctuations_insitu(
+            CppParticleCatalogue& particles
+        ) except +
+
+        void compute_ylm_wgtd_field[LoSPolicy](
+            CppParticleCatalogue& particles_data,
+            CppParticleCatalogue& particles_rand,
+            LoSPolicy los_data, LoSPolicy los_rand,
+            double alpha, int ell, int m
+        ) except +
+        void compute_ylm_wgtd_field_single \
+            "compute_ylm_wgtd_field" [LoSPolicy](
+            CppParticleCatalogue& particles, LoSPolicy los,
+            double alpha, int ell, int m
+        ) except +
+        void compute_ylm_wgtd_quad_field[LoSPolicy](
+            CppParticleCatalogue& particles_data,
+            CppParticleCatalogue& particles_rand,
+            LoSPolicy los_data, LoSPolicy los_rand,
+            double alpha, int ell, int m
+        ) except +
+        void compute_ylm_wgtd_quad_field_single \
+            "compute_ylm_wgtd_quad_field" [LoSPolicy](
+            CppParticleCatalogue& particles, LoSPolicy los,
+            double alpha, int ell, int m
+        ) except +
+
+        void fourier_transform() except +
+        void inv_fourier_transform() except +
+        void apply_assignment_compensation() except +
+
+        void inv_fourier_transform_ylm_wgtd_field_band_limited(
+            CppMeshField& field_fourier, vector[np.complex128_t]& ylm,
+            double k_lower, double k_upper, double& k_eff, int& nmodes
+        ) except +
+        void inv_fourier_transform_unit_field_band_limited(
+            double k_lower, double k_upper, double& k_eff, int& nmodes
+        ) except +
+
+    # --------------------------------------------------------------------
+    # Pseudo two-point statistics
+    # --------------------------------------------------------------------
+
+    cdef cppclass CppFieldStats "trv::FieldStats":
+        vector[int] nmodes
+        vector[int] npairs
+        vector[double] k
+        vector[double] r
+        vector[np.complex128_t] sn
+        vector[np.complex128_t] pk
+        vector[np.complex128_t] xi
+
+        CppFieldStats(CppParameterSet& params) except +
+
+        void reset_stats()
+
+        void compute_ylm_wgtd_2pt_stats_in_fourier(
+            CppMeshField& field_a, CppMeshField& field_b,
+            np.complex128_t shotnoise_amp,
+            int ell, int m, CppBinning& kbinning
+        ) except +
+        void compute_ylm_wgtd_2pt_stats_in_config(
+            CppMeshField& field_a, CppMeshField& field_b,
+            np.complex128_t shotnoise_amp,
+            int ell, int m, CppBinning& rbinning
+        ) except +
+
+
+cdef class MeshField:
+    cdef CppMeshField* thisptr
+    cdef public object paramset
+
+
+cdef class FieldStats:
+    cdef CppFieldStats* thisptr
+    cdef public object paramset
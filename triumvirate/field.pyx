@@ -0,0 +1,804 @@
+"""
+Mesh Fields (:mod:`~triumvirate.field`)
+==========================================================================
+
+Build persistent mesh fields and pseudo two-point statistics.
+
+Mesh fields are assigned from particle catalogues once, transformed
+in place and viewed as NumPy arrays without copying, so that several
+clustering statistics (or custom estimators) can share them.
+
+Pseudo two-point statistics are binned by :class:`FieldStats`, and
+band-limited (shell) fields for bispectrum estimators are obtained with
+:meth:`MeshField.inv_fourier_transform_ylm_wgtd_field_band_limited`.
+Bispectrum and three-point correlation function shot-noise terms are
+not exposed here and remain computed by :mod:`~triumvirate.threept`.
+
+.. autosummary::
+    MeshField
+    FieldStats
+    calc_ylm_wgtd_shotnoise_amp
+
+"""
+from cython.operator cimport dereference as deref
+from libcpp.vector cimport vector
+
+import numpy as np
+cimport numpy as np
+
+from triumvirate._particles cimport CppParticleCatalogue, _ParticleCatalogue
+from triumvirate.dataobjs cimport (
+    Binning,
+    GlobalLineOfSight, LineOfSight, RadialLineOfSight, StoredLineOfSight,
+)
+from triumvirate.parameters cimport ParameterSet
+from .field cimport CppFieldStats, CppMeshField
+
+from triumvirate.dataobjs import _parse_los_spec
+
+np.import_array()
+
+
+cdef extern from "include/maths.hpp" nogil:
+    cdef cppclass CppSphericalHarmonicCalculator \
+            "trv::maths::SphericalHarmonicCalculator":
+        @staticmethod
+        void store_reduced_spherical_harmonic_in_fourier_space(
+            int ell, int m, double* boxsize, int* ngrid,
+            vector[np.complex128_t]& ylm_out
+        ) except +
+
+
+cdef extern from "include/twopt.hpp" nogil:
+    np.complex128_t calc_ylm_wgtd_shotnoise_amp_for_powspec_cpp \
+        "trv::calc_ylm_wgtd_shotnoise_amp_for_powspec" [LoSPolicy](
+            CppParticleCatalogue& particles_data,
+            CppParticleCatalogue& particles_rand,
+            LoSPolicy los_data, LoSPolicy los_rand,
+            double alpha, int ell, int m
+        ) except +
+    np.complex128_t calc_ylm_wgtd_shotnoise_amp_for_powspec_single_cpp \
+        "trv::calc_ylm_wgtd_shotnoise_amp_for_powspec" [LoSPolicy](
+            CppParticleCatalogue& particles, LoSPolicy los,
+            double alpha, int ell, int m
+        ) except +
+
+
+def _as_cpp_catalogue(catalogue):
+    """Return a C++-wrapped catalogue.
+
+    Parameters
+    ----------
+    catalogue : :class:`~triumvirate.catalogue.ParticleCatalogue`
+        Particle catalogue.  A C++-wrapped catalogue is passed through
+        so that it may be converted once and reused.
+
+    Returns
+    -------
+    :class:`~triumvirate._particles._ParticleCatalogue`
+        C++-wrapped catalogue.
+
+    """
+    if isinstance(catalogue, _ParticleCatalogue):
+        return catalogue
+    return catalogue._convert_to_cpp_catalogue()
+
+
+def _check_los_sizes(los_type, *pairs):
+    """Check stored lines of sight match the catalogue sizes.
+
+    Parameters
+    ----------
+    los_type : {'radial', 'global', 'stored'}
+        Line-of-sight policy type.
+    *pairs : tuple
+        C++-wrapped catalogue and its stored (N, 3) lines of sight.
+
+    Raises
+    ------
+    ValueError
+        If any stored lines of sight do not match the catalogue size.
+
+    """
+    if los_type != 'stored':
+        return
+    for particles, los in pairs:
+        if len(los) != (<_ParticleCatalogue>particles).thisptr.ntotal:
+            raise ValueError(
+                "Lines of sight do not match the catalogue sizes."
+            )
+
+
+cdef class MeshField:
+    """Discretely sampled field on a mesh grid from particle catalogues.
+
+    Parameters
+    ----------
+    paramset : :class:`~triumvirate.parameters.ParameterSet`
+        Parameter set for mesh sampling, i.e. 'boxsize', 'ngrid',
+        'assignment' and 'interlace'.
+
+    Attributes
+    ----------
+    paramset : :class:`~triumvirate.parameters.ParameterSet`
+        Parameter set.
+    field : (nx, ny, nz) :class:`numpy.ndarray` of complex
+        Field on the mesh grid (see :attr:`field`).
+
+    Notes
+    -----
+    Catalogues are assigned to the mesh as is, so they should already
+    be aligned to the box (see
+    :meth:`~triumvirate.catalogue.ParticleCatalogue.centre` and
+    :meth:`~triumvirate.catalogue.ParticleCatalogue.pad`).  Catalogues
+    may be passed as :class:`~triumvirate.catalogue.ParticleCatalogue`
+    objects or, to avoid repeated conversions, as their C++-wrapped
+    equivalents.
+
+    Examples
+    --------
+    A power spectrum monopole from fields built once:
+
+    >>> dn_00 = MeshField(paramset)
+    >>> dn_00.compute_ylm_wgtd_field(catalogue_data, catalogue_rand, alpha)
+    >>> dn_00.fourier_transform()
+    >>> sn_amp = calc_ylm_wgtd_shotnoise_amp(
+    ...     catalogue_data, catalogue_rand, alpha
+    ... )
+    >>> stats = FieldStats(paramset).compute_ylm_wgtd_2pt_stats_in_fourier(
+    ...     dn_00, dn_00, sn_amp, 0, 0, binning
+    ... )
+
+    """
+
+    def __cinit__(self, ParameterSet paramset not None):
+        self.paramset = paramset
+        self.thisptr = new CppMeshField(deref(paramset.thisptr))
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    @property
+    def field(self):
+        """Field on the (local) mesh grid as a read-only NumPy view.
+
+        The array shares memory with the mesh field, so it reflects
+        subsequent in-place assignments and transforms.  It is read-only
+        as the mesh field tracks properties of its values (e.g. whether
+        it is real in configuration space) that writes would invalidate;
+        copy the array to modify it.  Fourier-space entries are arranged
+        in the FFTW convention (i.e. shifted).
+
+        Returns
+        -------
+        (nx, ny, nz) :class:`numpy.ndarray` of complex
+            Mesh field view.
+
+        """
+        cdef np.npy_intp dims[3]
+        dims[0] = self.thisptr.local_x_end - self.thisptr.local_x_begin
+        dims[1] = self.thisptr.params.ngrid[1]
+        dims[2] = self.thisptr.params.ngrid[2]
+
+        cdef np.ndarray arr = np.PyArray_SimpleNewFromData(
+            3, dims, np.NPY_COMPLEX128, <void*>self.thisptr.field
+        )
+        np.PyArray_CLEARFLAGS(arr, np.NPY_ARRAY_WRITEABLE)
+        np.set_array_base(arr, self)  # keep the mesh field alive
+
+        return arr
+
+    @property
+    def dr(self):
+        """Grid size in each dimension.
+
+        Returns
+        -------
+        tuple of float
+            Grid size.
+
+        """
+        return tuple(self.thisptr.dr[iaxis] for iaxis in range(3))
+
+    @property
+    def dk(self):
+        """Fundamental wavenumber in each dimension.
+
+        Returns
+        -------
+        tuple of float
+            Fundamental wavenumber.
+
+        """
+        return tuple(self.thisptr.dk[iaxis] for iaxis in range(3))
+
+    @property
+    def vol(self):
+        """Mesh volume.
+
+        Returns
+        -------
+        float
+            Mesh volume.
+
+        """
+        return self.thisptr.vol
+
+    @property
+    def vol_cell(self):
+        """Mesh grid cell volume.
+
+        Returns
+        -------
+        float
+            Mesh grid cell volume.
+
+        """
+        return self.thisptr.vol_cell
+
+    def reset(self):
+        """Reset the field values to zeros.
+
+        """
+        self.thisptr.initialise_density_field()
+
+    def compute_unweighted_field(self, catalogue):
+        """Compute the unweighted (number density) field.
+
+        Parameters
+        ----------
+        catalogue : :class:`~triumvirate.catalogue.ParticleCatalogue`
+            Particle catalogue.
+
+        """
+        cdef _ParticleCatalogue particles = _as_cpp_catalogue(catalogue)
+        with nogil:
+            self.thisptr.compute_unweighted_field(deref(particles.thisptr))
+
+    def compute_unweighted_field_fluctuations_insitu(self, catalogue):
+        """Compute the unweighted field fluctuations in a periodic box.
+
+        Parameters
+        ----------
+        catalogue : :class:`~triumvirate.catalogue.ParticleCatalogue`
+            Particle catalogue.
+
+        """
+        cdef _ParticleCatalogue particles = _as_cpp_catalogue(catalogue)
+        with nogil:
+            self.thisptr.compute_unweighted_field_fluctuations_insitu(
+                deref(particles.thisptr)
+            )
+
+    def compute_ylm_wgtd_field(self, catalogue_data, catalogue_rand=None,
+                               double alpha=1., int ell=0, int m=0,
+                               los_data=None, los_rand=None):
+        """Compute the weighted field (fluctuations) further weighted by
+        the reduced spherical harmonics.
+
+        Parameters
+        ----------
+        catalogue_data : :class:`~triumvirate.catalogue.ParticleCatalogue`
+            (Data-source) particle catalogue.
+        catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`, optional
+            (Random-source) particle catalogue.  If `None` (default),
+            the field of `catalogue_data` alone (scaled by `alpha`) is
+            computed rather than the fluctuations.
+        alpha : float, optional
+            Alpha contrast (default is 1.).
+        ell, m : int, optional
+            Degree and order of the spherical harmonic (defaults are 0).
+        los_data, los_rand : (N, 3) or (3,) array of float, optional
+            Stored lines of sight for each catalogue or a global
+            line-of-sight axis (defaults are `None`, for which lines of
+            sight are radial from the observer).
+
+        """
+        self._compute_ylm_wgtd(
+            False, catalogue_data, catalogue_rand, alpha, ell, m,
+            los_data, los_rand
+        )
+
+    def compute_ylm_wgtd_quad_field(self, catalogue_data, catalogue_rand=None,
+                                    double alpha=1., int ell=0, int m=0,
+                                    los_data=None, los_rand=None):
+        """Compute the quadratic weighted field (fluctuations) further
+        weighted by the reduced spherical harmonics.
+
+        Parameters
+        ----------
+        catalogue_data : :class:`~triumvirate.catalogue.ParticleCatalogue`
+            (Data-source) particle catalogue.
+        catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`, optional
+            (Random-source) particle catalogue.  If `None` (default),
+            the field of `catalogue_data` alone (scaled by `alpha`) is
+            computed.
+        alpha : float, optional
+            Alpha contrast (default is 1.).
+        ell, m : int, optional
+            Degree and order of the spherical harmonic (defaults are 0).
+        los_data, los_rand : (N, 3) or (3,) array of float, optional
+            Stored lines of sight for each catalogue or a global
+            line-of-sight axis (defaults are `None`, for which lines of
+            sight are radial from the observer).
+
+        """
+        self._compute_ylm_wgtd(
+            True, catalogue_data, catalogue_rand, alpha, ell, m,
+            los_data, los_rand
+        )
+
+    def _compute_ylm_wgtd(self, bint quad, catalogue_data, catalogue_rand,
+                          double alpha, int ell, int m, los_data, los_rand):
+        cdef _ParticleCatalogue particles_data = \
+            _as_cpp_catalogue(catalogue_data)
+        cdef _ParticleCatalogue particles_rand
+
+        cdef double[::1] los_data_axis, los_rand_axis
+        cdef double[:, ::1] los_data_arr, los_rand_arr
+
+        # Single-catalogue field.
+        if catalogue_rand is None:
+            los_type, (los_data,) = _parse_los_spec(los_data)
+            _check_los_sizes(los_type, (particles_data, los_data))
+            if los_type == 'radial':
+                with nogil:
+                    if quad:
+                        self.thisptr.compute_ylm_wgtd_quad_field_single[
+                            RadialLineOfSight
+                        ](
+                            deref(particles_data.thisptr),
+                            RadialLineOfSight(
+                                particles_data.thisptr.pos_observer
+                            ),
+                            alpha, ell, m
+                        )
+                    else:
+                        self.thisptr.compute_ylm_wgtd_field_single[
+                            RadialLineOfSight
+                        ](
+                            deref(particles_data.thisptr),
+                            RadialLineOfSight(
+                                particles_data.thisptr.pos_observer
+                            ),
+                            alpha, ell, m
+                        )
+            elif los_type == 'global':
+                los_data_axis = los_data
+                with nogil:
+                    if quad:
+                        self.thisptr.compute_ylm_wgtd_quad_field_single[
+                            GlobalLineOfSight
+                        ](
+                            deref(particles_data.thisptr),
+                            GlobalLineOfSight(&los_data_axis[0]),
+                            alpha, ell, m
+                        )
+                    else:
+                        self.thisptr.compute_ylm_wgtd_field_single[
+                            GlobalLineOfSight
+                        ](
+                            deref(particles_data.thisptr),
+                            GlobalLineOfSight(&los_data_axis[0]),
+                            alpha, ell, m
+                        )
+            else:
+                los_data_arr = los_data
+                with nogil:
+                    if quad:
+                        self.thisptr.compute_ylm_wgtd_quad_field_single[
+                            StoredLineOfSight
+                        ](
+                            deref(particles_data.thisptr),
+                            StoredLineOfSight(
+                                <LineOfSight*>&los_data_arr[0, 0]
+                            ),
+                            alpha, ell, m
+                        )
+                    else:
+                        self.thisptr.compute_ylm_wgtd_field_single[
+                            StoredLineOfSight
+                        ](
+                            deref(particles_data.thisptr),
+                            StoredLineOfSight(
+                                <LineOfSight*>&los_data_arr[0, 0]
+                            ),
+                            alpha, ell, m
+                        )
+            return
+
+        # Paired-catalogue field fluctuations.
+        particles_rand = _as_cpp_catalogue(catalogue_rand)
+
+        los_type, (los_data, los_rand) = _parse_los_spec(los_data, los_rand)
+        _check_los_sizes(
+            los_type, (particles_data, los_data), (particles_rand, los_rand)
+        )
+        if los_type == 'radial':
+            with nogil:
+                if quad:
+                    self.thisptr.compute_ylm_wgtd_quad_field[
+                        RadialLineOfSight
+                    ](
+                        deref(particles_data.thisptr),
+                        deref(particles_rand.thisptr),
+                        RadialLineOfSight(particles_data.thisptr.pos_observer),
+                        RadialLineOfSight(particles_rand.thisptr.pos_observer),
+                        alpha, ell, m
+                    )
+                else:
+                    self.thisptr.compute_ylm_wgtd_field[RadialLineOfSight](
+                        deref(particles_data.thisptr),
+                        deref(particles_rand.thisptr),
+                        RadialLineOfSight(particles_data.thisptr.pos_observer),
+                        RadialLineOfSight(particles_rand.thisptr.pos_observer),
+                        alpha, ell, m
+                    )
+        elif los_type == 'global':
+            los_data_axis, los_rand_axis = los_data, los_rand
+            with nogil:
+                if quad:
+                    self.thisptr.compute_ylm_wgtd_quad_field[
+                        GlobalLineOfSight
+                    ](
+                        deref(particles_data.thisptr),
+                        deref(particles_rand.thisptr),
+                        GlobalLineOfSight(&los_data_axis[0]),
+                        GlobalLineOfSight(&los_rand_axis[0]),
+                        alpha, ell, m
+                    )
+                else:
+                    self.thisptr.compute_ylm_wgtd_field[GlobalLineOfSight](
+                        deref(particles_data.thisptr),
+                        deref(particles_rand.thisptr),
+                        GlobalLineOfSight(&los_data_axis[0]),
+                        GlobalLineOfSight(&los_rand_axis[0]),
+                        alpha, ell, m
+                    )
+        else:
+            los_data_arr, los_rand_arr = los_data, los_rand
+            with nogil:
+                if quad:
+                    self.thisptr.compute_ylm_wgtd_quad_field[
+                        StoredLineOfSight
+                    ](
+                        deref(particles_data.thisptr),
+                        deref(particles_rand.thisptr),
+                        StoredLineOfSight(<LineOfSight*>&los_data_arr[0, 0]),
+                        StoredLineOfSight(<LineOfSight*>&los_rand_arr[0, 0]),
+                        alpha, ell, m
+                    )
+                else:
+                    self.thisptr.compute_ylm_wgtd_field[StoredLineOfSight](
+                        deref(particles_data.thisptr),
+                        deref(particles_rand.thisptr),
+                        StoredLineOfSight(<LineOfSight*>&los_data_arr[0, 0]),
+                        StoredLineOfSight(<LineOfSight*>&los_rand_arr[0, 0]),
+                        alpha, ell, m
+                    )
+
+    def fourier_transform(self):
+        """Fourier transform the field in place.
+
+        Interlacing with the shadow field, if enabled, is applied.
+
+        """
+        with nogil:
+            self.thisptr.fourier_transform()
+
+    def inv_fourier_transform(self):
+        """Inverse Fourier transform the field in place.
+
+        """
+        with nogil:
+            self.thisptr.inv_fourier_transform()
+
+    def apply_assignment_compensation(self):
+        """Apply compensation for the mesh assignment window to the
+        Fourier-space field in place.
+
+        """
+        with nogil:
+            self.thisptr.apply_assignment_compensation()
+
+    def inv_fourier_transform_ylm_wgtd_field_band_limited(
+            self, MeshField field_fourier not None, int ell, int m,
+            double k_lower, double k_upper):
+        """Inverse Fourier transform a Fourier-space field weighted by
+        the reduced spherical harmonics and restricted to a wavenumber
+        band into this field.
+
+        Parameters
+        ----------
+        field_fourier : :class:`~triumvirate.field.MeshField`
+            Fourier-space mesh field (on a mesh grid at least as fine
+            as this one).
+        ell, m : int
+            Degree and order of the spherical harmonic.
+        k_lower, k_upper : float
+            Band lower and upper wavenumbers.
+
+        Returns
+        -------
+        k_eff : float
+            Effective band wavenumber.
+        nmodes : int
+            Number of wavevector modes in the band.
+
+        Notes
+        -----
+        Products of such band-limited fields summed over the mesh grid
+        (times :attr:`vol_cell`) give the raw bispectrum signal
+        component as in :func:`~triumvirate.threept.compute_bispec`.
+
+        """
+        cdef vector[np.complex128_t] ylm = vector[np.complex128_t](
+            field_fourier.thisptr.params.nmesh
+        )
+        cdef double k_eff = 0.
+        cdef int nmodes = 0
+        with nogil:
+            CppSphericalHarmonicCalculator.\
+                store_reduced_spherical_harmonic_in_fourier_space(
+                ell, m,
+                field_fourier.thisptr.params.boxsize,
+                field_fourier.thisptr.params.ngrid,
+                ylm
+            )
+            self.thisptr.inv_fourier_transform_ylm_wgtd_field_band_limited(
+                deref(field_fourier.thisptr), ylm,
+                k_lower, k_upper, k_eff, nmodes
+            )
+
+        return k_eff, nmodes
+
+    def inv_fourier_transform_unit_field_band_limited(self, double k_lower,
+                                                      double k_upper):
+        """Inverse Fourier transform the unit field restricted to a
+        wavenumber band into this field.
+
+        Parameters
+        ----------
+        k_lower, k_upper : float
+            Band lower and upper wavenumbers.
+
+        Returns
+        -------
+        k_eff : float
+            Effective band wavenumber.
+        nmodes : int
+            Number of wavevector modes in the band.
+
+        Notes
+        -----
+        Products of such band-limited fields summed over the mesh grid
+        count closed wavevector configurations, e.g. triangles for the
+        bispectrum.
+
+        """
+        cdef double k_eff = 0.
+        cdef int nmodes = 0
+        with nogil:
+            self.thisptr.inv_fourier_transform_unit_field_band_limited(
+                k_lower, k_upper, k_eff, nmodes
+            )
+
+        return k_eff, nmodes
+
+
+cdef class FieldStats:
+    """Pseudo two-point statistics of mesh fields.
+
+    Parameters
+    ----------
+    paramset : :class:`~triumvirate.parameters.ParameterSet`
+        Parameter set compatible with that of the mesh fields.
+
+    Attributes
+    ----------
+    paramset : :class:`~triumvirate.parameters.ParameterSet`
+        Parameter set.
+
+    """
+
+    def __cinit__(self, ParameterSet paramset not None):
+        self.paramset = paramset
+        self.thisptr = new CppFieldStats(deref(paramset.thisptr))
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute_ylm_wgtd_2pt_stats_in_fourier(self,
+                                              MeshField field_a not None,
+                                              MeshField field_b not None,
+                                              shotnoise_amp,
+                                              int ell, int m,
+                                              Binning kbinning not None):
+        """Compute binned two-point statistics in Fourier space.
+
+        Parameters
+        ----------
+        field_a, field_b : :class:`~triumvirate.field.MeshField`
+            Fourier-space mesh fields.
+        shotnoise_amp : complex
+            Shot-noise amplitude.
+        ell, m : int
+            Degree and order of the spherical harmonic.
+        kbinning : :class:`~triumvirate.dataobjs.Binning`
+            Wavenumber binning.
+
+        Returns
+        -------
+        dict
+            Binned statistics with keys 'k', 'nmodes', 'pk' and 'sn'
+            for the average wavenumber, number of wavevector modes,
+            pseudo power spectrum and shot-noise power in bins.
+
+        """
+        cdef np.complex128_t sn_amp = shotnoise_amp
+        with nogil:
+            self.thisptr.compute_ylm_wgtd_2pt_stats_in_fourier(
+                deref(field_a.thisptr), deref(field_b.thisptr),
+                sn_amp, ell, m, deref(kbinning.thisptr)
+            )
+
+        return {
+            'k': np.array(self.thisptr.k),
+            'nmodes': np.array(self.thisptr.nmodes),
+            'pk': np.array(self.thisptr.pk),
+            'sn': np.array(self.thisptr.sn),
+        }
+
+    def compute_ylm_wgtd_2pt_stats_in_config(self,
+                                             MeshField field_a not None,
+                                             MeshField field_b not None,
+                                             shotnoise_amp,
+                                             int ell, int m,
+                                             Binning rbinning not None):
+        """Compute binned two-point statistics in configuration space.
+
+        Parameters
+        ----------
+        field_a, field_b : :class:`~triumvirate.field.MeshField`
+            Fourier-space mesh fields.
+        shotnoise_amp : complex
+            Shot-noise amplitude.
+        ell, m : int
+            Degree and order of the spherical harmonic.
+        rbinning : :class:`~triumvirate.dataobjs.Binning`
+            Separation binning.
+
+        Returns
+        -------
+        dict
+            Binned statistics with keys 'r', 'npairs' and 'xi' for the
+            average separation, number of separation pairs and pseudo
+            two-point correlation function in bins.
+
+        """
+        cdef np.complex128_t sn_amp = shotnoise_amp
+        with nogil:
+            self.thisptr.compute_ylm_wgtd_2pt_stats_in_config(
+                deref(field_a.thisptr), deref(field_b.thisptr),
+                sn_amp, ell, m, deref(rbinning.thisptr)
+            )
+
+        return {
+            'r': np.array(self.thisptr.r),
+            'npairs': np.array(self.thisptr.npairs),
+            'xi': np.array(self.thisptr.xi),
+        }
+
+
+def calc_ylm_wgtd_shotnoise_amp(catalogue_data, catalogue_rand=None,
+                                double alpha=1., int ell=0, int m=0,
+                                los_data=None, los_rand=None):
+    """Calculate the power spectrum shot-noise amplitude weighted by
+    the reduced spherical harmonics.
+
+    Parameters
+    ----------
+    catalogue_data : :class:`~triumvirate.catalogue.ParticleCatalogue`
+        (Data-source) particle catalogue.
+    catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`, optional
+        (Random-source) particle catalogue.  If `None` (default), the
+        shot noise of `catalogue_data` alone is calculated.
+    alpha : float, optional
+        Alpha contrast (default is 1.).
+    ell, m : int, optional
+        Degree and order of the spherical harmonic (defaults are 0).
+    los_data, los_rand : (N, 3) or (3,) array of float, optional
+        Stored lines of sight for each catalogue or a global
+        line-of-sight axis (defaults are `None`, for which lines of
+        sight are radial from the observer).
+
+    Returns
+    -------
+    complex
+        Weighted shot-noise amplitude.
+
+    """
+    cdef _ParticleCatalogue particles_data = _as_cpp_catalogue(catalogue_data)
+    cdef _ParticleCatalogue particles_rand
+
+    cdef double[::1] los_data_axis, los_rand_axis
+    cdef double[:, ::1] los_data_arr, los_rand_arr
+
+    cdef np.complex128_t sn_amp
+
+    # Single catalogue.
+    if catalogue_rand is None:
+        los_type, (los_data,) = _parse_los_spec(los_data)
+        _check_los_sizes(los_type, (particles_data, los_data))
+        if los_type == 'radial':
+            with nogil:
+                sn_amp = calc_ylm_wgtd_shotnoise_amp_for_powspec_single_cpp[
+                    RadialLineOfSight
+                ](
+                    deref(particles_data.thisptr),
+                    RadialLineOfSight(particles_data.thisptr.pos_observer),
+                    alpha, ell, m
+                )
+        elif los_type == 'global':
+            los_data_axis = los_data
+            with nogil:
+                sn_amp = calc_ylm_wgtd_shotnoise_amp_for_powspec_single_cpp[
+                    GlobalLineOfSight
+                ](
+                    deref(particles_data.thisptr),
+                    GlobalLineOfSight(&los_data_axis[0]),
+                    alpha, ell, m
+                )
+        else:
+            los_data_arr = los_data
+            with nogil:
+                sn_amp = calc_ylm_wgtd_shotnoise_amp_for_powspec_single_cpp[
+                    StoredLineOfSight
+                ](
+                    deref(particles_data.thisptr),
+                    StoredLineOfSight(<LineOfSight*>&los_data_arr[0, 0]),
+                    alpha, ell, m
+                )
+        return sn_amp
+
+    # Paired catalogues.
+    particles_rand = _as_cpp_catalogue(catalogue_rand)
+
+    los_type, (los_data, los_rand) = _parse_los_spec(los_data, los_rand)
+    _check_los_sizes(
+        los_type, (particles_data, los_data), (particles_rand, los_rand)
+    )
+    if los_type == 'radial':
+        with nogil:
+            sn_amp = calc_ylm_wgtd_shotnoise_amp_for_powspec_cpp[
+                RadialLineOfSight
+            ](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                RadialLineOfSight(particles_data.thisptr.pos_observer),
+                RadialLineOfSight(particles_rand.thisptr.pos_observer),
+                alpha, ell, m
+            )
+    elif los_type == 'global':
+        los_data_axis, los_rand_axis = los_data, los_rand
+        with nogil:
+            sn_amp = calc_ylm_wgtd_shotnoise_amp_for_powspec_cpp[
+                GlobalLineOfSight
+            ](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                GlobalLineOfSight(&los_data_axis[0]),
+                GlobalLineOfSight(&los_rand_axis[0]),
+                alpha, ell, m
+            )
+    else:
+        los_data_arr, los_rand_arr = los_data, los_rand
+        with nogil:
+            sn_amp = calc_ylm_wgtd_shotnoise_amp_for_powspec_cpp[
+                StoredLineOfSight
+            ](
+                deref(particles_data.thisptr), deref(particles_rand.thisptr),
+                StoredLineOfSight(<LineOfSight*>&los_data_arr[0, 0]),
+                StoredLineOfSight(<LineOfSight*>&los_rand_arr[0, 0]),
+                alpha, ell, m
+            )
+
+    return sn_amp
@@ -25,7 +25,7 @@
  *
  * Clustering measurement data objects provided include:
  * - binning schemes;
- * - line of sight; and
+ * - line of sight and line-of-sight policies; and
  * - clustering statistics.
  */
 
@@ -164,6 +164,113 @@ struct LineOfSight {
   double pos[3];  ///< 3-d position vector
 };
 
+/// ----------------------------------------------------------------------
+/// Line-of-sight policies
+/// ----------------------------------------------------------------------
+
+/// Line-of-sight policies supply the line of sight to each particle
+/// to the reduced-spherical-harmonic-weighted kernels, which are
+/// templated on the policy type.  The line of sight need not be
+/// normalised as only its direction enters the reduced spherical
+/// harmonics.
+
+/**
+ * @brief Line-of-sight policy reading pre-computed vectors.
+ *
+ */
+struct StoredLineOfSight {
+  const LineOfSight* los;  ///< particle lines of sight
+
+  /**
+   * @brief Construct the policy from stored lines of sight.
+   *
+   * @param los Particle lines of sight.
+   */
+  explicit StoredLineOfSight(const LineOfSight* los): los(los) {}
+
+  /**
+   * @brief Evaluate the line of sight to a particle.
+   *
+   * @param[in] pid Particle index.
+   * @param[in] pos Particle position (unused).
+   * @param[out] los_out Line-of-sight vector.
+   */
+  void eval(int pid, const double pos[3], double los_out[3]) const {
+    los_out[0] = this->los[pid].pos[0];
+    los_out[1] = this->los[pid].pos[1];
+    los_out[2] = this->los[pid].pos[2];
+  }
+};
+
+/**
+ * @brief Line-of-sight policy evaluating the radial direction
+ *        from an observer on the fly.
+ *
+ */
+struct RadialLineOfSight {
+  double observer[3];  ///< observer position
+
+  /**
+   * @brief Construct the policy with the observer at the origin.
+   */
+  RadialLineOfSight(): observer{0., 0., 0.} {}
+
+  /**
+   * @brief Construct the policy from the observer position.
+   *
+   * @param observer Observer position in the particle coordinates.
+   */
+  explicit RadialLineOfSight(const double observer[3]):
+    observer{observer[0], observer[1], observer[2]} {}
+
+  /**
+   * @brief Evaluate the line of sight to a particle.
+   *
+   * @param[in] pid Particle index (unused).
+   * @param[in] pos Particle position.
+   * @param[out] los_out Line-of-sight vector (unnormalised).
+   */
+  void eval(int pid, const double pos[3], double los_out[3]) const {
+    los_out[0] = pos[0] - this->observer[0];
+    los_out[1] = pos[1] - this->observer[1];
+    los_out[2] = pos[2] - this->observer[2];
+  }
+};
+
+/**
+ * @brief Line-of-sight policy with a fixed global axis.
+ *
+ */
+struct GlobalLineOfSight {
+  double axis[3];  ///< line-of-sight axis
+
+  /**
+   * @brief Construct the policy with the global z-axis.
+   */
+  GlobalLineOfSight(): axis{0., 0., 1.} {}
+
+  /**
+   * @brief Construct the policy from the line-of-sight axis.
+   *
+   * @param axis Line-of-sight axis.
+   */
+  explicit GlobalLineOfSight(const double axis[3]):
+    axis{axis[0], axis[1], axis[2]} {}
+
+  /**
+   * @brief Evaluate the line of sight to a particle.
+   *
+   * @param[in] pid Particle index (unused).
+   * @param[in] pos Particle position (unused).
+   * @param[out] los_out Line-of-sight vector.
+   */
+  void eval(int pid, const double pos[3], double los_out[3]) const {
+    los_out[0] = this->axis[0];
+    los_out[1] = this->axis[1];
+    los_out[2] = this->axis[2];
+  }
+};
+
 /// **********************************************************************
 /// Clustering statistics
 /// **********************************************************************
@@ -185,6 +292,24 @@ struct PowspecMeasurements {
   std::vector< std::complex<double> > pk_shot;  ///< power spectrum shot noise
 };
 
+/**
+ * @brief Power spectrum wedge measurements.
+ *
+ * Entries are flattened over (k, μ) bins with the μ-bin index running
+ * fastest.
+ *
+ */
+struct PowspecWedgeMeasurements {
+  std::vector<double> kbin;   ///< central wavenumber in bins
+  std::vector<double> mubin;  ///< central |μ| in bins
+  std::vector<double> keff;   ///< effective wavenumber in bins
+  std::vector<double> mueff;  ///< effective |μ| in bins
+  std::vector<int> nmodes;    ///< number of wavevectors in bins
+  std::vector< std::complex<double> > pk_raw;   ///< power spectrum
+                                                ///< raw measurements
+  std::vector< std::complex<double> > pk_shot;  ///< power spectrum shot noise
+};
+
 /**
  * @brief Two-point correlation function measurements.
  *
@@ -229,6 +354,26 @@ struct BispecMeasurements {
   std::vector< std::complex<double> > bk_shot;  ///< bispectrum shot noise
 };
 
+/**
+ * @brief Bispectrum monopole measurements for all closed triangle
+ *        configurations of wavenumber bins (with f@$ k_1 \leqslant k_2
+ *        \leqslant k_3 f@$).
+ *
+ */
+struct BispecTriangleMeasurements {
+  std::vector<double> k1bin;  ///< first central wavenumber in bins
+  std::vector<double> k2bin;  ///< second central wavenumber in bins
+  std::vector<double> k3bin;  ///< third central wavenumber in bins
+  std::vector<double> k1eff;  ///< first effective wavenumber in bins
+  std::vector<double> k2eff;  ///< second effective wavenumber in bins
+  std::vector<double> k3eff;  ///< third effective wavenumber in bins
+  std::vector<long long> ntriangles;  ///< number of wavevector triangles
+                                      ///< in bins
+  std::vector< std::complex<double> > bk_raw;   ///< bispectrum
+                                                ///< raw measurements
+  std::vector< std::complex<double> > bk_shot;  ///< bispectrum shot noise
+};
+
 /**
  * @brief Three-point correlation function measurements.
  *
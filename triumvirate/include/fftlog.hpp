@@ -31,8 +31,12 @@
 
 #include <fftw3.h>
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include "maths.hpp"
 #include "arrayops.hpp"
@@ -95,6 +99,174 @@ void hankel_transform(
   std::complex<double>* u
 );
 
+/**
+ * @brief Hankel transformer with precomputed FFTLog kernel and plans.
+ *
+ * For a fixed transform order, bias index and set of pre-transform
+ * sample points, the kernel coefficients, post-transform sample points
+ * and FFT plans are computed once on construction, so that repeated
+ * (and batched) transforms only perform the convolution.
+ *
+ * @attention Calls on the same transformer from multiple threads are
+ *            serialised as they share the work buffers; batched
+ *            transforms are parallelised internally.
+ */
+class HankelTransformer {
+ public:
+  double mu;              ///< order of the Hankel transform
+  double q;               ///< FFTLog power-law bias index
+  int N;                  ///< sample number
+  double L;               ///< logarithmic interval
+  double kr_c;            ///< (low-ringing) pivot value
+  std::vector<double> r;  ///< pre-transform sample points
+  std::vector<double> k;  ///< post-transform sample points
+
+  /**
+   * @brief Construct the Hankel transformer.
+   *
+   * @param mu Order of the Hankel transform.
+   * @param q FFTLog power-law bias index.
+   * @param kr_c (Initial) pivot value.
+   * @param N Sample number.
+   * @param lowring Boolean low-ringing condition.
+   * @param r Pre-transform sample points.
+   */
+  HankelTransformer(
+    double mu, double q, double kr_c, int N, bool lowring, const double r[]
+  );
+
+  /**
+   * @brief Destruct the Hankel transformer.
+   */
+  ~HankelTransformer();
+
+  /**
+   * @brief Perform the (forward) Hankel transform.
+   *
+   * This is equivalent to @ref trv::maths::hankel_transform with
+   * the precomputed kernel.
+   *
+   * @param[in] a Pre-transform sample values.
+   * @param[out] b Post-transform sample values.
+   */
+  void transform(const std::complex<double> a[], std::complex<double> b[]);
+
+  /**
+   * @brief Perform batched (forward) Hankel transforms.
+   *
+   * @param[in] nbatch Number of transforms.
+   * @param[in] a Pre-transform sample values in @p nbatch contiguous
+   *              rows of @ref trv::maths::HankelTransformer.N.
+   * @param[out] b Post-transform sample values in the same layout.
+   *
+   * @overload
+   */
+  void transform(
+    int nbatch, const std::complex<double> a[], std::complex<double> b[]
+  );
+
+  /**
+   * @brief Perform batched (forward) spherical Fourier--Bessel
+   *        transforms.
+   *
+   * For real sample values, this is equivalent to
+   * @ref trv::maths::sj_transform with f@$ \ell = \mu - 1/2 f@$ and
+   * f@$ q = 0 f@$, where the dimensional power-law index f@$ n f@$ need
+   * not be an integer, e.g. f@$ n = m + i f@$ in
+   * @ref trv::maths::sj_transform_symm_biased.
+   *
+   * @param[in] n Dimensional power-law index.
+   * @param[in] nbatch Number of transforms.
+   * @param[in] a Pre-transform sample values in @p nbatch contiguous
+   *              rows of @ref trv::maths::HankelTransformer.N.
+   * @param[out] b Post-transform sample values in the same layout.
+   */
+  void sj_transform(double n, int nbatch, const double a[], double b[]);
+
+ private:
+  std::vector< std::complex<double> > u;  ///> kernel coefficients
+  fftw_plan forward_plan;                 ///> forward FFT plan
+  fftw_plan reverse_plan;                 ///> reverse FFT plan
+  int nthreads;                           ///> number of work buffers
+  std::vector<fftw_complex*> work_in;     ///> input work buffers
+                                          ///> (one per thread)
+  std::vector<fftw_complex*> work_out;    ///> output work buffers
+                                          ///> (one per thread)
+  std::mutex work_mutex;                  ///> work buffer lock
+
+  /**
+   * @brief Convolve the input work buffer with the kernel into
+   *        the output work buffer.
+   *
+   * The output is in reverse order of the post-transform sample points.
+   *
+   * @param ibuf Work buffer index.
+   */
+  void convolve(int ibuf);
+};
+
+/**
+ * @brief Two-dimensional Hankel transformer with precomputed FFTLog
+ *        kernels and plans.
+ *
+ * For samples on a square grid with the same log-linearly spaced sample
+ * points in both dimensions, the transform is separated into batched
+ * transforms along the rows (second dimension) and then along the
+ * columns (first dimension), each with its own
+ * @ref trv::maths::HankelTransformer.
+ *
+ * @attention Calls on the same transformer from multiple threads are
+ *            serialised as they share the work buffers; batched
+ *            transforms are parallelised internally.
+ */
+class BiHankelTransformer {
+ public:
+  int N;                  ///< sample number (in each dimension)
+  std::vector<double> k;  ///< post-transform sample points
+                          ///< (in each dimension)
+
+  /**
+   * @brief Construct the two-dimensional Hankel transformer.
+   *
+   * @param mu1 Order of the Hankel transform in the first dimension.
+   * @param mu2 Order of the Hankel transform in the second dimension.
+   * @param q FFTLog power-law bias index.
+   * @param kr_c (Initial) pivot value.
+   * @param N Sample number (in each dimension).
+   * @param lowring Boolean low-ringing condition.
+   * @param r Pre-transform sample points (in each dimension).
+   */
+  BiHankelTransformer(
+    double mu1, double mu2, double q, double kr_c, int N, bool lowring,
+    const double r[]
+  );
+
+  /**
+   * @brief Perform the (forward) two-dimensional spherical
+   *        Fourier--Bessel transform.
+   *
+   * This is the spherical Fourier--Bessel transform in
+   * @ref trv::maths::HankelTransformer::sj_transform applied in both
+   * dimensions, i.e.
+   * f@[
+   *   b(k_1, k_2) = (2\pi)^{-3} (k_1 k_2)^{-3/2}
+   *     \int_0^\infty k_1 \mathrm{d}r_1 \, r_1^{n - 1/2}
+   *       J_{\mu_1}(k_1 r_1)
+   *     \int_0^\infty k_2 \mathrm{d}r_2 \, r_2^{n - 1/2}
+   *       J_{\mu_2}(k_2 r_2) \, a(r_1, r_2) \,.
+   * f@]
+   *
+   * @param[in] n Dimensional power-law index.
+   * @param[in] a Pre-transform sample values (in row-major order).
+   * @param[out] b Post-transform sample values (in row-major order).
+   */
+  void sj_transform(double n, const double a[], double b[]);
+
+ private:
+  HankelTransformer transformer_row;  ///> transformer along rows
+  HankelTransformer transformer_col;  ///> transformer along columns
+};
+
 /**
  * @brief Perform the (forward) spherical Fourier--Bessel transform.
  *
@@ -192,6 +364,64 @@ void transform_corrfunc_to_powspec_multipole(
   int ell, int N, double* r, double* xi, double* k, double* pk
 );
 
+/**
+ * @brief Transform bispectrum to three-point correlation function
+ *        samples.
+ *
+ * The bispectrum is sampled on a square grid with the same log-linearly
+ * spaced wavenumbers in both dimensions, and may be extrapolated at
+ * either end before the transform.
+ *
+ * @param[in] ell1, ell2 Multipole degrees.
+ * @param[in] N Sample number (in each dimension).
+ * @param[in] k Wavenumber sample points.
+ * @param[in] bk Bispectrum samples (in row-major order).
+ * @param[in] N_ext Extrapolation number on either end
+ *                  (in each dimension).
+ * @param[in] extrap Extrapolation scheme, one of {"lin", "loglin",
+ *                   "zero"} (ignored if @p N_ext is zero).
+ * @param[out] r Separation sample points (of length
+ *               @p N + 2 * @p N_ext).
+ * @param[out] zeta Three-point correlation function samples
+ *                  (in row-major order).
+ * @throws trv::sys::InvalidParameter When @p extrap is unrecognised.
+ * @throws trv::sys::ExtrapError When the log-linear extrapolation
+ *                               fails.
+ */
+void transform_bispec_to_3pcf(
+  int ell1, int ell2, int N, double* k, double* bk,
+  int N_ext, const std::string& extrap, double* r, double* zeta
+);
+
+/**
+ * @brief Transform three-point correlation function to bispectrum
+ *        samples.
+ *
+ * The three-point correlation function is sampled on a square grid
+ * with the same log-linearly spaced separations in both dimensions,
+ * and may be extrapolated at either end before the transform.
+ *
+ * @param[in] ell1, ell2 Multipole degrees.
+ * @param[in] N Sample number (in each dimension).
+ * @param[in] r Separation sample points.
+ * @param[in] zeta Three-point correlation function samples
+ *                 (in row-major order).
+ * @param[in] N_ext Extrapolation number on either end
+ *                  (in each dimension).
+ * @param[in] extrap Extrapolation scheme, one of {"lin", "loglin",
+ *                   "zero"} (ignored if @p N_ext is zero).
+ * @param[out] k Wavenumber sample points (of length
+ *               @p N + 2 * @p N_ext).
+ * @param[out] bk Bispectrum samples (in row-major order).
+ * @throws trv::sys::InvalidParameter When @p extrap is unrecognised.
+ * @throws trv::sys::ExtrapError When the log-linear extrapolation
+ *                               fails.
+ */
+void transform_3pcf_to_bispec(
+  int ell1, int ell2, int N, double* r, double* zeta,
+  int N_ext, const std::string& extrap, double* k, double* bk
+);
+
 }  // namespace trv
 
 #endif  // !TRIUMVIRATE_INCLUDE_FFTLOG_HPP_INCLUDED_
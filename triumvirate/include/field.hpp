@@ -32,6 +32,10 @@
  * compute various constituent terms (one-point and pseudo two-point
  * statistics) in the estimators of two- and three-point statistics.
  *
+ * With MPI enabled, mesh fields are slab-decomposed along the first
+ * dimension across tasks, and pseudo two-point statistics are reduced
+ * across tasks.
+ *
  */
 
 #ifndef TRIUMVIRATE_INCLUDE_FIELD_HPP_INCLUDED_
@@ -39,8 +43,20 @@
 
 #include <fftw3.h>
 
+#ifdef TRV_USE_MPI
+#include <fftw3-mpi.h>
+#endif  // TRV_USE_MPI
+
+#include <algorithm>
 #include <cmath>
 #include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "monitor.hpp"
@@ -69,6 +85,11 @@ class MeshField {
   double dk[3];              ///> fundamental wavenumber in each dimension
   double vol;                ///> mesh volume
   double vol_cell;           ///> mesh grid cell volume
+  int local_x_begin;         ///> first grid index in the first dimension
+                             ///> of the local slab
+  int local_x_end;           ///> past-the-end grid index in the first
+                             ///> dimension of the local slab
+  int local_nmesh;           ///> number of local mesh grid cells
 
   /// --------------------------------------------------------------------
   /// Life cycle
@@ -77,6 +98,9 @@ class MeshField {
   /**
    * @brief Construct the mesh field.
    *
+   * Without MPI, the local slab is the full mesh; otherwise the slab
+   * decomposition is determined by FFTW.
+   *
    * @param params Parameter set.
    */
   MeshField(trv::ParameterSet& params);
@@ -110,7 +134,7 @@ class MeshField {
   /**
    * @brief Return mesh field grid cell value.
    *
-   * @param gid Grid index.
+   * @param gid (Local) grid index.
    * @returns Field value.
    */
   const fftw_complex& operator[](int gid);
@@ -129,6 +153,20 @@ class MeshField {
     ParticleCatalogue& particles, fftw_complex* weights
   );
 
+  /**
+   * @brief Add a weighted field to a mesh by interpolation scheme.
+   *
+   * Unlike @ref trv::MeshField::assign_weighted_field_to_mesh, existing
+   * field values are not reset, so that particles may be assigned
+   * in chunks.
+   *
+   * @param particles Particle catalogue.
+   * @param weights Weight field.
+   */
+  void add_weighted_field_to_mesh(
+    ParticleCatalogue& particles, fftw_complex* weights
+  );
+
   /// --------------------------------------------------------------------
   /// Field computations
   /// --------------------------------------------------------------------
@@ -189,17 +227,21 @@ class MeshField {
    * @note See eq. (34) in Sugiyama et al. (2019)
    *       [<a href="https://arxiv.org/abs/1803.02132">1803.02132</a>].
    *
+   * @tparam LoSPolicy Line-of-sight policy type.
    * @param particles_data (Data-source) particle catalogue.
-   * @param particles_rand (Random-source) particle catalogue.
-   * @param los_data (Data-source) particle lines of sight.
-   * @param los_rand (Random-source) particle lines of sight.
+   * @param particles_rand (Random-source) particle catalogue.  If a
+   *                       @ref trv::RandomMeshCache is attached, its
+   *                       field is read from the cache.
+   * @param los_data (Data-source) line-of-sight policy.
+   * @param los_rand (Random-source) line-of-sight policy.
    * @param alpha Alpha contrast.
    * @param ell Degree of the spherical harmonic.
    * @param m Order of the spherical harmonic.
    */
+  template <class LoSPolicy>
   void compute_ylm_wgtd_field(
     ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
-    LineOfSight* los_data, LineOfSight* los_rand,
+    LoSPolicy los_data, LoSPolicy los_rand,
     double alpha, int ell, int m
   );
 
@@ -207,19 +249,43 @@ class MeshField {
    * @brief Compute the weighted field further weighted by the
    *        reduced spherical harmonics.
    *
+   * @tparam LoSPolicy Line-of-sight policy type.
    * @param particles Particle catalogue.
-   * @param los Particle lines of sight.
+   * @param los Line-of-sight policy.
    * @param alpha Alpha contrast.
    * @param ell Degree of the spherical harmonic.
    * @param m Order of the spherical harmonic.
    *
    * @overload
    */
+  template <class LoSPolicy>
   void compute_ylm_wgtd_field(
-    ParticleCatalogue& particles, LineOfSight* los,
+    ParticleCatalogue& particles, LoSPolicy los,
     double alpha, int ell, int m
   );
 
+  /**
+   * @brief Add to the field a weighted field further weighted by the
+   *        reduced spherical harmonics.
+   *
+   * Existing field values are not reset, so that this may be called
+   * for successive chunks of a streamed particle catalogue
+   * (see @ref trv::ParticleCatalogueStream).
+   *
+   * @tparam LoSPolicy Line-of-sight policy type.
+   * @param particles Particle catalogue (chunk).
+   * @param los Line-of-sight policy.
+   * @param weight Overall weight, e.g. f@$ -\alpha f@$ for
+   *               the random-source catalogue.
+   * @param ell Degree of the spherical harmonic.
+   * @param m Order of the spherical harmonic.
+   */
+  template <class LoSPolicy>
+  void add_ylm_wgtd_field(
+    ParticleCatalogue& particles, LoSPolicy los,
+    double weight, int ell, int m
+  );
+
   /**
    * @brief Compute the quadratic weighted field (fluctuations) further
    *        weighted by the reduced spherical harmonics.
@@ -243,17 +309,21 @@ class MeshField {
    * @note See eq. (46) in Sugiyama et al. (2019)
    *       [<a href="https://arxiv.org/abs/1803.02132">1803.02132</a>].
    *
+   * @tparam LoSPolicy Line-of-sight policy type.
    * @param particles_data (Data-source) particle catalogue.
-   * @param particles_rand (Random-source) particle catalogue.
-   * @param los_data (Data-source) particle lines of sight.
-   * @param los_rand (Random-source) particle lines of sight.
+   * @param particles_rand (Random-source) particle catalogue.  If a
+   *                       @ref trv::RandomMeshCache is attached, its
+   *                       field is read from the cache.
+   * @param los_data (Data-source) line-of-sight policy.
+   * @param los_rand (Random-source) line-of-sight policy.
    * @param alpha Alpha contrast.
    * @param ell Degree of the spherical harmonic.
    * @param m Order of the spherical harmonic.
    */
+  template <class LoSPolicy>
   void compute_ylm_wgtd_quad_field(
     ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
-    LineOfSight* los_data, LineOfSight* los_rand,
+    LoSPolicy los_data, LoSPolicy los_rand,
     double alpha, int ell, int m
   );
 
@@ -261,19 +331,41 @@ class MeshField {
    * @brief Compute the quadratic weighted field (fluctuations) further
    *        weighted by the reduced spherical harmonics.
    *
+   * @tparam LoSPolicy Line-of-sight policy type.
    * @param particles Particle catalogue.
-   * @param los Particle lines of sight.
+   * @param los Line-of-sight policy.
    * @param alpha Alpha contrast.
    * @param ell Degree of the spherical harmonic.
    * @param m Order of the spherical harmonic.
    *
    * @overload
    */
+  template <class LoSPolicy>
   void compute_ylm_wgtd_quad_field(
-    ParticleCatalogue& particles, LineOfSight* los,
+    ParticleCatalogue& particles, LoSPolicy los,
     double alpha, int ell, int m
   );
 
+  /**
+   * @brief Add to the field a quadratic weighted field further weighted
+   *        by the reduced spherical harmonics.
+   *
+   * Existing field values are not reset (cf. @ref add_ylm_wgtd_field).
+   *
+   * @tparam LoSPolicy Line-of-sight policy type.
+   * @param particles Particle catalogue (chunk).
+   * @param los Line-of-sight policy.
+   * @param weight Overall weight, e.g. f@$ \alpha^2 f@$ for
+   *               the random-source catalogue.
+   * @param ell Degree of the spherical harmonic.
+   * @param m Order of the spherical harmonic.
+   */
+  template <class LoSPolicy>
+  void add_ylm_wgtd_quad_field(
+    ParticleCatalogue& particles, LoSPolicy los,
+    double weight, int ell, int m
+  );
+
   /// --------------------------------------------------------------------
   /// Field transforms
   /// --------------------------------------------------------------------
@@ -284,7 +376,8 @@ class MeshField {
    * If @ref trv::MeshField.params.interlace is set to "true", interlacing
    * is performed where a phase factor is multiplied into the 'shadow'
    * complex field before the average of the complex field and its shadow
-   * is taken.
+   * is taken.  The field and its shadow are transformed together in
+   * a single batched FFT.
    */
   void fourier_transform();
 
@@ -311,6 +404,19 @@ class MeshField {
    */
   void apply_assignment_compensation();
 
+  /**
+   * @brief Resample a Fourier-space field onto this (coarser) mesh grid.
+   *
+   * Each wavevector mode representable on this mesh grid takes the
+   * value of the same mode of the finer field; higher modes are
+   * discarded.
+   *
+   * @param field_fourier A Fourier-space field with the same box size
+   *                      and at least as many grid cells in each
+   *                      dimension.
+   */
+  void resample_fourier_field(MeshField& field_fourier);
+
   /// --------------------------------------------------------------------
   /// One-point statistics
   /// --------------------------------------------------------------------
@@ -339,11 +445,30 @@ class MeshField {
    * @param[out] nmodes Number of wavevector modes in band.
    */
   void inv_fourier_transform_ylm_wgtd_field_band_limited(
-    MeshField& field_fourier, std::vector< std::complex<double> >& ylm,
+    MeshField& field_fourier, const std::vector< std::complex<double> >& ylm,
     double k_band, double dk_band,
     double& k_eff, int& nmodes
   );
 
+  /**
+   * @brief Inverse Fourier transform the unit field restricted to a
+   *        wavenumber band.
+   *
+   * This is the band indicator function averaged over the wavevector
+   * modes in the band (with the same mode subsampling as
+   * @ref trv::MeshField::inv_fourier_transform_ylm_wgtd_field_band_limited),
+   * whose mesh products count closed wavevector configurations,
+   * e.g. triangles for the bispectrum.
+   *
+   * @param[in] k_lower Band lower wavenumber.
+   * @param[in] k_upper Band upper wavenumber.
+   * @param[out] k_eff Effective band wavenumber.
+   * @param[out] nmodes Number of wavevector modes in band.
+   */
+  void inv_fourier_transform_unit_field_band_limited(
+    double k_lower, double k_upper, double& k_eff, int& nmodes
+  );
+
   /**
    * @brief Inverse Fourier transform a field f@$ f f@$ weighted by the
    *        spherical Bessel function and reduced spherical harmonics.
@@ -366,7 +491,7 @@ class MeshField {
    */
   void inv_fourier_transform_sjl_ylm_wgtd_field(
     MeshField& field_fourier,
-    std::vector< std::complex<double> >& ylm,
+    const std::vector< std::complex<double> >& ylm,
     trvm::SphericalBesselCalculator& sjl,
     double r
   );
@@ -391,16 +516,71 @@ class MeshField {
  private:
   fftw_complex* field_s = nullptr;  ///> half-grid shifted complex field on mesh
 
+  int local_nalloc;  ///> number of locally allocated mesh grid cells
+
+  /// CAVEAT: Ghost planes on either side of the local slab must cover
+  /// the assignment stencil (up to order 4) of any particle in the slab
+  /// including the interlacing half-grid shift.
+  static const int ghost_width = 3;  ///> number of ghost planes on
+                                     ///> either side of the local slab
+
+  std::vector<int> slab_begins;  ///> first grid index of each task's slab
+  std::vector<int> slab_ends;    ///> past-the-end grid index of each
+                                 ///> task's slab
+  std::vector<int> plane_tasks;  ///> owning task of each grid plane
+
+  fftw_complex* field_ghost = nullptr;    ///> ghost planes of the field
+  fftw_complex* field_s_ghost = nullptr;  ///> ghost planes of the shadow
+                                          ///> field
+
+  int nslots;               ///> number of co-allocated field arrays
+                            ///> (2 if interlacing is used, else 1)
+  bool owns_field = true;   ///> whether the field storage is owned (or
+                            ///> attached by a mesh field batch)
+  bool real_valued = true;  ///> whether the field is real in configuration
+                            ///> space (i.e. Hermitian-symmetric in
+                            ///> Fourier space)
+
+  /// Fourier-space mode entry in the sparse shell mode list.
+  struct ShellMode {
+    double kmag;    ///> wavenumber
+    int i, j, k;    ///> grid index in each dimension
+    short mult;     ///> Hermitian multiplicity
+    bool retained;  ///> whether the mode is retained under subsampling
+  };
+
+  typedef std::vector<
+    ShellMode, trv::sys::TrackingAllocator<ShellMode, trv::sys::MEM_MODES>
+  > ShellModeList;  ///> tracked list of shell modes
+
+  ShellModeList shell_modes;       ///> modes sorted by wavenumber
+  double shell_modes_kmax = -1.;   ///> maximum indexed wavenumber
+  bool shell_modes_half_space = false;  ///> whether modes are indexed
+                                        ///> over the half space
+
   friend class FieldStats;
+  friend class MeshFieldBatch;
+  friend class RandomMeshCache;
+
+  /**
+   * @brief Construct the mesh field with or without allocating
+   *        the field storage.
+   *
+   * @param params Parameter set.
+   * @param alloc If @c false, the field storage is left unallocated
+   *              and attached by @ref trv::MeshFieldBatch.
+   */
+  MeshField(trv::ParameterSet& params, bool alloc);
 
   /// --------------------------------------------------------------------
   /// Mesh grid properties
   /// --------------------------------------------------------------------
 
   /**
-   * @brief Return the grid cell index.
+   * @brief Return the (local) grid cell index.
    *
-   * @param i, j, k Grid index in each dimension.
+   * @param i, j, k Grid index in each dimension, where @p i is global
+   *                and must lie in the local slab.
    * @returns Grid cell index.
    */
   long long get_grid_index(int i, int j, int k);
@@ -421,52 +601,354 @@ class MeshField {
    */
   void get_grid_wavevector(int i, int j, int k, double kvec[3]);
 
+  /**
+   * @brief Return the grid index in one dimension of another mesh
+   *        field with the same wavevector.
+   *
+   * @param idx Grid index in the dimension.
+   * @param axis Dimension {0, 1, 2}.
+   * @param other Another mesh field with the same box size and
+   *              at least as many grid cells in the dimension.
+   * @returns Grid index in the dimension for @p other.
+   */
+  int get_fourier_grid_index(int idx, int axis, MeshField& other);
+
+  /**
+   * @brief Return the multiplicity of a grid cell in the half-space
+   *        iteration over Fourier-space modes.
+   *
+   * Each pair of grid cells at f@$ \pm\vec{k} f@$ is represented by the
+   * cell in the lower half of the last dimension.  Cells on the
+   * zero and Nyquist planes of the last dimension, and cells on the
+   * Nyquist planes of the first two dimensions (where e.g. interlaced
+   * fields are not Hermitian-symmetric), represent only themselves.
+   *
+   * @param i, j, k Grid index in each dimension.
+   * @returns 2 if the cell represents itself and its partner,
+   *          1 if only itself, and 0 if it is represented by its
+   *          partner.
+   */
+  int get_hermitian_multiplicity(int i, int j, int k);
+
+  /**
+   * @brief Return the (local) grid cell index of the partner grid cell
+   *        at the opposite wavevector (or position vector).
+   *
+   * @param i, j, k Grid index in each dimension.
+   * @returns Grid cell index of the partner, which must lie in
+   *          the local slab.
+   */
+  long long get_hermitian_partner_index(int i, int j, int k);
+
+  /**
+   * @brief Check whether the whole mesh lies in the local slab, so that
+   *        partner grid cells of the half-space iteration can be
+   *        written to.
+   *
+   * @returns Whether the local slab is the whole mesh.
+   */
+  bool if_mesh_local();
+
+  /**
+   * @brief Check whether a grid cell is retained under deterministic
+   *        Fourier-space mode subsampling.
+   *
+   * Cells are selected by hashing the global grid index of the
+   * canonical cell of each Hermitian pair, so the selection is
+   * reproducible across runs, tasks and threads, and the modes at
+   * ±k are retained or discarded together.
+   *
+   * @param i, j, k Grid index in each dimension.
+   * @returns Whether the cell is retained at the rate
+   *          @ref trv::ParameterSet::subsample_frac.
+   */
+  bool if_mode_retained(int i, int j, int k);
+
+  /**
+   * @brief Check whether a band of indexed shell modes is subsampled.
+   *
+   * A band with lower edge at or above
+   * @ref trv::ParameterSet::subsample_kmin is subsampled unless none
+   * of its modes would be retained, in which case all modes are kept
+   * so that the band average remains defined.
+   *
+   * @param k_lower Lower wavenumber limit of the band.
+   * @param imode_begin, imode_end Range of shell mode indices
+   *                               in the band.
+   * @returns Whether the band is subsampled.
+   */
+  bool if_band_subsampled(
+    double k_lower, long long imode_begin, long long imode_end
+  );
+
+  /**
+   * @brief Index the (local) Fourier-space modes up to a maximum
+   *        wavenumber in a sparse list sorted by wavenumber.
+   *
+   * @param k_max Maximum wavenumber.
+   * @param half_space Whether to index only one mode of each
+   *                   Hermitian pair (with its multiplicity).
+   */
+  void index_shell_modes(double k_max, bool half_space);
+
+  /**
+   * @brief Plan an in-place 3-d discrete Fourier transform of
+   *        a (local) mesh array.
+   *
+   * The plan uses all available threads and is created holding
+   * the FFTW planner lock.
+   *
+   * @param arr Mesh array (with the local slab layout).
+   * @param sign Transform sign {@c FFTW_FORWARD, @c FFTW_BACKWARD}.
+   * @returns FFTW plan (distributed if MPI is enabled).
+   *
+   * @see trv::sys::lock_fftw_planner
+   */
+  fftw_plan plan_dft_3d(fftw_complex* arr, int sign);
+
+  /**
+   * @brief Destroy an FFTW plan holding the FFTW planner lock.
+   *
+   * @param plan FFTW plan.
+   */
+  static void destroy_plan(fftw_plan plan);
+
+  /**
+   * @brief Return the cached FFTW plan of in-place 3-d discrete
+   *        Fourier transforms of co-allocated (local) mesh arrays,
+   *        or plan and cache it if missing.
+   *
+   * Plans are keyed on the mesh grid, the array layout, the transform
+   * sign, the number of threads and the array alignment, and are kept
+   * for the lifetime of the program, so that transforms of the same
+   * mesh (e.g. for successive catalogues in a batch) reuse them with
+   * @c fftw_execute_dft.
+   *
+   * @param arr First mesh array.
+   * @param howmany Number of mesh arrays.
+   * @param dist Offset between successive mesh arrays (ignored if
+   *             @p howmany is 1).
+   * @param sign Transform sign {@c FFTW_FORWARD, @c FFTW_BACKWARD}.
+   * @returns FFTW plan (owned by the cache and distributed if MPI
+   *          is enabled and @p howmany is 1).
+   */
+  fftw_plan get_cached_plan(
+    fftw_complex* arr, int howmany, long long dist, int sign
+  );
+
+  /**
+   * @brief Execute an in-place 3-d discrete Fourier transform of
+   *        a (local) mesh array with a cached plan.
+   *
+   * @param arr Mesh array (with the local slab layout).
+   * @param sign Transform sign {@c FFTW_FORWARD, @c FFTW_BACKWARD}.
+   *
+   * @see trv::MeshField::get_cached_plan
+   */
+  void execute_dft_3d(fftw_complex* arr, int sign);
+
+  /**
+   * @brief Execute in-place 3-d discrete Fourier transforms of
+   *        multiple co-allocated (local) mesh arrays.
+   *
+   * Without MPI, the arrays are transformed with a single
+   * @c fftw_plan_many_dft plan; otherwise each array is transformed
+   * with its own distributed plan.
+   *
+   * @param arr First mesh array.
+   * @param howmany Number of mesh arrays.
+   * @param dist Offset between successive mesh arrays.
+   * @param sign Transform sign {@c FFTW_FORWARD, @c FFTW_BACKWARD}.
+   */
+  void execute_many_dft_3d(
+    fftw_complex* arr, int howmany, long long dist, int sign
+  );
+
+  /// --------------------------------------------------------------------
+  /// Field transforms
+  /// --------------------------------------------------------------------
+
+  /**
+   * @brief Inverse Fourier transform the field whose non-zero modes
+   *        lie within a bounding wavenumber along each dimension.
+   *
+   * The transform is performed one dimension at a time, skipping
+   * pencils which are entirely zero in the first two stages (without
+   * MPI).  No volume normalisation is applied.
+   *
+   * @param k_max Bounding wavenumber (of the shell).
+   */
+  void inv_fourier_transform_pruned(double k_max);
+
+  /**
+   * @brief Apply the FFT volume normalisation to the field (and its
+   *        shadow if interlacing is used).
+   */
+  void apply_fourier_volume_normalisation();
+
+  /**
+   * @brief Apply the inverse FFT volume normalisation to the field.
+   */
+  void apply_inv_fourier_volume_normalisation();
+
+  /**
+   * @brief Interlace the (FFT-transformed) field with its shadow.
+   */
+  void apply_interlacing();
+
   /// --------------------------------------------------------------------
   /// Mesh assignment
   /// --------------------------------------------------------------------
 
+  /**
+   * @brief Locate the task owning a particle, i.e. the task whose slab
+   *        holds the grid plane into which the particle falls.
+   *
+   * @param pos Particle position.
+   * @returns Owning task.
+   */
+  int locate_particle_task(const double pos[3]);
+
+  /**
+   * @brief Locate the mesh grid cell (in the local slab or its ghost
+   *        planes) to which a particle is assigned.
+   *
+   * @param i, j, k Global grid index in each dimension.
+   * @param shadow Whether the cell is in the shadow field.
+   * @returns Pointer to the grid cell value, or @c nullptr if the
+   *          flattened grid index is out of bounds.
+   */
+  fftw_complex* locate_assignment_cell(int i, int j, int k, bool shadow);
+
+  /**
+   * @brief Send assigned ghost-plane values to their owning tasks and
+   *        add received ghost-plane values to the local slab.
+   *
+   * @param arr Mesh array (with the local slab layout).
+   * @param ghost Ghost planes of the mesh array.
+   */
+  void reduce_ghost_planes(fftw_complex* arr, fftw_complex* ghost);
+
+  /**
+   * @brief Add a weighted field to a mesh by interpolation scheme,
+   *        with particle weights evaluated on the fly.
+   *
+   * @tparam WeightKern Weight kernel type callable as
+   *                    @c std::complex<double>(int pid).
+   * @param particles Particle catalogue.
+   * @param weight_kern Particle weight kernel.
+   */
+  template <class WeightKern>
+  void add_kernel_weighted_field_to_mesh(
+    ParticleCatalogue& particles, WeightKern weight_kern
+  );
+
+  /**
+   * @brief Exchange particles, with their weights evaluated, to the
+   *        tasks owning them.
+   *
+   * Each task evaluates the weights of an equal share of the particles
+   * and sends them to their owning tasks (see
+   * @ref trv::MeshField::locate_particle_task), so that each task
+   * keeps only the particles in its slab for assignment.  Assignment
+   * stencils straddling a slab boundary are covered by ghost planes.
+   *
+   * @tparam WeightKern Weight kernel type callable as
+   *                    @c std::complex<double>(int pid).
+   * @param[in] particles Particle catalogue.
+   * @param[in] weight_kern Particle weight kernel.
+   * @param[out] particles_owned Owned particles (with positions only).
+   * @param[out] weights_owned Weights of owned particles.
+   */
+  template <class WeightKern>
+  void exchange_particles_to_slabs(
+    ParticleCatalogue& particles, WeightKern weight_kern,
+    ParticleCatalogue& particles_owned,
+    std::vector< std::complex<double> >& weights_owned
+  );
+
+  /**
+   * @brief Assign weighted field to a mesh by the interpolation scheme
+   *        set in the parameters.
+   *
+   * @tparam WeightKern Weight kernel type callable as
+   *                    @c std::complex<double>(int pid).
+   * @param particles Particle catalogue.
+   * @param weight_kern Particle weight kernel.
+   * @throws trv::sys::InvalidParameter When the assignment scheme is
+   *                                    unsupported.
+   */
+  template <class WeightKern>
+  void assign_weighted_field_to_mesh_by_scheme(
+    ParticleCatalogue& particles, WeightKern weight_kern
+  );
+
   /**
    * @brief Assign weighted field to a mesh by the nearest-grid-point
    *        (NGP) scheme.
    *
+   * The mesh and its interlaced shadow (if used) are assigned
+   * in the same pass over particles.
+   *
+   * @tparam WeightKern Weight kernel type callable as
+   *                    @c std::complex<double>(int pid).
    * @param particles Particle catalogue.
-   * @param weight Particle weights.
+   * @param weight_kern Particle weight kernel.
    */
+  template <class WeightKern>
   void assign_weighted_field_to_mesh_ngp(
-    ParticleCatalogue& particles, fftw_complex* weight
+    ParticleCatalogue& particles, WeightKern weight_kern
   );
 
   /**
    * @brief Assign weighted field to a mesh by the cloud-in-cell
    *        (CIC) scheme.
    *
+   * The mesh and its interlaced shadow (if used) are assigned
+   * in the same pass over particles.
+   *
+   * @tparam WeightKern Weight kernel type callable as
+   *                    @c std::complex<double>(int pid).
    * @param particles Particle catalogue.
-   * @param weight Particle weights.
+   * @param weight_kern Particle weight kernel.
    */
+  template <class WeightKern>
   void assign_weighted_field_to_mesh_cic(
-    ParticleCatalogue& particles, fftw_complex* weight
+    ParticleCatalogue& particles, WeightKern weight_kern
   );
 
   /**
    * @brief Assign weighted field to a mesh by the triangular-shaped-cloud
    *        (TSC) scheme.
    *
+   * The mesh and its interlaced shadow (if used) are assigned
+   * in the same pass over particles.
+   *
+   * @tparam WeightKern Weight kernel type callable as
+   *                    @c std::complex<double>(int pid).
    * @param particles Particle catalogue.
-   * @param weight Particle weights.
+   * @param weight_kern Particle weight kernel.
    */
+  template <class WeightKern>
   void assign_weighted_field_to_mesh_tsc(
-    ParticleCatalogue& particles, fftw_complex* weight
+    ParticleCatalogue& particles, WeightKern weight_kern
   );
 
   /**
    * @brief Assign weighted field to a mesh by the piecewise cubib spline
    *        (PCS) scheme.
    *
+   * The mesh and its interlaced shadow (if used) are assigned
+   * in the same pass over particles.
+   *
+   * @tparam WeightKern Weight kernel type callable as
+   *                    @c std::complex<double>(int pid).
    * @param particles Particle catalogue.
-   * @param weight Particle weights.
+   * @param weight_kern Particle weight kernel.
    */
+  template <class WeightKern>
   void assign_weighted_field_to_mesh_pcs(
-    ParticleCatalogue& particles, fftw_complex* weight
+    ParticleCatalogue& particles, WeightKern weight_kern
   );
 
   /**
@@ -480,6 +962,311 @@ class MeshField {
 };
 
 
+/// **********************************************************************
+/// Mesh field batch
+/// **********************************************************************
+
+/**
+ * @brief Batch of co-allocated mesh fields of the same kind.
+ *
+ * The fields (each followed by its shadow if interlacing is used) are
+ * stored in a single contiguous block so that they can be transformed
+ * together with a single batched FFT plan.
+ *
+ */
+class MeshFieldBatch {
+ public:
+  trv::ParameterSet params;  ///> parameter set
+  int nfields;               ///> number of mesh fields
+
+  /// --------------------------------------------------------------------
+  /// Life cycle
+  /// --------------------------------------------------------------------
+
+  /**
+   * @brief Construct the mesh field batch.
+   *
+   * @param params Parameter set.
+   * @param nfields Number of mesh fields.
+   */
+  MeshFieldBatch(trv::ParameterSet& params, int nfields);
+
+  /**
+   * @brief Destruct the mesh field batch.
+   */
+  ~MeshFieldBatch();
+
+  /// --------------------------------------------------------------------
+  /// Operators & reserved methods
+  /// --------------------------------------------------------------------
+
+  /**
+   * @brief Return a mesh field in the batch.
+   *
+   * @param ifield Field index.
+   * @returns Mesh field.
+   */
+  MeshField& operator[](int ifield);
+
+  /// --------------------------------------------------------------------
+  /// Field transforms
+  /// --------------------------------------------------------------------
+
+  /**
+   * @brief Fourier transform all fields in the batch.
+   *
+   * @see trv::MeshField::fourier_transform
+   */
+  void fourier_transform();
+
+  /**
+   * @brief Inverse Fourier transform all (FFT-transformed) fields
+   *        in the batch.
+   *
+   * @see trv::MeshField::inv_fourier_transform
+   */
+  void inv_fourier_transform();
+
+ private:
+  std::vector<MeshField*> fields;  ///> mesh fields attached to the batch
+  fftw_complex* field_block = nullptr;  ///> co-allocated field storage
+  long long field_dist;  ///> offset between successive fields
+};
+
+
+/// **********************************************************************
+/// Random mesh cache
+/// **********************************************************************
+
+/**
+ * @brief Disk cache of random-source meshes and sums shared by
+ *        data-source catalogues.
+ *
+ * Random-source fields weighted by the reduced spherical harmonics
+ * (without the alpha contrast), together with normalisation and
+ * shot-noise sums and the catalogue summary, are saved under a file
+ * prefix keyed on the content hash of the random catalogue file and
+ * the alignment parameters; mesh files are further keyed on the mesh
+ * parameters and the resulting box alignment.  A catalogue restored
+ * from the cache holds only summary information, and cached meshes are
+ * memory-mapped and added to data-source fields.  Any entry missing
+ * from the cache triggers a one-off reload of the random catalogue to
+ * compute and save it.
+ *
+ * @note Fields and shot-noise sums are only cached with the radial
+ *       line of sight (as in the Triumvirate program) and otherwise
+ *       computed from the catalogue as usual.
+ *
+ */
+class RandomMeshCache {
+ public:
+  std::string prefix;  ///< cache file path prefix
+
+  /// --------------------------------------------------------------------
+  /// Life cycle
+  /// --------------------------------------------------------------------
+
+  /**
+   * @brief Construct the random mesh cache by hashing the random
+   *        catalogue file and reading any saved entries.
+   *
+   * @param params Parameter set (with the random catalogue file and
+   *               the cache directory).
+   */
+  RandomMeshCache(trv::ParameterSet& params);
+
+  /**
+   * @brief Restore the summary information of the random-source
+   *        catalogue from the cache and attach the cache to it.
+   *
+   * @param[out] particles (Random-source) particle catalogue.
+   * @returns Whether the cached summary is found.
+   */
+  bool restore_catalogue(ParticleCatalogue& particles);
+
+  /**
+   * @brief Attach the cache to a loaded (but not yet aligned)
+   *        random-source catalogue and save its summary information.
+   *
+   * @param particles (Random-source) particle catalogue.
+   */
+  void attach_catalogue(ParticleCatalogue& particles);
+
+  /**
+   * @brief Load the particle data of a restored catalogue.
+   *
+   * The catalogue file is reloaded and offset to the tracked observer
+   * position, so that particle positions follow any box alignment
+   * applied to the summary information.  This is a no-op if particle
+   * data are already loaded.
+   *
+   * @param particles (Random-source) particle catalogue.
+   */
+  void load_particles(ParticleCatalogue& particles);
+
+  /// --------------------------------------------------------------------
+  /// Cache entries
+  /// --------------------------------------------------------------------
+
+  /**
+   * @brief Find a cached value.
+   *
+   * @param[in] name Value name.
+   * @param[out] value Cached value.
+   * @returns Whether the value is found.
+   */
+  bool find_value(const std::string& name, std::complex<double>& value);
+
+  /**
+   * @brief Save a value to the cache.
+   *
+   * @param name Value name.
+   * @param value Value.
+   */
+  void save_value(const std::string& name, std::complex<double> value);
+
+  /**
+   * @brief Return a cached value, or compute and save it if missing.
+   *
+   * @tparam ComputeFunc Callable type returning the value.
+   * @param name Value name.
+   * @param particles (Random-source) particle catalogue, whose particle
+   *                  data are loaded before computing the value.
+   * @param compute Computation of the value.
+   * @returns Value.
+   */
+  template <class ComputeFunc>
+  std::complex<double> get_value(
+    const std::string& name, ParticleCatalogue& particles,
+    ComputeFunc compute
+  ) {
+    std::complex<double> value;
+    if (this->find_value(name, value)) {return value;}
+
+    this->load_particles(particles);
+    value = compute();
+    this->save_value(name, value);
+
+    return value;
+  }
+
+  /**
+   * @brief Add to a field the cached (quadratic) weighted random-source
+   *        field further weighted by the reduced spherical harmonics,
+   *        or assign and save it if missing.
+   *
+   * @tparam LoSPolicy Line-of-sight policy type.
+   * @param field Mesh field.
+   * @param particles (Random-source) particle catalogue.
+   * @param los (Random-source) line-of-sight policy.
+   * @param weight Overall weight, e.g. f@$ -\alpha f@$ (or
+   *               f@$ \alpha^2 f@$ for the quadratic field).
+   * @param ell Degree of the spherical harmonic.
+   * @param m Order of the spherical harmonic.
+   * @param quad If @c true, add the quadratic weighted field.
+   *
+   * @see trv::MeshField::add_ylm_wgtd_field,
+   *      trv::MeshField::add_ylm_wgtd_quad_field
+   */
+  template <class LoSPolicy>
+  void add_ylm_wgtd_field(
+    MeshField& field, ParticleCatalogue& particles, LoSPolicy los,
+    double weight, int ell, int m, bool quad
+  );
+
+  /**
+   * @brief Return the cache key of mesh parameters and the box
+   *        alignment of the random-source catalogue.
+   *
+   * The alignment depends on the data-source catalogue as well and is
+   * tracked by the observer position of the random-source catalogue.
+   *
+   * @param params Parameter set.
+   * @param particles (Random-source) particle catalogue.
+   * @returns Hexadecimal key.
+   */
+  static std::string get_mesh_key(
+    trv::ParameterSet& params, ParticleCatalogue& particles
+  );
+
+ private:
+  trv::ParameterSet params;  ///> parameter set
+  std::vector<std::pair<std::string, std::complex<double>>> values;
+    ///> cached values
+
+  /**
+   * @brief Set a value in the cache without saving the summary file.
+   *
+   * @param name Value name.
+   * @param value Value.
+   */
+  void set_value(const std::string& name, std::complex<double> value);
+
+  /**
+   * @brief Hash bytes with the 64-bit FNV-1a hash function.
+   *
+   * @param bytes Byte array.
+   * @param len Number of bytes.
+   * @param hash Initial hash value (to chain successive calls).
+   * @returns Hash value.
+   */
+  static std::uint64_t hash_bytes(
+    const char* bytes, std::size_t len, std::uint64_t hash
+  );
+
+  /**
+   * @brief Save cached values (including the catalogue summary)
+   *        to the summary file.
+   */
+  void save_summary();
+
+  /**
+   * @brief Add to a field a mesh from a cache file.
+   *
+   * @param field Mesh field.
+   * @param filepath Mesh file path.
+   * @param weight Overall weight.
+   * @returns Whether the mesh file is found (by all tasks) and valid.
+   */
+  bool add_mesh_from_file(
+    MeshField& field, const std::string& filepath, double weight
+  );
+
+  /**
+   * @brief Save a mesh to a cache file.
+   *
+   * @param field Mesh field.
+   * @param filepath Mesh file path.
+   */
+  void save_mesh_to_file(MeshField& field, const std::string& filepath);
+
+  /**
+   * @brief Open a uniquely named temporary file next to a cache file.
+   *
+   * @param[in] filepath Cache file path.
+   * @param[in] mode File access mode.
+   * @param[out] filepath_tmp Temporary file path.
+   * @returns File pointer (`nullptr` on failure).
+   */
+  static std::FILE* open_temp_file(
+    const std::string& filepath, const char* mode, std::string& filepath_tmp
+  );
+
+  /**
+   * @brief Rename a temporary file to its cache file path, or remove
+   *        it if incompletely written.
+   *
+   * @param filepath_tmp Temporary file path.
+   * @param filepath Cache file path.
+   * @param written Whether the temporary file is completely written.
+   */
+  static void commit_temp_file(
+    const std::string& filepath_tmp, const std::string& filepath,
+    bool written
+  );
+};
+
+
 /// **********************************************************************
 /// Field statistics
 /// **********************************************************************
@@ -504,6 +1291,24 @@ class FieldStats {
   std::vector< std::complex<double> > xi;  ///< pseudo two-point
                                            ///< correlation function
                                            ///< in bins
+  std::vector< std::vector< std::complex<double> > > sn_terms;
+    ///< shot-noise power in bins for each term of multi-term statistics
+  std::vector< std::vector< std::complex<double> > > pk_terms;
+    ///< pseudo power spectrum in bins for each term of multi-term
+    ///< statistics
+
+  /// Wedge statistics in (k, μ) bins (flattened with the μ-bin index
+  /// running fastest), enabled by
+  /// @ref trv::FieldStats::set_wedge_binning.
+  std::vector<int> nmodes_wedges;  ///< number of wavevector modes
+                                   ///< in wedge bins
+  std::vector<double> k_wedges;    ///< average wavenumber in wedge bins
+  std::vector<double> mu_wedges;   ///< average |μ| in wedge bins
+  std::vector< std::complex<double> > sn_wedges;  ///< shot-noise power
+                                                  ///< in wedge bins
+  std::vector< std::complex<double> > pk_wedges;  ///< pseudo power
+                                                  ///< spectrum in
+                                                  ///< wedge bins
 
   /// --------------------------------------------------------------------
   /// Life cycle
@@ -526,6 +1331,23 @@ class FieldStats {
    */
   void reset_stats();
 
+  /**
+   * @brief Enable wedge binning in subsequent Fourier-space
+   *        two-point statistics.
+   *
+   * The auto-power of the second field is additionally binned in
+   * wavenumber and in f@$ |\mu| = |\hat{\vec{k}} \cdot \hat{\vec{n}}| f@$
+   * over evenly spaced bins in f@$ [0, 1] f@$, in the same pass over
+   * the mesh as the spherical-harmonic-weighted statistics.
+   *
+   * @param num_mu_bins Number of f@$ |\mu| f@$ bins (0 to disable).
+   * @param los Global line-of-sight unit vector f@$ \hat{\vec{n}} f@$.
+   * @param shotnoise_amp Shot-noise amplitude of the auto-power.
+   */
+  void set_wedge_binning(
+    int num_mu_bins, double los[3], std::complex<double> shotnoise_amp
+  );
+
   /// --------------------------------------------------------------------
   /// Binned statistics
   /// --------------------------------------------------------------------
@@ -564,6 +1386,33 @@ class FieldStats {
     int ell, int m, trv::Binning& kbinning
   );
 
+  /**
+   * @brief Compute binned two-point statistics in Fourier space for
+   *        multiple terms sharing the second field.
+   *
+   * Each term pairs one of the first fields with the second field as in
+   * @ref trv::FieldStats::compute_ylm_wgtd_2pt_stats_in_fourier, but the
+   * wavenumber binning and grid corrections of each wavevector mode
+   * are computed once for all terms.  Results are stored in
+   * @ref trv::FieldStats::pk_terms and @ref trv::FieldStats::sn_terms.
+   *
+   * @param fields_a First fields.
+   * @param field_b Second field.
+   * @param shotnoise_amps Shot-noise amplitudes.
+   * @param ells Degrees of the spherical harmonics.
+   * @param ms Orders of the spherical harmonics.
+   * @param kbinning Wavenumber bins.
+   * @throws trv::sys::InvalidData When any of @p fields_a and @p field_b
+   *                               have incompatible physical properties.
+   *
+   * @overload
+   */
+  void compute_ylm_wgtd_2pt_stats_in_fourier(
+    std::vector<MeshField*>& fields_a, MeshField& field_b,
+    std::vector< std::complex<double> >& shotnoise_amps,
+    std::vector<int>& ells, std::vector<int>& ms, trv::Binning& kbinning
+  );
+
   /**
    * @brief Compute binned two-point statistics in configuration space.
    *
@@ -620,8 +1469,8 @@ class FieldStats {
    */
   void compute_uncoupled_shotnoise_for_3pcf(
     MeshField& field_a, MeshField& field_b,
-    std::vector< std::complex<double> >& ylm_a,
-    std::vector< std::complex<double> >& ylm_b,
+    const std::vector< std::complex<double> >& ylm_a,
+    const std::vector< std::complex<double> >& ylm_b,
     std::complex<double> shotnoise_amp,
     trv::Binning& rbinning
   );
@@ -664,8 +1513,8 @@ class FieldStats {
    */
   std::complex<double> compute_uncoupled_shotnoise_for_bispec_per_bin(
     MeshField& field_a, MeshField& field_b,
-    std::vector< std::complex<double> >& ylm_a,
-    std::vector< std::complex<double> >& ylm_b,
+    const std::vector< std::complex<double> >& ylm_a,
+    const std::vector< std::complex<double> >& ylm_b,
     trvm::SphericalBesselCalculator& sj1, trvm::SphericalBesselCalculator& sj2,
     std::complex<double> shotnoise_amp,
     double k_a, double k_b
@@ -678,6 +1527,10 @@ class FieldStats {
   double vol;                ///> mesh volume
   double vol_cell;           ///> mesh grid cell volume
 
+  int num_mu_bins = 0;                  ///> number of wedge |μ| bins
+  double los_wedges[3] = {0., 0., 1.};  ///> wedge line of sight
+  std::complex<double> sn_amp_wedges;   ///> wedge shot-noise amplitude
+
   /// --------------------------------------------------------------------
   /// Utilities
   /// --------------------------------------------------------------------
@@ -116,6 +116,22 @@ void print_measurement_datatab_to_file(
   trv::ParameterSet& params, trv::PowspecMeasurements& meas_powspec
 );
 
+/**
+ * @brief Print measurements to a file including the normalisation
+ *        factors and data table columns.
+ *
+ * @param fileptr File to print to.
+ * @param params Parameter set.
+ * @param meas_powspec_wedges Power spectrum wedge measurements.
+ *
+ * @overload
+ */
+void print_measurement_datatab_to_file(
+  std::FILE* fileptr,
+  trv::ParameterSet& params,
+  trv::PowspecWedgeMeasurements& meas_powspec_wedges
+);
+
 /**
  * @brief Print measurements to a file including the normalisation
  *        factors and data table columns.
@@ -166,6 +182,21 @@ void print_measurement_datatab_to_file(
   trv::ParameterSet& params, trv::BispecMeasurements& meas_bispec
 );
 
+/**
+ * @brief Print measurements to a file including the normalisation
+ *        factors and data table columns.
+ *
+ * @param fileptr File to print to.
+ * @param params Parameter set.
+ * @param meas_bispec Bispectrum triangle measurements.
+ *
+ * @overload
+ */
+void print_measurement_datatab_to_file(
+  std::FILE* fileptr,
+  trv::ParameterSet& params, trv::BispecTriangleMeasurements& meas_bispec
+);
+
 /**
  * @brief Print measurements to a file including the normalisation
  *        factors and data table columns.
@@ -42,6 +42,7 @@
 
 #include <cmath>
 #include <complex>
+#include <memory>
 #include <vector>
 
 #include "monitor.hpp"
@@ -234,6 +235,45 @@ class SphericalHarmonicCalculator {
     const double boxsize[3], const int ngrid[3],
     std::vector< std::complex<double> >& ylm_out
   );
+
+  /**
+   * @brief Get shared reduced spherical harmonics computed in
+   *        Fourier space.
+   *
+   * The values are stored once per degree, order and mesh grid, and
+   * reused for as long as any holder keeps them (e.g. across
+   * catalogues measured in a batch).
+   *
+   * @param ell Degree @f$ ell @f$.
+   * @param m Order @f$ m @f$.
+   * @param boxsize Box size in each dimension.
+   * @param ngrid Grid number in each dimension.
+   * @returns Shared stored @f$ y_\ell^m f@$ values.
+   */
+  static std::shared_ptr< const std::vector< std::complex<double> > >
+  get_reduced_spherical_harmonic_in_fourier_space(
+    const int ell, const int m,
+    const double boxsize[3], const int ngrid[3]
+  );
+
+  /**
+   * @brief Get shared reduced spherical harmonics computed in
+   *        configuration space.
+   *
+   * @param ell Degree @f$ ell @f$.
+   * @param m Order @f$ m @f$.
+   * @param boxsize Box size in each dimension.
+   * @param ngrid Grid number in each dimension.
+   * @returns Shared stored @f$ y_\ell^m f@$ values.
+   *
+   * @see trv::maths::SphericalHarmonicCalculator::
+   *      get_reduced_spherical_harmonic_in_fourier_space
+   */
+  static std::shared_ptr< const std::vector< std::complex<double> > >
+  get_reduced_spherical_harmonic_in_config_space(
+    const int ell, const int m,
+    const double boxsize[3], const int ngrid[3]
+  );
 };
 
 
@@ -251,6 +291,9 @@ class SphericalBesselCalculator {
   /**
    * @brief Construct the interpolated function.
    *
+   * The interpolation scheme is shared by all calculators of the same
+   * order that are alive, and only the accelerator is their own.
+   *
    * @param ell Order @f$ \ell @f$.
    */
   SphericalBesselCalculator(const int ell);
@@ -269,8 +312,8 @@ class SphericalBesselCalculator {
   double eval(double x);
 
  private:
-  gsl_interp_accel* accel;  ///< interpolation accelerator
-  gsl_spline* spline;       ///< interpolation scheme
+  gsl_interp_accel* accel;             ///< interpolation accelerator
+  std::shared_ptr<gsl_spline> spline;  ///< interpolation scheme
 };
 
 }  // namespace trv::maths
@@ -32,11 +32,18 @@
 #ifndef TRIUMVIRATE_INCLUDE_MONITOR_HPP_INCLUDED_
 #define TRIUMVIRATE_INCLUDE_MONITOR_HPP_INCLUDED_
 
+#include <algorithm>
 #include <chrono>
 #include <cstdarg>
+#include <cstddef>
 #include <cstdio>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 /// Declares OMP macros.
 #ifdef TRV_USE_OMP
@@ -48,6 +55,11 @@
 #define OMP_CRITICAL
 #endif  // TRV_USE_OMP
 
+/// Declares MPI facilities.
+#ifdef TRV_USE_MPI
+#include <mpi.h>
+#endif  // TRV_USE_MPI
+
 /// Enter debugging mode.
 #ifdef DBG_MODE
 #include <iostream>
@@ -60,30 +72,180 @@ namespace sys {
 /// Program tracking
 /// **********************************************************************
 
-/// RFE: Implement MPI.
 extern int currTask;  ///< current task
+extern int numTasks;  ///< number of tasks
 
 extern double gbytesMem;     ///< current memory usage in gibibytes
 extern double gbytesMaxMem;  ///< maximum memory usage in gibibytes
 
+/**
+ * @brief Categories of tracked memory usage.
+ *
+ */
+enum MemoryCategory {
+  MEM_MESH = 0,       ///> mesh fields and mesh-sized buffers
+  MEM_PARTICLES = 1,  ///> particle data
+  MEM_MODES = 2,      ///> per-mode tables, e.g. spherical harmonics
+                      ///> on mesh grids and indexed shell modes
+  MEM_STATS = 3,      ///> binned-statistics sample buffers
+  MEM_OTHER = 4       ///> uncategorised usage
+};
+
+const int NUM_MEM_CATEGORIES = 5;  ///< number of memory categories
+
+extern const char* memCategoryNames[NUM_MEM_CATEGORIES];
+  ///< memory category names
+extern double gbytesMemCat[NUM_MEM_CATEGORIES];
+  ///< current memory usage in gibibytes by category
+extern double gbytesMaxMemCat[NUM_MEM_CATEGORIES];
+  ///< maximum memory usage in gibibytes by category
+
 /**
  * @brief Return size in gibibytes.
  *
  * @tparam T A @c typename.
+ * @param num Number of elements.
  * @returns Size in gibibytes.
  */
 template <typename T>
-double size_in_gb(int num) {
+double size_in_gb(long long num) {
   const double BYTES_PER_GBYTES = 1073741824.;  // 1024³ bytes per gibibyte
   return double(num) * sizeof(T) / BYTES_PER_GBYTES;
 }
 
+/**
+ * @brief Initialise the tasks (as MPI processes if enabled), setting
+ *        @ref trv::sys::currTask and @ref trv::sys::numTasks.
+ *
+ * MPI is initialised with funnelled thread support, i.e. MPI calls
+ * are only made from the main thread; the program is aborted if this
+ * is not supported.
+ *
+ * @param argc Pointer to the number of command-line arguments.
+ * @param argv Pointer to the command-line arguments.
+ */
+void init_tasks(int* argc, char*** argv);
+
+/**
+ * @brief Finalise the tasks (as MPI processes if enabled).
+ */
+void finalise_tasks();
+
+/**
+ * @brief Sum values elementwise in place across all tasks.
+ *
+ * This is a no-op unless MPI is enabled.
+ *
+ * @param[in,out] values Values to be summed.
+ * @param num Number of values.
+ */
+void sum_across_tasks(double* values, int num);
+
+/**
+ * @brief Sum values elementwise in place across all tasks.
+ *
+ * @param[in,out] values Values to be summed.
+ * @param num Number of values.
+ *
+ * @overload
+ */
+void sum_across_tasks(int* values, int num);
+
 /**
  * @brief Update the maximum memory usage estimate.
  *
+ * This is safe to call from multiple threads.
  */
 void update_maxmem();
 
+/**
+ * @brief Add an allocation to the tracked memory usage.
+ *
+ * This updates the current and maximum memory usage (in total and by
+ * category) and is safe to call from multiple threads.
+ *
+ * @param gbytes Allocated size in gibibytes.
+ * @param category Memory category (default is `MEM_OTHER`).
+ */
+void count_alloc(double gbytes, MemoryCategory category = MEM_OTHER);
+
+/**
+ * @brief Remove a deallocation from the tracked memory usage.
+ *
+ * @param gbytes Deallocated size in gibibytes.
+ * @param category Memory category (default is `MEM_OTHER`).
+ */
+void count_dealloc(double gbytes, MemoryCategory category = MEM_OTHER);
+
+/**
+ * @brief Return the sampled resident set size of the process.
+ *
+ * @returns Resident set size in gibibytes (0 if unavailable).
+ */
+double get_rss_in_gb();
+
+/**
+ * @brief Return the peak resident set size of the process.
+ *
+ * @returns Peak resident set size in gibibytes (0 if unavailable).
+ */
+double get_peak_rss_in_gb();
+
+/**
+ * @brief Standard-library allocator that counts its allocations
+ *        towards the tracked memory usage.
+ *
+ * @tparam T Element type.
+ * @tparam C Memory category.
+ */
+template <typename T, MemoryCategory C = MEM_OTHER>
+class TrackingAllocator {
+ public:
+  typedef T value_type;  ///< element type
+
+  /// Rebind the allocator to another element type.
+  template <typename U>
+  struct rebind {typedef TrackingAllocator<U, C> other;};
+
+  TrackingAllocator() noexcept {}
+
+  template <typename U>
+  TrackingAllocator(const TrackingAllocator<U, C>&) noexcept {}
+
+  /**
+   * @brief Allocate storage and count its size.
+   *
+   * @param num Number of elements.
+   * @returns Pointer to the storage.
+   */
+  T* allocate(std::size_t num) {
+    T* ptr = std::allocator<T>().allocate(num);
+    count_alloc(size_in_gb<T>(num), C);
+    return ptr;
+  }
+
+  /**
+   * @brief Deallocate storage and uncount its size.
+   *
+   * @param ptr Pointer to the storage.
+   * @param num Number of elements.
+   */
+  void deallocate(T* ptr, std::size_t num) noexcept {
+    std::allocator<T>().deallocate(ptr, num);
+    count_dealloc(size_in_gb<T>(num), C);
+  }
+};
+
+template <typename T, typename U, MemoryCategory C>
+bool operator==(
+  const TrackingAllocator<T, C>&, const TrackingAllocator<U, C>&
+) {return true;}
+
+template <typename T, typename U, MemoryCategory C>
+bool operator!=(
+  const TrackingAllocator<T, C>&, const TrackingAllocator<U, C>&
+) {return false;}
+
 /**
  * @brief Return the current date-time string in
  *        'YYYY-MM-DD HH:MM:SS' format.
@@ -107,6 +269,97 @@ std::string show_elapsed_time(double duration_in_seconds);
  */
 std::string show_timestamp();
 
+
+/// **********************************************************************
+/// Program profiling
+/// **********************************************************************
+
+extern bool profileOn;  ///< stage profiling switch
+
+/**
+ * @brief Turn on stage profiling, resetting any previous profile.
+ *
+ * Stage timers are no-ops until profiling is turned on, and only
+ * timers on the calling thread are profiled.  The peak memory usage
+ * estimates are restarted from the current usage so that repeated
+ * profiles (e.g. in benchmark sweeps) are independent.
+ */
+void enable_profiling();
+
+/**
+ * @brief Record a named quantity (e.g. mesh or particle sizes)
+ *        alongside the profile.
+ *
+ * A quantity recorded under an existing name is overwritten.
+ *
+ * @param name Quantity name.
+ * @param value Quantity value.
+ */
+void record_profile_quantity(const std::string& name, double value);
+
+/**
+ * @brief Print the stage profile as a JSON object.
+ *
+ * See @ref trv::sys::write_profile_to_file for the profile contents.
+ *
+ * @param fileptr Output file pointer.
+ * @param depth Indentation depth at which the object is nested
+ *              (default is 0).
+ */
+void print_profile(std::FILE* fileptr, int depth = 0);
+
+/**
+ * @brief Write the stage profile to a JSON file.
+ *
+ * The profile records, for each stage nested under its parent, the
+ * number of calls, the total and self (exclusive of nested stages)
+ * wall-clock time in seconds, and the peak tracked memory usage and
+ * sampled resident set size, together with the thread and task counts,
+ * the peak memory usage in total and by category and any recorded
+ * quantities.
+ *
+ * @param filepath Output file path.
+ * @returns Exit status.
+ */
+int write_profile_to_file(const std::string& filepath);
+
+/**
+ * @brief Scoped timer of a labelled program stage.
+ *
+ * Stages nest in the order the timers are constructed, and each timer
+ * stops when it goes out of scope (or when @ref
+ * trv::sys::StageTimer::stop() is called).  Timers constructed inside
+ * an OpenMP parallel region or on a thread other than the one that
+ * turned on profiling are ignored, as are all timers when profiling
+ * is off.
+ *
+ */
+class StageTimer {
+ public:
+  /**
+   * @brief Start timing a stage.
+   *
+   * @param label Stage label.
+   */
+  explicit StageTimer(const char* label);
+
+  /**
+   * @brief Stop timing the stage if not yet stopped.
+   */
+  ~StageTimer();
+
+  /**
+   * @brief Stop timing the stage.
+   *
+   * Stages must be stopped in the reverse order of being started.
+   */
+  void stop();
+
+ private:
+  int node;  ///> profile node index (-1 if not timed)
+  std::chrono::steady_clock::time_point tstart;  ///> stage starting time
+};
+
 /**
  * @brief Logging levels.
  *
@@ -246,6 +499,38 @@ class Logger {
 extern Logger logger;  ///< default logger at `NSET` level
 
 
+/// **********************************************************************
+/// FFTW state
+/// **********************************************************************
+
+/**
+ * @brief Initialise FFTW (with threads if enabled) once per process.
+ *
+ * This is safe to call repeatedly and from multiple threads, so that
+ * measurements need not initialise or clean up FFTW themselves and can
+ * run concurrently.
+ */
+void init_fftw();
+
+/**
+ * @brief Clean up FFTW at the end of the program.
+ *
+ * @attention No FFTW plans may be in use or be created afterwards.
+ */
+void finalise_fftw();
+
+/**
+ * @brief Lock the FFTW planner.
+ *
+ * FFTW plan creation and destruction (unlike plan execution) are not
+ * thread-safe, so they must be performed while holding this lock.
+ * FFTW is initialised if not yet.
+ *
+ * @returns Lock on the FFTW planner.
+ */
+std::unique_lock<std::mutex> lock_fftw_planner();
+
+
 /// **********************************************************************
 /// Program exceptions
 /// **********************************************************************
@@ -30,6 +30,7 @@
 #ifndef TRIUMVIRATE_INCLUDE_PARAMETERS_HPP_INCLUDED_
 #define TRIUMVIRATE_INCLUDE_PARAMETERS_HPP_INCLUDED_
 
+#include <glob.h>
 #include <sys/stat.h>
 
 #include <algorithm>
@@ -37,7 +38,9 @@
 #include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include "monitor.hpp"
 
@@ -58,11 +61,28 @@ class ParameterSet {
 
   std::string catalogue_dir;        ///< catalogue directory
   std::string measurement_dir;      ///< measurement/output directory
-  std::string data_catalogue_file;  ///< data catalogue file
+  std::string data_catalogue_file;  ///< data catalogue file (or
+                                    ///< comma-separated list and/or
+                                    ///< glob patterns for batch mode)
   std::string rand_catalogue_file;  ///< random catalogue file
   std::string catalogue_columns;    ///< catalogue data columns
                                     ///< (comma-separated without space)
   std::string output_tag;           ///< output tag
+  int chunk_size = 0;               ///< number of particles per chunk
+                                    ///< when the random-source catalogue
+                                    ///< is streamed (0 (default) for
+                                    ///< no streaming)
+  std::string profile = "false";    ///< stage-profile output switch:
+                                    ///< {"true"/"on",
+                                    ///<  "false"/"off" (default)}
+  std::string random_cache_dir = "";  ///< random mesh cache directory
+                                      ///< ("" (default) for no caching)
+
+  /// Derived I/O parameters.
+
+  std::vector<std::string> data_catalogue_files;  ///< data catalogue files
+                                                  ///< (expanded from
+                                                  ///< `data_catalogue_file`)
 
   /// --------------------------------------------------------------------
   /// Mesh sampling
@@ -114,7 +134,8 @@ class ParameterSet {
                                 ///< {"lin" (default), "log",
                                 ///<  "linpad", "logpad", "custom"}
   std::string form = "diag";    ///< form of the bispectrum measurement:
-                                ///< {"diag" (default), "full"}
+                                ///< {"diag" (default), "full",
+                                ///<  "triangle"}
 
   /// Derived measurement specification.
   std::string npoint;  ///< <i>N</i>-point case: {"2pt", "3pt"}
@@ -125,6 +146,11 @@ class ParameterSet {
   int ell2;  ///< spherical degree associated with the second wavevector
   int ELL;   ///< spherical degree associated with the line of sight
 
+  std::vector<int> multipoles;  ///< spherical degrees associated with
+                                ///< the line of sight measured together
+                                ///< in a single power spectrum run
+                                ///< (overriding @c ELL if non-empty)
+
   int i_wa;  ///< first order of the wide-angle correction term
   int j_wa;  ///< second order of the wide-angle correction term
 
@@ -135,6 +161,24 @@ class ParameterSet {
   int idx_bin;   ///< fixed bin index in "full" @c form
                  ///< bispectrum measurements
 
+  int num_mu_bins = 0;  ///< number of |μ| wedge bins for power spectrum
+                        ///< measurements in a periodic box (0 for none)
+
+  double subsample_kmin = 0.;  ///< wavenumber at or above which bins
+                               ///< (by their lower edges) have
+                               ///< Fourier-space modes subsampled
+                               ///< (in h/Mpc)
+  double subsample_frac = 1.;  ///< fraction of Fourier-space modes
+                               ///< retained above @c subsample_kmin
+                               ///< (1 for no subsampling)
+
+  int fold_factor = 1;  ///< mesh folding factor for measurements from
+                        ///< simulation-type catalogues in a periodic
+                        ///< box (1 for no folding)
+  double fold_kstitch = 0.;  ///< wavenumber at or above which bins
+                             ///< (by their lower edges) take the
+                             ///< folded measurements (in h/Mpc)
+
   /// --------------------------------------------------------------------
   /// Misc
   /// --------------------------------------------------------------------
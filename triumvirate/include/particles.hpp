@@ -25,7 +25,10 @@
  *
  * This module defines a particle catalogue object with I/O methods,
  * summary information and its computations, and methods to offset
- * particle coordinates (in particular in a mesh grid box).
+ * particle coordinates (in particular in a mesh grid box), as well as
+ * a catalogue stream for reading particle data from file in chunks.
+ * Catalogue files may be gzip- or Zstandard-compressed, in which case
+ * they are decompressed in the background while being parsed.
  *
  */
 
@@ -34,18 +37,156 @@
 
 #include <algorithm>
 #include <cmath>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdio>
+#include <deque>
 #include <fstream>
 #include <iterator>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
+#ifdef TRV_USE_ZLIB
+#include <zlib.h>
+#endif  // TRV_USE_ZLIB
+
+#ifdef TRV_USE_ZSTD
+#include <zstd.h>
+#endif  // TRV_USE_ZSTD
+
 #include "monitor.hpp"
 
 namespace trv {
 
+class RandomMeshCache;  // see field.hpp
+
+/**
+ * @brief Catalogue file reader with transparent decompression.
+ *
+ * Plain-text catalogue files are read directly.  Files compressed with
+ * gzip (requiring @c TRV_USE_ZLIB) or Zstandard (requiring
+ * @c TRV_USE_ZSTD), detected from their magic bytes, are decompressed
+ * block by block on a background thread into a bounded queue, so that
+ * decompression overlaps with line parsing on the calling thread(s).
+ *
+ */
+class CatalogueFileReader {
+ public:
+  std::string filepath;     ///< catalogue file path
+  std::string compression;  ///< compression format
+                            ///< {"none", "gzip", "zstd"}
+
+  /// --------------------------------------------------------------------
+  /// Life cycle
+  /// --------------------------------------------------------------------
+
+  /**
+   * @brief Construct the catalogue file reader by opening the file.
+   *
+   * @param filepath Catalogue file path.
+   * @throws trv::sys::IOError When the file cannot be opened, or its
+   *                           compression format is unsupported
+   *                           in the current build.
+   */
+  explicit CatalogueFileReader(const std::string& filepath);
+
+  /**
+   * @brief Destruct the catalogue file reader.
+   */
+  ~CatalogueFileReader();
+
+  /**
+   * @brief Detect the compression format of a file from its magic bytes.
+   *
+   * @param filepath File path.
+   * @returns Compression format {"none", "gzip", "zstd"}.
+   */
+  static std::string detect_compression(const std::string& filepath);
+
+  /// --------------------------------------------------------------------
+  /// Data I/O
+  /// --------------------------------------------------------------------
+
+  /**
+   * @brief Read the next line (as with @c std::getline).
+   *
+   * @param[out] line_str Line string without the trailing newline.
+   * @returns @c false if the end of file has been reached without
+   *          any character read, @c true otherwise.
+   * @throws trv::sys::IOError When decompression fails.
+   */
+  bool getline(std::string& line_str);
+
+  /**
+   * @brief Read the next batch of data lines, skipping empty lines
+   *        and comment lines.
+   *
+   * @param[out] lines Line buffer (resized to at least @p max_lines
+   *                   elements), of which the leading elements up to
+   *                   the returned number are filled with data lines.
+   * @param max_lines Maximum number of data lines to read.
+   * @returns Number of data lines read (0 at the end of file).
+   */
+  int read_data_lines(std::vector<std::string>& lines, int max_lines);
+
+  /**
+   * @brief Rewind the reader to the start of the file.
+   */
+  void rewind();
+
+ private:
+  std::ifstream fin;  ///< plain-text file stream
+
+  std::thread decompressor;             ///< background decompression thread
+  std::mutex queue_mutex;               ///< block queue mutex
+  std::condition_variable queue_cv;     ///< block queue condition
+  std::deque<std::string> block_queue;  ///< decompressed block queue
+  std::size_t block_size;               ///< decompressed block size
+  std::size_t max_queued_blocks;        ///< maximum queued blocks
+  bool decompression_done;              ///< whether decompression ended
+  bool decompression_stop;              ///< whether to stop decompression
+  std::string decompression_error;      ///< decompression error message
+
+  std::string block;      ///< current decompressed block being read
+  std::size_t block_pos;  ///< current read position in the block
+
+  /**
+   * @brief Open the file and start any background decompression.
+   */
+  void open();
+
+  /**
+   * @brief Stop any background decompression and close the file.
+   */
+  void close();
+
+  /**
+   * @brief Decompress the file into the block queue (run on the
+   *        background thread).
+   */
+  void decompress();
+
+  /**
+   * @brief Push a decompressed block to the queue, waiting while
+   *        the queue is full.
+   *
+   * @param block_out Decompressed block.
+   * @returns @c false if decompression should stop, @c true otherwise.
+   */
+  bool push_block(std::string& block_out);
+
+  /**
+   * @brief Pop the next decompressed block from the queue as the
+   *        current block, waiting while the queue is empty.
+   *
+   * @returns @c false at the end of decompressed data, @c true otherwise.
+   */
+  bool pop_block();
+};
+
 /**
  * @brief Particle catalogue.
  *
@@ -71,6 +212,17 @@ class ParticleCatalogue {
   double pos_min[3];  ///< minimum values of particle positions
   double pos_max[3];  ///< maximum values of particle positions
 
+  double pos_observer[3];  ///< observer position (the original origin
+                           ///< tracked through coordinate offsets)
+
+  bool streamed = false;  ///< whether particle data are streamed from
+                          ///< file in chunks (or read from a random
+                          ///< mesh cache), so that only summary
+                          ///< information is held
+
+  RandomMeshCache* mesh_cache = nullptr;  ///< attached random mesh cache
+                                          ///< (if any)
+
   /// --------------------------------------------------------------------
   /// Life cycle
   /// --------------------------------------------------------------------
@@ -126,6 +278,9 @@ class ParticleCatalogue {
   /**
    * @brief Read in a catalogue file.
    *
+   * The file may be compressed (see @ref trv::CatalogueFileReader).
+   * Lines are read in batches which are parsed in parallel.
+   *
    * @param catalogue_filepath Catalogue file path.
    * @param catalogue_columns Catalogue data column names
    *                          (comma-separated without space).
@@ -139,6 +294,53 @@ class ParticleCatalogue {
     double volume=0.
   );
 
+  /**
+   * @brief Scan a catalogue file for summary information only.
+   *
+   * The number of particles, their total systematic weight and the
+   * extents of their positions are computed in a single pass without
+   * holding the particle data, which are instead to be streamed in
+   * chunks (see @ref trv::ParticleCatalogueStream).
+   *
+   * @param catalogue_filepath Catalogue file path.
+   * @param catalogue_columns Catalogue data column names
+   *                          (comma-separated without space).
+   * @returns Exit status.
+   */
+  int scan_catalogue_file(
+    const std::string& catalogue_filepath,
+    const std::string& catalogue_columns
+  );
+
+  /**
+   * @brief Locate catalogue data columns by name.
+   *
+   * @param catalogue_columns Catalogue data column names
+   *                          (comma-separated without space).
+   * @returns Column indices of the fields "x", "y", "z", "nz", "ws"
+   *          and "wc" in order, with -1 for any unfound field.
+   */
+  static std::vector<int> get_column_indices(
+    const std::string& catalogue_columns
+  );
+
+  /**
+   * @brief Parse a catalogue file line as particle data.
+   *
+   * @param[in] line_str Catalogue file line.
+   * @param[in] name_indices Column indices of catalogue data fields
+   *                         (see
+   *                         @ref trv::ParticleCatalogue::get_column_indices).
+   * @param[in] nz_default Default 'nz' value when the field is missing.
+   * @param[out] particle Particle data.
+   * @returns Whether the line holds particle data, i.e. is neither
+   *          empty nor a comment line.
+   */
+  static bool parse_catalogue_line(
+    const std::string& line_str, const std::vector<int>& name_indices,
+    double nz_default, ParticleData& particle
+  );
+
   /**
    * @brief Read in particle data.
    *
@@ -146,8 +348,56 @@ class ParticleCatalogue {
    * @returns Exit status.
    */
   int load_particle_data(
-    std::vector<double> x, std::vector<double> y, std::vector<double> z,
-    std::vector<double> nz, std::vector<double> ws, std::vector<double> wc
+    const std::vector<double>& x,
+    const std::vector<double>& y,
+    const std::vector<double>& z,
+    const std::vector<double>& nz,
+    const std::vector<double>& ws,
+    const std::vector<double>& wc
+  );
+
+  /**
+   * @brief Read in particle data from contiguous caller-owned buffers.
+   *
+   * The buffers are read directly without any intermediate copy,
+   * so that the particle data are held only once more in memory.
+   *
+   * @param x, y, z, nz, ws, wc Particle data by column.
+   * @param num Number of particles (i.e. length of each buffer).
+   * @returns Exit status.
+   *
+   * @overload
+   */
+  int load_particle_data(
+    const double* x, const double* y, const double* z,
+    const double* nz, const double* ws, const double* wc,
+    const int num
+  );
+
+  /**
+   * @brief Read in a single column of particle data.
+   *
+   * This lets callers whose particle data need converting (e.g. in
+   * precision or memory layout) convert and read in one column at a
+   * time, so that only one converted column is held at once.  The
+   * particle data container must first be initialised with
+   * @ref trv::ParticleCatalogue::initialise_particles, and the "ws"
+   * column must be read in before the "wc" column, with which overall
+   * weights are set.  Once all columns have been read in,
+   * @ref trv::ParticleCatalogue::calc_wtotal and
+   * @ref trv::ParticleCatalogue::calc_pos_min_and_max are to be called.
+   *
+   * @param name Column name, one of {"x", "y", "z", "nz", "ws", "wc"}.
+   * @param values Contiguous column buffer.
+   * @param num Number of particles (i.e. length of the buffer).
+   * @returns Exit status.
+   * @throws trv::sys::InvalidData When the particle data container is
+   *                               not initialised for @p num particles.
+   * @throws trv::sys::InvalidParameter When @p name is not a particle
+   *                                    data column.
+   */
+  int load_particle_data_column(
+    const std::string& name, const double* values, const int num
   );
 
   /// --------------------------------------------------------------------
@@ -165,7 +415,8 @@ class ParticleCatalogue {
    * @brief Calculate the extents of particle positions.
    *
    * @note This method merely sets @ref trv::ParticleCatalogue::pos_min
-   *       and @ref trv::ParticleCatalogue::pos_max.
+   *       and @ref trv::ParticleCatalogue::pos_max.  For a streamed
+   *       catalogue, the extents precomputed from scanning are kept.
    */
   void calc_pos_min_and_max();
 
@@ -177,6 +428,9 @@ class ParticleCatalogue {
    * @brief Offset particle positions by a given vector.
    *
    * The position specified by the input vector is the new origin.
+   * The observer position is offset alongside.  For a streamed
+   * catalogue, only the extents and the observer position are offset,
+   * and streamed chunks are offset as they are read in.
    *
    * @param dpos (Subtractive) offset position vector.
    */
@@ -189,6 +443,22 @@ class ParticleCatalogue {
    */
   void offset_coords_for_periodicity(const double boxsize[3]);
 
+  /**
+   * @brief Fold particle positions into a periodic sub-box by wrapping
+   *        them modulo the sub-box size.
+   *
+   * The original positions are saved and can be restored by
+   * @ref trv::ParticleCatalogue::unfold_coords.
+   *
+   * @param boxsize Periodic sub-box size in each dimension.
+   */
+  void fold_coords(const double boxsize[3]);
+
+  /**
+   * @brief Restore particle positions saved before folding.
+   */
+  void unfold_coords();
+
   /**
    * @brief Centre a catalogue in a box.
    *
@@ -286,6 +556,90 @@ class ParticleCatalogue {
     ParticleCatalogue& catalogue, ParticleCatalogue& catalogue_ref,
     const double boxsize[3], const int ngrid[3], const double ngrid_pad[3]
   );
+
+ private:
+  typedef std::vector<
+    double, trv::sys::TrackingAllocator<double, trv::sys::MEM_PARTICLES>
+  > PositionList;  ///> tracked list of particle position components
+
+  PositionList pos_unfolded;  ///> particle positions saved before folding
+};
+
+/**
+ * @brief Particle catalogue streamed from a file in fixed-size chunks.
+ *
+ * The catalogue file is scanned once for summary information held by
+ * the attached catalogue @ref trv::ParticleCatalogueStream::catalogue,
+ * which can be aligned in a box as usual.  Particle data are then read
+ * into
+ * @ref trv::ParticleCatalogueStream::chunk one chunk at a time,
+ * with positions offset into the same frame as the summary catalogue,
+ * so that memory usage is bounded by the chunk size rather than the
+ * catalogue size.
+ *
+ */
+class ParticleCatalogueStream {
+ public:
+  ParticleCatalogue& catalogue;  ///< summary catalogue (without data)
+  ParticleCatalogue chunk;       ///< current chunk of particle data
+  int chunk_size;                ///< maximum number of particles per chunk
+
+  /// --------------------------------------------------------------------
+  /// Life cycle
+  /// --------------------------------------------------------------------
+
+  /**
+   * @brief Construct the particle catalogue stream by scanning
+   *        a catalogue file.
+   *
+   * @param catalogue Summary catalogue to attach (which must not have
+   *                  been loaded from any other source).
+   * @param catalogue_filepath Catalogue file path.
+   * @param catalogue_columns Catalogue data column names
+   *                          (comma-separated without space).
+   * @param chunk_size Maximum number of particles per chunk.
+   * @param volume Catalogue volume (default is 0.) used for computing
+   *               the default 'nz' value when the field is missing.
+   */
+  ParticleCatalogueStream(
+    ParticleCatalogue& catalogue,
+    const std::string& catalogue_filepath,
+    const std::string& catalogue_columns,
+    const int chunk_size,
+    double volume=0.
+  );
+
+  /**
+   * @brief Destruct the particle catalogue stream.
+   */
+  ~ParticleCatalogueStream();
+
+  /// --------------------------------------------------------------------
+  /// Data I/O
+  /// --------------------------------------------------------------------
+
+  /**
+   * @brief Read in the next chunk of particle data.
+   *
+   * Particle positions are offset so that the observer, originally at
+   * the coordinate origin, coincides with that of the summary catalogue.
+   *
+   * @returns Number of particles read in the chunk (0 when the
+   *          catalogue file is exhausted).
+   */
+  int read_next_chunk();
+
+  /**
+   * @brief Rewind the stream to the start of the catalogue file.
+   */
+  void rewind();
+
+ private:
+  std::string catalogue_filepath;  ///< catalogue file path
+  std::vector<int> name_indices;   ///< catalogue data column indices
+  double nz_default;               ///< default 'nz' value
+  CatalogueFileReader* reader;     ///< catalogue file reader
+  std::vector<std::string> lines;  ///< data lines of the current chunk
 };
 
 }  // namespace trv
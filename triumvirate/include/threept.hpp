@@ -136,18 +136,20 @@ double calc_bispec_normalisation_from_particles(
  * @note See eq. (46) in Sugiyama et al. (2019)
  *       [<a href="https://arxiv.org/abs/1803.02132">1803.02132</a>].
  *
+ * @tparam LoSPolicy Line-of-sight policy type.
  * @param particles_data (Data-source) particle catalogue.
  * @param particles_rand (Random-source) particle catalogue.
- * @param los_data (Data-source) particle lines of sight.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_data (Data-source) line-of-sight policy.
+ * @param los_rand (Random-source) line-of-sight policy.
  * @param alpha Alpha contrast.
  * @param ell Degree of the spherical harmonic.
  * @param m Order of the spherical harmonic.
  * @returns Weighted shot-noise contribution for bispectrum.
  */
+template <class LoSPolicy>
 std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
   ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
   double alpha, int ell, int m
 );
 
@@ -155,8 +157,9 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
  * @brief Calculate bispectrum shot noise amplitude weighted by
  *        reduced spherical harmonics.
  *
+ * @tparam LoSPolicy Line-of-sight policy type.
  * @param particles Particle catalogue.
- * @param los Particle lines of sight.
+ * @param los Line-of-sight policy.
  * @param alpha Alpha contrast.
  * @param ell Degree of the spherical harmonic.
  * @param m Order of the spherical harmonic.
@@ -164,12 +167,71 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
  *
  * @overload
  */
+template <class LoSPolicy>
 std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
-  ParticleCatalogue& particles, LineOfSight* los,
+  ParticleCatalogue& particles, LoSPolicy los,
   double alpha, int ell, int m
 );
 
 
+/// **********************************************************************
+/// Reduced mesh grids
+/// **********************************************************************
+
+/**
+ * @brief Set up a parameter set for a reduced mesh grid sufficient for
+ *        the bispectrum of wavenumber bands below a maximum wavenumber.
+ *
+ * The triple product of fields band-limited to f@$ |k_i| \leqslant
+ * k_\mathrm{max} f@$ in each dimension is free of aliasing on any mesh
+ * grid with more than f@$ 4 k_\mathrm{max} / \Delta k_i f@$ cells in
+ * each dimension, so its mesh sum can be computed on the smallest
+ * FFT-friendly such grid (with the same box size).
+ *
+ * @param[in] params Parameter set.
+ * @param[in] k_max Maximum wavenumber of the bands.
+ * @param[out] params_reduced Parameter set for the reduced mesh grid.
+ * @returns Whether the reduced mesh grid is smaller than the full
+ *          mesh grid.
+ */
+bool set_reduced_mesh_params(
+  trv::ParameterSet& params, double k_max,
+  trv::ParameterSet& params_reduced
+);
+
+/**
+ * @brief Compute the bispectrum component from a pair of wavenumber
+ *        bands on a reduced mesh grid.
+ *
+ * This computes the mesh sum of the product
+ * f@$ F_{\ell_1 m_1}(\vec{x}; k_a) F_{\ell_2 m_2}(\vec{x}; k_b)
+ * G_{LM}(\vec{x}) f@$ (times the grid cell volume), with all fields
+ * resampled from the full mesh grid in Fourier space.
+ *
+ * @param[in] params_reduced Parameter set for the reduced mesh grid
+ *                           (see @ref trv::set_reduced_mesh_params).
+ * @param[in] dn_fourier Fourier-space field on the full mesh grid
+ *                       from which the band-limited fields are drawn.
+ * @param[in] ylm_k_a, ylm_k_b Reduced spherical harmonics on the full
+ *                             mesh grid in Fourier space.
+ * @param[in] G_fourier Compensated Fourier-space field on the full
+ *                      mesh grid.
+ * @param[in] k_lower_a, k_upper_a First band wavenumber range.
+ * @param[in] k_lower_b, k_upper_b Second band wavenumber range.
+ * @param[out] k_eff_a, k_eff_b Effective band wavenumbers.
+ * @param[out] nmodes_a, nmodes_b Numbers of wavevector modes in bands.
+ * @returns Bispectrum component.
+ */
+std::complex<double> calc_bispec_component_on_reduced_mesh(
+  trv::ParameterSet& params_reduced, MeshField& dn_fourier,
+  const std::vector< std::complex<double> >& ylm_k_a,
+  const std::vector< std::complex<double> >& ylm_k_b,
+  MeshField& G_fourier,
+  double k_lower_a, double k_upper_a, double k_lower_b, double k_upper_b,
+  double& k_eff_a, int& nmodes_a, double& k_eff_b, int& nmodes_b
+);
+
+
 /// **********************************************************************
 /// Full statistics
 /// **********************************************************************
@@ -182,18 +244,20 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
 /**
  * @brief Compute bispectrum from paired survey-type catalogues.
  *
+ * @tparam LoSPolicy Line-of-sight policy type.
  * @param catalogue_data (Data-source) particle catalogue.
  * @param catalogue_rand (Random-source) particle catalogue.
- * @param los_data (Data-source) particle lines of sight.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_data (Data-source) line-of-sight policy.
+ * @param los_rand (Random-source) line-of-sight policy.
  * @param params Parameter set.
  * @param kbinning Wavenumber binning.
  * @param norm_factor Normalisation factor.
  * @returns Bispectrum measurements.
  */
+template <class LoSPolicy>
 trv::BispecMeasurements compute_bispec(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
   trv::ParameterSet& params, trv::Binning& kbinning,
   double norm_factor
 );
@@ -202,18 +266,20 @@ trv::BispecMeasurements compute_bispec(
  * @brief Compute three-point correlation function from paired
  *        survey-type catalogues.
  *
+ * @tparam LoSPolicy Line-of-sight policy type.
  * @param catalogue_data (Data-source) particle catalogue.
  * @param catalogue_rand (Random-source) particle catalogue.
- * @param los_data (Data-source) particle lines of sight.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_data (Data-source) line-of-sight policy.
+ * @param los_rand (Random-source) line-of-sight policy.
  * @param params Parameter set.
  * @param rbinning Separation binning.
  * @param norm_factor Normalisation factor.
  * @returns Three-point correlation function measurements.
  */
+template <class LoSPolicy>
 trv::ThreePCFMeasurements compute_3pcf(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
   trv::ParameterSet& params, trv::Binning& rbinning,
   double norm_factor
 );
@@ -222,6 +288,12 @@ trv::ThreePCFMeasurements compute_3pcf(
  * @brief Compute bispectrum in a periodic box in the global
  *        plane-parallel approximation.
  *
+ * If @ref trv::ParameterSet::fold_factor is greater than 1, the
+ * measurements are repeated on the folded mesh grid (see
+ * @ref trv::set_folded_mesh_params) and stitched onto the unfolded ones
+ * in bins where both wavenumber bins have lower edges at or above
+ * @ref trv::ParameterSet::fold_kstitch.
+ *
  * @param catalogue_data (Data-source) particle catalogue.
  * @param params Parameter set.
  * @param kbinning Wavenumber binning.
@@ -234,6 +306,32 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
   double norm_factor
 );
 
+/**
+ * @brief Compute bispectrum monopole in a periodic box for all closed
+ *        triangle configurations of wavenumber bins.
+ *
+ * One shell field f@$ F_i(\vec{x}) f@$ of the density fluctuations
+ * is inverse Fourier transformed per wavenumber bin f@$ i f@$, and the
+ * bispectrum in each triangle bin f@$ (i, j, l) f@$ with
+ * f@$ i \leqslant j \leqslant l f@$ is the mesh sum
+ * f@$ \sum_{\vec{x}} F_i F_j F_l f@$ divided by the same sum of
+ * unit shell fields, which counts the closed wavevector triangles.
+ * Only triangle bins containing closed triangles are returned.
+ * With subsampling, all closed triangles are counted but the bispectrum
+ * is averaged over retained ones.
+ *
+ * @param catalogue_data (Data-source) particle catalogue.
+ * @param params Parameter set.
+ * @param kbinning Wavenumber binning.
+ * @param norm_factor Normalisation factor.
+ * @returns Bispectrum triangle measurements.
+ */
+trv::BispecTriangleMeasurements compute_bispec_triangles_in_gpp_box(
+  ParticleCatalogue& catalogue_data,
+  trv::ParameterSet& params, trv::Binning& kbinning,
+  double norm_factor
+);
+
 /**
  * @brief Compute three-point correlation function in a periodic box
  *        in the global plane-parallel approximation.
@@ -254,8 +352,9 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
  * @brief Compute three-point correlation function window from
  *        a random catalogue.
  *
+ * @tparam LoSPolicy Line-of-sight policy type.
  * @param catalogue_rand (Random-source) particle catalogue.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_rand (Random-source) line-of-sight policy.
  * @param params Parameter set.
  * @param rbinning Separation binning.
  * @param alpha Alpha contrast.
@@ -263,8 +362,9 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
  * @param wide_angle Whether wide-angle corretions or not.
  * @returns Three-point correlation function window measurements.
  */
+template <class LoSPolicy>
 trv::ThreePCFWindowMeasurements compute_3pcf_window(
-  ParticleCatalogue& catalogue_rand, LineOfSight* los_rand,
+  ParticleCatalogue& catalogue_rand, LoSPolicy los_rand,
   trv::ParameterSet& params, trv::Binning& rbinning,
   double alpha, double norm_factor, bool wide_angle=false
 );
@@ -274,10 +374,11 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
  * @brief Compute bispectrum from paired survey-type catalogues with
  *        a particular choice of line of sight.
  *
+ * @tparam LoSPolicy Line-of-sight policy type.
  * @param catalogue_data (Data-source) particle catalogue.
  * @param catalogue_rand (Random-source) particle catalogue.
- * @param los_data (Data-source) particle lines of sight.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_data (Data-source) line-of-sight policy.
+ * @param los_rand (Random-source) line-of-sight policy.
  * @param los_choice Choice of line of sight in {0, 1, 2}.
  * @param params Parameter set.
  * @param kbin Wavenumber binning.
@@ -285,9 +386,10 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
  * @param norm Normalisation factor.
  * @returns Bispectrum measurements.
  */
+template <class LoSPolicy>
 trv::BispecMeasurements compute_bispec_for_los_choice(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
   int los_choice,
   trv::ParameterSet& params, trv::Binning& kbinning,
   double norm_factor
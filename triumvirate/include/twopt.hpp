@@ -37,9 +37,12 @@
 #ifndef TRIUMVIRATE_INCLUDE_TWOPT_HPP_INCLUDED_
 #define TRIUMVIRATE_INCLUDE_TWOPT_HPP_INCLUDED_
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
 #include <cstdio>
+#include <memory>
+#include <vector>
 
 #include "monitor.hpp"
 #include "maths.hpp"
@@ -97,6 +100,36 @@ double calc_powspec_normalisation_from_particles(
   ParticleCatalogue& particles, double alpha=1.
 );
 
+/**
+ * @brief Calculate mesh-based power spectrum normalisation from
+ *        a streamed particle catalogue.
+ *
+ * @param stream Particle catalogue stream.
+ * @param params Parameter set.
+ * @param alpha Alpha contrast.
+ * @returns Power spectrum normalisation factor.
+ *
+ * @overload
+ */
+double calc_powspec_normalisation_from_mesh(
+  trv::ParticleCatalogueStream& stream, trv::ParameterSet& params,
+  double alpha=1.
+);
+
+/**
+ * @brief Calculate particle-based power spectrum normalisation from
+ *        a streamed particle catalogue.
+ *
+ * @param stream Particle catalogue stream.
+ * @param alpha Alpha contrast.
+ * @returns Power spectrum normalisation factor.
+ *
+ * @overload
+ */
+double calc_powspec_normalisation_from_particles(
+  ParticleCatalogueStream& stream, double alpha=1.
+);
+
 
 /// **********************************************************************
 /// Shot noise
@@ -106,12 +139,9 @@ double calc_powspec_normalisation_from_particles(
  * @brief Calculate particle-based power spectrum shot noise level.
  *
  * @param particles Particle catalogue.
- * @param alpha Alpha contrast.
- * @returns Power spectrum normalisation factor.
+ * @returns Power spectrum shot noise level.
  */
-double calc_powspec_shotnoise_from_particles(
-  ParticleCatalogue& particles, double alpha=1.
-);
+double calc_powspec_shotnoise_from_particles(ParticleCatalogue& particles);
 
 /**
  * @brief Calculate power spectrum shot noise weighted by
@@ -133,18 +163,20 @@ double calc_powspec_shotnoise_from_particles(
  *     \alpha^2 \sum_{i \in mathrm{data or rand}} \,.
  * f@]
  *
+ * @tparam LoSPolicy Line-of-sight policy type.
  * @param catalogue_data (Data-source) particle catalogue.
  * @param catalogue_rand (Random-source) particle catalogue.
- * @param los_data (Data-source) particle lines of sight.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_data (Data-source) line-of-sight policy.
+ * @param los_rand (Random-source) line-of-sight policy.
  * @param alpha Alpha contrast.
  * @param ell Degree of the spherical harmonic.
  * @param m Order of the spherical harmonic.
  * @returns Weighted shot noise for power spectrum.
  */
+template <class LoSPolicy>
 std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
   ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
   double alpha, int ell, int m
 );
 
@@ -152,8 +184,9 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
  * @brief Calculate power spectrum shot noise weighted by
  *        reduced spherical harmonics.
  *
+ * @tparam LoSPolicy Line-of-sight policy type.
  * @param particles Particle catalogue.
- * @param los Particle lines of sight.
+ * @param los Line-of-sight policy.
  * @param alpha Alpha contrast.
  * @param ell Degree of the spherical harmonic.
  * @param m Order of the spherical harmonic.
@@ -161,12 +194,131 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
  *
  * @overload
  */
+template <class LoSPolicy>
 std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
-  ParticleCatalogue& particles, LineOfSight* los,
+  ParticleCatalogue& particles, LoSPolicy los,
   double alpha, int ell, int m
 );
 
 
+/// **********************************************************************
+/// Streamed fields
+/// **********************************************************************
+
+/**
+ * @brief Compute the fields and shot noise amplitudes weighted by
+ *        reduced spherical harmonics for two-point statistics, with the
+ *        random-source catalogue streamed in chunks.
+ *
+ * The fields f@$ \delta{n}_{00} f@$ and f@$ \delta{n}_{LM} f@$ for all
+ * degrees f@$ L f@$ and orders f@$ M f@$, the shot noise amplitudes
+ * f@$ \bar{N}_{LM} f@$ and the power spectrum normalisation factors
+ * are accumulated chunk by chunk in a single pass over the
+ * random-source catalogue file.
+ *
+ * @note All fields are held in memory at once, i.e.
+ *       f@$ 1 + \sum_{L > 0} (2L + 1) f@$ meshes, in exchange for
+ *       reading the catalogue file only once for all degrees.
+ *
+ * @tparam LoSPolicy Line-of-sight policy type (independent of
+ *                   particle indices).
+ * @param[in] catalogue_data (Data-source) particle catalogue.
+ * @param[in] stream_rand (Random-source) particle catalogue stream.
+ * @param[in] los_data (Data-source) line-of-sight policy.
+ * @param[in] los_rand (Random-source) line-of-sight policy.
+ * @param[in] params Parameter set.
+ * @param[in] ells Multipole degrees.
+ * @param[in] alpha Alpha contrast.
+ * @param[out] dn_fields Batch of field f@$ \delta{n}_{00} f@$
+ *                       (indexed by 0) followed by fields
+ *                       f@$ \delta{n}_{LM} f@$ for each positive
+ *                       degree in the order of @p ells (each
+ *                       indexed by f@$ M + L f@$ from its offset).
+ * @param[out] sn_amp Shot noise amplitudes f@$ \bar{N}_{LM} f@$ for
+ *                    each degree in the order of @p ells (indexed
+ *                    by f@$ M + L f@$).
+ * @param[out] norm_factor_part Particle-based power spectrum
+ *                              normalisation factor.
+ * @param[out] norm_factor_mesh Mesh-based power spectrum
+ *                              normalisation factor.
+ * @throws trv::sys::InvalidParameter When the number of fields does
+ *                                    not match the multipole degrees.
+ *
+ * @see trv::calc_powspec_normalisation_from_particles,
+ *      trv::calc_powspec_normalisation_from_mesh
+ */
+template <class LoSPolicy>
+void compute_ylm_wgtd_fields_for_2pt_streamed(
+  ParticleCatalogue& catalogue_data, ParticleCatalogueStream& stream_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
+  trv::ParameterSet& params, std::vector<int>& ells, double alpha,
+  MeshFieldBatch& dn_fields,
+  std::vector< std::vector< std::complex<double> > >& sn_amp,
+  double& norm_factor_part, double& norm_factor_mesh
+);
+
+
+/// **********************************************************************
+/// Mesh folding
+/// **********************************************************************
+
+/**
+ * @brief Set up a parameter set for a folded mesh grid.
+ *
+ * Particle positions wrapped modulo f@$ L / f f@$ for a folding factor
+ * f@$ f f@$ sample exactly the Fourier modes of the full box at
+ * multiples of f@$ f f@$ times the fundamental wavenumber, so the same
+ * mesh grid size reaches f@$ f f@$ times the Nyquist wavenumber.
+ *
+ * @param[in] params Parameter set.
+ * @param[out] params_fold Parameter set for the folded box (without
+ *                         further folding).
+ */
+void set_folded_mesh_params(
+  trv::ParameterSet& params, trv::ParameterSet& params_fold
+);
+
+/**
+ * @brief Stitch power spectrum measurements on a folded mesh grid onto
+ *        the unfolded ones.
+ *
+ * Bins with lower edges at or above
+ * @ref trv::ParameterSet::fold_kstitch take the folded measurements,
+ * which are normalised for the folded box volume and rescaled to the
+ * full box volume.
+ *
+ * @param[in] params Parameter set.
+ * @param[in] params_fold Parameter set for the folded box.
+ * @param[in] kbinning Wavenumber binning.
+ * @param[in] meas_fold Folded measurements.
+ * @param[in,out] meas Unfolded measurements.
+ */
+void stitch_folded_measurements(
+  trv::ParameterSet& params, trv::ParameterSet& params_fold,
+  trv::Binning& kbinning,
+  trv::PowspecMeasurements& meas_fold, trv::PowspecMeasurements& meas
+);
+
+/**
+ * @brief Stitch power spectrum wedge measurements on a folded mesh grid
+ *        onto the unfolded ones.
+ *
+ * @param[in] params Parameter set.
+ * @param[in] params_fold Parameter set for the folded box.
+ * @param[in] kbinning Wavenumber binning.
+ * @param[in] meas_fold Folded measurements.
+ * @param[in,out] meas Unfolded measurements.
+ *
+ * @overload
+ */
+void stitch_folded_measurements(
+  trv::ParameterSet& params, trv::ParameterSet& params_fold,
+  trv::Binning& kbinning,
+  trv::PowspecWedgeMeasurements& meas_fold,
+  trv::PowspecWedgeMeasurements& meas
+);
+
+
 /// **********************************************************************
 /// Full statistics
 /// **********************************************************************
@@ -177,19 +329,63 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
 /**
  * @brief Compute power spectrum from paired survey-type catalogues.
  *
+ * If @p wedges_out is given and
+ * @ref trv::ParameterSet::num_mu_bins is positive, power spectrum
+ * wedges in (k, |μ|) bins with respect to the global line of sight
+ * are also measured in the same pass over the mesh as the monopole
+ * field, which requires a global line-of-sight policy
+ * (see @ref trv::GlobalLineOfSight).
+ *
+ * @tparam LoSPolicy Line-of-sight policy type.
+ * @param[in] catalogue_data (Data-source) particle catalogue.
+ * @param[in] catalogue_rand (Random-source) particle catalogue.
+ * @param[in] los_data (Data-source) line-of-sight policy.
+ * @param[in] los_rand (Random-source) line-of-sight policy.
+ * @param[in] params Parameter set.
+ * @param[in] kbinning Wavenumber binning.
+ * @param[in] norm_factor Normalisation factor.
+ * @param[out] wedges_out Power spectrum wedge measurements (optional).
+ * @returns Power spectrum measurements.
+ * @throws trv::sys::InvalidParameter When wedges are requested without
+ *                                    a global line-of-sight policy.
+ */
+template <class LoSPolicy>
+trv::PowspecMeasurements compute_powspec(
+  ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
+  trv::ParameterSet& params, trv::Binning& kbinning,
+  double norm_factor,
+  trv::PowspecWedgeMeasurements* wedges_out = nullptr
+);
+
+/**
+ * @brief Compute multiple power spectrum multipoles from paired
+ *        survey-type catalogues.
+ *
+ * The field f@$ \delta{n}_{00} f@$ is shared by all multipoles, each
+ * field f@$ \delta{n}_{LM} f@$ is assigned and transformed once, and
+ * all multipoles of the same order f@$ M f@$ are binned in a single
+ * pass over the mesh.
+ *
+ * @tparam LoSPolicy Line-of-sight policy type.
  * @param catalogue_data (Data-source) particle catalogue.
  * @param catalogue_rand (Random-source) particle catalogue.
- * @param los_data (Data-source) particle lines of sight.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_data (Data-source) line-of-sight policy.
+ * @param los_rand (Random-source) line-of-sight policy.
  * @param params Parameter set.
+ * @param ells Multipole degrees.
  * @param kbinning Wavenumber binning.
  * @param norm_factor Normalisation factor.
- * @returns Power spectrum measurements.
+ * @returns Power spectrum measurements for each multipole degree
+ *          in the order of @p ells.
+ * @throws trv::sys::InvalidParameter When @p ells is empty or contains
+ *                                    negative degrees.
  */
-trv::PowspecMeasurements compute_powspec(
+template <class LoSPolicy>
+std::vector<trv::PowspecMeasurements> compute_powspec_multipoles(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
-  trv::ParameterSet& params, trv::Binning& kbinning,
+  LoSPolicy los_data, LoSPolicy los_rand,
+  trv::ParameterSet& params, std::vector<int>& ells, trv::Binning& kbinning,
   double norm_factor
 );
 
@@ -197,36 +393,174 @@ trv::PowspecMeasurements compute_powspec(
  * @brief Compute two-point correlation function from paired
  *        survey-type catalogues.
  *
+ * @tparam LoSPolicy Line-of-sight policy type.
  * @param catalogue_data (Data-source) particle catalogue.
  * @param catalogue_rand (Random-source) particle catalogue.
- * @param los_data (Data-source) particle lines of sight.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_data (Data-source) line-of-sight policy.
+ * @param los_rand (Random-source) line-of-sight policy.
  * @param params Parameter set.
  * @param rbinning Separation binning.
  * @param norm_factor Normalisation factor.
  * @returns Two-point correlation function measurements.
  */
+template <class LoSPolicy>
 trv::TwoPCFMeasurements compute_corrfunc(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
   trv::ParameterSet& params, trv::Binning& rbinning,
   double norm_factor
 );
 
+/**
+ * @brief Compute power spectrum from paired survey-type catalogues
+ *        with the random-source catalogue streamed in chunks.
+ *
+ * The normalisation factors are computed in the same pass over the
+ * random-source catalogue file as the fields, with the one used
+ * chosen by @ref trv::ParameterSet::norm_convention.
+ *
+ * @tparam LoSPolicy Line-of-sight policy type (independent of
+ *                   particle indices).
+ * @param[in] catalogue_data (Data-source) particle catalogue.
+ * @param[in] stream_rand (Random-source) particle catalogue stream.
+ * @param[in] los_data (Data-source) line-of-sight policy.
+ * @param[in] los_rand (Random-source) line-of-sight policy.
+ * @param[in] params Parameter set.
+ * @param[in] kbinning Wavenumber binning.
+ * @param[out] norm_factor Normalisation factor (used).
+ * @param[out] norm_factor_alt Normalisation factor (alternative).
+ * @returns Power spectrum measurements.
+ *
+ * @overload
+ */
+template <class LoSPolicy>
+trv::PowspecMeasurements compute_powspec(
+  ParticleCatalogue& catalogue_data, ParticleCatalogueStream& stream_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
+  trv::ParameterSet& params, trv::Binning& kbinning,
+  double& norm_factor, double& norm_factor_alt
+);
+
+/**
+ * @brief Compute multiple power spectrum multipoles from paired
+ *        survey-type catalogues with the random-source catalogue
+ *        streamed in chunks.
+ *
+ * All fields and the normalisation factors are computed in a single
+ * pass over the random-source catalogue file (see
+ * @ref trv::compute_ylm_wgtd_fields_for_2pt_streamed for the memory
+ * cost).
+ *
+ * @tparam LoSPolicy Line-of-sight policy type (independent of
+ *                   particle indices).
+ * @param[in] catalogue_data (Data-source) particle catalogue.
+ * @param[in] stream_rand (Random-source) particle catalogue stream.
+ * @param[in] los_data (Data-source) line-of-sight policy.
+ * @param[in] los_rand (Random-source) line-of-sight policy.
+ * @param[in] params Parameter set.
+ * @param[in] ells Multipole degrees.
+ * @param[in] kbinning Wavenumber binning.
+ * @param[out] norm_factor Normalisation factor (used).
+ * @param[out] norm_factor_alt Normalisation factor (alternative).
+ * @returns Power spectrum measurements for each multipole degree
+ *          in the order of @p ells.
+ * @throws trv::sys::InvalidParameter When @p ells is empty or contains
+ *                                    negative degrees.
+ *
+ * @overload
+ */
+template <class LoSPolicy>
+std::vector<trv::PowspecMeasurements> compute_powspec_multipoles(
+  ParticleCatalogue& catalogue_data, ParticleCatalogueStream& stream_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
+  trv::ParameterSet& params, std::vector<int>& ells, trv::Binning& kbinning,
+  double& norm_factor, double& norm_factor_alt
+);
+
+/**
+ * @brief Compute two-point correlation function from paired
+ *        survey-type catalogues with the random-source catalogue
+ *        streamed in chunks.
+ *
+ * The normalisation factors are computed in the same pass over the
+ * random-source catalogue file as the fields, with the one used
+ * chosen by @ref trv::ParameterSet::norm_convention.
+ *
+ * @tparam LoSPolicy Line-of-sight policy type (independent of
+ *                   particle indices).
+ * @param[in] catalogue_data (Data-source) particle catalogue.
+ * @param[in] stream_rand (Random-source) particle catalogue stream.
+ * @param[in] los_data (Data-source) line-of-sight policy.
+ * @param[in] los_rand (Random-source) line-of-sight policy.
+ * @param[in] params Parameter set.
+ * @param[in] rbinning Separation binning.
+ * @param[out] norm_factor Normalisation factor (used).
+ * @param[out] norm_factor_alt Normalisation factor (alternative).
+ * @returns Two-point correlation function measurements.
+ *
+ * @overload
+ */
+template <class LoSPolicy>
+trv::TwoPCFMeasurements compute_corrfunc(
+  ParticleCatalogue& catalogue_data, ParticleCatalogueStream& stream_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
+  trv::ParameterSet& params, trv::Binning& rbinning,
+  double& norm_factor, double& norm_factor_alt
+);
+
 /**
  * @brief Compute power spectrum in a periodic box in the global
  *        plane-parallel approximation.
  *
- * @param catalogue_data (Data-source) particle catalogue.
- * @param params Parameter set.
- * @param kbinning Wavenumber binning.
- * @param norm_factor Normalisation factor.
+ * If @p wedges_out is given and
+ * @ref trv::ParameterSet::num_mu_bins is positive, power spectrum
+ * wedges in (k, |μ|) bins with respect to the z-axis are also measured
+ * in the same pass over the mesh.
+ *
+ * If @ref trv::ParameterSet::fold_factor is greater than 1, the
+ * measurements are repeated on the folded mesh grid (see
+ * @ref trv::set_folded_mesh_params) and stitched onto the unfolded
+ * ones (see @ref trv::stitch_folded_measurements).
+ *
+ * @param[in] catalogue_data (Data-source) particle catalogue.
+ * @param[in] params Parameter set.
+ * @param[in] kbinning Wavenumber binning.
+ * @param[in] norm_factor Normalisation factor.
+ * @param[out] wedges_out Power spectrum wedge measurements (optional).
  * @returns Power spectrum measurements.
  */
 trv::PowspecMeasurements compute_powspec_in_gpp_box(
   ParticleCatalogue& catalogue_data,
   trv::ParameterSet& params, trv::Binning kbinning,
-  double norm_factor
+  double norm_factor,
+  trv::PowspecWedgeMeasurements* wedges_out = nullptr
+);
+
+/**
+ * @brief Compute multiple power spectrum multipoles in a periodic box
+ *        in the global plane-parallel approximation.
+ *
+ * All multipoles, and wedges if requested as in
+ * @ref trv::compute_powspec_in_gpp_box, are binned from the same
+ * transformed field in a single pass over the mesh.  Mesh folding
+ * is applied as in @ref trv::compute_powspec_in_gpp_box.
+ *
+ * @param[in] catalogue_data (Data-source) particle catalogue.
+ * @param[in] params Parameter set.
+ * @param[in] ells Multipole degrees.
+ * @param[in] kbinning Wavenumber binning.
+ * @param[in] norm_factor Normalisation factor.
+ * @param[out] wedges_out Power spectrum wedge measurements (optional).
+ * @returns Power spectrum measurements for each multipole degree
+ *          in the order of @p ells.
+ * @throws trv::sys::InvalidParameter When @p ells is empty or contains
+ *                                    negative degrees.
+ */
+std::vector<trv::PowspecMeasurements> compute_powspec_multipoles_in_gpp_box(
+  ParticleCatalogue& catalogue_data,
+  trv::ParameterSet& params, std::vector<int>& ells, trv::Binning kbinning,
+  double norm_factor,
+  trv::PowspecWedgeMeasurements* wedges_out = nullptr
 );
 
 /**
@@ -249,16 +583,18 @@ trv::TwoPCFMeasurements compute_corrfunc_in_gpp_box(
  * Compute two-point correlation function window from a random catalogue
  * and optionally save the results.
  *
+ * @tparam LoSPolicy Line-of-sight policy type.
  * @param catalogue_rand (Random-source) particle catalogue.
- * @param los_rand (Random-source) particle lines of sight.
+ * @param los_rand (Random-source) line-of-sight policy.
  * @param params Parameter set.
  * @param rbinning Separation binning.
  * @param alpha Alpha contrast.
  * @param norm_factor Normalisation factor.
  * @returns Two-point correlation function window measurements.
  */
+template <class LoSPolicy>
 trv::TwoPCFWindowMeasurements compute_corrfunc_window(
-  trv::ParticleCatalogue& catalogue_rand, trv::LineOfSight* los_rand,
+  trv::ParticleCatalogue& catalogue_rand, LoSPolicy los_rand,
   trv::ParameterSet& params, trv::Binning rbinning,
   double alpha, double norm_factor
 );
@@ -62,6 +62,8 @@ cdef extern from "include/parameters.hpp":
         int num_bins
         int idx_bin
 
+        int num_mu_bins
+
         # -- Misc --------------------------------------------------------
 
         int verbose
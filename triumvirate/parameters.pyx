@@ -44,6 +44,7 @@ _DEFAULT_PARAM_DICT = {
     'range': [None, None],
     'num_bins': None,
     'idx_bin': None,
+    'num_mu_bins': None,
     'verbose': 20,
 }
 
@@ -311,6 +312,8 @@ cdef class ParameterSet:
             raise InvalidParameter("`num_bins` parameter must be set.")
         if self._params['idx_bin'] is not None:
             self.thisptr.idx_bin = self._params['idx_bin']
+        if self._params.get('num_mu_bins') is not None:
+            self.thisptr.num_mu_bins = self._params['num_mu_bins']
 
         # Attribute string parameters.
         if self._params['catalogue_type'] is not None:
@@ -363,6 +366,7 @@ cdef class ParameterSet:
         self._params['npoint'] = self.thisptr.npoint.decode('utf-8')
         self._params['space'] = self.thisptr.space.decode('utf-8')
         self._params['interlace'] = self.thisptr.interlace.decode('utf-8')
+        self._params['num_mu_bins'] = self.thisptr.num_mu_bins
 
         self._validity = True
 
@@ -26,6 +26,9 @@
 
 #include "fftlog.hpp"
 
+#include <memory>
+
+namespace trvs = trv::sys;
 namespace trvm = trv::maths;
 
 namespace trv {
@@ -128,12 +131,16 @@ void hankel_transform(
   /// Compute the convolution b = a * u using FFT.
   /// ``(`` and ``)`` necessary
   /// (see https://www.fftw.org/doc/Complex-numbers.html).
-  fftw_plan forward_plan = fftw_plan_dft_1d(
-    N, (fftw_complex*) a, (fftw_complex*) b, -1, FFTW_ESTIMATE
-  );
-  fftw_plan reverse_plan = fftw_plan_dft_1d(
-    N, (fftw_complex*) b, (fftw_complex*) b, +1, FFTW_ESTIMATE
-  );
+  fftw_plan forward_plan, reverse_plan;
+  {
+    auto planner_lock = trv::sys::lock_fftw_planner();
+    forward_plan = fftw_plan_dft_1d(
+      N, (fftw_complex*) a, (fftw_complex*) b, -1, FFTW_ESTIMATE
+    );
+    reverse_plan = fftw_plan_dft_1d(
+      N, (fftw_complex*) b, (fftw_complex*) b, +1, FFTW_ESTIMATE
+    );
+  }
 
   fftw_execute(forward_plan);
   for (int m = 0; m < N; m++) {
@@ -141,8 +148,11 @@ void hankel_transform(
   }
   fftw_execute(reverse_plan);
 
-  fftw_destroy_plan(forward_plan);
-  fftw_destroy_plan(reverse_plan);
+  {
+    auto planner_lock = trv::sys::lock_fftw_planner();
+    fftw_destroy_plan(forward_plan);
+    fftw_destroy_plan(reverse_plan);
+  }
 
   /// Reverse the array `b`.
   std::complex<double> b_;
@@ -155,51 +165,279 @@ void hankel_transform(
   delete[] u_;
 }
 
-void sj_transform(
-  int ell, int m, int N, double* r, double* a, double* k, double* b
+HankelTransformer::HankelTransformer(
+  double mu, double q, double kr_c, int N, bool lowring, const double r[]
 ) {
-  double mu = ell + 1./2;
-  double q = 0.;
-  double kr_c = 1.;
-  bool lowring = true;
+  this->mu = mu;
+  this->q = q;
+  this->N = N;
+  this->r.assign(r, r + N);
 
-  std::complex<double> A[N];
-  std::complex<double> B[N];
+  /// Calculate the logarithmic interval.
+  this->L = N * std::log(r[N - 1] / r[0]) / (N - 1.);
 
-  for (int j = 0; j < N; j++) {
-    A[j] = std::pow(r[j], m - 1./2) * a[j];
+  /// Compute the forward transform kernel.
+  if (lowring) {
+    kr_c = calc_kr_pivot_lowring(mu, q, this->L, N, kr_c);
   }
+  this->kr_c = kr_c;
 
-  hankel_transform(mu, q, kr_c, N, lowring, r, A, k, B, nullptr);
+  this->u.resize(N);
+  compute_u_kernel_coeff(mu, q, this->L, N, kr_c, this->u.data());
 
-  for (int j = 0; j < N; j++) {
-    std::complex<double> bj = std::pow(2*M_PI * k[j], -3./2) * B[j];
-    b[j] = bj.real();
+  /// Compute output sample points corresponding to the input sample points.
+  double kr_0 = kr_c * std::exp(-this->L);
+
+  this->k.resize(N);
+  this->k[0] = kr_0 / r[0];
+  for (int j = 1; j < N; j++) {
+    this->k[j] = this->k[0] * std::exp(j * this->L / N);
+  }
+
+  /// Allocate work buffers for each thread, which share the alignment
+  /// of FFTW allocation so that the plans below apply to all of them.
+#ifdef TRV_USE_OMP
+  this->nthreads = omp_get_max_threads();
+#else  // !TRV_USE_OMP
+  this->nthreads = 1;
+#endif  // TRV_USE_OMP
+  for (int ibuf = 0; ibuf < this->nthreads; ibuf++) {
+    this->work_in.push_back(fftw_alloc_complex(N));
+    this->work_out.push_back(fftw_alloc_complex(N));
+  }
+
+  /// Plan the convolution b = a * u using FFT once.
+  {
+    auto planner_lock = trv::sys::lock_fftw_planner();
+#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
+    fftw_plan_with_nthreads(1);  // threads are used across transforms
+#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+    this->forward_plan = fftw_plan_dft_1d(
+      N, this->work_in[0], this->work_out[0], -1, FFTW_ESTIMATE
+    );
+    this->reverse_plan = fftw_plan_dft_1d(
+      N, this->work_out[0], this->work_out[0], +1, FFTW_ESTIMATE
+    );
   }
 }
 
-void sj_transform_symm_biased(
-  int ell, int i, int N, double* r, double* a, double* k, double* b
+HankelTransformer::~HankelTransformer() {
+  {
+    auto planner_lock = trv::sys::lock_fftw_planner();
+    fftw_destroy_plan(this->forward_plan);
+    fftw_destroy_plan(this->reverse_plan);
+  }
+
+  for (int ibuf = 0; ibuf < this->nthreads; ibuf++) {
+    fftw_free(this->work_in[ibuf]);
+    fftw_free(this->work_out[ibuf]);
+  }
+}
+
+void HankelTransformer::convolve(int ibuf) {
+  fftw_execute_dft(
+    this->forward_plan, this->work_in[ibuf], this->work_out[ibuf]
+  );
+
+  std::complex<double>* b = (std::complex<double>*) this->work_out[ibuf];
+  for (int m = 0; m < this->N; m++) {
+    b[m] *= this->u[m] / double(this->N);  // normalise the inverse DFT
+  }
+
+  fftw_execute_dft(
+    this->reverse_plan, this->work_out[ibuf], this->work_out[ibuf]
+  );
+}
+
+void HankelTransformer::transform(
+  const std::complex<double> a[], std::complex<double> b[]
 ) {
-  double mu = ell + 1./2;
-  double m = 2.;
-  double q = 0.;
-  double kr_c = 1.;
-  bool lowring = true;
+  this->transform(1, a, b);
+}
+
+void HankelTransformer::transform(
+  int nbatch, const std::complex<double> a[], std::complex<double> b[]
+) {
+  std::lock_guard<std::mutex> work_lock(this->work_mutex);
 
-  std::complex<double> A[N];
-  std::complex<double> B[N];
+  const int N = this->N;
 
-  for (int j = 0; j < N; j++) {
-    A[j] = std::pow(r[j], m + i - 1./2) * a[j];
+#ifdef TRV_USE_OMP
+#pragma omp parallel for num_threads(this->nthreads) if (nbatch > 1)
+#endif  // TRV_USE_OMP
+  for (int ibatch = 0; ibatch < nbatch; ibatch++) {
+#ifdef TRV_USE_OMP
+    int ibuf = omp_get_thread_num();
+#else  // !TRV_USE_OMP
+    int ibuf = 0;
+#endif  // TRV_USE_OMP
+
+    const std::complex<double>* a_ = a + (long long)(ibatch) * N;
+    std::complex<double>* b_ = b + (long long)(ibatch) * N;
+
+    std::complex<double>* in = (std::complex<double>*) this->work_in[ibuf];
+    std::complex<double>* out = (std::complex<double>*) this->work_out[ibuf];
+
+    std::copy(a_, a_ + N, in);
+
+    this->convolve(ibuf);
+
+    /// Reverse the convolution output.
+    for (int n = 0; n < N; n++) {
+      b_[n] = out[N - n - 1];
+    }
   }
+}
+
+void HankelTransformer::sj_transform(
+  double n, int nbatch, const double a[], double b[]
+) {
+  std::lock_guard<std::mutex> work_lock(this->work_mutex);
 
-  hankel_transform(mu, q, kr_c, N, lowring, r, A, k, B, nullptr);
+  const int N = this->N;
 
+  /// Compute power-law factors shared by all transforms.
+  std::vector<double> pre_factor(N), post_factor(N);
   for (int j = 0; j < N; j++) {
-    std::complex<double> bj = std::pow(2*M_PI * k[j], -3./2) * B[j];
-    b[j] = bj.real();
+    pre_factor[j] = std::pow(this->r[j], n - 1./2);
+    post_factor[j] = std::pow(2*M_PI * this->k[j], -3./2);
+  }
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for num_threads(this->nthreads) if (nbatch > 1)
+#endif  // TRV_USE_OMP
+  for (int ibatch = 0; ibatch < nbatch; ibatch++) {
+#ifdef TRV_USE_OMP
+    int ibuf = omp_get_thread_num();
+#else  // !TRV_USE_OMP
+    int ibuf = 0;
+#endif  // TRV_USE_OMP
+
+    const double* a_ = a + (long long)(ibatch) * N;
+    double* b_ = b + (long long)(ibatch) * N;
+
+    std::complex<double>* in = (std::complex<double>*) this->work_in[ibuf];
+    std::complex<double>* out = (std::complex<double>*) this->work_out[ibuf];
+
+    for (int j = 0; j < N; j++) {
+      in[j] = pre_factor[j] * a_[j];
+    }
+
+    this->convolve(ibuf);
+
+    for (int j = 0; j < N; j++) {
+      b_[j] = post_factor[j] * out[N - j - 1].real();
+    }
+  }
+}
+
+BiHankelTransformer::BiHankelTransformer(
+  double mu1, double mu2, double q, double kr_c, int N, bool lowring,
+  const double r[]
+) : transformer_row(mu2, q, kr_c, N, lowring, r),
+    transformer_col(mu1, q, kr_c, N, lowring, r) {
+  this->N = N;
+  this->k = this->transformer_row.k;
+}
+
+void BiHankelTransformer::sj_transform(
+  double n, const double a[], double b[]
+) {
+  const int N = this->N;
+
+  std::vector<double> buf((long long)(N) * N), buf_t((long long)(N) * N);
+
+  /// Transform along the rows (second dimension) in a batch.
+  this->transformer_row.sj_transform(n, N, a, buf.data());
+
+  /// Transform along the columns (first dimension) in a batch
+  /// by transposition.
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      buf_t[(long long)(j) * N + i] = buf[(long long)(i) * N + j];
+    }
   }
+
+  this->transformer_col.sj_transform(n, N, buf_t.data(), buf.data());
+
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      b[(long long)(i) * N + j] = buf[(long long)(j) * N + i];
+    }
+  }
+}
+
+/**
+ * @brief Return a cached transformer for the spherical Bessel transforms
+ *        of a given order and pre-transform sample points.
+ *
+ * The most recently used transformers are kept, so that repeated
+ * transforms (e.g. of multipoles) reuse their kernels and plans.
+ *
+ * @param ell Order of the transform.
+ * @param N Sample number.
+ * @param r Pre-transform sample points.
+ * @returns Low-ringing transformer without power-law bias.
+ */
+static std::shared_ptr<HankelTransformer> get_sj_transformer(
+  int ell, int N, const double r[]
+) {
+  const double mu = ell + 1./2;
+  const double q = 0.;
+  const double kr_c = 1.;
+  const bool lowring = true;
+
+  const std::size_t ncache = 8;
+
+  /// The cache is never destroyed, so that no FFTW plans are destroyed
+  /// at exit (possibly after FFTW clean-up).
+  static std::mutex cache_mutex;
+  static auto* cache = new std::vector< std::shared_ptr<HankelTransformer> >;
+
+  std::lock_guard<std::mutex> cache_lock(cache_mutex);
+
+  for (auto it = cache->begin(); it != cache->end(); ++it) {
+    const HankelTransformer& cached = **it;
+    if (cached.mu == mu && cached.N == N
+        && std::equal(r, r + N, cached.r.begin())) {
+      std::shared_ptr<HankelTransformer> transformer = *it;
+      cache->erase(it);
+      cache->push_back(transformer);  // most recently used last
+      return transformer;
+    }
+  }
+
+  std::shared_ptr<HankelTransformer> transformer =
+    std::make_shared<HankelTransformer>(mu, q, kr_c, N, lowring, r);
+
+  cache->push_back(transformer);
+  if (cache->size() > ncache) {cache->erase(cache->begin());}
+
+  return transformer;
+}
+
+void sj_transform(
+  int ell, int m, int N, double* r, double* a, double* k, double* b
+) {
+  std::shared_ptr<HankelTransformer> transformer =
+    get_sj_transformer(ell, N, r);
+
+  transformer->sj_transform(m, 1, a, b);
+
+  std::copy(transformer->k.begin(), transformer->k.end(), k);
+}
+
+void sj_transform_symm_biased(
+  int ell, int i, int N, double* r, double* a, double* k, double* b
+) {
+  double m = 2.;
+
+  std::shared_ptr<HankelTransformer> transformer =
+    get_sj_transformer(ell, N, r);
+
+  transformer->sj_transform(m + i, 1, a, b);
+
+  std::copy(transformer->k.begin(), transformer->k.end(), k);
 }
 
 }  // namespace trv::maths
@@ -226,4 +464,116 @@ void transform_corrfunc_to_powspec_multipole(
   }
 }
 
+/**
+ * @brief Extrapolate square-grid samples and perform the
+ *        two-dimensional spherical Fourier--Bessel transform.
+ *
+ * @param[in] ell1, ell2 Orders of the transform.
+ * @param[in] N Sample number (in each dimension).
+ * @param[in] x Pre-transform sample points.
+ * @param[in] a Pre-transform sample values (in row-major order).
+ * @param[in] N_ext Extrapolation number on either end.
+ * @param[in] extrap Extrapolation scheme.
+ * @param[out] y Post-transform sample points.
+ * @param[out] b Post-transform sample values (in row-major order).
+ */
+static void transform_bihankel_extrap(
+  int ell1, int ell2, int N, double* x, double* a,
+  int N_ext, const std::string& extrap, double* y, double* b
+) {
+  int m = 2;
+  double q = 0.;
+  double kr_c = 1.;
+  bool lowring = true;
+
+  int N_samp = N + 2*N_ext;
+
+  /// Extrapolate the sample points and values.
+  std::vector<double> x_samp(N_samp);
+  std::vector<double> a_samp((long long)(N_samp) * N_samp);
+  if (N_ext > 0) {
+    std::vector< std::vector<double> > a_in(N, std::vector<double>(N));
+    std::vector< std::vector<double> > a_ext(
+      N_samp, std::vector<double>(N_samp)
+    );
+    for (int i = 0; i < N; i++) {
+      std::copy(a + (long long)(i) * N, a + (long long)(i + 1) * N,
+                a_in[i].begin());
+    }
+
+    if (extrap == "lin") {
+      trv::utils::extrap2d_bilin(a_in, N, N_ext, a_ext);
+    } else
+    if (extrap == "loglin") {
+      trv::utils::extrap2d_logbilin(a_in, N, N_ext, a_ext);
+    } else
+    if (extrap == "zero") {
+      trv::utils::extrap2d_bizeros(a_in, N, N_ext, a_ext);
+    } else {
+      if (trvs::currTask == 0) {
+        trvs::logger.error(
+          "Unknown extrapolation scheme: '%s'.", extrap.c_str()
+        );
+      }
+      throw trvs::InvalidParameter(
+        "Unknown extrapolation scheme: '%s'.\n", extrap.c_str()
+      );
+    }
+
+    trv::utils::extrap_loglin(x, N, N_ext, x_samp.data());
+    for (int i = 0; i < N_samp; i++) {
+      std::copy(a_ext[i].begin(), a_ext[i].end(),
+                a_samp.begin() + (long long)(i) * N_samp);
+    }
+  } else {
+    std::copy(x, x + N, x_samp.begin());
+    std::copy(a, a + (long long)(N) * N, a_samp.begin());
+  }
+
+  /// Perform the transform.
+  trvm::BiHankelTransformer transformer(
+    ell1 + 1./2, ell2 + 1./2, q, kr_c, N_samp, lowring, x_samp.data()
+  );
+
+  transformer.sj_transform(m, a_samp.data(), b);
+
+  std::copy(transformer.k.begin(), transformer.k.end(), y);
+}
+
+void transform_bispec_to_3pcf(
+  int ell1, int ell2, int N, double* k, double* bk,
+  int N_ext, const std::string& extrap, double* r, double* zeta
+) {
+  transform_bihankel_extrap(ell1, ell2, N, k, bk, N_ext, extrap, r, zeta);
+
+  /// An overall parity factor is needed here as it is not included
+  /// in the backend transforms.
+  int ell = ell1 + ell2;
+  double parity = (ell % 2 != 0) ? 0. : ((ell % 4 == 0) ? 1. : -1.);
+
+  long long N_samp = N + 2*N_ext;
+  for (long long idx = 0; idx < N_samp * N_samp; idx++) {
+    zeta[idx] *= parity;
+  }
+}
+
+void transform_3pcf_to_bispec(
+  int ell1, int ell2, int N, double* r, double* zeta,
+  int N_ext, const std::string& extrap, double* k, double* bk
+) {
+  transform_bihankel_extrap(ell1, ell2, N, r, zeta, N_ext, extrap, k, bk);
+
+  /// An overall parity factor is needed here as it is not included
+  /// in the backend transforms.  Factors of π are needed here as the
+  /// forward transform is used in the backend as the backward transform.
+  int ell = ell1 + ell2;
+  double parity = (ell % 2 != 0) ? 0. : ((ell % 4 == 0) ? 1. : -1.);
+  double factor = std::pow(2*M_PI, 6) * parity;
+
+  long long N_samp = N + 2*N_ext;
+  for (long long idx = 0; idx < N_samp * N_samp; idx++) {
+    bk[idx] *= factor;
+  }
+}
+
 }  // namespace trv
@@ -26,6 +26,18 @@
 
 #include "field.hpp"
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // __unix__ || __APPLE__
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
 namespace trvs = trv::sys;
 namespace trvm = trv::maths;
 
@@ -39,26 +51,70 @@ namespace trv {
 /// Life cycle
 /// ----------------------------------------------------------------------
 
-MeshField::MeshField(trv::ParameterSet& params) {
+MeshField::MeshField(trv::ParameterSet& params) : MeshField(params, true) {}
+
+MeshField::MeshField(trv::ParameterSet& params, bool alloc) {
   /// Attach the full parameter set to @ref trv::MeshField.
   this->params = params;
 
-  /// Initialise the field (and its shadow field if interlacing is used)
-  /// and increase allocated memory.
-  this->field = fftw_alloc_complex(this->params.nmesh);
+  /// Determine the local slab of the mesh.
+#ifdef TRV_USE_MPI
+  ptrdiff_t local_n0, local_0_start;
+  this->local_nalloc = fftw_mpi_local_size_3d(
+    this->params.ngrid[0], this->params.ngrid[1], this->params.ngrid[2],
+    MPI_COMM_WORLD, &local_n0, &local_0_start
+  );
+  this->local_x_begin = local_0_start;
+  this->local_x_end = local_0_start + local_n0;
+  this->local_nmesh =
+    local_n0 * this->params.ngrid[1] * this->params.ngrid[2];
+
+  /// Record the slab decomposition across all tasks.
+  this->slab_begins.resize(trvs::numTasks);
+  this->slab_ends.resize(trvs::numTasks);
+  MPI_Allgather(
+    &this->local_x_begin, 1, MPI_INT,
+    this->slab_begins.data(), 1, MPI_INT, MPI_COMM_WORLD
+  );
+  MPI_Allgather(
+    &this->local_x_end, 1, MPI_INT,
+    this->slab_ends.data(), 1, MPI_INT, MPI_COMM_WORLD
+  );
+
+  this->plane_tasks.resize(this->params.ngrid[0]);
+  for (int task = 0; task < trvs::numTasks; task++) {
+    for (int i = this->slab_begins[task]; i < this->slab_ends[task]; i++) {
+      this->plane_tasks[i] = task;
+    }
+  }
+#else  // !TRV_USE_MPI
+  this->local_x_begin = 0;
+  this->local_x_end = this->params.ngrid[0];
+  this->local_nmesh = this->params.nmesh;
+  this->local_nalloc = this->params.nmesh;
+#endif  // TRV_USE_MPI
 
-  trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(this->params.nmesh);
-  trv::sys::update_maxmem();
+  /// Initialise the field (and its shadow field if interlacing is used)
+  /// and increase allocated memory.  The shadow field is co-allocated
+  /// immediately after the field so that both can be transformed
+  /// together.
+  this->nslots = (this->params.interlace == "true") ? 2 : 1;
+  this->owns_field = alloc;
+  if (alloc) {
+    this->field = fftw_alloc_complex(this->nslots * this->local_nalloc);
+
+    trvs::count_alloc(
+      trvs::size_in_gb<fftw_complex>(this->nslots * this->local_nalloc),
+      trvs::MEM_MESH
+    );
 
-  if (this->params.interlace == "true") {
-    this->field_s = fftw_alloc_complex(this->params.nmesh);
+    if (this->params.interlace == "true") {
+      this->field_s = this->field + this->local_nalloc;
+    }
 
-    trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(this->params.nmesh);
-    trv::sys::update_maxmem();
+    this->initialise_density_field();  // likely redundant but safe
   }
 
-  this->initialise_density_field();  // likely redundant but safe
-
   /// Calculate grid sizes in configuration space.
   this->dr[0] = this->params.boxsize[0] / this->params.ngrid[0];
   this->dr[1] = this->params.boxsize[1] / this->params.ngrid[1];
@@ -77,10 +133,13 @@ MeshField::MeshField(trv::ParameterSet& params) {
 MeshField::~MeshField() {this->finalise_density_field();}
 
 void MeshField::initialise_density_field() {
+  /// A zero field is real.
+  this->real_valued = true;
+
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
+  for (int gid = 0; gid < this->local_nmesh; gid++) {
     this->field[gid][0] = 0.;
     this->field[gid][1] = 0.;
   }
@@ -88,7 +147,7 @@ void MeshField::initialise_density_field() {
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-    for (int gid = 0; gid < this->params.nmesh; gid++) {
+    for (int gid = 0; gid < this->local_nmesh; gid++) {
       this->field_s[gid][0] = 0.;
       this->field_s[gid][1] = 0.;
     }
@@ -96,15 +155,19 @@ void MeshField::initialise_density_field() {
 }
 
 void MeshField::finalise_density_field() {
-  /// Free memory usage.
-  if (this->field != nullptr) {
-    fftw_free(this->field); this->field = nullptr;
-    trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(this->params.nmesh);
-  }
-  if (this->field_s != nullptr) {
-    fftw_free(this->field_s); this->field_s = nullptr;
-    trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(this->params.nmesh);
+  /// Free memory usage (unless owned by a mesh field batch).
+  if (this->field != nullptr && this->owns_field) {
+    fftw_free(this->field);
+    trvs::count_dealloc(
+      trvs::size_in_gb<fftw_complex>(this->nslots * this->local_nalloc),
+      trvs::MEM_MESH
+    );
   }
+  this->field = nullptr;
+  this->field_s = nullptr;
+
+  ShellModeList().swap(this->shell_modes);
+  this->shell_modes_kmax = -1.;
 }
 
 
@@ -121,7 +184,8 @@ const fftw_complex& MeshField::operator[](int gid) {return this->field[gid];}
 
 long long MeshField::get_grid_index(int i, int j, int k) {
   long long idx_grid =
-    (i * this->params.ngrid[1] + j) * this->params.ngrid[2] + k;
+    ((i - this->local_x_begin) * this->params.ngrid[1] + j)
+    * this->params.ngrid[2] + k;
   return idx_grid;
 }
 
@@ -143,6 +207,328 @@ void MeshField::get_grid_wavevector(int i, int j, int k, double kvec[3]) {
     k * this->dk[2] : (k - this->params.ngrid[2]) * this->dk[2];
 }
 
+int MeshField::get_fourier_grid_index(int idx, int axis, MeshField& other) {
+  int n = (idx < this->params.ngrid[axis]/2) ?
+    idx : idx - this->params.ngrid[axis];
+  return (n + other.params.ngrid[axis]) % other.params.ngrid[axis];
+}
+
+int MeshField::get_hermitian_multiplicity(int i, int j, int k) {
+  if (2*i == this->params.ngrid[0] || 2*j == this->params.ngrid[1]) {
+    return 1;
+  }
+  if (k == 0 || 2*k == this->params.ngrid[2]) {return 1;}
+  return (2*k < this->params.ngrid[2]) ? 2 : 0;
+}
+
+long long MeshField::get_hermitian_partner_index(int i, int j, int k) {
+  return this->get_grid_index(
+    (this->params.ngrid[0] - i) % this->params.ngrid[0],
+    (this->params.ngrid[1] - j) % this->params.ngrid[1],
+    (this->params.ngrid[2] - k) % this->params.ngrid[2]
+  );
+}
+
+bool MeshField::if_mesh_local() {
+  return this->local_x_begin == 0
+    && this->local_x_end == this->params.ngrid[0];
+}
+
+bool MeshField::if_mode_retained(int i, int j, int k) {
+  if (this->params.subsample_frac >= 1.) {return true;}
+
+  /// Hash the global grid index of the canonical cell of the Hermitian
+  /// pair (i.e. the lesser index of the pair) with the SplitMix64
+  /// finaliser and compare the resulting uniform deviate against
+  /// the fraction.
+  auto ret_global_index = [this](int i_, int j_, int k_) {
+    return (
+      (unsigned long long)(i_) * this->params.ngrid[1] + j_
+    ) * this->params.ngrid[2] + k_;
+  };
+
+  unsigned long long z = std::min(
+    ret_global_index(i, j, k),
+    ret_global_index(
+      (this->params.ngrid[0] - i) % this->params.ngrid[0],
+      (this->params.ngrid[1] - j) % this->params.ngrid[1],
+      (this->params.ngrid[2] - k) % this->params.ngrid[2]
+    )
+  );
+  z += 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+
+  double u = double(z >> 11) / 9007199254740992.;  // 2⁵³
+
+  return u < this->params.subsample_frac;
+}
+
+bool MeshField::if_band_subsampled(
+  double k_lower, long long imode_begin, long long imode_end
+) {
+  if (
+    this->params.subsample_frac >= 1.
+    || k_lower < this->params.subsample_kmin
+  ) {
+    return false;
+  }
+
+  int nmodes_retained = 0;
+  for (long long imode = imode_begin; imode < imode_end; imode++) {
+    if (this->shell_modes[imode].retained) {
+      nmodes_retained += this->shell_modes[imode].mult;
+    }
+  }
+  trvs::sum_across_tasks(&nmodes_retained, 1);
+
+  return nmodes_retained > 0;
+}
+
+void MeshField::index_shell_modes(double k_max, bool half_space) {
+  ShellModeList().swap(this->shell_modes);
+
+  for (int i = this->local_x_begin; i < this->local_x_end; i++) {
+    for (int j = 0; j < this->params.ngrid[1]; j++) {
+      for (int k = 0; k < this->params.ngrid[2]; k++) {
+        int mult = half_space ? this->get_hermitian_multiplicity(i, j, k) : 1;
+        if (mult == 0) {continue;}
+
+        double kv[3];
+        this->get_grid_wavevector(i, j, k, kv);
+
+        double k_ = trvm::get_vec3d_magnitude(kv);
+        if (k_ > k_max) {continue;}
+
+        bool retained = this->if_mode_retained(i, j, k);
+
+        this->shell_modes.push_back(
+          ShellMode{k_, i, j, k, short(mult), retained}
+        );
+      }
+    }
+  }
+
+  std::sort(
+    this->shell_modes.begin(), this->shell_modes.end(),
+    [](const ShellMode& a, const ShellMode& b) {return a.kmag < b.kmag;}
+  );
+
+  this->shell_modes_kmax = k_max;
+  this->shell_modes_half_space = half_space;
+}
+
+fftw_plan MeshField::plan_dft_3d(fftw_complex* arr, int sign) {
+  auto planner_lock = trvs::lock_fftw_planner();
+
+#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
+  fftw_plan_with_nthreads(omp_get_max_threads());
+#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+
+#ifdef TRV_USE_MPI
+  return fftw_mpi_plan_dft_3d(
+    this->params.ngrid[0], this->params.ngrid[1], this->params.ngrid[2],
+    arr, arr, MPI_COMM_WORLD, sign, FFTW_ESTIMATE
+  );
+#else  // !TRV_USE_MPI
+  return fftw_plan_dft_3d(
+    this->params.ngrid[0], this->params.ngrid[1], this->params.ngrid[2],
+    arr, arr, sign, FFTW_ESTIMATE
+  );
+#endif  // TRV_USE_MPI
+}
+
+void MeshField::destroy_plan(fftw_plan plan) {
+  auto planner_lock = trvs::lock_fftw_planner();
+  fftw_destroy_plan(plan);
+}
+
+fftw_plan MeshField::get_cached_plan(
+  fftw_complex* arr, int howmany, long long dist, int sign
+) {
+  static std::map<std::vector<long long>, fftw_plan> plans;  // plan cache
+
+  int nthreads = 1;
+#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
+  nthreads = omp_get_max_threads();
+#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+
+  std::vector<long long> key = {
+    this->params.ngrid[0], this->params.ngrid[1], this->params.ngrid[2],
+    howmany, (howmany > 1) ? dist : 0LL, sign, nthreads,
+    fftw_alignment_of(reinterpret_cast<double*>(arr))
+  };
+
+  {
+    auto planner_lock = trvs::lock_fftw_planner();
+    auto it = plans.find(key);
+    if (it != plans.end()) {return it->second;}
+  }
+
+  /// Plan outside of the lookup lock, which planning acquires itself;
+  /// a plan raced in by another thread is kept in favour of this one.
+  fftw_plan plan;
+  if (howmany == 1) {
+    plan = this->plan_dft_3d(arr, sign);
+  } else {
+    int ngrid[3] = {
+      this->params.ngrid[0], this->params.ngrid[1], this->params.ngrid[2]
+    };
+
+    auto planner_lock = trvs::lock_fftw_planner();
+#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
+    fftw_plan_with_nthreads(nthreads);
+#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+    plan = fftw_plan_many_dft(
+      3, ngrid, howmany,
+      arr, nullptr, 1, int(dist),
+      arr, nullptr, 1, int(dist),
+      sign, FFTW_ESTIMATE
+    );
+  }
+
+  auto planner_lock = trvs::lock_fftw_planner();
+  auto inserted = plans.emplace(key, plan);
+  if (!inserted.second) {fftw_destroy_plan(plan);}
+
+  return inserted.first->second;
+}
+
+void MeshField::execute_dft_3d(fftw_complex* arr, int sign) {
+  fftw_plan plan = this->get_cached_plan(arr, 1, 0, sign);
+
+#ifdef TRV_USE_MPI
+  fftw_mpi_execute_dft(plan, arr, arr);
+#else  // !TRV_USE_MPI
+  fftw_execute_dft(plan, arr, arr);
+#endif  // TRV_USE_MPI
+}
+
+#ifdef TRV_USE_MPI
+int MeshField::locate_particle_task(const double pos[3]) {
+  /// A particle is owned by the task holding the mesh plane into which
+  /// it falls along the first (slab-decomposed) dimension.
+  int plane = int(
+    std::floor(this->params.ngrid[0] * pos[0] / this->params.boxsize[0])
+  );
+  plane %= this->params.ngrid[0];
+  if (plane < 0) {plane += this->params.ngrid[0];}
+
+  return this->plane_tasks[plane];
+}
+#endif  // TRV_USE_MPI
+
+fftw_complex* MeshField::locate_assignment_cell(
+  int i, int j, int k, bool shadow
+) {
+  long long gid =
+    (static_cast<long long>(i) * this->params.ngrid[1] + j)
+    * this->params.ngrid[2] + k;
+  if (gid < 0 || gid >= this->params.nmesh) {return nullptr;}
+
+  fftw_complex* arr = shadow ? this->field_s : this->field;
+
+#ifdef TRV_USE_MPI
+  const long long plane_size =
+    static_cast<long long>(this->params.ngrid[1]) * this->params.ngrid[2];
+  const int local_n = this->local_x_end - this->local_x_begin;
+
+  /// Locate the plane relative to the local slab, accounting for
+  /// the periodic boundary condition.
+  int dx = int(gid / plane_size) - this->local_x_begin;
+  if (dx < -ghost_width) {dx += this->params.ngrid[0];}
+  if (dx >= local_n + ghost_width) {dx -= this->params.ngrid[0];}
+
+  long long offset = gid % plane_size;
+  if (0 <= dx && dx < local_n) {
+    return &arr[dx * plane_size + offset];
+  }
+
+  /// Otherwise redirect to the ghost planes either side of the slab.
+  fftw_complex* ghost = shadow ? this->field_s_ghost : this->field_ghost;
+  if (-ghost_width <= dx && dx < 0) {
+    return &ghost[(dx + ghost_width) * plane_size + offset];
+  }
+  if (local_n <= dx && dx < local_n + ghost_width) {
+    return &ghost[(dx - local_n + ghost_width) * plane_size + offset];
+  }
+  return nullptr;
+#else  // !TRV_USE_MPI
+  return &arr[gid];
+#endif  // TRV_USE_MPI
+}
+
+#ifdef TRV_USE_MPI
+void MeshField::reduce_ghost_planes(fftw_complex* arr, fftw_complex* ghost) {
+  const int ngrid0 = this->params.ngrid[0];
+  const long long plane_size =
+    static_cast<long long>(this->params.ngrid[1]) * this->params.ngrid[2];
+  const int plane_len = 2 * plane_size;  // real and imaginary parts
+  const int nslots = 2 * ghost_width;
+
+  /// Map a ghost plane slot of any task to the global plane it shadows.
+  auto get_slot_plane = [&](int task, int slot) {
+    int slab_size = this->slab_ends[task] - this->slab_begins[task];
+    int dx = (slot < ghost_width)
+      ? slot - ghost_width : slab_size + slot - ghost_width;
+    return ((this->slab_begins[task] + dx) % ngrid0 + ngrid0) % ngrid0;
+  };
+
+  /// Count the planes to be sent to and received from each task.
+  std::vector<int> sendcounts(trvs::numTasks, 0);
+  std::vector<int> recvcounts(trvs::numTasks, 0);
+  for (int task = 0; task < trvs::numTasks; task++) {
+    for (int slot = 0; slot < nslots; slot++) {
+      int owner = this->plane_tasks[get_slot_plane(task, slot)];
+      if (task == trvs::currTask) {sendcounts[owner] += plane_len;}
+      if (owner == trvs::currTask) {recvcounts[task] += plane_len;}
+    }
+  }
+
+  std::vector<int> sdispls(trvs::numTasks, 0);
+  std::vector<int> rdispls(trvs::numTasks, 0);
+  for (int task = 1; task < trvs::numTasks; task++) {
+    sdispls[task] = sdispls[task - 1] + sendcounts[task - 1];
+    rdispls[task] = rdispls[task - 1] + recvcounts[task - 1];
+  }
+
+  /// Pack ghost planes by owner task.
+  std::vector<double> sendbuf(nslots * plane_len);
+  std::vector<int> spos(sdispls);
+  for (int slot = 0; slot < nslots; slot++) {
+    int owner = this->plane_tasks[get_slot_plane(trvs::currTask, slot)];
+    const double* src = &ghost[slot * plane_size][0];
+    std::copy(src, src + plane_len, sendbuf.begin() + spos[owner]);
+    spos[owner] += plane_len;
+  }
+
+  std::vector<double> recvbuf(
+    rdispls[trvs::numTasks - 1] + recvcounts[trvs::numTasks - 1]
+  );
+  MPI_Alltoallv(
+    sendbuf.data(), sendcounts.data(), sdispls.data(), MPI_DOUBLE,
+    recvbuf.data(), recvcounts.data(), rdispls.data(), MPI_DOUBLE,
+    MPI_COMM_WORLD
+  );
+
+  /// Add received ghost planes onto the local slab in the order packed.
+  long long rpos = 0;
+  for (int task = 0; task < trvs::numTasks; task++) {
+    for (int slot = 0; slot < nslots; slot++) {
+      int plane = get_slot_plane(task, slot);
+      if (this->plane_tasks[plane] != trvs::currTask) {continue;}
+
+      double* dest = &arr[(plane - this->local_x_begin) * plane_size][0];
+      for (int idx = 0; idx < plane_len; idx++) {
+        dest[idx] += recvbuf[rpos + idx];
+      }
+      rpos += plane_len;
+    }
+  }
+}
+#endif  // TRV_USE_MPI
+
 
 /// ----------------------------------------------------------------------
 /// Mesh assignment
@@ -151,6 +537,32 @@ void MeshField::get_grid_wavevector(int i, int j, int k, double kvec[3]) {
 void MeshField::assign_weighted_field_to_mesh(
   ParticleCatalogue& particles, fftw_complex* weights
 ) {
+  /// Reset field values to zero.
+  this->initialise_density_field();
+
+  this->add_weighted_field_to_mesh(particles, weights);
+}
+
+void MeshField::add_weighted_field_to_mesh(
+  ParticleCatalogue& particles, fftw_complex* weights
+) {
+  /// Weights may be complex.
+  this->real_valued = false;
+
+  this->add_kernel_weighted_field_to_mesh(
+    particles,
+    [weights](int pid) {
+      return std::complex<double>(weights[pid][0], weights[pid][1]);
+    }
+  );
+}
+
+template <class WeightKern>
+void MeshField::add_kernel_weighted_field_to_mesh(
+  ParticleCatalogue& particles, WeightKern weight_kern
+) {
+  trvs::StageTimer timer("assignment");
+
   for (int iaxis = 0; iaxis < 3; iaxis++) {
     double extent = particles.pos_max[iaxis] - particles.pos_min[iaxis];
     if (params.boxsize[iaxis] < extent) {
@@ -164,17 +576,164 @@ void MeshField::assign_weighted_field_to_mesh(
     }
   }
 
+#ifdef TRV_USE_MPI
+  /// Allocate ghost planes to collect contributions from particles
+  /// near the local slab boundaries.
+  const long long ghost_size = 2LL * ghost_width
+    * this->params.ngrid[1] * this->params.ngrid[2];
+  this->field_ghost = fftw_alloc_complex(ghost_size);
+  std::fill(
+    &this->field_ghost[0][0], &this->field_ghost[0][0] + 2*ghost_size, 0.
+  );
+  if (this->params.interlace == "true") {
+    this->field_s_ghost = fftw_alloc_complex(ghost_size);
+    std::fill(
+      &this->field_s_ghost[0][0], &this->field_s_ghost[0][0] + 2*ghost_size,
+      0.
+    );
+  }
+  const double gbytes_ghost =
+    trvs::size_in_gb<fftw_complex>(this->nslots * ghost_size);
+  trvs::count_alloc(gbytes_ghost, trvs::MEM_MESH);
+#endif  // TRV_USE_MPI
+
+#ifdef TRV_USE_MPI
+  /// Exchange particles to their owning tasks, so that each task
+  /// assigns only the particles in its slab.
+  ParticleCatalogue particles_owned;
+  std::vector< std::complex<double> > weights_owned;
+  this->exchange_particles_to_slabs(
+    particles, weight_kern, particles_owned, weights_owned
+  );
+
+  this->assign_weighted_field_to_mesh_by_scheme(
+    particles_owned,
+    [&weights_owned](int pid) {return weights_owned[pid];}
+  );
+#else  // !TRV_USE_MPI
+  this->assign_weighted_field_to_mesh_by_scheme(particles, weight_kern);
+#endif  // TRV_USE_MPI
+
+#ifdef TRV_USE_MPI
+  /// Reduce ghost planes onto the slabs of their owner tasks.
+  this->reduce_ghost_planes(this->field, this->field_ghost);
+  fftw_free(this->field_ghost); this->field_ghost = nullptr;
+  if (this->field_s_ghost != nullptr) {
+    this->reduce_ghost_planes(this->field_s, this->field_s_ghost);
+    fftw_free(this->field_s_ghost); this->field_s_ghost = nullptr;
+  }
+  trvs::count_dealloc(gbytes_ghost, trvs::MEM_MESH);
+#endif  // TRV_USE_MPI
+}
+
+#ifdef TRV_USE_MPI
+template <class WeightKern>
+void MeshField::exchange_particles_to_slabs(
+  ParticleCatalogue& particles, WeightKern weight_kern,
+  ParticleCatalogue& particles_owned,
+  std::vector< std::complex<double> >& weights_owned
+) {
+  const int nvals = 5;  // position and complex weight per particle
+
+  /// Evaluate the weights of the local share of particles.
+  const int pid_begin = int(
+    (long long)(particles.ntotal) * trvs::currTask / trvs::numTasks
+  );
+  const int pid_end = int(
+    (long long)(particles.ntotal) * (trvs::currTask + 1) / trvs::numTasks
+  );
+  const int nshare = pid_end - pid_begin;
+
+  std::vector<int> owners(nshare);
+  std::vector< std::complex<double> > weights(nshare);
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+  for (int pid = pid_begin; pid < pid_end; pid++) {
+    owners[pid - pid_begin] = this->locate_particle_task(particles[pid].pos);
+    weights[pid - pid_begin] = weight_kern(pid);
+  }
+
+  /// Pack particles by owning task.
+  std::vector<int> sendcounts(trvs::numTasks, 0);
+  std::vector<int> recvcounts(trvs::numTasks, 0);
+  std::vector<int> sdispls(trvs::numTasks, 0);
+  std::vector<int> rdispls(trvs::numTasks, 0);
+  for (int owner : owners) {sendcounts[owner] += nvals;}
+  for (int task = 1; task < trvs::numTasks; task++) {
+    sdispls[task] = sdispls[task - 1] + sendcounts[task - 1];
+  }
+
+  std::vector<double> sendbuf((long long)(nvals) * nshare);
+  std::vector<int> offsets = sdispls;
+  for (int pid = pid_begin; pid < pid_end; pid++) {
+    double* dest = &sendbuf[offsets[owners[pid - pid_begin]]];
+    dest[0] = particles[pid].pos[0];
+    dest[1] = particles[pid].pos[1];
+    dest[2] = particles[pid].pos[2];
+    dest[3] = weights[pid - pid_begin].real();
+    dest[4] = weights[pid - pid_begin].imag();
+    offsets[owners[pid - pid_begin]] += nvals;
+  }
+  std::vector<int>().swap(owners);
+  std::vector< std::complex<double> >().swap(weights);
+
+  /// Exchange particles.
+  MPI_Alltoall(
+    sendcounts.data(), 1, MPI_INT, recvcounts.data(), 1, MPI_INT,
+    MPI_COMM_WORLD
+  );
+  for (int task = 1; task < trvs::numTasks; task++) {
+    rdispls[task] = rdispls[task - 1] + recvcounts[task - 1];
+  }
+
+  std::vector<double> recvbuf(
+    (long long)(rdispls.back()) + recvcounts.back()
+  );
+  MPI_Alltoallv(
+    sendbuf.data(), sendcounts.data(), sdispls.data(), MPI_DOUBLE,
+    recvbuf.data(), recvcounts.data(), rdispls.data(), MPI_DOUBLE,
+    MPI_COMM_WORLD
+  );
+  std::vector<double>().swap(sendbuf);
+
+  /// Unpack owned particles.
+  const int nowned = int(recvbuf.size() / nvals);
+
+  weights_owned.resize(nowned);
+  if (nowned == 0) {return;}
+
+  particles_owned.initialise_particles(nowned);
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+  for (int pid = 0; pid < nowned; pid++) {
+    const double* src = &recvbuf[(long long)(nvals) * pid];
+    particles_owned[pid].pos[0] = src[0];
+    particles_owned[pid].pos[1] = src[1];
+    particles_owned[pid].pos[2] = src[2];
+    weights_owned[pid] = std::complex<double>(src[3], src[4]);
+  }
+}
+#endif  // TRV_USE_MPI
+
+template <class WeightKern>
+void MeshField::assign_weighted_field_to_mesh_by_scheme(
+  ParticleCatalogue& particles, WeightKern weight_kern
+) {
   if (this->params.assignment == "ngp") {
-    this->assign_weighted_field_to_mesh_ngp(particles, weights);
+    this->assign_weighted_field_to_mesh_ngp(particles, weight_kern);
   } else
   if (this->params.assignment == "cic") {
-    this->assign_weighted_field_to_mesh_cic(particles, weights);
+    this->assign_weighted_field_to_mesh_cic(particles, weight_kern);
   } else
   if (this->params.assignment == "tsc") {
-    this->assign_weighted_field_to_mesh_tsc(particles, weights);
+    this->assign_weighted_field_to_mesh_tsc(particles, weight_kern);
   } else
   if (this->params.assignment == "pcs") {
-    this->assign_weighted_field_to_mesh_pcs(particles, weights);
+    this->assign_weighted_field_to_mesh_pcs(particles, weight_kern);
   } else {
     if (trvs::currTask == 0) {
       trvs::logger.error(
@@ -189,8 +748,9 @@ void MeshField::assign_weighted_field_to_mesh(
   }
 }
 
+template <class WeightKern>
 void MeshField::assign_weighted_field_to_mesh_ngp(
-  ParticleCatalogue& particles, fftw_complex* weight
+  ParticleCatalogue& particles, WeightKern weight_kern
 ) {
   /// Set interpolation order, i.e. number of grids, per dimension,
   /// to which a single particle is assigned.
@@ -200,17 +760,19 @@ void MeshField::assign_weighted_field_to_mesh_ngp(
   /// dV =: `vol_cell`.
   const double inv_vol_cell = 1 / this->vol_cell;
 
-  /// Reset field values to zero.
-  this->initialise_density_field();
+  const bool interlace = (this->params.interlace == "true");
 
-  /// Assign particles to grid cells.
+  /// Assign particles to grid cells (and the shadow grid cells).
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
   for (int pid = 0; pid < particles.ntotal; pid++) {
+    /// Evaluate the particle weight once for both the mesh
+    /// and its shadow.
+    std::complex<double> weight = weight_kern(pid);
+
     int ijk[order][3];     // grid index coordinates of covered grid cells
     double win[order][3];  // sampling window
-    long long gid = 0;     // flattened grid cell index
 
     for (int iaxis = 0; iaxis < 3; iaxis++) {
       /// Carefully set covered sampling window grid indices.
@@ -232,66 +794,57 @@ void MeshField::assign_weighted_field_to_mesh_ngp(
     for (int iloc = 0; iloc < order; iloc++) {
       for (int jloc = 0; jloc < order; jloc++) {
         for (int kloc = 0; kloc < order; kloc++) {
-          gid = this->get_grid_index(
-            ijk[iloc][0], ijk[jloc][1], ijk[kloc][2]
+          fftw_complex* cell = this->locate_assignment_cell(
+            ijk[iloc][0], ijk[jloc][1], ijk[kloc][2], false
           );
-          if (0 <= gid && gid < this->params.nmesh) {
+          if (cell != nullptr) {
 OMP_ATOMIC
-            this->field[gid][0] += inv_vol_cell
-              * weight[pid][0] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+            (*cell)[0] += inv_vol_cell
+              * weight.real() * win[iloc][0] * win[jloc][1] * win[kloc][2];
 OMP_ATOMIC
-            this->field[gid][1] += inv_vol_cell
-              * weight[pid][1] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+            (*cell)[1] += inv_vol_cell
+              * weight.imag() * win[iloc][0] * win[jloc][1] * win[kloc][2];
           }
         }
       }
     }
-  }
 
-  /// Perform interlacing if needed.
-  if (this->params.interlace == "true") {
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-    for (int pid = 0; pid < particles.ntotal; pid++) {
-      int ijk[order][3];
-      double win[order][3];
-      long long gid = 0;
-
-      for (int iaxis = 0; iaxis < 3; iaxis++) {
-        /// Apply a half-grid shift and impose the periodic boundary condition.
-        double loc_grid = this->params.ngrid[iaxis]
-          * particles[pid].pos[iaxis] / this->params.boxsize[iaxis] + 0.5;
-
-        if (loc_grid > this->params.ngrid[iaxis]) {
-          loc_grid -= this->params.ngrid[iaxis];
-        }
+    /// Perform interlacing if needed.
+    if (!interlace) {continue;}
 
-        int idx_grid = int(loc_grid);
-        if (loc_grid - idx_grid >= 0.5) {
-          idx_grid = (idx_grid == this->params.ngrid[iaxis] - 1)
-            ? 0 : idx_grid + 1;
-        }
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      /// Apply a half-grid shift and impose the periodic boundary condition.
+      double loc_grid = this->params.ngrid[iaxis]
+        * particles[pid].pos[iaxis] / this->params.boxsize[iaxis] + 0.5;
 
-        ijk[0][iaxis] = idx_grid;
+      if (loc_grid > this->params.ngrid[iaxis]) {
+        loc_grid -= this->params.ngrid[iaxis];
+      }
 
-        win[0][iaxis] = 1.;
+      int idx_grid = int(loc_grid);
+      if (loc_grid - idx_grid >= 0.5) {
+        idx_grid = (idx_grid == this->params.ngrid[iaxis] - 1)
+          ? 0 : idx_grid + 1;
       }
 
-      for (int iloc = 0; iloc < order; iloc++) {
-        for (int jloc = 0; jloc < order; jloc++) {
-          for (int kloc = 0; kloc < order; kloc++) {
-            gid = this->get_grid_index(
-              ijk[iloc][0], ijk[jloc][1], ijk[kloc][2]
-            );
-            if (0 <= gid && gid < this->params.nmesh) {
+      ijk[0][iaxis] = idx_grid;
+
+      win[0][iaxis] = 1.;
+    }
+
+    for (int iloc = 0; iloc < order; iloc++) {
+      for (int jloc = 0; jloc < order; jloc++) {
+        for (int kloc = 0; kloc < order; kloc++) {
+          fftw_complex* cell = this->locate_assignment_cell(
+            ijk[iloc][0], ijk[jloc][1], ijk[kloc][2], true
+          );
+          if (cell != nullptr) {
 OMP_ATOMIC
-              this->field_s[gid][0] += inv_vol_cell
-                * weight[pid][0] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+            (*cell)[0] += inv_vol_cell
+              * weight.real() * win[iloc][0] * win[jloc][1] * win[kloc][2];
 OMP_ATOMIC
-              this->field_s[gid][1] += inv_vol_cell
-                * weight[pid][1] * win[iloc][0] * win[jloc][1] * win[kloc][2];
-            }
+            (*cell)[1] += inv_vol_cell
+              * weight.imag() * win[iloc][0] * win[jloc][1] * win[kloc][2];
           }
         }
       }
@@ -299,8 +852,9 @@ OMP_ATOMIC
   }
 }
 
+template <class WeightKern>
 void MeshField::assign_weighted_field_to_mesh_cic(
-  ParticleCatalogue& particles, fftw_complex* weight
+  ParticleCatalogue& particles, WeightKern weight_kern
 ) {
   /// Set interpolation order, i.e. number of grids, per dimension,
   /// to which a single particle is assigned.
@@ -310,18 +864,19 @@ void MeshField::assign_weighted_field_to_mesh_cic(
   /// dV =: `vol_cell`.
   const double inv_vol_cell = 1 / this->vol_cell;
 
-  /// Reset field values to zero.
-  this->initialise_density_field();
-
-  /// Assign particles to grid cells.
+  const bool interlace = (this->params.interlace == "true");
 
+  /// Assign particles to grid cells (and the shadow grid cells).
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
   for (int pid = 0; pid < particles.ntotal; pid++) {
+    /// Evaluate the particle weight once for both the mesh
+    /// and its shadow.
+    std::complex<double> weight = weight_kern(pid);
+
     int ijk[order][3];     // grid index coordinates of covered grid cells
     double win[order][3];  // sampling window
-    long long gid = 0;     // flattened grid cell index
 
     for (int iaxis = 0; iaxis < 3; iaxis++) {
       /// Carefully set covered sampling window grid indices.
@@ -344,66 +899,57 @@ void MeshField::assign_weighted_field_to_mesh_cic(
     for (int iloc = 0; iloc < order; iloc++) {
       for (int jloc = 0; jloc < order; jloc++) {
         for (int kloc = 0; kloc < order; kloc++) {
-          gid = this->get_grid_index(
-            ijk[iloc][0], ijk[jloc][1], ijk[kloc][2]
+          fftw_complex* cell = this->locate_assignment_cell(
+            ijk[iloc][0], ijk[jloc][1], ijk[kloc][2], false
           );
-          if (0 <= gid && gid < this->params.nmesh) {
+          if (cell != nullptr) {
 OMP_ATOMIC
-            this->field[gid][0] += inv_vol_cell
-              * weight[pid][0] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+            (*cell)[0] += inv_vol_cell
+              * weight.real() * win[iloc][0] * win[jloc][1] * win[kloc][2];
 OMP_ATOMIC
-            this->field[gid][1] += inv_vol_cell
-              * weight[pid][1] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+            (*cell)[1] += inv_vol_cell
+              * weight.imag() * win[iloc][0] * win[jloc][1] * win[kloc][2];
           }
         }
       }
     }
-  }
-
-  /// Perform interlacing if needed.
-  if (this->params.interlace == "true") {
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-    for (int pid = 0; pid < particles.ntotal; pid++) {
-      int ijk[order][3];
-      double win[order][3];
-      long long gid = 0;
-
-      for (int iaxis = 0; iaxis < 3; iaxis++) {
-        /// Apply a half-grid shift and impose the periodic boundary condition.
-        double loc_grid = this->params.ngrid[iaxis]
-          * particles[pid].pos[iaxis] / this->params.boxsize[iaxis] + 0.5;
-
-        if (loc_grid > this->params.ngrid[iaxis]) {
-          loc_grid -= this->params.ngrid[iaxis];
-        }
 
-        int idx_grid = int(loc_grid);
+    /// Perform interlacing if needed.
+    if (!interlace) {continue;}
 
-        ijk[0][iaxis] = idx_grid;
-        ijk[1][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
-          ? 0 : idx_grid + 1;
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      /// Apply a half-grid shift and impose the periodic boundary condition.
+      double loc_grid = this->params.ngrid[iaxis]
+        * particles[pid].pos[iaxis] / this->params.boxsize[iaxis] + 0.5;
 
-        double s = loc_grid - idx_grid;
-        win[0][iaxis] = 1. - s;
-        win[1][iaxis] = s;
+      if (loc_grid > this->params.ngrid[iaxis]) {
+        loc_grid -= this->params.ngrid[iaxis];
       }
 
-      for (int iloc = 0; iloc < order; iloc++) {
-        for (int jloc = 0; jloc < order; jloc++) {
-          for (int kloc = 0; kloc < order; kloc++) {
-            gid = this->get_grid_index(
-              ijk[iloc][0], ijk[jloc][1], ijk[kloc][2]
-            );
-            if (0 <= gid && gid < this->params.nmesh) {
+      int idx_grid = int(loc_grid);
+
+      ijk[0][iaxis] = idx_grid;
+      ijk[1][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
+        ? 0 : idx_grid + 1;
+
+      double s = loc_grid - idx_grid;
+      win[0][iaxis] = 1. - s;
+      win[1][iaxis] = s;
+    }
+
+    for (int iloc = 0; iloc < order; iloc++) {
+      for (int jloc = 0; jloc < order; jloc++) {
+        for (int kloc = 0; kloc < order; kloc++) {
+          fftw_complex* cell = this->locate_assignment_cell(
+            ijk[iloc][0], ijk[jloc][1], ijk[kloc][2], true
+          );
+          if (cell != nullptr) {
 OMP_ATOMIC
-              this->field_s[gid][0] += inv_vol_cell
-                * weight[pid][0] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+            (*cell)[0] += inv_vol_cell
+              * weight.real() * win[iloc][0] * win[jloc][1] * win[kloc][2];
 OMP_ATOMIC
-              this->field_s[gid][1] += inv_vol_cell
-                * weight[pid][1] * win[iloc][0] * win[jloc][1] * win[kloc][2];
-            }
+            (*cell)[1] += inv_vol_cell
+              * weight.imag() * win[iloc][0] * win[jloc][1] * win[kloc][2];
           }
         }
       }
@@ -411,8 +957,9 @@ OMP_ATOMIC
   }
 }
 
+template <class WeightKern>
 void MeshField::assign_weighted_field_to_mesh_tsc(
-  ParticleCatalogue& particles, fftw_complex* weight
+  ParticleCatalogue& particles, WeightKern weight_kern
 ) {
   /// Set interpolation order, i.e. number of grids, per dimension,
   /// to which a single particle is assigned.
@@ -422,17 +969,19 @@ void MeshField::assign_weighted_field_to_mesh_tsc(
   /// dV =: `vol_cell`.
   const double inv_vol_cell = 1 / this->vol_cell;
 
-  /// Reset field values to zero.
-  this->initialise_density_field();
+  const bool interlace = (this->params.interlace == "true");
 
-  /// Perform assignment.
+  /// Assign particles to grid cells (and the shadow grid cells).
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
   for (int pid = 0; pid < particles.ntotal; pid++) {
+    /// Evaluate the particle weight once for both the mesh
+    /// and its shadow.
+    std::complex<double> weight = weight_kern(pid);
+
     int ijk[order][3];     // grid index coordinates of covered grid cells
     double win[order][3];  // sampling window
-    long long gid = 0;     // flattened grid cell index
 
     for (int iaxis = 0; iaxis < 3; iaxis++) {
       /// Carefully set covered sampling window grid indices.
@@ -473,85 +1022,76 @@ void MeshField::assign_weighted_field_to_mesh_tsc(
     for (int iloc = 0; iloc < order; iloc++) {
       for (int jloc = 0; jloc < order; jloc++) {
         for (int kloc = 0; kloc < order; kloc++) {
-          gid = this->get_grid_index(
-            ijk[iloc][0], ijk[jloc][1], ijk[kloc][2]
+          fftw_complex* cell = this->locate_assignment_cell(
+            ijk[iloc][0], ijk[jloc][1], ijk[kloc][2], false
           );
-          if (0 <= gid && gid < this->params.nmesh) {
+          if (cell != nullptr) {
 OMP_ATOMIC
-            this->field[gid][0] += inv_vol_cell
-              * weight[pid][0] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+            (*cell)[0] += inv_vol_cell
+              * weight.real() * win[iloc][0] * win[jloc][1] * win[kloc][2];
 OMP_ATOMIC
-            this->field[gid][1] += inv_vol_cell
-              * weight[pid][1] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+            (*cell)[1] += inv_vol_cell
+              * weight.imag() * win[iloc][0] * win[jloc][1] * win[kloc][2];
           }
         }
       }
     }
-  }
 
-  /// Perform interlacing if needed.
-  if (this->params.interlace == "true") {
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-    for (int pid = 0; pid < particles.ntotal; pid++) {
-      int ijk[order][3];
-      double win[order][3];
-      long long gid = 0;
-
-      for (int iaxis = 0; iaxis < 3; iaxis++) {
-        /// Apply a half-grid shift and impose the periodic boundary condition.
-        double loc_grid = this->params.ngrid[iaxis]
-          * particles[pid].pos[iaxis] / this->params.boxsize[iaxis] + 0.5;
-
-        if (loc_grid > this->params.ngrid[iaxis]) {
-          loc_grid -= this->params.ngrid[iaxis];
-        }
+    /// Perform interlacing if needed.
+    if (!interlace) {continue;}
 
-        int idx_grid = int(loc_grid);
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      /// Apply a half-grid shift and impose the periodic boundary condition.
+      double loc_grid = this->params.ngrid[iaxis]
+        * particles[pid].pos[iaxis] / this->params.boxsize[iaxis] + 0.5;
 
-        if (loc_grid - idx_grid < 0.5) {
-          ijk[0][iaxis] = (idx_grid == 0)
-            ? this->params.ngrid[iaxis] - 1 : idx_grid - 1;
-          ijk[1][iaxis] = idx_grid;
-          ijk[2][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
-            ? 0 : idx_grid + 1;
-        } else {
-          ijk[0][iaxis] = idx_grid;
-          ijk[1][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
-            ? 0 : ijk[0][iaxis] + 1;
-          ijk[2][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
-            ? 0 : ijk[1][iaxis] + 1;
-        }
+      if (loc_grid > this->params.ngrid[iaxis]) {
+        loc_grid -= this->params.ngrid[iaxis];
+      }
 
-        double s = loc_grid - idx_grid;
+      int idx_grid = int(loc_grid);
 
-        if (s < 0.5) {
-          win[0][iaxis] = 1./2 * (1./2 - s) * (1./2 - s);
-          win[1][iaxis] = 3./4 - s * s;
-          win[2][iaxis] = 1./2 * (1./2 + s) * (1./2 + s);
-        } else {
-          s = 1 - s;
-          win[0][iaxis] = 1./2 * (1./2 + s) * (1./2 + s);
-          win[1][iaxis] = 3./4 - s * s;
-          win[2][iaxis] = 1./2 * (1./2 - s) * (1./2 - s);
-        }
+      if (loc_grid - idx_grid < 0.5) {
+        ijk[0][iaxis] = (idx_grid == 0)
+          ? this->params.ngrid[iaxis] - 1 : idx_grid - 1;
+        ijk[1][iaxis] = idx_grid;
+        ijk[2][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
+          ? 0 : idx_grid + 1;
+      } else {
+        ijk[0][iaxis] = idx_grid;
+        ijk[1][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
+          ? 0 : ijk[0][iaxis] + 1;
+        ijk[2][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
+          ? 0 : ijk[1][iaxis] + 1;
       }
 
-      for (int iloc = 0; iloc < order; iloc++) {
-        for (int jloc = 0; jloc < order; jloc++) {
-          for (int kloc = 0; kloc < order; kloc++) {
-            gid = this->get_grid_index(
-              ijk[iloc][0], ijk[jloc][1], ijk[kloc][2]
-            );
-            if (0 <= gid && gid < this->params.nmesh) {
+      double s = loc_grid - idx_grid;
+
+      if (s < 0.5) {
+        win[0][iaxis] = 1./2 * (1./2 - s) * (1./2 - s);
+        win[1][iaxis] = 3./4 - s * s;
+        win[2][iaxis] = 1./2 * (1./2 + s) * (1./2 + s);
+      } else {
+        s = 1 - s;
+        win[0][iaxis] = 1./2 * (1./2 + s) * (1./2 + s);
+        win[1][iaxis] = 3./4 - s * s;
+        win[2][iaxis] = 1./2 * (1./2 - s) * (1./2 - s);
+      }
+    }
+
+    for (int iloc = 0; iloc < order; iloc++) {
+      for (int jloc = 0; jloc < order; jloc++) {
+        for (int kloc = 0; kloc < order; kloc++) {
+          fftw_complex* cell = this->locate_assignment_cell(
+            ijk[iloc][0], ijk[jloc][1], ijk[kloc][2], true
+          );
+          if (cell != nullptr) {
 OMP_ATOMIC
-              this->field_s[gid][0] += inv_vol_cell
-                * weight[pid][0] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+            (*cell)[0] += inv_vol_cell
+              * weight.real() * win[iloc][0] * win[jloc][1] * win[kloc][2];
 OMP_ATOMIC
-              this->field_s[gid][1] += inv_vol_cell
-                * weight[pid][1] * win[iloc][0] * win[jloc][1] * win[kloc][2];
-            }
+            (*cell)[1] += inv_vol_cell
+              * weight.imag() * win[iloc][0] * win[jloc][1] * win[kloc][2];
           }
         }
       }
@@ -559,8 +1099,9 @@ OMP_ATOMIC
   }
 }
 
+template <class WeightKern>
 void MeshField::assign_weighted_field_to_mesh_pcs(
-  ParticleCatalogue& particles, fftw_complex* weight
+  ParticleCatalogue& particles, WeightKern weight_kern
 ) {
   /// Set interpolation order, i.e. number of grids, per dimension,
   /// to which a single particle is assigned.
@@ -570,17 +1111,19 @@ void MeshField::assign_weighted_field_to_mesh_pcs(
   /// where δᴰ corresponds to δᴷ / dV, dV =: `vol_cell`.
   const double inv_vol_cell = 1 / this->vol_cell;
 
-  /// Reset field values to zero.
-  this->initialise_density_field();
+  const bool interlace = (this->params.interlace == "true");
 
-  /// Perform assignment.
+  /// Assign particles to grid cells (and the shadow grid cells).
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
   for (int pid = 0; pid < particles.ntotal; pid++) {
+    /// Evaluate the particle weight once for both the mesh
+    /// and its shadow.
+    std::complex<double> weight = weight_kern(pid);
+
     int ijk[order][3];     // grid index coordinates of covered grid cells
     double win[order][3];  // sampling window
-    long long gid = 0;     // flattened grid cell index
 
     for (int iaxis = 0; iaxis < 3; iaxis++) {
       /// Carefully set covered sampling window grid indices.
@@ -611,74 +1154,65 @@ void MeshField::assign_weighted_field_to_mesh_pcs(
     for (int iloc = 0; iloc < order; iloc++) {
       for (int jloc = 0; jloc < order; jloc++) {
         for (int kloc = 0; kloc < order; kloc++) {
-          gid = this->get_grid_index(
-            ijk[iloc][0], ijk[jloc][1], ijk[kloc][2]
+          fftw_complex* cell = this->locate_assignment_cell(
+            ijk[iloc][0], ijk[jloc][1], ijk[kloc][2], false
           );
-          if (0 <= gid && gid < this->params.nmesh) {
+          if (cell != nullptr) {
 OMP_ATOMIC
-            this->field[gid][0] += inv_vol_cell
-              * weight[pid][0] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+            (*cell)[0] += inv_vol_cell
+              * weight.real() * win[iloc][0] * win[jloc][1] * win[kloc][2];
 OMP_ATOMIC
-            this->field[gid][1] += inv_vol_cell
-              * weight[pid][1] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+            (*cell)[1] += inv_vol_cell
+              * weight.imag() * win[iloc][0] * win[jloc][1] * win[kloc][2];
           }
         }
       }
     }
-  }
 
-  /// Perform interlacing if needed.
-  if (this->params.interlace == "true") {
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-    for (int pid = 0; pid < particles.ntotal; pid++) {
-      int ijk[order][3];
-      double win[order][3];
-      long long gid = 0;
-
-      for (int iaxis = 0; iaxis < 3; iaxis++) {
-        /// Apply a half-grid shift and impose the periodic boundary condition.
-        double loc_grid = this->params.ngrid[iaxis]
-          * particles[pid].pos[iaxis] / this->params.boxsize[iaxis] + 0.5;
-
-        if (loc_grid > this->params.ngrid[iaxis]) {
-          loc_grid -= this->params.ngrid[iaxis];
-        }
+    /// Perform interlacing if needed.
+    if (!interlace) {continue;}
 
-        int idx_grid = int(loc_grid);
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      /// Apply a half-grid shift and impose the periodic boundary condition.
+      double loc_grid = this->params.ngrid[iaxis]
+        * particles[pid].pos[iaxis] / this->params.boxsize[iaxis] + 0.5;
 
-        ijk[0][iaxis] = (idx_grid == 0)
-          ? this->params.ngrid[iaxis] - 1 : idx_grid - 1;
-        ijk[1][iaxis] = idx_grid;
-        ijk[2][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
-          ? 0 : idx_grid + 1;
-        ijk[3][iaxis] = (ijk[2][iaxis] == this->params.ngrid[iaxis] - 1)
-          ? 0 : ijk[2][iaxis] + 1;
-        double s = loc_grid - idx_grid;
-
-        win[0][iaxis] = 1./6 * (1. - s) * (1. - s) * (1. - s);
-        win[1][iaxis] = 1./6 * (4. - 6. * s * s + 3. * s * s * s);
-        win[2][iaxis] = 1./6 * (
-          4. - 6. * (1. - s) * (1. - s) + 3. * (1. - s) * (1. - s) * (1. - s)
-        );
-        win[3][iaxis] = 1./6 * s * s * s;
+      if (loc_grid > this->params.ngrid[iaxis]) {
+        loc_grid -= this->params.ngrid[iaxis];
       }
 
-      for (int iloc = 0; iloc < order; iloc++) {
-        for (int jloc = 0; jloc < order; jloc++) {
-          for (int kloc = 0; kloc < order; kloc++) {
-            gid = this->get_grid_index(
-              ijk[iloc][0], ijk[jloc][1], ijk[kloc][2]
-            );
-            if (0 <= gid && gid < this->params.nmesh) {
+      int idx_grid = int(loc_grid);
+
+      ijk[0][iaxis] = (idx_grid == 0)
+        ? this->params.ngrid[iaxis] - 1 : idx_grid - 1;
+      ijk[1][iaxis] = idx_grid;
+      ijk[2][iaxis] = (idx_grid == this->params.ngrid[iaxis] - 1)
+        ? 0 : idx_grid + 1;
+      ijk[3][iaxis] = (ijk[2][iaxis] == this->params.ngrid[iaxis] - 1)
+        ? 0 : ijk[2][iaxis] + 1;
+      double s = loc_grid - idx_grid;
+
+      win[0][iaxis] = 1./6 * (1. - s) * (1. - s) * (1. - s);
+      win[1][iaxis] = 1./6 * (4. - 6. * s * s + 3. * s * s * s);
+      win[2][iaxis] = 1./6 * (
+        4. - 6. * (1. - s) * (1. - s) + 3. * (1. - s) * (1. - s) * (1. - s)
+      );
+      win[3][iaxis] = 1./6 * s * s * s;
+    }
+
+    for (int iloc = 0; iloc < order; iloc++) {
+      for (int jloc = 0; jloc < order; jloc++) {
+        for (int kloc = 0; kloc < order; kloc++) {
+          fftw_complex* cell = this->locate_assignment_cell(
+            ijk[iloc][0], ijk[jloc][1], ijk[kloc][2], true
+          );
+          if (cell != nullptr) {
 OMP_ATOMIC
-              this->field_s[gid][0] += inv_vol_cell
-                * weight[pid][0] * win[iloc][0] * win[jloc][1] * win[kloc][2];
+            (*cell)[0] += inv_vol_cell
+              * weight.real() * win[iloc][0] * win[jloc][1] * win[kloc][2];
 OMP_ATOMIC
-              this->field_s[gid][1] += inv_vol_cell
-                * weight[pid][1] * win[iloc][0] * win[jloc][1] * win[kloc][2];
-            }
+            (*cell)[1] += inv_vol_cell
+              * weight.imag() * win[iloc][0] * win[jloc][1] * win[kloc][2];
           }
         }
       }
@@ -725,26 +1259,11 @@ double MeshField::calc_assignment_window_in_fourier(int i, int j, int k) {
 /// ----------------------------------------------------------------------
 
 void MeshField::compute_unweighted_field(ParticleCatalogue& particles) {
-  fftw_complex* unit_weight = nullptr;
-
-  unit_weight = fftw_alloc_complex(particles.ntotal);
-
-  trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(particles.ntotal);
-  trv::sys::update_maxmem();
-
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles.ntotal; pid++) {
-    unit_weight[pid][0] = 1.;
-    unit_weight[pid][1] = 0.;
-  }
-
-  this->assign_weighted_field_to_mesh(particles, unit_weight);
-
-  fftw_free(unit_weight); unit_weight = nullptr;
+  this->initialise_density_field();
 
-  trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(particles.ntotal);
+  this->add_kernel_weighted_field_to_mesh(
+    particles, [](int pid) {return std::complex<double>(1., 0.);}
+  );
 }
 
 void MeshField::compute_unweighted_field_fluctuations_insitu(
@@ -758,382 +1277,364 @@ void MeshField::compute_unweighted_field_fluctuations_insitu(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
+  for (int gid = 0; gid < this->local_nmesh; gid++) {
     this->field[gid][0] -= nbar;
     // this->field[gid][1] -= 0.; (unused)
   }
 }
 
+template <class LoSPolicy>
 void MeshField::compute_ylm_wgtd_field(
   ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
   double alpha, int ell, int m
 ) {
-  fftw_complex* weight_kern = nullptr;
-
-  /// Compute the weighted data-source field.
-  weight_kern = fftw_alloc_complex(particles_data.ntotal);
-
-  trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(particles_data.ntotal);
-  trv::sys::update_maxmem();
-
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles_data.ntotal; pid++) {
-    double los_[3] = {
-      los_data[pid].pos[0], los_data[pid].pos[1], los_data[pid].pos[2]
-    };
-
-    std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
-      calc_reduced_spherical_harmonic(ell, m, los_);
-
-    weight_kern[pid][0] = ylm.real() * particles_data[pid].w;
-    weight_kern[pid][1] = ylm.imag() * particles_data[pid].w;
-  }
-
-  this->assign_weighted_field_to_mesh(particles_data, weight_kern);
-
-  fftw_free(weight_kern); weight_kern = nullptr;
-
-  trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(particles_data.ntotal);
-
-  /// Compute the weighted random-source field.
-  weight_kern = fftw_alloc_complex(particles_rand.ntotal);
-
-  trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(particles_rand.ntotal);
-  trv::sys::update_maxmem();
-
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles_rand.ntotal; pid++) {
-    double los_[3] = {
-      los_rand[pid].pos[0], los_rand[pid].pos[1], los_rand[pid].pos[2]
-    };
-
-    std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
-      calc_reduced_spherical_harmonic(ell, m, los_);
-
-    weight_kern[pid][0] = ylm.real() * particles_rand[pid].w;
-    weight_kern[pid][1] = ylm.imag() * particles_rand[pid].w;
-  }
-
-  MeshField field_rand(this->params);
-  field_rand.assign_weighted_field_to_mesh(particles_rand, weight_kern);
-
-  fftw_free(weight_kern); weight_kern = nullptr;
-
-  trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(particles_rand.ntotal);
+  /// Reset field values to zero.
+  this->initialise_density_field();
 
-  /// Subtract to compute fluctuations, i.e. δn_LM.
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
-    this->field[gid][0] -= alpha * field_rand[gid][0];
-    this->field[gid][1] -= alpha * field_rand[gid][1];
-  }
+  /// Assign the weighted data-source field.
+  this->add_ylm_wgtd_field(particles_data, los_data, 1., ell, m);
 
-  if (this->params.interlace == "true") {
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-    for (int gid = 0; gid < this->params.nmesh; gid++) {
-      this->field_s[gid][0] -= alpha * field_rand.field_s[gid][0];
-      this->field_s[gid][1] -= alpha * field_rand.field_s[gid][1];
-    }
+  /// Assign the weighted random-source field into the same mesh
+  /// with the alpha contrast subtracted to compute fluctuations,
+  /// i.e. δn_LM.
+  if (particles_rand.mesh_cache != nullptr
+      && std::is_same<LoSPolicy, RadialLineOfSight>::value) {
+    particles_rand.mesh_cache->add_ylm_wgtd_field(
+      *this, particles_rand, los_rand, - alpha, ell, m, false
+    );
+  } else {
+    this->add_ylm_wgtd_field(particles_rand, los_rand, - alpha, ell, m);
   }
 }
 
+template <class LoSPolicy>
 void MeshField::compute_ylm_wgtd_field(
-  ParticleCatalogue& particles, LineOfSight* los,
+  ParticleCatalogue& particles, LoSPolicy los,
   double alpha, int ell, int m
 ) {
-  fftw_complex* weight_kern = nullptr;
-
-  /// Compute the weighted field.
-  weight_kern = fftw_alloc_complex(particles.ntotal);
-
-  trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(particles.ntotal);
-  trv::sys::update_maxmem();
-
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles.ntotal; pid++) {
-    double los_[3] = {los[pid].pos[0], los[pid].pos[1], los[pid].pos[2]};
-
-    std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
-      calc_reduced_spherical_harmonic(ell, m, los_);
+  /// Reset field values to zero.
+  this->initialise_density_field();
 
-    weight_kern[pid][0] = ylm.real() * particles[pid].w;
-    weight_kern[pid][1] = ylm.imag() * particles[pid].w;
-  }
+  /// Assign the weighted field with the normalising alpha contrast.
+  this->add_ylm_wgtd_field(particles, los, alpha, ell, m);
+}
 
-  this->assign_weighted_field_to_mesh(particles, weight_kern);
+template <class LoSPolicy>
+void MeshField::add_ylm_wgtd_field(
+  ParticleCatalogue& particles, LoSPolicy los,
+  double weight, int ell, int m
+) {
+  /// Reduced spherical harmonics are real only for m = 0.
+  if (m != 0) {this->real_valued = false;}
 
-  fftw_free(weight_kern); weight_kern = nullptr;
+  this->add_kernel_weighted_field_to_mesh(
+    particles,
+    [&particles, &los, weight, ell, m](int pid) -> std::complex<double> {
+      double los_[3];
+      los.eval(pid, particles[pid].pos, los_);
 
-  trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(particles.ntotal);
+      std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
+        calc_reduced_spherical_harmonic(ell, m, los_);
 
-  /// Apply the normalising alpha contrast.
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
-    this->field[gid][0] *= alpha;
-    this->field[gid][1] *= alpha;
-  }
+      return weight * ylm * particles[pid].w;
+    }
+  );
 }
 
+template <class LoSPolicy>
 void MeshField::compute_ylm_wgtd_quad_field(
   ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
   double alpha,
   int ell, int m
 ) {
-  fftw_complex* weight_kern = nullptr;
-
-  /// Compute the quadratic weighted data-source field.
-  weight_kern = fftw_alloc_complex(particles_data.ntotal);
+  /// Reset field values to zero.
+  this->initialise_density_field();
 
-  trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(particles_data.ntotal);
-  trv::sys::update_maxmem();
+  /// Assign the quadratic weighted data-source field.
+  this->add_ylm_wgtd_quad_field(particles_data, los_data, 1., ell, m);
 
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles_data.ntotal; pid++) {
-    double los_[3] = {
-      los_data[pid].pos[0], los_data[pid].pos[1], los_data[pid].pos[2]
-    };
+  /// Assign the quadratic weighted random-source field into the same
+  /// mesh with the squared alpha contrast added to compute quadratic
+  /// fluctuations, i.e. N_LM.
+  if (particles_rand.mesh_cache != nullptr
+      && std::is_same<LoSPolicy, RadialLineOfSight>::value) {
+    particles_rand.mesh_cache->add_ylm_wgtd_field(
+      *this, particles_rand, los_rand, std::pow(alpha, 2), ell, m, true
+    );
+  } else {
+    this->add_ylm_wgtd_quad_field(
+      particles_rand, los_rand, std::pow(alpha, 2), ell, m
+    );
+  }
+}
 
-    std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
-      calc_reduced_spherical_harmonic(ell, m, los_);
+template <class LoSPolicy>
+void MeshField::compute_ylm_wgtd_quad_field(
+  ParticleCatalogue& particles, LoSPolicy los,
+  double alpha, int ell, int m
+) {
+  /// Reset field values to zero.
+  this->initialise_density_field();
 
-    ylm = std::conj(ylm);  // additional conjugation
+  /// Assign the quadratic weighted field with mean-density matching
+  /// normalisation (i.e. alpha contrast) to compute N_LM.
+  this->add_ylm_wgtd_quad_field(particles, los, std::pow(alpha, 2), ell, m);
+}
 
-    weight_kern[pid][0] = ylm.real() * std::pow(particles_data[pid].w, 2);
-    weight_kern[pid][1] = ylm.imag() * std::pow(particles_data[pid].w, 2);
-  }
+template <class LoSPolicy>
+void MeshField::add_ylm_wgtd_quad_field(
+  ParticleCatalogue& particles, LoSPolicy los,
+  double weight, int ell, int m
+) {
+  /// Reduced spherical harmonics are real only for m = 0.
+  if (m != 0) {this->real_valued = false;}
 
-  this->assign_weighted_field_to_mesh(particles_data, weight_kern);
+  this->add_kernel_weighted_field_to_mesh(
+    particles,
+    [&particles, &los, weight, ell, m](int pid) -> std::complex<double> {
+      double los_[3];
+      los.eval(pid, particles[pid].pos, los_);
 
-  fftw_free(weight_kern); weight_kern = nullptr;
+      std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
+        calc_reduced_spherical_harmonic(ell, m, los_);
 
-  trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(particles_data.ntotal);
+      ylm = std::conj(ylm);  // conjugation is essential
 
-  /// Compute the quadratic weighted random-source field.
-  weight_kern = fftw_alloc_complex(particles_rand.ntotal);
+      return weight * ylm * std::pow(particles[pid].w, 2);
+    }
+  );
+}
 
-  trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(particles_rand.ntotal);
-  trv::sys::update_maxmem();
 
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles_rand.ntotal; pid++) {
-    double los_[3] = {
-      los_rand[pid].pos[0], los_rand[pid].pos[1], los_rand[pid].pos[2]
-    };
+/// ----------------------------------------------------------------------
+/// Field transforms
+/// ----------------------------------------------------------------------
 
-    std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
-      calc_reduced_spherical_harmonic(ell, m, los_);
+void MeshField::fourier_transform() {
+  /// Apply FFT volume normalisation.
+  this->apply_fourier_volume_normalisation();
 
-    ylm = std::conj(ylm);  // additional conjugation
+  /// Perform FFT of the field together with its co-allocated
+  /// shadow field (if interlacing is used).
+  this->execute_many_dft_3d(
+    this->field, this->nslots, this->local_nalloc, FFTW_FORWARD
+  );
 
-    weight_kern[pid][0] = ylm.real() * std::pow(particles_rand[pid].w, 2);
-    weight_kern[pid][1] = ylm.imag() * std::pow(particles_rand[pid].w, 2);
+  /// Interlace with the shadow field.
+  if (this->params.interlace == "true") {
+    this->apply_interlacing();
   }
+}
 
-  MeshField field_rand(this->params);
-  field_rand.assign_weighted_field_to_mesh(particles_rand, weight_kern);
-
-  fftw_free(weight_kern); weight_kern = nullptr;
+void MeshField::inv_fourier_transform() {
+  /// Apply inverse FFT volume normalisation.
+  this->apply_inv_fourier_volume_normalisation();
 
-  trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(particles_rand.ntotal);
+  /// Perform inverse FFT.
+  this->execute_many_dft_3d(
+    this->field, 1, this->nslots * this->local_nalloc, FFTW_BACKWARD
+  );
+}
 
-  /// Add to compute quadratic fluctuations, i.e. N_LM.
+void MeshField::apply_fourier_volume_normalisation() {
+  /// Apply FFT volume normalisation, where ∫d³x ↔ dV Σᵢ, dV =: `vol_cell`.
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
-    this->field[gid][0] += std::pow(alpha, 2) * field_rand[gid][0];
-    this->field[gid][1] += std::pow(alpha, 2) * field_rand[gid][1];
+  for (int gid = 0; gid < this->local_nmesh; gid++) {
+    this->field[gid][0] *= this->vol_cell;
+    this->field[gid][1] *= this->vol_cell;
   }
 
   if (this->params.interlace == "true") {
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-    for (int gid = 0; gid < this->params.nmesh; gid++) {
-      this->field_s[gid][0] += std::pow(alpha, 2) * field_rand.field_s[gid][0];
-      this->field_s[gid][1] += std::pow(alpha, 2) * field_rand.field_s[gid][1];
+    for (int gid = 0; gid < this->local_nmesh; gid++) {
+      this->field_s[gid][0] *= this->vol_cell;
+      this->field_s[gid][1] *= this->vol_cell;
     }
   }
 }
 
-void MeshField::compute_ylm_wgtd_quad_field(
-  ParticleCatalogue& particles, LineOfSight* los,
-  double alpha, int ell, int m
-) {
-  fftw_complex* weight_kern = nullptr;
-
-  /// Compute the quadratic weighted field.
-  weight_kern = fftw_alloc_complex(particles.ntotal);
-
-  trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(particles.ntotal);
-  trv::sys::update_maxmem();
-
+void MeshField::apply_inv_fourier_volume_normalisation() {
+  /// Apply inverse FFT volume normalisation, where ∫d³k/(2π)³ ↔ (1/V) Σᵢ,
+  /// V =: `vol`.
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles.ntotal; pid++) {
-    double los_[3] = {los[pid].pos[0], los[pid].pos[1], los[pid].pos[2]};
+  for (int gid = 0; gid < this->local_nmesh; gid++) {
+    this->field[gid][0] /= this->vol;
+    this->field[gid][1] /= this->vol;
+  }
+}
 
-    std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
-      calc_reduced_spherical_harmonic(ell, m, los_);
+void MeshField::apply_interlacing() {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for collapse(3)
+#endif  // TRV_USE_OMP
+  for (int i = this->local_x_begin; i < this->local_x_end; i++) {
+    for (int j = 0; j < this->params.ngrid[1]; j++) {
+      for (int k = 0; k < this->params.ngrid[2]; k++) {
+        long long idx_grid = this->get_grid_index(i, j, k);
+
+        /// Calculate the index vector representing the grid cell.
+        double m[3];
+        m[0] = (i < this->params.ngrid[0]/2)
+          ? double(i) / this->params.ngrid[0]
+          : double(i) / this->params.ngrid[0] - 1;
+        m[1] = (j < this->params.ngrid[1]/2)
+          ? double(j) / this->params.ngrid[1]
+          : double(j) / this->params.ngrid[1] - 1;
+        m[2] = (k < this->params.ngrid[2]/2)
+          ? double(k) / this->params.ngrid[2]
+          : double(k) / this->params.ngrid[2] - 1;
+
+        /// Multiply by the phase factor from the half-grid shift and
+        /// add the shadow mesh field contribution.  Note the positive
+        /// sign of `arg`.
+        double arg = M_PI * (m[0] + m[1] + m[2]);
+
+        this->field[idx_grid][0] +=
+          std::cos(arg) * this->field_s[idx_grid][0]
+          - std::sin(arg) * this->field_s[idx_grid][1]
+        ;
+        this->field[idx_grid][1] +=
+          std::sin(arg) * this->field_s[idx_grid][0]
+          + std::cos(arg) * this->field_s[idx_grid][1]
+        ;
+
+        this->field[idx_grid][0] /= 2.;
+        this->field[idx_grid][1] /= 2.;
+      }
+    }
+  }
+}
 
-    ylm = std::conj(ylm);  // conjugation is essential
+void MeshField::execute_many_dft_3d(
+  fftw_complex* arr, int howmany, long long dist, int sign
+) {
+  trvs::StageTimer timer("fft");
+
+  /// Distributed transforms of strided arrays (or those whose strides
+  /// overflow the FFTW interface) are performed one by one.
+#ifndef TRV_USE_MPI
+  if (dist <= std::numeric_limits<int>::max()) {
+    fftw_execute_dft(
+      this->get_cached_plan(arr, howmany, dist, sign), arr, arr
+    );
+    return;
+  }
+#endif  // !TRV_USE_MPI
 
-    weight_kern[pid][0] = ylm.real() * std::pow(particles[pid].w, 2);
-    weight_kern[pid][1] = ylm.imag() * std::pow(particles[pid].w, 2);
+  for (int ifield = 0; ifield < howmany; ifield++) {
+    this->execute_dft_3d(arr + ifield * dist, sign);
   }
+}
+
+void MeshField::inv_fourier_transform_pruned(double k_max) {
+  trvs::StageTimer timer("fft");
 
-  this->assign_weighted_field_to_mesh(particles, weight_kern);
+#ifdef TRV_USE_MPI
+  /// Distributed transforms are not pruned.
+  this->execute_dft_3d(this->field, FFTW_BACKWARD);
+#else  // !TRV_USE_MPI
+  int ngrid[3] = {
+    this->params.ngrid[0], this->params.ngrid[1], this->params.ngrid[2]
+  };
+  const int plane_size = ngrid[1] * ngrid[2];
+
+  /// Find grid indices in the first two dimensions within the bounding
+  /// extent, outside of which all pencils are empty.
+  auto get_active_indices = [k_max](int ngrid_, double dk_) {
+    std::vector<int> indices;
+    for (int idx = 0; idx < ngrid_; idx++) {
+      int n = (idx < ngrid_/2) ? idx : idx - ngrid_;
+      if (std::fabs(n * dk_) <= k_max) {indices.push_back(idx);}
+    }
+    return indices;
+  };
+
+  std::vector<int> active_i = get_active_indices(ngrid[0], this->dk[0]);
+  std::vector<int> active_j = get_active_indices(ngrid[1], this->dk[1]);
+  const int nactive_i = active_i.size();
+  const int nactive_j = active_j.size();
 
-  fftw_free(weight_kern); weight_kern = nullptr;
+  /// Pencils in the first two stages are transformed one by one
+  /// in parallel, so their plans are single-threaded.
+  fftw_plan transform_z, transform_y;
+  {
+    auto planner_lock = trvs::lock_fftw_planner();
+#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
+    fftw_plan_with_nthreads(1);
+#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+    transform_z = fftw_plan_many_dft(
+      1, &ngrid[2], 1,
+      this->field, nullptr, 1, ngrid[2],
+      this->field, nullptr, 1, ngrid[2],
+      FFTW_BACKWARD, FFTW_ESTIMATE | FFTW_UNALIGNED
+    );
+    transform_y = fftw_plan_many_dft(
+      1, &ngrid[1], ngrid[2],
+      this->field, nullptr, ngrid[2], 1,
+      this->field, nullptr, ngrid[2], 1,
+      FFTW_BACKWARD, FFTW_ESTIMATE | FFTW_UNALIGNED
+    );
+  }
 
-  trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(particles.ntotal);
+  /// Stage 1: transform along the last dimension only the pencils
+  /// within the bounding extent.
 
-  /// Apply mean-density matching normalisation (i.e. alpha contrast)
-  /// to compute N_LM.
 #ifdef TRV_USE_OMP
-#pragma omp parallel for
+#pragma omp parallel for collapse(2)
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
-    this->field[gid][0] *= std::pow(alpha, 2);
-    this->field[gid][1] *= std::pow(alpha, 2);
+  for (int ii = 0; ii < nactive_i; ii++) {
+    for (int jj = 0; jj < nactive_j; jj++) {
+      fftw_complex* pencil = &this->field[
+        static_cast<long long>(active_i[ii]) * plane_size
+        + static_cast<long long>(active_j[jj]) * ngrid[2]
+      ];
+      fftw_execute_dft(transform_z, pencil, pencil);
+    }
   }
-}
 
+  MeshField::destroy_plan(transform_z);
 
-/// ----------------------------------------------------------------------
-/// Field transforms
-/// ----------------------------------------------------------------------
+  /// Stage 2: transform along the second dimension only the planes
+  /// within the bounding extent.
 
-void MeshField::fourier_transform() {
-  /// Apply FFT volume normalisation, where ∫d³x ↔ dV Σᵢ, dV =: `vol_cell`.
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
-    this->field[gid][0] *= this->vol_cell;
-    this->field[gid][1] *= this->vol_cell;
+  for (int ii = 0; ii < nactive_i; ii++) {
+    fftw_complex* plane =
+      &this->field[static_cast<long long>(active_i[ii]) * plane_size];
+    fftw_execute_dft(transform_y, plane, plane);
   }
 
-  /// Perform FFT.
+  MeshField::destroy_plan(transform_y);
+
+  /// Stage 3: transform along the first dimension in full.
+  fftw_plan transform_x;
+  {
+    auto planner_lock = trvs::lock_fftw_planner();
 #if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_plan_with_nthreads(omp_get_max_threads());
+    fftw_plan_with_nthreads(omp_get_max_threads());
 #endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-  fftw_plan transform = fftw_plan_dft_3d(
-    this->params.ngrid[0], this->params.ngrid[1], this->params.ngrid[2],
-    this->field, this->field,
-    FFTW_FORWARD, FFTW_ESTIMATE
-  );
+    transform_x = fftw_plan_many_dft(
+      1, &ngrid[0], plane_size,
+      this->field, nullptr, plane_size, 1,
+      this->field, nullptr, plane_size, 1,
+      FFTW_BACKWARD, FFTW_ESTIMATE
+    );
+  }
 
-  fftw_execute(transform);
-  fftw_destroy_plan(transform);
-
-  /// Interlace with the shadow field.
-  if (this->params.interlace == "true") {
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-    for (int gid = 0; gid < this->params.nmesh; gid++) {
-      this->field_s[gid][0] *= this->vol_cell;
-      this->field_s[gid][1] *= this->vol_cell;
-    }
-
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_plan_with_nthreads(omp_get_max_threads());
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-    fftw_plan transform_s = fftw_plan_dft_3d(
-      this->params.ngrid[0], this->params.ngrid[1], this->params.ngrid[2],
-      this->field_s, this->field_s,
-      FFTW_FORWARD, FFTW_ESTIMATE
-    );
-
-    fftw_execute(transform_s);
-    fftw_destroy_plan(transform_s);
-
-#ifdef TRV_USE_OMP
-#pragma omp parallel for collapse(3)
-#endif  // TRV_USE_OMP
-    for (int i = 0; i < this->params.ngrid[0]; i++) {
-      for (int j = 0; j < this->params.ngrid[1]; j++) {
-        for (int k = 0; k < this->params.ngrid[2]; k++) {
-          long long idx_grid = this->get_grid_index(i, j, k);
-
-          /// Calculate the index vector representing the grid cell.
-          double m[3];
-          m[0] = (i < this->params.ngrid[0]/2)
-            ? double(i) / this->params.ngrid[0]
-            : double(i) / this->params.ngrid[0] - 1;
-          m[1] = (j < this->params.ngrid[1]/2)
-            ? double(j) / this->params.ngrid[1]
-            : double(j) / this->params.ngrid[1] - 1;
-          m[2] = (k < this->params.ngrid[2]/2)
-            ? double(k) / this->params.ngrid[2]
-            : double(k) / this->params.ngrid[2] - 1;
-
-          /// Multiply by the phase factor from the half-grid shift and
-          /// add the shadow mesh field contribution.  Note the positive
-          /// sign of `arg`.
-          double arg = M_PI * (m[0] + m[1] + m[2]);
-
-          this->field[idx_grid][0] +=
-            std::cos(arg) * this->field_s[idx_grid][0]
-            - std::sin(arg) * this->field_s[idx_grid][1]
-          ;
-          this->field[idx_grid][1] +=
-            std::sin(arg) * this->field_s[idx_grid][0]
-            + std::cos(arg) * this->field_s[idx_grid][1]
-          ;
-
-          this->field[idx_grid][0] /= 2.;
-          this->field[idx_grid][1] /= 2.;
-        }
-      }
-    }
-  }
-}
-
-void MeshField::inv_fourier_transform() {
-  /// Apply inverse FFT volume normalisation, where ∫d³k/(2π)³ ↔ (1/V) Σᵢ,
-  /// V =: `vol`.
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
-    this->field[gid][0] /= this->vol;
-    this->field[gid][1] /= this->vol;
-  }
-
-  /// Perform inverse FFT.
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_plan_with_nthreads(omp_get_max_threads());
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-  fftw_plan inv_transform = fftw_plan_dft_3d(
-    this->params.ngrid[0], this->params.ngrid[1], this->params.ngrid[2],
-    this->field, this->field,
-    FFTW_BACKWARD, FFTW_ESTIMATE
-  );
-
-  fftw_execute(inv_transform);
-  fftw_destroy_plan(inv_transform);
-}
+  fftw_execute(transform_x);
+  MeshField::destroy_plan(transform_x);
+#endif  // TRV_USE_MPI
+}
 
 
 /// ----------------------------------------------------------------------
@@ -1144,12 +1645,19 @@ void MeshField::apply_wide_angle_pow_law_kernel() {
   /// CAVEAT: Discretionary choice such that eps_r / r = O(1.e-9).
   const double eps_r = 1.e-6;
 
+  /// The kernel is even, so each pair of grid cells at ±r is visited
+  /// once if both are local.
+  const bool half_space = this->if_mesh_local();
+
 #ifdef TRV_USE_OMP
 #pragma omp parallel for collapse(3)
 #endif  // TRV_USE_OMP
-  for (int i = 0; i < this->params.ngrid[0]; i++) {
+  for (int i = this->local_x_begin; i < this->local_x_end; i++) {
     for (int j = 0; j < this->params.ngrid[1]; j++) {
       for (int k = 0; k < this->params.ngrid[2]; k++) {
+        int mult = half_space ? this->get_hermitian_multiplicity(i, j, k) : 1;
+        if (mult == 0) {continue;}
+
         long long idx_grid = this->get_grid_index(i, j, k);
 
         double rv[3];
@@ -1161,10 +1669,16 @@ void MeshField::apply_wide_angle_pow_law_kernel() {
           // this->field[idx_grid][0] *= 0.; (unused)
           // this->field[idx_grid][1] *= 0.; (unused)
         } else {
-          this->field[idx_grid][0] *=
-            std::pow(r_, - this->params.i_wa - this->params.j_wa);
-          this->field[idx_grid][1] *=
-            std::pow(r_, - this->params.i_wa - this->params.j_wa);
+          double kern = std::pow(r_, - this->params.i_wa - this->params.j_wa);
+
+          this->field[idx_grid][0] *= kern;
+          this->field[idx_grid][1] *= kern;
+
+          if (mult == 2) {
+            long long idx_grid_ = this->get_hermitian_partner_index(i, j, k);
+            this->field[idx_grid_][0] *= kern;
+            this->field[idx_grid_][1] *= kern;
+          }
         }
       }
     }
@@ -1172,33 +1686,192 @@ void MeshField::apply_wide_angle_pow_law_kernel() {
 }
 
 void MeshField::apply_assignment_compensation() {
+  /// The assignment window is even, so each pair of grid cells at ±k
+  /// is visited once if both are local.
+  const bool half_space = this->if_mesh_local();
+
 #ifdef TRV_USE_OMP
 #pragma omp parallel for collapse(3)
 #endif  // TRV_USE_OMP
-  for (int i = 0; i < this->params.ngrid[0]; i++) {
+  for (int i = this->local_x_begin; i < this->local_x_end; i++) {
     for (int j = 0; j < this->params.ngrid[1]; j++) {
       for (int k = 0; k < this->params.ngrid[2]; k++) {
+        int mult = half_space ? this->get_hermitian_multiplicity(i, j, k) : 1;
+        if (mult == 0) {continue;}
+
         long long idx_grid = this->get_grid_index(i, j, k);
 
         double win = this->calc_assignment_window_in_fourier(i, j, k);
 
         this->field[idx_grid][0] /= win;
         this->field[idx_grid][1] /= win;
+
+        if (mult == 2) {
+          long long idx_grid_ = this->get_hermitian_partner_index(i, j, k);
+          this->field[idx_grid_][0] /= win;
+          this->field[idx_grid_][1] /= win;
+        }
       }
     }
   }
 }
 
+void MeshField::resample_fourier_field(MeshField& field_fourier) {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for collapse(3)
+#endif  // TRV_USE_OMP
+  for (int i = this->local_x_begin; i < this->local_x_end; i++) {
+    for (int j = 0; j < this->params.ngrid[1]; j++) {
+      for (int k = 0; k < this->params.ngrid[2]; k++) {
+        long long idx_grid = this->get_grid_index(i, j, k);
+        long long idx_grid_ = field_fourier.get_grid_index(
+          this->get_fourier_grid_index(i, 0, field_fourier),
+          this->get_fourier_grid_index(j, 1, field_fourier),
+          this->get_fourier_grid_index(k, 2, field_fourier)
+        );
+
+        this->field[idx_grid][0] = field_fourier[idx_grid_][0];
+        this->field[idx_grid][1] = field_fourier[idx_grid_][1];
+      }
+    }
+  }
+
+  this->real_valued = field_fourier.real_valued;
+}
 
 /// ----------------------------------------------------------------------
 /// One-point statistics
 /// ----------------------------------------------------------------------
 
 void MeshField::inv_fourier_transform_ylm_wgtd_field_band_limited(
-  MeshField& field_fourier, std::vector< std::complex<double> >& ylm,
+  MeshField& field_fourier, const std::vector< std::complex<double> >& ylm,
   double k_lower, double k_upper,
   double& k_eff, int& nmodes
 ) {
+  trvs::StageTimer timer("shell_transform");
+
+  /// Reset field values to zero.
+  this->initialise_density_field();
+
+  /// Reset effective wavenumber and wavevector modes.
+  k_eff = 0.;
+  nmodes = 0;
+
+  /// Perform wavevector mode binning in the band, visiting only the
+  /// modes in the band from the sparse shell mode list (re-indexed if
+  /// it does not cover the band).  The Fourier-space field (and the
+  /// reduced spherical harmonic) may be on a finer mesh grid, in which
+  /// case the modes are looked up by wavevector.  If the Fourier-space
+  /// field is Hermitian-symmetric, each pair of modes at ±k is visited
+  /// once.
+  const bool half_space =
+    field_fourier.real_valued && this->if_mesh_local();
+
+  if (
+    k_upper > this->shell_modes_kmax
+    || half_space != this->shell_modes_half_space
+  ) {
+    this->index_shell_modes(
+      std::max(k_upper, this->params.bin_max), half_space
+    );
+  }
+
+  auto cmp_kmag = [](const ShellMode& mode, double k_) {
+    return mode.kmag <= k_;
+  };
+  const long long imode_begin = std::lower_bound(
+    this->shell_modes.begin(), this->shell_modes.end(), k_lower, cmp_kmag
+  ) - this->shell_modes.begin();
+  const long long imode_end = std::lower_bound(
+    this->shell_modes.begin(), this->shell_modes.end(), k_upper, cmp_kmag
+  ) - this->shell_modes.begin();
+
+  /// In a band subsampled (i.e. with lower edge at or above
+  /// `subsample_kmin`), modes not retained are counted but not added,
+  /// and the retained modes are reweighted by the exact mode count.
+  const bool subsample =
+    this->if_band_subsampled(k_lower, imode_begin, imode_end);
+
+  int nmodes_retained = 0;
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for reduction(+:k_eff, nmodes, nmodes_retained)
+#endif  // TRV_USE_OMP
+  for (long long imode = imode_begin; imode < imode_end; imode++) {
+    const ShellMode& mode = this->shell_modes[imode];
+
+    k_eff += mode.mult * mode.kmag;
+    nmodes += mode.mult;
+
+    if (subsample && !mode.retained) {continue;}
+
+    nmodes_retained += mode.mult;
+
+    int i = mode.i, j = mode.j, k = mode.k;
+
+    long long idx_grid = this->get_grid_index(i, j, k);
+
+    int i_f = this->get_fourier_grid_index(i, 0, field_fourier);
+    int j_f = this->get_fourier_grid_index(j, 1, field_fourier);
+    int k_f = this->get_fourier_grid_index(k, 2, field_fourier);
+
+    long long idx_grid_ = field_fourier.get_grid_index(i_f, j_f, k_f);
+
+    std::complex<double> fk(
+      field_fourier[idx_grid_][0], field_fourier[idx_grid_][1]
+    );
+
+    /// Apply assignment compensation.
+    double win =
+      field_fourier.calc_assignment_window_in_fourier(i_f, j_f, k_f);
+    fk /= win;
+
+    /// Weight the field.
+    this->field[idx_grid][0] = (ylm[idx_grid_] * fk).real();
+    this->field[idx_grid][1] = (ylm[idx_grid_] * fk).imag();
+
+    if (mode.mult == 2) {
+      long long idx_grid_p = this->get_hermitian_partner_index(i, j, k);
+      long long idx_grid_p_ =
+        field_fourier.get_hermitian_partner_index(i_f, j_f, k_f);
+
+      this->field[idx_grid_p][0] =
+        (ylm[idx_grid_p_] * std::conj(fk)).real();
+      this->field[idx_grid_p][1] =
+        (ylm[idx_grid_p_] * std::conj(fk)).imag();
+    }
+  }
+
+  /// Perform inverse FFT pruned to the band's bounding extent.
+  this->inv_fourier_transform_pruned(k_upper);
+
+  /// The weighted field is complex in general.
+  this->real_valued = false;
+
+  trvs::sum_across_tasks(&k_eff, 1);
+  trvs::sum_across_tasks(&nmodes, 1);
+  trvs::sum_across_tasks(&nmodes_retained, 1);
+
+  /// Average over (retained) wavevector modes in the band, which is
+  /// left as zeros if empty.
+  if (nmodes_retained > 0) {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+    for (int gid = 0; gid < this->local_nmesh; gid++) {
+      this->field[gid][0] /= double(nmodes_retained);
+      this->field[gid][1] /= double(nmodes_retained);
+    }
+  }
+
+  k_eff /= double(nmodes);
+}
+
+void MeshField::inv_fourier_transform_unit_field_band_limited(
+  double k_lower, double k_upper, double& k_eff, int& nmodes
+) {
+  trvs::StageTimer timer("shell_transform");
+
   /// Reset field values to zero.
   this->initialise_density_field();
 
@@ -1206,13 +1879,108 @@ void MeshField::inv_fourier_transform_ylm_wgtd_field_band_limited(
   k_eff = 0.;
   nmodes = 0;
 
-  /// Perform wavevector mode binning in the band.
+  /// Perform wavevector mode binning in the band as in
+  /// `inv_fourier_transform_ylm_wgtd_field_band_limited`.
+  const bool half_space = this->if_mesh_local();
+
+  if (
+    k_upper > this->shell_modes_kmax
+    || half_space != this->shell_modes_half_space
+  ) {
+    this->index_shell_modes(
+      std::max(k_upper, this->params.bin_max), half_space
+    );
+  }
+
+  auto cmp_kmag = [](const ShellMode& mode, double k_) {
+    return mode.kmag <= k_;
+  };
+  const long long imode_begin = std::lower_bound(
+    this->shell_modes.begin(), this->shell_modes.end(), k_lower, cmp_kmag
+  ) - this->shell_modes.begin();
+  const long long imode_end = std::lower_bound(
+    this->shell_modes.begin(), this->shell_modes.end(), k_upper, cmp_kmag
+  ) - this->shell_modes.begin();
+
+  const bool subsample =
+    this->if_band_subsampled(k_lower, imode_begin, imode_end);
+
+  int nmodes_retained = 0;
+
 #ifdef TRV_USE_OMP
-#pragma omp parallel for collapse(3) reduction(+:k_eff, nmodes)
+#pragma omp parallel for reduction(+:k_eff, nmodes, nmodes_retained)
 #endif  // TRV_USE_OMP
-  for (int i = 0; i < this->params.ngrid[0]; i++) {
+  for (long long imode = imode_begin; imode < imode_end; imode++) {
+    const ShellMode& mode = this->shell_modes[imode];
+
+    k_eff += mode.mult * mode.kmag;
+    nmodes += mode.mult;
+
+    if (subsample && !mode.retained) {continue;}
+
+    nmodes_retained += mode.mult;
+
+    long long idx_grid = this->get_grid_index(mode.i, mode.j, mode.k);
+    this->field[idx_grid][0] = 1.;
+
+    if (mode.mult == 2) {
+      long long idx_grid_p =
+        this->get_hermitian_partner_index(mode.i, mode.j, mode.k);
+      this->field[idx_grid_p][0] = 1.;
+    }
+  }
+
+  /// Perform inverse FFT pruned to the band's bounding extent.
+  this->inv_fourier_transform_pruned(k_upper);
+
+  /// The band indicator field is real.
+  this->real_valued = true;
+
+  trvs::sum_across_tasks(&k_eff, 1);
+  trvs::sum_across_tasks(&nmodes, 1);
+  trvs::sum_across_tasks(&nmodes_retained, 1);
+
+  /// Average over (retained) wavevector modes in the band, which is
+  /// left as zeros if empty.
+  if (nmodes_retained > 0) {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+    for (int gid = 0; gid < this->local_nmesh; gid++) {
+      this->field[gid][0] /= double(nmodes_retained);
+      this->field[gid][1] /= double(nmodes_retained);
+    }
+  }
+
+  k_eff /= double(nmodes);
+}
+
+void MeshField::inv_fourier_transform_sjl_ylm_wgtd_field(
+    MeshField& field_fourier,
+    const std::vector< std::complex<double> >& ylm,
+    trvm::SphericalBesselCalculator& sjl,
+    double r
+) {
+  trvs::StageTimer timer("bessel_transform");
+
+  /// Reset field values to zero.
+  this->initialise_density_field();
+
+  /// Compute the field weighted by the spherical Bessel function and
+  /// reduced spherical harmonics.  If the Fourier-space field is
+  /// Hermitian-symmetric, each pair of modes at ±k is visited once.
+  const bool half_space =
+    field_fourier.real_valued && this->if_mesh_local();
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for collapse(3)
+#endif  // TRV_USE_OMP
+  for (int i = this->local_x_begin; i < this->local_x_end; i++) {
     for (int j = 0; j < this->params.ngrid[1]; j++) {
       for (int k = 0; k < this->params.ngrid[2]; k++) {
+        int mult = half_space ? this->get_hermitian_multiplicity(i, j, k) : 1;
+        if (mult == 0) {continue;}
+
         long long idx_grid = this->get_grid_index(i, j, k);
 
         double kv[3];
@@ -1220,158 +1988,652 @@ void MeshField::inv_fourier_transform_ylm_wgtd_field_band_limited(
 
         double k_ = trvm::get_vec3d_magnitude(kv);
 
-        /// Determine the grid cell contribution to the band.
-        if (k_lower < k_ && k_ <= k_upper) {
-          std::complex<double> fk(
-            field_fourier[idx_grid][0], field_fourier[idx_grid][1]
-          );
+        /// Apply assignment compensation.
+        std::complex<double> fk(
+          field_fourier[idx_grid][0], field_fourier[idx_grid][1]
+        );
+
+        double win = this->calc_assignment_window_in_fourier(i, j, k);
+        fk /= win;
+
+        /// Weight the field including the volume normalisation,
+        /// where ∫d³k/(2π)³ ↔ (1/V) Σᵢ, V =: `vol`.
+        double sj = sjl.eval(k_ * r);
 
-          /// Apply assignment compensation.
-          double win = this->calc_assignment_window_in_fourier(i, j, k);
-          fk /= win;
+        this->field[idx_grid][0] = sj * (ylm[idx_grid] * fk).real() / this->vol;
+        this->field[idx_grid][1] = sj * (ylm[idx_grid] * fk).imag() / this->vol;
+
+        if (mult == 2) {
+          long long idx_grid_p = this->get_hermitian_partner_index(i, j, k);
+
+          this->field[idx_grid_p][0] =
+            sj * (ylm[idx_grid_p] * std::conj(fk)).real() / this->vol;
+          this->field[idx_grid_p][1] =
+            sj * (ylm[idx_grid_p] * std::conj(fk)).imag() / this->vol;
+        }
+      }
+    }
+  }
+
+  /// The weighted field is complex in general.
+  this->real_valued = false;
+
+  /// Perform inverse FFT.
+  this->execute_dft_3d(this->field, FFTW_BACKWARD);
+}
+
+
+/// ----------------------------------------------------------------------
+/// Misc
+/// ----------------------------------------------------------------------
+
+double MeshField::calc_grid_based_powlaw_norm(
+  ParticleCatalogue& particles, int order
+) {
+  /// Compute the weighted field.
+  this->initialise_density_field();
+
+  this->add_kernel_weighted_field_to_mesh(
+    particles,
+    [&particles](int pid) {
+      return std::complex<double>(particles[pid].w, 0.);
+    }
+  );
+
+  /// Compute normalisation volume integral, where ∫d³x ↔ dV Σᵢ,
+  /// dV =: `vol_cell`.
+  double vol_int = 0.;
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for reduction(+:vol_int)
+#endif  // TRV_USE_OMP
+  for (int gid = 0; gid < this->local_nmesh; gid++) {
+    vol_int += std::pow(this->field[gid][0], order);
+  }
+
+  trvs::sum_across_tasks(&vol_int, 1);
+
+  vol_int *= this->vol_cell;
+
+  double norm_factor = 1. / vol_int;
+
+  return norm_factor;
+}
+
+
+/// **********************************************************************
+/// Mesh field batch
+/// **********************************************************************
+
+/// ----------------------------------------------------------------------
+/// Life cycle
+/// ----------------------------------------------------------------------
+
+MeshFieldBatch::MeshFieldBatch(trv::ParameterSet& params, int nfields) {
+  this->params = params;
+  this->nfields = nfields;
+
+  /// Set up mesh fields without storage.
+  for (int ifield = 0; ifield < nfields; ifield++) {
+    this->fields.push_back(new MeshField(params, false));
+  }
+
+  /// Co-allocate the storage of all fields (and their shadows) and
+  /// increase allocated memory.
+  MeshField& field_0 = *this->fields[0];
+  this->field_dist =
+    static_cast<long long>(field_0.nslots) * field_0.local_nalloc;
+
+  this->field_block = fftw_alloc_complex(nfields * this->field_dist);
+
+  trvs::count_alloc(
+    trvs::size_in_gb<fftw_complex>(nfields * this->field_dist),
+    trvs::MEM_MESH
+  );
+
+  /// Attach the storage to each field.
+  for (int ifield = 0; ifield < nfields; ifield++) {
+    MeshField& field_ = *this->fields[ifield];
+    field_.field = this->field_block + ifield * this->field_dist;
+    if (this->params.interlace == "true") {
+      field_.field_s = field_.field + field_.local_nalloc;
+    }
+    field_.initialise_density_field();  // likely redundant but safe
+  }
+}
+
+MeshFieldBatch::~MeshFieldBatch() {
+  for (MeshField* field_ptr : this->fields) {delete field_ptr;}
+  this->fields.clear();
+
+  if (this->field_block != nullptr) {
+    fftw_free(this->field_block); this->field_block = nullptr;
+    trvs::count_dealloc(
+      trvs::size_in_gb<fftw_complex>(this->nfields * this->field_dist),
+      trvs::MEM_MESH
+    );
+  }
+}
+
+
+/// ----------------------------------------------------------------------
+/// Operators & reserved methods
+/// ----------------------------------------------------------------------
+
+MeshField& MeshFieldBatch::operator[](int ifield) {
+  return *this->fields[ifield];
+}
+
+
+/// ----------------------------------------------------------------------
+/// Field transforms
+/// ----------------------------------------------------------------------
+
+void MeshFieldBatch::fourier_transform() {
+  for (MeshField* field_ptr : this->fields) {
+    field_ptr->apply_fourier_volume_normalisation();
+  }
+
+  /// Perform FFT of all fields and their shadows (contiguous in memory)
+  /// with a single batched plan.
+  MeshField& field_0 = *this->fields[0];
+  field_0.execute_many_dft_3d(
+    this->field_block, this->nfields * field_0.nslots,
+    field_0.local_nalloc, FFTW_FORWARD
+  );
+
+  if (this->params.interlace == "true") {
+    for (MeshField* field_ptr : this->fields) {
+      field_ptr->apply_interlacing();
+    }
+  }
+}
+
+void MeshFieldBatch::inv_fourier_transform() {
+  for (MeshField* field_ptr : this->fields) {
+    field_ptr->apply_inv_fourier_volume_normalisation();
+  }
+
+  /// Perform inverse FFT of all fields (strided past their shadows)
+  /// with a single batched plan.
+  this->fields[0]->execute_many_dft_3d(
+    this->field_block, this->nfields, this->field_dist, FFTW_BACKWARD
+  );
+}
+
+
+/// **********************************************************************
+/// Random mesh cache
+/// **********************************************************************
+
+/// ----------------------------------------------------------------------
+/// Life cycle
+/// ----------------------------------------------------------------------
+
+RandomMeshCache::RandomMeshCache(trv::ParameterSet& params) {
+  this->params = params;
+
+  /// Hash the random catalogue file content.
+  std::uint64_t hash_content = 14695981039346656037ULL;  // FNV offset basis
+
+  /// All tasks must be able to open the file (otherwise all abort).
+  std::FILE* fileptr = std::fopen(params.rand_catalogue_file.c_str(), "rb");
+  int failed = (fileptr == nullptr) ? 1 : 0;
+  trvs::sum_across_tasks(&failed, 1);
+  if (failed > 0) {
+    if (fileptr != nullptr) {std::fclose(fileptr);}
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Failed to open random catalogue file for hashing: %s.",
+        params.rand_catalogue_file.c_str()
+      );
+    }
+    throw trvs::IOError(
+      "Failed to open random catalogue file for hashing: %s.\n",
+      params.rand_catalogue_file.c_str()
+    );
+  }
+
+  std::vector<char> buffer(1 << 20);
+  std::size_t nread;
+  while ((nread = std::fread(buffer.data(), 1, buffer.size(), fileptr)) > 0) {
+    hash_content = RandomMeshCache::hash_bytes(
+      buffer.data(), nread, hash_content
+    );
+  }
+  std::fclose(fileptr);
+
+  /// Hash the parameters on which the aligned particle positions depend
+  /// (with padding parameters only relevant to padding alignment).
+  bool padded = (params.alignment == "pad");
+  char align_str[1024];
+  std::snprintf(
+    align_str, sizeof(align_str),
+    "%s|%s|%s|%.17g|%.17g,%.17g,%.17g|%d,%d,%d",
+    params.catalogue_columns.c_str(), params.alignment.c_str(),
+    padded ? params.padscale.c_str() : "", padded ? params.padfactor : 0.,
+    params.boxsize[0], params.boxsize[1], params.boxsize[2],
+    params.ngrid[0], params.ngrid[1], params.ngrid[2]
+  );
+  std::uint64_t hash_align = RandomMeshCache::hash_bytes(
+    align_str, std::strlen(align_str), 14695981039346656037ULL
+  );
+
+  char prefix_str[1024];
+  std::snprintf(
+    prefix_str, sizeof(prefix_str), "%s/rand_%016llx_%016llx",
+    params.random_cache_dir.c_str(),
+    (unsigned long long)(hash_content), (unsigned long long)(hash_align)
+  );
+  this->prefix = prefix_str;
+
+  /// Read any saved entries.
+  std::ifstream fin(this->prefix + ".summary");
+  std::string line_str;
+  while (std::getline(fin, line_str)) {
+    std::istringstream iss(line_str);
+    std::string name;
+    double value_real, value_imag;
+    if (iss >> name >> value_real >> value_imag) {
+      this->values.push_back(
+        std::make_pair(name, std::complex<double>(value_real, value_imag))
+      );
+    }
+  }
+
+  if (trvs::currTask == 0) {
+    trvs::logger.info(
+      "Random mesh cache: %s (%d saved entries).",
+      this->prefix.c_str(), int(this->values.size())
+    );
+  }
+}
+
+bool RandomMeshCache::restore_catalogue(ParticleCatalogue& particles) {
+  std::complex<double> ntotal, wtotal, pos_min[3], pos_max[3];
+  const char* axes[3] = {"x", "y", "z"};
+  bool found = this->find_value("ntotal", ntotal)
+    && this->find_value("wtotal", wtotal);
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    found = found
+      && this->find_value(
+        std::string("pos_min_") + axes[iaxis], pos_min[iaxis]
+      )
+      && this->find_value(
+        std::string("pos_max_") + axes[iaxis], pos_max[iaxis]
+      );
+  }
+  if (!found) {return false;}
+
+  /// Hold only summary information, as for a streamed catalogue.
+  particles.finalise_particles();
+  particles.source = "extfile:" + this->params.rand_catalogue_file;
+  particles.streamed = true;
+  particles.ntotal = int(ntotal.real());
+  particles.wtotal = wtotal.real();
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    particles.pos_min[iaxis] = pos_min[iaxis].real();
+    particles.pos_max[iaxis] = pos_max[iaxis].real();
+    particles.pos_observer[iaxis] = 0.;
+  }
+  particles.mesh_cache = this;
+
+  if (trvs::currTask == 0) {
+    trvs::logger.info(
+      "Catalogue restored from random mesh cache: %d particles with "
+      "total systematic weights %.3f (source=%s).",
+      particles.ntotal, particles.wtotal, particles.source.c_str()
+    );
+  }
+
+  return true;
+}
+
+void RandomMeshCache::attach_catalogue(ParticleCatalogue& particles) {
+  const char* axes[3] = {"x", "y", "z"};
+
+  this->set_value("ntotal", particles.ntotal);
+  this->set_value("wtotal", particles.wtotal);
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    this->set_value(
+      std::string("pos_min_") + axes[iaxis], particles.pos_min[iaxis]
+    );
+    this->set_value(
+      std::string("pos_max_") + axes[iaxis], particles.pos_max[iaxis]
+    );
+  }
+  this->save_summary();
+
+  particles.mesh_cache = this;
+}
+
+void RandomMeshCache::load_particles(ParticleCatalogue& particles) {
+  if (particles.pdata != nullptr) {return;}
+
+  if (trvs::currTask == 0) {
+    trvs::logger.info(
+      "Random mesh cache entry missing; reloading random catalogue."
+    );
+  }
+
+  /// Reload the catalogue (which resets the observer position) and
+  /// re-apply the box alignment tracked by the observer position.
+  double dpos[3] = {
+    - particles.pos_observer[0],
+    - particles.pos_observer[1],
+    - particles.pos_observer[2]
+  };
+
+  particles.source.clear();
+  particles.streamed = false;
+  int failed = particles.load_catalogue_file(
+    this->params.rand_catalogue_file, this->params.catalogue_columns,
+    this->params.volume
+  ) ? 1 : 0;
+  trvs::sum_across_tasks(&failed, 1);
+  if (failed > 0) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Failed to reload random catalogue file for the mesh cache."
+      );
+    }
+    throw trvs::IOError(
+      "Failed to reload random catalogue file for the mesh cache.\n"
+    );
+  }
+
+  particles.offset_coords(dpos);
+}
+
+
+/// ----------------------------------------------------------------------
+/// Cache entries
+/// ----------------------------------------------------------------------
+
+bool RandomMeshCache::find_value(
+  const std::string& name, std::complex<double>& value
+) {
+  for (const auto& entry : this->values) {
+    if (entry.first == name) {
+      value = entry.second;
+      return true;
+    }
+  }
+  return false;
+}
 
-          /// Weight the field.
-          this->field[idx_grid][0] = (ylm[idx_grid] * fk).real();
-          this->field[idx_grid][1] = (ylm[idx_grid] * fk).imag();
+void RandomMeshCache::save_value(
+  const std::string& name, std::complex<double> value
+) {
+  this->set_value(name, value);
+  this->save_summary();
+}
 
-          k_eff += k_;
-          nmodes++;
-        } else {
-          // this->field[idx_grid][0] = 0.; (unused)
-          // this->field[idx_grid][1] = 0.; (unused)
-        }
-      }
+void RandomMeshCache::set_value(
+  const std::string& name, std::complex<double> value
+) {
+  bool found = false;
+  for (auto& entry : this->values) {
+    if (entry.first == name) {
+      entry.second = value;
+      found = true;
+      break;
     }
   }
+  if (!found) {this->values.push_back(std::make_pair(name, value));}
+}
 
-  /// Perform inverse FFT.
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_plan_with_nthreads(omp_get_max_threads());
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-  fftw_plan inv_transform = fftw_plan_dft_3d(
-    this->params.ngrid[0], this->params.ngrid[1], this->params.ngrid[2],
-    this->field, this->field,
-    FFTW_BACKWARD, FFTW_ESTIMATE
+template <class LoSPolicy>
+void RandomMeshCache::add_ylm_wgtd_field(
+  MeshField& field, ParticleCatalogue& particles, LoSPolicy los,
+  double weight, int ell, int m, bool quad
+) {
+  /// Reduced spherical harmonics are real only for m = 0.
+  if (m != 0) {field.real_valued = false;}
+
+  char filepath[1024];
+  std::snprintf(
+    filepath, sizeof(filepath), "%s_%s_%s_l%d_m%d_task%d.mesh",
+    this->prefix.c_str(),
+    RandomMeshCache::get_mesh_key(field.params, particles).c_str(),
+    quad ? "quad" : "ylm", ell, m, trvs::currTask
   );
 
-  fftw_execute(inv_transform);
-  fftw_destroy_plan(inv_transform);
+  if (this->add_mesh_from_file(field, filepath, weight)) {return;}
 
-  /// Average over wavevector modes in the band.
+  /// Assign the unweighted (i.e. alpha-unscaled) field, save it and
+  /// add it with the overall weight.
+  this->load_particles(particles);
+
+  MeshField field_rand(field.params);
+  if (quad) {
+    field_rand.add_ylm_wgtd_quad_field(particles, los, 1., ell, m);
+  } else {
+    field_rand.add_ylm_wgtd_field(particles, los, 1., ell, m);
+  }
+
+  this->save_mesh_to_file(field_rand, filepath);
+
+  for (int islot = 0; islot < field.nslots; islot++) {
+    fftw_complex* dest = field.field + islot * field.local_nalloc;
+    fftw_complex* src = field_rand.field + islot * field_rand.local_nalloc;
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
-    this->field[gid][0] /= double(nmodes);
-    this->field[gid][1] /= double(nmodes);
+    for (int gid = 0; gid < field.local_nmesh; gid++) {
+      dest[gid][0] += weight * src[gid][0];
+      dest[gid][1] += weight * src[gid][1];
+    }
   }
-
-  k_eff /= double(nmodes);
 }
 
-void MeshField::inv_fourier_transform_sjl_ylm_wgtd_field(
-    MeshField& field_fourier,
-    std::vector< std::complex<double> >& ylm,
-    trvm::SphericalBesselCalculator& sjl,
-    double r
+std::string RandomMeshCache::get_mesh_key(
+  trv::ParameterSet& params, ParticleCatalogue& particles
 ) {
-  /// Reset field values to zero.
-  this->initialise_density_field();
-
-  /// Compute the field weighted by the spherical Bessel function and
-  /// reduced spherical harmonics.
-#ifdef TRV_USE_OMP
-#pragma omp parallel for collapse(3)
-#endif  // TRV_USE_OMP
-  for (int i = 0; i < this->params.ngrid[0]; i++) {
-    for (int j = 0; j < this->params.ngrid[1]; j++) {
-      for (int k = 0; k < this->params.ngrid[2]; k++) {
-        long long idx_grid = this->get_grid_index(i, j, k);
+  char mesh_str[1024];
+  std::snprintf(
+    mesh_str, sizeof(mesh_str),
+    "%.17g,%.17g,%.17g|%d,%d,%d|%s|%s|%d|%.17g,%.17g,%.17g",
+    params.boxsize[0], params.boxsize[1], params.boxsize[2],
+    params.ngrid[0], params.ngrid[1], params.ngrid[2],
+    params.assignment.c_str(), params.interlace.c_str(), trvs::numTasks,
+    particles.pos_observer[0], particles.pos_observer[1],
+    particles.pos_observer[2]
+  );
+  std::uint64_t hash_mesh = RandomMeshCache::hash_bytes(
+    mesh_str, std::strlen(mesh_str), 14695981039346656037ULL
+  );
 
-        double kv[3];
-        this->get_grid_wavevector(i, j, k, kv);
+  char key[32];
+  std::snprintf(key, sizeof(key), "%016llx", (unsigned long long)(hash_mesh));
 
-        double k_ = trvm::get_vec3d_magnitude(kv);
+  return std::string(key);
+}
 
-        /// Apply assignment compensation.
-        std::complex<double> fk(
-          field_fourier[idx_grid][0], field_fourier[idx_grid][1]
-        );
+std::uint64_t RandomMeshCache::hash_bytes(
+  const char* bytes, std::size_t len, std::uint64_t hash
+) {
+  const std::uint64_t FNV_PRIME = 1099511628211ULL;
+  for (std::size_t ib = 0; ib < len; ib++) {
+    hash ^= static_cast<unsigned char>(bytes[ib]);
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
 
-        double win = this->calc_assignment_window_in_fourier(i, j, k);
-        fk /= win;
+void RandomMeshCache::save_summary() {
+  if (trvs::currTask != 0) {return;}
 
-        /// Weight the field including the volume normalisation,
-        /// where ∫d³k/(2π)³ ↔ (1/V) Σᵢ, V =: `vol`.
-        this->field[idx_grid][0] =
-          sjl.eval(k_ * r) * (ylm[idx_grid] * fk).real() / this->vol;
-        this->field[idx_grid][1] =
-          sjl.eval(k_ * r) * (ylm[idx_grid] * fk).imag() / this->vol;
-      }
-    }
-  }
+  /// Write to a temporary file first so that concurrent readers never
+  /// see a partial summary.
+  std::string filepath = this->prefix + ".summary";
+  std::string filepath_tmp;
 
-  /// Perform inverse FFT.
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_plan_with_nthreads(omp_get_max_threads());
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-  fftw_plan inv_transform = fftw_plan_dft_3d(
-    this->params.ngrid[0], this->params.ngrid[1], this->params.ngrid[2],
-    this->field, this->field,
-    FFTW_BACKWARD, FFTW_ESTIMATE
+  std::FILE* fileptr = RandomMeshCache::open_temp_file(
+    filepath, "w", filepath_tmp
   );
+  if (fileptr == nullptr) {
+    trvs::logger.warn(
+      "Failed to save random mesh cache summary: %s.", filepath.c_str()
+    );
+    return;
+  }
+  bool written = true;
+  for (const auto& entry : this->values) {
+    written = std::fprintf(
+      fileptr, "%s %.17g %.17g\n",
+      entry.first.c_str(), entry.second.real(), entry.second.imag()
+    ) > 0 && written;
+  }
+  written = (std::fclose(fileptr) == 0) && written;
 
-  fftw_execute(inv_transform);
-  fftw_destroy_plan(inv_transform);
+  RandomMeshCache::commit_temp_file(filepath_tmp, filepath, written);
 }
 
-
-/// ----------------------------------------------------------------------
-/// Misc
-/// ----------------------------------------------------------------------
-
-double MeshField::calc_grid_based_powlaw_norm(
-  ParticleCatalogue& particles, int order
+bool RandomMeshCache::add_mesh_from_file(
+  MeshField& field, const std::string& filepath, double weight
 ) {
-  /// Initialise the weight field.
-  fftw_complex* weight = nullptr;
+  /// The file holds a header (a magic string and the number of values)
+  /// followed by each field slot over the local mesh.
+  const long long nvalues = 2LL * field.nslots * field.local_nmesh;
+  const std::size_t header_size = 8 + sizeof(long long);
+  const std::size_t file_size = header_size + nvalues * sizeof(double);
+
+  const char* data = nullptr;
+  std::vector<char> buffer;
+#if defined(__unix__) || defined(__APPLE__)
+  void* addr = MAP_FAILED;
+  int fd = open(filepath.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == 0
+        && std::size_t(file_stat.st_size) == file_size) {
+      addr = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+  }
+  if (addr != MAP_FAILED) {data = static_cast<const char*>(addr);}
+#else  // !__unix__ && !__APPLE__
+  std::FILE* fileptr = std::fopen(filepath.c_str(), "rb");
+  if (fileptr != nullptr) {
+    buffer.resize(file_size);
+    if (std::fread(buffer.data(), 1, file_size, fileptr) == file_size
+        && std::fgetc(fileptr) == EOF) {
+      data = buffer.data();
+    }
+    std::fclose(fileptr);
+  }
+#endif  // __unix__ || __APPLE__
 
-  weight = fftw_alloc_complex(particles.ntotal);
+  long long nvalues_saved = 0;
+  if (data != nullptr) {
+    std::memcpy(&nvalues_saved, data + 8, sizeof(long long));
+  }
+  int found = (
+    data != nullptr
+    && std::memcmp(data, "TRVMESH", 8) == 0
+    && nvalues_saved == nvalues
+  ) ? 1 : 0;
 
-  trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(particles.ntotal);
-  trv::sys::update_maxmem();
+  /// All tasks must agree on using the cache.
+  trvs::sum_across_tasks(&found, 1);
 
+  if (found == trvs::numTasks) {
+    const double* src = reinterpret_cast<const double*>(data + header_size);
+    for (int islot = 0; islot < field.nslots; islot++) {
+      fftw_complex* dest = field.field + islot * field.local_nalloc;
+      const double* src_slot = src + 2LL * islot * field.local_nmesh;
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles.ntotal; pid++) {
-    weight[pid][0] = particles[pid].w;
-    weight[pid][1] = 0.;
+      for (int gid = 0; gid < field.local_nmesh; gid++) {
+        dest[gid][0] += weight * src_slot[2 * (long long)(gid)];
+        dest[gid][1] += weight * src_slot[2 * (long long)(gid) + 1];
+      }
+    }
   }
 
-  /// Compute the weighted field.
-  this->assign_weighted_field_to_mesh(particles, weight);
+#if defined(__unix__) || defined(__APPLE__)
+  if (addr != MAP_FAILED) {munmap(addr, file_size);}
+#endif  // __unix__ || __APPLE__
 
-  fftw_free(weight); weight = nullptr;
+  return found == trvs::numTasks;
+}
 
-  trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(particles.ntotal);
+void RandomMeshCache::save_mesh_to_file(
+  MeshField& field, const std::string& filepath
+) {
+  std::string filepath_tmp;
 
-  /// Compute normalisation volume integral, where ∫d³x ↔ dV Σᵢ,
-  /// dV =: `vol_cell`.
-  double vol_int = 0.;
+  std::FILE* fileptr = RandomMeshCache::open_temp_file(
+    filepath, "wb", filepath_tmp
+  );
+  if (fileptr == nullptr) {
+    trvs::logger.warn(
+      "Failed to save random mesh cache file: %s.", filepath.c_str()
+    );
+    return;
+  }
 
-#ifdef TRV_USE_OMP
-#pragma omp parallel for reduction(+:vol_int)
-#endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
-    vol_int += std::pow(this->field[gid][0], order);
+  const long long nvalues = 2LL * field.nslots * field.local_nmesh;
+  bool written = std::fwrite("TRVMESH", 1, 8, fileptr) == 8
+    && std::fwrite(&nvalues, sizeof(long long), 1, fileptr) == 1;
+  for (int islot = 0; islot < field.nslots && written; islot++) {
+    written = std::fwrite(
+      field.field + islot * field.local_nalloc,
+      sizeof(fftw_complex), field.local_nmesh, fileptr
+    ) == std::size_t(field.local_nmesh);
   }
+  written = (std::fclose(fileptr) == 0) && written;
 
-  vol_int *= this->vol_cell;
+  RandomMeshCache::commit_temp_file(filepath_tmp, filepath, written);
+}
 
-  double norm_factor = 1. / vol_int;
+std::FILE* RandomMeshCache::open_temp_file(
+  const std::string& filepath, const char* mode, std::string& filepath_tmp
+) {
+  /// Tag the temporary file by process and task so that concurrent
+  /// writers (of the same or other runs) never share it.
+#if defined(__unix__) || defined(__APPLE__)
+  filepath_tmp = filepath + ".tmp." + std::to_string(getpid())
+    + "." + std::to_string(trvs::currTask) + ".XXXXXX";
+
+  std::vector<char> filepath_buf(filepath_tmp.begin(), filepath_tmp.end());
+  filepath_buf.push_back('\0');
+
+  int fd = mkstemp(filepath_buf.data());
+  if (fd < 0) {return nullptr;}
+  filepath_tmp = filepath_buf.data();
+
+  /// Restore the usual permissions (`mkstemp` creates files with 0600)
+  /// so that the cache stays shareable.
+  fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+
+  std::FILE* fileptr = fdopen(fd, mode);
+  if (fileptr == nullptr) {
+    close(fd);
+    std::remove(filepath_tmp.c_str());
+  }
+  return fileptr;
+#else  // !__unix__ && !__APPLE__
+  filepath_tmp = filepath + ".tmp." + std::to_string(trvs::currTask);
+  return std::fopen(filepath_tmp.c_str(), mode);
+#endif  // __unix__ || __APPLE__
+}
 
-  return norm_factor;
+void RandomMeshCache::commit_temp_file(
+  const std::string& filepath_tmp, const std::string& filepath,
+  bool written
+) {
+  /// Only complete files replace the destination (atomically).
+  if (written && std::rename(filepath_tmp.c_str(), filepath.c_str()) == 0) {
+    return;
+  }
+
+  std::remove(filepath_tmp.c_str());
+  trvs::logger.warn(
+    "Failed to save random mesh cache file: %s.", filepath.c_str()
+  );
 }
 
 
@@ -1416,6 +2678,35 @@ void FieldStats::reset_stats() {
   std::fill(this->xi.begin(), this->xi.end(), 0.);
 }
 
+void FieldStats::set_wedge_binning(
+  int num_mu_bins, double los[3], std::complex<double> shotnoise_amp
+) {
+  if (num_mu_bins < 0) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error("Number of wedge bins must be non-negative.");
+      throw trvs::InvalidParameter(
+        "Number of wedge bins must be non-negative.\n"
+      );
+    }
+  }
+
+  double los_norm = trvm::get_vec3d_magnitude(los);
+  if (num_mu_bins > 0 && los_norm == 0.) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error("Wedge line of sight must be non-zero.");
+      throw trvs::InvalidParameter(
+        "Wedge line of sight must be non-zero.\n"
+      );
+    }
+  }
+
+  this->num_mu_bins = num_mu_bins;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    this->los_wedges[iaxis] = (num_mu_bins > 0) ? los[iaxis] / los_norm : 0.;
+  }
+  this->sn_amp_wedges = shotnoise_amp;
+}
+
 void FieldStats::resize_stats(int num_bins){
   this->nmodes.resize(num_bins);
   this->npairs.resize(num_bins);
@@ -1471,18 +2762,44 @@ void FieldStats::compute_ylm_wgtd_2pt_stats_in_fourier(
   MeshField& field_a, MeshField& field_b, std::complex<double> shotnoise_amp,
   int ell, int m, trv::Binning& kbinning
 ) {
+  std::vector<MeshField*> fields_a = {&field_a};
+  std::vector< std::complex<double> > shotnoise_amps = {shotnoise_amp};
+  std::vector<int> ells = {ell};
+  std::vector<int> ms = {m};
+
+  this->compute_ylm_wgtd_2pt_stats_in_fourier(
+    fields_a, field_b, shotnoise_amps, ells, ms, kbinning
+  );
+
+  this->pk = this->pk_terms[0];
+  this->sn = this->sn_terms[0];
+}
+
+void FieldStats::compute_ylm_wgtd_2pt_stats_in_fourier(
+  std::vector<MeshField*>& fields_a, MeshField& field_b,
+  std::vector< std::complex<double> >& shotnoise_amps,
+  std::vector<int>& ells, std::vector<int>& ms, trv::Binning& kbinning
+) {
+  trvs::StageTimer timer("binning");
+
   this->resize_stats(kbinning.num_bins);
 
+  const int nterms = fields_a.size();
+
   /// Check mesh fields compatibility and reuse methods of the first mesh field.
-  if (!this->if_fields_compatible(field_a, field_b)) {
-    trvs::logger.error(
-      "Input mesh fields have incompatible physical properties."
-    );
-    throw trvs::InvalidData(
-      "Input mesh fields have incompatible physical properties.\n"
-    );
+  for (int iterm = 0; iterm < nterms; iterm++) {
+    if (!this->if_fields_compatible(*fields_a[iterm], field_b)) {
+      trvs::logger.error(
+        "Input mesh fields have incompatible physical properties."
+      );
+      throw trvs::InvalidData(
+        "Input mesh fields have incompatible physical properties.\n"
+      );
+    }
   }
 
+  MeshField& field_a = *fields_a[0];
+
   auto ret_grid_index = [&field_a](int i, int j, int k) {
     return field_a.get_grid_index(i, j, k);
   };
@@ -1499,29 +2816,109 @@ void FieldStats::compute_ylm_wgtd_2pt_stats_in_fourier(
 
   int* nmodes_sample = new int[n_sample];
   double* k_sample = new double[n_sample];
-  double* pk_sample_real = new double[n_sample];
-  double* pk_sample_imag = new double[n_sample];
-  double* sn_sample_real = new double[n_sample];
-  double* sn_sample_imag = new double[n_sample];
-  std::complex<double>* pk_sample = new std::complex<double>[n_sample];
-  std::complex<double>* sn_sample = new std::complex<double>[n_sample];
+  double* pk_sample_real = new double[nterms * n_sample];
+  double* pk_sample_imag = new double[nterms * n_sample];
+  double* sn_sample_real = new double[nterms * n_sample];
+  double* sn_sample_imag = new double[nterms * n_sample];
+  double gbytes_sample = trvs::size_in_gb<int>(n_sample)
+    + trvs::size_in_gb<double>((1 + 4 * nterms) * (long long)(n_sample));
   for (int i = 0; i < n_sample; i++) {
     nmodes_sample[i] = 0;
     k_sample[i] = 0.;
+  }
+  for (int i = 0; i < nterms * n_sample; i++) {
     pk_sample_real[i] = 0.;
     pk_sample_imag[i] = 0.;
     sn_sample_real[i] = 0.;
     sn_sample_imag[i] = 0.;
   }
 
+  /// Map fine samples to wavenumber bins for mode subsampling and
+  /// wedge binning, where only the auto-power of the second field is
+  /// accumulated for the latter.
+  const int num_mu_bins = this->num_mu_bins;
+  const int num_wedge_bins = kbinning.num_bins * num_mu_bins;
+
+  const bool subsample = this->params.subsample_frac < 1.;
+
+  int* ibin_sample = nullptr;
+  if (num_mu_bins > 0 || subsample) {
+    ibin_sample = new int[n_sample];
+    gbytes_sample += trvs::size_in_gb<int>(n_sample);
+    for (int i = 0; i < n_sample; i++) {
+      ibin_sample[i] = -1;
+      double k_ = i * dk_sample;
+      for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+        double k_lower = kbinning.bin_edges[ibin];
+        double k_upper = kbinning.bin_edges[ibin + 1];
+        if (k_lower < k_ && k_ <= k_upper) {
+          ibin_sample[i] = ibin;
+          break;
+        }
+      }
+    }
+  }
+
+  /// In subsampled bins (i.e. with lower edges at or above
+  /// `subsample_kmin`), all modes are counted but only the retained
+  /// modes are added, which are then averaged over by their exact count.
+  int* nmodes_retained_sample = nullptr;
+  if (subsample) {
+    nmodes_retained_sample = new int[n_sample];
+    gbytes_sample += trvs::size_in_gb<int>(n_sample);
+    for (int i = 0; i < n_sample; i++) {
+      nmodes_retained_sample[i] = 0;
+    }
+  }
+
+  int* nmodes_wedge = nullptr;
+  int* nmodes_retained_wedge = nullptr;
+  double* k_wedge = nullptr;
+  double* mu_wedge = nullptr;
+  double* pk_wedge = nullptr;
+  double* sn_wedge = nullptr;
+  if (num_mu_bins > 0) {
+    nmodes_wedge = new int[num_wedge_bins];
+    nmodes_retained_wedge = new int[num_wedge_bins];
+    k_wedge = new double[num_wedge_bins];
+    mu_wedge = new double[num_wedge_bins];
+    pk_wedge = new double[num_wedge_bins];
+    sn_wedge = new double[num_wedge_bins];
+    gbytes_sample += trvs::size_in_gb<int>(2 * num_wedge_bins)
+      + trvs::size_in_gb<double>(4 * num_wedge_bins);
+    for (int iwedge = 0; iwedge < num_wedge_bins; iwedge++) {
+      nmodes_wedge[iwedge] = 0;
+      nmodes_retained_wedge[iwedge] = 0;
+      k_wedge[iwedge] = 0.;
+      mu_wedge[iwedge] = 0.;
+      pk_wedge[iwedge] = 0.;
+      sn_wedge[iwedge] = 0.;
+    }
+  }
+
+  trvs::count_alloc(gbytes_sample, trvs::MEM_STATS);
+
   this->reset_stats();
 
+  /// If all fields are Hermitian-symmetric, each pair of modes at ±k
+  /// is visited once, with the partner mode contributing the complex
+  /// conjugate weighted by the parity of the reduced spherical harmonic.
+  bool half_space = field_b.real_valued;
+  for (int iterm = 0; iterm < nterms; iterm++) {
+    half_space = half_space && fields_a[iterm]->real_valued;
+  }
+
+  /// The wavenumber bin and grid corrections of each mode are shared
+  /// by all terms.
 #ifdef TRV_USE_OMP
 #pragma omp parallel for collapse(3)
 #endif  // TRV_USE_OMP
-  for (int i = 0; i < this->params.ngrid[0]; i++) {
+  for (int i = field_a.local_x_begin; i < field_a.local_x_end; i++) {
     for (int j = 0; j < this->params.ngrid[1]; j++) {
       for (int k = 0; k < this->params.ngrid[2]; k++) {
+        int mult = half_space ? field_a.get_hermitian_multiplicity(i, j, k) : 1;
+        if (mult == 0) {continue;}
+
         long long idx_grid = ret_grid_index(i, j, k);
 
         double kv[3];
@@ -1531,12 +2928,25 @@ void FieldStats::compute_ylm_wgtd_2pt_stats_in_fourier(
 
         int idx_k = int(k_ / dk_sample);
         if (0 <= idx_k && idx_k < n_sample) {
-          std::complex<double> fa(field_a[idx_grid][0], field_a[idx_grid][1]);
-          std::complex<double> fb(field_b[idx_grid][0], field_b[idx_grid][1]);
-
-          std::complex<double> pk_mode = fa * std::conj(fb);
-          std::complex<double> sn_mode =
-            shotnoise_amp * this->calc_shotnoise_aliasing(i, j, k);
+OMP_ATOMIC
+          nmodes_sample[idx_k] += mult;
+OMP_ATOMIC
+          k_sample[idx_k] += mult * k_;
+
+          bool retained = true;
+          if (subsample) {
+            int ibin = ibin_sample[idx_k];
+            if (
+              ibin >= 0
+              && kbinning.bin_edges[ibin] >= this->params.subsample_kmin
+            ) {
+              retained = field_a.if_mode_retained(i, j, k);
+            }
+            if (retained) {
+OMP_ATOMIC
+              nmodes_retained_sample[idx_k] += mult;
+            }
+          }
 
           /// Apply grid corrections.
           double win_pk, win_sn;
@@ -1556,83 +2966,219 @@ void FieldStats::compute_ylm_wgtd_2pt_stats_in_fourier(
 #endif  // !DBG_NOAC
           }
 
-          pk_mode /= win_pk;
-          sn_mode /= win_sn;
+          double sn_alias = this->calc_shotnoise_aliasing(i, j, k);
 
-          /// Weight by reduced spherical harmonics.
-          std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
-            calc_reduced_spherical_harmonic(ell, m, kv);
+          std::complex<double> fb(field_b[idx_grid][0], field_b[idx_grid][1]);
 
-          pk_mode *= ylm;
-          sn_mode *= ylm;
+          /// Add wedge contribution, where the partner mode at -k
+          /// shares |μ| and the (real) auto-power.
+          if (num_mu_bins > 0 && ibin_sample[idx_k] >= 0) {
+            double mu_ = (k_ > 0.) ? std::fabs(
+              kv[0] * this->los_wedges[0]
+              + kv[1] * this->los_wedges[1]
+              + kv[2] * this->los_wedges[2]
+            ) / k_ : 0.;
+            int imu = std::min(int(mu_ * num_mu_bins), num_mu_bins - 1);
+            int iwedge = ibin_sample[idx_k] * num_mu_bins + imu;
 
-          double pk_mode_real = pk_mode.real();
-          double pk_mode_imag = pk_mode.imag();
-          double sn_mode_real = sn_mode.real();
-          double sn_mode_imag = sn_mode.imag();
+            double pk_wedge_mode = mult * std::norm(fb) / win_pk;
+            double sn_wedge_mode = mult * sn_alias / win_sn;
 
-          /// Add contribution.
 OMP_ATOMIC
-          nmodes_sample[idx_k]++;
+            nmodes_wedge[iwedge] += mult;
+OMP_ATOMIC
+            k_wedge[iwedge] += mult * k_;
 OMP_ATOMIC
-          k_sample[idx_k] += k_;
+            mu_wedge[iwedge] += mult * mu_;
+            if (retained) {
 OMP_ATOMIC
-          pk_sample_real[idx_k] += pk_mode_real;
+              nmodes_retained_wedge[iwedge] += mult;
 OMP_ATOMIC
-          pk_sample_imag[idx_k] += pk_mode_imag;
+              pk_wedge[iwedge] += pk_wedge_mode;
 OMP_ATOMIC
-          sn_sample_real[idx_k] += sn_mode_real;
+              sn_wedge[iwedge] += sn_wedge_mode;
+            }
+          }
+
+          if (!retained) {continue;}
+
+          for (int iterm = 0; iterm < nterms; iterm++) {
+            std::complex<double> fa(
+              (*fields_a[iterm])[idx_grid][0], (*fields_a[iterm])[idx_grid][1]
+            );
+
+            std::complex<double> pk_mode = fa * std::conj(fb);
+            std::complex<double> sn_mode = shotnoise_amps[iterm] * sn_alias;
+
+            pk_mode /= win_pk;
+            sn_mode /= win_sn;
+
+            /// Weight by reduced spherical harmonics.
+            std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
+              calc_reduced_spherical_harmonic(ells[iterm], ms[iterm], kv);
+
+            if (mult == 2) {
+              double parity = (ells[iterm] % 2 == 0) ? 1. : -1.;
+              pk_mode = ylm * (pk_mode + parity * std::conj(pk_mode));
+              sn_mode = ylm * (1. + parity) * sn_mode;
+            } else {
+              pk_mode *= ylm;
+              sn_mode *= ylm;
+            }
+
+            double pk_mode_real = pk_mode.real();
+            double pk_mode_imag = pk_mode.imag();
+            double sn_mode_real = sn_mode.real();
+            double sn_mode_imag = sn_mode.imag();
+
+            /// Add contribution.
+            long long idx_sample = iterm * n_sample + idx_k;
 OMP_ATOMIC
-          sn_sample_imag[idx_k] += sn_mode_imag;
+            pk_sample_real[idx_sample] += pk_mode_real;
+OMP_ATOMIC
+            pk_sample_imag[idx_sample] += pk_mode_imag;
+OMP_ATOMIC
+            sn_sample_real[idx_sample] += sn_mode_real;
+OMP_ATOMIC
+            sn_sample_imag[idx_sample] += sn_mode_imag;
+          }
         }
       }
     }
   }
 
-  for (int i = 0; i < n_sample; i++) {
-    pk_sample[i] = pk_sample_real[i] + trvm::M_I * pk_sample_imag[i];
-    sn_sample[i] = sn_sample_real[i] + trvm::M_I * sn_sample_imag[i];
+  /// Reduce fine binning across mesh slabs.
+  trvs::sum_across_tasks(nmodes_sample, n_sample);
+  trvs::sum_across_tasks(k_sample, n_sample);
+  trvs::sum_across_tasks(pk_sample_real, nterms * n_sample);
+  trvs::sum_across_tasks(pk_sample_imag, nterms * n_sample);
+  trvs::sum_across_tasks(sn_sample_real, nterms * n_sample);
+  trvs::sum_across_tasks(sn_sample_imag, nterms * n_sample);
+  if (subsample) {
+    trvs::sum_across_tasks(nmodes_retained_sample, n_sample);
   }
 
   /// Perform binning.
+  this->pk_terms.assign(
+    nterms, std::vector< std::complex<double> >(kbinning.num_bins, 0.)
+  );
+  this->sn_terms.assign(
+    nterms, std::vector< std::complex<double> >(kbinning.num_bins, 0.)
+  );
+  int nbins_unretained = 0;  // subsampled bins with no retained modes
   for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
     double k_lower = kbinning.bin_edges[ibin];
     double k_upper = kbinning.bin_edges[ibin + 1];
+    int nmodes_retained = 0;
     for (int i = 0; i < n_sample; i++) {
       double k_ = i * dk_sample;
       if (k_lower < k_ && k_ <= k_upper) {
         this->nmodes[ibin] += nmodes_sample[i];
         this->k[ibin] += k_sample[i];
-        this->pk[ibin] += pk_sample[i];
-        this->sn[ibin] += sn_sample[i];
+        nmodes_retained +=
+          subsample ? nmodes_retained_sample[i] : nmodes_sample[i];
+        for (int iterm = 0; iterm < nterms; iterm++) {
+          long long idx_sample = iterm * n_sample + i;
+          this->pk_terms[iterm][ibin] += pk_sample_real[idx_sample]
+            + trvm::M_I * pk_sample_imag[idx_sample];
+          this->sn_terms[iterm][ibin] += sn_sample_real[idx_sample]
+            + trvm::M_I * sn_sample_imag[idx_sample];
+        }
       }
     }
 
-    if (this->nmodes[ibin] != 0) {
+    if (this->nmodes[ibin] != 0 && nmodes_retained != 0) {
       this->k[ibin] /= double(this->nmodes[ibin]);
-      this->pk[ibin] /= double(this->nmodes[ibin]);
-      this->sn[ibin] /= double(this->nmodes[ibin]);
+      for (int iterm = 0; iterm < nterms; iterm++) {
+        this->pk_terms[iterm][ibin] /= double(nmodes_retained);
+        this->sn_terms[iterm][ibin] /= double(nmodes_retained);
+      }
     } else {
+      /// A subsampled bin with modes but none retained is reported
+      /// as empty.
+      if (this->nmodes[ibin] != 0) {
+        this->nmodes[ibin] = 0;
+        nbins_unretained++;
+      }
       this->k[ibin] = kbinning.bin_centres[ibin];
-      this->pk[ibin] = 0.;
-      this->sn[ibin] = 0.;
+      for (int iterm = 0; iterm < nterms; iterm++) {
+        this->pk_terms[iterm][ibin] = 0.;
+        this->sn_terms[iterm][ibin] = 0.;
+      }
+    }
+  }
+
+  if (nbins_unretained > 0 && trvs::currTask == 0) {
+    trvs::logger.warn(
+      "No modes are retained under subsampling in %d wavenumber bin(s), "
+      "which are reported as empty. Consider raising `subsample_frac`.",
+      nbins_unretained
+    );
+  }
+
+  /// Perform wedge binning.
+  this->nmodes_wedges.assign(num_wedge_bins, 0);
+  this->k_wedges.assign(num_wedge_bins, 0.);
+  this->mu_wedges.assign(num_wedge_bins, 0.);
+  this->pk_wedges.assign(num_wedge_bins, 0.);
+  this->sn_wedges.assign(num_wedge_bins, 0.);
+  if (num_mu_bins > 0) {
+    trvs::sum_across_tasks(nmodes_wedge, num_wedge_bins);
+    trvs::sum_across_tasks(nmodes_retained_wedge, num_wedge_bins);
+    trvs::sum_across_tasks(k_wedge, num_wedge_bins);
+    trvs::sum_across_tasks(mu_wedge, num_wedge_bins);
+    trvs::sum_across_tasks(pk_wedge, num_wedge_bins);
+    trvs::sum_across_tasks(sn_wedge, num_wedge_bins);
+
+    for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+      for (int imu = 0; imu < num_mu_bins; imu++) {
+        int iwedge = ibin * num_mu_bins + imu;
+        this->nmodes_wedges[iwedge] = nmodes_wedge[iwedge];
+        if (
+          nmodes_wedge[iwedge] != 0 && nmodes_retained_wedge[iwedge] != 0
+        ) {
+          double nmodes_ = double(nmodes_wedge[iwedge]);
+          double nmodes_retained_ = double(nmodes_retained_wedge[iwedge]);
+          this->k_wedges[iwedge] = k_wedge[iwedge] / nmodes_;
+          this->mu_wedges[iwedge] = mu_wedge[iwedge] / nmodes_;
+          this->pk_wedges[iwedge] = pk_wedge[iwedge] / nmodes_retained_;
+          this->sn_wedges[iwedge] =
+            this->sn_amp_wedges * (sn_wedge[iwedge] / nmodes_retained_);
+        } else {
+          /// A subsampled wedge with modes but none retained is
+          /// reported as empty.
+          this->nmodes_wedges[iwedge] = 0;
+          this->k_wedges[iwedge] = kbinning.bin_centres[ibin];
+          this->mu_wedges[iwedge] = (imu + 0.5) / num_mu_bins;
+        }
+      }
     }
+
+    delete[] nmodes_wedge;
+    delete[] nmodes_retained_wedge;
+    delete[] k_wedge;
+    delete[] mu_wedge;
+    delete[] pk_wedge;
+    delete[] sn_wedge;
   }
 
+  delete[] ibin_sample;
+  delete[] nmodes_retained_sample;
   delete[] nmodes_sample;
   delete[] k_sample;
   delete[] pk_sample_real;
   delete[] pk_sample_imag;
   delete[] sn_sample_real;
   delete[] sn_sample_imag;
-  delete[] pk_sample;
-  delete[] sn_sample;
+  trvs::count_dealloc(gbytes_sample, trvs::MEM_STATS);
 }
 
 void FieldStats::compute_ylm_wgtd_2pt_stats_in_config(
   MeshField& field_a, MeshField& field_b, std::complex<double> shotnoise_amp,
   int ell, int m, trv::Binning& rbinning
 ) {
+  trvs::StageTimer timer("binning");
+
   this->resize_stats(rbinning.num_bins);
 
   /// Check mesh fields compatibility and reuse properties and methods of
@@ -1662,23 +3208,32 @@ void FieldStats::compute_ylm_wgtd_2pt_stats_in_config(
 
   /// Set up 3-d two-point statistics mesh grids (before inverse
   /// Fourier transform).
-  fftw_complex* twopt_3d = fftw_alloc_complex(this->params.nmesh);
+  fftw_complex* twopt_3d = fftw_alloc_complex(field_a.local_nalloc);
 
-  trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(this->params.nmesh);
-  trv::sys::update_maxmem();
+  trvs::count_alloc(
+    trvs::size_in_gb<fftw_complex>(field_a.local_nalloc), trvs::MEM_MESH
+  );
 
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
+  for (int gid = 0; gid < field_a.local_nmesh; gid++) {
     twopt_3d[gid][0] = 0.;
     twopt_3d[gid][1] = 0.;
   }  // likely redundant but safe
 
   /// Compute shot noise--subtracted mode powers on mesh grids.
-  for (int i = 0; i < this->params.ngrid[0]; i++) {
+  /// If both fields are Hermitian-symmetric, each pair of modes at ±k
+  /// is visited once.
+  const bool half_space = field_a.real_valued && field_b.real_valued
+    && field_a.if_mesh_local();
+
+  for (int i = field_a.local_x_begin; i < field_a.local_x_end; i++) {
     for (int j = 0; j < this->params.ngrid[1]; j++) {
       for (int k = 0; k < this->params.ngrid[2]; k++) {
+        int mult = half_space ? field_a.get_hermitian_multiplicity(i, j, k) : 1;
+        if (mult == 0) {continue;}
+
         long long idx_grid = ret_grid_index(i, j, k);
 
         std::complex<double> fa(field_a[idx_grid][0], field_a[idx_grid][1]);
@@ -1709,26 +3264,23 @@ void FieldStats::compute_ylm_wgtd_2pt_stats_in_config(
         pk_mode /= win_pk;
         sn_mode /= win_sn;
 
-        pk_mode -= sn_mode;
+        twopt_3d[idx_grid][0] = (pk_mode - sn_mode).real() / this->vol;
+        twopt_3d[idx_grid][1] = (pk_mode - sn_mode).imag() / this->vol;
+
+        if (mult == 2) {
+          long long idx_grid_p = field_a.get_hermitian_partner_index(i, j, k);
 
-        twopt_3d[idx_grid][0] = pk_mode.real() / this->vol;
-        twopt_3d[idx_grid][1] = pk_mode.imag() / this->vol;
+          twopt_3d[idx_grid_p][0] =
+            (std::conj(pk_mode) - sn_mode).real() / this->vol;
+          twopt_3d[idx_grid_p][1] =
+            (std::conj(pk_mode) - sn_mode).imag() / this->vol;
+        }
       }
     }
   }
 
   /// Inverse Fourier transform.
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_plan_with_nthreads(omp_get_max_threads());
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-  fftw_plan inv_transform = fftw_plan_dft_3d(
-    this->params.ngrid[0], this->params.ngrid[1], this->params.ngrid[2],
-    twopt_3d, twopt_3d,
-    FFTW_BACKWARD, FFTW_ESTIMATE
-  );
-
-  fftw_execute(inv_transform);
-  fftw_destroy_plan(inv_transform);
+  field_a.execute_dft_3d(twopt_3d, FFTW_BACKWARD);
 
   /// Perform fine binning.
   /// NOTE: Dynamically allocate owing to size.
@@ -1741,6 +3293,10 @@ void FieldStats::compute_ylm_wgtd_2pt_stats_in_config(
   double* xi_sample_real = new double[n_sample];
   double* xi_sample_imag = new double[n_sample];
   std::complex<double>* xi_sample = new std::complex<double>[n_sample];
+  const double gbytes_sample = trvs::size_in_gb<int>(n_sample)
+    + trvs::size_in_gb<double>(3 * n_sample)
+    + trvs::size_in_gb< std::complex<double> >(n_sample);
+  trvs::count_alloc(gbytes_sample, trvs::MEM_STATS);
   for (int i = 0; i < n_sample; i++) {
     npairs_sample[i] = 0;
     r_sample[i] = 0.;
@@ -1753,7 +3309,7 @@ void FieldStats::compute_ylm_wgtd_2pt_stats_in_config(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for collapse(3)
 #endif  // TRV_USE_OMP
-  for (int i = 0; i < this->params.ngrid[0]; i++) {
+  for (int i = field_a.local_x_begin; i < field_a.local_x_end; i++) {
     for (int j = 0; j < this->params.ngrid[1]; j++) {
       for (int k = 0; k < this->params.ngrid[2]; k++) {
         long long idx_grid = ret_grid_index(i, j, k);
@@ -1792,6 +3348,12 @@ OMP_ATOMIC
     }
   }
 
+  /// Reduce fine binning across mesh slabs.
+  trvs::sum_across_tasks(npairs_sample, n_sample);
+  trvs::sum_across_tasks(r_sample, n_sample);
+  trvs::sum_across_tasks(xi_sample_real, n_sample);
+  trvs::sum_across_tasks(xi_sample_imag, n_sample);
+
   for (int i = 0; i < n_sample; i++) {
     xi_sample[i] = xi_sample_real[i] + trvm::M_I * xi_sample_imag[i];
   }
@@ -1820,22 +3382,27 @@ OMP_ATOMIC
 
   fftw_free(twopt_3d); twopt_3d = nullptr;
 
-  trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(this->params.nmesh);
+  trvs::count_dealloc(
+    trvs::size_in_gb<fftw_complex>(field_a.local_nalloc), trvs::MEM_MESH
+  );
 
   delete[] npairs_sample;
   delete[] r_sample;
   delete[] xi_sample_real;
   delete[] xi_sample_imag;
   delete[] xi_sample;
+  trvs::count_dealloc(gbytes_sample, trvs::MEM_STATS);
 }
 
 void FieldStats::compute_uncoupled_shotnoise_for_3pcf(
   MeshField& field_a, MeshField& field_b,
-  std::vector< std::complex<double> >& ylm_a,
-  std::vector< std::complex<double> >& ylm_b,
+  const std::vector< std::complex<double> >& ylm_a,
+  const std::vector< std::complex<double> >& ylm_b,
   std::complex<double> shotnoise_amp,
   trv::Binning& rbinning
 ) {
+  trvs::StageTimer timer("shotnoise");
+
   this->resize_stats(rbinning.num_bins);
 
   /// Check mesh fields compatibility and reuse properties and methods of
@@ -1865,26 +3432,34 @@ void FieldStats::compute_uncoupled_shotnoise_for_3pcf(
 
   /// Set up 3-d two-point statistics mesh grids (before inverse
   /// Fourier transform).
-  fftw_complex* twopt_3d = fftw_alloc_complex(this->params.nmesh);
+  fftw_complex* twopt_3d = fftw_alloc_complex(field_a.local_nalloc);
 
-  trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(this->params.nmesh);
-  trv::sys::update_maxmem();
+  trvs::count_alloc(
+    trvs::size_in_gb<fftw_complex>(field_a.local_nalloc), trvs::MEM_MESH
+  );
 
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
+  for (int gid = 0; gid < field_a.local_nmesh; gid++) {
     twopt_3d[gid][0] = 0.;
     twopt_3d[gid][1] = 0.;
   }  // likely redundant but safe
 
-  /// Compute meshed statistics.
+  /// Compute meshed statistics.  If both fields are
+  /// Hermitian-symmetric, each pair of modes at ±k is visited once.
+  const bool half_space = field_a.real_valued && field_b.real_valued
+    && field_a.if_mesh_local();
+
 #ifdef TRV_USE_OMP
 #pragma omp parallel for collapse(3)
 #endif  // TRV_USE_OMP
-  for (int i = 0; i < this->params.ngrid[0]; i++) {
+  for (int i = field_a.local_x_begin; i < field_a.local_x_end; i++) {
     for (int j = 0; j < this->params.ngrid[1]; j++) {
       for (int k = 0; k < this->params.ngrid[2]; k++) {
+        int mult = half_space ? field_a.get_hermitian_multiplicity(i, j, k) : 1;
+        if (mult == 0) {continue;}
+
         long long idx_grid = ret_grid_index(i, j, k);
 
         std::complex<double> fa(field_a[idx_grid][0], field_a[idx_grid][1]);
@@ -1915,26 +3490,23 @@ void FieldStats::compute_uncoupled_shotnoise_for_3pcf(
         pk_mode /= win_pk;
         sn_mode /= win_sn;
 
-        pk_mode -= sn_mode;
+        twopt_3d[idx_grid][0] = (pk_mode - sn_mode).real() / this->vol;
+        twopt_3d[idx_grid][1] = (pk_mode - sn_mode).imag() / this->vol;
+
+        if (mult == 2) {
+          long long idx_grid_p = field_a.get_hermitian_partner_index(i, j, k);
 
-        twopt_3d[idx_grid][0] = pk_mode.real() / this->vol;
-        twopt_3d[idx_grid][1] = pk_mode.imag() / this->vol;
+          twopt_3d[idx_grid_p][0] =
+            (std::conj(pk_mode) - sn_mode).real() / this->vol;
+          twopt_3d[idx_grid_p][1] =
+            (std::conj(pk_mode) - sn_mode).imag() / this->vol;
+        }
       }
     }
   }
 
   /// Inverse Fourier transform.
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_plan_with_nthreads(omp_get_max_threads());
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-  fftw_plan inv_transform = fftw_plan_dft_3d(
-    this->params.ngrid[0], this->params.ngrid[1], this->params.ngrid[2],
-    twopt_3d, twopt_3d,
-    FFTW_BACKWARD, FFTW_ESTIMATE
-  );
-
-  fftw_execute(inv_transform);
-  fftw_destroy_plan(inv_transform);
+  field_a.execute_dft_3d(twopt_3d, FFTW_BACKWARD);
 
   /// Perform fine binning.
   /// NOTE: Dynamically allocate owing to size.
@@ -1947,6 +3519,10 @@ void FieldStats::compute_uncoupled_shotnoise_for_3pcf(
   double* xi_sample_real = new double[n_sample];
   double* xi_sample_imag = new double[n_sample];
   std::complex<double>* xi_sample = new std::complex<double>[n_sample];
+  const double gbytes_sample = trvs::size_in_gb<int>(n_sample)
+    + trvs::size_in_gb<double>(3 * n_sample)
+    + trvs::size_in_gb< std::complex<double> >(n_sample);
+  trvs::count_alloc(gbytes_sample, trvs::MEM_STATS);
   for (int i = 0; i < n_sample; i++) {
     npairs_sample[i] = 0;
     r_sample[i] = 0.;
@@ -1959,7 +3535,7 @@ void FieldStats::compute_uncoupled_shotnoise_for_3pcf(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for collapse(3)
 #endif  // TRV_USE_OMP
-  for (int i = 0; i < this->params.ngrid[0]; i++) {
+  for (int i = field_a.local_x_begin; i < field_a.local_x_end; i++) {
     for (int j = 0; j < this->params.ngrid[1]; j++) {
       for (int k = 0; k < this->params.ngrid[2]; k++) {
         long long idx_grid = ret_grid_index(i, j, k);
@@ -1995,6 +3571,12 @@ OMP_ATOMIC
     }
   }
 
+  /// Reduce fine binning across mesh slabs.
+  trvs::sum_across_tasks(npairs_sample, n_sample);
+  trvs::sum_across_tasks(r_sample, n_sample);
+  trvs::sum_across_tasks(xi_sample_real, n_sample);
+  trvs::sum_across_tasks(xi_sample_imag, n_sample);
+
   for (int i = 0; i < n_sample; i++) {
     xi_sample[i] = xi_sample_real[i] + trvm::M_I * xi_sample_imag[i];
   }
@@ -2033,23 +3615,28 @@ OMP_ATOMIC
 
   fftw_free(twopt_3d); twopt_3d = nullptr;
 
-  trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(this->params.nmesh);
+  trvs::count_dealloc(
+    trvs::size_in_gb<fftw_complex>(field_a.local_nalloc), trvs::MEM_MESH
+  );
 
   delete[] npairs_sample;
   delete[] r_sample;
   delete[] xi_sample_real;
   delete[] xi_sample_imag;
   delete[] xi_sample;
+  trvs::count_dealloc(gbytes_sample, trvs::MEM_STATS);
 }
 
 std::complex<double> FieldStats::compute_uncoupled_shotnoise_for_bispec_per_bin(
   MeshField& field_a, MeshField& field_b,
-  std::vector< std::complex<double> >& ylm_a,
-  std::vector< std::complex<double> >& ylm_b,
+  const std::vector< std::complex<double> >& ylm_a,
+  const std::vector< std::complex<double> >& ylm_b,
   trvm::SphericalBesselCalculator& sj_a, trvm::SphericalBesselCalculator& sj_b,
   std::complex<double> shotnoise_amp,
   double k_a, double k_b
 ) {
+  trvs::StageTimer timer("shotnoise");
+
   /// Check mesh fields compatibility and reuse properties and methods of
   /// the first mesh field.
   if (!this->if_fields_compatible(field_a, field_b)) {
@@ -2077,26 +3664,34 @@ std::complex<double> FieldStats::compute_uncoupled_shotnoise_for_bispec_per_bin(
 
   /// Set up 3-d two-point statistics mesh grids (before inverse
   /// Fourier transform).
-  fftw_complex* twopt_3d = fftw_alloc_complex(this->params.nmesh);
+  fftw_complex* twopt_3d = fftw_alloc_complex(field_a.local_nalloc);
 
-  trvs::gbytesMem += trvs::size_in_gb<fftw_complex>(this->params.nmesh);
-  trv::sys::update_maxmem();
+  trvs::count_alloc(
+    trvs::size_in_gb<fftw_complex>(field_a.local_nalloc), trvs::MEM_MESH
+  );
 
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int gid = 0; gid < this->params.nmesh; gid++) {
+  for (int gid = 0; gid < field_a.local_nmesh; gid++) {
     twopt_3d[gid][0] = 0.;
     twopt_3d[gid][1] = 0.;
   }  // likely redundant but safe
 
-  /// Compute meshed statistics.
+  /// Compute meshed statistics.  If both fields are
+  /// Hermitian-symmetric, each pair of modes at ±k is visited once.
+  const bool half_space = field_a.real_valued && field_b.real_valued
+    && field_a.if_mesh_local();
+
 #ifdef TRV_USE_OMP
 #pragma omp parallel for collapse(3)
 #endif  // TRV_USE_OMP
-  for (int i = 0; i < this->params.ngrid[0]; i++) {
+  for (int i = field_a.local_x_begin; i < field_a.local_x_end; i++) {
     for (int j = 0; j < this->params.ngrid[1]; j++) {
       for (int k = 0; k < this->params.ngrid[2]; k++) {
+        int mult = half_space ? field_a.get_hermitian_multiplicity(i, j, k) : 1;
+        if (mult == 0) {continue;}
+
         long long idx_grid = ret_grid_index(i, j, k);
 
         std::complex<double> fa(field_a[idx_grid][0], field_a[idx_grid][1]);
@@ -2127,26 +3722,23 @@ std::complex<double> FieldStats::compute_uncoupled_shotnoise_for_bispec_per_bin(
         pk_mode /= win_pk;
         sn_mode /= win_sn;
 
-        pk_mode -= sn_mode;
+        twopt_3d[idx_grid][0] = (pk_mode - sn_mode).real() / this->vol;
+        twopt_3d[idx_grid][1] = (pk_mode - sn_mode).imag() / this->vol;
+
+        if (mult == 2) {
+          long long idx_grid_p = field_a.get_hermitian_partner_index(i, j, k);
 
-        twopt_3d[idx_grid][0] = pk_mode.real() / this->vol;
-        twopt_3d[idx_grid][1] = pk_mode.imag() / this->vol;
+          twopt_3d[idx_grid_p][0] =
+            (std::conj(pk_mode) - sn_mode).real() / this->vol;
+          twopt_3d[idx_grid_p][1] =
+            (std::conj(pk_mode) - sn_mode).imag() / this->vol;
+        }
       }
     }
   }
 
   /// Inverse Fourier transform.
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_plan_with_nthreads(omp_get_max_threads());
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-  fftw_plan inv_transform = fftw_plan_dft_3d(
-    this->params.ngrid[0], this->params.ngrid[1], this->params.ngrid[2],
-    twopt_3d, twopt_3d,
-    FFTW_BACKWARD, FFTW_ESTIMATE
-  );
-
-  fftw_execute(inv_transform);
-  fftw_destroy_plan(inv_transform);
+  field_a.execute_dft_3d(twopt_3d, FFTW_BACKWARD);
 
   /// Weight by spherical Bessel functions and harmonics before summing
   /// over the configuration-space grids.
@@ -2155,7 +3747,7 @@ std::complex<double> FieldStats::compute_uncoupled_shotnoise_for_bispec_per_bin(
 #ifdef TRV_USE_OMP
 #pragma omp parallel for collapse(3) reduction(+:S_ij_k_real, S_ij_k_imag)
 #endif  // TRV_USE_OMP
-  for (int i = 0; i < this->params.ngrid[0]; i++) {
+  for (int i = field_a.local_x_begin; i < field_a.local_x_end; i++) {
     for (int j = 0; j < this->params.ngrid[1]; j++) {
       for (int k = 0; k < this->params.ngrid[2]; k++) {
         long long idx_grid = ret_grid_index(i, j, k);
@@ -2183,13 +3775,18 @@ std::complex<double> FieldStats::compute_uncoupled_shotnoise_for_bispec_per_bin(
     }
   }
 
+  trvs::sum_across_tasks(&S_ij_k_real, 1);
+  trvs::sum_across_tasks(&S_ij_k_imag, 1);
+
   std::complex<double> S_ij_k(S_ij_k_real, S_ij_k_imag);
 
   S_ij_k *= this->vol_cell;
 
   fftw_free(twopt_3d); twopt_3d = nullptr;
 
-  trvs::gbytesMem -= trvs::size_in_gb<fftw_complex>(this->params.nmesh);
+  trvs::count_dealloc(
+    trvs::size_in_gb<fftw_complex>(field_a.local_nalloc), trvs::MEM_MESH
+  );
 
   return S_ij_k;
 }
@@ -2264,4 +3861,85 @@ double FieldStats::calc_shotnoise_aliasing_pcs(int i, int j, int k) {
     * (1. - 4./3. * cz2 + 2./5. * cz2 * cz2 - 4./315. * cz2 * cz2 * cz2);
 }
 
+
+/// **********************************************************************
+/// Explicit instantiations
+/// **********************************************************************
+
+/// Instantiate the line-of-sight-templated functions for each
+/// line-of-sight policy in @ref dataobjs.hpp.
+
+template void MeshField::compute_ylm_wgtd_field<StoredLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, StoredLineOfSight, StoredLineOfSight,
+  double, int, int
+);
+template void MeshField::compute_ylm_wgtd_field<StoredLineOfSight>(
+  ParticleCatalogue&, StoredLineOfSight, double, int, int
+);
+template void MeshField::add_ylm_wgtd_field<StoredLineOfSight>(
+  ParticleCatalogue&, StoredLineOfSight, double, int, int
+);
+template void MeshField::compute_ylm_wgtd_quad_field<StoredLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, StoredLineOfSight, StoredLineOfSight,
+  double, int, int
+);
+template void MeshField::compute_ylm_wgtd_quad_field<StoredLineOfSight>(
+  ParticleCatalogue&, StoredLineOfSight, double, int, int
+);
+template void MeshField::add_ylm_wgtd_quad_field<StoredLineOfSight>(
+  ParticleCatalogue&, StoredLineOfSight, double, int, int
+);
+
+template void MeshField::compute_ylm_wgtd_field<RadialLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, RadialLineOfSight, RadialLineOfSight,
+  double, int, int
+);
+template void MeshField::compute_ylm_wgtd_field<RadialLineOfSight>(
+  ParticleCatalogue&, RadialLineOfSight, double, int, int
+);
+template void MeshField::add_ylm_wgtd_field<RadialLineOfSight>(
+  ParticleCatalogue&, RadialLineOfSight, double, int, int
+);
+template void MeshField::compute_ylm_wgtd_quad_field<RadialLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, RadialLineOfSight, RadialLineOfSight,
+  double, int, int
+);
+template void MeshField::compute_ylm_wgtd_quad_field<RadialLineOfSight>(
+  ParticleCatalogue&, RadialLineOfSight, double, int, int
+);
+template void MeshField::add_ylm_wgtd_quad_field<RadialLineOfSight>(
+  ParticleCatalogue&, RadialLineOfSight, double, int, int
+);
+
+template void MeshField::compute_ylm_wgtd_field<GlobalLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, GlobalLineOfSight, GlobalLineOfSight,
+  double, int, int
+);
+template void MeshField::compute_ylm_wgtd_field<GlobalLineOfSight>(
+  ParticleCatalogue&, GlobalLineOfSight, double, int, int
+);
+template void MeshField::add_ylm_wgtd_field<GlobalLineOfSight>(
+  ParticleCatalogue&, GlobalLineOfSight, double, int, int
+);
+template void MeshField::compute_ylm_wgtd_quad_field<GlobalLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, GlobalLineOfSight, GlobalLineOfSight,
+  double, int, int
+);
+template void MeshField::compute_ylm_wgtd_quad_field<GlobalLineOfSight>(
+  ParticleCatalogue&, GlobalLineOfSight, double, int, int
+);
+template void MeshField::add_ylm_wgtd_quad_field<GlobalLineOfSight>(
+  ParticleCatalogue&, GlobalLineOfSight, double, int, int
+);
+
+template void RandomMeshCache::add_ylm_wgtd_field<StoredLineOfSight>(
+  MeshField&, ParticleCatalogue&, StoredLineOfSight, double, int, int, bool
+);
+template void RandomMeshCache::add_ylm_wgtd_field<RadialLineOfSight>(
+  MeshField&, ParticleCatalogue&, RadialLineOfSight, double, int, int, bool
+);
+template void RandomMeshCache::add_ylm_wgtd_field<GlobalLineOfSight>(
+  MeshField&, ParticleCatalogue&, GlobalLineOfSight, double, int, int, bool
+);
+
 }  // namespace trv
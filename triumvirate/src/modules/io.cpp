@@ -203,6 +203,14 @@ void print_measurement_header_to_file(
     comment_delimiter,
     params.assignment.c_str(), params.interlace.c_str()
   );
+  if (params.fold_factor > 1) {
+    std::fprintf(
+      fileptr,
+      "%s Mesh folding: factor %d, stitched at k = %.4f\n",
+      comment_delimiter,
+      params.fold_factor, params.fold_kstitch
+    );
+  }
 
   if (params.norm_convention == "particle") {
     std::fprintf(
@@ -258,6 +266,40 @@ void print_measurement_datatab_to_file(
   }
 }
 
+void print_measurement_datatab_to_file(
+  std::FILE* fileptr,
+  trv::ParameterSet& params,
+  trv::PowspecWedgeMeasurements& meas_powspec_wedges
+) {
+  /// Print data table columns.
+  std::fprintf(
+    fileptr,
+    "%s "
+    "[0] k_cen, [1] mu_cen, [2] k_eff, [3] mu_eff, [4] nmodes, "
+    "[5] Re{pkmu_raw}, [6] Im{pkmu_raw}, "
+    "[7] Re{pkmu_shot}, [8] Im{pkmu_shot}\n",
+    comment_delimiter
+  );
+
+  /// Print data table.
+  int num_wedges = params.num_bins * params.num_mu_bins;
+  for (int iwedge = 0; iwedge < num_wedges; iwedge++) {
+    std::fprintf(
+      fileptr,
+      "%.9e\t%.9e\t%.9e\t%.9e\t%10d\t% .9e\t% .9e\t% .9e\t% .9e\n",
+      meas_powspec_wedges.kbin[iwedge],
+      meas_powspec_wedges.mubin[iwedge],
+      meas_powspec_wedges.keff[iwedge],
+      meas_powspec_wedges.mueff[iwedge],
+      meas_powspec_wedges.nmodes[iwedge],
+      meas_powspec_wedges.pk_raw[iwedge].real(),
+      meas_powspec_wedges.pk_raw[iwedge].imag(),
+      meas_powspec_wedges.pk_shot[iwedge].real(),
+      meas_powspec_wedges.pk_shot[iwedge].imag()
+    );
+  }
+}
+
 void print_measurement_datatab_to_file(
   std::FILE* fileptr,
   trv::ParameterSet& params, trv::TwoPCFMeasurements& meas_2pcf
@@ -345,6 +387,41 @@ void print_measurement_datatab_to_file(
   }
 }
 
+void print_measurement_datatab_to_file(
+  std::FILE* fileptr,
+  trv::ParameterSet& params, trv::BispecTriangleMeasurements& meas_bispec
+) {
+  char multipole_str[4];
+  std::sprintf(multipole_str, "%d%d%d", params.ell1, params.ell2, params.ELL);
+
+  /// Print data table columns.
+  std::fprintf(
+    fileptr,
+    "%s "
+    "[0] k1_cen, [1] k1_eff, [2] k2_cen, [3] k2_eff, [4] k3_cen, [5] k3_eff, "
+    "[6] ntriangles, "
+    "[7] Re{bk%s_raw}, [8] Im{bk%s_raw}, "
+    "[9] Re{bk%s_shot}, [10] Im{bk%s_shot}\n",
+    comment_delimiter,
+    multipole_str, multipole_str, multipole_str, multipole_str
+  );
+
+  /// Print data table.
+  for (std::size_t itri = 0; itri < meas_bispec.ntriangles.size(); itri++) {
+    std::fprintf(
+      fileptr,
+      "%.9e\t%.9e\t%.9e\t%.9e\t%.9e\t%.9e\t%15lld\t"
+      "% .9e\t% .9e\t% .9e\t% .9e\n",
+      meas_bispec.k1bin[itri], meas_bispec.k1eff[itri],
+      meas_bispec.k2bin[itri], meas_bispec.k2eff[itri],
+      meas_bispec.k3bin[itri], meas_bispec.k3eff[itri],
+      meas_bispec.ntriangles[itri],
+      meas_bispec.bk_raw[itri].real(), meas_bispec.bk_raw[itri].imag(),
+      meas_bispec.bk_shot[itri].real(), meas_bispec.bk_shot[itri].imag()
+    );
+  }
+}
+
 void print_measurement_datatab_to_file(
   std::FILE* fileptr,
   trv::ParameterSet& params, trv::ThreePCFMeasurements& meas_3pcf
@@ -26,6 +26,10 @@
 
 #include "maths.hpp"
 
+#include <map>
+#include <mutex>
+#include <tuple>
+
 namespace trvs = trv::sys;
 
 namespace trv {
@@ -292,11 +296,117 @@ void SphericalHarmonicCalculator::store_reduced_spherical_harmonic_in_config_spa
 }
 
 
+/**
+ * @brief Get shared reduced spherical harmonics stored on a mesh grid.
+ *
+ * @param ell Degree @f$ ell @f$.
+ * @param m Order @f$ m @f$.
+ * @param boxsize Box size in each dimension.
+ * @param ngrid Grid number in each dimension.
+ * @param fourier Whether the harmonics are computed in Fourier space
+ *                (rather than configuration space).
+ * @returns Shared stored @f$ y_\ell^m f@$ values.
+ */
+static std::shared_ptr< const std::vector< std::complex<double> > >
+get_shared_reduced_spherical_harmonic(
+  const int ell, const int m,
+  const double boxsize[3], const int ngrid[3], const bool fourier
+) {
+  using YlmTable = std::vector< std::complex<double> >;
+  using YlmKey = std::tuple<
+    int, int, bool, double, double, double, int, int, int
+  >;
+
+  /// The cache only observes the tables, which are released once their
+  /// last holder is gone.  It is never destroyed, so that tables held
+  /// at exit remain valid.
+  static std::mutex cache_mutex;
+  static auto* cache = new std::map< YlmKey, std::weak_ptr<YlmTable> >;
+
+  const YlmKey key{
+    ell, m, fourier, boxsize[0], boxsize[1], boxsize[2],
+    ngrid[0], ngrid[1], ngrid[2]
+  };
+
+  std::lock_guard<std::mutex> cache_lock(cache_mutex);
+
+  std::shared_ptr<YlmTable> ylm = (*cache)[key].lock();
+  if (ylm != nullptr) {return ylm;}
+
+  const long long nmesh =
+    (long long)(ngrid[0]) * (long long)(ngrid[1]) * (long long)(ngrid[2]);
+
+  ylm = std::shared_ptr<YlmTable>(
+    new YlmTable(nmesh),
+    [nmesh](YlmTable* table) {
+      delete table;
+      trvs::count_dealloc(
+        trvs::size_in_gb< std::complex<double> >(nmesh), trvs::MEM_MODES
+      );
+    }
+  );
+  trvs::count_alloc(
+    trvs::size_in_gb< std::complex<double> >(nmesh), trvs::MEM_MODES
+  );
+
+  if (fourier) {
+    SphericalHarmonicCalculator::
+      store_reduced_spherical_harmonic_in_fourier_space(
+        ell, m, boxsize, ngrid, *ylm
+      );
+  } else {
+    SphericalHarmonicCalculator::
+      store_reduced_spherical_harmonic_in_config_space(
+        ell, m, boxsize, ngrid, *ylm
+      );
+  }
+
+  (*cache)[key] = ylm;
+
+  return ylm;
+}
+
+/// STYLE: Column limit exceeded here.
+std::shared_ptr< const std::vector< std::complex<double> > >
+SphericalHarmonicCalculator::get_reduced_spherical_harmonic_in_fourier_space(
+  const int ell, const int m,
+  const double boxsize[3], const int ngrid[3]
+) {
+  return get_shared_reduced_spherical_harmonic(
+    ell, m, boxsize, ngrid, true
+  );
+}
+
+/// STYLE: Column limit exceeded here.
+std::shared_ptr< const std::vector< std::complex<double> > >
+SphericalHarmonicCalculator::get_reduced_spherical_harmonic_in_config_space(
+  const int ell, const int m,
+  const double boxsize[3], const int ngrid[3]
+) {
+  return get_shared_reduced_spherical_harmonic(
+    ell, m, boxsize, ngrid, false
+  );
+}
+
+
 /// **********************************************************************
 /// Spherical Bessel function
 /// **********************************************************************
 
 SphericalBesselCalculator::SphericalBesselCalculator(const int ell) {
+  /// Initialise the accelerator.
+  this->accel = gsl_interp_accel_alloc();
+
+  /// Reuse the interpolation scheme of any live calculator of the same
+  /// order.  The cache only observes the schemes and is never destroyed.
+  static std::mutex cache_mutex;
+  static auto* cache = new std::map< int, std::weak_ptr<gsl_spline> >;
+
+  std::lock_guard<std::mutex> cache_lock(cache_mutex);
+
+  this->spline = (*cache)[ell].lock();
+  if (this->spline != nullptr) {return;}
+
   /// Set up sampling range and number.
   /// CAVEAT: Discretionary choices such that max(kr) > 4096π, Δ(kr) = 0.01.
   const double xmin = 0.;       ///< minimum of interpolation range
@@ -317,27 +427,26 @@ SphericalBesselCalculator::SphericalBesselCalculator(const int ell) {
     j_ell[i] = gsl_sf_bessel_jl(ell, x[i]);
   }
 
-  /// Initialise the interpolator using cubic spline and the accelerator.
-  this->accel = gsl_interp_accel_alloc();
-  this->spline = gsl_spline_alloc(gsl_interp_cspline, nsample);
+  /// Initialise the interpolator using cubic spline.
+  this->spline = std::shared_ptr<gsl_spline>(
+    gsl_spline_alloc(gsl_interp_cspline, nsample), gsl_spline_free
+  );
 
-  gsl_spline_init(this->spline, x, j_ell, nsample);
+  gsl_spline_init(this->spline.get(), x, j_ell, nsample);
 
   delete[] x; delete[] j_ell;
+
+  (*cache)[ell] = this->spline;
 }
 
 SphericalBesselCalculator::~SphericalBesselCalculator() {
   if (this->accel != nullptr) {
     gsl_interp_accel_free(this->accel); this->accel = nullptr;
   }
-
-  if (this->spline != nullptr) {
-    gsl_spline_free(this->spline); this->spline = nullptr;
-  }
 }
 
 double SphericalBesselCalculator::eval(double x) {
-  return gsl_spline_eval(this->spline, x, this->accel);
+  return gsl_spline_eval(this->spline.get(), x, this->accel);
 }
 
 }  // namespace trv::maths
@@ -26,6 +26,13 @@
 
 #include "monitor.hpp"
 
+#include <fftw3.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif  // __unix__ || __APPLE__
+
 #ifdef TRV_EXTCALL
 #define SHOW_CPPSTATE "C++"
 #else  // !TRV_EXTCALL
@@ -40,16 +47,71 @@ namespace sys {
 /// **********************************************************************
 
 int currTask = 0;
+int numTasks = 1;
 
 double gbytesMem = 0.;
 double gbytesMaxMem = 0.;
 
+const char* memCategoryNames[NUM_MEM_CATEGORIES] = {
+  "mesh", "particles", "modes", "stats", "other"
+};
+double gbytesMemCat[NUM_MEM_CATEGORIES] = {0., 0., 0., 0., 0.};
+double gbytesMaxMemCat[NUM_MEM_CATEGORIES] = {0., 0., 0., 0., 0.};
+
 auto clockStart = std::chrono::steady_clock::now();  ///< program
                                                      ///< starting time
 
 Logger logger(NSET);
 
+std::mutex monitorMutex;  ///< mutex guarding memory-usage and profiling
+                          ///< state shared across threads
+std::mutex loggerMutex;   ///< mutex serialising log emission
+
+void init_tasks(int* argc, char*** argv) {
+#ifdef TRV_USE_MPI
+  /// MPI calls are only made from the main thread, while OpenMP and
+  /// other threads (e.g. catalogue prefetching) run alongside.
+  int thread_support;
+  MPI_Init_thread(argc, argv, MPI_THREAD_FUNNELED, &thread_support);
+  MPI_Comm_rank(MPI_COMM_WORLD, &trv::sys::currTask);
+  MPI_Comm_size(MPI_COMM_WORLD, &trv::sys::numTasks);
+
+  if (thread_support < MPI_THREAD_FUNNELED) {
+    if (trv::sys::currTask == 0) {
+      logger.error(
+        "MPI implementation does not support funnelled threads "
+        "(provided thread support level: %d).", thread_support
+      );
+    }
+    MPI_Abort(MPI_COMM_WORLD, 1);
+  }
+#endif  // TRV_USE_MPI
+}
+
+void finalise_tasks() {
+#ifdef TRV_USE_MPI
+  MPI_Finalize();
+#endif  // TRV_USE_MPI
+}
+
+void sum_across_tasks(double* values, int num) {
+#ifdef TRV_USE_MPI
+  MPI_Allreduce(
+    MPI_IN_PLACE, values, num, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD
+  );
+#endif  // TRV_USE_MPI
+}
+
+void sum_across_tasks(int* values, int num) {
+#ifdef TRV_USE_MPI
+  MPI_Allreduce(
+    MPI_IN_PLACE, values, num, MPI_INT, MPI_SUM, MPI_COMM_WORLD
+  );
+#endif  // TRV_USE_MPI
+}
+
 void update_maxmem() {
+  std::lock_guard<std::mutex> monitor_lock(monitorMutex);
   trv::sys::gbytesMaxMem = (trv::sys::gbytesMem > trv::sys::gbytesMaxMem) ?
     trv::sys::gbytesMem : trv::sys::gbytesMaxMem;
 }
@@ -117,6 +179,314 @@ std::string show_timestamp() {
   return timestamp;
 }
 
+/// **********************************************************************
+/// Program profiling
+/// **********************************************************************
+
+bool profileOn = false;
+
+/// Profile node of a stage nested under its parent stage.
+struct ProfileNode {
+  std::string label;   ///< stage label
+  int parent;          ///< parent node index (-1 for the root)
+  long long ncalls;    ///< number of calls
+  double time_total;   ///< total wall-clock time (in seconds)
+  double time_nested;  ///< wall-clock time in nested stages (in seconds)
+  double gbytes_peak;  ///< peak tracked memory usage (in gibibytes)
+  double gbytes_rss_peak;  ///< peak sampled resident set size
+                           ///< (in gibibytes)
+};
+
+std::vector<ProfileNode> profileNodes;  ///< profile nodes (with the root
+                                        ///< node first)
+int profileNodeCurr = 0;                ///< index of the current node
+std::vector<std::pair<std::string, double>> profileQuantities;
+                                        ///< recorded quantities
+auto profileStart = std::chrono::steady_clock::now();  ///< profiling
+                                                       ///< starting time
+std::thread::id profileThread;  ///< profiled thread
+
+void enable_profiling() {
+  std::lock_guard<std::mutex> monitor_lock(monitorMutex);
+
+  profileNodes.clear();
+  profileNodes.push_back(
+    ProfileNode{"program", -1, 1, 0., 0., gbytesMem, get_rss_in_gb()}
+  );
+  profileNodeCurr = 0;
+  profileQuantities.clear();
+  profileStart = std::chrono::steady_clock::now();
+  profileThread = std::this_thread::get_id();
+
+  /// Restart the peak memory usage from the current usage.
+  gbytesMaxMem = gbytesMem;
+  for (int icat = 0; icat < NUM_MEM_CATEGORIES; icat++) {
+    gbytesMaxMemCat[icat] = gbytesMemCat[icat];
+  }
+
+  profileOn = true;
+}
+
+void record_profile_quantity(const std::string& name, double value) {
+  std::lock_guard<std::mutex> monitor_lock(monitorMutex);
+
+  for (auto& quantity : profileQuantities) {
+    if (quantity.first == name) {
+      quantity.second = value;
+      return;
+    }
+  }
+  profileQuantities.push_back(std::make_pair(name, value));
+}
+
+void print_profile_node(std::FILE* fileptr, int node, int depth) {
+  const ProfileNode& pnode = profileNodes[node];
+  std::string indent(2 * depth, ' ');
+
+  std::fprintf(
+    fileptr,
+    "%s{\"label\": \"%s\", \"calls\": %lld, "
+    "\"total_time\": %.6f, \"self_time\": %.6f, "
+    "\"peak_memory_gb\": %.6f, \"peak_rss_gb\": %.6f, \"children\": [",
+    indent.c_str(), pnode.label.c_str(), pnode.ncalls,
+    pnode.time_total, pnode.time_total - pnode.time_nested,
+    pnode.gbytes_peak, pnode.gbytes_rss_peak
+  );
+
+  bool first = true;
+  for (int child = node + 1; child < int(profileNodes.size()); child++) {
+    if (profileNodes[child].parent != node) {continue;}
+    std::fprintf(fileptr, first ? "\n" : ",\n");
+    print_profile_node(fileptr, child, depth + 1);
+    first = false;
+  }
+
+  if (first) {
+    std::fprintf(fileptr, "]}");
+  } else {
+    std::fprintf(fileptr, "\n%s]}", indent.c_str());
+  }
+}
+
+void print_profile(std::FILE* fileptr, int depth) {
+  if (!profileOn) {return;}
+
+  std::lock_guard<std::mutex> monitor_lock(monitorMutex);
+
+  /// Close the root node, whose nested time is the sum over the
+  /// top-level stages.
+  ProfileNode& root = profileNodes[0];
+  root.time_total = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - profileStart
+  ).count();
+  root.time_nested = 0.;
+  root.gbytes_rss_peak = std::max(root.gbytes_rss_peak, get_rss_in_gb());
+  for (int node = 1; node < int(profileNodes.size()); node++) {
+    if (profileNodes[node].parent == 0) {
+      root.time_nested += profileNodes[node].time_total;
+    }
+  }
+
+  int nthreads = 1;
+#ifdef TRV_USE_OMP
+  nthreads = omp_get_max_threads();
+#endif  // TRV_USE_OMP
+
+  std::string indent_str(2 * depth, ' ');
+  const char* indent = indent_str.c_str();
+
+  std::fprintf(fileptr, "{\n");
+  std::fprintf(
+    fileptr, "%s  \"timestamp\": \"%s\",\n",
+    indent, show_current_datetime().c_str()
+  );
+  std::fprintf(fileptr, "%s  \"num_tasks\": %d,\n", indent, numTasks);
+  std::fprintf(fileptr, "%s  \"num_threads\": %d,\n", indent, nthreads);
+  std::fprintf(
+    fileptr, "%s  \"wall_time\": %.6f,\n", indent, root.time_total
+  );
+  std::fprintf(
+    fileptr, "%s  \"peak_memory_gb\": %.6f,\n", indent, gbytesMaxMem
+  );
+  std::fprintf(
+    fileptr, "%s  \"peak_rss_gb\": %.6f,\n",
+    indent, std::max(get_peak_rss_in_gb(), root.gbytes_rss_peak)
+  );
+
+  std::fprintf(fileptr, "%s  \"peak_memory_gb_by_category\": {", indent);
+  for (int icat = 0; icat < NUM_MEM_CATEGORIES; icat++) {
+    std::fprintf(
+      fileptr, "%s\n%s    \"%s\": %.6f", (icat == 0) ? "" : ",",
+      indent, memCategoryNames[icat], gbytesMaxMemCat[icat]
+    );
+  }
+  std::fprintf(fileptr, "\n%s  },\n", indent);
+
+  std::fprintf(fileptr, "%s  \"quantities\": {", indent);
+  for (int iq = 0; iq < int(profileQuantities.size()); iq++) {
+    std::fprintf(
+      fileptr, "%s\n%s    \"%s\": %.17g", (iq == 0) ? "" : ",",
+      indent, profileQuantities[iq].first.c_str(),
+      profileQuantities[iq].second
+    );
+  }
+  if (profileQuantities.empty()) {
+    std::fprintf(fileptr, "},\n");
+  } else {
+    std::fprintf(fileptr, "\n%s  },\n", indent);
+  }
+
+  std::fprintf(fileptr, "%s  \"stages\":\n", indent);
+  print_profile_node(fileptr, 0, depth + 1);
+  std::fprintf(fileptr, "\n%s}", indent);
+}
+
+int write_profile_to_file(const std::string& filepath) {
+  if (!profileOn) {return 1;}
+
+  std::FILE* fileptr = std::fopen(filepath.c_str(), "w");
+  if (fileptr == nullptr) {return 1;}
+
+  print_profile(fileptr);
+  std::fprintf(fileptr, "\n");
+
+  std::fclose(fileptr);
+
+  return 0;
+}
+
+StageTimer::StageTimer(const char* label) {
+  this->node = -1;
+  if (!profileOn) {return;}
+#ifdef TRV_USE_OMP
+  if (omp_in_parallel()) {return;}
+#endif  // TRV_USE_OMP
+  if (std::this_thread::get_id() != profileThread) {return;}
+
+  std::lock_guard<std::mutex> monitor_lock(monitorMutex);
+
+  /// Find or create the node under the current one.
+  int node_found = -1;
+  for (int node = profileNodeCurr + 1; node < int(profileNodes.size());
+       node++) {
+    if (profileNodes[node].parent == profileNodeCurr
+        && profileNodes[node].label == label) {
+      node_found = node;
+      break;
+    }
+  }
+  if (node_found < 0) {
+    profileNodes.push_back(
+      ProfileNode{label, profileNodeCurr, 0, 0., 0., 0., 0.}
+    );
+    node_found = int(profileNodes.size()) - 1;
+  }
+
+  ProfileNode& pnode = profileNodes[node_found];
+  pnode.gbytes_peak = std::max(pnode.gbytes_peak, gbytesMem);
+  pnode.gbytes_rss_peak = std::max(pnode.gbytes_rss_peak, get_rss_in_gb());
+
+  profileNodeCurr = node_found;
+  this->node = node_found;
+  this->tstart = std::chrono::steady_clock::now();
+}
+
+StageTimer::~StageTimer() {this->stop();}
+
+void StageTimer::stop() {
+  if (this->node < 0) {return;}
+
+  double elapsed = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - this->tstart
+  ).count();
+
+  std::lock_guard<std::mutex> monitor_lock(monitorMutex);
+
+  ProfileNode& pnode = profileNodes[this->node];
+  pnode.ncalls++;
+  pnode.time_total += elapsed;
+
+  /// Propagate the sampled resident set size to enclosing stages (the
+  /// tracked memory peaks are propagated on allocation).
+  double gbytes_rss = get_rss_in_gb();
+  for (int node = this->node; node >= 0; node = profileNodes[node].parent) {
+    profileNodes[node].gbytes_rss_peak =
+      std::max(profileNodes[node].gbytes_rss_peak, gbytes_rss);
+  }
+  if (pnode.parent > 0) {
+    profileNodes[pnode.parent].time_nested += elapsed;
+  }
+
+  profileNodeCurr = pnode.parent;
+  this->node = -1;
+}
+
+void count_alloc(double gbytes, MemoryCategory category) {
+  /// The lock (rather than an OpenMP critical section) also guards
+  /// against threads outside OpenMP, e.g. concurrent measurements.
+  std::lock_guard<std::mutex> monitor_lock(monitorMutex);
+
+  gbytesMem += gbytes;
+  gbytesMaxMem = std::max(gbytesMaxMem, gbytesMem);
+
+  gbytesMemCat[category] += gbytes;
+  gbytesMaxMemCat[category] =
+    std::max(gbytesMaxMemCat[category], gbytesMemCat[category]);
+
+  /// Propagate the peak to the current stage and those enclosing it.
+  if (profileOn) {
+    for (int node = profileNodeCurr; node >= 0;
+         node = profileNodes[node].parent) {
+      profileNodes[node].gbytes_peak =
+        std::max(profileNodes[node].gbytes_peak, gbytesMem);
+    }
+  }
+}
+
+void count_dealloc(double gbytes, MemoryCategory category) {
+  std::lock_guard<std::mutex> monitor_lock(monitorMutex);
+
+  gbytesMem -= gbytes;
+  gbytesMemCat[category] -= gbytes;
+}
+
+double get_rss_in_gb() {
+  const double BYTES_PER_GBYTES = 1073741824.;  // 1024³ bytes per gibibyte
+#if defined(__linux__)
+  /// Read the number of resident pages.
+  long long npages_total = 0, npages_rss = 0;
+  std::FILE* statm = std::fopen("/proc/self/statm", "r");
+  if (statm == nullptr) {return 0.;}
+  if (std::fscanf(statm, "%lld %lld", &npages_total, &npages_rss) != 2) {
+    npages_rss = 0;
+  }
+  std::fclose(statm);
+
+  return double(npages_rss) * double(sysconf(_SC_PAGESIZE))
+    / BYTES_PER_GBYTES;
+#else  // !__linux__
+  /// The peak is the best available sample elsewhere.
+  (void) BYTES_PER_GBYTES;
+  return get_peak_rss_in_gb();
+#endif  // __linux__
+}
+
+double get_peak_rss_in_gb() {
+  const double BYTES_PER_GBYTES = 1073741824.;  // 1024³ bytes per gibibyte
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {return 0.;}
+#if defined(__APPLE__)
+  return double(usage.ru_maxrss) / BYTES_PER_GBYTES;  // in bytes
+#else  // !__APPLE__
+  return double(usage.ru_maxrss) * 1024. / BYTES_PER_GBYTES;  // in KiB
+#endif  // __APPLE__
+#else  // !__unix__ && !__APPLE__
+  (void) BYTES_PER_GBYTES;
+  return 0.;
+#endif  // __unix__ || __APPLE__
+}
+
 Logger::Logger(LogLevel level) {
   Logger::reset_level(level);
 }
@@ -136,8 +506,15 @@ void Logger::reset_level(int level) {
 void Logger::emit(
   std::string log_type, const char* fmt_string, std::va_list args
 ) {
+  /// Only the root task emits messages to avoid duplicates.
+  if (trv::sys::currTask != 0) {return;}
+
   char log_mesg_buf[4096];
-  std::vsprintf(log_mesg_buf, fmt_string, args);
+  std::vsnprintf(log_mesg_buf, sizeof(log_mesg_buf), fmt_string, args);
+
+  /// Serialise emission from multiple threads, which also guards
+  /// the static storage used in formatting the timestamp.
+  std::lock_guard<std::mutex> logger_lock(loggerMutex);
 
   std::printf(
     "[%s %s %s] %s\n",
@@ -243,6 +620,36 @@ void Logger::error(const char* fmt_string, ...) {
 }
 
 
+/// **********************************************************************
+/// FFTW state
+/// **********************************************************************
+
+std::once_flag fftwInitFlag;  ///< FFTW initialisation flag
+std::mutex fftwPlannerMutex;  ///< FFTW planner mutex
+
+void init_fftw() {
+  std::call_once(fftwInitFlag, []() {
+#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
+    fftw_init_threads();
+#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+  });
+}
+
+void finalise_fftw() {
+  std::lock_guard<std::mutex> planner_lock(fftwPlannerMutex);
+#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
+  fftw_cleanup_threads();
+#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
+  fftw_cleanup();
+#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+}
+
+std::unique_lock<std::mutex> lock_fftw_planner() {
+  init_fftw();
+  return std::unique_lock<std::mutex>(fftwPlannerMutex);
+}
+
+
 /// **********************************************************************
 /// Program exceptions
 /// **********************************************************************
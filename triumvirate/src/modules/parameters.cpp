@@ -47,6 +47,8 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
   char rand_catalogue_file_[1024];
   char catalogue_columns_[1024];
   char output_tag_[1024];
+  char profile_[16] = "false";
+  char random_cache_dir_[1024] = "";
 
   double boxsize_x, boxsize_y, boxsize_z;
   int ngrid_x, ngrid_y, ngrid_z;
@@ -103,6 +105,15 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
     scan_par_str("catalogue_columns", "%s %s %s", catalogue_columns_);
     scan_par_str("output_tag", "%s %s %s", output_tag_);
 
+    if (line_str.find("chunk_size") != std::string::npos) {
+      std::sscanf(
+        line_str.data(), "%s %s %d", dummy_str, dummy_equal, &this->chunk_size
+      );
+    }
+
+    scan_par_str("profile", "%s %s %s", profile_);
+    scan_par_str("random_cache_dir", "%s %s %s", random_cache_dir_);
+
     /// Mesh sampling ----------------------------------------------------
 
     if (line_str.find("boxsize_x") != std::string::npos) {
@@ -172,6 +183,17 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
         line_str.data(), "%s %s %d", dummy_str, dummy_equal, &this->ELL
       );
     }
+    if (line_str.find("multipoles") != std::string::npos) {
+      /// Parse a comma- and/or space-separated list of degrees.
+      std::string list_str = line_str.substr(line_str.find("=") + 1);
+      std::replace(list_str.begin(), list_str.end(), ',', ' ');
+      std::istringstream list_sstream(list_str);
+      this->multipoles.clear();
+      int ell_;
+      while (list_sstream >> ell_) {
+        this->multipoles.push_back(ell_);
+      }
+    }
 
     if (line_str.find("i_wa") != std::string::npos) {
       std::sscanf(
@@ -205,6 +227,38 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
         line_str.data(), "%s %s %d", dummy_str, dummy_equal, &this->idx_bin
       );
     }
+    if (line_str.find("num_mu_bins") != std::string::npos) {
+      std::sscanf(
+        line_str.data(), "%s %s %d",
+        dummy_str, dummy_equal, &this->num_mu_bins
+      );
+    }
+
+    if (line_str.find("subsample_kmin") != std::string::npos) {
+      std::sscanf(
+        line_str.data(), "%s %s %lg",
+        dummy_str, dummy_equal, &this->subsample_kmin
+      );
+    }
+    if (line_str.find("subsample_frac") != std::string::npos) {
+      std::sscanf(
+        line_str.data(), "%s %s %lg",
+        dummy_str, dummy_equal, &this->subsample_frac
+      );
+    }
+
+    if (line_str.find("fold_factor") != std::string::npos) {
+      std::sscanf(
+        line_str.data(), "%s %s %d",
+        dummy_str, dummy_equal, &this->fold_factor
+      );
+    }
+    if (line_str.find("fold_kstitch") != std::string::npos) {
+      std::sscanf(
+        line_str.data(), "%s %s %lg",
+        dummy_str, dummy_equal, &this->fold_kstitch
+      );
+    }
   }
 
   /// Misc ---------------------------------------------------------------
@@ -228,6 +282,8 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
   this->rand_catalogue_file = rand_catalogue_file_;
   this->catalogue_columns = catalogue_columns_;
   this->output_tag = output_tag_;
+  this->profile = profile_;
+  this->random_cache_dir = random_cache_dir_;
 
   this->alignment = alignment_;
   this->padscale = padscale_;
@@ -275,6 +331,8 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
   debug_par_str("rand_catalogue_file", this->rand_catalogue_file);
   debug_par_str("catalogue_columns", this->catalogue_columns);
   debug_par_str("output_tag", this->output_tag);
+  debug_par_str("profile", this->profile);
+  debug_par_str("random_cache_dir", this->random_cache_dir);
 
   debug_par_str("alignment", this->alignment);
   debug_par_str("padscale", this->padscale);
@@ -287,6 +345,8 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
   debug_par_str("binning", this->binning);
   debug_par_str("form", this->form);
 
+  debug_par_int("chunk_size", this->chunk_size);
+
   debug_par_int("ngrid[0]", this->ngrid[0]);
   debug_par_int("ngrid[1]", this->ngrid[1]);
   debug_par_int("ngrid[2]", this->ngrid[2]);
@@ -300,6 +360,8 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
 
   debug_par_int("num_bins", this->num_bins);
   debug_par_int("idx_bin", this->idx_bin);
+  debug_par_int("num_mu_bins", this->num_mu_bins);
+  debug_par_int("fold_factor", this->fold_factor);
 
   debug_par_double("boxsize[0]", this->boxsize[0]);
   debug_par_double("boxsize[1]", this->boxsize[1]);
@@ -308,6 +370,9 @@ int ParameterSet::read_from_file(char* parameter_filepath) {
   debug_par_double("padfactor", this->padfactor);
   debug_par_double("bin_min", this->bin_min);
   debug_par_double("bin_max", this->bin_max);
+  debug_par_double("subsample_kmin", this->subsample_kmin);
+  debug_par_double("subsample_frac", this->subsample_frac);
+  debug_par_double("fold_kstitch", this->fold_kstitch);
 #endif  // DBG_PARS
 
   return this->validate();
@@ -318,8 +383,46 @@ int ParameterSet::validate() {
   if (this->catalogue_dir != "") {
     this->catalogue_dir += "/";  // transmutation
   }  // any duplicate '/' has no effect
+  /// Expand any comma-separated list and glob patterns of data catalogue
+  /// files for batch mode (with glob matches in sorted order).
+  auto expand_data_catalogue_files = [this]() {
+    this->data_catalogue_files.clear();
+
+    std::stringstream spec_ss(this->data_catalogue_file);
+    std::string pattern;
+    while (std::getline(spec_ss, pattern, ',')) {
+      if (pattern.empty()) {continue;}
+      pattern = this->catalogue_dir + pattern;
+
+      if (pattern.find_first_of("*?[") == std::string::npos) {
+        this->data_catalogue_files.push_back(pattern);
+        continue;
+      }
+
+      glob_t glob_matches;
+      if (glob(pattern.c_str(), 0, nullptr, &glob_matches) == 0) {
+        for (std::size_t imatch = 0; imatch < glob_matches.gl_pathc; imatch++) {
+          this->data_catalogue_files.push_back(glob_matches.gl_pathv[imatch]);
+        }
+      } else {
+        if (trvs::currTask == 0) {
+          trvs::logger.error(
+            "No data catalogue file matches the pattern: '%s'.",
+            pattern.c_str()
+          );
+          throw trvs::InvalidParameter(
+            "No data catalogue file matches the pattern: '%s'.\n",
+            pattern.c_str()
+          );
+        }
+      }
+      globfree(&glob_matches);
+    }
+  };
+
   if (this->catalogue_type == "survey") {
     if (this->data_catalogue_file != "") {
+      expand_data_catalogue_files();
       this->data_catalogue_file = this->catalogue_dir
         + this->data_catalogue_file;  // transmutation
     }
@@ -337,6 +440,7 @@ int ParameterSet::validate() {
   } else
   if (this->catalogue_type == "sim") {
     if (this->data_catalogue_file != "") {
+      expand_data_catalogue_files();
       this->data_catalogue_file = this->catalogue_dir
         + this->data_catalogue_file;  // transmutation
     }
@@ -420,6 +524,26 @@ int ParameterSet::validate() {
     }
   }
 
+  if (this->profile == "true" || this->profile == "on") {
+    this->profile = "true";  // transmutation
+  } else
+  if (this->profile == "false" || this->profile == "off") {
+    this->profile = "false";  // transmutation
+  } else {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Profiling must be 'true'/'on' or 'false'/'off': "
+        "`profile` = '%s'.",
+        this->profile.c_str()
+      );
+      throw trvs::InvalidParameter(
+        "Profiling must be 'true'/'on' or 'false'/'off': "
+        "`profile` = '%s'.\n",
+        this->profile.c_str()
+      );
+    }
+  }
+
   if (this->statistic_type == "powspec") {
     this->npoint = "2pt"; this->space = "fourier";  // derivation
   } else
@@ -483,14 +607,16 @@ int ParameterSet::validate() {
       );
     }
   }
-  if (!(this->form == "diag" || this->form == "full")) {
+  if (!(
+    this->form == "diag" || this->form == "full" || this->form == "triangle"
+  )) {
     if (trvs::currTask == 0) {
       trvs::logger.error(
-        "`form` must be either 'full' or 'diag': `form` = '%s'.",
+        "`form` must be 'full', 'diag' or 'triangle': `form` = '%s'.",
         this->form.c_str()
       );
       throw trvs::InvalidParameter(
-        "`form` must be either 'full' or 'diag': `form` = '%s'.\n",
+        "`form` must be 'full', 'diag' or 'triangle': `form` = '%s'.\n",
         this->form.c_str()
       );
     }
@@ -596,6 +722,15 @@ int ParameterSet::validate() {
     }
   }
 
+  if (this->chunk_size < 0) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error("Streaming chunk size `chunk_size` must be >= 0.");
+      throw trvs::InvalidParameter(
+        "Streaming chunk size `chunk_size` must be >= 0.\n"
+      );
+    }
+  }
+
   if (this->num_bins < 2) {
     if (trvs::currTask == 0) {
       trvs::logger.error("Number of bins `num_bins` must be >= 2.");
@@ -611,6 +746,24 @@ int ParameterSet::validate() {
   }
 
   /// Check for parameter conflicts.
+  if (this->form == "triangle" && this->npoint == "3pt" && !(
+    this->statistic_type == "bispec" && this->catalogue_type == "sim"
+    && this->ell1 == 0 && this->ell2 == 0 && this->ELL == 0
+  )) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "The 'triangle' form is only supported for the bispectrum monopole "
+        "(ell1 = ell2 = ELL = 0) from simulation-type catalogues "
+        "in a periodic box."
+      );
+      throw trvs::InvalidParameter(
+        "The 'triangle' form is only supported for the bispectrum monopole "
+        "(ell1 = ell2 = ELL = 0) from simulation-type catalogues "
+        "in a periodic box.\n"
+      );
+    }
+  }
+
   if (this->binning == "linpad" || this->binning == "logpad") {
     /// SEE: See @ref trv::Binning.
     int nbin_pad = 5;
@@ -640,6 +793,146 @@ int ParameterSet::validate() {
     }
   }
 
+  if (this->chunk_size > 0 && !(
+    this->catalogue_type == "survey"
+    && (this->statistic_type == "powspec" || this->statistic_type == "2pcf")
+  )) {
+    this->chunk_size = 0;  // transmutation
+
+    if (trvs::currTask == 0) {
+      trvs::logger.warn(
+        "Catalogue streaming is only supported for power spectrum and "
+        "two-point correlation function measurements from survey-type "
+        "catalogues. `chunk_size` is set to 0."
+      );
+    }
+  }
+
+  if (!this->random_cache_dir.empty()
+      && (this->catalogue_type != "survey" || this->chunk_size > 0)) {
+    this->random_cache_dir = "";  // transmutation
+
+    if (trvs::currTask == 0) {
+      trvs::logger.warn(
+        "Random mesh caching is only supported for unstreamed survey-type "
+        "catalogues. `random_cache_dir` is unset."
+      );
+    }
+  }
+
+  if (!this->multipoles.empty()) {
+    if (this->statistic_type != "powspec") {
+      if (trvs::currTask == 0) {
+        trvs::logger.error(
+          "Multiple multipoles `multipoles` are only supported for "
+          "power spectrum measurements."
+        );
+        throw trvs::InvalidParameter(
+          "Multiple multipoles `multipoles` are only supported for "
+          "power spectrum measurements.\n"
+        );
+      }
+    }
+    for (int ell_ : this->multipoles) {
+      if (ell_ < 0) {
+        if (trvs::currTask == 0) {
+          trvs::logger.error(
+            "Multipole degrees in `multipoles` must be non-negative."
+          );
+          throw trvs::InvalidParameter(
+            "Multipole degrees in `multipoles` must be non-negative.\n"
+          );
+        }
+      }
+    }
+  }
+
+  if (this->num_mu_bins < 0) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Number of wedge bins `num_mu_bins` must be non-negative."
+      );
+      throw trvs::InvalidParameter(
+        "Number of wedge bins `num_mu_bins` must be non-negative.\n"
+      );
+    }
+  }
+
+  if (this->num_mu_bins > 0 && !(
+    (this->catalogue_type == "sim" || this->catalogue_type == "survey")
+    && this->statistic_type == "powspec"
+  )) {
+    this->num_mu_bins = 0;  // transmutation
+
+    if (trvs::currTask == 0) {
+      trvs::logger.warn(
+        "Power spectrum wedges are only supported for power spectrum "
+        "measurements from simulation- or survey-type catalogues. "
+        "`num_mu_bins` is set to 0."
+      );
+    }
+  }
+
+  if (!(0. < this->subsample_frac && this->subsample_frac <= 1.)) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Mode subsampling fraction `subsample_frac` must be in (0, 1]."
+      );
+      throw trvs::InvalidParameter(
+        "Mode subsampling fraction `subsample_frac` must be in (0, 1].\n"
+      );
+    }
+  }
+
+  if (this->subsample_frac < 1. && this->space != "fourier") {
+    this->subsample_frac = 1.;  // transmutation
+
+    if (trvs::currTask == 0) {
+      trvs::logger.warn(
+        "Mode subsampling is only supported for Fourier-space "
+        "measurements. `subsample_frac` is set to 1."
+      );
+    }
+  }
+
+  if (this->fold_factor < 1) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Mesh folding factor `fold_factor` must be positive."
+      );
+      throw trvs::InvalidParameter(
+        "Mesh folding factor `fold_factor` must be positive.\n"
+      );
+    }
+  }
+
+  if (this->fold_factor > 1 && !(
+    this->catalogue_type == "sim" && this->space == "fourier"
+  )) {
+    this->fold_factor = 1;  // transmutation
+
+    if (trvs::currTask == 0) {
+      trvs::logger.warn(
+        "Mesh folding is only supported for Fourier-space measurements "
+        "from simulation-type catalogues in a periodic box. "
+        "`fold_factor` is set to 1."
+      );
+    }
+  }
+
+  if (
+    this->fold_factor > 1 && this->npoint == "3pt" && this->form == "triangle"
+  ) {
+    this->fold_factor = 1;  // transmutation
+
+    if (trvs::currTask == 0) {
+      trvs::logger.warn(
+        "Mesh folding is unsupported for all-triangle bispectrum "
+        "measurements. `fold_factor` is set to 1."
+      );
+    }
+  }
+
   if (this->npoint == "3pt" && this->interlace == "true") {
     this->interlace = "false";  // transmutation
 
@@ -651,6 +944,19 @@ int ParameterSet::validate() {
     }
   }
 
+  if (this->npoint == "3pt" && trvs::numTasks > 1) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Three-point measurements are unsupported for multi-task runs "
+        "with slab-decomposed meshes."
+      );
+      throw trvs::InvalidParameter(
+        "Three-point measurements are unsupported for multi-task runs "
+        "with slab-decomposed meshes.\n"
+      );
+    }
+  }
+
   if (trvs::currTask == 0) {
     trvs::logger.stat("Parameters validated.");
   }
@@ -692,6 +998,9 @@ int ParameterSet::print_to_file(char* out_parameter_filepath) {
   print_par_str("rand_catalogue_file = %s\n", this->rand_catalogue_file);
   print_par_str("catalogue_columns = %s\n", this->catalogue_columns);
   print_par_str("output_tag = %s\n", this->output_tag);
+  print_par_int("chunk_size = %d\n", this->chunk_size);
+  print_par_str("profile = %s\n", this->profile);
+  print_par_str("random_cache_dir = %s\n", this->random_cache_dir);
 
   print_par_double("boxsize_x = %.2f\n", this->boxsize[0]);
   print_par_double("boxsize_y = %.2f\n", this->boxsize[1]);
@@ -724,6 +1033,14 @@ int ParameterSet::print_to_file(char* out_parameter_filepath) {
   print_par_int("ell1 = %d\n", this->ell1);
   print_par_int("ell2 = %d\n", this->ell2);
   print_par_int("ELL = %d\n", this->ELL);
+  if (!this->multipoles.empty()) {
+    std::string multipoles_str;
+    for (int ell_ : this->multipoles) {
+      if (!multipoles_str.empty()) {multipoles_str += ",";}
+      multipoles_str += std::to_string(ell_);
+    }
+    print_par_str("multipoles = %s\n", multipoles_str);
+  }
 
   print_par_int("i_wa = %d\n", this->i_wa);
   print_par_int("j_wa = %d\n", this->j_wa);
@@ -732,6 +1049,11 @@ int ParameterSet::print_to_file(char* out_parameter_filepath) {
   print_par_double("bin_max = %.4f\n", this->bin_max);
   print_par_int("num_bins = %d\n", this->num_bins);
   print_par_int("idx_bin = %d\n", this->idx_bin);
+  print_par_int("num_mu_bins = %d\n", this->num_mu_bins);
+  print_par_double("subsample_kmin = %.4f\n", this->subsample_kmin);
+  print_par_double("subsample_frac = %.4f\n", this->subsample_frac);
+  print_par_int("fold_factor = %d\n", this->fold_factor);
+  print_par_double("fold_kstitch = %.4f\n", this->fold_kstitch);
 
   print_par_int("verbose = %d\n", this->verbose);
 
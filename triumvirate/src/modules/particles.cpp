@@ -30,6 +30,336 @@ namespace trvs = trv::sys;
 
 namespace trv {
 
+/// **********************************************************************
+/// Catalogue file reader
+/// **********************************************************************
+
+CatalogueFileReader::CatalogueFileReader(const std::string& filepath) {
+  this->filepath = filepath;
+  this->compression = CatalogueFileReader::detect_compression(filepath);
+
+  /// Use blocks large enough to amortise locking but small enough to
+  /// bound the memory held by the queue.
+  this->block_size = 1 << 22;  // 4 MiB
+  this->max_queued_blocks = 4;
+
+  this->open();
+}
+
+CatalogueFileReader::~CatalogueFileReader() {
+  this->close();
+}
+
+std::string CatalogueFileReader::detect_compression(
+  const std::string& filepath
+) {
+  unsigned char magic[4] = {0, 0, 0, 0};
+
+  std::FILE* fileptr = std::fopen(filepath.c_str(), "rb");
+  if (fileptr == nullptr) {return "none";}
+  std::size_t nbytes = std::fread(magic, 1, 4, fileptr);
+  std::fclose(fileptr);
+
+  if (nbytes >= 2 && magic[0] == 0x1F && magic[1] == 0x8B) {
+    return "gzip";
+  }
+  if (
+    nbytes == 4
+    && magic[0] == 0x28 && magic[1] == 0xB5
+    && magic[2] == 0x2F && magic[3] == 0xFD
+  ) {
+    return "zstd";
+  }
+
+  return "none";
+}
+
+void CatalogueFileReader::open() {
+  this->block.clear();
+  this->block_pos = 0;
+
+  if (this->compression == "none") {
+    this->fin.open(this->filepath.c_str(), std::ios::in);
+
+    if (this->fin.fail()) {
+      this->fin.close();
+      if (trvs::currTask == 0) {
+        trvs::logger.error("Failed to open file '%s'.", this->filepath.c_str());
+      }
+      throw trvs::IOError(
+        "Failed to open file '%s'.\n", this->filepath.c_str()
+      );
+    }
+    return;
+  }
+
+#ifndef TRV_USE_ZLIB
+  if (this->compression == "gzip") {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Gzip-compressed file '%s' is unsupported in this build "
+        "(compile with `TRV_USE_ZLIB`).",
+        this->filepath.c_str()
+      );
+    }
+    throw trvs::IOError(
+      "Gzip-compressed file '%s' is unsupported in this build "
+      "(compile with `TRV_USE_ZLIB`).\n",
+      this->filepath.c_str()
+    );
+  }
+#endif  // !TRV_USE_ZLIB
+
+#ifndef TRV_USE_ZSTD
+  if (this->compression == "zstd") {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Zstandard-compressed file '%s' is unsupported in this build "
+        "(compile with `TRV_USE_ZSTD`).",
+        this->filepath.c_str()
+      );
+    }
+    throw trvs::IOError(
+      "Zstandard-compressed file '%s' is unsupported in this build "
+      "(compile with `TRV_USE_ZSTD`).\n",
+      this->filepath.c_str()
+    );
+  }
+#endif  // !TRV_USE_ZSTD
+
+  this->block_queue.clear();
+  this->decompression_done = false;
+  this->decompression_stop = false;
+  this->decompression_error.clear();
+
+  this->decompressor = std::thread(&CatalogueFileReader::decompress, this);
+}
+
+void CatalogueFileReader::close() {
+  if (this->compression == "none") {
+    this->fin.close();
+    return;
+  }
+
+  /// Signal the decompressor to stop (which may be waiting on a full
+  /// queue) and wait for it to finish.
+  {
+    std::lock_guard<std::mutex> lock(this->queue_mutex);
+    this->decompression_stop = true;
+  }
+  this->queue_cv.notify_all();
+
+  if (this->decompressor.joinable()) {
+    this->decompressor.join();
+  }
+
+  this->block_queue.clear();
+  this->block.clear();
+  this->block_pos = 0;
+}
+
+void CatalogueFileReader::rewind() {
+  if (this->compression == "none") {
+    this->fin.clear();
+    this->fin.seekg(0, std::ios::beg);
+    return;
+  }
+
+  /// Compressed streams cannot be seeked, so restart decompression.
+  this->close();
+  this->open();
+}
+
+bool CatalogueFileReader::push_block(std::string& block_out) {
+  std::unique_lock<std::mutex> lock(this->queue_mutex);
+  this->queue_cv.wait(lock, [this] {
+    return this->decompression_stop
+      || this->block_queue.size() < this->max_queued_blocks;
+  });
+  if (this->decompression_stop) {return false;}
+
+  this->block_queue.push_back(std::move(block_out));
+  block_out.clear();
+
+  lock.unlock();
+  this->queue_cv.notify_all();
+
+  return true;
+}
+
+bool CatalogueFileReader::pop_block() {
+  std::unique_lock<std::mutex> lock(this->queue_mutex);
+  this->queue_cv.wait(lock, [this] {
+    return this->decompression_done || !this->block_queue.empty();
+  });
+
+  if (this->block_queue.empty()) {
+    /// Decompression has ended with all blocks consumed.
+    std::string err = this->decompression_error;
+    lock.unlock();
+    if (!err.empty()) {
+      if (trvs::currTask == 0) {
+        trvs::logger.error(
+          "Failed to decompress file '%s': %s.",
+          this->filepath.c_str(), err.c_str()
+        );
+        throw trvs::IOError(
+          "Failed to decompress file '%s': %s.\n",
+          this->filepath.c_str(), err.c_str()
+        );
+      }
+    }
+    return false;
+  }
+
+  this->block = std::move(this->block_queue.front());
+  this->block_queue.pop_front();
+  this->block_pos = 0;
+
+  lock.unlock();
+  this->queue_cv.notify_all();
+
+  return true;
+}
+
+void CatalogueFileReader::decompress() {
+  std::string err;
+  std::string block_out;
+
+#ifdef TRV_USE_ZLIB
+  if (this->compression == "gzip") {
+    /// Concatenated gzip members (e.g. from parallel compressors)
+    /// are read through transparently.
+    gzFile gzfile = gzopen(this->filepath.c_str(), "rb");
+    if (gzfile == nullptr) {
+      err = "cannot open gzip stream";
+    } else {
+      gzbuffer(gzfile, 1 << 18);
+
+      while (true) {
+        block_out.resize(this->block_size);
+        int nread = gzread(
+          gzfile, &block_out[0], static_cast<unsigned>(this->block_size)
+        );
+        if (nread < 0) {
+          int errnum = 0;
+          err = gzerror(gzfile, &errnum);
+          break;
+        }
+        if (nread == 0) {break;}
+
+        block_out.resize(nread);
+        if (!this->push_block(block_out)) {break;}
+      }
+
+      gzclose(gzfile);
+    }
+  }
+#endif  // TRV_USE_ZLIB
+
+#ifdef TRV_USE_ZSTD
+  if (this->compression == "zstd") {
+    std::FILE* fileptr = std::fopen(this->filepath.c_str(), "rb");
+    ZSTD_DCtx* dctx = ZSTD_createDCtx();
+    if (fileptr == nullptr || dctx == nullptr) {
+      err = "cannot open Zstandard stream";
+    } else {
+      std::vector<char> buff_in(ZSTD_DStreamInSize());
+      std::vector<char> buff_out(ZSTD_DStreamOutSize());
+
+      bool stopped = false;
+      std::size_t nread;
+      while (
+        !stopped
+        && (nread = std::fread(buff_in.data(), 1, buff_in.size(), fileptr))
+      ) {
+        ZSTD_inBuffer input = {buff_in.data(), nread, 0};
+        while (input.pos < input.size) {
+          ZSTD_outBuffer output = {buff_out.data(), buff_out.size(), 0};
+          std::size_t ret = ZSTD_decompressStream(dctx, &output, &input);
+          if (ZSTD_isError(ret)) {
+            err = ZSTD_getErrorName(ret);
+            stopped = true;
+            break;
+          }
+
+          block_out.append(buff_out.data(), output.pos);
+          if (block_out.size() >= this->block_size) {
+            if (!this->push_block(block_out)) {
+              stopped = true;
+              break;
+            }
+          }
+        }
+      }
+
+      if (!stopped && !block_out.empty()) {
+        this->push_block(block_out);
+      }
+    }
+
+    if (dctx != nullptr) {ZSTD_freeDCtx(dctx);}
+    if (fileptr != nullptr) {std::fclose(fileptr);}
+  }
+#endif  // TRV_USE_ZSTD
+
+  {
+    std::lock_guard<std::mutex> lock(this->queue_mutex);
+    this->decompression_error = err;
+    this->decompression_done = true;
+  }
+  this->queue_cv.notify_all();
+}
+
+bool CatalogueFileReader::getline(std::string& line_str) {
+  if (this->compression == "none") {
+    return bool(std::getline(this->fin, line_str));
+  }
+
+  line_str.clear();
+
+  bool read_any = false;
+  while (true) {
+    if (this->block_pos >= this->block.size()) {
+      if (!this->pop_block()) {return read_any;}
+    }
+
+    std::size_t pos_newline = this->block.find('\n', this->block_pos);
+    if (pos_newline == std::string::npos) {
+      /// Carry the partial line over to the next block.
+      line_str.append(this->block, this->block_pos, std::string::npos);
+      this->block_pos = this->block.size();
+      read_any = true;
+      continue;
+    }
+
+    line_str.append(
+      this->block, this->block_pos, pos_newline - this->block_pos
+    );
+    this->block_pos = pos_newline + 1;
+
+    return true;
+  }
+}
+
+int CatalogueFileReader::read_data_lines(
+  std::vector<std::string>& lines, int max_lines
+) {
+  /// Reuse existing line buffers to avoid reallocations between batches.
+  if (int(lines.size()) < max_lines) {lines.resize(max_lines);}
+
+  int nlines = 0;
+  while (nlines < max_lines && this->getline(lines[nlines])) {
+    /// Skip empty lines or comment lines.
+    if (lines[nlines].empty() || lines[nlines][0] == '#') {continue;}
+
+    nlines++;
+  }
+
+  return nlines;
+}
+
+
 /// **********************************************************************
 /// Life cycle
 /// **********************************************************************
@@ -42,6 +372,7 @@ ParticleCatalogue::ParticleCatalogue () {
   for (int iaxis = 0; iaxis < 3; iaxis++) {
     this->pos_min[iaxis] = 0.;
     this->pos_max[iaxis] = 0.;
+    this->pos_observer[iaxis] = 0.;
   }
 }
 
@@ -54,22 +385,30 @@ void ParticleCatalogue::initialise_particles(const int num) {
     throw trvs::InvalidParameter("Number of particles is non-positive.\n");
   }
 
-  this->ntotal = num;
-
   /// Renew particle data.
-  delete[] this->pdata; this->pdata = nullptr;
+  this->finalise_particles();
+
+  this->ntotal = num;
 
   this->pdata = new ParticleData[this->ntotal];
 
-  trvs::gbytesMem += trvs::size_in_gb<struct ParticleData>(this->ntotal);
-  trv::sys::update_maxmem();
+  /// Reset the observer to the coordinate origin.
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    this->pos_observer[iaxis] = 0.;
+  }
+
+  trvs::count_alloc(
+    trvs::size_in_gb<struct ParticleData>(this->ntotal), trvs::MEM_PARTICLES
+  );
 }
 
 void ParticleCatalogue::finalise_particles() {
   /// Free particle data.
   if (this->pdata != nullptr) {
     delete[] this->pdata; this->pdata = nullptr;
-    trvs::gbytesMem -= trvs::size_in_gb<struct ParticleData>(this->ntotal);
+    trvs::count_dealloc(
+      trvs::size_in_gb<struct ParticleData>(this->ntotal), trvs::MEM_PARTICLES
+    );
   }
 }
 
@@ -107,29 +446,8 @@ int ParticleCatalogue::load_catalogue_file(
   /// Columns & fields
   /// --------------------------------------------------------------------
 
-  /// CAVEAT: Hard-coded ordered column names.
-  const std::vector<std::string> names_ordered = {
-    "x", "y", "z", "nz", "ws", "wc"
-  };
-
-  std::istringstream iss(catalogue_columns);
-  std::vector<std::string> colnames;
-  std::string name;
-  while (std::getline(iss, name, ',')) {
-    colnames.push_back(name);
-  }
-
-  /// CAVEAT: Default -1 index as a flag for unfound column names.
-  std::vector<int> name_indices(names_ordered.size(), -1);
-  for (int iname = 0; iname < int(names_ordered.size()); iname++) {
-    std::ptrdiff_t col_idx = std::distance(
-      colnames.begin(),
-      std::find(colnames.begin(), colnames.end(), names_ordered[iname])
-    );
-    if (0 <= col_idx && col_idx < int(colnames.size())) {
-      name_indices[iname] = col_idx;
-    }
-  }
+  std::vector<int> name_indices =
+    ParticleCatalogue::get_column_indices(catalogue_columns);
 
   /// Check for the 'nz' column.
   if (name_indices[3] == -1) {
@@ -146,25 +464,12 @@ int ParticleCatalogue::load_catalogue_file(
   /// Data reading
   /// --------------------------------------------------------------------
 
-  std::ifstream fin;
-
-  fin.open(catalogue_filepath.c_str(), std::ios::in);
-
-  if (fin.fail()) {
-    fin.close();
-    if (trvs::currTask == 0) {
-      trvs::logger.error("Failed to open file '%s'.", this->source.c_str());
-      throw trvs::IOError("Failed to open file '%s'.\n", this->source.c_str());
-    }
-  }
+  CatalogueFileReader reader(catalogue_filepath);
 
   /// Initialise particle data.
   int num_lines = 0;
   std::string line_str;
-  while (std::getline(fin, line_str)) {
-    /// Terminate at the end of file.
-    if (!fin) {break;}
-
+  while (reader.getline(line_str)) {
     /// Skip empty lines or comment lines.
     if (line_str.empty() || line_str[0] == '#') {continue;}
 
@@ -172,8 +477,6 @@ int ParticleCatalogue::load_catalogue_file(
     num_lines++;
   }
 
-  fin.close();
-
   this->initialise_particles(num_lines);
 
   /// Set particle data.
@@ -182,75 +485,187 @@ int ParticleCatalogue::load_catalogue_file(
     nz_box_default = this->ntotal / volume;
   }
 
-  fin.open(catalogue_filepath.c_str(), std::ios::in);
+  reader.rewind();
+
+  /// Read data lines in batches, each parsed in parallel while the
+  /// next is being decompressed (if the file is compressed).
+  const int batch_size = 1 << 16;
+
+  std::vector<std::string> lines;
+  int idx_line = 0;  // current line number
+  int nlines;
+  while (
+    idx_line < this->ntotal
+    && (nlines = reader.read_data_lines(
+      lines, std::min(batch_size, this->ntotal - idx_line)
+    )) > 0
+  ) {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+    for (int iline = 0; iline < nlines; iline++) {
+      ParticleCatalogue::parse_catalogue_line(
+        lines[iline], name_indices, nz_box_default,
+        this->pdata[idx_line + iline]
+      );
+    }
+    idx_line += nlines;
+  }
+
+  /// --------------------------------------------------------------------
+  /// Catalogue properties
+  /// --------------------------------------------------------------------
 
-  int idx_line = 0;   // current line number
-  double nz, ws, wc;  // placeholder variables
-  double entry;       // data entry (per column per row)
-  while (std::getline(fin, line_str)) {  // std::string line_str;
-    /// Terminate at the end of file.
-    if (!fin) {break;}
+  /// Calculate systematic weight sum.
+  this->calc_wtotal();
 
-    /// Skip empty lines or comment lines.
-    if (line_str.empty() || line_str[0] == '#') {continue;}
+  /// Calculate the extents of particles.
+  this->calc_pos_min_and_max();
 
-    /// Extract row entries.
-    std::vector<double> row;
+  return 0;
+}
 
-    std::stringstream ss(
-      line_str, std::ios_base::out | std::ios_base::in | std::ios_base::binary
+int ParticleCatalogue::scan_catalogue_file(
+  const std::string& catalogue_filepath,
+  const std::string& catalogue_columns
+) {
+  if (!(this->source.empty())) {
+    trvs::logger.error(
+      "Catalogue already loaded from another source: %s.", this->source.c_str()
+    );
+    throw trvs::InvalidData(
+      "Catalogue already loaded from another source: %s.\n",
+      this->source.c_str()
     );
-    while (ss >> entry) {row.push_back(entry);}
+  }
+  this->source = "extfile:" + catalogue_filepath;
 
-    /// Add the current line as a particle.
-    this->pdata[idx_line].pos[0] = row[name_indices[0]];  // x
-    this->pdata[idx_line].pos[1] = row[name_indices[1]];  // y
-    this->pdata[idx_line].pos[2] = row[name_indices[2]];  // z
+  std::vector<int> name_indices =
+    ParticleCatalogue::get_column_indices(catalogue_columns);
 
-    if (name_indices[3] != -1) {
-      nz = row[name_indices[3]];
-    } else {
-      nz = nz_box_default;  // default value
-    }
+  CatalogueFileReader reader(catalogue_filepath);
 
-    if (name_indices[4] != -1) {
-      ws = row[name_indices[4]];
-    } else {
-      ws = 1.;  // default value
-    }
+  /// Accumulate summary information line by line.  The 'nz' value
+  /// is irrelevant here and so a placeholder default is used.
+  int ntotal = 0;
+  double wtotal = 0.;
+  double pos_min[3], pos_max[3];
 
-    if (name_indices[5] != -1) {
-      wc = row[name_indices[5]];
-    } else {
-      wc = 1.;  // default value
-    }
+  std::string line_str;
+  ParticleData particle;
+  while (reader.getline(line_str)) {
+    if (!ParticleCatalogue::parse_catalogue_line(
+      line_str, name_indices, 0., particle
+    )) {continue;}
 
-    this->pdata[idx_line].nz = nz;
-    this->pdata[idx_line].ws = ws;
-    this->pdata[idx_line].wc = wc;
-    this->pdata[idx_line].w = ws * wc;
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      if (ntotal == 0 || particle.pos[iaxis] < pos_min[iaxis]) {
+        pos_min[iaxis] = particle.pos[iaxis];
+      }
+      if (ntotal == 0 || particle.pos[iaxis] > pos_max[iaxis]) {
+        pos_max[iaxis] = particle.pos[iaxis];
+      }
+    }
+    wtotal += particle.ws;
+    ntotal++;
+  }
 
-    idx_line++;
+  if (ntotal <= 0) {
+    trvs::logger.error("Number of particles is non-positive.");
+    throw trvs::InvalidData("Number of particles is non-positive.\n");
   }
 
-  fin.close();
+  /// Set summary information without particle data.
+  this->finalise_particles();
 
-  /// --------------------------------------------------------------------
-  /// Catalogue properties
-  /// --------------------------------------------------------------------
+  this->streamed = true;
+  this->ntotal = ntotal;
+  this->wtotal = wtotal;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    this->pos_min[iaxis] = pos_min[iaxis];
+    this->pos_max[iaxis] = pos_max[iaxis];
+    this->pos_observer[iaxis] = 0.;
+  }
 
-  /// Calculate systematic weight sum.
-  this->calc_wtotal();
+  if (trvs::currTask == 0) {
+    trvs::logger.info(
+      "Catalogue scanned: %d particles with "
+      "total systematic weights %.3f (source=%s).",
+      this->ntotal, this->wtotal, this->source.c_str()
+    );
+  }
 
-  /// Calculate the extents of particles.
   this->calc_pos_min_and_max();
 
   return 0;
 }
 
+std::vector<int> ParticleCatalogue::get_column_indices(
+  const std::string& catalogue_columns
+) {
+  /// CAVEAT: Hard-coded ordered column names.
+  const std::vector<std::string> names_ordered = {
+    "x", "y", "z", "nz", "ws", "wc"
+  };
+
+  std::istringstream iss(catalogue_columns);
+  std::vector<std::string> colnames;
+  std::string name;
+  while (std::getline(iss, name, ',')) {
+    colnames.push_back(name);
+  }
+
+  /// CAVEAT: Default -1 index as a flag for unfound column names.
+  std::vector<int> name_indices(names_ordered.size(), -1);
+  for (int iname = 0; iname < int(names_ordered.size()); iname++) {
+    std::ptrdiff_t col_idx = std::distance(
+      colnames.begin(),
+      std::find(colnames.begin(), colnames.end(), names_ordered[iname])
+    );
+    if (0 <= col_idx && col_idx < int(colnames.size())) {
+      name_indices[iname] = col_idx;
+    }
+  }
+
+  return name_indices;
+}
+
+bool ParticleCatalogue::parse_catalogue_line(
+  const std::string& line_str, const std::vector<int>& name_indices,
+  double nz_default, ParticleData& particle
+) {
+  /// Skip empty lines or comment lines.
+  if (line_str.empty() || line_str[0] == '#') {return false;}
+
+  /// Extract row entries.
+  std::vector<double> row;
+
+  double entry;  // data entry (per column per row)
+  std::stringstream ss(
+    line_str, std::ios_base::out | std::ios_base::in | std::ios_base::binary
+  );
+  while (ss >> entry) {row.push_back(entry);}
+
+  /// Set the particle data, with default values for missing fields.
+  particle.pos[0] = row[name_indices[0]];  // x
+  particle.pos[1] = row[name_indices[1]];  // y
+  particle.pos[2] = row[name_indices[2]];  // z
+
+  particle.nz = (name_indices[3] != -1) ? row[name_indices[3]] : nz_default;
+  particle.ws = (name_indices[4] != -1) ? row[name_indices[4]] : 1.;
+  particle.wc = (name_indices[5] != -1) ? row[name_indices[5]] : 1.;
+  particle.w = particle.ws * particle.wc;
+
+  return true;
+}
+
 int ParticleCatalogue::load_particle_data(
-  std::vector<double> x, std::vector<double> y, std::vector<double> z,
-  std::vector<double> nz, std::vector<double> ws, std::vector<double> wc
+  const std::vector<double>& x,
+  const std::vector<double>& y,
+  const std::vector<double>& z,
+  const std::vector<double>& nz,
+  const std::vector<double>& ws,
+  const std::vector<double>& wc
 ) {
   this->source = "extdata";
 
@@ -275,13 +690,40 @@ int ParticleCatalogue::load_particle_data(
     }
   }
 
+  return this->load_particle_data(
+    x.data(), y.data(), z.data(), nz.data(), ws.data(), wc.data(), ntotal
+  );
+}
+
+int ParticleCatalogue::load_particle_data(
+  const double* x, const double* y, const double* z,
+  const double* nz, const double* ws, const double* wc,
+  const int num
+) {
+  this->source = "extdata";
+
+  /// Check data buffers.
+  if (
+    x == nullptr || y == nullptr || z == nullptr
+    || nz == nullptr || ws == nullptr || wc == nullptr
+  ) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Invalid particle data buffers (source=%s).", this->source.c_str()
+      );
+      throw trvs::InvalidData(
+        "Invalid particle data buffers (source=%s).\n", this->source.c_str()
+      );
+    }
+  }
+
   /// Fill in particle data.
-  this->initialise_particles(ntotal);
+  this->initialise_particles(num);
 
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < ntotal; pid++) {
+  for (int pid = 0; pid < num; pid++) {
     this->pdata[pid].pos[0] = x[pid];
     this->pdata[pid].pos[1] = y[pid];
     this->pdata[pid].pos[2] = z[pid];
@@ -300,6 +742,74 @@ int ParticleCatalogue::load_particle_data(
   return 0;
 }
 
+int ParticleCatalogue::load_particle_data_column(
+  const std::string& name, const double* values, const int num
+) {
+  this->source = "extdata";
+
+  /// Check the data buffer against the particle data container.
+  if (values == nullptr || this->pdata == nullptr || this->ntotal != num) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Inconsistent particle data dimensions (source=%s).",
+        this->source.c_str()
+      );
+    }
+    throw trvs::InvalidData(
+      "Inconsistent particle data dimensions (source=%s).\n",
+      this->source.c_str()
+    );
+  }
+
+  /// Fill in the particle data column.
+  if (name == "x" || name == "y" || name == "z") {
+    const int iaxis = name[0] - 'x';
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+    for (int pid = 0; pid < num; pid++) {
+      this->pdata[pid].pos[iaxis] = values[pid];
+    }
+  } else
+  if (name == "nz") {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+    for (int pid = 0; pid < num; pid++) {
+      this->pdata[pid].nz = values[pid];
+    }
+  } else
+  if (name == "ws") {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+    for (int pid = 0; pid < num; pid++) {
+      this->pdata[pid].ws = values[pid];
+    }
+  } else
+  if (name == "wc") {
+    /// The overall weights are set along with the clustering weights.
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+    for (int pid = 0; pid < num; pid++) {
+      this->pdata[pid].wc = values[pid];
+      this->pdata[pid].w = this->pdata[pid].ws * values[pid];
+    }
+  } else {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Unknown particle data column: '%s'.", name.c_str()
+      );
+    }
+    throw trvs::InvalidParameter(
+      "Unknown particle data column: '%s'.\n", name.c_str()
+    );
+  }
+
+  return 0;
+}
+
 
 /// **********************************************************************
 /// Catalogue properties
@@ -334,6 +844,22 @@ void ParticleCatalogue::calc_wtotal() {
 }
 
 void ParticleCatalogue::calc_pos_min_and_max() {
+  /// Keep the precomputed extents of a streamed catalogue.
+  if (this->streamed) {
+    if (trvs::currTask == 0) {
+      trvs::logger.info(
+        "Extents of particle coordinates: "
+        "{'x': (%.3f, %.3f), 'y': (%.3f, %.3f), 'z': (%.3f, %.3f)} "
+        "(source=%s).",
+        this->pos_min[0], this->pos_max[0],
+        this->pos_min[1], this->pos_max[1],
+        this->pos_min[2], this->pos_max[2],
+        this->source.c_str()
+      );
+    }
+    return;
+  }
+
   if (this->pdata == nullptr) {
     if (trvs::currTask == 0) {
       trvs::logger.error("Particle data are uninitialised.");
@@ -385,6 +911,19 @@ void ParticleCatalogue::calc_pos_min_and_max() {
 /// **********************************************************************
 
 void ParticleCatalogue::offset_coords(const double dpos[3]) {
+  /// Offset only the summary information of a streamed catalogue.
+  if (this->streamed) {
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      this->pos_min[iaxis] -= dpos[iaxis];
+      this->pos_max[iaxis] -= dpos[iaxis];
+      this->pos_observer[iaxis] -= dpos[iaxis];
+    }
+
+    this->calc_pos_min_and_max();
+
+    return;
+  }
+
   if (this->pdata == nullptr) {
     if (trvs::currTask == 0) {
       trvs::logger.error("Particle data are uninitialised.");
@@ -401,10 +940,21 @@ void ParticleCatalogue::offset_coords(const double dpos[3]) {
     }
   }
 
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    this->pos_observer[iaxis] -= dpos[iaxis];
+  }
+
   this->calc_pos_min_and_max();
 }
 
 void ParticleCatalogue::offset_coords_for_periodicity(const double boxsize[3]) {
+  if (this->pdata == nullptr) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error("Particle data are uninitialised.");
+      throw trvs::InvalidData("Particle data are uninitialised.\n");
+    }
+  }
+
 #ifdef TRV_USE_OMP
 #pragma omp parallel for
 #endif  // TRV_USE_OMP
@@ -422,6 +972,52 @@ void ParticleCatalogue::offset_coords_for_periodicity(const double boxsize[3]) {
   this->calc_pos_min_and_max();
 }
 
+void ParticleCatalogue::fold_coords(const double boxsize[3]) {
+  if (this->pdata == nullptr) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error("Particle data are uninitialised.");
+      throw trvs::InvalidData("Particle data are uninitialised.\n");
+    }
+  }
+
+  this->pos_unfolded.resize(3 * (long long)(this->ntotal));
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+  for (int pid = 0; pid < this->ntotal; pid++) {
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      double pos_ = this->pdata[pid].pos[iaxis];
+      this->pos_unfolded[3 * (long long)(pid) + iaxis] = pos_;
+
+      pos_ -= boxsize[iaxis] * std::floor(pos_ / boxsize[iaxis]);
+      if (pos_ >= boxsize[iaxis]) {pos_ -= boxsize[iaxis];}  // round-off
+
+      this->pdata[pid].pos[iaxis] = pos_;
+    }
+  }
+
+  this->calc_pos_min_and_max();
+}
+
+void ParticleCatalogue::unfold_coords() {
+  if (this->pos_unfolded.empty()) {return;}
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+  for (int pid = 0; pid < this->ntotal; pid++) {
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      this->pdata[pid].pos[iaxis] =
+        this->pos_unfolded[3 * (long long)(pid) + iaxis];
+    }
+  }
+
+  PositionList().swap(this->pos_unfolded);
+
+  this->calc_pos_min_and_max();
+}
+
 void ParticleCatalogue::centre_in_box(
   ParticleCatalogue& catalogue,
   const double boxsize[3]
@@ -521,4 +1117,96 @@ void ParticleCatalogue::pad_grids(
   catalogue.offset_coords(dvec);
 }
 
+
+/// **********************************************************************
+/// Particle catalogue stream
+/// **********************************************************************
+
+ParticleCatalogueStream::ParticleCatalogueStream(
+  ParticleCatalogue& catalogue,
+  const std::string& catalogue_filepath,
+  const std::string& catalogue_columns,
+  const int chunk_size,
+  double volume
+) : catalogue(catalogue) {
+  if (chunk_size <= 0) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error("Chunk size is non-positive.");
+      throw trvs::InvalidParameter("Chunk size is non-positive.\n");
+    }
+  }
+
+  this->catalogue_filepath = catalogue_filepath;
+  this->name_indices =
+    ParticleCatalogue::get_column_indices(catalogue_columns);
+
+  /// Scan the catalogue file for summary information.
+  this->catalogue.scan_catalogue_file(catalogue_filepath, catalogue_columns);
+
+  /// Check for the 'nz' column.
+  this->nz_default = 0.;
+  if (this->name_indices[3] == -1) {
+    if (volume > 0.) {
+      this->nz_default = this->catalogue.ntotal / volume;
+    }
+    if (trvs::currTask == 0) {
+      trvs::logger.warn(
+        "Catalogue 'nz' field is unavailable and "
+        "will be set to the mean density in the bounding box (source=%s).",
+        this->catalogue.source.c_str()
+      );
+    }
+  }
+
+  /// Allocate the chunk buffer once for reuse.
+  this->chunk_size = std::min(chunk_size, this->catalogue.ntotal);
+  this->chunk.initialise_particles(this->chunk_size);
+  this->chunk.source = this->catalogue.source;
+  this->chunk.ntotal = 0;
+
+  this->reader = new CatalogueFileReader(this->catalogue_filepath);
+}
+
+ParticleCatalogueStream::~ParticleCatalogueStream() {
+  delete this->reader;
+
+  /// Restore the chunk buffer size for correct memory accounting.
+  this->chunk.ntotal = this->chunk_size;
+  this->chunk.finalise_particles();
+}
+
+int ParticleCatalogueStream::read_next_chunk() {
+  int nchunk = this->reader->read_data_lines(this->lines, this->chunk_size);
+
+  /// Parse data lines and offset particle positions into the frame of
+  /// the summary catalogue.  The chunk extents are bounded by the
+  /// summary catalogue's.
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+  for (int pid = 0; pid < nchunk; pid++) {
+    ParticleCatalogue::parse_catalogue_line(
+      this->lines[pid], this->name_indices, this->nz_default,
+      this->chunk.pdata[pid]
+    );
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      this->chunk.pdata[pid].pos[iaxis] += this->catalogue.pos_observer[iaxis];
+    }
+  }
+
+  this->chunk.ntotal = nchunk;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    this->chunk.pos_min[iaxis] = this->catalogue.pos_min[iaxis];
+    this->chunk.pos_max[iaxis] = this->catalogue.pos_max[iaxis];
+    this->chunk.pos_observer[iaxis] = this->catalogue.pos_observer[iaxis];
+  }
+
+  return nchunk;
+}
+
+void ParticleCatalogueStream::rewind() {
+  this->reader->rewind();
+  this->chunk.ntotal = 0;
+}
+
 }  // namespace trv
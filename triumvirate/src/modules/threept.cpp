@@ -69,11 +69,26 @@ void validate_multipole_coupling(trv::ParameterSet& params) {
 double calc_bispec_normalisation_from_mesh(
   ParticleCatalogue& particles, trv::ParameterSet& params, double alpha
 ) {
-  MeshField catalogue_mesh(params);
+  auto calc_norm = [&]() {
+    MeshField catalogue_mesh(params);
 
-  double norm_factor = catalogue_mesh.calc_grid_based_powlaw_norm(particles, 3);
+    double norm_factor =
+      catalogue_mesh.calc_grid_based_powlaw_norm(particles, 3);
 
-  catalogue_mesh.finalise_density_field();  // likely redundant but safe
+    catalogue_mesh.finalise_density_field();  // likely redundant but safe
+
+    return std::complex<double>(norm_factor, 0.);
+  };
+
+  double norm_factor;
+  if (particles.mesh_cache != nullptr) {
+    norm_factor = particles.mesh_cache->get_value(
+      "norm_mesh_3_" + RandomMeshCache::get_mesh_key(params, particles),
+      particles, calc_norm
+    ).real();
+  } else {
+    norm_factor = calc_norm().real();
+  }
 
   norm_factor /= std::pow(alpha, 3);
 
@@ -83,21 +98,34 @@ double calc_bispec_normalisation_from_mesh(
 double calc_bispec_normalisation_from_particles(
   ParticleCatalogue& particles, double alpha
 ) {
-  if (particles.pdata == nullptr) {
-    if (trvs::currTask == 0) {
-      trvs::logger.error("Particle data are uninitialised.");
-      throw trvs::InvalidData("Particle data are uninitialised.\n");
+  auto calc_norm = [&]() {
+    if (particles.pdata == nullptr) {
+      if (trvs::currTask == 0) {
+        trvs::logger.error("Particle data are uninitialised.");
+        throw trvs::InvalidData("Particle data are uninitialised.\n");
+      }
     }
-  }
 
-  double norm = 0.;  // I₃
+    double norm = 0.;
 
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:norm)
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles.ntotal; pid++) {
-    norm += particles[pid].ws
-      * std::pow(particles[pid].nz, 2) * std::pow(particles[pid].wc, 3);
+    for (int pid = 0; pid < particles.ntotal; pid++) {
+      norm += particles[pid].ws
+        * std::pow(particles[pid].nz, 2) * std::pow(particles[pid].wc, 3);
+    }
+
+    return std::complex<double>(norm, 0.);
+  };
+
+  double norm;  // I₃
+  if (particles.mesh_cache != nullptr) {
+    norm = particles.mesh_cache->get_value(
+      "norm_particle_3", particles, calc_norm
+    ).real();
+  } else {
+    norm = calc_norm().real();
   }
 
   if (norm == 0.) {
@@ -123,20 +151,22 @@ double calc_bispec_normalisation_from_particles(
 /// Shot noise
 /// **********************************************************************
 
+template <class LoSPolicy>
 std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
   ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
   double alpha, int ell, int m
 ) {
+  trvs::StageTimer timer("shotnoise");
+
   double sn_data_real = 0., sn_data_imag = 0.;
 
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:sn_data_real, sn_data_imag)
 #endif
   for (int pid = 0; pid < particles_data.ntotal; pid++) {
-    double los_[3] = {
-      los_data[pid].pos[0], los_data[pid].pos[1], los_data[pid].pos[2]
-    };
+    double los_[3];
+    los_data.eval(pid, particles_data[pid].pos, los_);
 
     std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
       calc_reduced_spherical_harmonic(ell, m, los_);
@@ -151,43 +181,63 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
 
   std::complex<double> sn_data(sn_data_real, sn_data_imag);
 
-  double sn_rand_real = 0., sn_rand_imag = 0.;
+  auto calc_sn_rand = [&]() {
+    double sn_rand_real = 0., sn_rand_imag = 0.;
 
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:sn_rand_real, sn_rand_imag)
 #endif
-  for (int pid = 0; pid < particles_rand.ntotal; pid++) {
-    double los_[3] = {
-      los_rand[pid].pos[0], los_rand[pid].pos[1], los_rand[pid].pos[2]
-    };
+    for (int pid = 0; pid < particles_rand.ntotal; pid++) {
+      double los_[3];
+      los_rand.eval(pid, particles_rand[pid].pos, los_);
 
-    std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
-      calc_reduced_spherical_harmonic(ell, m, los_);
+      std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
+        calc_reduced_spherical_harmonic(ell, m, los_);
 
-    std::complex<double> sn_part = ylm * std::pow(particles_rand[pid].w, 3);
-    double sn_part_real = sn_part.real();
-    double sn_part_imag = sn_part.imag();
+      std::complex<double> sn_part =
+        ylm * std::pow(particles_rand[pid].w, 3);
+      double sn_part_real = sn_part.real();
+      double sn_part_imag = sn_part.imag();
 
-    sn_rand_real += sn_part_real;
-    sn_rand_imag += sn_part_imag;
-  }
+      sn_rand_real += sn_part_real;
+      sn_rand_imag += sn_part_imag;
+    }
 
-  std::complex<double> sn_rand(sn_rand_real, sn_rand_imag);
+    return std::complex<double>(sn_rand_real, sn_rand_imag);
+  };
+
+  /// Random-source sums are shared across data-source catalogues
+  /// if cached.
+  std::complex<double> sn_rand;
+  if (particles_rand.mesh_cache != nullptr
+      && std::is_same<LoSPolicy, RadialLineOfSight>::value) {
+    char sn_name[32];
+    std::snprintf(sn_name, sizeof(sn_name), "sn_w3_l%d_m%d", ell, m);
+    sn_rand = particles_rand.mesh_cache->get_value(
+      sn_name, particles_rand, calc_sn_rand
+    );
+  } else {
+    sn_rand = calc_sn_rand();
+  }
 
   return sn_data + std::pow(alpha, 3) * sn_rand;
 }
 
+template <class LoSPolicy>
 std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
-  ParticleCatalogue& particles, LineOfSight* los,
+  ParticleCatalogue& particles, LoSPolicy los,
   double alpha, int ell, int m
 ) {
+  trvs::StageTimer timer("shotnoise");
+
   double sn_real = 0., sn_imag = 0.;
 
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:sn_real, sn_imag)
 #endif
   for (int pid = 0; pid < particles.ntotal; pid++) {
-    double los_[3] = {los[pid].pos[0], los[pid].pos[1], los[pid].pos[2]};
+    double los_[3];
+    los.eval(pid, particles[pid].pos, los_);
 
     std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
       calc_reduced_spherical_harmonic(ell, m, los_);
@@ -206,6 +256,83 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
 }
 
 
+/// **********************************************************************
+/// Reduced mesh grids
+/// **********************************************************************
+
+bool set_reduced_mesh_params(
+  trv::ParameterSet& params, double k_max,
+  trv::ParameterSet& params_reduced
+) {
+  params_reduced = params;
+
+  /// Distributed mesh grids are not reduced.
+  if (trvs::numTasks > 1) {return false;}
+
+  /// Find the smallest even FFT-friendly size (with prime factors
+  /// 2, 3 and 5 only) no less than the given size.
+  auto get_fft_friendly_size = [](int size) {
+    for (int size_ = size + size % 2; ; size_ += 2) {
+      int factor = size_;
+      for (int prime : {2, 3, 5}) {
+        while (factor % prime == 0) {factor /= prime;}
+      }
+      if (factor == 1) {return size_;}
+    }
+  };
+
+  bool reduced = false;
+  long long nmesh_reduced = 1;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    double dk = 2.*M_PI / params.boxsize[iaxis];
+    int nmax = int(k_max / dk);
+
+    int ngrid_reduced = get_fft_friendly_size(4 * nmax + 1);
+    if (ngrid_reduced < params.ngrid[iaxis]) {
+      params_reduced.ngrid[iaxis] = ngrid_reduced;
+      reduced = true;
+    }
+    nmesh_reduced *= params_reduced.ngrid[iaxis];
+  }
+  params_reduced.nmesh = nmesh_reduced;
+
+  return reduced;
+}
+
+std::complex<double> calc_bispec_component_on_reduced_mesh(
+  trv::ParameterSet& params_reduced, MeshField& dn_fourier,
+  const std::vector< std::complex<double> >& ylm_k_a,
+  const std::vector< std::complex<double> >& ylm_k_b,
+  MeshField& G_fourier,
+  double k_lower_a, double k_upper_a, double k_lower_b, double k_upper_b,
+  double& k_eff_a, int& nmodes_a, double& k_eff_b, int& nmodes_b
+) {
+  MeshField F_lm_a(params_reduced);  // F_lm_a
+  MeshField F_lm_b(params_reduced);  // F_lm_b
+  MeshField G_LM(params_reduced);  // G_LM
+
+  F_lm_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
+    dn_fourier, ylm_k_a, k_lower_a, k_upper_a, k_eff_a, nmodes_a
+  );
+  F_lm_b.inv_fourier_transform_ylm_wgtd_field_band_limited(
+    dn_fourier, ylm_k_b, k_lower_b, k_upper_b, k_eff_b, nmodes_b
+  );
+
+  G_LM.resample_fourier_field(G_fourier);
+  G_LM.inv_fourier_transform();
+
+  std::complex<double> bk_component = 0.;
+  for (int gid = 0; gid < F_lm_a.local_nmesh; gid++) {
+    std::complex<double> F_lm_a_gridpt(F_lm_a[gid][0], F_lm_a[gid][1]);
+    std::complex<double> F_lm_b_gridpt(F_lm_b[gid][0], F_lm_b[gid][1]);
+    std::complex<double> G_LM_gridpt(G_LM[gid][0], G_LM[gid][1]);
+    bk_component += F_lm_a_gridpt * F_lm_b_gridpt * G_LM_gridpt;
+  }
+
+  return F_lm_a.vol_cell * bk_component;
+}
+
+
 /// **********************************************************************
 /// Full statistics
 /// **********************************************************************
@@ -215,12 +342,15 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_bispec(
 
 /// Hereafter 'the Paper' refers to Sugiyama et al. (2019) [1803.02132].
 
+template <class LoSPolicy>
 trv::BispecMeasurements compute_bispec(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
   trv::ParameterSet& params, trv::Binning& kbinning,
   double norm_factor
 ) {
+  trvs::StageTimer timer("bispec");
+
   if (trvs::currTask == 0) {
     trvs::logger.stat(
       "Computing bispectrum from paired survey-type catalogues..."
@@ -256,26 +386,26 @@ trv::BispecMeasurements compute_bispec(
   /// Measurement
   /// --------------------------------------------------------------------
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+  trvs::init_fftw();
 
   /// Compute common field quantities.
-  MeshField dn_00(params);  // δn_00(k)
+  MeshFieldBatch fields_00(params, 2);  // δn_00(k), N_00(k)
+
+  MeshField& dn_00 = fields_00[0];  // δn_00(k)
   dn_00.compute_ylm_wgtd_field(
     catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
   );
-  dn_00.fourier_transform();
 
   MeshField& dn_00_for_sn = dn_00;  // δn_00(k) (for shot noise)
 
   double vol_cell = dn_00.vol_cell;
 
-  MeshField N_00(params);  // N_00(k)
+  MeshField& N_00 = fields_00[1];  // N_00(k)
   N_00.compute_ylm_wgtd_quad_field(
     catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
   );
-  N_00.fourier_transform();
+
+  fields_00.fourier_transform();
 
   trvm::SphericalBesselCalculator sj_a(params.ell1);  // j_l_a
   trvm::SphericalBesselCalculator sj_b(params.ell2);  // j_l_b
@@ -296,30 +426,23 @@ trv::BispecMeasurements compute_bispec(
       }
       if (flag_vanishing == "true") {continue;}
 
-      /// Initialise reduced-spherical-harmonic weights on mesh grids.
-      std::vector< std::complex<double> > ylm_k_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_k_b(params.nmesh);
-      std::vector< std::complex<double> > ylm_r_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_r_b(params.nmesh);
-      trvs::gbytesMem +=
-        trvs::size_in_gb< std::complex<double> >(4 * params.nmesh);
-      trvs::update_maxmem();
-
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_fourier_space(
-          params.ell1, m1_, params.boxsize, params.ngrid, ylm_k_a
+      /// Get reduced-spherical-harmonic weights on mesh grids, which are
+      /// shared with other measurements on the same mesh grids.
+      auto ylm_k_a = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_fourier_space(
+          params.ell1, m1_, params.boxsize, params.ngrid
         );
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_fourier_space(
-          params.ell2, m2_, params.boxsize, params.ngrid, ylm_k_b
+      auto ylm_k_b = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_fourier_space(
+          params.ell2, m2_, params.boxsize, params.ngrid
         );
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_config_space(
-          params.ell1, m1_, params.boxsize, params.ngrid, ylm_r_a
+      auto ylm_r_a = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_config_space(
+          params.ell1, m1_, params.boxsize, params.ngrid
         );
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_config_space(
-          params.ell2, m2_, params.boxsize, params.ngrid, ylm_r_b
+      auto ylm_r_b = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_config_space(
+          params.ell2, m2_, params.boxsize, params.ngrid
         );
 
       for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
@@ -341,52 +464,75 @@ trv::BispecMeasurements compute_bispec(
         );
         G_LM.fourier_transform();
         G_LM.apply_assignment_compensation();
-        G_LM.inv_fourier_transform();
+
+        /// Compute low-wavenumber bins on reduced mesh grids while
+        /// `G_LM` is kept in Fourier space, and the rest on the full
+        /// mesh grid (bins are in ascending order).
+        bool G_LM_in_config = false;
 
         MeshField F_lm_a(params);  // F_lm_a
         MeshField F_lm_b(params);  // F_lm_b
-        if (params.form == "full") {
-          double k_lower = kbinning.bin_edges[params.idx_bin];
-          double k_upper = kbinning.bin_edges[params.idx_bin + 1];
-
-          double k_eff_a_;
-          int nmodes_a_;
-
-          F_lm_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
-            dn_00, ylm_k_a, k_lower, k_upper, k_eff_a_, nmodes_a_
-          );
-
-          for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
-            // nmodes1_save[ibin] = nmodes_a_ inferred from *_b_
-            k1_save[ibin] = k_eff_a_;
-          }
-        }
+        bool F_lm_a_full = false;
 
         for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
           double k_lower = kbinning.bin_edges[ibin];
           double k_upper = kbinning.bin_edges[ibin + 1];
 
+          double k_lower_a = k_lower;
+          double k_upper_a = k_upper;
+          if (params.form == "full") {
+            k_lower_a = kbinning.bin_edges[params.idx_bin];
+            k_upper_a = kbinning.bin_edges[params.idx_bin + 1];
+          }
+
+          double k_eff_a_;
+          int nmodes_a_;  // inferred from `nmodes_b_`
           double k_eff_b_;
           int nmodes_b_;
 
+          trv::ParameterSet params_reduced;
+          if (!G_LM_in_config && trv::set_reduced_mesh_params(
+            params, std::max(k_upper_a, k_upper), params_reduced
+          )) {
+            std::complex<double> bk_component =  // B_{l₁ l₂ L}^{m₁ m₂ M}
+              trv::calc_bispec_component_on_reduced_mesh(
+                params_reduced, dn_00, *ylm_k_a, *ylm_k_b, G_LM,
+                k_lower_a, k_upper_a, k_lower, k_upper,
+                k_eff_a_, nmodes_a_, k_eff_b_, nmodes_b_
+              );
+
+            k1_save[ibin] = k_eff_a_;
+            k2_save[ibin] = k_eff_b_;
+            nmodes_save[ibin] = nmodes_b_;
+
+            bk_save[ibin] += coupling * bk_component;
+            continue;
+          }
+
+          if (!G_LM_in_config) {
+            G_LM.inv_fourier_transform();
+            G_LM_in_config = true;
+          }
+
           F_lm_b.inv_fourier_transform_ylm_wgtd_field_band_limited(
-            dn_00, ylm_k_b, k_lower, k_upper, k_eff_b_, nmodes_b_
+            dn_00, *ylm_k_b, k_lower, k_upper, k_eff_b_, nmodes_b_
           );
 
           k2_save[ibin] = k_eff_b_;
           nmodes_save[ibin] = nmodes_b_;
 
-          if (params.form == "diag") {
-            double k_eff_a_;  // redundant as this is `k_eff_b_`
-            int nmodes_a_;  // redundant as this is `nmodes_b_`
-
+          /// In the "full" form, `F_lm_a` is fixed and computed once.
+          if (params.form == "diag" || !F_lm_a_full) {
             F_lm_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
-              dn_00, ylm_k_a, k_lower, k_upper, k_eff_a_, nmodes_a_
+              dn_00, *ylm_k_a, k_lower_a, k_upper_a, k_eff_a_, nmodes_a_
             );
-
-            k1_save[ibin] = k_eff_a_;
+            F_lm_a_full = true;
+          } else {
+            k_eff_a_ = k1_save[ibin - 1];
           }
 
+          k1_save[ibin] = k_eff_a_;
+
           std::complex<double> bk_component = 0.;  // B_{l₁ l₂ L}^{m₁ m₂ M}
           for (int gid = 0; gid < params.nmesh; gid++) {
             std::complex<double> F_lm_a_gridpt(F_lm_a[gid][0], F_lm_a[gid][1]);
@@ -403,19 +549,22 @@ trv::BispecMeasurements compute_bispec(
         /// ······························································
 
         /// Compute shot noise components in eqs. (45) & (46) in the Paper.
-        MeshField dn_LM_for_sn(params);  // δn_LM(k) (for shot noise)
+        /// δn_LM(k) & N_LM(k) (for shot noise)
+        MeshFieldBatch fields_LM_for_sn(params, 2);
+
+        MeshField& dn_LM_for_sn = fields_LM_for_sn[0];  // δn_LM(k)
         dn_LM_for_sn.compute_ylm_wgtd_field(
           catalogue_data, catalogue_rand, los_data, los_rand, alpha,
           params.ELL, M_
         );
-        dn_LM_for_sn.fourier_transform();
 
-        MeshField N_LM(params);  // N_LM(k)
+        MeshField& N_LM = fields_LM_for_sn[1];  // N_LM(k)
         N_LM.compute_ylm_wgtd_quad_field(
           catalogue_data, catalogue_rand, los_data, los_rand, alpha,
           params.ELL, M_
         );
-        N_LM.fourier_transform();
+
+        fields_LM_for_sn.fourier_transform();
 
         std::complex<double> Sbar_LM = calc_ylm_wgtd_shotnoise_amp_for_bispec(
           catalogue_data, catalogue_rand, los_data, los_rand, alpha,
@@ -471,7 +620,7 @@ trv::BispecMeasurements compute_bispec(
 
           std::complex<double> S_ij_k = parity
             * stats_sn.compute_uncoupled_shotnoise_for_bispec_per_bin(
-              dn_LM_for_sn, N_00, ylm_r_a, ylm_r_b, sj_a, sj_b,
+              dn_LM_for_sn, N_00, *ylm_r_a, *ylm_r_b, sj_a, sj_b,
               Sbar_LM, k_a, k_b
             );  // S|{i = j ≠ k}
 
@@ -486,20 +635,12 @@ trv::BispecMeasurements compute_bispec(
         }
       }
 
-      trvs::gbytesMem -=
-        trvs::size_in_gb< std::complex<double> >(4 * params.nmesh);
     }
   }
 
   dn_00.finalise_density_field();  // ~dn_00 (likely redundant but safe)
   N_00.finalise_density_field();  // ~N_00 (likely redundant but safe)
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_cleanup_threads();
-#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
-  fftw_cleanup();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-
   /// --------------------------------------------------------------------
   /// Results
   /// --------------------------------------------------------------------
@@ -532,12 +673,15 @@ trv::BispecMeasurements compute_bispec(
   return bispec_out;
 }
 
+template <class LoSPolicy>
 trv::ThreePCFMeasurements compute_3pcf(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
   trv::ParameterSet& params, trv::Binning& rbinning,
   double norm_factor
 ) {
+  trvs::StageTimer timer("3pcf");
+
   if (trvs::currTask == 0) {
     trvs::logger.stat(
       "Computing three-point correlation function "
@@ -574,24 +718,24 @@ trv::ThreePCFMeasurements compute_3pcf(
   /// Measurement
   /// --------------------------------------------------------------------
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+  trvs::init_fftw();
 
   /// Compute common field quantities.
-  MeshField dn_00(params);  // δn_00(k)
+  MeshFieldBatch fields_00(params, 2);  // δn_00(k), N_00(k)
+
+  MeshField& dn_00 = fields_00[0];  // δn_00(k)
   dn_00.compute_ylm_wgtd_field(
     catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
   );
-  dn_00.fourier_transform();
 
   double vol_cell = dn_00.vol_cell;
 
-  MeshField N_00(params);  // N_00(k)
+  MeshField& N_00 = fields_00[1];  // N_00(k)
   N_00.compute_ylm_wgtd_quad_field(
     catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
   );
-  N_00.fourier_transform();
+
+  fields_00.fourier_transform();
 
   trvm::SphericalBesselCalculator sj_a(params.ell1);  // j_l_a
   trvm::SphericalBesselCalculator sj_b(params.ell2);  // j_l_b
@@ -613,30 +757,23 @@ trv::ThreePCFMeasurements compute_3pcf(
       }
       if (flag_vanishing == "true") {continue;}
 
-      /// Initialise reduced-spherical-harmonic weights on mesh grids.
-      std::vector< std::complex<double> > ylm_r_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_r_b(params.nmesh);
-      std::vector< std::complex<double> > ylm_k_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_k_b(params.nmesh);
-      trvs::gbytesMem +=
-        trvs::size_in_gb< std::complex<double> >(4 * params.nmesh);
-      trvs::update_maxmem();
-
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_config_space(
-          params.ell1, m1_, params.boxsize, params.ngrid, ylm_r_a
+      /// Get reduced-spherical-harmonic weights on mesh grids, which are
+      /// shared with other measurements on the same mesh grids.
+      auto ylm_r_a = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_config_space(
+          params.ell1, m1_, params.boxsize, params.ngrid
         );
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_config_space(
-          params.ell2, m2_, params.boxsize, params.ngrid, ylm_r_b
+      auto ylm_r_b = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_config_space(
+          params.ell2, m2_, params.boxsize, params.ngrid
         );
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_fourier_space(
-          params.ell1, m1_, params.boxsize, params.ngrid, ylm_k_a
+      auto ylm_k_a = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_fourier_space(
+          params.ell1, m1_, params.boxsize, params.ngrid
         );
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_fourier_space(
-          params.ell2, m2_, params.boxsize, params.ngrid, ylm_k_b
+      auto ylm_k_b = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_fourier_space(
+          params.ell2, m2_, params.boxsize, params.ngrid
         );
 
       for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
@@ -665,7 +802,7 @@ trv::ThreePCFMeasurements compute_3pcf(
 
         FieldStats stats_sn(params);  // S|{i = j ≠ k}
         stats_sn.compute_uncoupled_shotnoise_for_3pcf(
-          dn_LM_for_sn, N_00, ylm_r_a, ylm_r_b, Sbar_LM, rbinning
+          dn_LM_for_sn, N_00, *ylm_r_a, *ylm_r_b, Sbar_LM, rbinning
         );
 
         for (int ibin = 0; ibin < rbinning.num_bins; ibin++) {
@@ -721,7 +858,7 @@ trv::ThreePCFMeasurements compute_3pcf(
         if (params.form == "full") {
           double r_a = r1_save[params.idx_bin];
           F_lm_a.inv_fourier_transform_sjl_ylm_wgtd_field(
-            dn_00, ylm_k_a, sj_a, r_a
+            dn_00, *ylm_k_a, sj_a, r_a
           );
         }
 
@@ -729,13 +866,13 @@ trv::ThreePCFMeasurements compute_3pcf(
           double r_b = r2_save[ibin];
 
           F_lm_b.inv_fourier_transform_sjl_ylm_wgtd_field(
-            dn_00, ylm_k_b, sj_b, r_b
+            dn_00, *ylm_k_b, sj_b, r_b
           );
 
           if (params.form == "diag") {
             double r_a = r_b;
             F_lm_a.inv_fourier_transform_sjl_ylm_wgtd_field(
-              dn_00, ylm_k_a, sj_a, r_a
+              dn_00, *ylm_k_a, sj_a, r_a
             );
           }
 
@@ -759,20 +896,12 @@ trv::ThreePCFMeasurements compute_3pcf(
         }
       }
 
-      trvs::gbytesMem -=
-        trvs::size_in_gb< std::complex<double> >(4 * params.nmesh);
     }
   }
 
   dn_00.finalise_density_field();  // ~dn_00 (likely redundant but safe)
   N_00.finalise_density_field();  // ~N_00 (likely redundant but safe)
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_cleanup_threads();
-#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
-  fftw_cleanup();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-
   /// --------------------------------------------------------------------
   /// Results
   /// --------------------------------------------------------------------
@@ -811,6 +940,8 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
   trv::ParameterSet& params, trv::Binning kbinning,
   double norm_factor
 ) {
+  trvs::StageTimer timer("bispec");
+
   if (trvs::currTask == 0) {
     trvs::logger.stat(
       "Computing bispectrum from a periodic-box simulation-type catalogue "
@@ -845,14 +976,13 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
   /// Measurement
   /// --------------------------------------------------------------------
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+  trvs::init_fftw();
 
   /// Compute common field quantities.
-  MeshField dn_00(params);  // δn_00(k)
+  MeshFieldBatch fields_00(params, 2);  // δn_00(k), N_L0(k)
+
+  MeshField& dn_00 = fields_00[0];  // δn_00(k)
   dn_00.compute_unweighted_field_fluctuations_insitu(catalogue_data);
-  dn_00.fourier_transform();
 
   MeshField& dn_00_for_sn = dn_00;  // δn_00(k) (for shot noise)
   MeshField& dn_L0_for_sn = dn_00;  // δn_L0(k) (for shot noise)
@@ -861,9 +991,10 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
 
   /// Under the global plane-parallel approximation, y_{LM} = δᴰ_{M0}
   /// (L-invariant) for the line-of-sight spherical harmonic.
-  MeshField N_L0(params);  // N_L0(k)
+  MeshField& N_L0 = fields_00[1];  // N_L0(k)
   N_L0.compute_unweighted_field(catalogue_data);
-  N_L0.fourier_transform();
+
+  fields_00.fourier_transform();
 
   MeshField& N_00 = N_L0;  // N_00(k)
 
@@ -883,30 +1014,23 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
       );  // Wigner 3-j's
       if (std::fabs(coupling) < trvm::eps_coupling) {continue;}
 
-      /// Initialise/reset spherical harmonic mesh grids.
-      std::vector< std::complex<double> > ylm_k_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_k_b(params.nmesh);
-      std::vector< std::complex<double> > ylm_r_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_r_b(params.nmesh);
-      trvs::gbytesMem +=
-        trvs::size_in_gb< std::complex<double> >(4 * params.nmesh);
-      trvs::update_maxmem();
-
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_fourier_space(
-          params.ell1, m1_, params.boxsize, params.ngrid, ylm_k_a
+      /// Get reduced-spherical-harmonic weights on mesh grids, which are
+      /// shared with other measurements on the same mesh grids.
+      auto ylm_k_a = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_fourier_space(
+          params.ell1, m1_, params.boxsize, params.ngrid
         );
-      trvm::SphericalHarmonicCalculator
-        ::store_reduced_spherical_harmonic_in_fourier_space(
-          params.ell2, m2_, params.boxsize, params.ngrid, ylm_k_b
+      auto ylm_k_b = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_fourier_space(
+          params.ell2, m2_, params.boxsize, params.ngrid
         );
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_config_space(
-          params.ell1, m1_, params.boxsize, params.ngrid, ylm_r_a
+      auto ylm_r_a = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_config_space(
+          params.ell1, m1_, params.boxsize, params.ngrid
         );
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_config_space(
-          params.ell2, m2_, params.boxsize, params.ngrid, ylm_r_b
+      auto ylm_r_b = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_config_space(
+          params.ell2, m2_, params.boxsize, params.ngrid
         );
 
       /// ······························································
@@ -917,52 +1041,75 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
       G_00.compute_unweighted_field_fluctuations_insitu(catalogue_data);
       G_00.fourier_transform();
       G_00.apply_assignment_compensation();
-      G_00.inv_fourier_transform();
+
+      /// Compute low-wavenumber bins on reduced mesh grids while
+      /// `G_00` is kept in Fourier space, and the rest on the full
+      /// mesh grid (bins are in ascending order).
+      bool G_00_in_config = false;
 
       MeshField F_lm_a(params);  // F_lm_a
       MeshField F_lm_b(params);  // F_lm_b
-      if (params.form == "full") {
-        double k_lower = kbinning.bin_edges[params.idx_bin];
-        double k_upper = kbinning.bin_edges[params.idx_bin + 1];
-
-        double k_eff_a_;
-        int nmodes_a_;
-
-        F_lm_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
-          dn_00, ylm_k_a, k_lower, k_upper, k_eff_a_, nmodes_a_
-        );
-
-        for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
-          // nmodes1_save[ibin] = nmodes_a_ inferred from *_b_
-          k1_save[ibin] = k_eff_a_;
-        }
-      }
+      bool F_lm_a_full = false;
 
       for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
         double k_lower = kbinning.bin_edges[ibin];
         double k_upper = kbinning.bin_edges[ibin + 1];
 
+        double k_lower_a = k_lower;
+        double k_upper_a = k_upper;
+        if (params.form == "full") {
+          k_lower_a = kbinning.bin_edges[params.idx_bin];
+          k_upper_a = kbinning.bin_edges[params.idx_bin + 1];
+        }
+
+        double k_eff_a_;
+        int nmodes_a_;  // inferred from `nmodes_b_`
         double k_eff_b_;
         int nmodes_b_;
 
+        trv::ParameterSet params_reduced;
+        if (!G_00_in_config && trv::set_reduced_mesh_params(
+          params, std::max(k_upper_a, k_upper), params_reduced
+        )) {
+          std::complex<double> bk_component =  // B_{l₁ l₂ L}^{m₁ m₂ M}
+            trv::calc_bispec_component_on_reduced_mesh(
+              params_reduced, dn_00, *ylm_k_a, *ylm_k_b, G_00,
+              k_lower_a, k_upper_a, k_lower, k_upper,
+              k_eff_a_, nmodes_a_, k_eff_b_, nmodes_b_
+            );
+
+          k1_save[ibin] = k_eff_a_;
+          k2_save[ibin] = k_eff_b_;
+          nmodes_save[ibin] = nmodes_b_;
+
+          bk_save[ibin] += coupling * bk_component;
+          continue;
+        }
+
+        if (!G_00_in_config) {
+          G_00.inv_fourier_transform();
+          G_00_in_config = true;
+        }
+
         F_lm_b.inv_fourier_transform_ylm_wgtd_field_band_limited(
-          dn_00, ylm_k_b, k_lower, k_upper, k_eff_b_, nmodes_b_
+          dn_00, *ylm_k_b, k_lower, k_upper, k_eff_b_, nmodes_b_
         );
 
         k2_save[ibin] = k_eff_b_;
         nmodes_save[ibin] = nmodes_b_;
 
-        if (params.form == "diag") {
-          double k_eff_a_;  // redundant as this is `k_eff_b_`
-          int nmodes_a_;  // redundant as this is `nmodes_b_`
-
+        /// In the "full" form, `F_lm_a` is fixed and computed once.
+        if (params.form == "diag" || !F_lm_a_full) {
           F_lm_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
-            dn_00, ylm_k_a, k_lower, k_upper, k_eff_a_, nmodes_a_
+            dn_00, *ylm_k_a, k_lower_a, k_upper_a, k_eff_a_, nmodes_a_
           );
-
-          k1_save[ibin] = k_eff_a_;
+          F_lm_a_full = true;
+        } else {
+          k_eff_a_ = k1_save[ibin - 1];
         }
 
+        k1_save[ibin] = k_eff_a_;
+
         std::complex<double> bk_component = 0.;  // B_{l₁ l₂ L}^{m₁ m₂ M}
         for (int gid = 0; gid < params.nmesh; gid++) {
           std::complex<double> F_lm_a_gridpt(F_lm_a[gid][0], F_lm_a[gid][1]);
@@ -1030,7 +1177,7 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
 
         std::complex<double> S_ij_k = parity *
           stats_sn.compute_uncoupled_shotnoise_for_bispec_per_bin(
-            dn_L0_for_sn, N_00, ylm_r_a, ylm_r_b, sj_a, sj_b,
+            dn_L0_for_sn, N_00, *ylm_r_a, *ylm_r_b, sj_a, sj_b,
             Sbar_L0, k_a, k_b
           );  // S|{i = j ≠ k}
 
@@ -1044,20 +1191,12 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
         );
       }
 
-      trvs::gbytesMem -=
-        trvs::size_in_gb< std::complex<double> >(4 * params.nmesh);
     }
   }
 
   dn_00.finalise_density_field();  // ~dn_00 (likely redundant but safe)
   N_L0.finalise_density_field();  // ~N_L0 (likely redundant but safe)
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_cleanup_threads();
-#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
-  fftw_cleanup();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-
   /// --------------------------------------------------------------------
   /// Results
   /// --------------------------------------------------------------------
@@ -1081,6 +1220,48 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
   delete[] nmodes_save; delete[] k1_save; delete[] k2_save;
   delete[] bk_save; delete[] sn_save;
 
+  /// Repeat the measurements on the folded mesh grid, normalised for the
+  /// folded box volume, and stitch them onto the unfolded ones in bins
+  /// where both wavenumber bins have lower edges at or above the
+  /// stitching wavenumber.
+  if (params.fold_factor > 1) {
+    if (trvs::currTask == 0) {
+      trvs::logger.stat(
+        "Measuring on the mesh grid folded by a factor of %d "
+        "(stitched at k = %.4f).",
+        params.fold_factor, params.fold_kstitch
+      );
+    }
+
+    trv::ParameterSet params_fold;
+    trv::set_folded_mesh_params(params, params_fold);
+
+    double vol_ratio = params.volume / params_fold.volume;
+
+    catalogue_data.fold_coords(params_fold.boxsize);
+    trv::BispecMeasurements bispec_fold = compute_bispec_in_gpp_box(
+      catalogue_data, params_fold, kbinning,
+      norm_factor / (vol_ratio * vol_ratio)
+    );
+    catalogue_data.unfold_coords();
+
+    for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+      int ibin_a = (params.form == "full") ? params.idx_bin : ibin;
+      if (
+        kbinning.bin_edges[ibin_a] < params.fold_kstitch
+        || kbinning.bin_edges[ibin] < params.fold_kstitch
+      ) {continue;}
+
+      bispec_out.k1eff[ibin] = bispec_fold.k1eff[ibin];
+      bispec_out.k2eff[ibin] = bispec_fold.k2eff[ibin];
+      bispec_out.nmodes[ibin] = bispec_fold.nmodes[ibin];
+      bispec_out.bk_raw[ibin] =
+        vol_ratio * vol_ratio * bispec_fold.bk_raw[ibin];
+      bispec_out.bk_shot[ibin] =
+        vol_ratio * vol_ratio * bispec_fold.bk_shot[ibin];
+    }
+  }
+
   if (trvs::currTask == 0) {
     trvs::logger.stat(
       "... computed bispectrum from a periodic-box simulation-type catalogue "
@@ -1091,11 +1272,286 @@ trv::BispecMeasurements compute_bispec_in_gpp_box(
   return bispec_out;
 }
 
+trv::BispecTriangleMeasurements compute_bispec_triangles_in_gpp_box(
+  ParticleCatalogue& catalogue_data,
+  trv::ParameterSet& params, trv::Binning& kbinning,
+  double norm_factor
+) {
+  trvs::StageTimer timer("bispec_triangles");
+
+  if (trvs::currTask == 0) {
+    trvs::logger.stat(
+      "Computing bispectrum monopole for all triangle configurations "
+      "from a periodic-box simulation-type catalogue..."
+    );
+  }
+
+  /// --------------------------------------------------------------------
+  /// Set-up
+  /// --------------------------------------------------------------------
+
+  /// Set up/check input.
+  if (!(params.ell1 == 0 && params.ell2 == 0 && params.ELL == 0)) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "All-triangle bispectrum measurements are only supported for "
+        "the monopole (ell1 = ell2 = ELL = 0)."
+      );
+      throw trvs::InvalidParameter(
+        "All-triangle bispectrum measurements are only supported for "
+        "the monopole (ell1 = ell2 = ELL = 0).\n"
+      );
+    }
+  }
+
+  const int num_bins = kbinning.num_bins;
+
+  /// Find triangle bins (i ≤ j ≤ l) which may contain closed triangles.
+  std::vector<int> itri_bins[3];
+  for (int ibin = 0; ibin < num_bins; ibin++) {
+    for (int jbin = ibin; jbin < num_bins; jbin++) {
+      for (int lbin = jbin; lbin < num_bins; lbin++) {
+        if (
+          kbinning.bin_edges[lbin]
+          > kbinning.bin_edges[ibin + 1] + kbinning.bin_edges[jbin + 1]
+        ) {break;}
+        itri_bins[0].push_back(ibin);
+        itri_bins[1].push_back(jbin);
+        itri_bins[2].push_back(lbin);
+      }
+    }
+  }
+  const int num_tri = itri_bins[0].size();
+
+  /// --------------------------------------------------------------------
+  /// Measurement
+  /// --------------------------------------------------------------------
+
+  trvs::init_fftw();
+
+  /// Compute common field quantities.
+  MeshField dn_00(params);  // δn_00(k)
+  dn_00.compute_unweighted_field_fluctuations_insitu(catalogue_data);
+  dn_00.fourier_transform();
+
+  /// Store the (real) shell fields of all wavenumber bins.
+  std::vector< std::vector<double> > shells(
+    num_bins, std::vector<double>(params.nmesh, 0.)
+  );
+  trvs::count_alloc(
+    trvs::size_in_gb<double>((long long)(num_bins) * params.nmesh),
+    trvs::MEM_MESH
+  );
+
+  MeshField shell(params);
+
+  auto store_shell = [&shell, &params](std::vector<double>& shell_store) {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+    for (int gid = 0; gid < params.nmesh; gid++) {
+      shell_store[gid] = shell[gid][0];
+    }
+  };
+
+  auto sum_shell_products = [&shells, &params](int ibin, int jbin, int lbin) {
+    double sum = 0.;
+#ifdef TRV_USE_OMP
+#pragma omp parallel for reduction(+:sum)
+#endif  // TRV_USE_OMP
+    for (int gid = 0; gid < params.nmesh; gid++) {
+      sum += shells[ibin][gid] * shells[jbin][gid] * shells[lbin][gid];
+    }
+    return sum;
+  };
+
+  /// Count triangles from unit shell fields, each averaged over its
+  /// (retained) modes, the number of which follows from Parseval's
+  /// identity as ``nmesh`` over the sum of the squared shell field.
+  std::vector<double> k_eff(num_bins, 0.);
+  std::vector<double> nmodes_shell(num_bins, 0.);
+
+  auto count_triangles = [&](
+    MeshField& shell_unit,
+    std::vector<double>& unit_sums_, std::vector<long long>& ntriangles_
+  ) {
+    for (int ibin = 0; ibin < num_bins; ibin++) {
+      int nmodes_;
+      shell_unit.inv_fourier_transform_unit_field_band_limited(
+        kbinning.bin_edges[ibin], kbinning.bin_edges[ibin + 1],
+        k_eff[ibin], nmodes_
+      );
+      if (nmodes_ == 0) {continue;}
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+      for (int gid = 0; gid < params.nmesh; gid++) {
+        shells[ibin][gid] = shell_unit[gid][0];
+      }
+
+      double sum_sq = 0.;
+#ifdef TRV_USE_OMP
+#pragma omp parallel for reduction(+:sum_sq)
+#endif  // TRV_USE_OMP
+      for (int gid = 0; gid < params.nmesh; gid++) {
+        sum_sq += shells[ibin][gid] * shells[ibin][gid];
+      }
+      nmodes_shell[ibin] = double(params.nmesh) / sum_sq;
+    }
+
+    for (int itri = 0; itri < num_tri; itri++) {
+      int ibin = itri_bins[0][itri];
+      int jbin = itri_bins[1][itri];
+      int lbin = itri_bins[2][itri];
+
+      unit_sums_[itri] = sum_shell_products(ibin, jbin, lbin);
+      ntriangles_[itri] = std::llround(
+        unit_sums_[itri] * nmodes_shell[ibin] * nmodes_shell[jbin]
+        * nmodes_shell[lbin] / double(params.nmesh)
+      );
+    }
+  };
+
+  /// With subsampling, triangles are counted in full from unsubsampled
+  /// unit shell fields (as bins report all modes but average over
+  /// retained ones), before the retained triangles are counted for
+  /// averaging.
+  std::vector<double> unit_sums(num_tri);
+  std::vector<long long> ntriangles(num_tri);
+  std::vector<long long> ntriangles_retained(num_tri);
+
+  if (
+    params.subsample_frac < 1.
+    && kbinning.bin_edges[num_bins - 1] >= params.subsample_kmin
+  ) {
+    trv::ParameterSet params_full = params;
+    params_full.subsample_frac = 1.;
+
+    MeshField shell_full(params_full);
+    count_triangles(shell_full, unit_sums, ntriangles);
+    shell_full.finalise_density_field();
+
+    count_triangles(shell, unit_sums, ntriangles_retained);
+  } else {
+    count_triangles(shell, unit_sums, ntriangles);
+    ntriangles_retained = ntriangles;
+  }
+
+  /// Compute the bispectrum from shell fields of density fluctuations
+  /// with the reduced spherical harmonic y_00 = 1.
+  std::vector< std::complex<double> > ylm_00(params.nmesh, 1.);
+  trvs::count_alloc(
+    trvs::size_in_gb< std::complex<double> >(params.nmesh), trvs::MEM_MODES
+  );
+
+  for (int ibin = 0; ibin < num_bins; ibin++) {
+    if (nmodes_shell[ibin] == 0.) {continue;}
+
+    double k_eff_;
+    int nmodes_;
+    shell.inv_fourier_transform_ylm_wgtd_field_band_limited(
+      dn_00, ylm_00, kbinning.bin_edges[ibin], kbinning.bin_edges[ibin + 1],
+      k_eff_, nmodes_
+    );
+
+    store_shell(shells[ibin]);
+  }
+
+  std::vector<double> bk_sums(num_tri, 0.);
+  for (int itri = 0; itri < num_tri; itri++) {
+    if (ntriangles_retained[itri] == 0) {continue;}
+    bk_sums[itri] = sum_shell_products(
+      itri_bins[0][itri], itri_bins[1][itri], itri_bins[2][itri]
+    );
+  }
+
+  trvs::count_dealloc(
+    trvs::size_in_gb< std::complex<double> >(params.nmesh), trvs::MEM_MODES
+  );
+  trvs::count_dealloc(
+    trvs::size_in_gb<double>((long long)(num_bins) * params.nmesh),
+    trvs::MEM_MESH
+  );
+  std::vector< std::vector<double> >().swap(shells);
+  shell.finalise_density_field();
+
+  /// Compute the shot noise, where under the global plane-parallel
+  /// approximation the field is unweighted from simulation sources.
+  MeshField N_00(params);  // N_00(k)
+  N_00.compute_unweighted_field(catalogue_data);
+  N_00.fourier_transform();
+
+  std::complex<double> Sbar_00 = double(catalogue_data.ntotal);  // \bar{S}_00
+
+  FieldStats stats_sn(params);  // S|{i ≠ j = k}
+  stats_sn.compute_ylm_wgtd_2pt_stats_in_fourier(
+    dn_00, N_00, Sbar_00, 0, 0, kbinning
+  );
+
+  dn_00.finalise_density_field();  // ~dn_00 (likely redundant but safe)
+  N_00.finalise_density_field();  // ~N_00 (likely redundant but safe)
+
+  /// --------------------------------------------------------------------
+  /// Results
+  /// --------------------------------------------------------------------
+
+  trv::BispecTriangleMeasurements bispec_out;
+  int ntri_unretained = 0;  // triangle bins with no retained triangles
+  for (int itri = 0; itri < num_tri; itri++) {
+    /// A subsampled triangle bin with triangles but none retained is
+    /// reported as empty.
+    if (ntriangles_retained[itri] == 0) {
+      if (ntriangles[itri] != 0) {ntri_unretained++;}
+      continue;
+    }
+
+    int ibins[3] = {itri_bins[0][itri], itri_bins[1][itri], itri_bins[2][itri]};
+
+    /// The raw bispectrum is averaged over closed triangles, and the shot
+    /// noise combines the (bin-averaged) power spectrum of each side.
+    std::complex<double> bk_raw = bk_sums[itri] / unit_sums[itri];
+    std::complex<double> bk_shot = Sbar_00;
+    for (int ibin : ibins) {
+      bk_shot += stats_sn.pk[ibin] - stats_sn.sn[ibin];
+    }
+
+    bispec_out.k1bin.push_back(kbinning.bin_centres[ibins[0]]);
+    bispec_out.k2bin.push_back(kbinning.bin_centres[ibins[1]]);
+    bispec_out.k3bin.push_back(kbinning.bin_centres[ibins[2]]);
+    bispec_out.k1eff.push_back(k_eff[ibins[0]]);
+    bispec_out.k2eff.push_back(k_eff[ibins[1]]);
+    bispec_out.k3eff.push_back(k_eff[ibins[2]]);
+    bispec_out.ntriangles.push_back(ntriangles[itri]);
+    bispec_out.bk_raw.push_back(norm_factor * bk_raw);
+    bispec_out.bk_shot.push_back(norm_factor * bk_shot);
+  }
+
+  if (ntri_unretained > 0 && trvs::currTask == 0) {
+    trvs::logger.warn(
+      "No triangles are retained under subsampling in %d triangle bin(s), "
+      "which are reported as empty. Consider raising `subsample_frac`.",
+      ntri_unretained
+    );
+  }
+
+  if (trvs::currTask == 0) {
+    trvs::logger.stat(
+      "... computed bispectrum monopole for all triangle configurations "
+      "from a periodic-box simulation-type catalogue."
+    );
+  }
+
+  return bispec_out;
+}
+
 trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
   ParticleCatalogue& catalogue_data,
   trv::ParameterSet& params, trv::Binning& rbinning,
   double norm_factor
 ) {
+  trvs::StageTimer timer("3pcf");
+
   if (trvs::currTask == 0) {
     trvs::logger.stat(
       "Computing three-point correlation function "
@@ -1131,22 +1587,22 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
   /// Measurement
   /// --------------------------------------------------------------------
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+  trvs::init_fftw();
 
   /// Compute common field quantities.
-  MeshField dn_00(params);  // δn_00(k)
+  MeshFieldBatch fields_00(params, 2);  // δn_00(k), N_00(k)
+
+  MeshField& dn_00 = fields_00[0];  // δn_00(k)
   dn_00.compute_unweighted_field_fluctuations_insitu(catalogue_data);
-  dn_00.fourier_transform();
 
   MeshField& dn_L0_for_sn = dn_00;  // δn_L0(k)
 
   double vol_cell = dn_00.vol_cell;
 
-  MeshField N_00(params);  // N_00(k)
+  MeshField& N_00 = fields_00[1];  // N_00(k)
   N_00.compute_unweighted_field(catalogue_data);
-  N_00.fourier_transform();
+
+  fields_00.fourier_transform();
 
   trvm::SphericalBesselCalculator sj_a(params.ell1);  // j_l_a
   trvm::SphericalBesselCalculator sj_b(params.ell2);  // j_l_b
@@ -1164,30 +1620,23 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
       );  // Wigner 3-j's
       if (std::fabs(coupling) < trvm::eps_coupling) {continue;}
 
-      /// Initialise/reset spherical harmonic mesh grids.
-      std::vector< std::complex<double> > ylm_r_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_r_b(params.nmesh);
-      std::vector< std::complex<double> > ylm_k_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_k_b(params.nmesh);
-      trvs::gbytesMem +=
-        trvs::size_in_gb< std::complex<double> >(4 * params.nmesh);
-      trvs::update_maxmem();
-
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_config_space(
-          params.ell1, m1_, params.boxsize, params.ngrid, ylm_r_a
+      /// Get reduced-spherical-harmonic weights on mesh grids, which are
+      /// shared with other measurements on the same mesh grids.
+      auto ylm_r_a = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_config_space(
+          params.ell1, m1_, params.boxsize, params.ngrid
         );
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_config_space(
-          params.ell2, m2_, params.boxsize, params.ngrid, ylm_r_b
+      auto ylm_r_b = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_config_space(
+          params.ell2, m2_, params.boxsize, params.ngrid
         );
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_fourier_space(
-          params.ell1, m1_, params.boxsize, params.ngrid, ylm_k_a
+      auto ylm_k_a = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_fourier_space(
+          params.ell1, m1_, params.boxsize, params.ngrid
         );
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_fourier_space(
-          params.ell2, m2_, params.boxsize, params.ngrid, ylm_k_b
+      auto ylm_k_b = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_fourier_space(
+          params.ell2, m2_, params.boxsize, params.ngrid
         );
 
       /// ································································
@@ -1202,7 +1651,7 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
 
       FieldStats stats_sn(params);  // S|{i = j ≠ k}
       stats_sn.compute_uncoupled_shotnoise_for_3pcf(
-        dn_L0_for_sn, N_00, ylm_r_a, ylm_r_b, Sbar_L0, rbinning
+        dn_L0_for_sn, N_00, *ylm_r_a, *ylm_r_b, Sbar_L0, rbinning
       );
 
       for (int ibin = 0; ibin < rbinning.num_bins; ibin++) {
@@ -1255,7 +1704,7 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
       if (params.form == "full") {
         double r_a = r1_save[params.idx_bin];
         F_lm_a.inv_fourier_transform_sjl_ylm_wgtd_field(
-          dn_00, ylm_k_a, sj_a, r_a
+          dn_00, *ylm_k_a, sj_a, r_a
         );
       }
 
@@ -1263,13 +1712,13 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
         double r_b = r2_save[ibin];
 
         F_lm_b.inv_fourier_transform_sjl_ylm_wgtd_field(
-          dn_00, ylm_k_b, sj_b, r_b
+          dn_00, *ylm_k_b, sj_b, r_b
         );
 
         if (params.form == "diag") {
           double r_a = r_b;
           F_lm_a.inv_fourier_transform_sjl_ylm_wgtd_field(
-            dn_00, ylm_k_a, sj_a, r_a
+            dn_00, *ylm_k_a, sj_a, r_a
           );
         }
 
@@ -1292,20 +1741,12 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
         );
       }
 
-      trvs::gbytesMem -=
-        trvs::size_in_gb< std::complex<double> >(4 * params.nmesh);
     }
   }
 
   dn_00.finalise_density_field();  // ~dn_00 (likely redundant but safe)
   N_00.finalise_density_field();  // ~N_00 (likely redundant but safe)
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_cleanup_threads();
-#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
-  fftw_cleanup();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-
   /// --------------------------------------------------------------------
   /// Results
   /// --------------------------------------------------------------------
@@ -1340,11 +1781,14 @@ trv::ThreePCFMeasurements compute_3pcf_in_gpp_box(
   return threepcf_out;
 }
 
+template <class LoSPolicy>
 trv::ThreePCFWindowMeasurements compute_3pcf_window(
-  ParticleCatalogue& catalogue_rand, LineOfSight* los_rand,
+  ParticleCatalogue& catalogue_rand, LoSPolicy los_rand,
   trv::ParameterSet& params, trv::Binning& rbinning,
   double alpha, double norm_factor, bool wide_angle
 ) {
+  trvs::StageTimer timer("3pcf_window");
+
   std::string msg_tag = wide_angle ? "wide-angle corrections " : "";
 
   if (trvs::currTask == 0) {
@@ -1382,20 +1826,20 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
   /// Measurement
   /// --------------------------------------------------------------------
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+  trvs::init_fftw();
 
   /// Compute common field quantities.
-  MeshField n_00(params);  // n_00(k)
+  MeshFieldBatch fields_00(params, 2);  // n_00(k), N_00(k)
+
+  MeshField& n_00 = fields_00[0];  // n_00(k)
   n_00.compute_ylm_wgtd_field(catalogue_rand, los_rand, alpha, 0, 0);
-  n_00.fourier_transform();
 
   double vol_cell = n_00.vol_cell;
 
-  MeshField N_00(params);  // N_00(k)
+  MeshField& N_00 = fields_00[1];  // N_00(k)
   N_00.compute_ylm_wgtd_quad_field(catalogue_rand, los_rand, alpha, 0, 0);
-  N_00.fourier_transform();
+
+  fields_00.fourier_transform();
 
   trvm::SphericalBesselCalculator sj_a(params.ell1);  // j_l_a
   trvm::SphericalBesselCalculator sj_b(params.ell2);  // j_l_b
@@ -1417,30 +1861,23 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
       }
       if (flag_vanishing == "true") {continue;}
 
-      /// Initialise reduced-spherical-harmonic weights on mesh grids.
-      std::vector< std::complex<double> > ylm_r_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_r_b(params.nmesh);
-      std::vector< std::complex<double> > ylm_k_a(params.nmesh);
-      std::vector< std::complex<double> > ylm_k_b(params.nmesh);
-      trvs::gbytesMem +=
-        trvs::size_in_gb< std::complex<double> >(4 * params.nmesh);
-      trvs::update_maxmem();
-
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_config_space(
-          params.ell1, m1_, params.boxsize, params.ngrid, ylm_r_a
+      /// Get reduced-spherical-harmonic weights on mesh grids, which are
+      /// shared with other measurements on the same mesh grids.
+      auto ylm_r_a = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_config_space(
+          params.ell1, m1_, params.boxsize, params.ngrid
         );
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_config_space(
-          params.ell2, m2_, params.boxsize, params.ngrid, ylm_r_b
+      auto ylm_r_b = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_config_space(
+          params.ell2, m2_, params.boxsize, params.ngrid
         );
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_fourier_space(
-          params.ell1, m1_, params.boxsize, params.ngrid, ylm_k_a
+      auto ylm_k_a = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_fourier_space(
+          params.ell1, m1_, params.boxsize, params.ngrid
         );
-      trvm::SphericalHarmonicCalculator::
-        store_reduced_spherical_harmonic_in_fourier_space(
-          params.ell2, m2_, params.boxsize, params.ngrid, ylm_k_b
+      auto ylm_k_b = trvm::SphericalHarmonicCalculator::
+        get_reduced_spherical_harmonic_in_fourier_space(
+          params.ell2, m2_, params.boxsize, params.ngrid
         );
 
       for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
@@ -1468,7 +1905,7 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
 
         FieldStats stats_sn(params);  // S|{i = j ≠ k}
         stats_sn.compute_uncoupled_shotnoise_for_3pcf(
-          n_LM_for_sn, N_00, ylm_r_a, ylm_r_b, Sbar_LM, rbinning
+          n_LM_for_sn, N_00, *ylm_r_a, *ylm_r_b, Sbar_LM, rbinning
         );
 
         for (int ibin = 0; ibin < rbinning.num_bins; ibin++) {
@@ -1527,7 +1964,7 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
         if (params.form == "full") {
           double r_a = r1_save[params.idx_bin];
           F_lm_a.inv_fourier_transform_sjl_ylm_wgtd_field(
-            n_00, ylm_k_a, sj_a, r_a
+            n_00, *ylm_k_a, sj_a, r_a
           );
         }
 
@@ -1535,13 +1972,13 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
           double r_b = r2_save[ibin];
 
           F_lm_b.inv_fourier_transform_sjl_ylm_wgtd_field(
-            n_00, ylm_k_b, sj_b, r_b
+            n_00, *ylm_k_b, sj_b, r_b
           );
 
           if (params.form == "diag") {
             double r_a = r_b;
             F_lm_a.inv_fourier_transform_sjl_ylm_wgtd_field(
-              n_00, ylm_k_a, sj_a, r_a
+              n_00, *ylm_k_a, sj_a, r_a
             );
           }
 
@@ -1565,20 +2002,12 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
         }
       }
 
-      trvs::gbytesMem -=
-        trvs::size_in_gb< std::complex<double> >(4 * params.nmesh);
     }
   }
 
   n_00.finalise_density_field();  // ~n_00 (likely redundant but safe)
   N_00.finalise_density_field();  // ~N_00 (likely redundant but safe)
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_cleanup_threads();
-#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
-  fftw_cleanup();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-
   /// --------------------------------------------------------------------
   /// Results
   /// --------------------------------------------------------------------
@@ -1614,9 +2043,10 @@ trv::ThreePCFWindowMeasurements compute_3pcf_window(
 }
 
 #ifdef TRV_USE_LEGACY_CODE
+template <class LoSPolicy>
 trv::BispecMeasurements compute_bispec_for_los_choice(
   ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
   int los_choice,
   trv::ParameterSet& params, trv::Binning& kbinning,
   double norm_factor
@@ -1658,9 +2088,7 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
   /// Measurement
   /// --------------------------------------------------------------------
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+  trvs::init_fftw();
 
   /// Compute common field quantities.
   MeshField dn_00(params);  // δn_00(r)
@@ -1700,9 +2128,10 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
       std::vector< std::complex<double> > ylm_k_b(params.nmesh);
       std::vector< std::complex<double> > ylm_r_a(params.nmesh);
       std::vector< std::complex<double> > ylm_r_b(params.nmesh);
-      trvs::gbytesMem +=
-        trvs::size_in_gb< std::complex<double> >(4 * params.nmesh);
-      trvs::update_maxmem();
+      trvs::count_alloc(
+        trvs::size_in_gb< std::complex<double> >(4LL * params.nmesh),
+        trvs::MEM_MODES
+      );
 
       trvm::SphericalHarmonicCalculator::
         store_reduced_spherical_harmonic_in_fourier_space(
@@ -1968,20 +2397,16 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
       delete[] ylm_k_b; ylm_k_b = nullptr;
       delete[] ylm_r_a; ylm_r_a = nullptr;
       delete[] ylm_r_b; ylm_r_b = nullptr;
-      trvs::gbytesMem -=
-        trvs::size_in_gb< std::complex<double> >(4 * params.nmesh);
+      trvs::count_dealloc(
+        trvs::size_in_gb< std::complex<double> >(4LL * params.nmesh),
+        trvs::MEM_MODES
+      );
     }
   }
 
   dn_00.finalise_density_field();  // ~dn_00 (likely redundant but safe)
   N_00.finalise_density_field();  // ~N_00 (likely redundant but safe)
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_cleanup_threads();
-#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
-  fftw_cleanup();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-
   /// --------------------------------------------------------------------
   /// Results
   /// --------------------------------------------------------------------
@@ -2017,4 +2442,78 @@ trv::BispecMeasurements compute_bispec_for_los_choice(
 }
 #endif  // TRV_USE_LEGACY_CODE
 
+
+/// **********************************************************************
+/// Explicit instantiations
+/// **********************************************************************
+
+/// Instantiate the line-of-sight-templated functions for each
+/// line-of-sight policy in @ref dataobjs.hpp.
+
+template std::complex<double>
+calc_ylm_wgtd_shotnoise_amp_for_bispec<StoredLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, StoredLineOfSight, StoredLineOfSight,
+  double, int, int
+);
+template std::complex<double>
+calc_ylm_wgtd_shotnoise_amp_for_bispec<StoredLineOfSight>(
+  ParticleCatalogue&, StoredLineOfSight, double, int, int
+);
+template trv::BispecMeasurements compute_bispec<StoredLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, StoredLineOfSight, StoredLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double
+);
+template trv::ThreePCFMeasurements compute_3pcf<StoredLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, StoredLineOfSight, StoredLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double
+);
+template trv::ThreePCFWindowMeasurements compute_3pcf_window<StoredLineOfSight>(
+  ParticleCatalogue&, StoredLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double, double, bool
+);
+
+template std::complex<double>
+calc_ylm_wgtd_shotnoise_amp_for_bispec<RadialLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, RadialLineOfSight, RadialLineOfSight,
+  double, int, int
+);
+template std::complex<double>
+calc_ylm_wgtd_shotnoise_amp_for_bispec<RadialLineOfSight>(
+  ParticleCatalogue&, RadialLineOfSight, double, int, int
+);
+template trv::BispecMeasurements compute_bispec<RadialLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, RadialLineOfSight, RadialLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double
+);
+template trv::ThreePCFMeasurements compute_3pcf<RadialLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, RadialLineOfSight, RadialLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double
+);
+template trv::ThreePCFWindowMeasurements compute_3pcf_window<RadialLineOfSight>(
+  ParticleCatalogue&, RadialLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double, double, bool
+);
+
+template std::complex<double>
+calc_ylm_wgtd_shotnoise_amp_for_bispec<GlobalLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, GlobalLineOfSight, GlobalLineOfSight,
+  double, int, int
+);
+template std::complex<double>
+calc_ylm_wgtd_shotnoise_amp_for_bispec<GlobalLineOfSight>(
+  ParticleCatalogue&, GlobalLineOfSight, double, int, int
+);
+template trv::BispecMeasurements compute_bispec<GlobalLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, GlobalLineOfSight, GlobalLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double
+);
+template trv::ThreePCFMeasurements compute_3pcf<GlobalLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, GlobalLineOfSight, GlobalLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double
+);
+template trv::ThreePCFWindowMeasurements compute_3pcf_window<GlobalLineOfSight>(
+  ParticleCatalogue&, GlobalLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double, double, bool
+);
+
 }  // namespace trv
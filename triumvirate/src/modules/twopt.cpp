@@ -52,11 +52,26 @@ double calc_coupling_coeff_2pt(int ell, int ELL, int m, int M) {
 double calc_powspec_normalisation_from_mesh(
   trv::ParticleCatalogue& particles, trv::ParameterSet& params, double alpha
 ) {
-  trv::MeshField catalogue_mesh(params);
+  auto calc_norm = [&]() {
+    trv::MeshField catalogue_mesh(params);
 
-  double norm_factor = catalogue_mesh.calc_grid_based_powlaw_norm(particles, 2);
+    double norm_factor =
+      catalogue_mesh.calc_grid_based_powlaw_norm(particles, 2);
 
-  catalogue_mesh.finalise_density_field();  // likely redundant but safe
+    catalogue_mesh.finalise_density_field();  // likely redundant but safe
+
+    return std::complex<double>(norm_factor, 0.);
+  };
+
+  double norm_factor;
+  if (particles.mesh_cache != nullptr) {
+    norm_factor = particles.mesh_cache->get_value(
+      "norm_mesh_2_" + RandomMeshCache::get_mesh_key(params, particles),
+      particles, calc_norm
+    ).real();
+  } else {
+    norm_factor = calc_norm().real();
+  }
 
   norm_factor /= std::pow(alpha, 2);
 
@@ -66,21 +81,107 @@ double calc_powspec_normalisation_from_mesh(
 double calc_powspec_normalisation_from_particles(
   ParticleCatalogue& particles, double alpha
 ) {
-  if (particles.pdata == nullptr) {
+  auto calc_norm = [&]() {
+    if (particles.pdata == nullptr) {
+      if (trvs::currTask == 0) {
+        trvs::logger.error("Particle data are uninitialised.");
+        throw trvs::InvalidData("Particle data are uninitialised.\n");
+      }
+    }
+
+    double norm = 0.;
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for reduction(+:norm)
+#endif  // TRV_USE_OMP
+    for (int pid = 0; pid < particles.ntotal; pid++) {
+      norm += particles[pid].ws
+        * particles[pid].nz * std::pow(particles[pid].wc, 2);
+    }
+
+    return std::complex<double>(norm, 0.);
+  };
+
+  double norm;  // I₂
+  if (particles.mesh_cache != nullptr) {
+    norm = particles.mesh_cache->get_value(
+      "norm_particle_2", particles, calc_norm
+    ).real();
+  } else {
+    norm = calc_norm().real();
+  }
+
+  if (norm == 0.) {
     if (trvs::currTask == 0) {
-      trvs::logger.error("Particle data are uninitialised.");
-      throw trvs::InvalidData("Particle data are uninitialised.\n");
+      trvs::logger.error(
+        "Particle 'nz' values appear to be all zeros. "
+        "Check the input catalogue contains valid 'nz' field."
+      );
+      throw trvs::InvalidData(
+        "Particle 'nz' values appear to be all zeros. "
+        "Check the input catalogue contains valid 'nz' field.\n"
+      );
     }
   }
 
+  double norm_factor = 1. / (alpha * norm);  // 1/I₂
+
+  return norm_factor;
+}
+
+
+double calc_powspec_normalisation_from_mesh(
+  trv::ParticleCatalogueStream& stream, trv::ParameterSet& params,
+  double alpha
+) {
+  trv::MeshField catalogue_mesh(params);
+
+  /// Assign the weighted field chunk by chunk, noting that the reduced
+  /// spherical harmonic of degree 0 is unity.
+  trv::GlobalLineOfSight los;
+
+  stream.rewind();
+  while (stream.read_next_chunk() > 0) {
+    catalogue_mesh.add_ylm_wgtd_field(stream.chunk, los, 1., 0, 0);
+  }
+
+  /// Compute normalisation volume integral, where ∫d³x ↔ dV Σᵢ,
+  /// dV =: `vol_cell`.
+  double vol_int = 0.;
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for reduction(+:vol_int)
+#endif  // TRV_USE_OMP
+  for (int gid = 0; gid < catalogue_mesh.local_nmesh; gid++) {
+    vol_int += std::pow(catalogue_mesh.field[gid][0], 2);
+  }
+
+  trvs::sum_across_tasks(&vol_int, 1);
+
+  vol_int *= catalogue_mesh.vol_cell;
+
+  catalogue_mesh.finalise_density_field();  // likely redundant but safe
+
+  double norm_factor = 1. / vol_int / std::pow(alpha, 2);
+
+  return norm_factor;
+}
+
+double calc_powspec_normalisation_from_particles(
+  ParticleCatalogueStream& stream, double alpha
+) {
   double norm = 0.;  // I₂
 
+  stream.rewind();
+  while (stream.read_next_chunk() > 0) {
+    ParticleCatalogue& chunk = stream.chunk;
+
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:norm)
 #endif  // TRV_USE_OMP
-  for (int pid = 0; pid < particles.ntotal; pid++) {
-    norm += particles[pid].ws
-      * particles[pid].nz * std::pow(particles[pid].wc, 2);
+    for (int pid = 0; pid < chunk.ntotal; pid++) {
+      norm += chunk[pid].ws * chunk[pid].nz * std::pow(chunk[pid].wc, 2);
+    }
   }
 
   if (norm == 0.) {
@@ -106,9 +207,9 @@ double calc_powspec_normalisation_from_particles(
 /// Shot noise
 /// **********************************************************************
 
-double calc_powspec_shotnoise_from_particles(
-  ParticleCatalogue& particles, double alpha
-) {
+double calc_powspec_shotnoise_from_particles(ParticleCatalogue& particles) {
+  trvs::StageTimer timer("shotnoise");
+
   if (particles.pdata == nullptr) {
     if (trvs::currTask == 0) {
       trvs::logger.error("Particle data are uninitialised.");
@@ -129,20 +230,22 @@ double calc_powspec_shotnoise_from_particles(
   return shotnoise;
 }
 
+template <class LoSPolicy>
 std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
   ParticleCatalogue& particles_data, ParticleCatalogue& particles_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
   double alpha, int ell, int m
 ) {
+  trvs::StageTimer timer("shotnoise");
+
   double sn_data_real = 0., sn_data_imag = 0.;
 
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:sn_data_real, sn_data_imag)
 #endif
   for (int pid = 0; pid < particles_data.ntotal; pid++) {
-    double los_[3] = {
-      los_data[pid].pos[0], los_data[pid].pos[1], los_data[pid].pos[2]
-    };
+    double los_[3];
+    los_data.eval(pid, particles_data[pid].pos, los_);
 
     std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
       calc_reduced_spherical_harmonic(ell, m, los_);
@@ -157,43 +260,63 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
 
   std::complex<double> sn_data(sn_data_real, sn_data_imag);
 
-  double sn_rand_real = 0., sn_rand_imag = 0.;
+  auto calc_sn_rand = [&]() {
+    double sn_rand_real = 0., sn_rand_imag = 0.;
 
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:sn_rand_real, sn_rand_imag)
 #endif
-  for (int pid = 0; pid < particles_rand.ntotal; pid++) {
-    double los_[3] = {
-      los_rand[pid].pos[0], los_rand[pid].pos[1], los_rand[pid].pos[2]
-    };
+    for (int pid = 0; pid < particles_rand.ntotal; pid++) {
+      double los_[3];
+      los_rand.eval(pid, particles_rand[pid].pos, los_);
 
-    std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
-      calc_reduced_spherical_harmonic(ell, m, los_);
+      std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
+        calc_reduced_spherical_harmonic(ell, m, los_);
 
-    std::complex<double> sn_part = ylm * std::pow(particles_rand[pid].w, 2);
-    double sn_part_real = sn_part.real();
-    double sn_part_imag = sn_part.imag();
+      std::complex<double> sn_part =
+        ylm * std::pow(particles_rand[pid].w, 2);
+      double sn_part_real = sn_part.real();
+      double sn_part_imag = sn_part.imag();
 
-    sn_rand_real += sn_part_real;
-    sn_rand_imag += sn_part_imag;
-  }
+      sn_rand_real += sn_part_real;
+      sn_rand_imag += sn_part_imag;
+    }
 
-  std::complex<double> sn_rand(sn_rand_real, sn_rand_imag);
+    return std::complex<double>(sn_rand_real, sn_rand_imag);
+  };
+
+  /// Random-source sums are shared across data-source catalogues
+  /// if cached.
+  std::complex<double> sn_rand;
+  if (particles_rand.mesh_cache != nullptr
+      && std::is_same<LoSPolicy, RadialLineOfSight>::value) {
+    char sn_name[32];
+    std::snprintf(sn_name, sizeof(sn_name), "sn_w2_l%d_m%d", ell, m);
+    sn_rand = particles_rand.mesh_cache->get_value(
+      sn_name, particles_rand, calc_sn_rand
+    );
+  } else {
+    sn_rand = calc_sn_rand();
+  }
 
   return sn_data + std::pow(alpha, 2) * sn_rand;
 }
 
+template <class LoSPolicy>
 std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
-  ParticleCatalogue& particles, LineOfSight* los,
+  ParticleCatalogue& particles, LoSPolicy los,
   double alpha, int ell, int m
 ) {
+  trvs::StageTimer timer("shotnoise");
+
   double sn_real = 0., sn_imag = 0.;
 
 #ifdef TRV_USE_OMP
 #pragma omp parallel for reduction(+:sn_real, sn_imag)
 #endif
   for (int pid = 0; pid < particles.ntotal; pid++) {
-    double los_[3] = {los[pid].pos[0], los[pid].pos[1], los[pid].pos[2]};
+    double los_[3];
+    los.eval(pid, particles[pid].pos, los_);
 
     std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
       calc_reduced_spherical_harmonic(ell, m, los_);
@@ -206,28 +329,715 @@ std::complex<double> calc_ylm_wgtd_shotnoise_amp_for_powspec(
     sn_imag += sn_part_imag;
   }
 
-  std::complex<double> sn(sn_real, sn_imag);
+  std::complex<double> sn(sn_real, sn_imag);
+
+  return std::pow(alpha, 2) * sn;
+}
+
+
+/// **********************************************************************
+/// Streamed fields
+/// **********************************************************************
+
+template <class LoSPolicy>
+void compute_ylm_wgtd_fields_for_2pt_streamed(
+  ParticleCatalogue& catalogue_data, ParticleCatalogueStream& stream_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
+  trv::ParameterSet& params, std::vector<int>& ells, double alpha,
+  MeshFieldBatch& dn_fields,
+  std::vector< std::vector< std::complex<double> > >& sn_amp,
+  double& norm_factor_part, double& norm_factor_mesh
+) {
+  const int nells = ells.size();
+
+  int nfields = 1;
+  for (int ELL : ells) {
+    if (ELL > 0) {nfields += 2*ELL + 1;}
+  }
+
+  if (dn_fields.nfields != nfields || int(sn_amp.size()) != nells) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Number of streamed fields does not match the multipole degrees."
+      );
+    }
+    throw trvs::InvalidParameter(
+      "Number of streamed fields does not match the multipole degrees.\n"
+    );
+  }
+
+  MeshField& dn_00 = dn_fields[0];
+
+  /// Reset all fields and sums before accumulation.
+  for (int ifield = 0; ifield < nfields; ifield++) {
+    dn_fields[ifield].initialise_density_field();
+  }
+  for (int iell = 0; iell < nells; iell++) {
+    sn_amp[iell].assign(2*ells[iell] + 1, 0.);
+  }
+
+  double norm_part = 0.;  // I₂ (particle-based)
+
+  /// Assign the random-source catalogue to all fields chunk by chunk,
+  /// with the particle-based normalisation accumulated alongside.
+  stream_rand.rewind();
+  while (stream_rand.read_next_chunk() > 0) {
+    ParticleCatalogue& chunk = stream_rand.chunk;
+
+    dn_00.add_ylm_wgtd_field(chunk, los_rand, - alpha, 0, 0);
+
+    int ifield = 1;
+    for (int iell = 0; iell < nells; iell++) {
+      const int ELL = ells[iell];
+      for (int M_ = - ELL; M_ <= ELL; M_++) {
+        if (ELL > 0) {
+          dn_fields[ifield + M_ + ELL].add_ylm_wgtd_field(
+            chunk, los_rand, - alpha, ELL, M_
+          );
+        }
+        sn_amp[iell][M_ + ELL] +=
+          trv::calc_ylm_wgtd_shotnoise_amp_for_powspec(
+            chunk, los_rand, alpha, ELL, M_
+          );
+      }
+      if (ELL > 0) {ifield += 2*ELL + 1;}
+    }
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for reduction(+:norm_part)
+#endif  // TRV_USE_OMP
+    for (int pid = 0; pid < chunk.ntotal; pid++) {
+      norm_part += chunk[pid].ws * chunk[pid].nz * std::pow(chunk[pid].wc, 2);
+    }
+  }
+
+  if (norm_part == 0.) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Particle 'nz' values appear to be all zeros. "
+        "Check the input catalogue contains valid 'nz' field."
+      );
+    }
+    throw trvs::InvalidData(
+      "Particle 'nz' values appear to be all zeros. "
+      "Check the input catalogue contains valid 'nz' field.\n"
+    );
+  }
+
+  /// Compute the mesh-based normalisation from the random-source part
+  /// of δn_00, i.e. -α times the weighted random-source field, before
+  /// the data-source catalogue is assigned.
+  double vol_int = 0.;
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for reduction(+:vol_int)
+#endif  // TRV_USE_OMP
+  for (int gid = 0; gid < dn_00.local_nmesh; gid++) {
+    vol_int += std::pow(dn_00.field[gid][0], 2);
+  }
+
+  trvs::sum_across_tasks(&vol_int, 1);
+
+  vol_int *= dn_00.vol_cell;
+
+  norm_factor_part = 1. / (alpha * norm_part);  // 1/I₂
+  norm_factor_mesh = 1. / vol_int;  // α² carried by δn_00
+
+  /// Assign the data-source catalogue held in memory.
+  dn_00.add_ylm_wgtd_field(catalogue_data, los_data, 1., 0, 0);
+
+  int ifield = 1;
+  for (int iell = 0; iell < nells; iell++) {
+    const int ELL = ells[iell];
+    for (int M_ = - ELL; M_ <= ELL; M_++) {
+      if (ELL > 0) {
+        dn_fields[ifield + M_ + ELL].add_ylm_wgtd_field(
+          catalogue_data, los_data, 1., ELL, M_
+        );
+      }
+      sn_amp[iell][M_ + ELL] += trv::calc_ylm_wgtd_shotnoise_amp_for_powspec(
+        catalogue_data, los_data, 1., ELL, M_
+      );
+    }
+    if (ELL > 0) {ifield += 2*ELL + 1;}
+  }
+}
+
+/**
+ * @brief Set the used and alternative normalisation factors by the
+ *        normalisation convention.
+ *
+ * @param[in] params Parameter set.
+ * @param[in] norm_factor_part Particle-based normalisation factor.
+ * @param[in] norm_factor_mesh Mesh-based normalisation factor.
+ * @param[out] norm_factor Normalisation factor (used).
+ * @param[out] norm_factor_alt Normalisation factor (alternative).
+ */
+void set_norm_factors_by_convention(
+  trv::ParameterSet& params,
+  double norm_factor_part, double norm_factor_mesh,
+  double& norm_factor, double& norm_factor_alt
+) {
+  if (params.norm_convention == "mesh") {
+    norm_factor = norm_factor_mesh;
+    norm_factor_alt = norm_factor_part;
+  } else {
+    norm_factor = norm_factor_part;
+    norm_factor_alt = norm_factor_mesh;
+  }
+}
+
+
+/// **********************************************************************
+/// Mesh folding
+/// **********************************************************************
+
+void set_folded_mesh_params(
+  trv::ParameterSet& params, trv::ParameterSet& params_fold
+) {
+  params_fold = params;
+  params_fold.fold_factor = 1;
+
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    params_fold.boxsize[iaxis] = params.boxsize[iaxis] / params.fold_factor;
+  }
+  params_fold.volume = params_fold.boxsize[0]
+    * params_fold.boxsize[1] * params_fold.boxsize[2];
+}
+
+void stitch_folded_measurements(
+  trv::ParameterSet& params, trv::ParameterSet& params_fold,
+  trv::Binning& kbinning,
+  trv::PowspecMeasurements& meas_fold, trv::PowspecMeasurements& meas
+) {
+  double vol_ratio = params.volume / params_fold.volume;
+
+  for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+    if (kbinning.bin_edges[ibin] < params.fold_kstitch) {continue;}
+
+    meas.keff[ibin] = meas_fold.keff[ibin];
+    meas.nmodes[ibin] = meas_fold.nmodes[ibin];
+    meas.pk_raw[ibin] = vol_ratio * meas_fold.pk_raw[ibin];
+    meas.pk_shot[ibin] = vol_ratio * meas_fold.pk_shot[ibin];
+  }
+}
+
+void stitch_folded_measurements(
+  trv::ParameterSet& params, trv::ParameterSet& params_fold,
+  trv::Binning& kbinning,
+  trv::PowspecWedgeMeasurements& meas_fold,
+  trv::PowspecWedgeMeasurements& meas
+) {
+  double vol_ratio = params.volume / params_fold.volume;
+
+  for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+    if (kbinning.bin_edges[ibin] < params.fold_kstitch) {continue;}
+
+    for (int imu = 0; imu < params.num_mu_bins; imu++) {
+      int iwedge = ibin * params.num_mu_bins + imu;
+      meas.keff[iwedge] = meas_fold.keff[iwedge];
+      meas.mueff[iwedge] = meas_fold.mueff[iwedge];
+      meas.nmodes[iwedge] = meas_fold.nmodes[iwedge];
+      meas.pk_raw[iwedge] = vol_ratio * meas_fold.pk_raw[iwedge];
+      meas.pk_shot[iwedge] = vol_ratio * meas_fold.pk_shot[iwedge];
+    }
+  }
+}
+
+
+/// **********************************************************************
+/// Full statistics
+/// **********************************************************************
+
+/// STYLE: Standard naming convention is not always followed for
+/// intermediary quantities in the functions below.
+
+/**
+ * @brief Get the global line of sight of a line-of-sight policy
+ *        for wedge binning.
+ *
+ * @tparam LoSPolicy Line-of-sight policy type.
+ * @param[in] los Line-of-sight policy.
+ * @param[out] los_out Global line-of-sight vector.
+ * @returns Whether the policy has a global line of sight.
+ */
+template <class LoSPolicy>
+bool get_global_los(const LoSPolicy& los, double los_out[3]) {
+  return false;
+}
+
+bool get_global_los(const GlobalLineOfSight& los, double los_out[3]) {
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    los_out[iaxis] = los.axis[iaxis];
+  }
+  return true;
+}
+
+template <class LoSPolicy>
+trv::PowspecMeasurements compute_powspec(
+  ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
+  trv::ParameterSet& params, trv::Binning& kbinning,
+  double norm_factor,
+  trv::PowspecWedgeMeasurements* wedges_out
+) {
+  trvs::StageTimer timer("powspec");
+
+  if (trvs::currTask == 0) {
+    trvs::logger.stat(
+      "Computing power spectrum from paired survey-type catalogues..."
+    );
+  }
+
+  /// --------------------------------------------------------------------
+  /// Set-up
+  /// --------------------------------------------------------------------
+
+  /// Set up input.
+  double alpha = catalogue_data.wtotal / catalogue_rand.wtotal;
+  int ell1 = params.ELL;
+
+  /// Wedges are binned with respect to the global line of sight.
+  const bool measure_wedges = wedges_out != nullptr && params.num_mu_bins > 0;
+
+  double los_wedges[3];
+  if (measure_wedges && !get_global_los(los_data, los_wedges)) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Power spectrum wedges from survey-type catalogues require "
+        "a global line of sight."
+      );
+    }
+    throw trvs::InvalidParameter(
+      "Power spectrum wedges from survey-type catalogues require "
+      "a global line of sight.\n"
+    );
+  }
+
+  /// Set up output.
+  int* nmodes_save = new int[kbinning.num_bins];
+  double* k_save = new double[kbinning.num_bins];
+  std::complex<double>* pk_save = new std::complex<double>[kbinning.num_bins];
+  std::complex<double>* sn_save = new std::complex<double>[kbinning.num_bins];
+  for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+    nmodes_save[ibin] = 0;
+    k_save[ibin] = 0.;
+    pk_save[ibin] = 0.;
+    sn_save[ibin] = 0.;
+  }  // likely redundant but safe
+
+  /// --------------------------------------------------------------------
+  /// Measurement
+  /// --------------------------------------------------------------------
+
+  trvs::init_fftw();
+
+  MeshField dn_00(params);  // δn_00(k)
+  dn_00.compute_ylm_wgtd_field(
+    catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
+  );
+  dn_00.fourier_transform();
+
+  for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
+    MeshField dn_LM(params);  // δn_LM(k)
+    dn_LM.compute_ylm_wgtd_field(
+      catalogue_data, catalogue_rand, los_data, los_rand, alpha, params.ELL, M_
+    );
+    dn_LM.fourier_transform();
+
+    std::complex<double> sn_amp = trv::calc_ylm_wgtd_shotnoise_amp_for_powspec(
+      catalogue_data, catalogue_rand, los_data, los_rand, alpha, params.ELL, M_
+    );  // \bar{N}_LM(k)
+
+    /// Compute quantity equivalent to (-1)^m₁ δᴰ_{m₁, -M} which, after
+    /// being summed over m₁, agrees with Hand et al. (2017) [1704.02357].
+    FieldStats stats_2pt(params);
+
+    /// Wedges are binned from the auto-power of δn_00 in the pass at
+    /// order M = 0.
+    if (measure_wedges && M_ == 0) {
+      std::complex<double> sn_amp_00 =
+        trv::calc_ylm_wgtd_shotnoise_amp_for_powspec(
+          catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
+        );  // \bar{N}_00(k)
+      stats_2pt.set_wedge_binning(params.num_mu_bins, los_wedges, sn_amp_00);
+    }
+
+    for (int m1 = - ell1; m1 <= ell1; m1++) {
+      double coupling = calc_coupling_coeff_2pt(ell1, params.ELL, m1, M_);
+      if (std::fabs(coupling) < trvm::eps_coupling) {continue;}
+
+      stats_2pt.compute_ylm_wgtd_2pt_stats_in_fourier(
+        dn_LM, dn_00, sn_amp, ell1, m1, kbinning
+      );
+
+      for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+        pk_save[ibin] += coupling * stats_2pt.pk[ibin];
+        sn_save[ibin] += coupling * stats_2pt.sn[ibin];
+      }
+
+      if (M_ == 0 && m1 == 0) {
+        for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+          nmodes_save[ibin] = stats_2pt.nmodes[ibin];
+          k_save[ibin] = stats_2pt.k[ibin];
+        }
+
+        if (measure_wedges) {
+          *wedges_out = trv::PowspecWedgeMeasurements();
+          for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+            for (int imu = 0; imu < params.num_mu_bins; imu++) {
+              int iwedge = ibin * params.num_mu_bins + imu;
+              wedges_out->kbin.push_back(kbinning.bin_centres[ibin]);
+              wedges_out->mubin.push_back((imu + 0.5) / params.num_mu_bins);
+              wedges_out->keff.push_back(stats_2pt.k_wedges[iwedge]);
+              wedges_out->mueff.push_back(stats_2pt.mu_wedges[iwedge]);
+              wedges_out->nmodes.push_back(stats_2pt.nmodes_wedges[iwedge]);
+              wedges_out->pk_raw.push_back(
+                norm_factor * stats_2pt.pk_wedges[iwedge]
+              );
+              wedges_out->pk_shot.push_back(
+                norm_factor * stats_2pt.sn_wedges[iwedge]
+              );
+            }
+          }
+        }
+      }
+    }
+
+    if (trvs::currTask == 0) {
+      trvs::logger.stat("Power spectrum term at order M = %d computed.", M_);
+    }
+  }
+
+  /// --------------------------------------------------------------------
+  /// Results
+  /// --------------------------------------------------------------------
+
+  trv::PowspecMeasurements powspec_out;
+  for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+    powspec_out.kbin.push_back(kbinning.bin_centres[ibin]);
+    powspec_out.keff.push_back(k_save[ibin]);
+    powspec_out.nmodes.push_back(nmodes_save[ibin]);
+    powspec_out.pk_raw.push_back(norm_factor * pk_save[ibin]);
+    powspec_out.pk_shot.push_back(norm_factor * sn_save[ibin]);
+  }
+
+  delete[] nmodes_save; delete[] k_save; delete[] pk_save; delete[] sn_save;
+
+  if (trvs::currTask == 0) {
+    trvs::logger.stat(
+      "... computed power spectrum from paired survey-type catalogues."
+    );
+  }
+
+  return powspec_out;
+}
+
+template <class LoSPolicy>
+std::vector<trv::PowspecMeasurements> compute_powspec_multipoles(
+  ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
+  trv::ParameterSet& params, std::vector<int>& ells, trv::Binning& kbinning,
+  double norm_factor
+) {
+  trvs::StageTimer timer("powspec");
+
+  if (trvs::currTask == 0) {
+    trvs::logger.stat(
+      "Computing power spectrum multipoles "
+      "from paired survey-type catalogues..."
+    );
+  }
+
+  /// --------------------------------------------------------------------
+  /// Set-up
+  /// --------------------------------------------------------------------
+
+  /// Check input multipole degrees.
+  if (ells.empty() || *std::min_element(ells.begin(), ells.end()) < 0) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Power spectrum multipole degrees must be non-empty "
+        "and non-negative."
+      );
+    }
+    throw trvs::InvalidParameter(
+      "Power spectrum multipole degrees must be non-empty "
+      "and non-negative.\n"
+    );
+  }
+
+  /// Set up input.
+  double alpha = catalogue_data.wtotal / catalogue_rand.wtotal;
+  const int nells = ells.size();
+  const int ELL_max = *std::max_element(ells.begin(), ells.end());
+
+  /// Set up output.
+  std::vector<int> nmodes_save(kbinning.num_bins, 0);
+  std::vector<double> k_save(kbinning.num_bins, 0.);
+  std::vector< std::vector< std::complex<double> > > pk_save(
+    nells, std::vector< std::complex<double> >(kbinning.num_bins, 0.)
+  );
+  std::vector< std::vector< std::complex<double> > > sn_save(
+    nells, std::vector< std::complex<double> >(kbinning.num_bins, 0.)
+  );
+
+  /// --------------------------------------------------------------------
+  /// Measurement
+  /// --------------------------------------------------------------------
+
+  trvs::init_fftw();
+
+  MeshField dn_00(params);  // δn_00(k)
+  dn_00.compute_ylm_wgtd_field(
+    catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
+  );
+  dn_00.fourier_transform();
+
+  /// Group the multipoles sharing each order M so that every field
+  /// δn_LM is assigned and transformed exactly once, with δn_00 reused
+  /// for the monopole, and all terms of the same order are binned in
+  /// a single pass over the mesh.
+  for (int M_ = - ELL_max; M_ <= ELL_max; M_++) {
+    std::vector<int> iells;  // multipole indices with L >= |M|
+    int nfields = 0;         // number of fields δn_LM with L > 0
+    for (int iell = 0; iell < nells; iell++) {
+      if (ells[iell] >= std::abs(M_)) {
+        iells.push_back(iell);
+        if (ells[iell] > 0) {nfields++;}
+      }
+    }
+    if (iells.empty()) {continue;}
+
+    std::unique_ptr<MeshFieldBatch> dn_LMs;  // δn_LM(k)
+    if (nfields > 0) {
+      dn_LMs.reset(new MeshFieldBatch(params, nfields));
+    }
+
+    std::vector<MeshField*> fields_a;
+    std::vector< std::complex<double> > sn_amps;
+    std::vector<int> ells_a, ms_a;
+    int ifield = 0;
+    for (int iell : iells) {
+      int ELL = ells[iell];
+      if (ELL == 0) {
+        fields_a.push_back(&dn_00);
+      } else {
+        (*dn_LMs)[ifield].compute_ylm_wgtd_field(
+          catalogue_data, catalogue_rand, los_data, los_rand, alpha, ELL, M_
+        );
+        fields_a.push_back(&(*dn_LMs)[ifield]);
+        ifield++;
+      }
+
+      sn_amps.push_back(trv::calc_ylm_wgtd_shotnoise_amp_for_powspec(
+        catalogue_data, catalogue_rand, los_data, los_rand, alpha, ELL, M_
+      ));  // \bar{N}_LM(k)
+
+      /// The coupling (-1)^m₁ δᴰ_{m₁, -M} is only non-zero at m₁ = -M.
+      ells_a.push_back(ELL);
+      ms_a.push_back(- M_);
+    }
+
+    if (dn_LMs) {
+      dn_LMs->fourier_transform();
+    }
+
+    FieldStats stats_2pt(params);
+    stats_2pt.compute_ylm_wgtd_2pt_stats_in_fourier(
+      fields_a, dn_00, sn_amps, ells_a, ms_a, kbinning
+    );
+
+    for (int iterm = 0; iterm < int(iells.size()); iterm++) {
+      int iell = iells[iterm];
+      double coupling =
+        calc_coupling_coeff_2pt(ells[iell], ells[iell], - M_, M_);
+      for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+        pk_save[iell][ibin] += coupling * stats_2pt.pk_terms[iterm][ibin];
+        sn_save[iell][ibin] += coupling * stats_2pt.sn_terms[iterm][ibin];
+      }
+    }
+
+    if (M_ == 0) {
+      for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+        nmodes_save[ibin] = stats_2pt.nmodes[ibin];
+        k_save[ibin] = stats_2pt.k[ibin];
+      }
+    }
+
+    dn_LMs.reset();
+
+    if (trvs::currTask == 0) {
+      trvs::logger.stat(
+        "Power spectrum terms at order M = %d computed.", M_
+      );
+    }
+  }
+
+  /// --------------------------------------------------------------------
+  /// Results
+  /// --------------------------------------------------------------------
+
+  std::vector<trv::PowspecMeasurements> powspec_out(nells);
+  for (int iell = 0; iell < nells; iell++) {
+    for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+      powspec_out[iell].kbin.push_back(kbinning.bin_centres[ibin]);
+      powspec_out[iell].keff.push_back(k_save[ibin]);
+      powspec_out[iell].nmodes.push_back(nmodes_save[ibin]);
+      powspec_out[iell].pk_raw.push_back(norm_factor * pk_save[iell][ibin]);
+      powspec_out[iell].pk_shot.push_back(norm_factor * sn_save[iell][ibin]);
+    }
+  }
+
+  if (trvs::currTask == 0) {
+    trvs::logger.stat(
+      "... computed power spectrum multipoles "
+      "from paired survey-type catalogues."
+    );
+  }
+
+  return powspec_out;
+}
+
+template <class LoSPolicy>
+trv::TwoPCFMeasurements compute_corrfunc(
+  ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
+  trv::ParameterSet& params, trv::Binning& rbinning,
+  double norm_factor
+) {
+  trvs::StageTimer timer("corrfunc");
+
+  if (trvs::currTask == 0) {
+    trvs::logger.stat(
+      "Computing two-point correlation function from "
+      "paired survey-type catalogues..."
+    );
+  }
+
+  /// --------------------------------------------------------------------
+  /// Set-up
+  /// --------------------------------------------------------------------
+
+  /// Set up input.
+  double alpha = catalogue_data.wtotal / catalogue_rand.wtotal;
+  int ell1 = params.ELL;
+
+  /// Set up output.
+  int* npairs_save = new int[rbinning.num_bins];
+  double* r_save = new double[rbinning.num_bins];
+  std::complex<double>* xi_save = new std::complex<double>[rbinning.num_bins];
+  for (int ibin = 0; ibin < rbinning.num_bins; ibin++) {
+    npairs_save[ibin] = 0;
+    r_save[ibin] = 0.;
+    xi_save[ibin] = 0.;
+  }  // likely redundant but safe
+
+  /// --------------------------------------------------------------------
+  /// Measurement
+  /// --------------------------------------------------------------------
+
+  trvs::init_fftw();
+
+  MeshField dn_00(params);  // δn_00(k)
+  dn_00.compute_ylm_wgtd_field(
+    catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
+  );
+  dn_00.fourier_transform();
+
+  for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
+    MeshField dn_LM(params);  // δn_LM(k)
+    dn_LM.compute_ylm_wgtd_field(
+      catalogue_data, catalogue_rand, los_data, los_rand, alpha, params.ELL, M_
+    );
+    dn_LM.fourier_transform();
+
+    std::complex<double> sn_amp = trv::calc_ylm_wgtd_shotnoise_amp_for_powspec(
+      catalogue_data, catalogue_rand, los_data, los_rand, alpha, params.ELL, M_
+    );  // \bar{N}_LM(k)
+
+    /// Compute quantity equivalent to (-1)^m₁ δᴰ_{m₁, -M} which, after
+    /// being summed over m₁, agrees with Hand et al. (2017) [1704.02357].
+    FieldStats stats_2pt(params);
+    for (int m1 = - ell1; m1 <= ell1; m1++) {
+      double coupling = calc_coupling_coeff_2pt(ell1, params.ELL, m1, M_);
+      if (std::fabs(coupling) < trvm::eps_coupling) {continue;}
+
+      stats_2pt.compute_ylm_wgtd_2pt_stats_in_config(
+        dn_LM, dn_00, sn_amp, ell1, m1, rbinning
+      );
+
+      for (int ibin = 0; ibin < rbinning.num_bins; ibin++) {
+        xi_save[ibin] += coupling * stats_2pt.xi[ibin];
+      }
+
+      if (M_ == 0 && m1 == 0) {
+        for (int ibin = 0; ibin < rbinning.num_bins; ibin++) {
+          npairs_save[ibin] = stats_2pt.npairs[ibin];
+          r_save[ibin] = stats_2pt.r[ibin];
+        }
+      }
+    }
+
+    if (trvs::currTask == 0) {
+      trvs::logger.stat(
+        "Two-point correlation function term at order M = %d computed.", M_
+      );
+    }
+  }
+
+  /// --------------------------------------------------------------------
+  /// Results
+  /// --------------------------------------------------------------------
 
-  return std::pow(alpha, 2) * sn;
-}
+  trv::TwoPCFMeasurements corrfunc_out;
+  for (int ibin = 0; ibin < rbinning.num_bins; ibin++) {
+    corrfunc_out.rbin.push_back(rbinning.bin_centres[ibin]);
+    corrfunc_out.reff.push_back(r_save[ibin]);
+    corrfunc_out.npairs.push_back(npairs_save[ibin]);
+    corrfunc_out.xi.push_back(norm_factor * xi_save[ibin]);
+  }
 
+  delete[] npairs_save; delete[] r_save; delete[] xi_save;
 
-/// **********************************************************************
-/// Full statistics
-/// **********************************************************************
+  if (trvs::currTask == 0) {
+    trvs::logger.stat(
+      "... computed two-point correlation function "
+      "from paired survey-type catalogues."
+    );
+  }
 
-/// STYLE: Standard naming convention is not always followed for
-/// intermediary quantities in the functions below.
+  return corrfunc_out;
+}
 
+template <class LoSPolicy>
 trv::PowspecMeasurements compute_powspec(
-  ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  ParticleCatalogue& catalogue_data, ParticleCatalogueStream& stream_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
   trv::ParameterSet& params, trv::Binning& kbinning,
-  double norm_factor
+  double& norm_factor, double& norm_factor_alt
+) {
+  std::vector<int> ells{params.ELL};
+
+  return trv::compute_powspec_multipoles(
+    catalogue_data, stream_rand, los_data, los_rand,
+    params, ells, kbinning, norm_factor, norm_factor_alt
+  )[0];
+}
+
+template <class LoSPolicy>
+std::vector<trv::PowspecMeasurements> compute_powspec_multipoles(
+  ParticleCatalogue& catalogue_data, ParticleCatalogueStream& stream_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
+  trv::ParameterSet& params, std::vector<int>& ells, trv::Binning& kbinning,
+  double& norm_factor, double& norm_factor_alt
 ) {
+  trvs::StageTimer timer("powspec");
+
   if (trvs::currTask == 0) {
     trvs::logger.stat(
-      "Computing power spectrum from paired survey-type catalogues..."
+      "Computing power spectrum from paired survey-type catalogues "
+      "with streamed random-source catalogue..."
     );
   }
 
@@ -235,116 +1045,160 @@ trv::PowspecMeasurements compute_powspec(
   /// Set-up
   /// --------------------------------------------------------------------
 
+  /// Check input multipole degrees.
+  if (ells.empty() || *std::min_element(ells.begin(), ells.end()) < 0) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Power spectrum multipole degrees must be non-empty "
+        "and non-negative."
+      );
+    }
+    throw trvs::InvalidParameter(
+      "Power spectrum multipole degrees must be non-empty "
+      "and non-negative.\n"
+    );
+  }
+
   /// Set up input.
-  double alpha = catalogue_data.wtotal / catalogue_rand.wtotal;
-  int ell1 = params.ELL;
+  double alpha = catalogue_data.wtotal / stream_rand.catalogue.wtotal;
+  const int nells = ells.size();
+  const int ELL_max = *std::max_element(ells.begin(), ells.end());
+
+  std::vector<int> field_offsets(nells, 0);  // δn_LM offsets in the batch
+  int nfields = 1;
+  for (int iell = 0; iell < nells; iell++) {
+    field_offsets[iell] = nfields;
+    if (ells[iell] > 0) {nfields += 2*ells[iell] + 1;}
+  }
 
   /// Set up output.
-  int* nmodes_save = new int[kbinning.num_bins];
-  double* k_save = new double[kbinning.num_bins];
-  std::complex<double>* pk_save = new std::complex<double>[kbinning.num_bins];
-  std::complex<double>* sn_save = new std::complex<double>[kbinning.num_bins];
-  for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
-    nmodes_save[ibin] = 0;
-    k_save[ibin] = 0.;
-    pk_save[ibin] = 0.;
-    sn_save[ibin] = 0.;
-  }  // likely redundant but safe
+  std::vector<int> nmodes_save(kbinning.num_bins, 0);
+  std::vector<double> k_save(kbinning.num_bins, 0.);
+  std::vector< std::vector< std::complex<double> > > pk_save(
+    nells, std::vector< std::complex<double> >(kbinning.num_bins, 0.)
+  );
+  std::vector< std::vector< std::complex<double> > > sn_save(
+    nells, std::vector< std::complex<double> >(kbinning.num_bins, 0.)
+  );
 
   /// --------------------------------------------------------------------
   /// Measurement
   /// --------------------------------------------------------------------
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+  trvs::init_fftw();
 
-  MeshField dn_00(params);  // δn_00(k)
-  dn_00.compute_ylm_wgtd_field(
-    catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
+  /// Compute all fields and the normalisation factors in a single pass
+  /// over the streamed catalogue and transform the fields together.
+  MeshFieldBatch dn_fields(params, nfields);  // δn_00(k), δn_LM(k)
+  std::vector< std::vector< std::complex<double> > > sn_amp(
+    nells
+  );  // \bar{N}_LM(k)
+  double norm_factor_part, norm_factor_mesh;
+
+  trv::compute_ylm_wgtd_fields_for_2pt_streamed(
+    catalogue_data, stream_rand, los_data, los_rand, params, ells, alpha,
+    dn_fields, sn_amp, norm_factor_part, norm_factor_mesh
+  );
+  set_norm_factors_by_convention(
+    params, norm_factor_part, norm_factor_mesh, norm_factor, norm_factor_alt
   );
-  dn_00.fourier_transform();
 
-  for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
-    MeshField dn_LM(params);  // δn_LM(k)
-    dn_LM.compute_ylm_wgtd_field(
-      catalogue_data, catalogue_rand, los_data, los_rand, alpha, params.ELL, M_
-    );
-    dn_LM.fourier_transform();
+  dn_fields.fourier_transform();
+
+  MeshField& dn_00 = dn_fields[0];  // δn_00(k)
+
+  /// Bin all multipoles of the same order M in a single pass over
+  /// the mesh, with δn_00 reused for the monopole.
+  for (int M_ = - ELL_max; M_ <= ELL_max; M_++) {
+    std::vector<int> iells;  // multipole indices with L >= |M|
+    std::vector<MeshField*> fields_a;
+    std::vector< std::complex<double> > sn_amps;
+    std::vector<int> ells_a, ms_a;
+    for (int iell = 0; iell < nells; iell++) {
+      const int ELL = ells[iell];
+      if (ELL < std::abs(M_)) {continue;}
+
+      iells.push_back(iell);
+      if (ELL == 0) {
+        fields_a.push_back(&dn_00);
+      } else {
+        fields_a.push_back(&dn_fields[field_offsets[iell] + M_ + ELL]);
+      }
+      sn_amps.push_back(sn_amp[iell][M_ + ELL]);
 
-    std::complex<double> sn_amp = trv::calc_ylm_wgtd_shotnoise_amp_for_powspec(
-      catalogue_data, catalogue_rand, los_data, los_rand, alpha, params.ELL, M_
-    );  // \bar{N}_LM(k)
+      /// The coupling (-1)^m₁ δᴰ_{m₁, -M} is only non-zero at m₁ = -M.
+      ells_a.push_back(ELL);
+      ms_a.push_back(- M_);
+    }
+    if (iells.empty()) {continue;}
 
-    /// Compute quantity equivalent to (-1)^m₁ δᴰ_{m₁, -M} which, after
-    /// being summed over m₁, agrees with Hand et al. (2017) [1704.02357].
     FieldStats stats_2pt(params);
-    for (int m1 = - ell1; m1 <= ell1; m1++) {
-      double coupling = calc_coupling_coeff_2pt(ell1, params.ELL, m1, M_);
-      if (std::fabs(coupling) < trvm::eps_coupling) {continue;}
-
-      stats_2pt.compute_ylm_wgtd_2pt_stats_in_fourier(
-        dn_LM, dn_00, sn_amp, ell1, m1, kbinning
-      );
+    stats_2pt.compute_ylm_wgtd_2pt_stats_in_fourier(
+      fields_a, dn_00, sn_amps, ells_a, ms_a, kbinning
+    );
 
+    for (int iterm = 0; iterm < int(iells.size()); iterm++) {
+      int iell = iells[iterm];
+      double coupling =
+        calc_coupling_coeff_2pt(ells[iell], ells[iell], - M_, M_);
       for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
-        pk_save[ibin] += coupling * stats_2pt.pk[ibin];
-        sn_save[ibin] += coupling * stats_2pt.sn[ibin];
+        pk_save[iell][ibin] += coupling * stats_2pt.pk_terms[iterm][ibin];
+        sn_save[iell][ibin] += coupling * stats_2pt.sn_terms[iterm][ibin];
       }
+    }
 
-      if (M_ == 0 && m1 == 0) {
-        for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
-          nmodes_save[ibin] = stats_2pt.nmodes[ibin];
-          k_save[ibin] = stats_2pt.k[ibin];
-        }
+    if (M_ == 0) {
+      for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+        nmodes_save[ibin] = stats_2pt.nmodes[ibin];
+        k_save[ibin] = stats_2pt.k[ibin];
       }
     }
 
     if (trvs::currTask == 0) {
-      trvs::logger.stat("Power spectrum term at order M = %d computed.", M_);
+      trvs::logger.stat(
+        "Power spectrum terms at order M = %d computed.", M_
+      );
     }
   }
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_cleanup_threads();
-#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
-  fftw_cleanup();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-
   /// --------------------------------------------------------------------
   /// Results
   /// --------------------------------------------------------------------
 
-  trv::PowspecMeasurements powspec_out;
-  for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
-    powspec_out.kbin.push_back(kbinning.bin_centres[ibin]);
-    powspec_out.keff.push_back(k_save[ibin]);
-    powspec_out.nmodes.push_back(nmodes_save[ibin]);
-    powspec_out.pk_raw.push_back(norm_factor * pk_save[ibin]);
-    powspec_out.pk_shot.push_back(norm_factor * sn_save[ibin]);
+  std::vector<trv::PowspecMeasurements> powspec_out(nells);
+  for (int iell = 0; iell < nells; iell++) {
+    for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+      powspec_out[iell].kbin.push_back(kbinning.bin_centres[ibin]);
+      powspec_out[iell].keff.push_back(k_save[ibin]);
+      powspec_out[iell].nmodes.push_back(nmodes_save[ibin]);
+      powspec_out[iell].pk_raw.push_back(norm_factor * pk_save[iell][ibin]);
+      powspec_out[iell].pk_shot.push_back(norm_factor * sn_save[iell][ibin]);
+    }
   }
 
-  delete[] nmodes_save; delete[] k_save; delete[] pk_save; delete[] sn_save;
-
   if (trvs::currTask == 0) {
     trvs::logger.stat(
-      "... computed power spectrum from paired survey-type catalogues."
+      "... computed power spectrum from paired survey-type catalogues "
+      "with streamed random-source catalogue."
     );
   }
 
   return powspec_out;
 }
 
+template <class LoSPolicy>
 trv::TwoPCFMeasurements compute_corrfunc(
-  ParticleCatalogue& catalogue_data, ParticleCatalogue& catalogue_rand,
-  LineOfSight* los_data, LineOfSight* los_rand,
+  ParticleCatalogue& catalogue_data, ParticleCatalogueStream& stream_rand,
+  LoSPolicy los_data, LoSPolicy los_rand,
   trv::ParameterSet& params, trv::Binning& rbinning,
-  double norm_factor
+  double& norm_factor, double& norm_factor_alt
 ) {
+  trvs::StageTimer timer("corrfunc");
+
   if (trvs::currTask == 0) {
     trvs::logger.stat(
       "Computing two-point correlation function from "
-      "paired survey-type catalogues..."
+      "paired survey-type catalogues with streamed random-source catalogue..."
     );
   }
 
@@ -353,7 +1207,7 @@ trv::TwoPCFMeasurements compute_corrfunc(
   /// --------------------------------------------------------------------
 
   /// Set up input.
-  double alpha = catalogue_data.wtotal / catalogue_rand.wtotal;
+  double alpha = catalogue_data.wtotal / stream_rand.catalogue.wtotal;
   int ell1 = params.ELL;
 
   /// Set up output.
@@ -370,26 +1224,34 @@ trv::TwoPCFMeasurements compute_corrfunc(
   /// Measurement
   /// --------------------------------------------------------------------
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-
-  MeshField dn_00(params);  // δn_00(k)
-  dn_00.compute_ylm_wgtd_field(
-    catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
+  trvs::init_fftw();
+
+  /// Compute all fields and the normalisation factors in a single pass
+  /// over the streamed catalogue and transform the fields together.
+  std::vector<int> ells{params.ELL};
+  MeshFieldBatch dn_fields(
+    params, params.ELL > 0 ? 2*params.ELL + 2 : 1
+  );  // δn_00(k), δn_LM(k)
+  std::vector< std::vector< std::complex<double> > > sn_amp(
+    1
+  );  // \bar{N}_LM(k)
+  double norm_factor_part, norm_factor_mesh;
+
+  trv::compute_ylm_wgtd_fields_for_2pt_streamed(
+    catalogue_data, stream_rand, los_data, los_rand, params, ells, alpha,
+    dn_fields, sn_amp, norm_factor_part, norm_factor_mesh
+  );
+  set_norm_factors_by_convention(
+    params, norm_factor_part, norm_factor_mesh, norm_factor, norm_factor_alt
   );
-  dn_00.fourier_transform();
 
-  for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
-    MeshField dn_LM(params);  // δn_LM(k)
-    dn_LM.compute_ylm_wgtd_field(
-      catalogue_data, catalogue_rand, los_data, los_rand, alpha, params.ELL, M_
-    );
-    dn_LM.fourier_transform();
+  dn_fields.fourier_transform();
 
-    std::complex<double> sn_amp = trv::calc_ylm_wgtd_shotnoise_amp_for_powspec(
-      catalogue_data, catalogue_rand, los_data, los_rand, alpha, params.ELL, M_
-    );  // \bar{N}_LM(k)
+  MeshField& dn_00 = dn_fields[0];  // δn_00(k)
+
+  for (int M_ = - params.ELL; M_ <= params.ELL; M_++) {
+    MeshField& dn_LM_ = (params.ELL > 0)
+      ? dn_fields[M_ + params.ELL + 1] : dn_00;  // δn_LM(k)
 
     /// Compute quantity equivalent to (-1)^m₁ δᴰ_{m₁, -M} which, after
     /// being summed over m₁, agrees with Hand et al. (2017) [1704.02357].
@@ -399,7 +1261,7 @@ trv::TwoPCFMeasurements compute_corrfunc(
       if (std::fabs(coupling) < trvm::eps_coupling) {continue;}
 
       stats_2pt.compute_ylm_wgtd_2pt_stats_in_config(
-        dn_LM, dn_00, sn_amp, ell1, m1, rbinning
+        dn_LM_, dn_00, sn_amp[0][M_ + params.ELL], ell1, m1, rbinning
       );
 
       for (int ibin = 0; ibin < rbinning.num_bins; ibin++) {
@@ -421,12 +1283,6 @@ trv::TwoPCFMeasurements compute_corrfunc(
     }
   }
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_cleanup_threads();
-#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
-  fftw_cleanup();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-
   /// --------------------------------------------------------------------
   /// Results
   /// --------------------------------------------------------------------
@@ -444,7 +1300,8 @@ trv::TwoPCFMeasurements compute_corrfunc(
   if (trvs::currTask == 0) {
     trvs::logger.stat(
       "... computed two-point correlation function "
-      "from paired survey-type catalogues."
+      "from paired survey-type catalogues with streamed random-source "
+      "catalogue."
     );
   }
 
@@ -454,8 +1311,11 @@ trv::TwoPCFMeasurements compute_corrfunc(
 trv::PowspecMeasurements compute_powspec_in_gpp_box(
   ParticleCatalogue& catalogue_data,
   trv::ParameterSet& params, trv::Binning kbinning,
-  double norm_factor
+  double norm_factor,
+  trv::PowspecWedgeMeasurements* wedges_out
 ) {
+  trvs::StageTimer timer("powspec");
+
   if (trvs::currTask == 0) {
     trvs::logger.stat(
       "Computing power spectrum from a periodic-box simulation-type catalogue "
@@ -492,9 +1352,7 @@ trv::PowspecMeasurements compute_powspec_in_gpp_box(
   /// Measurement
   /// --------------------------------------------------------------------
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+  trvs::init_fftw();
 
   /// Compute power spectrum.
   MeshField dn(params);  // δn(k)
@@ -506,6 +1364,10 @@ trv::PowspecMeasurements compute_powspec_in_gpp_box(
   /// Under the global plane-parallel approximation, δᴰ_{M0} enforces
   /// M = 0 for any spherical-harmonic-weighted field fluctuations.
   FieldStats stats_2pt(params);
+  if (wedges_out != nullptr && params.num_mu_bins > 0) {
+    double los_z[3] = {0., 0., 1.};
+    stats_2pt.set_wedge_binning(params.num_mu_bins, los_z, sn_amp);
+  }
   stats_2pt.compute_ylm_wgtd_2pt_stats_in_fourier(
     dn, dn, sn_amp, params.ELL, 0, kbinning
   );
@@ -517,12 +1379,6 @@ trv::PowspecMeasurements compute_powspec_in_gpp_box(
     sn_save[ibin] += double(2*params.ELL + 1) * stats_2pt.sn[ibin];
   }
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_cleanup_threads();
-#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
-  fftw_cleanup();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-
   /// --------------------------------------------------------------------
   /// Results
   /// --------------------------------------------------------------------
@@ -537,8 +1393,62 @@ trv::PowspecMeasurements compute_powspec_in_gpp_box(
     powspec_out.pk_shot.push_back(norm_factor * sn_save[ibin]);
   }
 
+  if (wedges_out != nullptr) {
+    *wedges_out = trv::PowspecWedgeMeasurements();
+    for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+      for (int imu = 0; imu < params.num_mu_bins; imu++) {
+        int iwedge = ibin * params.num_mu_bins + imu;
+        wedges_out->kbin.push_back(kbinning.bin_centres[ibin]);
+        wedges_out->mubin.push_back((imu + 0.5) / params.num_mu_bins);
+        wedges_out->keff.push_back(stats_2pt.k_wedges[iwedge]);
+        wedges_out->mueff.push_back(stats_2pt.mu_wedges[iwedge]);
+        wedges_out->nmodes.push_back(stats_2pt.nmodes_wedges[iwedge]);
+        wedges_out->pk_raw.push_back(
+          norm_factor * stats_2pt.pk_wedges[iwedge]
+        );
+        wedges_out->pk_shot.push_back(
+          norm_factor * stats_2pt.sn_wedges[iwedge]
+        );
+      }
+    }
+  }
+
   delete[] nmodes_save; delete[] k_save; delete[] pk_save; delete[] sn_save;
 
+  /// Repeat the measurements on the folded mesh grid, normalised for the
+  /// folded box volume, and stitch them onto the unfolded ones.
+  if (params.fold_factor > 1) {
+    if (trvs::currTask == 0) {
+      trvs::logger.stat(
+        "Measuring on the mesh grid folded by a factor of %d "
+        "(stitched at k = %.4f).",
+        params.fold_factor, params.fold_kstitch
+      );
+    }
+
+    trv::ParameterSet params_fold;
+    trv::set_folded_mesh_params(params, params_fold);
+
+    trv::PowspecWedgeMeasurements wedges_fold;
+
+    catalogue_data.fold_coords(params_fold.boxsize);
+    trv::PowspecMeasurements powspec_fold = compute_powspec_in_gpp_box(
+      catalogue_data, params_fold, kbinning,
+      norm_factor * params_fold.volume / params.volume,
+      (wedges_out != nullptr) ? &wedges_fold : nullptr
+    );
+    catalogue_data.unfold_coords();
+
+    trv::stitch_folded_measurements(
+      params, params_fold, kbinning, powspec_fold, powspec_out
+    );
+    if (wedges_out != nullptr) {
+      trv::stitch_folded_measurements(
+        params, params_fold, kbinning, wedges_fold, *wedges_out
+      );
+    }
+  }
+
   if (trvs::currTask == 0) {
     trvs::logger.stat(
       "... computed power spectrum "
@@ -550,11 +1460,179 @@ trv::PowspecMeasurements compute_powspec_in_gpp_box(
   return powspec_out;
 }
 
+std::vector<trv::PowspecMeasurements> compute_powspec_multipoles_in_gpp_box(
+  ParticleCatalogue& catalogue_data,
+  trv::ParameterSet& params, std::vector<int>& ells, trv::Binning kbinning,
+  double norm_factor,
+  trv::PowspecWedgeMeasurements* wedges_out
+) {
+  trvs::StageTimer timer("powspec");
+
+  if (trvs::currTask == 0) {
+    trvs::logger.stat(
+      "Computing power spectrum multipoles "
+      "from a periodic-box simulation-type catalogue "
+      "in the global plane-parallel approximation."
+    );
+  }
+
+  /// --------------------------------------------------------------------
+  /// Set-up
+  /// --------------------------------------------------------------------
+
+  /// Check input multipole degrees.
+  if (ells.empty() || *std::min_element(ells.begin(), ells.end()) < 0) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Power spectrum multipole degrees must be non-empty "
+        "and non-negative."
+      );
+    }
+    throw trvs::InvalidParameter(
+      "Power spectrum multipole degrees must be non-empty "
+      "and non-negative.\n"
+    );
+  }
+
+  const int nells = ells.size();
+
+  /// Check input normalisation matches expectation.
+  double norm = double(catalogue_data.ntotal) * double(catalogue_data.ntotal)
+    / params.volume;
+  if (std::fabs(1 - norm * norm_factor) > eps_norm) {
+    trvs::logger.warn(
+      "Power spectrum normalisation input differs from "
+      "expected value for an unweight field in a periodic box."
+    );
+  }
+
+  /// --------------------------------------------------------------------
+  /// Measurement
+  /// --------------------------------------------------------------------
+
+  trvs::init_fftw();
+
+  /// Compute power spectrum multipoles from a single transformed field,
+  /// binning all degrees in the same pass over the mesh.
+  MeshField dn(params);  // δn(k)
+  dn.compute_unweighted_field_fluctuations_insitu(catalogue_data);
+  dn.fourier_transform();
+
+  std::vector<MeshField*> fields_a(nells, &dn);
+  std::vector< std::complex<double> > sn_amps(
+    nells, double(catalogue_data.ntotal)
+  );  // \bar{N}
+  std::vector<int> ms(nells, 0);
+
+  /// Under the global plane-parallel approximation, δᴰ_{M0} enforces
+  /// M = 0 for any spherical-harmonic-weighted field fluctuations.
+  FieldStats stats_2pt(params);
+  if (wedges_out != nullptr && params.num_mu_bins > 0) {
+    double los_z[3] = {0., 0., 1.};
+    stats_2pt.set_wedge_binning(
+      params.num_mu_bins, los_z, double(catalogue_data.ntotal)
+    );
+  }
+  stats_2pt.compute_ylm_wgtd_2pt_stats_in_fourier(
+    fields_a, dn, sn_amps, ells, ms, kbinning
+  );
+
+  /// --------------------------------------------------------------------
+  /// Results
+  /// --------------------------------------------------------------------
+
+  /// Fill in output structs.
+  std::vector<trv::PowspecMeasurements> powspec_out(nells);
+  for (int iell = 0; iell < nells; iell++) {
+    double factor = double(2*ells[iell] + 1);
+    for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+      powspec_out[iell].kbin.push_back(kbinning.bin_centres[ibin]);
+      powspec_out[iell].keff.push_back(stats_2pt.k[ibin]);
+      powspec_out[iell].nmodes.push_back(stats_2pt.nmodes[ibin]);
+      powspec_out[iell].pk_raw.push_back(
+        norm_factor * (factor * stats_2pt.pk_terms[iell][ibin])
+      );
+      powspec_out[iell].pk_shot.push_back(
+        norm_factor * (factor * stats_2pt.sn_terms[iell][ibin])
+      );
+    }
+  }
+
+  if (wedges_out != nullptr) {
+    *wedges_out = trv::PowspecWedgeMeasurements();
+    for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+      for (int imu = 0; imu < params.num_mu_bins; imu++) {
+        int iwedge = ibin * params.num_mu_bins + imu;
+        wedges_out->kbin.push_back(kbinning.bin_centres[ibin]);
+        wedges_out->mubin.push_back((imu + 0.5) / params.num_mu_bins);
+        wedges_out->keff.push_back(stats_2pt.k_wedges[iwedge]);
+        wedges_out->mueff.push_back(stats_2pt.mu_wedges[iwedge]);
+        wedges_out->nmodes.push_back(stats_2pt.nmodes_wedges[iwedge]);
+        wedges_out->pk_raw.push_back(
+          norm_factor * stats_2pt.pk_wedges[iwedge]
+        );
+        wedges_out->pk_shot.push_back(
+          norm_factor * stats_2pt.sn_wedges[iwedge]
+        );
+      }
+    }
+  }
+
+  /// Repeat the measurements on the folded mesh grid, normalised for the
+  /// folded box volume, and stitch them onto the unfolded ones.
+  if (params.fold_factor > 1) {
+    if (trvs::currTask == 0) {
+      trvs::logger.stat(
+        "Measuring on the mesh grid folded by a factor of %d "
+        "(stitched at k = %.4f).",
+        params.fold_factor, params.fold_kstitch
+      );
+    }
+
+    trv::ParameterSet params_fold;
+    trv::set_folded_mesh_params(params, params_fold);
+
+    trv::PowspecWedgeMeasurements wedges_fold;
+
+    catalogue_data.fold_coords(params_fold.boxsize);
+    std::vector<trv::PowspecMeasurements> powspec_fold =
+      compute_powspec_multipoles_in_gpp_box(
+        catalogue_data, params_fold, ells, kbinning,
+        norm_factor * params_fold.volume / params.volume,
+        (wedges_out != nullptr) ? &wedges_fold : nullptr
+      );
+    catalogue_data.unfold_coords();
+
+    for (int iell = 0; iell < nells; iell++) {
+      trv::stitch_folded_measurements(
+        params, params_fold, kbinning, powspec_fold[iell], powspec_out[iell]
+      );
+    }
+    if (wedges_out != nullptr) {
+      trv::stitch_folded_measurements(
+        params, params_fold, kbinning, wedges_fold, *wedges_out
+      );
+    }
+  }
+
+  if (trvs::currTask == 0) {
+    trvs::logger.stat(
+      "... computed power spectrum multipoles "
+      "from a periodic-box simulation-type catalogue "
+      "in the global plane-parallel approximation."
+    );
+  }
+
+  return powspec_out;
+}
+
 trv::TwoPCFMeasurements compute_corrfunc_in_gpp_box(
   ParticleCatalogue& catalogue_data,
   trv::ParameterSet& params, trv::Binning& rbinning,
   double norm_factor
 ) {
+  trvs::StageTimer timer("corrfunc");
+
   if (trvs::currTask == 0) {
     trvs::logger.stat(
       "Computing two-point correlation function "
@@ -590,9 +1668,7 @@ trv::TwoPCFMeasurements compute_corrfunc_in_gpp_box(
   /// Measurement
   /// --------------------------------------------------------------------
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+  trvs::init_fftw();
 
   /// Compute 2PCF.
   MeshField dn(params);  // δn(k)
@@ -614,12 +1690,6 @@ trv::TwoPCFMeasurements compute_corrfunc_in_gpp_box(
     xi_save[ibin] += double(2*params.ELL + 1) * stats_2pt.xi[ibin];
   }
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_cleanup_threads();
-#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
-  fftw_cleanup();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-
   /// --------------------------------------------------------------------
   /// Results
   /// --------------------------------------------------------------------
@@ -646,11 +1716,14 @@ trv::TwoPCFMeasurements compute_corrfunc_in_gpp_box(
   return corrfunc_out;
 }
 
+template <class LoSPolicy>
 trv::TwoPCFWindowMeasurements compute_corrfunc_window(
-  trv::ParticleCatalogue& catalogue_rand, trv::LineOfSight* los_rand,
+  trv::ParticleCatalogue& catalogue_rand, LoSPolicy los_rand,
   trv::ParameterSet& params, trv::Binning rbinning,
   double alpha, double norm_factor
 ) {
+  trvs::StageTimer timer("corrfunc_window");
+
   if (trvs::currTask == 0) {
     trvs::logger.stat(
       "Computing two-point correlation function window "
@@ -679,9 +1752,7 @@ trv::TwoPCFWindowMeasurements compute_corrfunc_window(
   /// Measurement
   /// --------------------------------------------------------------------
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_init_threads();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
+  trvs::init_fftw();
 
   MeshField dn_00(params);
   dn_00.compute_ylm_wgtd_field(catalogue_rand, los_rand, alpha, 0, 0);
@@ -729,12 +1800,6 @@ trv::TwoPCFWindowMeasurements compute_corrfunc_window(
     }
   }
 
-#if defined(TRV_USE_OMP) && defined(TRV_USE_FFTWOMP)
-  fftw_cleanup_threads();
-#else  // !TRV_USE_OMP || !TRV_USE_FFTWOMP
-  fftw_cleanup();
-#endif  // TRV_USE_OMP && TRV_USE_FFTWOMP
-
   /// --------------------------------------------------------------------
   /// Results
   /// --------------------------------------------------------------------
@@ -759,4 +1824,142 @@ trv::TwoPCFWindowMeasurements compute_corrfunc_window(
   return corrfunc_win_out;
 }
 
+
+/// **********************************************************************
+/// Explicit instantiations
+/// **********************************************************************
+
+/// Instantiate the line-of-sight-templated functions for each
+/// line-of-sight policy in @ref dataobjs.hpp.
+
+template std::complex<double>
+calc_ylm_wgtd_shotnoise_amp_for_powspec<StoredLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, StoredLineOfSight, StoredLineOfSight,
+  double, int, int
+);
+template std::complex<double>
+calc_ylm_wgtd_shotnoise_amp_for_powspec<StoredLineOfSight>(
+  ParticleCatalogue&, StoredLineOfSight, double, int, int
+);
+template trv::PowspecMeasurements compute_powspec<StoredLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, StoredLineOfSight, StoredLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double, trv::PowspecWedgeMeasurements*
+);
+template std::vector<trv::PowspecMeasurements>
+compute_powspec_multipoles<StoredLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, StoredLineOfSight, StoredLineOfSight,
+  trv::ParameterSet&, std::vector<int>&, trv::Binning&, double
+);
+template trv::TwoPCFMeasurements compute_corrfunc<StoredLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, StoredLineOfSight, StoredLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double
+);
+template trv::TwoPCFWindowMeasurements
+compute_corrfunc_window<StoredLineOfSight>(
+  trv::ParticleCatalogue&, StoredLineOfSight,
+  trv::ParameterSet&, trv::Binning, double, double
+);
+
+template std::complex<double>
+calc_ylm_wgtd_shotnoise_amp_for_powspec<RadialLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, RadialLineOfSight, RadialLineOfSight,
+  double, int, int
+);
+template std::complex<double>
+calc_ylm_wgtd_shotnoise_amp_for_powspec<RadialLineOfSight>(
+  ParticleCatalogue&, RadialLineOfSight, double, int, int
+);
+template trv::PowspecMeasurements compute_powspec<RadialLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, RadialLineOfSight, RadialLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double, trv::PowspecWedgeMeasurements*
+);
+template std::vector<trv::PowspecMeasurements>
+compute_powspec_multipoles<RadialLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, RadialLineOfSight, RadialLineOfSight,
+  trv::ParameterSet&, std::vector<int>&, trv::Binning&, double
+);
+template trv::TwoPCFMeasurements compute_corrfunc<RadialLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, RadialLineOfSight, RadialLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double
+);
+template trv::TwoPCFWindowMeasurements
+compute_corrfunc_window<RadialLineOfSight>(
+  trv::ParticleCatalogue&, RadialLineOfSight,
+  trv::ParameterSet&, trv::Binning, double, double
+);
+template void compute_ylm_wgtd_fields_for_2pt_streamed<RadialLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogueStream&,
+  RadialLineOfSight, RadialLineOfSight,
+  trv::ParameterSet&, std::vector<int>&, double,
+  MeshFieldBatch&, std::vector< std::vector< std::complex<double> > >&,
+  double&, double&
+);
+template trv::PowspecMeasurements compute_powspec<RadialLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogueStream&,
+  RadialLineOfSight, RadialLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double&, double&
+);
+template std::vector<trv::PowspecMeasurements>
+compute_powspec_multipoles<RadialLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogueStream&,
+  RadialLineOfSight, RadialLineOfSight,
+  trv::ParameterSet&, std::vector<int>&, trv::Binning&, double&, double&
+);
+template trv::TwoPCFMeasurements compute_corrfunc<RadialLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogueStream&,
+  RadialLineOfSight, RadialLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double&, double&
+);
+
+template std::complex<double>
+calc_ylm_wgtd_shotnoise_amp_for_powspec<GlobalLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, GlobalLineOfSight, GlobalLineOfSight,
+  double, int, int
+);
+template std::complex<double>
+calc_ylm_wgtd_shotnoise_amp_for_powspec<GlobalLineOfSight>(
+  ParticleCatalogue&, GlobalLineOfSight, double, int, int
+);
+template trv::PowspecMeasurements compute_powspec<GlobalLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, GlobalLineOfSight, GlobalLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double, trv::PowspecWedgeMeasurements*
+);
+template std::vector<trv::PowspecMeasurements>
+compute_powspec_multipoles<GlobalLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, GlobalLineOfSight, GlobalLineOfSight,
+  trv::ParameterSet&, std::vector<int>&, trv::Binning&, double
+);
+template trv::TwoPCFMeasurements compute_corrfunc<GlobalLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogue&, GlobalLineOfSight, GlobalLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double
+);
+template trv::TwoPCFWindowMeasurements
+compute_corrfunc_window<GlobalLineOfSight>(
+  trv::ParticleCatalogue&, GlobalLineOfSight,
+  trv::ParameterSet&, trv::Binning, double, double
+);
+template void compute_ylm_wgtd_fields_for_2pt_streamed<GlobalLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogueStream&,
+  GlobalLineOfSight, GlobalLineOfSight,
+  trv::ParameterSet&, std::vector<int>&, double,
+  MeshFieldBatch&, std::vector< std::vector< std::complex<double> > >&,
+  double&, double&
+);
+template trv::PowspecMeasurements compute_powspec<GlobalLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogueStream&,
+  GlobalLineOfSight, GlobalLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double&, double&
+);
+template std::vector<trv::PowspecMeasurements>
+compute_powspec_multipoles<GlobalLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogueStream&,
+  GlobalLineOfSight, GlobalLineOfSight,
+  trv::ParameterSet&, std::vector<int>&, trv::Binning&, double&, double&
+);
+template trv::TwoPCFMeasurements compute_corrfunc<GlobalLineOfSight>(
+  ParticleCatalogue&, ParticleCatalogueStream&,
+  GlobalLineOfSight, GlobalLineOfSight,
+  trv::ParameterSet&, trv::Binning&, double&, double&
+);
+
 }  // namespace trv
@@ -25,8 +25,12 @@
  *
  */
 
+#include <complex>
 #include <cstdio>
+#include <future>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "monitor.hpp"
 #include "parameters.hpp"
@@ -37,250 +41,88 @@
 #include "threept.hpp"
 
 /**
- * @brief Triumvirate program for measuring two- and three-point
- *        clustering statistics.
+ * @brief Load a data-source catalogue file.
  *
+ * @param[out] catalogue Data-source catalogue.
+ * @param filepath Catalogue file path.
+ * @param catalogue_columns Catalogue data columns.
+ * @param volume Catalogue volume.
  */
-int main(int argc, char* argv[]) {
-#ifdef TRV_USE_LOGO
-  trv::sys::display_prog_notice();
-#endif  // TRV_USE_LOGO
-
-  if (trv::sys::currTask == 0) {
-    std::printf("%s\n", std::string(80, '>').c_str());
-  }
-
-  /// ====================================================================
-  /// A Initialisation
-  /// ====================================================================
-
-  if (trv::sys::currTask == 0) {
-    trv::sys::logger.stat(
-      "[A] Parameters and source data are being initialised."
-    );
-  }
-
-  /// --------------------------------------------------------------------
-  /// A.1 Parameter I/O
-  /// --------------------------------------------------------------------
-
-  if (trv::sys::currTask == 0) {
-    trv::sys::logger.stat("[A.1] Reading parameters...");
-  }
-
-  if (argc < 2) {
+void load_data_catalogue(
+  trv::ParticleCatalogue& catalogue, const std::string filepath,
+  const std::string catalogue_columns, double volume
+) {
+  if (!(trv::sys::if_filepath_is_set(filepath))) {
     if (trv::sys::currTask == 0) {
       trv::sys::logger.error(
-        "Failed to initialise program: missing parameter file."
+        "Failed to initialise program: "
+        "unspecified data-source catalogue file."
       );
       throw trv::sys::IOError(
-        "Failed to initialise program: missing parameter file.\n"
+        "Failed to initialise program: "
+        "unspecified data-source catalogue file.\n"
       );
     }
   }
-
-  trv::ParameterSet params;  ///> program parameters
-  if (params.read_from_file(argv[1])) {
+  if (catalogue.load_catalogue_file(filepath, catalogue_columns, volume)) {
     if (trv::sys::currTask == 0) {
       trv::sys::logger.error(
-        "Failed to initialise program: invalidated parameters."
+        "Failed to initialise program: "
+        "unloadable data-source catalogue file."
       );
       throw trv::sys::IOError(
-        "Failed to initialise program: invalidated parameters.\n"
-      );
-    }
-  }
-
-  if (params.print_to_file()) {
-    if (trv::sys::currTask == 0) {
-      trv::sys::logger.warn(
-        "Failed to print used parameters to file "
-        "in the measurement output directory."
+        "Failed to initialise program: "
+        "unloadable data-source catalogue file.\n"
       );
     }
   }
+}
 
-  if (trv::sys::currTask == 0) {
-    trv::sys::logger.stat("[A.1] ... read parameters.");
-  }
-
-  trv::sys::logger.reset_level(params.verbose);
-
-  /// --------------------------------------------------------------------
-  /// A.2 Data I/O
-  /// --------------------------------------------------------------------
-
-  if (trv::sys::currTask == 0) {
-    trv::sys::logger.stat("[A.2] Reading catalogues...");
-  }
-
-  trv::ParticleCatalogue catalogue_data; ///> data-source catalogue
-  std::string flag_data = "false";       ///> data-source catalogue status
-  if (params.catalogue_type == "survey" || params.catalogue_type == "sim") {
-    if (!(trv::sys::if_filepath_is_set(params.data_catalogue_file))) {
-      if (trv::sys::currTask == 0) {
-        trv::sys::logger.error(
-          "Failed to initialise program: "
-          "unspecified data-source catalogue file."
-        );
-        throw trv::sys::IOError(
-          "Failed to initialise program: "
-          "unspecified data-source catalogue file.\n"
-        );
-      }
-    }
-    if (catalogue_data.load_catalogue_file(
-      params.data_catalogue_file, params.catalogue_columns, params.volume
-    )) {
-      if (trv::sys::currTask == 0) {
-        trv::sys::logger.error(
-          "Failed to initialise program: "
-          "unloadable data-source catalogue file."
-        );
-        throw trv::sys::IOError(
-          "Failed to initialise program: "
-          "unloadable data-source catalogue file.\n"
-        );
-      }
-    }
-    flag_data = "true";
-  }
-
-  trv::ParticleCatalogue catalogue_rand; ///> random-source catalogue
-  std::string flag_rand = "false";       ///> random-source catalogue status
-  if (params.catalogue_type == "survey" || params.catalogue_type == "random") {
-    if (!(trv::sys::if_filepath_is_set(params.rand_catalogue_file))) {
-      if (trv::sys::currTask == 0) {
-        trv::sys::logger.error(
-          "Failed to initialise program: "
-          "unspecified random-source catalogue file."
-        );
-        throw trv::sys::IOError(
-          "Failed to initialise program: "
-          "unspecified random-source catalogue file.\n"
-        );
-      }
-    }
-    if (catalogue_rand.load_catalogue_file(
-      params.rand_catalogue_file, params.catalogue_columns, params.volume
-    )) {
-      if (trv::sys::currTask == 0) {
-        trv::sys::logger.error(
-          "Failed to initialise program: "
-          "unloadable random-source catalogue file."
-        );
-        throw trv::sys::IOError(
-          "Failed to initialise program: "
-          "unloadable random-source catalogue file.\n"
-        );
-      }
-    }
-    flag_rand = "true";
-  }
-
-  if (trv::sys::currTask == 0) {
-    trv::sys::logger.stat("[A.2] ... read catalogues.");
-  }
-
-  /// ====================================================================
-  /// B Measurements
-  /// ====================================================================
-
-  if (trv::sys::currTask == 0) {
-    trv::sys::logger.stat("[B] Clustering statistics are being measured.");
-  }
-
-  /// --------------------------------------------------------------------
-  /// B.1 Binning
-  /// --------------------------------------------------------------------
-
-  if (trv::sys::currTask == 0) {
-    trv::sys::logger.stat("[B.1] Setting up binning...");
-  }
-
-  trv::Binning binning(params);  ///> binning
-  binning.set_bins();
-
-  if (trv::sys::currTask == 0) {
-    trv::sys::logger.stat("[B.1] ... set up binning.");
-  }
-
-  /// --------------------------------------------------------------------
-  /// B.2 Line of sight
-  /// --------------------------------------------------------------------
-
-  if (trv::sys::currTask == 0) {
-    trv::sys::logger.stat("[B.2] Computing lines of sight...");
-  }
-
-  trv::LineOfSight* los_data = nullptr;
-  if (flag_data == "true") {
-    los_data = new trv::LineOfSight[catalogue_data.ntotal];  ///> data-source
-                                                             ///> LoS
-    trv::sys::gbytesMem +=
-      trv::sys::size_in_gb<struct trv::LineOfSight>(catalogue_data.ntotal);
-    trv::sys::update_maxmem();
-
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-    for (int pid = 0; pid < catalogue_data.ntotal; pid++) {
-      double los_mag = trv::maths::get_vec3d_magnitude(catalogue_data[pid].pos);
-
-      if (los_mag == 0.) {
-        trv::sys::logger.warn(
-          "A data-catalogue particle coincides with the origin."
-        );
-        los_mag = 1.;
-      }
-
-      los_data[pid].pos[0] = catalogue_data[pid].pos[0] / los_mag;
-      los_data[pid].pos[1] = catalogue_data[pid].pos[1] / los_mag;
-      los_data[pid].pos[2] = catalogue_data[pid].pos[2] / los_mag;
-    }
-  }
-
-  trv::LineOfSight* los_rand = nullptr;
-  if (flag_rand == "true") {
-    los_rand = new trv::LineOfSight[catalogue_rand.ntotal];  ///> random-source
-                                                             ///> LoS
-    trv::sys::gbytesMem +=
-      trv::sys::size_in_gb<struct trv::LineOfSight>(catalogue_rand.ntotal);
-    trv::sys::update_maxmem();
-
-#ifdef TRV_USE_OMP
-#pragma omp parallel for
-#endif  // TRV_USE_OMP
-    for (int pid = 0; pid < catalogue_rand.ntotal; pid++) {
-      double los_mag = trv::maths::get_vec3d_magnitude(catalogue_rand[pid].pos);
-
-      if (los_mag == 0.) {
-        trv::sys::logger.warn(
-          "A random-catalogue particle coincides with the origin."
-        );
-        los_mag = 1.;
-      }
-
-      los_rand[pid].pos[0] = catalogue_rand[pid].pos[0] / los_mag;
-      los_rand[pid].pos[1] = catalogue_rand[pid].pos[1] / los_mag;
-      los_rand[pid].pos[2] = catalogue_rand[pid].pos[2] / los_mag;
-    }
-  }
-
-  if (trv::sys::currTask == 0) {
-    trv::sys::logger.stat("[B.2] ... computed lines of sight.");
-  }
+/**
+ * @brief Return the stem of a file path, i.e. the file name without
+ *        the directory path or any extensions.
+ *
+ * @param filepath File path.
+ * @returns File stem.
+ */
+std::string get_file_stem(const std::string& filepath) {
+  std::string filename = filepath.substr(filepath.find_last_of('/') + 1);
+  return filename.substr(0, filename.find('.'));
+}
 
+/**
+ * @brief Align catalogues inside the measurement box and measure
+ *        clustering statistics, saving the measurements to files.
+ *
+ * These are steps [B.2]--[B.5] of the program, which are repeated for
+ * each data-source catalogue in batch mode.
+ *
+ * @param params Parameter set.
+ * @param binning Binning.
+ * @param catalogue_data Data-source catalogue.
+ * @param flag_data Data-source catalogue status.
+ * @param catalogue_rand Random-source catalogue.
+ * @param flag_rand Random-source catalogue status.
+ * @param stream_rand Random-source catalogue stream (if any).
+ */
+void measure_catalogues(
+  trv::ParameterSet& params, trv::Binning& binning,
+  trv::ParticleCatalogue& catalogue_data, const std::string flag_data,
+  trv::ParticleCatalogue& catalogue_rand, const std::string flag_rand,
+  trv::ParticleCatalogueStream* stream_rand
+) {
   /// --------------------------------------------------------------------
-  /// B.3 Box alignment
+  /// B.2 Box alignment
   /// --------------------------------------------------------------------
 
   if (trv::sys::currTask == 0) {
     trv::sys::logger.stat(
-      "[B.3] Aligning catalogues inside measurement box..."
+      "[B.2] Aligning catalogues inside measurement box..."
     );
   }
 
+  trv::sys::StageTimer timer_align("alignment");  ///> box alignment timer
+
   if (params.catalogue_type == "survey") {
     if (params.alignment == "pad") {
       if (params.padscale == "grid") {
@@ -338,9 +180,26 @@ int main(int argc, char* argv[]) {
     }
   }
 
+  timer_align.stop();
+
+  if (trv::sys::currTask == 0) {
+    trv::sys::logger.stat(
+      "[B.2] ... aligned catalogues inside measurement box."
+    );
+  }
+
+  /// --------------------------------------------------------------------
+  /// B.3 Line of sight
+  /// --------------------------------------------------------------------
+
+  /// Lines of sight are evaluated on the fly as the radial direction
+  /// from the observer, which is tracked through box alignment.
+  trv::RadialLineOfSight los_data(catalogue_data.pos_observer);  ///> data LoS
+  trv::RadialLineOfSight los_rand(catalogue_rand.pos_observer);  ///> rand LoS
+
   if (trv::sys::currTask == 0) {
     trv::sys::logger.stat(
-      "[B.3] ... aligned catalogues inside measurement box."
+      "[B.3] Lines of sight are evaluated on the fly from the observer."
     );
   }
 
@@ -348,6 +207,9 @@ int main(int argc, char* argv[]) {
   /// B.4 Constants
   /// --------------------------------------------------------------------
 
+  trv::sys::StageTimer timer_norm("normalisation");  ///> normalisation
+                                                     ///> timer
+
   double alpha;  ///> alpha contrast
   if (flag_data == "true" && flag_rand == "true") {
     alpha = catalogue_data.wtotal / catalogue_rand.wtotal;
@@ -363,6 +225,12 @@ int main(int argc, char* argv[]) {
     (flag_rand == "true") ? catalogue_rand : catalogue_data;
   double alpha_for_norm = (flag_rand == "true") ? alpha : 1.;
   double norm_factor = 0., norm_factor_alt = 0.;  ///> normalisation factors
+  if (stream_rand != nullptr) {
+    /// Only two-point measurements are streamed (see
+    /// @ref trv::ParameterSet::validate), with the normalisation
+    /// factors computed in the same pass over the random-source
+    /// catalogue file as the fields (see [B.5]).
+  } else
   if (params.norm_convention == "particle") {
     if (params.npoint == "2pt") {
       norm_factor = trv::calc_powspec_normalisation_from_particles(
@@ -400,7 +268,9 @@ int main(int argc, char* argv[]) {
     }
   }
 
-  if (trv::sys::currTask == 0) {
+  timer_norm.stop();
+
+  if (trv::sys::currTask == 0 && stream_rand == nullptr) {
     trv::sys::logger.info(
       "Normalisation factors: %.6e (used), %.6e (alternative).",
       norm_factor, norm_factor_alt
@@ -411,7 +281,60 @@ int main(int argc, char* argv[]) {
   /// B.5 Clustering algorithms
   /// --------------------------------------------------------------------
 
+  trv::sys::StageTimer timer_meas("measurement");  ///> measurement timer
+
   char save_filepath[1024];
+  trv::PowspecWedgeMeasurements meas_powspec_wedges;  ///> power spectrum
+                                                      ///> wedges
+  if (params.statistic_type == "powspec" && !params.multipoles.empty()) {
+    std::vector<trv::PowspecMeasurements> meas_powspec_multipoles;
+      ///> power spectrum multipoles
+    if (params.catalogue_type == "survey") {
+      if (stream_rand != nullptr) {
+        /// Streamed random catalogues are read once for all degrees.
+        meas_powspec_multipoles = trv::compute_powspec_multipoles(
+          catalogue_data, *stream_rand, los_data, los_rand,
+          params, params.multipoles, binning, norm_factor, norm_factor_alt
+        );
+      } else {
+        meas_powspec_multipoles = trv::compute_powspec_multipoles(
+          catalogue_data, catalogue_rand, los_data, los_rand,
+          params, params.multipoles, binning, norm_factor
+        );
+      }
+    } else
+    if (params.catalogue_type == "sim") {
+      meas_powspec_multipoles = trv::compute_powspec_multipoles_in_gpp_box(
+        catalogue_data, params, params.multipoles, binning, norm_factor,
+        &meas_powspec_wedges
+      );
+    }
+
+    for (int iell = 0; iell < int(params.multipoles.size()); iell++) {
+      params.ELL = params.multipoles[iell];
+      std::sprintf(
+        save_filepath, "%s/pk%d%s",
+        params.measurement_dir.c_str(), params.ELL, params.output_tag.c_str()
+      );
+      if (trv::sys::currTask == 0) {
+        std::FILE* save_fileptr = std::fopen(save_filepath, "w");
+        if (params.catalogue_type == "survey") {
+          trv::print_measurement_header_to_file(
+            save_fileptr, params, catalogue_data, catalogue_rand,
+            norm_factor, norm_factor_alt
+          );
+        } else {
+          trv::print_measurement_header_to_file(
+            save_fileptr, params, catalogue_data, norm_factor, norm_factor_alt
+          );
+        }
+        trv::print_measurement_datatab_to_file(
+          save_fileptr, params, meas_powspec_multipoles[iell]
+        );
+        std::fclose(save_fileptr);
+      }
+    }
+  } else
   if (params.statistic_type == "powspec") {
     std::sprintf(
       save_filepath, "%s/pk%d%s",
@@ -420,27 +343,42 @@ int main(int argc, char* argv[]) {
     std::FILE* save_fileptr = nullptr;
     trv::PowspecMeasurements meas_powspec;  ///> power spectrum
     if (params.catalogue_type == "survey") {
-      meas_powspec = trv::compute_powspec(
-        catalogue_data, catalogue_rand, los_data, los_rand,
-        params, binning, norm_factor
-      );
-      save_fileptr = std::fopen(save_filepath, "w");
-      trv::print_measurement_header_to_file(
-        save_fileptr, params, catalogue_data, catalogue_rand,
-        norm_factor, norm_factor_alt
-      );
+      if (stream_rand != nullptr) {
+        meas_powspec = trv::compute_powspec(
+          catalogue_data, *stream_rand, los_data, los_rand,
+          params, binning, norm_factor, norm_factor_alt
+        );
+      } else {
+        meas_powspec = trv::compute_powspec(
+          catalogue_data, catalogue_rand, los_data, los_rand,
+          params, binning, norm_factor
+        );
+      }
+      if (trv::sys::currTask == 0) {
+        save_fileptr = std::fopen(save_filepath, "w");
+        trv::print_measurement_header_to_file(
+          save_fileptr, params, catalogue_data, catalogue_rand,
+          norm_factor, norm_factor_alt
+        );
+      }
     } else
     if (params.catalogue_type == "sim") {
       meas_powspec = trv::compute_powspec_in_gpp_box(
-        catalogue_data, params, binning, norm_factor
+        catalogue_data, params, binning, norm_factor, &meas_powspec_wedges
       );
-      save_fileptr = std::fopen(save_filepath, "w");
-      trv::print_measurement_header_to_file(
-        save_fileptr, params, catalogue_data, norm_factor, norm_factor_alt
+      if (trv::sys::currTask == 0) {
+        save_fileptr = std::fopen(save_filepath, "w");
+        trv::print_measurement_header_to_file(
+          save_fileptr, params, catalogue_data, norm_factor, norm_factor_alt
+        );
+      }
+    }
+    if (trv::sys::currTask == 0) {
+      trv::print_measurement_datatab_to_file(
+        save_fileptr, params, meas_powspec
       );
+      std::fclose(save_fileptr);
     }
-    trv::print_measurement_datatab_to_file(save_fileptr, params, meas_powspec);
-    std::fclose(save_fileptr);
   } else
   if (params.statistic_type == "2pcf") {
     std::sprintf(
@@ -450,27 +388,40 @@ int main(int argc, char* argv[]) {
     std::FILE* save_fileptr = nullptr;
     trv::TwoPCFMeasurements meas_2pcf;  ///> two-point correlation function
     if (params.catalogue_type == "survey") {
-      meas_2pcf = trv::compute_corrfunc(
-        catalogue_data, catalogue_rand, los_data, los_rand,
-        params, binning, norm_factor
-      );
-      save_fileptr = std::fopen(save_filepath, "w");
-      trv::print_measurement_header_to_file(
-        save_fileptr, params, catalogue_data, catalogue_rand,
-        norm_factor, norm_factor_alt
-      );
+      if (stream_rand != nullptr) {
+        meas_2pcf = trv::compute_corrfunc(
+          catalogue_data, *stream_rand, los_data, los_rand,
+          params, binning, norm_factor, norm_factor_alt
+        );
+      } else {
+        meas_2pcf = trv::compute_corrfunc(
+          catalogue_data, catalogue_rand, los_data, los_rand,
+          params, binning, norm_factor
+        );
+      }
+      if (trv::sys::currTask == 0) {
+        save_fileptr = std::fopen(save_filepath, "w");
+        trv::print_measurement_header_to_file(
+          save_fileptr, params, catalogue_data, catalogue_rand,
+          norm_factor, norm_factor_alt
+        );
+      }
     } else
     if (params.catalogue_type == "sim") {
       meas_2pcf = trv::compute_corrfunc_in_gpp_box(
         catalogue_data, params, binning, norm_factor
       );
-      save_fileptr = std::fopen(save_filepath, "w");
-      trv::print_measurement_header_to_file(
-        save_fileptr, params, catalogue_data, norm_factor, norm_factor_alt
-      );
+      if (trv::sys::currTask == 0) {
+        save_fileptr = std::fopen(save_filepath, "w");
+        trv::print_measurement_header_to_file(
+          save_fileptr, params, catalogue_data, norm_factor, norm_factor_alt
+        );
+      }
+    }
+    if (trv::sys::currTask == 0) {
+      trv::print_measurement_datatab_to_file(save_fileptr, params, meas_2pcf);
+      std::fclose(save_fileptr);
     }
-    trv::print_measurement_datatab_to_file(save_fileptr, params, meas_2pcf);
-    std::fclose(save_fileptr);
   } else
   if (params.statistic_type == "2pcf-win") {
     std::sprintf(
@@ -480,12 +431,38 @@ int main(int argc, char* argv[]) {
     trv::TwoPCFWindowMeasurements meas_2pcf_win = trv::compute_corrfunc_window(
       catalogue_rand, los_rand, params, binning, alpha, norm_factor
     );  ///> two-point correlation function window
-    std::FILE* save_fileptr = std::fopen(save_filepath, "w");
-    trv::print_measurement_header_to_file(
-      save_fileptr, params, catalogue_rand, norm_factor, norm_factor_alt
+    if (trv::sys::currTask == 0) {
+      std::FILE* save_fileptr = std::fopen(save_filepath, "w");
+      trv::print_measurement_header_to_file(
+        save_fileptr, params, catalogue_rand, norm_factor, norm_factor_alt
+      );
+      trv::print_measurement_datatab_to_file(
+        save_fileptr, params, meas_2pcf_win
+      );
+      std::fclose(save_fileptr);
+    }
+  } else
+  if (params.statistic_type == "bispec" && params.form == "triangle") {
+    std::sprintf(
+      save_filepath, "%s/bk%d%d%d_tri%s",
+      params.measurement_dir.c_str(),
+      params.ell1, params.ell2, params.ELL,
+      params.output_tag.c_str()
     );
-    trv::print_measurement_datatab_to_file(save_fileptr, params, meas_2pcf_win);
-    std::fclose(save_fileptr);
+    trv::BispecTriangleMeasurements meas_bispec_tri =
+      trv::compute_bispec_triangles_in_gpp_box(
+        catalogue_data, params, binning, norm_factor
+      );  ///> bispectrum in triangle bins
+    if (trv::sys::currTask == 0) {
+      std::FILE* save_fileptr = std::fopen(save_filepath, "w");
+      trv::print_measurement_header_to_file(
+        save_fileptr, params, catalogue_data, norm_factor, norm_factor_alt
+      );
+      trv::print_measurement_datatab_to_file(
+        save_fileptr, params, meas_bispec_tri
+      );
+      std::fclose(save_fileptr);
+    }
   } else
   if (params.statistic_type == "bispec") {
     if (params.form == "full") {
@@ -511,23 +488,29 @@ int main(int argc, char* argv[]) {
         catalogue_data, catalogue_rand, los_data, los_rand,
         params, binning, norm_factor
       );
-      save_fileptr = std::fopen(save_filepath, "w");
-      trv::print_measurement_header_to_file(
-        save_fileptr, params, catalogue_data, catalogue_rand,
-        norm_factor, norm_factor_alt
-      );
+      if (trv::sys::currTask == 0) {
+        save_fileptr = std::fopen(save_filepath, "w");
+        trv::print_measurement_header_to_file(
+          save_fileptr, params, catalogue_data, catalogue_rand,
+          norm_factor, norm_factor_alt
+        );
+      }
     } else
     if (params.catalogue_type == "sim") {
       meas_bispec = trv::compute_bispec_in_gpp_box(
         catalogue_data, params, binning, norm_factor
       );
-      save_fileptr = std::fopen(save_filepath, "w");
-      trv::print_measurement_header_to_file(
-        save_fileptr, params, catalogue_data, norm_factor, norm_factor_alt
-      );
+      if (trv::sys::currTask == 0) {
+        save_fileptr = std::fopen(save_filepath, "w");
+        trv::print_measurement_header_to_file(
+          save_fileptr, params, catalogue_data, norm_factor, norm_factor_alt
+        );
+      }
+    }
+    if (trv::sys::currTask == 0) {
+      trv::print_measurement_datatab_to_file(save_fileptr, params, meas_bispec);
+      std::fclose(save_fileptr);
     }
-    trv::print_measurement_datatab_to_file(save_fileptr, params, meas_bispec);
-    std::fclose(save_fileptr);
   } else
   if (params.statistic_type == "3pcf") {
     if (params.form == "full") {
@@ -553,23 +536,29 @@ int main(int argc, char* argv[]) {
         catalogue_data, catalogue_rand, los_data, los_rand,
         params, binning, norm_factor
       );
-      save_fileptr = std::fopen(save_filepath, "w");
-      trv::print_measurement_header_to_file(
-        save_fileptr, params, catalogue_data, catalogue_rand,
-        norm_factor, norm_factor_alt
-      );
+      if (trv::sys::currTask == 0) {
+        save_fileptr = std::fopen(save_filepath, "w");
+        trv::print_measurement_header_to_file(
+          save_fileptr, params, catalogue_data, catalogue_rand,
+          norm_factor, norm_factor_alt
+        );
+      }
     } else
     if (params.catalogue_type == "sim") {
       meas_3pcf = trv::compute_3pcf_in_gpp_box(
         catalogue_data, params, binning, norm_factor
       );
-      save_fileptr = std::fopen(save_filepath, "w");
-      trv::print_measurement_header_to_file(
-        save_fileptr, params, catalogue_data, norm_factor, norm_factor_alt
-      );
+      if (trv::sys::currTask == 0) {
+        save_fileptr = std::fopen(save_filepath, "w");
+        trv::print_measurement_header_to_file(
+          save_fileptr, params, catalogue_data, norm_factor, norm_factor_alt
+        );
+      }
+    }
+    if (trv::sys::currTask == 0) {
+      trv::print_measurement_datatab_to_file(save_fileptr, params, meas_3pcf);
+      std::fclose(save_fileptr);
     }
-    trv::print_measurement_datatab_to_file(save_fileptr, params, meas_3pcf);
-    std::fclose(save_fileptr);
   } else
   if (params.statistic_type == "3pcf-win") {
     if (params.form == "full") {
@@ -592,12 +581,16 @@ int main(int argc, char* argv[]) {
     trv::ThreePCFWindowMeasurements meas_3pcf_win = trv::compute_3pcf_window(
       catalogue_rand, los_rand, params, binning, alpha, norm_factor, wa
     );  ///> three-point correlation function window
-    std::FILE* save_fileptr = std::fopen(save_filepath, "w");
-    trv::print_measurement_header_to_file(
-      save_fileptr, params, catalogue_rand, norm_factor, norm_factor_alt
-    );
-    trv::print_measurement_datatab_to_file(save_fileptr, params, meas_3pcf_win);
-    std::fclose(save_fileptr);
+    if (trv::sys::currTask == 0) {
+      std::FILE* save_fileptr = std::fopen(save_filepath, "w");
+      trv::print_measurement_header_to_file(
+        save_fileptr, params, catalogue_rand, norm_factor, norm_factor_alt
+      );
+      trv::print_measurement_datatab_to_file(
+        save_fileptr, params, meas_3pcf_win
+      );
+      std::fclose(save_fileptr);
+    }
   } else
   if (params.statistic_type == "3pcf-win-wa") {
     if (params.form == "full") {
@@ -621,43 +614,417 @@ int main(int argc, char* argv[]) {
     trv::ThreePCFWindowMeasurements meas_3pcf_win_wa = trv::compute_3pcf_window(
       catalogue_rand, los_rand, params, binning, alpha, norm_factor, wa
     );  ///> three-point correlation function window wide-angle corrections
-    std::FILE* save_fileptr = std::fopen(save_filepath, "w");
-    trv::print_measurement_header_to_file(
-      save_fileptr, params, catalogue_rand, norm_factor, norm_factor_alt
-    );
-    trv::print_measurement_datatab_to_file(
-      save_fileptr, params, meas_3pcf_win_wa
+    if (trv::sys::currTask == 0) {
+      std::FILE* save_fileptr = std::fopen(save_filepath, "w");
+      trv::print_measurement_header_to_file(
+        save_fileptr, params, catalogue_rand, norm_factor, norm_factor_alt
+      );
+      trv::print_measurement_datatab_to_file(
+        save_fileptr, params, meas_3pcf_win_wa
+      );
+      std::fclose(save_fileptr);
+    }
+  }
+
+  /// Survey-type catalogues are measured with radial lines of sight,
+  /// with respect to which wedges are not defined.
+  if (
+    params.statistic_type == "powspec" && params.num_mu_bins > 0
+    && params.catalogue_type == "survey"
+  ) {
+    if (trv::sys::currTask == 0) {
+      trv::sys::logger.warn(
+        "Power spectrum wedges are not measured from survey-type catalogues "
+        "with radial lines of sight."
+      );
+    }
+  } else
+  if (params.statistic_type == "powspec" && params.num_mu_bins > 0) {
+    std::sprintf(
+      save_filepath, "%s/pkmu%s",
+      params.measurement_dir.c_str(), params.output_tag.c_str()
     );
-    std::fclose(save_fileptr);
+    if (trv::sys::currTask == 0) {
+      std::FILE* save_fileptr = std::fopen(save_filepath, "w");
+      trv::print_measurement_header_to_file(
+        save_fileptr, params, catalogue_data, norm_factor, norm_factor_alt
+      );
+      trv::print_measurement_datatab_to_file(
+        save_fileptr, params, meas_powspec_wedges
+      );
+      std::fclose(save_fileptr);
+    }
   }
 
+  if (trv::sys::currTask == 0 && stream_rand != nullptr) {
+    trv::sys::logger.info(
+      "Normalisation factors: %.6e (used), %.6e (alternative).",
+      norm_factor, norm_factor_alt
+    );
+  }
   if (trv::sys::currTask == 0) {
     trv::sys::logger.info("Measurements saved to %s.", save_filepath);
   }
 
+  timer_meas.stop();
+}
+
+/**
+ * @brief Triumvirate program for measuring two- and three-point
+ *        clustering statistics.
+ *
+ */
+int main(int argc, char* argv[]) {
+  trv::sys::init_tasks(&argc, &argv);
+#ifdef TRV_USE_MPI
+  /// FFTW threads must be initialised before FFTW MPI.
+  trv::sys::init_fftw();
+  fftw_mpi_init();
+#endif  // TRV_USE_MPI
+
+#ifdef TRV_USE_LOGO
+  trv::sys::display_prog_notice();
+#endif  // TRV_USE_LOGO
+
+  if (trv::sys::currTask == 0) {
+    std::printf("%s\n", std::string(80, '>').c_str());
+  }
+
   /// ====================================================================
-  /// C Finalisation
+  /// A Initialisation
   /// ====================================================================
 
-  /// Clear dynamically allocated memory.
-  catalogue_data.finalise_particles();
-  catalogue_rand.finalise_particles();
+  if (trv::sys::currTask == 0) {
+    trv::sys::logger.stat(
+      "[A] Parameters and source data are being initialised."
+    );
+  }
+
+  /// --------------------------------------------------------------------
+  /// A.1 Parameter I/O
+  /// --------------------------------------------------------------------
+
+  if (trv::sys::currTask == 0) {
+    trv::sys::logger.stat("[A.1] Reading parameters...");
+  }
+
+  if (argc < 2) {
+    if (trv::sys::currTask == 0) {
+      trv::sys::logger.error(
+        "Failed to initialise program: missing parameter file."
+      );
+      throw trv::sys::IOError(
+        "Failed to initialise program: missing parameter file.\n"
+      );
+    }
+  }
 
-  if (los_data != nullptr) {
-    delete[] los_data; los_data = nullptr;
+  trv::ParameterSet params;  ///> program parameters
+  if (params.read_from_file(argv[1])) {
+    if (trv::sys::currTask == 0) {
+      trv::sys::logger.error(
+        "Failed to initialise program: invalidated parameters."
+      );
+      throw trv::sys::IOError(
+        "Failed to initialise program: invalidated parameters.\n"
+      );
+    }
   }
-  if (los_rand != nullptr) {
-    delete[] los_rand; los_rand = nullptr;
+
+  if (trv::sys::currTask == 0) {
+    if (params.print_to_file()) {
+      trv::sys::logger.warn(
+        "Failed to print used parameters to file "
+        "in the measurement output directory."
+      );
+    }
   }
-  trv::sys::gbytesMem -= trv::sys::size_in_gb<struct trv::LineOfSight>(
-    (catalogue_data.ntotal + catalogue_rand.ntotal)
-  );
+
+  if (trv::sys::currTask == 0) {
+    trv::sys::logger.stat("[A.1] ... read parameters.");
+  }
+
+  trv::sys::logger.reset_level(params.verbose);
+
+  if (params.profile == "true") {
+    trv::sys::enable_profiling();
+  }
+
+  /// --------------------------------------------------------------------
+  /// A.2 Data I/O
+  /// --------------------------------------------------------------------
+
+  if (trv::sys::currTask == 0) {
+    trv::sys::logger.stat("[A.2] Reading catalogues...");
+  }
+
+  trv::sys::StageTimer timer_io("catalogue_io");  ///> catalogue I/O timer
+
+  std::unique_ptr<trv::ParticleCatalogue> catalogue_data(
+    new trv::ParticleCatalogue
+  );                                     ///> data-source catalogue
+  std::string flag_data = "false";       ///> data-source catalogue status
+  std::vector<std::string> data_catalogue_files;
+                                         ///> data-source catalogue files
+  if (params.catalogue_type == "survey" || params.catalogue_type == "sim") {
+    data_catalogue_files = params.data_catalogue_files;
+    if (data_catalogue_files.empty()) {
+      data_catalogue_files.push_back(params.data_catalogue_file);
+    }
+    load_data_catalogue(
+      *catalogue_data, data_catalogue_files[0],
+      params.catalogue_columns, params.volume
+    );
+    flag_data = "true";
+  }
+
+  trv::ParticleCatalogue catalogue_rand; ///> random-source catalogue
+  std::string flag_rand = "false";       ///> random-source catalogue status
+  trv::ParticleCatalogueStream* stream_rand = nullptr;
+                                         ///> random-source catalogue stream
+  trv::RandomMeshCache* rand_cache = nullptr;
+                                         ///> random mesh cache
+  if (params.catalogue_type == "survey" || params.catalogue_type == "random") {
+    if (!(trv::sys::if_filepath_is_set(params.rand_catalogue_file))) {
+      if (trv::sys::currTask == 0) {
+        trv::sys::logger.error(
+          "Failed to initialise program: "
+          "unspecified random-source catalogue file."
+        );
+        throw trv::sys::IOError(
+          "Failed to initialise program: "
+          "unspecified random-source catalogue file.\n"
+        );
+      }
+    }
+    if (params.chunk_size > 0) {
+      /// Only summary information is held, with particle data streamed
+      /// in chunks during the measurements.
+      stream_rand = new trv::ParticleCatalogueStream(
+        catalogue_rand,
+        params.rand_catalogue_file, params.catalogue_columns,
+        params.chunk_size, params.volume
+      );
+    } else {
+      if (!params.random_cache_dir.empty()) {
+        rand_cache = new trv::RandomMeshCache(params);
+      }
+      if (rand_cache != nullptr
+          && rand_cache->restore_catalogue(catalogue_rand)) {
+        /// Only summary information is held, with random-source meshes
+        /// and sums read from the cache during the measurements.
+      } else {
+        if (catalogue_rand.load_catalogue_file(
+          params.rand_catalogue_file, params.catalogue_columns, params.volume
+        )) {
+          if (trv::sys::currTask == 0) {
+            trv::sys::logger.error(
+              "Failed to initialise program: "
+              "unloadable random-source catalogue file."
+            );
+            throw trv::sys::IOError(
+              "Failed to initialise program: "
+              "unloadable random-source catalogue file.\n"
+            );
+          }
+        }
+        if (rand_cache != nullptr) {
+          rand_cache->attach_catalogue(catalogue_rand);
+        }
+      }
+    }
+    flag_rand = "true";
+  }
+
+  timer_io.stop();
+
+  trv::sys::record_profile_quantity("ngrid_x", params.ngrid[0]);
+  trv::sys::record_profile_quantity("ngrid_y", params.ngrid[1]);
+  trv::sys::record_profile_quantity("ngrid_z", params.ngrid[2]);
+  trv::sys::record_profile_quantity("nmesh", params.nmesh);
+  if (flag_data == "true") {
+    trv::sys::record_profile_quantity(
+      "nparticles_data", catalogue_data->ntotal
+    );
+  }
+  if (flag_rand == "true") {
+    trv::sys::record_profile_quantity(
+      "nparticles_rand", catalogue_rand.ntotal
+    );
+  }
+
+  if (trv::sys::currTask == 0) {
+    trv::sys::logger.stat("[A.2] ... read catalogues.");
+  }
+
+  /// ====================================================================
+  /// B Measurements
+  /// ====================================================================
+
+  if (trv::sys::currTask == 0) {
+    trv::sys::logger.stat("[B] Clustering statistics are being measured.");
+  }
+
+  /// --------------------------------------------------------------------
+  /// B.1 Binning
+  /// --------------------------------------------------------------------
+
+  if (trv::sys::currTask == 0) {
+    trv::sys::logger.stat("[B.1] Setting up binning...");
+  }
+
+  trv::Binning binning(params);  ///> binning
+  binning.set_bins();
+
+  if (trv::sys::currTask == 0) {
+    trv::sys::logger.stat("[B.1] ... set up binning.");
+  }
+
+  /// Measurements are repeated for each data-source catalogue in batch
+  /// mode, with the random-source catalogue and binning shared, and
+  /// outputs tagged by the data-source catalogue file stem.
+  const int nbatch =
+    (flag_data == "true") ? int(data_catalogue_files.size()) : 1;
+  const std::string output_tag = params.output_tag;
+
+  std::unique_ptr<trv::ParticleCatalogue> catalogue_next;
+    ///> next data-source catalogue
+  /// The prefetch future waits for its thread on destruction, so the
+  /// thread is joined even if a measurement throws.
+  std::future<void> prefetch;  ///> data-source catalogue prefetch
+
+  /// In batch mode, the reduced spherical harmonics on the mesh grids
+  /// and the spherical Bessel interpolators used for three-point
+  /// statistics are held across data-source catalogues, so that they
+  /// are computed once per batch rather than per catalogue.  This keeps
+  /// the harmonics of all orders for degrees ℓ₁ and ℓ₂ in memory
+  /// throughout the batch.
+  std::vector<
+    std::shared_ptr< const std::vector< std::complex<double> > >
+  > ylm_batch;  ///> reduced spherical harmonics held for the batch
+  std::vector< std::unique_ptr<trv::maths::SphericalBesselCalculator> >
+    sj_batch;  ///> spherical Bessel interpolators held for the batch
+  if (
+    nbatch > 1 && params.npoint == "3pt" && params.form != "triangle"
+  ) {
+    for (int ell : {params.ell1, params.ell2}) {
+      sj_batch.emplace_back(new trv::maths::SphericalBesselCalculator(ell));
+      for (int m_ = - ell; m_ <= ell; m_++) {
+        ylm_batch.push_back(
+          trv::maths::SphericalHarmonicCalculator::
+            get_reduced_spherical_harmonic_in_fourier_space(
+              ell, m_, params.boxsize, params.ngrid
+            )
+        );
+        ylm_batch.push_back(
+          trv::maths::SphericalHarmonicCalculator::
+            get_reduced_spherical_harmonic_in_config_space(
+              ell, m_, params.boxsize, params.ngrid
+            )
+        );
+      }
+    }
+  }
+
+  for (int ibatch = 0; ibatch < nbatch; ibatch++) {
+    if (nbatch > 1) {
+      params.data_catalogue_file = data_catalogue_files[ibatch];
+      params.output_tag =
+        output_tag + "_" + get_file_stem(data_catalogue_files[ibatch]);
+
+      if (trv::sys::currTask == 0) {
+        trv::sys::logger.stat(
+          "[B] Measuring data-source catalogue %d of %d in batch: %s.",
+          ibatch + 1, nbatch, params.data_catalogue_file.c_str()
+        );
+      }
+    }
+
+    if (ibatch > 0) {
+      trv::sys::StageTimer timer_prefetch("catalogue_io");
+        ///> catalogue I/O timer
+
+      prefetch.get();  // rethrows any prefetching error
+
+      catalogue_data = std::move(catalogue_next);
+
+      /// Bring the data-source catalogue into the frame of the random-source
+      /// catalogue already aligned, as box alignment is relative to the
+      /// latter.
+      if (flag_rand == "true") {
+        double dpos[3] = {
+          - catalogue_rand.pos_observer[0],
+          - catalogue_rand.pos_observer[1],
+          - catalogue_rand.pos_observer[2]
+        };
+        catalogue_data->offset_coords(dpos);
+      }
+
+      trv::sys::record_profile_quantity(
+        "nparticles_data", catalogue_data->ntotal
+      );
+    }
+
+    /// Prefetch the next data-source catalogue in the background while
+    /// the current one is being measured.
+    if (ibatch + 1 < nbatch) {
+      catalogue_next.reset(new trv::ParticleCatalogue);
+      prefetch = std::async(
+        std::launch::async,
+        [](
+          trv::ParticleCatalogue* catalogue, const std::string filepath,
+          const std::string catalogue_columns, double volume
+        ) {
+          /// Keep to one thread so as not to compete with the
+          /// measurement for cores.
+#ifdef TRV_USE_OMP
+          omp_set_num_threads(1);
+#endif  // TRV_USE_OMP
+          load_data_catalogue(
+            *catalogue, filepath, catalogue_columns, volume
+          );
+        },
+        catalogue_next.get(), data_catalogue_files[ibatch + 1],
+        params.catalogue_columns, params.volume
+      );
+    }
+
+    measure_catalogues(
+      params, binning, *catalogue_data, flag_data,
+      catalogue_rand, flag_rand, stream_rand
+    );
+
+    catalogue_data->finalise_particles();
+  }
+
+  ylm_batch.clear();
+  sj_batch.clear();
+
+  params.output_tag = output_tag;
+
+  /// ====================================================================
+  /// C Finalisation
+  /// ====================================================================
+
+  /// Clear dynamically allocated memory.
+  delete stream_rand; stream_rand = nullptr;
+  catalogue_rand.finalise_particles();
+  delete rand_cache; rand_cache = nullptr;
 
   if (trv::sys::currTask == 0) {
     trv::sys::logger.info(
       "Minimal estimate of peak memory usage: %.1f gigabytes.",
       trv::sys::gbytesMaxMem
     );
+    trv::sys::logger.info(
+      "Peak memory usage estimate by category: "
+      "%s %.1f, %s %.1f, %s %.1f, %s %.1f, %s %.1f gigabytes.",
+      trv::sys::memCategoryNames[0], trv::sys::gbytesMaxMemCat[0],
+      trv::sys::memCategoryNames[1], trv::sys::gbytesMaxMemCat[1],
+      trv::sys::memCategoryNames[2], trv::sys::gbytesMaxMemCat[2],
+      trv::sys::memCategoryNames[3], trv::sys::gbytesMaxMemCat[3],
+      trv::sys::memCategoryNames[4], trv::sys::gbytesMaxMemCat[4]
+    );
   }
   if (trv::sys::gbytesMem > 0.) {
     if (trv::sys::currTask == 0) {
@@ -668,9 +1035,30 @@ int main(int argc, char* argv[]) {
     }
   }
 
+  if (params.profile == "true" && trv::sys::currTask == 0) {
+    char profile_filepath[1024];
+    std::sprintf(
+      profile_filepath, "%s/profile%s.json",
+      params.measurement_dir.c_str(), params.output_tag.c_str()
+    );
+    if (trv::sys::write_profile_to_file(profile_filepath)) {
+      trv::sys::logger.warn(
+        "Failed to save stage profile to %s.", profile_filepath
+      );
+    } else {
+      trv::sys::logger.info("Stage profile saved to %s.", profile_filepath);
+    }
+  }
+
   if (trv::sys::currTask == 0) {
     std::printf("%s\n", std::string(80, '<').c_str());
   }
 
+  trv::sys::finalise_fftw();
+#ifdef TRV_USE_MPI
+  fftw_mpi_cleanup();
+#endif  // TRV_USE_MPI
+  trv::sys::finalise_tasks();
+
   return 0;
 }
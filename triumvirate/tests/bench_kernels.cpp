@@ -0,0 +1,479 @@
+// Copyright (C) [GPLv3 Licence]
+//
+// This file is part of the Triumvirate program. See the COPYRIGHT
+// and LICENCE files at the top-level directory of this distribution
+// for details of copyright and licensing.
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file bench_kernels.cpp
+ * @brief Micro-benchmarks of hot kernels.
+ *
+ * Cases are parameterised over the mesh grid number, particle number
+ * and (with OpenMP) thread number where relevant.  Run with
+ * `make bench`, which saves the results in JSON format; further options
+ * (e.g. `--benchmark_filter=<regex>`) can be passed through `BENCHARGS`.
+ * Kernel results are sanity-checked after timing, and failed checks are
+ * reported as benchmark errors (see `make benchtest`).
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "monitor.hpp"
+#include "parameters.hpp"
+#include "maths.hpp"
+#include "fftlog.hpp"
+#include "particles.hpp"
+#include "dataobjs.hpp"
+#include "field.hpp"
+
+/// **********************************************************************
+/// Set-up
+/// **********************************************************************
+
+const double BOXSIZE = 1000.;  ///< box size (in Mpc/h)
+
+/**
+ * @brief Return the thread numbers to benchmark.
+ *
+ * @returns Thread numbers, i.e. one and (with OpenMP) the maximum.
+ */
+std::vector<std::int64_t> get_thread_nums() {
+  std::vector<std::int64_t> thread_nums = {1};
+#ifdef TRV_USE_OMP
+  if (omp_get_max_threads() > 1) {
+    thread_nums.push_back(omp_get_max_threads());
+  }
+#endif  // TRV_USE_OMP
+  return thread_nums;
+}
+
+/**
+ * @brief Set the thread number for the benchmarked kernel.
+ *
+ * @param nthreads Thread number.
+ */
+void set_thread_num(int nthreads) {
+#ifdef TRV_USE_OMP
+  omp_set_num_threads(nthreads);
+#endif  // TRV_USE_OMP
+  (void) nthreads;
+}
+
+/**
+ * @brief Set up mesh parameters in a cubic box.
+ *
+ * @param ngrid Grid number in each dimension.
+ * @param assignment Mesh assignment scheme.
+ * @param interlace Interlacing switch.
+ * @returns Parameter set.
+ */
+trv::ParameterSet set_mesh_params(
+  int ngrid, std::string assignment = "tsc", std::string interlace = "false"
+) {
+  trv::ParameterSet params;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    params.boxsize[iaxis] = BOXSIZE;
+    params.ngrid[iaxis] = ngrid;
+  }
+  params.volume = BOXSIZE * BOXSIZE * BOXSIZE;
+  params.nmesh = ngrid * ngrid * ngrid;
+  params.assignment = assignment;
+  params.interlace = interlace;
+  params.catalogue_type = "sim";
+  params.statistic_type = "powspec";
+  params.npoint = "2pt";
+  params.space = "fourier";
+  params.ell1 = 0; params.ell2 = 0; params.ELL = 0;
+  params.i_wa = 0; params.j_wa = 0;
+  params.bin_min = 0.; params.bin_max = 0.;
+  params.num_bins = 0; params.idx_bin = 0;
+
+  return params;
+}
+
+/**
+ * @brief Load uniformly random particles in the box.
+ *
+ * @param[out] catalogue Particle catalogue.
+ * @param npart Particle number.
+ */
+void load_random_particles(trv::ParticleCatalogue& catalogue, int npart) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> uniform(0., BOXSIZE);
+
+  std::vector<double> x(npart), y(npart), z(npart);
+  std::vector<double> nz(npart, npart / (BOXSIZE * BOXSIZE * BOXSIZE));
+  std::vector<double> ws(npart, 1.), wc(npart, 1.);
+  for (int pid = 0; pid < npart; pid++) {
+    x[pid] = uniform(gen); y[pid] = uniform(gen); z[pid] = uniform(gen);
+  }
+
+  catalogue.load_particle_data(x, y, z, nz, ws, wc);
+}
+
+
+/// **********************************************************************
+/// Mesh assignment
+/// **********************************************************************
+
+/// Arguments: grid number, particle number, thread number.
+void BM_MeshAssignment(
+  benchmark::State& state, std::string assignment, std::string interlace
+) {
+  set_thread_num(state.range(2));
+
+  trv::ParameterSet params = set_mesh_params(
+    state.range(0), assignment, interlace
+  );
+  trv::ParticleCatalogue catalogue;
+  load_random_particles(catalogue, state.range(1));
+
+  trv::MeshField field(params);
+  for (auto _ : state) {
+    field.compute_unweighted_field(catalogue);
+    benchmark::ClobberMemory();
+  }
+
+  /// Check the particle number is conserved by the assignment.
+  double npart_assigned = 0.;
+  for (long long gid = 0; gid < params.nmesh; gid++) {
+    npart_assigned += field[gid][0];
+  }
+  npart_assigned *= params.volume / double(params.nmesh);
+  if (std::fabs(npart_assigned - state.range(1)) > 1.e-6 * state.range(1)) {
+    state.SkipWithError("Assigned particle number is not conserved.");
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+void set_assignment_args(benchmark::internal::Benchmark* bm) {
+  bm->ArgNames({"ngrid", "npart", "nthreads"})
+    ->ArgsProduct({{64, 128}, {100000, 1000000}, get_thread_nums()})
+    ->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_CAPTURE(BM_MeshAssignment, ngp, "ngp", "false")
+  ->Apply(set_assignment_args);
+BENCHMARK_CAPTURE(BM_MeshAssignment, cic, "cic", "false")
+  ->Apply(set_assignment_args);
+BENCHMARK_CAPTURE(BM_MeshAssignment, tsc, "tsc", "false")
+  ->Apply(set_assignment_args);
+BENCHMARK_CAPTURE(BM_MeshAssignment, pcs, "pcs", "false")
+  ->Apply(set_assignment_args);
+BENCHMARK_CAPTURE(BM_MeshAssignment, ngp_interlaced, "ngp", "true")
+  ->Apply(set_assignment_args);
+BENCHMARK_CAPTURE(BM_MeshAssignment, cic_interlaced, "cic", "true")
+  ->Apply(set_assignment_args);
+BENCHMARK_CAPTURE(BM_MeshAssignment, tsc_interlaced, "tsc", "true")
+  ->Apply(set_assignment_args);
+BENCHMARK_CAPTURE(BM_MeshAssignment, pcs_interlaced, "pcs", "true")
+  ->Apply(set_assignment_args);
+
+
+/// **********************************************************************
+/// Mesh FFTs
+/// **********************************************************************
+
+void set_mesh_args(benchmark::internal::Benchmark* bm) {
+  bm->ArgNames({"ngrid", "nthreads"})
+    ->ArgsProduct({{64, 128, 256}, get_thread_nums()})
+    ->Unit(benchmark::kMillisecond);
+}
+
+/// Arguments: grid number, thread number.
+void BM_MeshFFT(benchmark::State& state) {
+  set_thread_num(state.range(1));
+
+  trv::ParameterSet params = set_mesh_params(state.range(0));
+  trv::MeshField field(params);
+  for (auto _ : state) {
+    field.fourier_transform();
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * params.nmesh);
+}
+BENCHMARK(BM_MeshFFT)->Apply(set_mesh_args);
+
+/// Arguments: grid number, thread number.
+void BM_MeshInvFFT(benchmark::State& state) {
+  set_thread_num(state.range(1));
+
+  trv::ParameterSet params = set_mesh_params(state.range(0));
+  trv::MeshField field(params);
+  for (auto _ : state) {
+    field.inv_fourier_transform();
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * params.nmesh);
+}
+BENCHMARK(BM_MeshInvFFT)->Apply(set_mesh_args);
+
+
+/// **********************************************************************
+/// Field statistics
+/// **********************************************************************
+
+/// Arguments: grid number, thread number.
+void BM_FieldStatsFourier(benchmark::State& state) {
+  set_thread_num(state.range(1));
+
+  trv::ParameterSet params = set_mesh_params(state.range(0));
+  trv::ParticleCatalogue catalogue;
+  load_random_particles(catalogue, 100000);
+
+  trv::MeshField field(params);
+  field.compute_unweighted_field_fluctuations_insitu(catalogue);
+  field.fourier_transform();
+
+  trv::Binning kbinning("fourier", "lin");
+  kbinning.set_bins(0.005, 0.205, 20);
+
+  trv::FieldStats stats(params);
+  for (auto _ : state) {
+    stats.compute_ylm_wgtd_2pt_stats_in_fourier(
+      field, field, std::complex<double>(0., 0.), 0, 0, kbinning
+    );
+    benchmark::DoNotOptimize(stats.pk.data());
+  }
+
+  /// Check the auto-power spectrum is non-negative in populated bins.
+  for (int ibin = 0; ibin < kbinning.num_bins; ibin++) {
+    if (stats.nmodes[ibin] <= 0 || !(stats.pk[ibin].real() >= 0.)) {
+      state.SkipWithError("Binned power spectrum is invalid.");
+      break;
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * params.nmesh);
+}
+BENCHMARK(BM_FieldStatsFourier)->Apply(set_mesh_args);
+
+/// Arguments: grid number, thread number.
+void BM_FieldStatsConfig(benchmark::State& state) {
+  set_thread_num(state.range(1));
+
+  trv::ParameterSet params = set_mesh_params(state.range(0));
+  trv::ParticleCatalogue catalogue;
+  load_random_particles(catalogue, 100000);
+
+  trv::MeshField field(params);
+  field.compute_unweighted_field_fluctuations_insitu(catalogue);
+  field.fourier_transform();
+
+  trv::Binning rbinning("config", "lin");
+  rbinning.set_bins(0.5, 200.5, 20);
+
+  trv::FieldStats stats(params);
+  for (auto _ : state) {
+    stats.compute_ylm_wgtd_2pt_stats_in_config(
+      field, field, std::complex<double>(0., 0.), 0, 0, rbinning
+    );
+    benchmark::DoNotOptimize(stats.xi.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * params.nmesh);
+}
+BENCHMARK(BM_FieldStatsConfig)->Apply(set_mesh_args);
+
+
+/// **********************************************************************
+/// Spherical harmonics
+/// **********************************************************************
+
+/// Arguments: grid number, degree, thread number.
+void BM_YlmTable(benchmark::State& state) {
+  set_thread_num(state.range(2));
+
+  const int ngrid[3] = {
+    int(state.range(0)), int(state.range(0)), int(state.range(0))
+  };
+  const double boxsize[3] = {BOXSIZE, BOXSIZE, BOXSIZE};
+  const int ell = state.range(1);
+
+  std::vector< std::complex<double> > ylm(
+    (long long)(ngrid[0]) * ngrid[1] * ngrid[2]
+  );
+  for (auto _ : state) {
+    trv::maths::SphericalHarmonicCalculator::
+      store_reduced_spherical_harmonic_in_fourier_space(
+        ell, ell, boxsize, ngrid, ylm
+      );
+    benchmark::DoNotOptimize(ylm.data());
+  }
+
+  /// Check the reduced spherical harmonics are unity for the monopole
+  /// and bounded by the normalisation otherwise.
+  const double ylm_bound = (ell == 0) ? 1. : std::sqrt(4. * M_PI);
+  for (const auto& ylm_val : ylm) {
+    if ((ell == 0 && ylm_val != std::complex<double>(1., 0.))
+        || !(std::abs(ylm_val) <= ylm_bound)) {
+      state.SkipWithError("Spherical harmonic table is invalid.");
+      break;
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * ylm.size());
+}
+BENCHMARK(BM_YlmTable)
+  ->ArgNames({"ngrid", "ell", "nthreads"})
+  ->ArgsProduct({{64, 128}, {0, 2, 4}, get_thread_nums()})
+  ->Unit(benchmark::kMillisecond);
+
+
+/// **********************************************************************
+/// Spherical Bessel functions
+/// **********************************************************************
+
+/// Arguments: order.
+void BM_SphericalBesselConstruction(benchmark::State& state) {
+  const int ell = state.range(0);
+  for (auto _ : state) {
+    trv::maths::SphericalBesselCalculator sj(ell);
+    benchmark::DoNotOptimize(&sj);
+  }
+}
+BENCHMARK(BM_SphericalBesselConstruction)
+  ->ArgNames({"ell"})
+  ->Arg(0)->Arg(2)->Arg(4)
+  ->Unit(benchmark::kMillisecond);
+
+/// Arguments: order.
+void BM_SphericalBesselEvaluation(benchmark::State& state) {
+  const int ell = state.range(0);
+  const int nsample = 100000;
+
+  trv::maths::SphericalBesselCalculator sj(ell);
+
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> uniform(0., 1000.);
+  std::vector<double> x(nsample);
+  for (int i = 0; i < nsample; i++) {x[i] = uniform(gen);}
+
+  for (auto _ : state) {
+    double sum = 0.;
+    for (int i = 0; i < nsample; i++) {sum += sj.eval(x[i]);}
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(state.iterations() * nsample);
+}
+BENCHMARK(BM_SphericalBesselEvaluation)
+  ->ArgNames({"ell"})
+  ->Arg(0)->Arg(2)->Arg(4)
+  ->Unit(benchmark::kMillisecond);
+
+
+/// **********************************************************************
+/// Hankel transform
+/// **********************************************************************
+
+/// Arguments: sample number.
+void BM_HankelTransform(benchmark::State& state) {
+  const int nsample = state.range(0);
+
+  std::vector<double> r(nsample), k(nsample);
+  std::vector< std::complex<double> > a(nsample), b(nsample);
+  for (int i = 0; i < nsample; i++) {
+    r[i] = 1.e-3 * std::pow(1.e7, double(i) / (nsample - 1));
+    a[i] = r[i] * std::exp(-r[i] * r[i]);
+  }
+
+  for (auto _ : state) {
+    trv::maths::hankel_transform(
+      0.5, 0., 1., nsample, true, r.data(), a.data(), k.data(), b.data(),
+      nullptr
+    );
+    benchmark::DoNotOptimize(b.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * nsample);
+}
+BENCHMARK(BM_HankelTransform)
+  ->ArgNames({"nsample"})
+  ->RangeMultiplier(4)->Range(1 << 10, 1 << 16)
+  ->Unit(benchmark::kMicrosecond);
+
+
+/// **********************************************************************
+/// Catalogue parsing
+/// **********************************************************************
+
+/// Arguments: particle number, thread number.
+void BM_CatalogueParsing(benchmark::State& state) {
+  set_thread_num(state.range(1));
+
+  const int npart = state.range(0);
+
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> uniform(0., BOXSIZE);
+  std::vector<std::string> lines(npart);
+  char line_buf[256];
+  for (int pid = 0; pid < npart; pid++) {
+    std::snprintf(
+      line_buf, sizeof(line_buf),
+      "%.9e %.9e %.9e %.9e %.9e %.9e",
+      uniform(gen), uniform(gen), uniform(gen), 1.e-4, 1., 1.
+    );
+    lines[pid] = line_buf;
+  }
+
+  std::vector<int> name_indices =
+    trv::ParticleCatalogue::get_column_indices("x,y,z,nz,ws,wc");
+  std::vector<trv::ParticleCatalogue::ParticleData> particles(npart);
+
+  for (auto _ : state) {
+#ifdef TRV_USE_OMP
+#pragma omp parallel for
+#endif  // TRV_USE_OMP
+    for (int pid = 0; pid < npart; pid++) {
+      trv::ParticleCatalogue::parse_catalogue_line(
+        lines[pid], name_indices, 0., particles[pid]
+      );
+    }
+    benchmark::DoNotOptimize(particles.data());
+  }
+
+  /// Check the parsed values against the catalogue lines.
+  for (int pid = 0; pid < npart; pid++) {
+    double x_line = std::strtod(lines[pid].c_str(), nullptr);
+    if (particles[pid].pos[0] != x_line || particles[pid].nz != 1.e-4) {
+      state.SkipWithError("Parsed particle data differ.");
+      break;
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * npart);
+}
+BENCHMARK(BM_CatalogueParsing)
+  ->ArgNames({"npart", "nthreads"})
+  ->ArgsProduct({{100000, 1000000}, get_thread_nums()})
+  ->Unit(benchmark::kMillisecond);
+
+
+BENCHMARK_MAIN();
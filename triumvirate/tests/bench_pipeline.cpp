@@ -0,0 +1,896 @@
+// Copyright (C) [GPLv3 Licence]
+//
+// This file is part of the Triumvirate program. See the COPYRIGHT
+// and LICENCE files at the top-level directory of this distribution
+// for details of copyright and licensing.
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file bench_pipeline.cpp
+ * @brief End-to-end benchmarks of clustering measurements on synthetic
+ *        catalogues.
+ *
+ * Reproducible synthetic data and random catalogues are generated in
+ * a survey-like geometry, and the power spectrum, two-point correlation
+ * function, bispectrum and three-point correlation function are
+ * measured over a sweep of mesh grid numbers and (with OpenMP) thread
+ * numbers.  The wall time, stage profile and peak memory usage of each
+ * run, together with strong/weak scaling curves, are saved in a single
+ * JSON report.  Run with `make benchpipe`, passing options of the form
+ * `--<name>=<value>` through `BENCHPIPEARGS` (see `--help`).
+ *
+ */
+
+#include <fftw3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "monitor.hpp"
+#include "parameters.hpp"
+#include "particles.hpp"
+#include "dataobjs.hpp"
+#include "twopt.hpp"
+#include "threept.hpp"
+
+namespace trvs = trv::sys;
+
+/// **********************************************************************
+/// Options
+/// **********************************************************************
+
+const double FILL_FRACTION = 0.98;  ///< fraction of the box size spanned
+                                    ///< by the catalogue geometry
+
+/**
+ * @brief Benchmark options.
+ *
+ */
+struct BenchOptions {
+  std::string catalogue = "uniform";  ///< synthetic data catalogue:
+                                      ///< {"uniform", "blobs",
+                                      ///< "lognormal"}
+  std::string geometry = "shell";     ///< catalogue geometry:
+                                      ///< {"shell", "box"}
+  double boxsize = 1000.;             ///< box size (in Mpc/h)
+  int ndata = 100000;                 ///< data particle number
+  double rand_ratio = 5.;             ///< random-to-data number ratio
+  std::vector<int> ngrids = {64};     ///< mesh grid numbers
+  std::vector<int> thread_nums;       ///< thread numbers
+  std::string scaling = "strong";     ///< scaling sweep:
+                                      ///< {"strong", "weak", "both"}
+  std::vector<std::string> statistics = {
+    "powspec", "2pcf", "bispec", "3pcf"
+  };                                  ///< measured statistics
+  std::string assignment = "tsc";     ///< mesh assignment scheme
+  std::string interlace = "false";    ///< interlacing switch
+  int num_bins = 10;                  ///< number of measurement bins
+  int repeats = 1;                    ///< number of repeats per run
+  unsigned seed = 42;                 ///< random seed
+  double blob_radius = 10.;           ///< Gaussian blob radius
+                                      ///< (in Mpc/h)
+  int blob_members = 50;              ///< mean number of particles
+                                      ///< per blob
+  double lognormal_sigma = 1.;        ///< standard deviation of the
+                                      ///< Gaussian field
+  int lognormal_ngrid = 64;           ///< grid number of the lognormal
+                                      ///< density field
+  std::string tag = "";               ///< report tag (e.g. release)
+  std::string output = "bench_pipeline.json";  ///< report file path
+  int verbose = 40;                   ///< logging verbosity level
+};
+
+/**
+ * @brief Split a comma-separated list.
+ *
+ * @param list_str List string.
+ * @returns List entries.
+ */
+std::vector<std::string> split_list(const std::string& list_str) {
+  std::vector<std::string> entries;
+  std::stringstream ss(list_str);
+  std::string entry;
+  while (std::getline(ss, entry, ',')) {
+    if (!entry.empty()) {entries.push_back(entry);}
+  }
+  return entries;
+}
+
+/**
+ * @brief Split a comma-separated list of integers.
+ *
+ * @param list_str List string.
+ * @returns List entries.
+ */
+std::vector<int> split_int_list(const std::string& list_str) {
+  std::vector<int> entries;
+  for (const std::string& entry : split_list(list_str)) {
+    entries.push_back(std::atoi(entry.c_str()));
+  }
+  return entries;
+}
+
+/**
+ * @brief Print the usage message.
+ */
+void print_usage() {
+  std::printf(
+    "Usage: bench_pipeline [--<name>=<value> ...]\n"
+    "  --catalogue=uniform|blobs|lognormal   synthetic data catalogue\n"
+    "  --geometry=shell|box                  catalogue geometry\n"
+    "  --boxsize=<L>                         box size in Mpc/h\n"
+    "  --ndata=<N>                           data particle number\n"
+    "  --rand-ratio=<R>                      random-to-data number ratio\n"
+    "  --ngrid=<n1>,<n2>,...                 mesh grid numbers\n"
+    "  --threads=<t1>,<t2>,...               thread numbers\n"
+    "  --scaling=strong|weak|both            scaling sweep\n"
+    "  --statistics=powspec,2pcf,bispec,3pcf measured statistics\n"
+    "  --assignment=ngp|cic|tsc|pcs          mesh assignment scheme\n"
+    "  --interlace=true|false                interlacing switch\n"
+    "  --num-bins=<nbins>                    number of measurement bins\n"
+    "  --repeats=<nrep>                      number of repeats per run\n"
+    "  --seed=<seed>                         random seed\n"
+    "  --blob-radius=<R>                     Gaussian blob radius\n"
+    "  --blob-members=<M>                    mean particles per blob\n"
+    "  --lognormal-sigma=<sigma>             Gaussian field deviation\n"
+    "  --lognormal-ngrid=<n>                 lognormal field grid number\n"
+    "  --tag=<tag>                           report tag (e.g. release)\n"
+    "  --output=<path>                       report file path\n"
+    "  --verbose=<level>                     logging verbosity level\n"
+  );
+}
+
+/**
+ * @brief Parse and validate command-line options.
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Command-line arguments.
+ * @param[out] opts Benchmark options.
+ * @returns Exit status (1 if only the usage is requested).
+ * @throws trv::sys::InvalidParameter When an option is unrecognised or
+ *                                    invalid.
+ */
+int parse_options(int argc, char* argv[], BenchOptions& opts) {
+  for (int iarg = 1; iarg < argc; iarg++) {
+    std::string arg = argv[iarg];
+    if (arg == "--help" || arg == "-h") {
+      if (trvs::currTask == 0) {print_usage();}
+      return 1;
+    }
+
+    std::size_t pos_eq = arg.find('=');
+    std::string name = arg.substr(0, pos_eq);
+    std::string value =
+      (pos_eq == std::string::npos) ? "" : arg.substr(pos_eq + 1);
+
+    if (name == "--catalogue") {opts.catalogue = value;} else
+    if (name == "--geometry") {opts.geometry = value;} else
+    if (name == "--boxsize") {opts.boxsize = std::atof(value.c_str());} else
+    if (name == "--ndata") {opts.ndata = std::atoi(value.c_str());} else
+    if (name == "--rand-ratio") {
+      opts.rand_ratio = std::atof(value.c_str());
+    } else
+    if (name == "--ngrid") {opts.ngrids = split_int_list(value);} else
+    if (name == "--threads") {opts.thread_nums = split_int_list(value);} else
+    if (name == "--scaling") {opts.scaling = value;} else
+    if (name == "--statistics") {opts.statistics = split_list(value);} else
+    if (name == "--assignment") {opts.assignment = value;} else
+    if (name == "--interlace") {opts.interlace = value;} else
+    if (name == "--num-bins") {opts.num_bins = std::atoi(value.c_str());} else
+    if (name == "--repeats") {opts.repeats = std::atoi(value.c_str());} else
+    if (name == "--seed") {opts.seed = std::atoi(value.c_str());} else
+    if (name == "--blob-radius") {
+      opts.blob_radius = std::atof(value.c_str());
+    } else
+    if (name == "--blob-members") {
+      opts.blob_members = std::atoi(value.c_str());
+    } else
+    if (name == "--lognormal-sigma") {
+      opts.lognormal_sigma = std::atof(value.c_str());
+    } else
+    if (name == "--lognormal-ngrid") {
+      opts.lognormal_ngrid = std::atoi(value.c_str());
+    } else
+    if (name == "--tag") {opts.tag = value;} else
+    if (name == "--output") {opts.output = value;} else
+    if (name == "--verbose") {opts.verbose = std::atoi(value.c_str());} else
+    {
+      if (trvs::currTask == 0) {
+        trvs::logger.error("Unrecognised option: '%s'.", arg.c_str());
+        throw trvs::InvalidParameter(
+          "Unrecognised option: '%s'.\n", arg.c_str()
+        );
+      }
+    }
+  }
+
+  if (opts.thread_nums.empty()) {
+    opts.thread_nums.push_back(1);
+#ifdef TRV_USE_OMP
+    if (omp_get_max_threads() > 1) {
+      opts.thread_nums.push_back(omp_get_max_threads());
+    }
+#endif  // TRV_USE_OMP
+  }
+  std::sort(opts.thread_nums.begin(), opts.thread_nums.end());
+
+  if (!(
+    opts.catalogue == "uniform"
+    || opts.catalogue == "blobs"
+    || opts.catalogue == "lognormal"
+  )) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Synthetic catalogue must be 'uniform', 'blobs' or 'lognormal': "
+        "`catalogue` = '%s'.",
+        opts.catalogue.c_str()
+      );
+      throw trvs::InvalidParameter(
+        "Synthetic catalogue must be 'uniform', 'blobs' or 'lognormal': "
+        "`catalogue` = '%s'.\n",
+        opts.catalogue.c_str()
+      );
+    }
+  }
+  if (!(opts.geometry == "shell" || opts.geometry == "box")) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Catalogue geometry must be 'shell' or 'box': `geometry` = '%s'.",
+        opts.geometry.c_str()
+      );
+      throw trvs::InvalidParameter(
+        "Catalogue geometry must be 'shell' or 'box': `geometry` = '%s'.\n",
+        opts.geometry.c_str()
+      );
+    }
+  }
+  if (!(
+    opts.scaling == "strong" || opts.scaling == "weak"
+    || opts.scaling == "both"
+  )) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error(
+        "Scaling sweep must be 'strong', 'weak' or 'both': "
+        "`scaling` = '%s'.",
+        opts.scaling.c_str()
+      );
+      throw trvs::InvalidParameter(
+        "Scaling sweep must be 'strong', 'weak' or 'both': "
+        "`scaling` = '%s'.\n",
+        opts.scaling.c_str()
+      );
+    }
+  }
+  for (const std::string& statistic : opts.statistics) {
+    if (!(
+      statistic == "powspec" || statistic == "2pcf"
+      || statistic == "bispec" || statistic == "3pcf"
+    )) {
+      if (trvs::currTask == 0) {
+        trvs::logger.error(
+          "Statistic must be 'powspec', '2pcf', 'bispec' or '3pcf': "
+          "`statistics` entry = '%s'.",
+          statistic.c_str()
+        );
+        throw trvs::InvalidParameter(
+          "Statistic must be 'powspec', '2pcf', 'bispec' or '3pcf': "
+          "`statistics` entry = '%s'.\n",
+          statistic.c_str()
+        );
+      }
+    }
+  }
+  if (opts.boxsize <= 0. || opts.ndata <= 0 || opts.rand_ratio <= 0.
+      || opts.repeats <= 0 || opts.blob_radius <= 0.
+      || opts.blob_members <= 0 || opts.lognormal_sigma <= 0.
+      || opts.lognormal_ngrid <= 0 || opts.thread_nums.front() <= 0) {
+    if (trvs::currTask == 0) {
+      trvs::logger.error("Numerical options must be positive.");
+      throw trvs::InvalidParameter("Numerical options must be positive.\n");
+    }
+  }
+
+  return 0;
+}
+
+
+/// **********************************************************************
+/// Synthetic catalogues
+/// **********************************************************************
+
+/**
+ * @brief Check whether a position lies inside the catalogue geometry.
+ *
+ * The geometry is centred at the origin (the observer), either as a
+ * spherical shell between a quarter and a half of the filled box size
+ * in radius, or as the filled box itself.
+ *
+ * @param opts Benchmark options.
+ * @param pos Particle position.
+ * @returns Whether the position is inside the geometry.
+ */
+bool is_in_geometry(const BenchOptions& opts, const double pos[3]) {
+  double half_size = FILL_FRACTION * opts.boxsize / 2.;
+  if (opts.geometry == "shell") {
+    double r2 = pos[0] * pos[0] + pos[1] * pos[1] + pos[2] * pos[2];
+    return (half_size * half_size / 4. <= r2) && (r2 < half_size * half_size);
+  }
+  return std::fabs(pos[0]) < half_size
+    && std::fabs(pos[1]) < half_size
+    && std::fabs(pos[2]) < half_size;
+}
+
+/**
+ * @brief Calculate the volume of the catalogue geometry.
+ *
+ * @param opts Benchmark options.
+ * @returns Geometry volume (in Mpc^3/h^3).
+ */
+double calc_geometry_volume(const BenchOptions& opts) {
+  double half_size = FILL_FRACTION * opts.boxsize / 2.;
+  if (opts.geometry == "shell") {
+    return 4. * M_PI / 3. * (7. / 8.) * std::pow(half_size, 3);
+  }
+  return std::pow(2. * half_size, 3);
+}
+
+/**
+ * @brief Generate the lognormal density field as cell weights.
+ *
+ * A Gaussian random field with a power spectrum turning over at
+ * @f$ k_0 = 0.02\, h\,\mathrm{Mpc}^{-1} @f$, i.e.
+ * @f$ P(k) \propto k / [1 + (k/k_0)^2]^2 @f$, is normalised to the
+ * requested standard deviation @f$ \sigma @f$ and exponentiated,
+ * @f$ 1 + \delta = \exp(G - \sigma^2/2) @f$.
+ *
+ * @param opts Benchmark options.
+ * @param gen Random number generator.
+ * @returns Cell weights proportional to the density.
+ */
+std::vector<double> generate_lognormal_weights(
+  const BenchOptions& opts, std::mt19937& gen
+) {
+  const int ngrid = opts.lognormal_ngrid;
+  const long long ncell = (long long)(ngrid) * ngrid * ngrid;
+  const double size = FILL_FRACTION * opts.boxsize;
+  const double dk = 2. * M_PI / size;
+  const double K0 = 0.02;  // turnover wavenumber (in h/Mpc)
+
+  fftw_complex* field = fftw_alloc_complex(ncell);
+  fftw_plan forward_transform = fftw_plan_dft_3d(
+    ngrid, ngrid, ngrid, field, field, FFTW_FORWARD, FFTW_ESTIMATE
+  );
+  fftw_plan backward_transform = fftw_plan_dft_3d(
+    ngrid, ngrid, ngrid, field, field, FFTW_BACKWARD, FFTW_ESTIMATE
+  );
+
+  /// Filter white noise with the power spectrum.
+  std::normal_distribution<double> normal(0., 1.);
+  for (long long idx = 0; idx < ncell; idx++) {
+    field[idx][0] = normal(gen);
+    field[idx][1] = 0.;
+  }
+
+  fftw_execute(forward_transform);
+
+  for (int i = 0; i < ngrid; i++) {
+    for (int j = 0; j < ngrid; j++) {
+      for (int k = 0; k < ngrid; k++) {
+        long long idx = ((long long)(i) * ngrid + j) * ngrid + k;
+        double kx = dk * ((i < ngrid / 2) ? i : i - ngrid);
+        double ky = dk * ((j < ngrid / 2) ? j : j - ngrid);
+        double kz = dk * ((k < ngrid / 2) ? k : k - ngrid);
+        double kmag = std::sqrt(kx * kx + ky * ky + kz * kz);
+        double amp = std::sqrt(
+          kmag / std::pow(1. + (kmag / K0) * (kmag / K0), 2)
+        );
+        field[idx][0] *= amp;
+        field[idx][1] *= amp;
+      }
+    }
+  }
+
+  fftw_execute(backward_transform);
+
+  /// Normalise and exponentiate the Gaussian field.
+  double mean = 0., var = 0.;
+  for (long long idx = 0; idx < ncell; idx++) {
+    mean += field[idx][0];
+    var += field[idx][0] * field[idx][0];
+  }
+  mean /= double(ncell);
+  var = var / double(ncell) - mean * mean;
+
+  const double sigma = opts.lognormal_sigma;
+  std::vector<double> weights(ncell);
+  for (long long idx = 0; idx < ncell; idx++) {
+    double gauss = sigma * (field[idx][0] - mean) / std::sqrt(var);
+    weights[idx] = std::exp(gauss - sigma * sigma / 2.);
+  }
+
+  fftw_destroy_plan(forward_transform);
+  fftw_destroy_plan(backward_transform);
+  fftw_free(field);
+
+  return weights;
+}
+
+/**
+ * @brief Generate a synthetic catalogue inside the catalogue geometry.
+ *
+ * Candidate positions are drawn in the filled box, uniformly, around
+ * uniformly placed Gaussian blobs (wrapped periodically) or in cells
+ * drawn by lognormal density weight, and rejected outside the
+ * geometry.  All particles carry unit weights and the mean data number
+ * density as their redshift-dependent number density.
+ *
+ * @param opts Benchmark options.
+ * @param catalogue Synthetic catalogue type.
+ * @param npart Particle number.
+ * @param nbar Mean data number density (in h^3/Mpc^3).
+ * @param seed Random seed.
+ * @param[out] particles Particle catalogue.
+ */
+void generate_catalogue(
+  const BenchOptions& opts, const std::string& catalogue,
+  int npart, double nbar, unsigned seed, trv::ParticleCatalogue& particles
+) {
+  std::mt19937 gen(seed);
+  const double size = FILL_FRACTION * opts.boxsize;
+  std::uniform_real_distribution<double> uniform(-size / 2., size / 2.);
+  std::uniform_real_distribution<double> unit(0., 1.);
+  std::normal_distribution<double> normal(0., opts.blob_radius);
+
+  std::vector<double> centres;
+  if (catalogue == "blobs") {
+    int ncentres = std::max(1, opts.ndata / opts.blob_members);
+    centres.resize(3 * ncentres);
+    for (double& centre_coord : centres) {centre_coord = uniform(gen);}
+  }
+  std::uniform_int_distribution<int> pick_centre(
+    0, std::max(0, int(centres.size()) / 3 - 1)
+  );
+
+  std::discrete_distribution<long long> pick_cell;
+  const int ngrid_ln = opts.lognormal_ngrid;
+  if (catalogue == "lognormal") {
+    std::vector<double> weights = generate_lognormal_weights(opts, gen);
+    pick_cell = std::discrete_distribution<long long>(
+      weights.begin(), weights.end()
+    );
+  }
+
+  std::vector<double> x, y, z;
+  x.reserve(npart); y.reserve(npart); z.reserve(npart);
+  double pos[3];
+  while (int(x.size()) < npart) {
+    if (catalogue == "uniform") {
+      for (int iaxis = 0; iaxis < 3; iaxis++) {pos[iaxis] = uniform(gen);}
+    } else
+    if (catalogue == "blobs") {
+      int icentre = pick_centre(gen);
+      for (int iaxis = 0; iaxis < 3; iaxis++) {
+        pos[iaxis] = centres[3 * icentre + iaxis] + normal(gen);
+        pos[iaxis] -= size * std::floor(pos[iaxis] / size + 0.5);
+      }
+    } else
+    if (catalogue == "lognormal") {
+      long long idx = pick_cell(gen);
+      long long idx_cell[3] = {
+        idx / ((long long)(ngrid_ln) * ngrid_ln),
+        (idx / ngrid_ln) % ngrid_ln,
+        idx % ngrid_ln
+      };
+      for (int iaxis = 0; iaxis < 3; iaxis++) {
+        pos[iaxis] = size * ((idx_cell[iaxis] + unit(gen)) / ngrid_ln - 0.5);
+      }
+    }
+
+    if (is_in_geometry(opts, pos)) {
+      x.push_back(pos[0]); y.push_back(pos[1]); z.push_back(pos[2]);
+    }
+  }
+
+  std::vector<double> nz(npart, nbar), ws(npart, 1.), wc(npart, 1.);
+  particles.load_particle_data(x, y, z, nz, ws, wc);
+}
+
+
+/// **********************************************************************
+/// Measurements
+/// **********************************************************************
+
+/**
+ * @brief Set up measurement parameters.
+ *
+ * Fourier-space bins span from the fundamental wavenumber to half the
+ * Nyquist wavenumber, and configuration-space bins from twice the grid
+ * cell size to a quarter of the box size.
+ *
+ * @param opts Benchmark options.
+ * @param ngrid Grid number in each dimension.
+ * @param statistic Statistic type.
+ * @returns Parameter set.
+ */
+trv::ParameterSet set_params(
+  const BenchOptions& opts, int ngrid, const std::string& statistic
+) {
+  trv::ParameterSet params;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    params.boxsize[iaxis] = opts.boxsize;
+    params.ngrid[iaxis] = ngrid;
+  }
+  params.volume = opts.boxsize * opts.boxsize * opts.boxsize;
+  params.nmesh = ngrid * ngrid * ngrid;
+  params.alignment = "centre";
+  params.assignment = opts.assignment;
+  params.interlace = opts.interlace;
+  params.catalogue_type = "survey";
+  params.statistic_type = statistic;
+  params.norm_convention = "particle";
+  params.binning = "lin";
+  params.form = "diag";
+  params.ell1 = 0; params.ell2 = 0; params.ELL = 0;
+  params.i_wa = 0; params.j_wa = 0;
+  params.num_bins = opts.num_bins;
+  params.idx_bin = 0;
+  params.verbose = opts.verbose;
+
+  if (statistic == "powspec" || statistic == "bispec") {
+    params.bin_min = 2. * M_PI / opts.boxsize;
+    params.bin_max = M_PI * ngrid / opts.boxsize / 2.;
+  } else {
+    params.bin_min = 2. * opts.boxsize / ngrid;
+    params.bin_max = opts.boxsize / 4.;
+  }
+
+  params.validate();
+
+  return params;
+}
+
+/**
+ * @brief Perform one measurement of a statistic as a profiled run.
+ *
+ * The run covers box alignment, normalisation and the measurement,
+ * mirroring the stages of the Triumvirate program after catalogue I/O.
+ *
+ * @param params Parameter set.
+ * @param catalogue_data Data-source catalogue.
+ * @param catalogue_rand Random-source catalogue.
+ * @returns Wall time (in seconds).
+ */
+double run_measurement(
+  trv::ParameterSet& params,
+  trv::ParticleCatalogue& catalogue_data,
+  trv::ParticleCatalogue& catalogue_rand
+) {
+  trv::Binning binning(params);
+  binning.set_bins();
+
+  trvs::enable_profiling();
+  trvs::record_profile_quantity("ngrid_x", params.ngrid[0]);
+  trvs::record_profile_quantity("ngrid_y", params.ngrid[1]);
+  trvs::record_profile_quantity("ngrid_z", params.ngrid[2]);
+  trvs::record_profile_quantity("nmesh", params.nmesh);
+  trvs::record_profile_quantity("nparticles_data", catalogue_data.ntotal);
+  trvs::record_profile_quantity("nparticles_rand", catalogue_rand.ntotal);
+
+  auto tstart = std::chrono::steady_clock::now();
+
+  trvs::StageTimer timer_align("alignment");
+  trv::ParticleCatalogue::centre_in_box(
+    catalogue_data, catalogue_rand, params.boxsize
+  );
+  timer_align.stop();
+
+  trv::RadialLineOfSight los_data(catalogue_data.pos_observer);
+  trv::RadialLineOfSight los_rand(catalogue_rand.pos_observer);
+
+  trvs::StageTimer timer_norm("normalisation");
+  double alpha = catalogue_data.wtotal / catalogue_rand.wtotal;
+  double norm_factor = (params.npoint == "2pt")
+    ? trv::calc_powspec_normalisation_from_particles(catalogue_rand, alpha)
+    : trv::calc_bispec_normalisation_from_particles(catalogue_rand, alpha);
+  timer_norm.stop();
+
+  trvs::StageTimer timer_meas("measurement");
+  if (params.statistic_type == "powspec") {
+    trv::compute_powspec(
+      catalogue_data, catalogue_rand, los_data, los_rand,
+      params, binning, norm_factor
+    );
+  } else
+  if (params.statistic_type == "2pcf") {
+    trv::compute_corrfunc(
+      catalogue_data, catalogue_rand, los_data, los_rand,
+      params, binning, norm_factor
+    );
+  } else
+  if (params.statistic_type == "bispec") {
+    trv::compute_bispec(
+      catalogue_data, catalogue_rand, los_data, los_rand,
+      params, binning, norm_factor
+    );
+  } else
+  if (params.statistic_type == "3pcf") {
+    trv::compute_3pcf(
+      catalogue_data, catalogue_rand, los_data, los_rand,
+      params, binning, norm_factor
+    );
+  }
+  timer_meas.stop();
+
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - tstart
+  ).count();
+}
+
+
+/// **********************************************************************
+/// Report
+/// **********************************************************************
+
+/**
+ * @brief Record of a benchmark run.
+ *
+ */
+struct RunRecord {
+  std::string scaling;    ///< scaling sweep
+  std::string statistic;  ///< statistic type
+  int ngrid;              ///< grid number in each dimension
+  int nthreads;           ///< thread number
+  double wall_time;       ///< minimum wall time over repeats
+                          ///< (in seconds)
+};
+
+/**
+ * @brief Print scaling curves to the report.
+ *
+ * For each sweep, statistic and grid number, the wall times are
+ * referred to the run with the fewest threads: the strong-scaling
+ * efficiency is the speed-up per thread ratio, and the weak-scaling
+ * efficiency is the inverse wall-time ratio.
+ *
+ * @param fileptr Report file pointer.
+ * @param records Run records.
+ */
+void print_scaling_curves(
+  std::FILE* fileptr, const std::vector<RunRecord>& records
+) {
+  std::fprintf(fileptr, "  \"scaling\": [");
+
+  bool first = true;
+  for (std::size_t irec = 0; irec < records.size(); irec++) {
+    const RunRecord& ref = records[irec];
+
+    /// Start a curve at the first record of each sweep group.
+    bool is_new_group = true;
+    for (std::size_t jrec = 0; jrec < irec; jrec++) {
+      if (records[jrec].scaling == ref.scaling
+          && records[jrec].statistic == ref.statistic
+          && records[jrec].ngrid == ref.ngrid) {
+        is_new_group = false;
+        break;
+      }
+    }
+    if (!is_new_group) {continue;}
+
+    std::vector<const RunRecord*> curve;
+    for (const RunRecord& record : records) {
+      if (record.scaling == ref.scaling
+          && record.statistic == ref.statistic
+          && record.ngrid == ref.ngrid) {
+        curve.push_back(&record);
+      }
+    }
+
+    std::string nthreads_str, time_str, speedup_str, efficiency_str;
+    char buf[64];
+    for (std::size_t ipt = 0; ipt < curve.size(); ipt++) {
+      double ratio = curve[0]->wall_time / curve[ipt]->wall_time;
+      double efficiency = (ref.scaling == "strong")
+        ? ratio * curve[0]->nthreads / curve[ipt]->nthreads : ratio;
+      const char* sep = (ipt == 0) ? "" : ", ";
+
+      std::snprintf(buf, sizeof(buf), "%s%d", sep, curve[ipt]->nthreads);
+      nthreads_str += buf;
+      std::snprintf(buf, sizeof(buf), "%s%.6f", sep, curve[ipt]->wall_time);
+      time_str += buf;
+      std::snprintf(buf, sizeof(buf), "%s%.6f", sep, ratio);
+      speedup_str += buf;
+      std::snprintf(buf, sizeof(buf), "%s%.6f", sep, efficiency);
+      efficiency_str += buf;
+    }
+
+    std::fprintf(
+      fileptr,
+      "%s\n    {\"mode\": \"%s\", \"statistic\": \"%s\", \"ngrid\": %d, "
+      "\"nthreads\": [%s], \"wall_time\": [%s], \"speedup\": [%s], "
+      "\"efficiency\": [%s]}",
+      first ? "" : ",", ref.scaling.c_str(), ref.statistic.c_str(),
+      ref.ngrid, nthreads_str.c_str(), time_str.c_str(),
+      speedup_str.c_str(), efficiency_str.c_str()
+    );
+    first = false;
+  }
+
+  std::fprintf(fileptr, first ? "]\n" : "\n  ]\n");
+}
+
+
+/// **********************************************************************
+/// Driver
+/// **********************************************************************
+
+int main(int argc, char* argv[]) {
+  trvs::init_tasks(&argc, &argv);
+#ifdef TRV_USE_MPI
+  fftw_mpi_init();
+#endif  // TRV_USE_MPI
+
+  BenchOptions opts;
+  if (parse_options(argc, argv, opts)) {
+    trvs::finalise_tasks();
+    return 0;
+  }
+
+  trvs::logger.reset_level(opts.verbose);
+
+  std::FILE* fileptr = nullptr;
+  if (trvs::currTask == 0) {
+    fileptr = std::fopen(opts.output.c_str(), "w");
+    if (fileptr == nullptr) {
+      trvs::logger.error(
+        "Failed to open benchmark report file: %s.", opts.output.c_str()
+      );
+      throw trvs::IOError(
+        "Failed to open benchmark report file: %s.\n", opts.output.c_str()
+      );
+    }
+
+    std::fprintf(fileptr, "{\n");
+    std::fprintf(
+      fileptr, "  \"timestamp\": \"%s\",\n",
+      trvs::show_current_datetime().c_str()
+    );
+    std::fprintf(fileptr, "  \"tag\": \"%s\",\n", opts.tag.c_str());
+    std::fprintf(
+      fileptr,
+      "  \"config\": {\"catalogue\": \"%s\", \"geometry\": \"%s\", "
+      "\"boxsize\": %.6f, \"ndata\": %d, \"rand_ratio\": %.6f, "
+      "\"assignment\": \"%s\", \"interlace\": \"%s\", \"num_bins\": %d, "
+      "\"repeats\": %d, \"seed\": %u, \"num_tasks\": %d},\n",
+      opts.catalogue.c_str(), opts.geometry.c_str(), opts.boxsize,
+      opts.ndata, opts.rand_ratio, opts.assignment.c_str(),
+      opts.interlace.c_str(), opts.num_bins, opts.repeats, opts.seed,
+      trvs::numTasks
+    );
+    std::fprintf(fileptr, "  \"runs\": [");
+  }
+
+  std::vector<std::string> sweeps;
+  if (opts.scaling == "strong" || opts.scaling == "both") {
+    sweeps.push_back("strong");
+  }
+  if (opts.scaling == "weak" || opts.scaling == "both") {
+    sweeps.push_back("weak");
+  }
+
+  std::vector<RunRecord> records;
+  trv::ParticleCatalogue catalogue_data, catalogue_rand;
+  int ndata_curr = 0;
+  bool first_run = true;
+  for (const std::string& sweep : sweeps) {
+    for (int nthreads : opts.thread_nums) {
+      /// Weak scaling keeps the particle number per thread fixed.
+      int ndata = (sweep == "weak")
+        ? int(double(opts.ndata) * nthreads / opts.thread_nums.front())
+        : opts.ndata;
+      int nrand = int(opts.rand_ratio * ndata);
+
+      if (ndata != ndata_curr) {
+        if (trvs::currTask == 0) {
+          trvs::logger.stat(
+            "Generating synthetic catalogues: "
+            "%d data (%s) and %d random particles (%s geometry).",
+            ndata, opts.catalogue.c_str(), nrand, opts.geometry.c_str()
+          );
+        }
+        double nbar = ndata / calc_geometry_volume(opts);
+        generate_catalogue(
+          opts, opts.catalogue, ndata, nbar, opts.seed, catalogue_data
+        );
+        generate_catalogue(
+          opts, "uniform", nrand, nbar, opts.seed + 1, catalogue_rand
+        );
+        ndata_curr = ndata;
+      }
+
+#ifdef TRV_USE_OMP
+      omp_set_num_threads(nthreads);
+#endif  // TRV_USE_OMP
+
+      for (int ngrid : opts.ngrids) {
+        for (const std::string& statistic : opts.statistics) {
+          trv::ParameterSet params = set_params(opts, ngrid, statistic);
+
+          double wall_time_min = 0.;
+          for (int irep = 0; irep < opts.repeats; irep++) {
+            double wall_time = run_measurement(
+              params, catalogue_data, catalogue_rand
+            );
+            wall_time_min = (irep == 0)
+              ? wall_time : std::min(wall_time_min, wall_time);
+
+            if (trvs::currTask == 0) {
+              trvs::logger.stat(
+                "Benchmarked %s (%s scaling): ngrid = %d, nthreads = %d, "
+                "repeat %d, wall time %.3f s.",
+                statistic.c_str(), sweep.c_str(), ngrid, nthreads, irep,
+                wall_time
+              );
+
+              std::fprintf(
+                fileptr,
+                "%s\n    {\"scaling\": \"%s\", \"statistic\": \"%s\", "
+                "\"ngrid\": %d, \"nthreads\": %d, \"ndata\": %d, "
+                "\"nrand\": %d, \"repeat\": %d, \"wall_time\": %.6f, "
+                "\"peak_memory_gb\": %.6f,\n      \"profile\": ",
+                first_run ? "" : ",", sweep.c_str(), statistic.c_str(),
+                ngrid, nthreads, ndata, nrand, irep, wall_time,
+                trvs::gbytesMaxMem
+              );
+              trvs::print_profile(fileptr, 3);
+              std::fprintf(fileptr, "}");
+              std::fflush(fileptr);
+            }
+            first_run = false;
+          }
+
+          records.push_back(
+            RunRecord{sweep, statistic, ngrid, nthreads, wall_time_min}
+          );
+        }
+      }
+    }
+  }
+
+  if (trvs::currTask == 0) {
+    std::fprintf(fileptr, first_run ? "],\n" : "\n  ],\n");
+    print_scaling_curves(fileptr, records);
+    std::fprintf(fileptr, "}\n");
+    std::fclose(fileptr);
+
+    trvs::logger.stat("Benchmark report saved to %s.", opts.output.c_str());
+  }
+
+  catalogue_data.finalise_particles();
+  catalogue_rand.finalise_particles();
+
+#ifdef TRV_USE_MPI
+  fftw_mpi_cleanup();
+#endif  // TRV_USE_MPI
+  trvs::finalise_tasks();
+
+  return 0;
+}
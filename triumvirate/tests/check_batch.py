@@ -0,0 +1,219 @@
+"""Check batch-mode measurements against single-catalogue runs.
+
+Small synthetic survey-like data catalogues sharing one random
+catalogue are measured by the ``triumvirate`` program, once in batch
+mode with a glob pattern over the data catalogue files and once per
+data catalogue file.  The batch mode must write one output per
+realisation named by the file stem, equal to the single-catalogue
+measurement.
+
+Usage: ``python check_batch.py <program> [<statistics>]``, where
+``<statistics>`` is the comma-separated list of checked statistics.
+
+"""
+import glob
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+import numpy as np
+
+
+TEMPLATE_PARAMFILE = os.path.join(
+    os.path.dirname(os.path.abspath(__file__)),
+    "test_input", "params", "test_params.ini"
+)
+
+NDATA = 2000
+NRAND = 8000
+NREALISATIONS = 3
+
+STATISTIC_SETUPS = {
+    'powspec': ('pk0', 0.005, 0.105, {}),
+    '2pcf': ('xi0', 20., 320., {}),
+    'bispec': ('bk022_diag', 0.005, 0.105, {'ell2': 2, 'ELL': 2}),
+}
+
+
+def write_catalogues(catalogue_dir, seed=42):
+    """Write synthetic data catalogues and a shared random catalogue.
+
+    The data catalogues differ in extent, so that the measurement box
+    would be aligned differently for each if it were not for the shared
+    random catalogue.
+
+    Parameters
+    ----------
+    catalogue_dir : str
+        Catalogue directory.
+    seed : int, optional
+        Random seed (default is 42).
+
+    Returns
+    -------
+    list of str
+        Data catalogue file stems.
+
+    """
+    rng = np.random.default_rng(seed)
+
+    def write_catalogue(filename, nparticles, extent):
+        pos = rng.uniform(100., 100. + extent, size=(nparticles, 3))
+        nz = np.full(nparticles, nparticles / extent**3)
+        ws = np.ones(nparticles)
+        np.savetxt(
+            os.path.join(catalogue_dir, filename),
+            np.column_stack([pos, nz, ws]),
+            header="x y z nz ws"
+        )
+
+    write_catalogue("batch_rand.dat", NRAND, 600.)
+
+    stems = []
+    for ireal in range(NREALISATIONS):
+        stem = f"batch_data_{ireal}"
+        write_catalogue(f"{stem}.dat", NDATA, 600. - 50. * ireal)
+        stems.append(stem)
+
+    return stems
+
+
+def write_paramfile(filepath, **params):
+    """Write a parameter file from the test template.
+
+    Parameters
+    ----------
+    filepath : str
+        Parameter file path.
+    **params
+        Parameters substituted into the template.
+
+    """
+    with open(TEMPLATE_PARAMFILE) as template_file:
+        paramfile_content = template_file.read()
+
+    for name, value in params.items():
+        paramfile_content = re.sub(
+            rf"^{name} =.*$", f"{name} = {value}", paramfile_content,
+            flags=re.MULTILINE
+        )
+
+    with open(filepath, 'w') as paramfile:
+        paramfile.write(paramfile_content)
+
+
+def run_program(program, paramfile):
+    """Run the program on a parameter file.
+
+    Parameters
+    ----------
+    program : str
+        Program path.
+    paramfile : str
+        Parameter file path.
+
+    Returns
+    -------
+    bool
+        Whether the program has succeeded.
+
+    """
+    return subprocess.run(
+        [program, paramfile], stdout=subprocess.DEVNULL
+    ).returncode == 0
+
+
+def check_batch(program, statistics):
+    """Check batch-mode measurements.
+
+    Parameters
+    ----------
+    program : str
+        Program path.
+    statistics : list of str
+        Checked statistics.
+
+    Returns
+    -------
+    list of str
+        Failed checks.
+
+    """
+    failures = []
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        stems = write_catalogues(work_dir)
+
+        for statistic in statistics:
+            prefix, bin_min, bin_max, degrees = STATISTIC_SETUPS[statistic]
+
+            params = dict(
+                catalogue_dir=work_dir, measurement_dir=work_dir,
+                rand_catalogue_file="batch_rand.dat",
+                catalogue_columns="x,y,z,nz,ws",
+                catalogue_type="survey", statistic_type=statistic,
+                ngrid_x=32, ngrid_y=32, ngrid_z=32,
+                bin_min=bin_min, bin_max=bin_max, num_bins=5,
+                verbose=40, **degrees
+            )
+
+            paramfile = os.path.join(work_dir, f"batch_{statistic}.ini")
+            write_paramfile(
+                paramfile, data_catalogue_file="batch_data_*.dat",
+                output_tag="_batch", **params
+            )
+            if not run_program(program, paramfile):
+                failures.append(f"batch run has failed: {statistic}")
+                continue
+
+            outputs = glob.glob(os.path.join(work_dir, f"{prefix}_batch*"))
+            if len(outputs) != len(stems):
+                failures.append(
+                    f"unexpected number of batch outputs: {statistic} "
+                    f"({len(outputs)} for {len(stems)} catalogues)"
+                )
+
+            for stem in stems:
+                name = f"{statistic} ({stem})"
+
+                paramfile = os.path.join(work_dir, f"{stem}_{statistic}.ini")
+                write_paramfile(
+                    paramfile, data_catalogue_file=f"{stem}.dat",
+                    output_tag="_single", **params
+                )
+                if not run_program(program, paramfile):
+                    failures.append(f"single run has failed: {name}")
+                    continue
+
+                batch_output = os.path.join(
+                    work_dir, f"{prefix}_batch_{stem}"
+                )
+                single_output = os.path.join(work_dir, f"{prefix}_single")
+                if not os.path.isfile(batch_output):
+                    failures.append(f"batch output is missing: {name}")
+                    continue
+
+                meas_batch = np.loadtxt(batch_output)
+                meas_single = np.loadtxt(single_output)
+                if meas_batch.shape != meas_single.shape \
+                        or not np.allclose(
+                            meas_batch, meas_single, rtol=1.e-9, atol=0.
+                        ):
+                    failures.append(
+                        f"batch and single measurements differ: {name}"
+                    )
+
+    return failures
+
+
+if __name__ == '__main__':
+    statistics = sys.argv[2].split(',') if len(sys.argv) > 2 \
+        else list(STATISTIC_SETUPS)
+
+    failures = check_batch(sys.argv[1], statistics)
+    for failure in failures:
+        print(f"Batch-mode check failed: {failure}.", file=sys.stderr)
+
+    sys.exit(1 if failures else 0)
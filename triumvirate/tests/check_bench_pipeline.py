@@ -0,0 +1,131 @@
+"""Check an end-to-end benchmark report.
+
+The report written by ``bench_pipeline`` must be valid JSON with one
+profiled record per run, the requested synthetic catalogue sizes and
+a scaling curve per measured statistic and mesh grid number.
+
+Usage: ``python check_bench_pipeline.py <report> [<statistics>]``, where
+``<statistics>`` is the comma-separated list of benchmarked statistics.
+
+"""
+import json
+import sys
+
+
+STAGE_LABELS = {
+    'powspec': 'powspec',
+    '2pcf': 'corrfunc',
+    'bispec': 'bispec',
+    '3pcf': '3pcf',
+}
+
+
+def find_stage(stage, label):
+    """Find a stage by label in a profile stage tree.
+
+    Parameters
+    ----------
+    stage : dict
+        Profile stage.
+    label : str
+        Stage label.
+
+    Returns
+    -------
+    dict or None
+        Matching stage, or `None` if not found.
+
+    """
+    if stage['label'] == label:
+        return stage
+    for child in stage['children']:
+        found = find_stage(child, label)
+        if found is not None:
+            return found
+    return None
+
+
+def check_report(filepath, statistics):
+    """Check a benchmark report.
+
+    Parameters
+    ----------
+    filepath : str
+        Report file path.
+    statistics : list of str
+        Benchmarked statistics.
+
+    Returns
+    -------
+    list of str
+        Failed checks.
+
+    """
+    with open(filepath) as report_file:
+        report = json.load(report_file)
+
+    failures = []
+
+    config = report['config']
+    ndata = config['ndata']
+    nrand = int(config['rand_ratio'] * ndata)
+
+    runs = report['runs']
+    if not runs or len(runs) % (len(statistics) * config['repeats']):
+        failures.append(f"unexpected number of runs: {len(runs)}")
+
+    for run in runs:
+        name = "{statistic} (ngrid = {ngrid}, nthreads = {nthreads})" \
+            .format(**run)
+
+        if run['statistic'] not in statistics:
+            failures.append(f"unrequested statistic: {name}")
+            continue
+        if not run['wall_time'] > 0. or not run['peak_memory_gb'] > 0.:
+            failures.append(f"non-positive wall time or memory: {name}")
+
+        if run['scaling'] == 'strong' and (
+            run['ndata'] != ndata or run['nrand'] != nrand
+        ):
+            failures.append(f"catalogue sizes differ: {name}")
+
+        profile = run['profile']
+        quantities = profile['quantities']
+        if quantities.get('nparticles_data') != run['ndata'] \
+                or quantities.get('nparticles_rand') != run['nrand'] \
+                or quantities.get('nmesh') != run['ngrid'] ** 3:
+            failures.append(f"profile quantities differ: {name}")
+
+        measurement = find_stage(profile['stages'], 'measurement')
+        if measurement is None or measurement['calls'] != 1:
+            failures.append(f"measurement stage is missing: {name}")
+            continue
+        stage = find_stage(measurement, STAGE_LABELS[run['statistic']])
+        if stage is None or stage['calls'] != 1 \
+                or stage['total_time'] > measurement['total_time']:
+            failures.append(f"statistic stage is missing: {name}")
+
+    curves = report['scaling']
+    ngrids = {run['ngrid'] for run in runs}
+    scalings = {run['scaling'] for run in runs}
+    if len(curves) != len(statistics) * len(ngrids) * len(scalings):
+        failures.append(f"unexpected number of scaling curves: {len(curves)}")
+    for curve in curves:
+        if curve['speedup'][0] != 1. or curve['efficiency'][0] != 1.:
+            failures.append(
+                "scaling curve is not referred to its first run: "
+                "{statistic} (ngrid = {ngrid})".format(**curve)
+            )
+
+    return failures
+
+
+if __name__ == '__main__':
+    statistics = sys.argv[2].split(',') if len(sys.argv) > 2 \
+        else list(STAGE_LABELS)
+
+    failures = check_report(sys.argv[1], statistics)
+    for failure in failures:
+        print(f"Benchmark report check failed: {failure}.", file=sys.stderr)
+
+    sys.exit(1 if failures else 0)
@@ -96,3 +96,75 @@ def test_transforms(ell1, ell2, ELL, n_fftlog, n_extrap, extrap, case):
 
     assert np.allclose(bk_out, bk_in, rtol=0.005), \
         "Inverse Hankel transform does not recover input bispectrum!"
+
+
+@pytest.mark.parametrize(
+    "ell1,ell2,n_extrap,extrap",
+    [
+        (0, 0, None, None),
+        (1, 1, 16, 'lin'),
+        (2, 0, 16, 'loglin'),
+        (0, 2, 16, 'zero'),
+    ]
+)
+def test_native_transforms(ell1, ell2, n_extrap, extrap):
+
+    # Set up log-linearly spaced mock bispectrum samples.
+    k_in = np.logspace(-3., 0., num=64)
+    k1_mesh, k2_mesh = np.meshgrid(k_in, k_in, indexing='ij')
+    bk_in = 1.e4 / (k1_mesh * k2_mesh) ** 0.5 \
+        * np.exp(-(k1_mesh ** 2 + k2_mesh ** 2) / 0.1 ** 2)
+
+    r_out = np.logspace(0., 2., num=32)
+
+    # Perform native transformation and that with matching FFTLog
+    # samples, which need no interpolation.
+    n_fftlog = len(k_in) + 2 * (n_extrap or 0)
+
+    zeta_native = hankel.transform_bispec_to_3pcf(
+        ell1, ell2, k_in, bk_in, r_out,
+        n_extrap=n_extrap, extrap=extrap
+    )
+    zeta_fftlog = hankel.transform_bispec_to_3pcf(
+        ell1, ell2, k_in, bk_in, r_out, n_fftlog,
+        n_extrap=n_extrap, extrap=extrap
+    )
+
+    # Verify results.
+    assert zeta_native['n_fftlog'] == n_fftlog
+    assert np.allclose(zeta_native['r_fftlog'], zeta_fftlog['r_fftlog'])
+    assert np.allclose(
+        zeta_native['zeta_fftlog'], zeta_fftlog['zeta_fftlog'],
+        rtol=1.e-8, atol=1.e-8 * np.max(np.abs(zeta_fftlog['zeta_fftlog']))
+    ), "Native transform differs from the interpolated FFTLog transform!"
+
+    bk_native = hankel.transform_3pcf_to_bispec(
+        ell1, ell2, zeta_native['r_fftlog'], zeta_native['zeta_fftlog'],
+        k_in
+    )
+    bk_fftlog = hankel.transform_3pcf_to_bispec(
+        ell1, ell2, zeta_fftlog['r_fftlog'], zeta_fftlog['zeta_fftlog'],
+        k_in, n_fftlog
+    )
+
+    assert np.allclose(
+        bk_native['bk_fftlog'], bk_fftlog['bk_fftlog'],
+        rtol=1.e-8, atol=1.e-8 * np.max(np.abs(bk_fftlog['bk_fftlog']))
+    ), "Native transform differs from the interpolated FFTLog transform!"
+
+
+def test_native_transforms_unknown_extrap():
+
+    k_in = np.logspace(-3., 0., num=16)
+    bk_in = np.ones((len(k_in), len(k_in)))
+
+    with pytest.raises(ValueError):
+        hankel.transform_bispec_to_3pcf(
+            0, 0, k_in, bk_in, k_in, n_extrap=4, extrap='cubic'
+        )
+
+    # The backend rejects unknown schemes as well.
+    with pytest.raises(ValueError):
+        hankel._fftlog.trans_bispec_to_3pcf(
+            0, 0, k_in, bk_in, n_ext=4, extrap='cubic'
+        )
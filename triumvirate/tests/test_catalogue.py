@@ -0,0 +1,145 @@
+import tracemalloc
+
+import numpy as np
+import pytest
+import yaml
+
+try:
+    from triumvirate._particles import _ParticleCatalogue
+    from triumvirate._twopt import _compute_powspec_in_gpp_box
+    from triumvirate.catalogue import ParticleCatalogue
+    from triumvirate.dataobjs import Binning
+    from triumvirate.parameters import ParameterSet
+except (ImportError, ModuleNotFoundError):
+    import os, sys
+
+    # Add to Python search path.
+    sys.path.insert(0, os.path.join(
+        os.path.dirname(os.path.abspath(__file__)), ".."
+    ))
+    sys.path.insert(0, os.path.join(
+        os.path.dirname(os.path.abspath(__file__)), "../.."
+    ))
+
+    from triumvirate._particles import _ParticleCatalogue
+    from triumvirate._twopt import _compute_powspec_in_gpp_box
+    from triumvirate.catalogue import ParticleCatalogue
+    from triumvirate.dataobjs import Binning
+    from triumvirate.parameters import ParameterSet
+
+
+BOXSIZE = 500.
+NGRID = 32
+NPARTICLES = 4000
+
+
+@pytest.fixture(scope='module')
+def paramset():
+    with open("triumvirate/tests/test_input/params/test_params.yml") as f:
+        param_dict = yaml.load(f, Loader=yaml.Loader)
+    param_dict.update({
+        'boxsize': {'x': BOXSIZE, 'y': BOXSIZE, 'z': BOXSIZE},
+        'ngrid': {'x': NGRID, 'y': NGRID, 'z': NGRID},
+        'assignment': 'cic',
+        'catalogue_type': 'sim',
+        'statistic_type': 'powspec',
+        'degrees': {'ell1': 0, 'ell2': 0, 'ELL': 0},
+        'range': [0.02, 0.18],
+        'num_bins': 4,
+        'verbose': 60,
+    })
+    return ParameterSet(param_dict=param_dict)
+
+
+@pytest.fixture(scope='module')
+def columns():
+    rng = np.random.default_rng(42)
+    x, y, z = rng.uniform(0., BOXSIZE, size=(3, NPARTICLES))
+    ws = rng.uniform(0.5, 1.5, size=NPARTICLES)
+    nz = np.full(NPARTICLES, NPARTICLES / BOXSIZE**3)
+    wc = np.ones(NPARTICLES)
+    return x, y, z, nz, ws, wc
+
+
+def _measure(particles, paramset):
+    binning = Binning.from_parameter_set(paramset)
+    return _compute_powspec_in_gpp_box(particles, paramset, binning, 1.)
+
+
+def test_read_only_buffers(columns, paramset):
+
+    particles = _ParticleCatalogue(*columns)
+
+    # Read-only buffers (e.g. memory-mapped files) are accepted as is.
+    columns_ro = []
+    for col in columns:
+        col_ro = col.copy()
+        col_ro.flags.writeable = False
+        columns_ro.append(col_ro)
+
+    particles_ro = _ParticleCatalogue(*columns_ro)
+
+    results = _measure(particles, paramset)
+    results_ro = _measure(particles_ro, paramset)
+    for key in results:
+        assert np.array_equal(results_ro[key], results[key]), \
+            f"Measurement from read-only buffers differs in '{key}'!"
+
+
+def test_converted_columns(columns, paramset):
+
+    x, y, z, nz, ws, wc = columns
+
+    # Single-precision and strided columns are converted once.
+    x32, y32, z32 = (col.astype(np.float32) for col in (x, y, z))
+    ws_strided = np.repeat(ws, 2)[::2]
+    assert not ws_strided.flags.c_contiguous
+
+    catalogue = ParticleCatalogue(x32, y32, z32, nz=nz, ws=ws_strided)
+    particles = catalogue._convert_to_cpp_catalogue()
+
+    particles_ref = _ParticleCatalogue(
+        *(np.asarray(col, dtype=float) for col in (x32, y32, z32)),
+        nz, ws, wc
+    )
+
+    results = _measure(particles, paramset)
+    results_ref = _measure(particles_ref, paramset)
+    for key in results:
+        assert np.array_equal(results[key], results_ref[key]), \
+            f"Measurement from converted columns differs in '{key}'!"
+
+
+def test_column_conversion_memory():
+
+    # Converted columns are released one at a time, so that no more
+    # than one is held alongside the C++ particle data at once.
+    nparticles = 200000
+    rng = np.random.default_rng(42)
+    x, y, z, nz, ws = rng.uniform(
+        1., BOXSIZE, size=(5, nparticles)
+    ).astype(np.float32)
+    catalogue = ParticleCatalogue(x, y, z, nz=nz, ws=ws, wc=ws)
+
+    tracemalloc.start()
+    try:
+        particles = catalogue._convert_to_cpp_catalogue()
+        _, mem_peak = tracemalloc.get_traced_memory()
+    finally:
+        tracemalloc.stop()
+
+    assert mem_peak < 2 * nparticles * np.dtype(float).itemsize, \
+        "More than one converted column is held at once!"
+    assert particles is not None
+
+
+def test_inconsistent_buffers(columns):
+
+    x, y, z, nz, ws, wc = columns
+
+    with pytest.raises(ValueError):
+        _ParticleCatalogue(x[:-1], y, z, nz, ws, wc)
+    with pytest.raises(ValueError):
+        _ParticleCatalogue(*(col[:0] for col in columns))
+    with pytest.raises(ValueError):
+        _ParticleCatalogue(np.repeat(x, 2)[::2], y, z, nz, ws, wc)
@@ -1,4 +1,8 @@
+#include <cmath>
+#include <complex>
+#include <cstdio>
 #include <fstream>
+#include <vector>
 
 #include "fftlog.hpp"
 
@@ -44,5 +48,65 @@ int main() {
 
   std::fclose(test_file_out);
 
+  /// Check the transformer (with batching) against the one-off
+  /// Hankel transform.
+  const double mu = ell + 1./2;
+  const int nbatch = 3;
+  const double tol = 1.e-10;
+
+  std::vector< std::complex<double> > a(Nk), b_ref(Nk);
+  std::vector<double> r_ref(Nk);
+  for (int j = 0; j < Nk; j++) {
+    a[j] = std::pow(k[j], m - 1./2) * pk[j];
+  }
+
+  trv::maths::hankel_transform(
+    mu, 0., 1., Nk, true, k, a.data(), r_ref.data(), b_ref.data(), nullptr
+  );
+
+  trv::maths::HankelTransformer transformer(mu, 0., 1., Nk, true, k);
+
+  std::vector< std::complex<double> > a_batch(nbatch * Nk), b(nbatch * Nk);
+  for (int ibatch = 0; ibatch < nbatch; ibatch++) {
+    for (int j = 0; j < Nk; j++) {
+      a_batch[ibatch * Nk + j] = double(ibatch + 1) * a[j];
+    }
+  }
+  transformer.transform(nbatch, a_batch.data(), b.data());
+
+  double b_max = 0.;
+  for (int j = 0; j < Nk; j++) {b_max = std::max(b_max, std::abs(b_ref[j]));}
+
+  int nfailed = 0;
+  for (int j = 0; j < Nk; j++) {
+    if (std::fabs(transformer.k[j] - r_ref[j]) > tol * r_ref[j]) {nfailed++;}
+    for (int ibatch = 0; ibatch < nbatch; ibatch++) {
+      std::complex<double> diff =
+        b[ibatch * Nk + j] - double(ibatch + 1) * b_ref[j];
+      if (std::abs(diff) > tol * (ibatch + 1) * b_max) {nfailed++;}
+    }
+  }
+
+  /// Check repeated (cached) transforms reproduce the transformer.
+  double r_cached[Nk], xi_cached[Nk], xi_transformer[Nk];
+
+  trv::maths::sj_transform(ell, m, Nk, k, pk, r_cached, xi_cached);
+  transformer.sj_transform(m, 1, pk, xi_transformer);
+
+  for (int j = 0; j < Nk; j++) {
+    if (r_cached[j] != r[j] || xi_cached[j] != xi[j]) {nfailed++;}
+    if (std::fabs(xi_transformer[j] - xi[j]) > tol * std::fabs(xi[j])) {
+      nfailed++;
+    }
+  }
+
+  if (nfailed > 0) {
+    std::fprintf(
+      stderr, "Hankel transformer differs from the Hankel transform "
+      "at %d sample point(s)!\n", nfailed
+    );
+    return 1;
+  }
+
   return 0;
 }
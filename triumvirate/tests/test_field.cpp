@@ -0,0 +1,792 @@
+// Copyright (C) [GPLv3 Licence]
+//
+// This file is part of the Triumvirate program. See the COPYRIGHT
+// and LICENCE files at the top-level directory of this distribution
+// for details of copyright and licensing.
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file test_field.cpp
+ * @brief Tests of mesh field computations.
+ *
+ * Mesh fields of synthetic catalogues computed by optimised code paths
+ * are compared against direct reference computations.  The program
+ * returns a non-zero exit status if any check fails.
+ *
+ */
+
+#include <fftw3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "monitor.hpp"
+#include "maths.hpp"
+#include "parameters.hpp"
+#include "particles.hpp"
+#include "dataobjs.hpp"
+#include "field.hpp"
+
+namespace trvs = trv::sys;
+namespace trvm = trv::maths;
+
+const int NDATA = 2000;        ///< data particle number
+const int NRAND = 5000;        ///< random particle number
+const double BOXSIZE = 1000.;  ///< box size
+const int NGRID = 16;          ///< grid number
+const double TOL = 1.e-10;     ///< relative tolerance
+
+/**
+ * @brief Load a synthetic survey-like catalogue.
+ *
+ * Particles are placed uniformly in a cube away from the observer at
+ * the origin, with random systematic weights.
+ *
+ * @param catalogue Particle catalogue.
+ * @param npart Particle number.
+ * @param seed Random seed.
+ */
+void load_test_catalogue(
+  trv::ParticleCatalogue& catalogue, int npart, unsigned seed
+) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> uniform_pos(100., 900.);
+  std::uniform_real_distribution<double> uniform_wgt(0.5, 1.5);
+
+  std::vector<double> x(npart), y(npart), z(npart);
+  std::vector<double> nz(npart, npart / std::pow(800., 3));
+  std::vector<double> ws(npart), wc(npart, 1.);
+  for (int pid = 0; pid < npart; pid++) {
+    x[pid] = uniform_pos(gen);
+    y[pid] = uniform_pos(gen);
+    z[pid] = uniform_pos(gen);
+    ws[pid] = uniform_wgt(gen);
+  }
+
+  catalogue.load_particle_data(x, y, z, nz, ws, wc);
+}
+
+/**
+ * @brief Set up mesh parameters.
+ *
+ * @param assignment Mesh assignment scheme.
+ * @param interlace Interlacing switch.
+ * @returns Parameter set.
+ */
+trv::ParameterSet set_params(
+  const std::string& assignment, const std::string& interlace
+) {
+  trv::ParameterSet params;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    params.boxsize[iaxis] = BOXSIZE;
+    params.ngrid[iaxis] = NGRID;
+  }
+  params.volume = BOXSIZE * BOXSIZE * BOXSIZE;
+  params.nmesh = NGRID * NGRID * NGRID;
+  params.alignment = "centre";
+  params.assignment = assignment;
+  params.interlace = interlace;
+  params.catalogue_type = "survey";
+  params.statistic_type = "powspec";
+  params.norm_convention = "particle";
+  params.binning = "lin";
+  params.form = "diag";
+  params.ell1 = 0; params.ell2 = 0; params.ELL = 0;
+  params.i_wa = 0; params.j_wa = 0;
+  params.num_bins = 5;
+  params.idx_bin = 0;
+  params.bin_min = 2. * M_PI / BOXSIZE;
+  params.bin_max = M_PI * NGRID / BOXSIZE / 2.;
+  params.verbose = trvs::LogLevel::WARN;
+
+  params.validate();
+
+  return params;
+}
+
+/**
+ * @brief Count grid cells where two mesh fields differ.
+ *
+ * @param field Mesh field.
+ * @param field_ref Reference mesh field values.
+ * @param name Quantity name (for reporting).
+ * @returns Number of mismatches.
+ */
+int count_mismatches(
+  trv::MeshField& field,
+  const std::vector< std::complex<double> >& field_ref,
+  const std::string& name
+) {
+  double scale = 0.;
+  for (const auto& value : field_ref) {
+    scale = std::max(scale, std::abs(value));
+  }
+
+  int nmismatch = 0;
+  for (std::size_t gid = 0; gid < field_ref.size(); gid++) {
+    std::complex<double> value(field[gid][0], field[gid][1]);
+    if (std::abs(value - field_ref[gid]) > TOL * scale) {
+      nmismatch++;
+    }
+  }
+  if (nmismatch > 0) {
+    std::fprintf(
+      stderr, "Mismatched '%s' in %d grid cell(s).\n", name.c_str(), nmismatch
+    );
+  }
+
+  return nmismatch;
+}
+
+/**
+ * @brief Compute the reference weighted field of a catalogue pair
+ *        from separately assigned per-particle weight arrays.
+ *
+ * @param params Parameter set.
+ * @param particles_data Data-source particle catalogue.
+ * @param particles_rand Random-source particle catalogue.
+ * @param alpha Alpha contrast.
+ * @param ell Degree of the spherical harmonic.
+ * @param m Order of the spherical harmonic.
+ * @param quad Whether to compute the quadratic weighted field.
+ * @returns Fourier-space field values.
+ */
+std::vector< std::complex<double> > calc_ref_ylm_wgtd_field(
+  trv::ParameterSet& params,
+  trv::ParticleCatalogue& particles_data,
+  trv::ParticleCatalogue& particles_rand,
+  double alpha, int ell, int m, bool quad
+) {
+  trv::ParticleCatalogue* catalogues[2] = {&particles_data, &particles_rand};
+  const double signs[2] = {1., quad ? alpha * alpha : - alpha};
+
+  std::vector< std::complex<double> > field_ref(params.nmesh, 0.);
+  for (int icat = 0; icat < 2; icat++) {
+    trv::ParticleCatalogue& particles = *catalogues[icat];
+
+    fftw_complex* weights = fftw_alloc_complex(particles.ntotal);
+    for (int pid = 0; pid < particles.ntotal; pid++) {
+      double los[3];
+      for (int iaxis = 0; iaxis < 3; iaxis++) {
+        los[iaxis] = particles[pid].pos[iaxis] - particles.pos_observer[iaxis];
+      }
+
+      std::complex<double> ylm = trvm::SphericalHarmonicCalculator::
+        calc_reduced_spherical_harmonic(ell, m, los);
+      std::complex<double> weight = quad
+        ? std::conj(ylm) * std::pow(particles[pid].w, 2)
+        : ylm * particles[pid].w;
+
+      weights[pid][0] = weight.real();
+      weights[pid][1] = weight.imag();
+    }
+
+    trv::MeshField field(params);
+    field.assign_weighted_field_to_mesh(particles, weights);
+    field.fourier_transform();
+
+    for (long long gid = 0; gid < params.nmesh; gid++) {
+      field_ref[gid] += signs[icat]
+        * std::complex<double>(field[gid][0], field[gid][1]);
+    }
+
+    fftw_free(weights);
+  }
+
+  return field_ref;
+}
+
+/**
+ * @brief Check that data and random-source particles assigned into
+ *        one mesh with signed weights reproduce the difference of
+ *        separately assigned fields.
+ *
+ * @returns Number of failed checks.
+ */
+int test_signed_weight_assignment() {
+  const char* schemes[] = {"ngp", "cic", "tsc", "pcs"};
+  const int degrees[][2] = {{0, 0}, {2, 1}};  // (ell, m)
+
+  int nfailed = 0;
+  for (const char* scheme : schemes) {
+    for (const char* interlace : {"false", "true"}) {
+      trv::ParameterSet params = set_params(scheme, interlace);
+
+      trv::ParticleCatalogue catalogue_data, catalogue_rand;
+      load_test_catalogue(catalogue_data, NDATA, 42);
+      load_test_catalogue(catalogue_rand, NRAND, 43);
+
+      trv::ParticleCatalogue::centre_in_box(
+        catalogue_data, catalogue_rand, params.boxsize
+      );
+
+      trv::RadialLineOfSight los_data(catalogue_data.pos_observer);
+      trv::RadialLineOfSight los_rand(catalogue_rand.pos_observer);
+
+      double alpha = catalogue_data.wtotal / catalogue_rand.wtotal;
+
+      for (const auto& degree : degrees) {
+        const int ell = degree[0], m = degree[1];
+        const std::string name = std::string(scheme)
+          + (std::string(interlace) == "true" ? "+interlacing" : "")
+          + ", ell=" + std::to_string(ell) + ", m=" + std::to_string(m);
+
+        trv::MeshField dn(params);
+        dn.compute_ylm_wgtd_field(
+          catalogue_data, catalogue_rand, los_data, los_rand,
+          alpha, ell, m
+        );
+        dn.fourier_transform();
+
+        nfailed += count_mismatches(
+          dn,
+          calc_ref_ylm_wgtd_field(
+            params, catalogue_data, catalogue_rand, alpha, ell, m, false
+          ),
+          "dn: " + name
+        );
+
+        trv::MeshField N(params);
+        N.compute_ylm_wgtd_quad_field(
+          catalogue_data, catalogue_rand, los_data, los_rand,
+          alpha, ell, m
+        );
+        N.fourier_transform();
+
+        nfailed += count_mismatches(
+          N,
+          calc_ref_ylm_wgtd_field(
+            params, catalogue_data, catalogue_rand, alpha, ell, m, true
+          ),
+          "N: " + name
+        );
+      }
+    }
+  }
+
+  return nfailed;
+}
+
+/**
+ * @brief Check that batched transforms of mesh fields reproduce
+ *        individual transforms.
+ *
+ * @returns Number of failed checks.
+ */
+int test_batched_transforms() {
+  const int degrees[][2] = {{0, 0}, {2, 0}, {2, 1}};  // (ell, m)
+  const int nfields = 3;
+
+  int nfailed = 0;
+  for (const char* interlace : {"false", "true"}) {
+    trv::ParameterSet params = set_params("tsc", interlace);
+
+    trv::ParticleCatalogue catalogue_data, catalogue_rand;
+    load_test_catalogue(catalogue_data, NDATA, 42);
+    load_test_catalogue(catalogue_rand, NRAND, 43);
+
+    trv::ParticleCatalogue::centre_in_box(
+      catalogue_data, catalogue_rand, params.boxsize
+    );
+
+    trv::RadialLineOfSight los_data(catalogue_data.pos_observer);
+    trv::RadialLineOfSight los_rand(catalogue_rand.pos_observer);
+
+    double alpha = catalogue_data.wtotal / catalogue_rand.wtotal;
+
+    std::vector< std::vector< std::complex<double> > > field_refs_inv;
+
+    trv::MeshFieldBatch batch(params, nfields);
+    for (int ifield = 0; ifield < nfields; ifield++) {
+      batch[ifield].compute_ylm_wgtd_field(
+        catalogue_data, catalogue_rand, los_data, los_rand,
+        alpha, degrees[ifield][0], degrees[ifield][1]
+      );
+    }
+    batch.fourier_transform();
+
+    for (int ifield = 0; ifield < nfields; ifield++) {
+      const std::string name = std::string("batch[")
+        + std::to_string(ifield) + "]"
+        + (std::string(interlace) == "true" ? " with interlacing" : "");
+
+      trv::MeshField dn(params);
+      dn.compute_ylm_wgtd_field(
+        catalogue_data, catalogue_rand, los_data, los_rand,
+        alpha, degrees[ifield][0], degrees[ifield][1]
+      );
+      dn.fourier_transform();
+
+      std::vector< std::complex<double> > field_ref(params.nmesh);
+      for (long long gid = 0; gid < params.nmesh; gid++) {
+        field_ref[gid] = std::complex<double>(dn[gid][0], dn[gid][1]);
+      }
+      nfailed += count_mismatches(
+        batch[ifield], field_ref, "forward " + name
+      );
+
+      dn.inv_fourier_transform();
+      for (long long gid = 0; gid < params.nmesh; gid++) {
+        field_ref[gid] = std::complex<double>(dn[gid][0], dn[gid][1]);
+      }
+      field_refs_inv.push_back(field_ref);
+    }
+
+    batch.inv_fourier_transform();
+    for (int ifield = 0; ifield < nfields; ifield++) {
+      nfailed += count_mismatches(
+        batch[ifield], field_refs_inv[ifield],
+        "inverse batch[" + std::to_string(ifield) + "]"
+      );
+    }
+  }
+
+  return nfailed;
+}
+
+/**
+ * @brief Compute the reference inverse Fourier transform of a field
+ *        by a full-mesh FFT.
+ *
+ * @param field_fourier Fourier-space field values.
+ * @returns Configuration-space field values.
+ */
+std::vector< std::complex<double> > calc_ref_inv_fourier_transform(
+  const std::vector< std::complex<double> >& field_fourier
+) {
+  fftw_complex* buff = fftw_alloc_complex(field_fourier.size());
+  for (std::size_t gid = 0; gid < field_fourier.size(); gid++) {
+    buff[gid][0] = field_fourier[gid].real();
+    buff[gid][1] = field_fourier[gid].imag();
+  }
+
+  fftw_plan plan = fftw_plan_dft_3d(
+    NGRID, NGRID, NGRID, buff, buff, FFTW_BACKWARD, FFTW_ESTIMATE
+  );
+  fftw_execute(plan);
+  fftw_destroy_plan(plan);
+
+  std::vector< std::complex<double> > field_config(field_fourier.size());
+  for (std::size_t gid = 0; gid < field_fourier.size(); gid++) {
+    field_config[gid] = std::complex<double>(buff[gid][0], buff[gid][1]);
+  }
+
+  fftw_free(buff);
+
+  return field_config;
+}
+
+/**
+ * @brief Check that band-limited shell fields, which are indexed over
+ *        Hermitian half-space modes and inverse transformed with
+ *        pruning, reproduce full-mesh shell filtering and transforms.
+ *
+ * @returns Number of failed checks.
+ */
+int test_band_limited_transforms() {
+  trv::ParameterSet params = set_params("tsc", "true");
+
+  trv::ParticleCatalogue catalogue_data, catalogue_rand;
+  load_test_catalogue(catalogue_data, NDATA, 42);
+  load_test_catalogue(catalogue_rand, NRAND, 43);
+
+  trv::ParticleCatalogue::centre_in_box(
+    catalogue_data, catalogue_rand, params.boxsize
+  );
+
+  trv::RadialLineOfSight los_data(catalogue_data.pos_observer);
+  trv::RadialLineOfSight los_rand(catalogue_rand.pos_observer);
+
+  double alpha = catalogue_data.wtotal / catalogue_rand.wtotal;
+
+  trv::MeshField dn(params);
+  dn.compute_ylm_wgtd_field(
+    catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
+  );
+  dn.fourier_transform();
+
+  trv::MeshField dn_comp(params);
+  dn_comp.compute_ylm_wgtd_field(
+    catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
+  );
+  dn_comp.fourier_transform();
+  dn_comp.apply_assignment_compensation();
+
+  std::vector< std::complex<double> > ylm(params.nmesh);
+  trvm::SphericalHarmonicCalculator::
+    store_reduced_spherical_harmonic_in_fourier_space(
+      2, 1, params.boxsize, params.ngrid, ylm
+    );
+
+  /// Band edges avoid exact mode magnitudes; the last band includes
+  /// Nyquist planes.
+  const double dk = 2. * M_PI / BOXSIZE;
+  const double bands[][2] = {{0.5, 2.5}, {2.5, 4.5}, {6.2, 8.5}};
+
+  int nfailed = 0;
+  for (const auto& band : bands) {
+    const double k_lower = band[0] * dk, k_upper = band[1] * dk;
+    char name[64];
+    std::snprintf(name, sizeof(name), "band (%g, %g] dk", band[0], band[1]);
+
+    /// Filter the shell over the full mesh.
+    std::vector< std::complex<double> > shell_ylm(params.nmesh, 0.);
+    std::vector< std::complex<double> > shell_unit(params.nmesh, 0.);
+    double k_eff_ref = 0.;
+    int nmodes_ref = 0;
+    for (int i = 0; i < NGRID; i++) {
+      for (int j = 0; j < NGRID; j++) {
+        for (int k = 0; k < NGRID; k++) {
+          const int n[3] = {
+            (i < NGRID/2) ? i : i - NGRID,
+            (j < NGRID/2) ? j : j - NGRID,
+            (k < NGRID/2) ? k : k - NGRID
+          };
+          double k_ = dk * std::sqrt(double(
+            n[0] * n[0] + n[1] * n[1] + n[2] * n[2]
+          ));
+          if (k_ <= k_lower || k_ > k_upper) {continue;}
+
+          long long gid = (i * NGRID + j) * NGRID + k;
+          shell_ylm[gid] = ylm[gid]
+            * std::complex<double>(dn_comp[gid][0], dn_comp[gid][1]);
+          shell_unit[gid] = 1.;
+          k_eff_ref += k_;
+          nmodes_ref++;
+        }
+      }
+    }
+    k_eff_ref /= double(nmodes_ref);
+
+    std::vector< std::complex<double> > field_ylm_ref =
+      calc_ref_inv_fourier_transform(shell_ylm);
+    std::vector< std::complex<double> > field_unit_ref =
+      calc_ref_inv_fourier_transform(shell_unit);
+    for (long long gid = 0; gid < params.nmesh; gid++) {
+      field_ylm_ref[gid] /= double(nmodes_ref);
+      field_unit_ref[gid] /= double(nmodes_ref);
+    }
+
+    /// Compute the band-limited fields.
+    double k_eff;
+    int nmodes;
+
+    trv::MeshField F(params);
+    F.inv_fourier_transform_ylm_wgtd_field_band_limited(
+      dn, ylm, k_lower, k_upper, k_eff, nmodes
+    );
+    if (nmodes != nmodes_ref || std::fabs(k_eff - k_eff_ref) > TOL * k_eff) {
+      std::fprintf(stderr, "Mismatched modes in %s.\n", name);
+      nfailed++;
+    }
+    nfailed += count_mismatches(
+      F, field_ylm_ref, std::string("F_LM: ") + name
+    );
+
+    trv::MeshField F_unit(params);
+    F_unit.inv_fourier_transform_unit_field_band_limited(
+      k_lower, k_upper, k_eff, nmodes
+    );
+    if (nmodes != nmodes_ref || std::fabs(k_eff - k_eff_ref) > TOL * k_eff) {
+      std::fprintf(stderr, "Mismatched unit modes in %s.\n", name);
+      nfailed++;
+    }
+    nfailed += count_mismatches(
+      F_unit, field_unit_ref, std::string("F_unit: ") + name
+    );
+  }
+
+  return nfailed;
+}
+
+/**
+ * @brief Count bins where two sets of binned statistics differ.
+ *
+ * @param values Values.
+ * @param values_ref Reference values.
+ * @param name Quantity name (for reporting).
+ * @param scale Scale of the values, relative to which the tolerance
+ *              is set (default: largest reference magnitude), e.g.
+ *              the shot-noise amplitude for shot-noise multipoles,
+ *              which may vanish.
+ * @returns Number of mismatches.
+ */
+template <typename T>
+int count_stats_mismatches(
+  const std::vector<T>& values, const std::vector<T>& values_ref,
+  const std::string& name, double scale = 0.
+) {
+  if (scale == 0.) {
+    for (const auto& value : values_ref) {
+      scale = std::max(scale, double(std::abs(value)));
+    }
+  }
+
+  int nmismatch = (values.size() == values_ref.size()) ? 0 : 1;
+  for (std::size_t ibin = 0; ibin < values.size() && nmismatch == 0; ibin++) {
+    if (std::abs(values[ibin] - values_ref[ibin]) > TOL * scale) {
+      nmismatch++;
+    }
+  }
+  if (nmismatch > 0) {
+    std::fprintf(stderr, "Mismatched '%s'.\n", name.c_str());
+  }
+
+  return nmismatch;
+}
+
+/**
+ * @brief Check that Fourier-space loops over the Hermitian half space
+ *        for real-valued fields reproduce full-space loops.
+ *
+ * The reference field holds the same values but is assigned with
+ * explicit (complex) weights, so that it is not taken to be real.
+ *
+ * @returns Number of failed checks.
+ */
+int test_hermitian_half_space() {
+  int nfailed = 0;
+  for (const char* interlace : {"false", "true"}) {
+    const std::string suffix =
+      (std::string(interlace) == "true") ? " with interlacing" : "";
+
+    trv::ParameterSet params = set_params("tsc", interlace);
+
+    trv::ParameterSet params_config = params;
+    params_config.statistic_type = "2pcf";
+    params_config.bin_min = 2. * BOXSIZE / NGRID;
+    params_config.bin_max = BOXSIZE / 4.;
+    params_config.validate();
+
+    trv::Binning kbinning(params);
+    kbinning.set_bins();
+    trv::Binning rbinning(params_config);
+    rbinning.set_bins();
+
+    trv::ParticleCatalogue catalogue_data, catalogue_rand;
+    load_test_catalogue(catalogue_data, NDATA, 42);
+    load_test_catalogue(catalogue_rand, NRAND, 43);
+
+    trv::ParticleCatalogue::centre_in_box(
+      catalogue_data, catalogue_rand, params.boxsize
+    );
+
+    trv::RadialLineOfSight los_data(catalogue_data.pos_observer);
+    trv::RadialLineOfSight los_rand(catalogue_rand.pos_observer);
+
+    double alpha = catalogue_data.wtotal / catalogue_rand.wtotal;
+
+    /// Real-valued field.
+    trv::MeshField dn(params);
+    dn.compute_ylm_wgtd_field(
+      catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
+    );
+    dn.fourier_transform();
+
+    /// Same field, not taken to be real.
+    trv::MeshField dn_c(params);
+    dn_c.initialise_density_field();
+    trv::ParticleCatalogue* catalogues[2] = {&catalogue_data, &catalogue_rand};
+    const double signs[2] = {1., - alpha};
+    for (int icat = 0; icat < 2; icat++) {
+      trv::ParticleCatalogue& particles = *catalogues[icat];
+
+      fftw_complex* weights = fftw_alloc_complex(particles.ntotal);
+      for (int pid = 0; pid < particles.ntotal; pid++) {
+        weights[pid][0] = signs[icat] * particles[pid].w;
+        weights[pid][1] = 0.;
+      }
+      dn_c.add_weighted_field_to_mesh(particles, weights);
+
+      fftw_free(weights);
+    }
+    dn_c.fourier_transform();
+
+    const std::complex<double> shotnoise_amp = double(NDATA);
+
+    /// Two-point statistics in Fourier space.
+    trv::FieldStats stats_k(params), stats_k_ref(params);
+    stats_k.compute_ylm_wgtd_2pt_stats_in_fourier(
+      dn, dn, shotnoise_amp, 2, 0, kbinning
+    );
+    stats_k_ref.compute_ylm_wgtd_2pt_stats_in_fourier(
+      dn_c, dn_c, shotnoise_amp, 2, 0, kbinning
+    );
+
+    nfailed += count_stats_mismatches(
+      stats_k.nmodes, stats_k_ref.nmodes, "nmodes" + suffix
+    );
+    nfailed += count_stats_mismatches(stats_k.k, stats_k_ref.k, "k" + suffix);
+    nfailed += count_stats_mismatches(
+      stats_k.pk, stats_k_ref.pk, "pk" + suffix
+    );
+    nfailed += count_stats_mismatches(
+      stats_k.sn, stats_k_ref.sn, "sn" + suffix, std::abs(shotnoise_amp)
+    );
+
+    /// Two-point statistics in configuration space.
+    trv::FieldStats stats_r(params_config), stats_r_ref(params_config);
+    stats_r.compute_ylm_wgtd_2pt_stats_in_config(
+      dn, dn, shotnoise_amp, 2, 0, rbinning
+    );
+    stats_r_ref.compute_ylm_wgtd_2pt_stats_in_config(
+      dn_c, dn_c, shotnoise_amp, 2, 0, rbinning
+    );
+
+    nfailed += count_stats_mismatches(
+      stats_r.npairs, stats_r_ref.npairs, "npairs" + suffix
+    );
+    nfailed += count_stats_mismatches(
+      stats_r.xi, stats_r_ref.xi, "xi" + suffix
+    );
+
+    /// Three-point shot noise in configuration space.
+    std::vector< std::complex<double> > ylm_a(params.nmesh);
+    std::vector< std::complex<double> > ylm_b(params.nmesh);
+    trvm::SphericalHarmonicCalculator::
+      store_reduced_spherical_harmonic_in_config_space(
+        1, 0, params.boxsize, params.ngrid, ylm_a
+      );
+    trvm::SphericalHarmonicCalculator::
+      store_reduced_spherical_harmonic_in_config_space(
+        1, 1, params.boxsize, params.ngrid, ylm_b
+      );
+
+    trv::FieldStats stats_sn(params_config), stats_sn_ref(params_config);
+    stats_sn.compute_uncoupled_shotnoise_for_3pcf(
+      dn, dn, ylm_a, ylm_b, shotnoise_amp, rbinning
+    );
+    stats_sn_ref.compute_uncoupled_shotnoise_for_3pcf(
+      dn_c, dn_c, ylm_a, ylm_b, shotnoise_amp, rbinning
+    );
+
+    nfailed += count_stats_mismatches(
+      stats_sn.xi, stats_sn_ref.xi, "3pcf shot noise" + suffix
+    );
+  }
+
+  return nfailed;
+}
+
+/**
+ * @brief Check that reduced spherical harmonics and spherical Bessel
+ *        interpolators shared between holders reproduce freshly
+ *        computed ones, and are released with their last holder.
+ *
+ * @returns Number of failed checks.
+ */
+int test_shared_mesh_tables() {
+  trv::ParameterSet params = set_params("tsc", "false");
+
+  int nfailed = 0;
+
+  const double gbytes_mem = trvs::gbytesMem;
+  {
+    auto ylm_k = trvm::SphericalHarmonicCalculator::
+      get_reduced_spherical_harmonic_in_fourier_space(
+        2, 1, params.boxsize, params.ngrid
+      );
+    auto ylm_k_shared = trvm::SphericalHarmonicCalculator::
+      get_reduced_spherical_harmonic_in_fourier_space(
+        2, 1, params.boxsize, params.ngrid
+      );
+    auto ylm_r = trvm::SphericalHarmonicCalculator::
+      get_reduced_spherical_harmonic_in_config_space(
+        2, 1, params.boxsize, params.ngrid
+      );
+
+    if (ylm_k != ylm_k_shared || ylm_k == ylm_r) {
+      std::fprintf(
+        stderr, "Spherical harmonic tables are not shared by key.\n"
+      );
+      nfailed++;
+    }
+
+    std::vector< std::complex<double> > ylm_k_ref(params.nmesh);
+    std::vector< std::complex<double> > ylm_r_ref(params.nmesh);
+    trvm::SphericalHarmonicCalculator::
+      store_reduced_spherical_harmonic_in_fourier_space(
+        2, 1, params.boxsize, params.ngrid, ylm_k_ref
+      );
+    trvm::SphericalHarmonicCalculator::
+      store_reduced_spherical_harmonic_in_config_space(
+        2, 1, params.boxsize, params.ngrid, ylm_r_ref
+      );
+    if (*ylm_k != ylm_k_ref || *ylm_r != ylm_r_ref) {
+      std::fprintf(
+        stderr, "Shared spherical harmonic tables differ from stored.\n"
+      );
+      nfailed++;
+    }
+  }
+  if (trvs::gbytesMem != gbytes_mem) {
+    std::fprintf(
+      stderr, "Shared spherical harmonic tables are not released.\n"
+    );
+    nfailed++;
+  }
+
+  const double x[] = {0.5, 12.3, 456.7};
+  std::vector<double> sj_vals;
+  {
+    trvm::SphericalBesselCalculator sj(2);
+    trvm::SphericalBesselCalculator sj_shared(2);
+    for (double x_ : x) {
+      sj_vals.push_back(sj.eval(x_));
+      if (sj_shared.eval(x_) != sj_vals.back()) {
+        std::fprintf(
+          stderr, "Shared spherical Bessel interpolators differ.\n"
+        );
+        nfailed++;
+      }
+    }
+  }
+  {
+    trvm::SphericalBesselCalculator sj(2);  // rebuilt once released
+    for (std::size_t ix = 0; ix < sj_vals.size(); ix++) {
+      if (sj.eval(x[ix]) != sj_vals[ix]) {
+        std::fprintf(
+          stderr, "Rebuilt spherical Bessel interpolator differs.\n"
+        );
+        nfailed++;
+      }
+    }
+  }
+
+  return nfailed;
+}
+
+int main() {
+  trvs::logger.reset_level(trvs::LogLevel::WARN);
+
+  int nfailed = 0;
+  nfailed += test_signed_weight_assignment();
+  nfailed += test_batched_transforms();
+  nfailed += test_band_limited_transforms();
+  nfailed += test_hermitian_half_space();
+  nfailed += test_shared_mesh_tables();
+
+  if (nfailed > 0) {
+    std::fprintf(stderr, "Mesh field tests failed: %d.\n", nfailed);
+    return 1;
+  }
+
+  return 0;
+}
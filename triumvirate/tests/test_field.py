@@ -0,0 +1,147 @@
+import numpy as np
+import pytest
+import yaml
+
+try:
+    from triumvirate._threept import _compute_bispec_in_gpp_box
+    from triumvirate._twopt import _compute_powspec_in_gpp_box
+    from triumvirate.catalogue import ParticleCatalogue
+    from triumvirate.dataobjs import Binning
+    from triumvirate.field import FieldStats, MeshField
+    from triumvirate.parameters import ParameterSet
+except (ImportError, ModuleNotFoundError):
+    import os, sys
+
+    # Add to Python search path.
+    sys.path.insert(0, os.path.join(
+        os.path.dirname(os.path.abspath(__file__)), ".."
+    ))
+    sys.path.insert(0, os.path.join(
+        os.path.dirname(os.path.abspath(__file__)), "../.."
+    ))
+
+    from triumvirate._threept import _compute_bispec_in_gpp_box
+    from triumvirate._twopt import _compute_powspec_in_gpp_box
+    from triumvirate.catalogue import ParticleCatalogue
+    from triumvirate.dataobjs import Binning
+    from triumvirate.field import FieldStats, MeshField
+    from triumvirate.parameters import ParameterSet
+
+
+BOXSIZE = 500.
+NGRID = 32
+NPARTICLES = 4000
+
+
+def _make_paramset(statistic_type):
+    with open("triumvirate/tests/test_input/params/test_params.yml") as f:
+        param_dict = yaml.load(f, Loader=yaml.Loader)
+    param_dict.update({
+        'boxsize': {'x': BOXSIZE, 'y': BOXSIZE, 'z': BOXSIZE},
+        'ngrid': {'x': NGRID, 'y': NGRID, 'z': NGRID},
+        'assignment': 'cic',
+        'catalogue_type': 'sim',
+        'statistic_type': statistic_type,
+        'degrees': {'ell1': 0, 'ell2': 0, 'ELL': 0},
+        'range': [0.02, 0.18],
+        'num_bins': 4,
+        'verbose': 60,
+    })
+    return ParameterSet(param_dict=param_dict)
+
+
+@pytest.fixture(scope='module')
+def particles():
+    rng = np.random.default_rng(42)
+    x, y, z = rng.uniform(0., BOXSIZE, size=(3, NPARTICLES))
+
+    catalogue = ParticleCatalogue(x, y, z, nz=NPARTICLES/BOXSIZE**3)
+    catalogue.periodise([BOXSIZE,] * 3)
+
+    return catalogue._convert_to_cpp_catalogue()
+
+
+def test_field_view_is_read_only(particles):
+
+    paramset = _make_paramset('powspec')
+
+    dn = MeshField(paramset)
+    dn.compute_unweighted_field(particles)
+
+    field = dn.field
+    assert field.shape == (NGRID, NGRID, NGRID)
+    assert not field.flags.writeable
+    with pytest.raises(ValueError):
+        field[0, 0, 0] = 1.
+
+    # The view reflects in-place transforms of the mesh field.
+    assert np.isclose(field.real.sum() * dn.vol_cell, NPARTICLES)
+    dn.fourier_transform()
+    assert np.iscomplexobj(field) and not np.allclose(field.imag, 0.)
+
+
+def test_powspec_from_fields(particles):
+
+    paramset = _make_paramset('powspec')
+    binning = Binning.from_parameter_set(paramset)
+    norm_factor = BOXSIZE**3 / NPARTICLES**2
+
+    results = _compute_powspec_in_gpp_box(
+        particles, paramset, binning, norm_factor
+    )
+
+    dn = MeshField(paramset)
+    dn.compute_unweighted_field_fluctuations_insitu(particles)
+    dn.fourier_transform()
+
+    stats = FieldStats(paramset).compute_ylm_wgtd_2pt_stats_in_fourier(
+        dn, dn, NPARTICLES, 0, 0, binning
+    )
+
+    assert np.array_equal(stats['nmodes'], results['nmodes'])
+    assert np.allclose(stats['k'], results['keff'])
+    assert np.allclose(norm_factor * stats['pk'], results['pk_raw']), \
+        "Power spectrum from mesh fields differs from the full measurement!"
+    assert np.allclose(norm_factor * stats['sn'], results['pk_shot'])
+
+
+def test_bispec_from_band_limited_fields(particles):
+
+    paramset = _make_paramset('bispec')
+    binning = Binning.from_parameter_set(paramset)
+    norm_factor = BOXSIZE**6 / NPARTICLES**3
+
+    results = _compute_bispec_in_gpp_box(
+        particles, paramset, binning, norm_factor
+    )
+
+    dn = MeshField(paramset)
+    dn.compute_unweighted_field_fluctuations_insitu(particles)
+    dn.fourier_transform()
+
+    G = MeshField(paramset)
+    G.compute_unweighted_field_fluctuations_insitu(particles)
+    G.fourier_transform()
+    G.apply_assignment_compensation()
+    G.inv_fourier_transform()
+
+    F = MeshField(paramset)
+    bk_raw, keff, nmodes = [], [], []
+    for k_lower, k_upper in zip(binning.bin_edges[:-1], binning.bin_edges[1:]):
+        k_eff, nmodes_ = F.inv_fourier_transform_ylm_wgtd_field_band_limited(
+            dn, 0, 0, k_lower, k_upper
+        )
+        bk_raw.append(F.vol_cell * np.sum(F.field**2 * G.field))
+        keff.append(k_eff)
+        nmodes.append(nmodes_)
+
+    assert np.array_equal(nmodes, results['nmodes'])
+    assert np.allclose(keff, results['k1eff'])
+    assert np.allclose(norm_factor * np.array(bk_raw), results['bk_raw']), \
+        "Bispectrum from band-limited fields differs from the full measurement!"
+
+    # The unit band-limited field counts the same modes.
+    k_eff, nmodes_ = F.inv_fourier_transform_unit_field_band_limited(
+        binning.bin_edges[-2], binning.bin_edges[-1]
+    )
+    assert nmodes_ == nmodes[-1] and np.isclose(k_eff, keff[-1])
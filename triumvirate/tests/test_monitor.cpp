@@ -0,0 +1,550 @@
+// Copyright (C) [GPLv3 Licence]
+//
+// This file is part of the Triumvirate program. See the COPYRIGHT
+// and LICENCE files at the top-level directory of this distribution
+// for details of copyright and licensing.
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file test_monitor.cpp
+ * @brief Tests of program profiling and memory tracking.
+ *
+ * Stage profiles of timed stages and measurements are written to the
+ * test output directory and checked for their recorded contents, and
+ * tracked memory usage is checked to be balanced.  The program returns
+ * a non-zero exit status if any check fails.
+ *
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "monitor.hpp"
+#include "parameters.hpp"
+#include "particles.hpp"
+#include "dataobjs.hpp"
+#include "twopt.hpp"
+
+namespace trvs = trv::sys;
+
+const char test_profile_file[] =
+  "triumvirate/tests/test_output/test_profile.json";
+
+const int NDATA = 2000;        ///< data particle number
+const int NRAND = 5000;        ///< random particle number
+const double BOXSIZE = 1000.;  ///< box size
+const int NGRID = 16;          ///< grid number
+
+/**
+ * @brief Load a synthetic simulation-box catalogue.
+ *
+ * Particles are placed uniformly in the box.
+ *
+ * @param catalogue Particle catalogue.
+ * @param npart Particle number.
+ * @param seed Random seed.
+ */
+void load_box_catalogue(
+  trv::ParticleCatalogue& catalogue, int npart, unsigned seed
+) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> uniform_pos(0., BOXSIZE);
+
+  std::vector<double> x(npart), y(npart), z(npart);
+  std::vector<double> nz(npart, npart / std::pow(BOXSIZE, 3));
+  std::vector<double> ws(npart, 1.), wc(npart, 1.);
+  for (int pid = 0; pid < npart; pid++) {
+    x[pid] = uniform_pos(gen);
+    y[pid] = uniform_pos(gen);
+    z[pid] = uniform_pos(gen);
+  }
+
+  catalogue.load_particle_data(x, y, z, nz, ws, wc);
+}
+
+/**
+ * @brief Load a synthetic survey-like catalogue.
+ *
+ * Particles are placed uniformly in a cube away from the observer at
+ * the origin, with random systematic weights.
+ *
+ * @param catalogue Particle catalogue.
+ * @param npart Particle number.
+ * @param seed Random seed.
+ */
+void load_test_catalogue(
+  trv::ParticleCatalogue& catalogue, int npart, unsigned seed
+) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> uniform_pos(100., 900.);
+  std::uniform_real_distribution<double> uniform_wgt(0.5, 1.5);
+
+  std::vector<double> x(npart), y(npart), z(npart);
+  std::vector<double> nz(npart, npart / std::pow(800., 3));
+  std::vector<double> ws(npart), wc(npart, 1.);
+  for (int pid = 0; pid < npart; pid++) {
+    x[pid] = uniform_pos(gen);
+    y[pid] = uniform_pos(gen);
+    z[pid] = uniform_pos(gen);
+    ws[pid] = uniform_wgt(gen);
+  }
+
+  catalogue.load_particle_data(x, y, z, nz, ws, wc);
+}
+
+/**
+ * @brief Measure the power spectrum monopole of a box catalogue.
+ */
+void measure_box_powspec() {
+  trv::ParameterSet params;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    params.boxsize[iaxis] = BOXSIZE;
+    params.ngrid[iaxis] = NGRID;
+  }
+  params.volume = BOXSIZE * BOXSIZE * BOXSIZE;
+  params.nmesh = NGRID * NGRID * NGRID;
+  params.alignment = "centre";
+  params.assignment = "cic";
+  params.interlace = "false";
+  params.catalogue_type = "sim";
+  params.statistic_type = "powspec";
+  params.norm_convention = "particle";
+  params.binning = "lin";
+  params.form = "diag";
+  params.ell1 = 0; params.ell2 = 0; params.ELL = 0;
+  params.i_wa = 0; params.j_wa = 0;
+  params.num_bins = 5;
+  params.idx_bin = 0;
+  params.bin_min = 2. * M_PI / BOXSIZE;
+  params.bin_max = M_PI * NGRID / BOXSIZE / 2.;
+  params.verbose = trvs::LogLevel::WARN;
+
+  params.validate();
+
+  trv::Binning binning(params);
+  binning.set_bins();
+
+  trv::ParticleCatalogue catalogue;
+  load_box_catalogue(catalogue, NDATA, 42);
+
+  trv::compute_powspec_in_gpp_box(
+    catalogue, params, binning, params.volume / std::pow(double(NDATA), 2)
+  );
+}
+
+/**
+ * @brief Measure the two-point correlation function quadrupole of
+ *        survey-like catalogues.
+ */
+void measure_survey_corrfunc() {
+  trv::ParameterSet params;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    params.boxsize[iaxis] = BOXSIZE;
+    params.ngrid[iaxis] = NGRID;
+  }
+  params.volume = BOXSIZE * BOXSIZE * BOXSIZE;
+  params.nmesh = NGRID * NGRID * NGRID;
+  params.alignment = "centre";
+  params.assignment = "tsc";
+  params.interlace = "true";
+  params.catalogue_type = "survey";
+  params.statistic_type = "2pcf";
+  params.norm_convention = "particle";
+  params.binning = "lin";
+  params.form = "diag";
+  params.ell1 = 0; params.ell2 = 0; params.ELL = 2;
+  params.i_wa = 0; params.j_wa = 0;
+  params.num_bins = 5;
+  params.idx_bin = 0;
+  params.bin_min = 2. * BOXSIZE / NGRID;
+  params.bin_max = BOXSIZE / 4.;
+  params.verbose = trvs::LogLevel::WARN;
+
+  params.validate();
+
+  trv::Binning binning(params);
+  binning.set_bins();
+
+  trv::ParticleCatalogue catalogue_data, catalogue_rand;
+  load_test_catalogue(catalogue_data, NDATA, 42);
+  load_test_catalogue(catalogue_rand, NRAND, 43);
+
+  trv::ParticleCatalogue::centre_in_box(
+    catalogue_data, catalogue_rand, params.boxsize
+  );
+
+  trv::RadialLineOfSight los_data(catalogue_data.pos_observer);
+  trv::RadialLineOfSight los_rand(catalogue_rand.pos_observer);
+
+  double alpha = catalogue_data.wtotal / catalogue_rand.wtotal;
+  double norm_factor =
+    trv::calc_powspec_normalisation_from_particles(catalogue_rand, alpha);
+
+  trv::compute_corrfunc(
+    catalogue_data, catalogue_rand, los_data, los_rand,
+    params, binning, norm_factor
+  );
+}
+
+/**
+ * @brief Read a file into a string.
+ *
+ * @param filepath File path.
+ * @returns File contents.
+ */
+std::string read_file(const std::string& filepath) {
+  std::ifstream fin(filepath.c_str(), std::ios::in);
+  std::stringstream sbuff;
+  sbuff << fin.rdbuf();
+  return sbuff.str();
+}
+
+/**
+ * @brief Count the occurrences of a substring.
+ *
+ * @param str String.
+ * @param substr Substring.
+ * @returns Number of (non-overlapping) occurrences.
+ */
+int count_occurrences(const std::string& str, const std::string& substr) {
+  int count = 0;
+  for (std::size_t pos = str.find(substr); pos != std::string::npos;
+       pos = str.find(substr, pos + substr.size())) {
+    count++;
+  }
+  return count;
+}
+
+/**
+ * @brief Check that stage timers are profiled with their nesting, call
+ *        counts and timings, and that recorded quantities and
+ *        instrumented measurement stages appear in the profile.
+ *
+ * @returns Number of failed checks.
+ */
+int test_stage_profile() {
+  int nfailed = 0;
+
+  /// Timers are no-ops and no profile is written while profiling is off.
+  {
+    trvs::StageTimer timer("unprofiled");
+  }
+  if (trvs::write_profile_to_file(test_profile_file) == 0) {
+    std::fprintf(stderr, "Profile is written with profiling off.\n");
+    nfailed++;
+  }
+
+  trvs::enable_profiling();
+
+  const double tsleep = 0.01;  // in seconds
+  {
+    trvs::StageTimer timer_outer("outer");
+    for (int icall = 0; icall < 2; icall++) {
+      trvs::StageTimer timer_inner("inner");
+      std::this_thread::sleep_for(std::chrono::duration<double>(tsleep));
+    }
+
+    /// Timers on other threads are ignored.
+    std::thread thread_other([]() {
+      trvs::StageTimer timer_other("other_thread");
+    });
+    thread_other.join();
+
+    measure_box_powspec();
+  }
+
+  trvs::record_profile_quantity("ngrid", 8.);
+  trvs::record_profile_quantity("ngrid", NGRID);  // overwritten
+  trvs::record_profile_quantity("ntotal", NDATA);
+
+  if (trvs::write_profile_to_file(test_profile_file) != 0) {
+    std::fprintf(stderr, "Profile is not written with profiling on.\n");
+    return ++nfailed;
+  }
+
+  std::string profile = read_file(test_profile_file);
+  std::remove(test_profile_file);
+
+  /// Check the profile structure.
+  if (count_occurrences(profile, "{") != count_occurrences(profile, "}")
+      || count_occurrences(profile, "[") != count_occurrences(profile, "]")) {
+    std::fprintf(stderr, "Profile brackets are unbalanced.\n");
+    nfailed++;
+  }
+  for (const char* key : {
+    "\"num_threads\"", "\"wall_time\"", "\"peak_memory_gb\"",
+    "\"peak_rss_gb\"", "\"peak_memory_gb_by_category\"", "\"stages\""
+  }) {
+    if (profile.find(key) == std::string::npos) {
+      std::fprintf(stderr, "Profile is missing key %s.\n", key);
+      nfailed++;
+    }
+  }
+
+  /// Check the stages and their call counts.
+  struct StageCheck {
+    const char* label;
+    int ncalls;
+  };
+  for (const StageCheck& stage : {
+    StageCheck{"program", 1}, StageCheck{"outer", 1},
+    StageCheck{"inner", 2}, StageCheck{"powspec", 1}
+  }) {
+    char entry[64];
+    std::snprintf(
+      entry, sizeof(entry), "\"label\": \"%s\", \"calls\": %d,",
+      stage.label, stage.ncalls
+    );
+    if (count_occurrences(profile, entry) != 1) {
+      std::fprintf(stderr, "Profile stage differs: %s\n", entry);
+      nfailed++;
+    }
+  }
+  for (const char* label : {"unprofiled", "other_thread"}) {
+    if (profile.find(label) != std::string::npos) {
+      std::fprintf(stderr, "Profile includes ignored stage '%s'.\n", label);
+      nfailed++;
+    }
+  }
+
+  /// Nested stages are printed after their parent stage in the order
+  /// in which they are first timed.
+  std::size_t pos_outer = profile.find("\"label\": \"outer\"");
+  std::size_t pos_inner = profile.find("\"label\": \"inner\"");
+  std::size_t pos_powspec = profile.find("\"label\": \"powspec\"");
+  if (!(pos_outer < pos_inner && pos_inner < pos_powspec
+        && pos_powspec != std::string::npos)) {
+    std::fprintf(stderr, "Profile stages are misnested.\n");
+    nfailed++;
+  }
+
+  /// Check the timings, where self time excludes nested stages.
+  int nnodes = 0;
+  for (std::size_t pos = profile.find("\"total_time\"");
+       pos != std::string::npos;
+       pos = profile.find("\"total_time\"", pos + 1)) {
+    double time_total, time_self;
+    if (std::sscanf(
+      profile.c_str() + pos, "\"total_time\": %lf, \"self_time\": %lf",
+      &time_total, &time_self
+    ) != 2) {
+      std::fprintf(stderr, "Profile stage timings are unreadable.\n");
+      nfailed++;
+      break;
+    }
+    if (time_self < -1.e-6 || time_self > time_total + 1.e-6) {
+      std::fprintf(
+        stderr, "Profile self time (%g s) exceeds total time (%g s).\n",
+        time_self, time_total
+      );
+      nfailed++;
+    }
+    if (pos > pos_inner && pos < pos_powspec
+        && time_total < 2. * tsleep) {
+      std::fprintf(stderr, "Profile 'inner' stage time is too short.\n");
+      nfailed++;
+    }
+    nnodes++;
+  }
+  if (nnodes < 4) {
+    std::fprintf(stderr, "Profile has too few stages.\n");
+    nfailed++;
+  }
+
+  /// Check the recorded quantities.
+  char quantity[64];
+  std::snprintf(quantity, sizeof(quantity), "\"ngrid\": %d", NGRID);
+  if (count_occurrences(profile, quantity) != 1
+      || count_occurrences(profile, "\"ngrid\"") != 1) {
+    std::fprintf(stderr, "Profile quantity 'ngrid' differs.\n");
+    nfailed++;
+  }
+  std::snprintf(quantity, sizeof(quantity), "\"ntotal\": %d", NDATA);
+  if (count_occurrences(profile, quantity) != 1) {
+    std::fprintf(stderr, "Profile quantity 'ntotal' differs.\n");
+    nfailed++;
+  }
+
+  trvs::profileOn = false;
+
+  return nfailed;
+}
+
+/**
+ * @brief Check that tracked memory usage is attributed to categories,
+ *        balanced after measurements and consistent under concurrent
+ *        updates.
+ *
+ * @returns Number of failed checks.
+ */
+int test_memory_tracking() {
+  const double gbytes_tol = 1.e-12;
+
+  auto sum_categories = []() {
+    double gbytes = 0.;
+    for (int icat = 0; icat < trvs::NUM_MEM_CATEGORIES; icat++) {
+      gbytes += trvs::gbytesMemCat[icat];
+    }
+    return gbytes;
+  };
+
+  int nfailed = 0;
+
+  trvs::enable_profiling();
+
+  double gbytes_cat_init[trvs::NUM_MEM_CATEGORIES];
+  for (int icat = 0; icat < trvs::NUM_MEM_CATEGORIES; icat++) {
+    gbytes_cat_init[icat] = trvs::gbytesMemCat[icat];
+  }
+  const double gbytes_init = trvs::gbytesMem;
+
+  /// Tracking allocators count into their category only.
+  {
+    const int nelem = 1 << 16;
+    std::vector<double, trvs::TrackingAllocator<double, trvs::MEM_STATS>>
+      buffer(nelem);
+
+    double gbytes_expected = trvs::size_in_gb<double>(buffer.capacity());
+    if (std::fabs(
+      trvs::gbytesMemCat[trvs::MEM_STATS] - gbytes_cat_init[trvs::MEM_STATS]
+      - gbytes_expected
+    ) > gbytes_tol
+        || std::fabs(trvs::gbytesMem - gbytes_init - gbytes_expected)
+        > gbytes_tol) {
+      std::fprintf(stderr, "Tracked allocation is miscounted.\n");
+      nfailed++;
+    }
+    if (trvs::gbytesMemCat[trvs::MEM_MESH]
+        != gbytes_cat_init[trvs::MEM_MESH]) {
+      std::fprintf(stderr, "Tracked allocation is misattributed.\n");
+      nfailed++;
+    }
+  }
+
+  /// Concurrent updates (of exactly representable sizes) are not lost.
+  {
+    const int nthreads = 4;
+    const int nupdates = 10000;
+    const double gbytes = 1. / 1024.;
+
+    std::vector<std::thread> threads;
+    for (int ithread = 0; ithread < nthreads; ithread++) {
+      threads.emplace_back([nupdates, gbytes]() {
+        for (int iupdate = 0; iupdate < nupdates; iupdate++) {
+          trvs::count_alloc(gbytes, trvs::MEM_OTHER);
+        }
+      });
+    }
+    for (auto& thread : threads) {thread.join();}
+
+    if (trvs::gbytesMemCat[trvs::MEM_OTHER] - gbytes_cat_init[trvs::MEM_OTHER]
+        != nthreads * nupdates * gbytes) {
+      std::fprintf(stderr, "Concurrent allocations are lost.\n");
+      nfailed++;
+    }
+
+#ifdef TRV_USE_OMP
+#pragma omp parallel for num_threads(nthreads)
+#endif  // TRV_USE_OMP
+    for (int iupdate = 0; iupdate < nthreads * nupdates; iupdate++) {
+      trvs::count_dealloc(gbytes, trvs::MEM_OTHER);
+    }
+  }
+
+  /// Measurements release all tracked memory and record stage peaks.
+  measure_box_powspec();
+  measure_survey_corrfunc();
+
+  for (int icat = 0; icat < trvs::NUM_MEM_CATEGORIES; icat++) {
+    if (std::fabs(trvs::gbytesMemCat[icat] - gbytes_cat_init[icat])
+        > gbytes_tol) {
+      std::fprintf(
+        stderr, "Tracked memory usage is unbalanced for category '%s': "
+        "%.6e GiB.\n", trvs::memCategoryNames[icat],
+        trvs::gbytesMemCat[icat] - gbytes_cat_init[icat]
+      );
+      nfailed++;
+    }
+  }
+  if (std::fabs(trvs::gbytesMem - gbytes_init) > gbytes_tol
+      || std::fabs(trvs::gbytesMem - sum_categories()) > gbytes_tol) {
+    std::fprintf(stderr, "Tracked memory usage is unbalanced in total.\n");
+    nfailed++;
+  }
+
+  /// Peaks cover at least one complex mesh field and the particle data.
+  const double gbytes_mesh =
+    trvs::size_in_gb<double>(2LL * NGRID * NGRID * NGRID);
+  if (trvs::gbytesMaxMemCat[trvs::MEM_MESH]
+      < gbytes_cat_init[trvs::MEM_MESH] + gbytes_mesh
+      || trvs::gbytesMaxMemCat[trvs::MEM_PARTICLES]
+      <= gbytes_cat_init[trvs::MEM_PARTICLES]
+      || trvs::gbytesMaxMem < gbytes_init + gbytes_mesh) {
+    std::fprintf(stderr, "Peak memory usage is underestimated.\n");
+    nfailed++;
+  }
+
+  if (trvs::write_profile_to_file(test_profile_file) != 0) {
+    std::fprintf(stderr, "Profile is not written with profiling on.\n");
+    return ++nfailed;
+  }
+
+  std::string profile = read_file(test_profile_file);
+  std::remove(test_profile_file);
+
+  for (const char* label : {"powspec", "corrfunc"}) {
+    std::string entry = std::string("\"label\": \"") + label + "\"";
+    std::size_t pos = profile.find(entry);
+    double gbytes_peak = 0.;
+    if (pos == std::string::npos
+        || std::sscanf(
+          profile.c_str() + profile.find("\"peak_memory_gb\"", pos),
+          "\"peak_memory_gb\": %lf", &gbytes_peak
+        ) != 1
+        || gbytes_peak < gbytes_init + gbytes_mesh) {
+      std::fprintf(
+        stderr, "Profile stage '%s' peak memory usage is missing or "
+        "underestimated.\n", label
+      );
+      nfailed++;
+    }
+  }
+
+  trvs::profileOn = false;
+
+  return nfailed;
+}
+
+int main() {
+  trvs::logger.reset_level(trvs::LogLevel::WARN);
+
+  int nfailed = 0;
+  nfailed += test_stage_profile();
+  nfailed += test_memory_tracking();
+
+  if (nfailed > 0) {
+    std::fprintf(stderr, "Program monitoring tests failed: %d.\n", nfailed);
+    return 1;
+  }
+
+  return 0;
+}
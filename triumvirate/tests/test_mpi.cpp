@@ -0,0 +1,315 @@
+// Copyright (C) [GPLv3 Licence]
+//
+// This file is part of the Triumvirate program. See the COPYRIGHT
+// and LICENCE files at the top-level directory of this distribution
+// for details of copyright and licensing.
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file test_mpi.cpp
+ * @brief Tests of slab-decomposed measurements across MPI tasks.
+ *
+ * Two-point measurements of synthetic catalogues must not depend on
+ * the number of tasks.  Run on a single task, the program saves
+ * reference measurements to the test output directory; run on
+ * several tasks, it compares its measurements against the saved
+ * reference.  The program returns a non-zero exit status if any
+ * check fails.
+ *
+ */
+
+#ifdef TRV_USE_MPI
+#include <fftw3-mpi.h>
+#endif  // TRV_USE_MPI
+
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "monitor.hpp"
+#include "parameters.hpp"
+#include "particles.hpp"
+#include "dataobjs.hpp"
+#include "twopt.hpp"
+
+namespace trvs = trv::sys;
+
+const char test_ref_file[] =
+  "triumvirate/tests/test_output/test_mpi_ref.dat";
+
+const int NDATA = 2000;        ///< data particle number
+const int NRAND = 5000;        ///< random particle number
+const double BOXSIZE = 1000.;  ///< box size
+const int NGRID = 16;          ///< grid number
+const double TOL = 1.e-8;      ///< relative tolerance
+
+/**
+ * @brief Load a synthetic survey-like catalogue.
+ *
+ * Particles are placed uniformly in a cube away from the observer at
+ * the origin, with random systematic weights.  Every task loads the
+ * same replicated catalogue.
+ *
+ * @param catalogue Particle catalogue.
+ * @param npart Particle number.
+ * @param seed Random seed.
+ */
+void load_test_catalogue(
+  trv::ParticleCatalogue& catalogue, int npart, unsigned seed
+) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> uniform_pos(100., 900.);
+  std::uniform_real_distribution<double> uniform_wgt(0.5, 1.5);
+
+  std::vector<double> x(npart), y(npart), z(npart);
+  std::vector<double> nz(npart, npart / std::pow(800., 3));
+  std::vector<double> ws(npart), wc(npart, 1.);
+  for (int pid = 0; pid < npart; pid++) {
+    x[pid] = uniform_pos(gen);
+    y[pid] = uniform_pos(gen);
+    z[pid] = uniform_pos(gen);
+    ws[pid] = uniform_wgt(gen);
+  }
+
+  catalogue.load_particle_data(x, y, z, nz, ws, wc);
+}
+
+/**
+ * @brief Set up measurement parameters.
+ *
+ * @param statistic Statistic type.
+ * @param assignment Mesh assignment scheme.
+ * @param ELL Multipole degree.
+ * @returns Parameter set.
+ */
+trv::ParameterSet set_params(
+  const std::string& statistic, const std::string& assignment, int ELL
+) {
+  trv::ParameterSet params;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    params.boxsize[iaxis] = BOXSIZE;
+    params.ngrid[iaxis] = NGRID;
+  }
+  params.volume = BOXSIZE * BOXSIZE * BOXSIZE;
+  params.nmesh = NGRID * NGRID * NGRID;
+  params.alignment = "centre";
+  params.assignment = assignment;
+  params.interlace = "true";
+  params.catalogue_type = "survey";
+  params.statistic_type = statistic;
+  params.norm_convention = "particle";
+  params.binning = "lin";
+  params.form = "diag";
+  params.ell1 = 0; params.ell2 = 0; params.ELL = ELL;
+  params.i_wa = 0; params.j_wa = 0;
+  params.num_bins = 5;
+  params.idx_bin = 0;
+  params.verbose = trvs::LogLevel::WARN;
+
+  if (statistic == "powspec") {
+    params.bin_min = 2. * M_PI / BOXSIZE;
+    params.bin_max = M_PI * NGRID / BOXSIZE / 2.;
+  } else {
+    params.bin_min = 2. * BOXSIZE / NGRID;
+    params.bin_max = BOXSIZE / 4.;
+  }
+
+  params.validate();
+
+  return params;
+}
+
+/**
+ * @brief Measure two-point statistics for a set of test cases.
+ *
+ * Mode and pair counts are included as real values.
+ *
+ * @returns Measured values, flattened.
+ */
+std::vector<double> measure_test_cases() {
+  struct TestCase {
+    const char* statistic;
+    const char* assignment;
+    int ELL;
+  };
+  const TestCase cases[] = {
+    {"powspec", "ngp", 0}, {"powspec", "tsc", 2}, {"powspec", "pcs", 2},
+    {"2pcf", "cic", 0}, {"2pcf", "pcs", 2}
+  };  // higher-order schemes spill over more ghost planes
+
+  std::vector<double> values;
+  for (const auto& meas_case : cases) {
+    trv::ParameterSet params = set_params(
+      meas_case.statistic, meas_case.assignment, meas_case.ELL
+    );
+
+    trv::Binning binning(params);
+    binning.set_bins();
+
+    trv::ParticleCatalogue catalogue_data, catalogue_rand;
+    load_test_catalogue(catalogue_data, NDATA, 42);
+    load_test_catalogue(catalogue_rand, NRAND, 43);
+
+    trv::ParticleCatalogue::centre_in_box(
+      catalogue_data, catalogue_rand, params.boxsize
+    );
+
+    trv::RadialLineOfSight los_data(catalogue_data.pos_observer);
+    trv::RadialLineOfSight los_rand(catalogue_rand.pos_observer);
+
+    double alpha = catalogue_data.wtotal / catalogue_rand.wtotal;
+    double norm_factor =
+      trv::calc_powspec_normalisation_from_particles(catalogue_rand, alpha);
+
+    if (std::string(meas_case.statistic) == "powspec") {
+      trv::PowspecMeasurements meas = trv::compute_powspec(
+        catalogue_data, catalogue_rand, los_data, los_rand,
+        params, binning, norm_factor
+      );
+      for (int ibin = 0; ibin < params.num_bins; ibin++) {
+        values.push_back(meas.nmodes[ibin]);
+        values.push_back(meas.keff[ibin]);
+        values.push_back(meas.pk_raw[ibin].real());
+        values.push_back(meas.pk_raw[ibin].imag());
+        values.push_back(meas.pk_shot[ibin].real());
+        values.push_back(meas.pk_shot[ibin].imag());
+      }
+    } else {
+      trv::TwoPCFMeasurements meas = trv::compute_corrfunc(
+        catalogue_data, catalogue_rand, los_data, los_rand,
+        params, binning, norm_factor
+      );
+      for (int ibin = 0; ibin < params.num_bins; ibin++) {
+        values.push_back(meas.npairs[ibin]);
+        values.push_back(meas.reff[ibin]);
+        values.push_back(meas.xi[ibin].real());
+        values.push_back(meas.xi[ibin].imag());
+      }
+    }
+  }
+
+  return values;
+}
+
+/**
+ * @brief Save reference values.
+ *
+ * @param values Values.
+ */
+void save_reference(const std::vector<double>& values) {
+  std::FILE* fileptr = std::fopen(test_ref_file, "w");
+  if (fileptr == nullptr) {
+    throw trvs::IOError(
+      "Cannot open test reference file: %s.\n", test_ref_file
+    );
+  }
+  for (double value : values) {
+    std::fprintf(fileptr, "%.17e\n", value);
+  }
+  std::fclose(fileptr);
+}
+
+/**
+ * @brief Compare values against the saved reference.
+ *
+ * @param values Values.
+ * @returns Number of failed checks.
+ */
+int check_against_reference(const std::vector<double>& values) {
+  std::FILE* fileptr = std::fopen(test_ref_file, "r");
+  if (fileptr == nullptr) {
+    std::fprintf(
+      stderr, "Missing test reference file (run on a single task first).\n"
+    );
+    return 1;
+  }
+
+  std::vector<double> values_ref;
+  double value_ref;
+  while (std::fscanf(fileptr, "%lf", &value_ref) == 1) {
+    values_ref.push_back(value_ref);
+  }
+  std::fclose(fileptr);
+
+  if (values_ref.size() != values.size()) {
+    std::fprintf(stderr, "Mismatched number of reference values.\n");
+    return 1;
+  }
+
+  double scale = 0.;
+  for (double value : values_ref) {
+    scale = std::fmax(scale, std::fabs(value));
+  }
+
+  int nmismatch = 0;
+  for (std::size_t idx = 0; idx < values.size(); idx++) {
+    double diff = std::fabs(values[idx] - values_ref[idx]);
+    if (diff > TOL * std::fmax(std::fabs(values_ref[idx]), 1.e-3 * scale)) {
+      nmismatch++;
+    }
+  }
+  if (nmismatch > 0) {
+    std::fprintf(
+      stderr, "Measurements on %d tasks differ from a single task "
+      "in %d value(s).\n", trvs::numTasks, nmismatch
+    );
+  }
+
+  return nmismatch;
+}
+
+int main(int argc, char* argv[]) {
+  trvs::init_tasks(&argc, &argv);
+
+#ifdef TRV_USE_MPI
+  /// FFTW threads must be initialised before FFTW MPI.
+  trvs::init_fftw();
+  fftw_mpi_init();
+#endif  // TRV_USE_MPI
+
+  trvs::logger.reset_level(trvs::LogLevel::WARN);
+
+  std::vector<double> values = measure_test_cases();
+
+  /// Measurements are reduced across tasks, so are checked on the root.
+  int nfailed = 0;
+  if (trvs::currTask == 0) {
+    if (trvs::numTasks == 1) {
+      save_reference(values);
+    } else {
+      nfailed += check_against_reference(values);
+      std::remove(test_ref_file);
+    }
+  }
+
+  trvs::sum_across_tasks(&nfailed, 1);
+
+#ifdef TRV_USE_MPI
+  fftw_mpi_cleanup();
+#endif  // TRV_USE_MPI
+  trvs::finalise_tasks();
+
+  if (nfailed > 0) {
+    if (trvs::currTask == 0) {
+      std::fprintf(stderr, "MPI tests failed: %d.\n", nfailed);
+    }
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,384 @@
+// Copyright (C) [GPLv3 Licence]
+//
+// This file is part of the Triumvirate program. See the COPYRIGHT
+// and LICENCE files at the top-level directory of this distribution
+// for details of copyright and licensing.
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file test_particles.cpp
+ * @brief Tests of particle catalogue I/O.
+ *
+ * A synthetic catalogue file is written to the test output directory
+ * and read back in different ways, which must agree with loading the
+ * file in full.  The program returns a non-zero exit status if any
+ * check fails.
+ *
+ */
+
+#ifdef TRV_USE_ZLIB
+#include <zlib.h>
+#endif  // TRV_USE_ZLIB
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "monitor.hpp"
+#include "particles.hpp"
+
+namespace trvs = trv::sys;
+
+const char test_catalogue_file[] =
+  "triumvirate/tests/test_output/test_catalogue.dat";
+const char test_catalogue_gz_file[] =
+  "triumvirate/tests/test_output/test_catalogue.dat.gz";
+const char test_catalogue_columns[] = "x,y,z,nz,ws";
+
+const int NPARTICLES = 2000;    ///< particle number
+const double BOXSIZE = 1000.;   ///< box size
+
+/**
+ * @brief Write a synthetic survey-like catalogue file.
+ *
+ * Particles are placed uniformly in a cube away from the observer at
+ * the origin, with random systematic weights.
+ *
+ * @param filepath Catalogue file path.
+ * @param npart Particle number.
+ * @param seed Random seed.
+ */
+void write_test_catalogue(
+  const std::string& filepath, int npart, unsigned seed
+) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> uniform_pos(100., 900.);
+  std::uniform_real_distribution<double> uniform_wgt(0.5, 1.5);
+
+  std::FILE* fileptr = std::fopen(filepath.c_str(), "w");
+  if (fileptr == nullptr) {
+    throw trvs::IOError(
+      "Cannot open test catalogue file: %s.\n", filepath.c_str()
+    );
+  }
+
+  std::fprintf(fileptr, "# x y z nz ws\n");
+  for (int pid = 0; pid < npart; pid++) {
+    double x = uniform_pos(gen), y = uniform_pos(gen), z = uniform_pos(gen);
+    std::fprintf(
+      fileptr, "%.9e %.9e %.9e %.9e %.9e\n",
+      x, y, z, npart / std::pow(800., 3), uniform_wgt(gen)
+    );
+    if (pid % 500 == 0) {std::fprintf(fileptr, "\n# comment line\n");}
+  }
+
+  std::fclose(fileptr);
+}
+
+/**
+ * @brief Check that a streamed catalogue reproduces the fully loaded
+ *        catalogue, in summary and chunk by chunk.
+ *
+ * @returns Number of failed checks.
+ */
+int test_catalogue_stream() {
+  const double boxsize[3] = {BOXSIZE, BOXSIZE, BOXSIZE};
+  const int chunk_size = 97;  // not a divisor of the particle number
+
+  trv::ParticleCatalogue catalogue;
+  catalogue.load_catalogue_file(test_catalogue_file, test_catalogue_columns);
+
+  trv::ParticleCatalogue catalogue_summary;
+  trv::ParticleCatalogueStream stream(
+    catalogue_summary, test_catalogue_file, test_catalogue_columns,
+    chunk_size
+  );
+
+  int nfailed = 0;
+
+  if (!catalogue_summary.streamed || catalogue_summary.ntotal != NPARTICLES
+      || catalogue.ntotal != NPARTICLES) {
+    std::fprintf(stderr, "Streamed catalogue particle number differs.\n");
+    nfailed++;
+  }
+  if (std::fabs(catalogue_summary.wtotal - catalogue.wtotal)
+      > 1.e-10 * catalogue.wtotal) {
+    std::fprintf(stderr, "Streamed catalogue total weight differs.\n");
+    nfailed++;
+  }
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    if (catalogue_summary.pos_min[iaxis] != catalogue.pos_min[iaxis]
+        || catalogue_summary.pos_max[iaxis] != catalogue.pos_max[iaxis]) {
+      std::fprintf(stderr, "Streamed catalogue extents differ.\n");
+      nfailed++;
+    }
+  }
+
+  /// Chunks are offset into the frame of the aligned summary catalogue.
+  trv::ParticleCatalogue::centre_in_box(catalogue, boxsize);
+  trv::ParticleCatalogue::centre_in_box(catalogue_summary, boxsize);
+
+  for (int ipass = 0; ipass < 2; ipass++) {
+    int pid_offset = 0;
+    int nchunk;
+    while ((nchunk = stream.read_next_chunk()) > 0) {
+      if (nchunk > chunk_size || pid_offset + nchunk > NPARTICLES) {
+        std::fprintf(stderr, "Streamed chunk is oversized.\n");
+        nfailed++;
+        break;
+      }
+      for (int pid = 0; pid < nchunk; pid++) {
+        const auto& particle = stream.chunk.pdata[pid];
+        const auto& particle_ref = catalogue.pdata[pid_offset + pid];
+        bool match = particle.nz == particle_ref.nz
+          && particle.ws == particle_ref.ws && particle.w == particle_ref.w;
+        for (int iaxis = 0; iaxis < 3; iaxis++) {
+          match = match && std::fabs(
+            particle.pos[iaxis] - particle_ref.pos[iaxis]
+          ) < 1.e-9 * BOXSIZE;
+        }
+        if (!match) {nfailed++;}
+      }
+      pid_offset += nchunk;
+    }
+    if (pid_offset != NPARTICLES) {
+      std::fprintf(
+        stderr, "Streamed particle number differs (pass %d).\n", ipass
+      );
+      nfailed++;
+    }
+
+    stream.rewind();
+  }
+
+  return nfailed;
+}
+
+/**
+ * @brief Check that particle data read in column by column reproduce
+ *        particle data read in at once.
+ *
+ * @returns Number of failed checks.
+ */
+int test_column_loading() {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(0.5, 1.5);
+
+  std::vector< std::vector<double> > columns(6);
+  for (auto& column : columns) {
+    for (int pid = 0; pid < NPARTICLES; pid++) {
+      column.push_back(dist(gen));
+    }
+  }
+
+  trv::ParticleCatalogue catalogue_ref;
+  catalogue_ref.load_particle_data(
+    columns[0], columns[1], columns[2], columns[3], columns[4], columns[5]
+  );
+
+  const char* names[] = {"x", "y", "z", "nz", "ws", "wc"};
+
+  trv::ParticleCatalogue catalogue;
+  catalogue.initialise_particles(NPARTICLES);
+  for (int icol = 0; icol < 6; icol++) {
+    catalogue.load_particle_data_column(
+      names[icol], columns[icol].data(), NPARTICLES
+    );
+  }
+  catalogue.calc_wtotal();
+  catalogue.calc_pos_min_and_max();
+
+  int nfailed = 0;
+
+  if (catalogue.wtotal != catalogue_ref.wtotal) {
+    std::fprintf(stderr, "Column-loaded total weight differs.\n");
+    nfailed++;
+  }
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    if (catalogue.pos_min[iaxis] != catalogue_ref.pos_min[iaxis]
+        || catalogue.pos_max[iaxis] != catalogue_ref.pos_max[iaxis]) {
+      std::fprintf(stderr, "Column-loaded extents differ.\n");
+      nfailed++;
+    }
+  }
+  for (int pid = 0; pid < NPARTICLES; pid++) {
+    const auto& particle = catalogue.pdata[pid];
+    const auto& particle_ref = catalogue_ref.pdata[pid];
+    bool match = particle.nz == particle_ref.nz
+      && particle.ws == particle_ref.ws && particle.wc == particle_ref.wc
+      && particle.w == particle_ref.w;
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      match = match && particle.pos[iaxis] == particle_ref.pos[iaxis];
+    }
+    if (!match) {nfailed++;}
+  }
+
+  /// Columns must match the initialised container and be named.
+  try {
+    catalogue.load_particle_data_column(
+      "x", columns[0].data(), NPARTICLES - 1
+    );
+    std::fprintf(stderr, "Mis-sized column is not rejected.\n");
+    nfailed++;
+  } catch (const trvs::InvalidData&) {}
+  try {
+    catalogue.load_particle_data_column(
+      "w", columns[0].data(), NPARTICLES
+    );
+    std::fprintf(stderr, "Unknown column is not rejected.\n");
+    nfailed++;
+  } catch (const trvs::InvalidParameter&) {}
+
+  return nfailed;
+}
+
+#ifdef TRV_USE_ZLIB
+/**
+ * @brief Write a gzip-compressed copy of a catalogue file.
+ *
+ * The copy is written as two concatenated gzip members, as produced
+ * by parallel compressors.
+ *
+ * @param filepath Catalogue file path.
+ * @param filepath_gz Compressed catalogue file path.
+ */
+void compress_test_catalogue(
+  const std::string& filepath, const std::string& filepath_gz
+) {
+  std::ifstream fin(filepath.c_str(), std::ios::in);
+  std::stringstream sbuff;
+  sbuff << fin.rdbuf();
+  const std::string content = sbuff.str();
+
+  const std::size_t split = content.size() / 2;
+  const char* modes[2] = {"wb", "ab"};
+  const std::size_t offsets[3] = {0, split, content.size()};
+  for (int imember = 0; imember < 2; imember++) {
+    gzFile gzfile = gzopen(filepath_gz.c_str(), modes[imember]);
+    if (gzfile == nullptr) {
+      throw trvs::IOError(
+        "Cannot open compressed test catalogue file: %s.\n",
+        filepath_gz.c_str()
+      );
+    }
+    gzwrite(
+      gzfile, content.data() + offsets[imember],
+      unsigned(offsets[imember + 1] - offsets[imember])
+    );
+    gzclose(gzfile);
+  }
+}
+#endif  // TRV_USE_ZLIB
+
+/**
+ * @brief Check that a gzip-compressed catalogue file is read
+ *        identically to the plain file, or else rejected in a build
+ *        without compression support.
+ *
+ * @returns Number of failed checks.
+ */
+int test_compressed_catalogue() {
+  int nfailed = 0;
+
+#ifdef TRV_USE_ZLIB
+  compress_test_catalogue(test_catalogue_file, test_catalogue_gz_file);
+
+  trv::ParticleCatalogue catalogue, catalogue_gz;
+  catalogue.load_catalogue_file(test_catalogue_file, test_catalogue_columns);
+  catalogue_gz.load_catalogue_file(
+    test_catalogue_gz_file, test_catalogue_columns
+  );
+
+  if (catalogue_gz.ntotal != catalogue.ntotal) {
+    std::fprintf(stderr, "Compressed catalogue particle number differs.\n");
+    return ++nfailed;
+  }
+  for (int pid = 0; pid < catalogue.ntotal; pid++) {
+    const auto& particle = catalogue_gz.pdata[pid];
+    const auto& particle_ref = catalogue.pdata[pid];
+    bool match = particle.nz == particle_ref.nz
+      && particle.ws == particle_ref.ws && particle.wc == particle_ref.wc;
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      match = match && particle.pos[iaxis] == particle_ref.pos[iaxis];
+    }
+    if (!match) {nfailed++;}
+  }
+  if (nfailed > 0) {
+    std::fprintf(stderr, "Compressed catalogue particles differ.\n");
+  }
+
+  /// Compressed catalogues are also streamed in chunks.
+  trv::ParticleCatalogue catalogue_summary;
+  trv::ParticleCatalogueStream stream(
+    catalogue_summary, test_catalogue_gz_file, test_catalogue_columns, 97
+  );
+
+  int ntotal_s = 0;
+  int nchunk;
+  while ((nchunk = stream.read_next_chunk()) > 0) {
+    ntotal_s += nchunk;
+  }
+  if (ntotal_s != NPARTICLES || catalogue_summary.ntotal != NPARTICLES
+      || std::fabs(catalogue_summary.wtotal - catalogue.wtotal)
+        > 1.e-10 * catalogue.wtotal) {
+    std::fprintf(stderr, "Streamed compressed catalogue differs.\n");
+    nfailed++;
+  }
+#else   // !TRV_USE_ZLIB
+  /// Compression is detected from the magic bytes regardless of
+  /// build support.
+  std::FILE* fileptr = std::fopen(test_catalogue_gz_file, "wb");
+  const unsigned char magic[4] = {0x1F, 0x8B, 0x08, 0x00};
+  std::fwrite(magic, 1, 4, fileptr);
+  std::fclose(fileptr);
+
+  try {
+    trv::ParticleCatalogue catalogue_gz;
+    catalogue_gz.load_catalogue_file(
+      test_catalogue_gz_file, test_catalogue_columns
+    );
+    std::fprintf(stderr, "Unsupported compressed catalogue is accepted.\n");
+    nfailed++;
+  } catch (trvs::IOError& err) {}
+#endif  // TRV_USE_ZLIB
+
+  std::remove(test_catalogue_gz_file);
+
+  return nfailed;
+}
+
+int main() {
+  trvs::logger.reset_level(trvs::LogLevel::WARN);
+
+  write_test_catalogue(test_catalogue_file, NPARTICLES, 42);
+
+  int nfailed = 0;
+  nfailed += test_catalogue_stream();
+  nfailed += test_column_loading();
+  nfailed += test_compressed_catalogue();
+
+  std::remove(test_catalogue_file);
+
+  if (nfailed > 0) {
+    std::fprintf(stderr, "Particle catalogue tests failed: %d.\n", nfailed);
+    return 1;
+  }
+
+  return 0;
+}
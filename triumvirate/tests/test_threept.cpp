@@ -0,0 +1,506 @@
+// Copyright (C) [GPLv3 Licence]
+//
+// This file is part of the Triumvirate program. See the COPYRIGHT
+// and LICENCE files at the top-level directory of this distribution
+// for details of copyright and licensing.
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file test_threept.cpp
+ * @brief Tests of three-point clustering measurements.
+ *
+ * Measurements on synthetic catalogues by optimised code paths are
+ * compared against direct full-mesh computations.  The program returns
+ * a non-zero exit status if any check fails.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "monitor.hpp"
+#include "maths.hpp"
+#include "parameters.hpp"
+#include "particles.hpp"
+#include "dataobjs.hpp"
+#include "field.hpp"
+#include "threept.hpp"
+
+namespace trvs = trv::sys;
+namespace trvm = trv::maths;
+
+const int NDATA = 2000;        ///< data particle number
+const int NRAND = 5000;        ///< random particle number
+const double BOXSIZE = 1000.;  ///< box size
+const int NGRID = 32;          ///< grid number
+const double TOL = 1.e-10;     ///< relative tolerance
+
+/**
+ * @brief Load a synthetic survey-like catalogue.
+ *
+ * Particles are placed uniformly in a cube away from the observer at
+ * the origin, with random systematic weights.
+ *
+ * @param catalogue Particle catalogue.
+ * @param npart Particle number.
+ * @param seed Random seed.
+ */
+void load_test_catalogue(
+  trv::ParticleCatalogue& catalogue, int npart, unsigned seed
+) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> uniform_pos(100., 900.);
+  std::uniform_real_distribution<double> uniform_wgt(0.5, 1.5);
+
+  std::vector<double> x(npart), y(npart), z(npart);
+  std::vector<double> nz(npart, npart / std::pow(800., 3));
+  std::vector<double> ws(npart), wc(npart, 1.);
+  for (int pid = 0; pid < npart; pid++) {
+    x[pid] = uniform_pos(gen);
+    y[pid] = uniform_pos(gen);
+    z[pid] = uniform_pos(gen);
+    ws[pid] = uniform_wgt(gen);
+  }
+
+  catalogue.load_particle_data(x, y, z, nz, ws, wc);
+}
+
+/**
+ * @brief Load a synthetic simulation-box catalogue.
+ *
+ * Particles are placed uniformly in the box.
+ *
+ * @param catalogue Particle catalogue.
+ * @param npart Particle number.
+ * @param seed Random seed.
+ */
+void load_box_catalogue(
+  trv::ParticleCatalogue& catalogue, int npart, unsigned seed
+) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> uniform_pos(0., BOXSIZE);
+
+  std::vector<double> x(npart), y(npart), z(npart);
+  std::vector<double> nz(npart, npart / std::pow(BOXSIZE, 3));
+  std::vector<double> ws(npart, 1.), wc(npart, 1.);
+  for (int pid = 0; pid < npart; pid++) {
+    x[pid] = uniform_pos(gen);
+    y[pid] = uniform_pos(gen);
+    z[pid] = uniform_pos(gen);
+  }
+
+  catalogue.load_particle_data(x, y, z, nz, ws, wc);
+}
+
+/**
+ * @brief Set up measurement parameters.
+ *
+ * @param catalogue_type Catalogue type.
+ * @param form Three-point statistic form.
+ * @returns Parameter set.
+ */
+trv::ParameterSet set_params(
+  const std::string& catalogue_type, const std::string& form
+) {
+  trv::ParameterSet params;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    params.boxsize[iaxis] = BOXSIZE;
+    params.ngrid[iaxis] = NGRID;
+  }
+  params.volume = BOXSIZE * BOXSIZE * BOXSIZE;
+  params.nmesh = NGRID * NGRID * NGRID;
+  params.alignment = "centre";
+  params.assignment = "tsc";
+  params.interlace = "false";
+  params.catalogue_type = catalogue_type;
+  params.statistic_type = "bispec";
+  params.norm_convention = "particle";
+  params.binning = "lin";
+  params.form = form;
+  params.ell1 = 0; params.ell2 = 0; params.ELL = 0;
+  params.i_wa = 0; params.j_wa = 0;
+  params.num_bins = 4;
+  params.idx_bin = 0;
+  params.bin_min = 2. * M_PI / BOXSIZE;
+  params.bin_max = M_PI * NGRID / BOXSIZE / 2.;
+  params.verbose = trvs::LogLevel::WARN;
+
+  params.validate();
+
+  return params;
+}
+
+/**
+ * @brief Check that bispectrum components of low-k band pairs on
+ *        reduced mesh grids reproduce those on the full mesh grid.
+ *
+ * @returns Number of failed checks.
+ */
+int test_reduced_mesh_components() {
+  trv::ParameterSet params = set_params("survey", "full");
+
+  trv::ParticleCatalogue catalogue_data, catalogue_rand;
+  load_test_catalogue(catalogue_data, NDATA, 42);
+  load_test_catalogue(catalogue_rand, NRAND, 43);
+
+  trv::ParticleCatalogue::centre_in_box(
+    catalogue_data, catalogue_rand, params.boxsize
+  );
+
+  trv::RadialLineOfSight los_data(catalogue_data.pos_observer);
+  trv::RadialLineOfSight los_rand(catalogue_rand.pos_observer);
+
+  double alpha = catalogue_data.wtotal / catalogue_rand.wtotal;
+
+  trv::MeshField dn(params);
+  dn.compute_ylm_wgtd_field(
+    catalogue_data, catalogue_rand, los_data, los_rand, alpha, 0, 0
+  );
+  dn.fourier_transform();
+
+  trv::MeshField G(params);
+  G.compute_ylm_wgtd_field(
+    catalogue_data, catalogue_rand, los_data, los_rand, alpha, 2, 1
+  );
+  G.fourier_transform();
+  G.apply_assignment_compensation();
+
+  trv::MeshField G_config(params);
+  G_config.compute_ylm_wgtd_field(
+    catalogue_data, catalogue_rand, los_data, los_rand, alpha, 2, 1
+  );
+  G_config.fourier_transform();
+  G_config.apply_assignment_compensation();
+  G_config.inv_fourier_transform();
+
+  std::vector< std::complex<double> > ylm_a(params.nmesh);
+  std::vector< std::complex<double> > ylm_b(params.nmesh);
+  trvm::SphericalHarmonicCalculator::
+    store_reduced_spherical_harmonic_in_fourier_space(
+      0, 0, params.boxsize, params.ngrid, ylm_a
+    );
+  trvm::SphericalHarmonicCalculator::
+    store_reduced_spherical_harmonic_in_fourier_space(
+      2, -1, params.boxsize, params.ngrid, ylm_b
+    );
+
+  /// Band edges (in units of the fundamental wavenumber) avoid exact
+  /// mode magnitudes.
+  const double dk = 2. * M_PI / BOXSIZE;
+  const double band_pairs[][4] = {
+    {0.5, 1.5, 0.5, 1.5}, {1.5, 2.5, 3.5, 4.5}, {4.5, 5.5, 5.5, 6.5}
+  };
+
+  int nfailed = 0;
+  for (const auto& bands : band_pairs) {
+    const double k_lower_a = bands[0] * dk, k_upper_a = bands[1] * dk;
+    const double k_lower_b = bands[2] * dk, k_upper_b = bands[3] * dk;
+
+    char name[128];
+    std::snprintf(
+      name, sizeof(name), "bands (%g, %g] x (%g, %g] dk",
+      bands[0], bands[1], bands[2], bands[3]
+    );
+
+    trv::ParameterSet params_reduced;
+    bool reduced = trv::set_reduced_mesh_params(
+      params, std::max(k_upper_a, k_upper_b), params_reduced
+    );
+    if (!reduced || params_reduced.nmesh >= params.nmesh) {
+      std::fprintf(stderr, "Mesh grid is not reduced for %s.\n", name);
+      nfailed++;
+      continue;
+    }
+
+    /// Compute the component on the full mesh grid.
+    double k_eff_a, k_eff_b;
+    int nmodes_a, nmodes_b;
+
+    trv::MeshField F_a(params), F_b(params);
+    F_a.inv_fourier_transform_ylm_wgtd_field_band_limited(
+      dn, ylm_a, k_lower_a, k_upper_a, k_eff_a, nmodes_a
+    );
+    F_b.inv_fourier_transform_ylm_wgtd_field_band_limited(
+      dn, ylm_b, k_lower_b, k_upper_b, k_eff_b, nmodes_b
+    );
+
+    std::complex<double> bk_component_ref = 0.;
+    for (long long gid = 0; gid < params.nmesh; gid++) {
+      bk_component_ref += std::complex<double>(F_a[gid][0], F_a[gid][1])
+        * std::complex<double>(F_b[gid][0], F_b[gid][1])
+        * std::complex<double>(G_config[gid][0], G_config[gid][1]);
+    }
+    bk_component_ref *= params.volume / double(params.nmesh);
+
+    /// Compute the component on the reduced mesh grid.
+    double k_eff_a_r, k_eff_b_r;
+    int nmodes_a_r, nmodes_b_r;
+
+    std::complex<double> bk_component =
+      trv::calc_bispec_component_on_reduced_mesh(
+        params_reduced, dn, ylm_a, ylm_b, G,
+        k_lower_a, k_upper_a, k_lower_b, k_upper_b,
+        k_eff_a_r, nmodes_a_r, k_eff_b_r, nmodes_b_r
+      );
+
+    if (nmodes_a_r != nmodes_a || nmodes_b_r != nmodes_b
+        || std::fabs(k_eff_a_r - k_eff_a) > TOL * k_eff_a
+        || std::fabs(k_eff_b_r - k_eff_b) > TOL * k_eff_b) {
+      std::fprintf(stderr, "Mismatched modes for %s.\n", name);
+      nfailed++;
+    }
+    if (std::abs(bk_component - bk_component_ref)
+        > TOL * std::abs(bk_component_ref)) {
+      std::fprintf(
+        stderr, "Mismatched reduced-mesh component for %s: "
+        "(%.10e, %.10e) vs (%.10e, %.10e).\n", name,
+        bk_component.real(), bk_component.imag(),
+        bk_component_ref.real(), bk_component_ref.imag()
+      );
+      nfailed++;
+    }
+  }
+
+  /// Bands reaching the Nyquist wavenumber need the full mesh grid.
+  trv::ParameterSet params_reduced;
+  if (trv::set_reduced_mesh_params(params, params.bin_max, params_reduced)) {
+    std::fprintf(stderr, "Mesh grid is reduced up to the Nyquist.\n");
+    nfailed++;
+  }
+
+  return nfailed;
+}
+
+/**
+ * @brief Check that all-triangle bispectrum measurements reproduce
+ *        direct sums over closed wavevector triangles.
+ *
+ * @returns Number of failed checks.
+ */
+int test_bispec_triangles() {
+  trv::ParameterSet params = set_params("sim", "triangle");
+
+  /// Bin edges (in units of the fundamental wavenumber) avoid exact
+  /// mode magnitudes.
+  const double dk = 2. * M_PI / BOXSIZE;
+  params.bin_min = 0.6 * dk;
+  params.bin_max = 7.6 * dk;
+  params.validate();
+
+  trv::Binning binning(params);
+  binning.set_bins();
+
+  trv::ParticleCatalogue catalogue;
+  load_box_catalogue(catalogue, NDATA, 42);
+
+  trv::BispecTriangleMeasurements meas =
+    trv::compute_bispec_triangles_in_gpp_box(catalogue, params, binning, 1.);
+
+  /// Collect the compensated Fourier modes in the wavenumber bins.
+  trv::MeshField dn(params);
+  dn.compute_unweighted_field_fluctuations_insitu(catalogue);
+  dn.fourier_transform();
+  dn.apply_assignment_compensation();
+
+  struct Mode {
+    int n[3];
+    int ibin;
+    std::complex<double> dk;
+  };
+
+  auto find_bin = [&binning](const int n[3]) {
+    double kmag = 2. * M_PI / BOXSIZE
+      * std::sqrt(double(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]));
+    for (int ibin = 0; ibin < binning.num_bins; ibin++) {
+      if (binning.bin_edges[ibin] < kmag
+          && kmag <= binning.bin_edges[ibin + 1]) {
+        return ibin;
+      }
+    }
+    return -1;
+  };
+
+  auto get_mode = [&dn](const int n[3]) {
+    int idx[3];
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      idx[iaxis] = (n[iaxis] + NGRID) % NGRID;
+    }
+    long long gid = (idx[0] * NGRID + idx[1]) * (long long)(NGRID) + idx[2];
+    return std::complex<double>(dn[gid][0], dn[gid][1]);
+  };
+
+  std::vector<Mode> modes;
+  for (int nx = - NGRID / 2; nx < NGRID / 2; nx++) {
+    for (int ny = - NGRID / 2; ny < NGRID / 2; ny++) {
+      for (int nz = - NGRID / 2; nz < NGRID / 2; nz++) {
+        Mode mode = {{nx, ny, nz}, -1, 0.};
+        mode.ibin = find_bin(mode.n);
+        if (mode.ibin < 0) {continue;}
+        mode.dk = get_mode(mode.n);
+        modes.push_back(mode);
+      }
+    }
+  }
+
+  /// Sum over ordered closed triangles (k_1, k_2, k_3) with the sides
+  /// in ascending wavenumber bins.
+  struct TriangleSum {
+    long long ntriangles = 0;
+    std::complex<double> bk_sum = 0.;
+  };
+  std::map<std::vector<int>, TriangleSum> triangle_sums;
+  for (const Mode& mode_a : modes) {
+    for (const Mode& mode_b : modes) {
+      if (mode_b.ibin < mode_a.ibin) {continue;}
+
+      int n_c[3];
+      for (int iaxis = 0; iaxis < 3; iaxis++) {
+        n_c[iaxis] = - mode_a.n[iaxis] - mode_b.n[iaxis];
+      }
+      int ibin_c = find_bin(n_c);
+      if (ibin_c < mode_b.ibin) {continue;}
+
+      TriangleSum& tri = triangle_sums[{mode_a.ibin, mode_b.ibin, ibin_c}];
+      tri.ntriangles++;
+      tri.bk_sum += mode_a.dk * mode_b.dk * get_mode(n_c);
+    }
+  }
+
+  int nfailed = 0;
+
+  if (meas.bk_raw.size() != triangle_sums.size()) {
+    std::fprintf(
+      stderr, "Mismatched number of triangle bins: %zu vs %zu.\n",
+      meas.bk_raw.size(), triangle_sums.size()
+    );
+    return ++nfailed;
+  }
+
+  double scale = 0.;
+  for (const auto& tri : triangle_sums) {
+    scale = std::fmax(
+      scale, std::abs(tri.second.bk_sum) / tri.second.ntriangles
+    );
+  }
+
+  std::size_t itri = 0;
+  for (const auto& tri : triangle_sums) {
+    const std::vector<int>& ibins = tri.first;
+    std::complex<double> bk_ref = tri.second.bk_sum
+      / double(tri.second.ntriangles);
+
+    if (meas.k1bin[itri] != binning.bin_centres[ibins[0]]
+        || meas.k2bin[itri] != binning.bin_centres[ibins[1]]
+        || meas.k3bin[itri] != binning.bin_centres[ibins[2]]) {
+      std::fprintf(
+        stderr, "Mismatched triangle bin (%d, %d, %d).\n",
+        ibins[0], ibins[1], ibins[2]
+      );
+      nfailed++;
+    } else if (meas.ntriangles[itri] != tri.second.ntriangles) {
+      std::fprintf(
+        stderr, "Mismatched triangle count in bin (%d, %d, %d): "
+        "%lld vs %lld.\n", ibins[0], ibins[1], ibins[2],
+        meas.ntriangles[itri], tri.second.ntriangles
+      );
+      nfailed++;
+    } else if (std::abs(meas.bk_raw[itri] - bk_ref) > TOL * scale) {
+      std::fprintf(
+        stderr, "Mismatched bispectrum in bin (%d, %d, %d): "
+        "(%.10e, %.10e) vs (%.10e, %.10e).\n",
+        ibins[0], ibins[1], ibins[2],
+        meas.bk_raw[itri].real(), meas.bk_raw[itri].imag(),
+        bk_ref.real(), bk_ref.imag()
+      );
+      nfailed++;
+    }
+    itri++;
+  }
+
+  /// With subsampling, triangles are still counted in full, and bins
+  /// below the subsampling wavenumber are unchanged.
+  params.subsample_kmin = binning.bin_edges[3];
+  params.subsample_frac = 0.5;
+
+  trv::ParticleCatalogue catalogue_s;
+  load_box_catalogue(catalogue_s, NDATA, 42);
+
+  trv::BispecTriangleMeasurements meas_s =
+    trv::compute_bispec_triangles_in_gpp_box(catalogue_s, params, binning, 1.);
+
+  int ntri_subsampled = 0;
+  for (std::size_t itri_s = 0; itri_s < meas_s.bk_raw.size(); itri_s++) {
+    std::size_t itri_ = 0;
+    while (itri_ < meas.bk_raw.size()
+           && !(meas.k1bin[itri_] == meas_s.k1bin[itri_s]
+                && meas.k2bin[itri_] == meas_s.k2bin[itri_s]
+                && meas.k3bin[itri_] == meas_s.k3bin[itri_s])) {
+      itri_++;
+    }
+    if (itri_ == meas.bk_raw.size()) {
+      std::fprintf(stderr, "Unexpected subsampled triangle bin.\n");
+      nfailed++;
+      continue;
+    }
+
+    if (meas_s.ntriangles[itri_s] != meas.ntriangles[itri_]) {
+      std::fprintf(
+        stderr, "Mismatched subsampled triangle count: %lld vs %lld.\n",
+        meas_s.ntriangles[itri_s], meas.ntriangles[itri_]
+      );
+      nfailed++;
+    }
+
+    if (meas_s.k3bin[itri_s] < params.subsample_kmin) {
+      if (std::abs(meas_s.bk_raw[itri_s] - meas.bk_raw[itri_])
+          > TOL * scale) {
+        std::fprintf(stderr, "Changed unsubsampled triangle bin.\n");
+        nfailed++;
+      }
+    } else if (meas_s.bk_raw[itri_s] != meas.bk_raw[itri_]) {
+      ntri_subsampled++;
+    }
+  }
+
+  if (ntri_subsampled == 0) {
+    std::fprintf(stderr, "No triangle bin is subsampled.\n");
+    nfailed++;
+  }
+
+  return nfailed;
+}
+
+int main() {
+  trvs::logger.reset_level(trvs::LogLevel::WARN);
+
+  int nfailed = 0;
+  nfailed += test_reduced_mesh_components();
+  nfailed += test_bispec_triangles();
+
+  if (nfailed > 0) {
+    std::fprintf(
+      stderr, "Three-point measurement tests failed: %d.\n", nfailed
+    );
+    return 1;
+  }
+
+  return 0;
+}
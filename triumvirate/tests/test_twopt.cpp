@@ -0,0 +1,933 @@
+// Copyright (C) [GPLv3 Licence]
+//
+// This file is part of the Triumvirate program. See the COPYRIGHT
+// and LICENCE files at the top-level directory of this distribution
+// for details of copyright and licensing.
+//
+// This program is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file test_twopt.cpp
+ * @brief Tests of two-point clustering measurements.
+ *
+ * Measurements on synthetic catalogues by alternative code paths
+ * are compared against the reference in-memory estimators.  The program
+ * returns a non-zero exit status if any check fails.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "monitor.hpp"
+#include "parameters.hpp"
+#include "particles.hpp"
+#include "dataobjs.hpp"
+#include "twopt.hpp"
+
+namespace trvs = trv::sys;
+
+const char test_data_file[] =
+  "triumvirate/tests/test_output/test_twopt_data.dat";
+const char test_rand_file[] =
+  "triumvirate/tests/test_output/test_twopt_rand.dat";
+const char test_catalogue_columns[] = "x,y,z,nz,ws";
+const char test_cache_dir[] = "triumvirate/tests/test_output";
+
+const int NDATA = 2000;        ///< data particle number
+const int NRAND = 5000;        ///< random particle number
+const double BOXSIZE = 1000.;  ///< box size
+const int NGRID = 16;          ///< grid number
+const double TOL = 1.e-8;      ///< relative tolerance
+
+/**
+ * @brief Write a synthetic survey-like catalogue file.
+ *
+ * Particles are placed uniformly in a cube away from the observer at
+ * the origin, with random systematic weights.
+ *
+ * @param filepath Catalogue file path.
+ * @param npart Particle number.
+ * @param seed Random seed.
+ */
+void write_test_catalogue(
+  const std::string& filepath, int npart, unsigned seed
+) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> uniform_pos(100., 900.);
+  std::uniform_real_distribution<double> uniform_wgt(0.5, 1.5);
+
+  std::FILE* fileptr = std::fopen(filepath.c_str(), "w");
+  if (fileptr == nullptr) {
+    throw trvs::IOError(
+      "Cannot open test catalogue file: %s.\n", filepath.c_str()
+    );
+  }
+
+  std::fprintf(fileptr, "# x y z nz ws\n");
+  for (int pid = 0; pid < npart; pid++) {
+    double x = uniform_pos(gen), y = uniform_pos(gen), z = uniform_pos(gen);
+    std::fprintf(
+      fileptr, "%.9e %.9e %.9e %.9e %.9e\n",
+      x, y, z, npart / std::pow(800., 3), uniform_wgt(gen)
+    );
+  }
+
+  std::fclose(fileptr);
+}
+
+/**
+ * @brief Load a synthetic simulation-box catalogue.
+ *
+ * Particles are placed uniformly in the box.
+ *
+ * @param catalogue Particle catalogue.
+ * @param npart Particle number.
+ * @param seed Random seed.
+ */
+void load_box_catalogue(
+  trv::ParticleCatalogue& catalogue, int npart, unsigned seed
+) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> uniform_pos(0., BOXSIZE);
+
+  std::vector<double> x(npart), y(npart), z(npart);
+  std::vector<double> nz(npart, npart / std::pow(BOXSIZE, 3));
+  std::vector<double> ws(npart, 1.), wc(npart, 1.);
+  for (int pid = 0; pid < npart; pid++) {
+    x[pid] = uniform_pos(gen);
+    y[pid] = uniform_pos(gen);
+    z[pid] = uniform_pos(gen);
+  }
+
+  catalogue.load_particle_data(x, y, z, nz, ws, wc);
+}
+
+/**
+ * @brief Set up measurement parameters.
+ *
+ * @param statistic Statistic type.
+ * @param ELL Multipole degree.
+ * @returns Parameter set.
+ */
+trv::ParameterSet set_params(const std::string& statistic, int ELL) {
+  trv::ParameterSet params;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    params.boxsize[iaxis] = BOXSIZE;
+    params.ngrid[iaxis] = NGRID;
+  }
+  params.volume = BOXSIZE * BOXSIZE * BOXSIZE;
+  params.nmesh = NGRID * NGRID * NGRID;
+  params.alignment = "centre";
+  params.assignment = "cic";
+  params.interlace = "false";
+  params.catalogue_type = "survey";
+  params.statistic_type = statistic;
+  params.norm_convention = "particle";
+  params.binning = "lin";
+  params.form = "diag";
+  params.ell1 = 0; params.ell2 = 0; params.ELL = ELL;
+  params.i_wa = 0; params.j_wa = 0;
+  params.num_bins = 5;
+  params.idx_bin = 0;
+  params.verbose = trvs::LogLevel::WARN;
+
+  if (statistic == "powspec") {
+    params.bin_min = 2. * M_PI / BOXSIZE;
+    params.bin_max = M_PI * NGRID / BOXSIZE / 2.;
+  } else {
+    params.bin_min = 2. * BOXSIZE / NGRID;
+    params.bin_max = BOXSIZE / 4.;
+  }
+
+  params.validate();
+
+  return params;
+}
+
+/**
+ * @brief Find the largest magnitude of a set of complex values.
+ *
+ * @param values Values.
+ * @returns Largest magnitude.
+ */
+double max_abs(const std::vector< std::complex<double> >& values) {
+  double value_max = 0.;
+  for (const auto& value : values) {
+    value_max = std::max(value_max, std::abs(value));
+  }
+  return value_max;
+}
+
+/**
+ * @brief Count mismatches between two sets of complex values.
+ *
+ * @param values Values.
+ * @param values_ref Reference values.
+ * @param scale Scale of the values, relative to which the tolerance
+ *              is set (e.g. that of the raw power spectrum for the
+ *              shot noise, which may vanish).
+ * @param name Quantity name (for reporting).
+ * @returns Number of mismatches.
+ */
+int count_mismatches(
+  const std::vector< std::complex<double> >& values,
+  const std::vector< std::complex<double> >& values_ref,
+  double scale, const std::string& name
+) {
+  if (values.size() != values_ref.size()) {
+    std::fprintf(stderr, "Mismatched '%s' sizes.\n", name.c_str());
+    return 1;
+  }
+
+  int nmismatch = 0;
+  for (std::size_t ibin = 0; ibin < values.size(); ibin++) {
+    if (std::abs(values[ibin] - values_ref[ibin]) > TOL * scale) {
+      nmismatch++;
+    }
+  }
+  if (nmismatch > 0) {
+    std::fprintf(
+      stderr, "Mismatched '%s' in %d bin(s).\n", name.c_str(), nmismatch
+    );
+  }
+
+  return nmismatch;
+}
+
+/**
+ * @brief Check that measurements with the random-source catalogue
+ *        streamed in chunks reproduce the in-memory estimators,
+ *        including the normalisation factors computed in the same pass.
+ *
+ * The multipole degree -1 stands for the power spectrum multipoles
+ * of degrees 0, 2 and 4 measured together.
+ *
+ * @returns Number of failed checks.
+ */
+int test_streamed_randoms() {
+  const int chunk_size = 333;  // not a divisor of the particle number
+
+  const std::vector< std::pair<std::string, int> > cases = {
+    {"powspec", 0}, {"powspec", 2}, {"powspec", -1}, {"2pcf", 0}, {"2pcf", 2}
+  };  // statistic types and multipole degrees
+
+  int nfailed = 0;
+  for (const auto& meas_case : cases) {
+    const std::string& statistic = meas_case.first;
+    const bool multipoles = meas_case.second < 0;
+    trv::ParameterSet params = set_params(
+      statistic, multipoles ? 0 : meas_case.second
+    );
+
+    trv::Binning binning(params);
+    binning.set_bins();
+
+    /// Measure with the random-source catalogue in memory.
+    trv::ParticleCatalogue catalogue_data, catalogue_rand;
+    catalogue_data.load_catalogue_file(test_data_file, test_catalogue_columns);
+    catalogue_rand.load_catalogue_file(test_rand_file, test_catalogue_columns);
+
+    trv::ParticleCatalogue::centre_in_box(
+      catalogue_data, catalogue_rand, params.boxsize
+    );
+
+    trv::RadialLineOfSight los_data(catalogue_data.pos_observer);
+    trv::RadialLineOfSight los_rand(catalogue_rand.pos_observer);
+
+    double alpha = catalogue_data.wtotal / catalogue_rand.wtotal;
+    double norm_factor =
+      trv::calc_powspec_normalisation_from_particles(catalogue_rand, alpha);
+    double norm_factor_alt =
+      trv::calc_powspec_normalisation_from_mesh(catalogue_rand, params, alpha);
+
+    /// Measure with the random-source catalogue streamed.
+    trv::ParticleCatalogue catalogue_data_s, catalogue_rand_s;
+    catalogue_data_s.load_catalogue_file(
+      test_data_file, test_catalogue_columns
+    );
+    trv::ParticleCatalogueStream stream_rand(
+      catalogue_rand_s, test_rand_file, test_catalogue_columns, chunk_size
+    );
+
+    trv::ParticleCatalogue::centre_in_box(
+      catalogue_data_s, catalogue_rand_s, params.boxsize
+    );
+
+    trv::RadialLineOfSight los_data_s(catalogue_data_s.pos_observer);
+    trv::RadialLineOfSight los_rand_s(catalogue_rand_s.pos_observer);
+
+    double alpha_s = catalogue_data_s.wtotal / catalogue_rand_s.wtotal;
+    double norm_factor_s =
+      trv::calc_powspec_normalisation_from_particles(stream_rand, alpha_s);
+
+    if (std::fabs(norm_factor_s - norm_factor) > TOL * norm_factor) {
+      std::fprintf(stderr, "Mismatched streamed normalisation.\n");
+      nfailed++;
+    }
+
+    double norm_factor_pass = 0., norm_factor_alt_pass = 0.;
+    if (statistic == "powspec" && multipoles) {
+      std::vector<int> ells{0, 2, 4};
+      std::vector<trv::PowspecMeasurements> meas =
+        trv::compute_powspec_multipoles(
+          catalogue_data, catalogue_rand, los_data, los_rand,
+          params, ells, binning, norm_factor
+        );
+      std::vector<trv::PowspecMeasurements> meas_s =
+        trv::compute_powspec_multipoles(
+          catalogue_data_s, stream_rand, los_data_s, los_rand_s,
+          params, ells, binning, norm_factor_pass, norm_factor_alt_pass
+        );
+
+      double scale = max_abs(meas[0].pk_raw);
+
+      for (std::size_t iell = 0; iell < ells.size(); iell++) {
+        if (meas_s[iell].nmodes != meas[iell].nmodes) {nfailed++;}
+        nfailed += count_mismatches(
+          meas_s[iell].pk_raw, meas[iell].pk_raw, scale, "pk_raw"
+        );
+        nfailed += count_mismatches(
+          meas_s[iell].pk_shot, meas[iell].pk_shot, scale, "pk_shot"
+        );
+      }
+    } else
+    if (statistic == "powspec") {
+      trv::PowspecMeasurements meas = trv::compute_powspec(
+        catalogue_data, catalogue_rand, los_data, los_rand,
+        params, binning, norm_factor
+      );
+      trv::PowspecMeasurements meas_s = trv::compute_powspec(
+        catalogue_data_s, stream_rand, los_data_s, los_rand_s,
+        params, binning, norm_factor_pass, norm_factor_alt_pass
+      );
+
+      double scale = max_abs(meas.pk_raw);
+
+      if (meas_s.nmodes != meas.nmodes) {nfailed++;}
+      nfailed += count_mismatches(meas_s.pk_raw, meas.pk_raw, scale, "pk_raw");
+      nfailed += count_mismatches(
+        meas_s.pk_shot, meas.pk_shot, scale, "pk_shot"
+      );
+    } else {
+      trv::TwoPCFMeasurements meas = trv::compute_corrfunc(
+        catalogue_data, catalogue_rand, los_data, los_rand,
+        params, binning, norm_factor
+      );
+      trv::TwoPCFMeasurements meas_s = trv::compute_corrfunc(
+        catalogue_data_s, stream_rand, los_data_s, los_rand_s,
+        params, binning, norm_factor_pass, norm_factor_alt_pass
+      );
+
+      if (meas_s.npairs != meas.npairs) {nfailed++;}
+      nfailed += count_mismatches(meas_s.xi, meas.xi, max_abs(meas.xi), "xi");
+    }
+
+    if (std::fabs(norm_factor_pass - norm_factor) > TOL * norm_factor
+        || std::fabs(norm_factor_alt_pass - norm_factor_alt)
+          > TOL * norm_factor_alt) {
+      std::fprintf(
+        stderr, "Mismatched normalisation from the streamed pass.\n"
+      );
+      nfailed++;
+    }
+  }
+
+  return nfailed;
+}
+
+/**
+ * @brief Check that measurements with the random-source meshes and
+ *        sums cached reproduce those with the random-source catalogue
+ *        in memory, both when the cache is populated and when it is
+ *        restored.
+ *
+ * @returns Number of failed checks.
+ */
+int test_random_mesh_cache() {
+  const std::vector< std::pair<std::string, int> > cases = {
+    {"powspec", 2}, {"2pcf", 0}
+  };  // statistic types and multipole degrees
+
+  int nfailed = 0;
+  for (const auto& meas_case : cases) {
+    const std::string& statistic = meas_case.first;
+    const int ELL = meas_case.second;
+
+    trv::ParameterSet params = set_params(statistic, ELL);
+    params.rand_catalogue_file = test_rand_file;
+    params.catalogue_columns = test_catalogue_columns;
+    params.random_cache_dir = test_cache_dir;
+    params.validate();
+
+    trv::Binning binning(params);
+    binning.set_bins();
+
+    /// Measure with the random-source catalogue in memory (`ipass` = 0),
+    /// then populating (1) and restoring (2) the cache.
+    std::vector< std::vector< std::complex<double> > > values_ref;
+    std::vector<double> scales;
+    std::string cache_prefix, mesh_key;
+    for (int ipass = 0; ipass < 3; ipass++) {
+      trv::ParticleCatalogue catalogue_data, catalogue_rand;
+      catalogue_data.load_catalogue_file(
+        test_data_file, test_catalogue_columns
+      );
+
+      trv::RandomMeshCache* rand_cache = nullptr;
+      if (ipass > 0) {rand_cache = new trv::RandomMeshCache(params);}
+
+      bool restored = rand_cache != nullptr
+        && rand_cache->restore_catalogue(catalogue_rand);
+      if (restored != (ipass == 2)) {
+        std::fprintf(
+          stderr, "Random mesh cache is %srestored (pass %d).\n",
+          restored ? "" : "not ", ipass
+        );
+        nfailed++;
+      }
+      if (!restored) {
+        catalogue_rand.load_catalogue_file(
+          test_rand_file, test_catalogue_columns
+        );
+        if (rand_cache != nullptr) {
+          rand_cache->attach_catalogue(catalogue_rand);
+        }
+      }
+
+      trv::ParticleCatalogue::centre_in_box(
+        catalogue_data, catalogue_rand, params.boxsize
+      );
+
+      trv::RadialLineOfSight los_data(catalogue_data.pos_observer);
+      trv::RadialLineOfSight los_rand(catalogue_rand.pos_observer);
+
+      double alpha = catalogue_data.wtotal / catalogue_rand.wtotal;
+      double norm_factor =
+        trv::calc_powspec_normalisation_from_particles(catalogue_rand, alpha);
+
+      /// Each quantity is compared on its own scale, except for the
+      /// shot noise compared on the scale of the power spectrum.
+      std::vector< std::vector< std::complex<double> > > values = {
+        {norm_factor}
+      };
+      if (statistic == "powspec") {
+        trv::PowspecMeasurements meas = trv::compute_powspec(
+          catalogue_data, catalogue_rand, los_data, los_rand,
+          params, binning, norm_factor
+        );
+        values.emplace_back(meas.nmodes.begin(), meas.nmodes.end());
+        values.push_back(meas.pk_raw);
+        values.push_back(meas.pk_shot);
+      } else {
+        trv::TwoPCFMeasurements meas = trv::compute_corrfunc(
+          catalogue_data, catalogue_rand, los_data, los_rand,
+          params, binning, norm_factor
+        );
+        values.emplace_back(meas.npairs.begin(), meas.npairs.end());
+        values.push_back(meas.xi);
+      }
+
+      if (ipass == 0) {
+        values_ref = values;
+        for (const auto& values_qty : values) {
+          scales.push_back(max_abs(values_qty));
+        }
+        if (statistic == "powspec") {scales[3] = scales[2];}
+        continue;
+      }
+
+      char name[64];
+      std::snprintf(
+        name, sizeof(name), "%s (ELL = %d, pass %d)",
+        statistic.c_str(), ELL, ipass
+      );
+      for (std::size_t iqty = 0; iqty < values.size(); iqty++) {
+        nfailed += count_mismatches(
+          values[iqty], values_ref[iqty], scales[iqty], name
+        );
+      }
+
+      /// All entries are found in a restored cache without reloading
+      /// the random-source catalogue.
+      if (ipass == 2 && catalogue_rand.pdata != nullptr) {
+        std::fprintf(
+          stderr, "Random-source catalogue is reloaded for %s.\n", name
+        );
+        nfailed++;
+      }
+
+      cache_prefix = rand_cache->prefix;
+      mesh_key = trv::RandomMeshCache::get_mesh_key(params, catalogue_rand);
+
+      catalogue_rand.mesh_cache = nullptr;
+      delete rand_cache;
+    }
+
+    /// Remove the cache files.
+    for (int ell = 0; ell <= ELL; ell++) {
+      for (int m = - ell; m <= ell; m++) {
+        for (const char* type : {"ylm", "quad"}) {
+          char filepath[1024];
+          std::snprintf(
+            filepath, sizeof(filepath), "%s_%s_%s_l%d_m%d_task%d.mesh",
+            cache_prefix.c_str(), mesh_key.c_str(), type, ell, m,
+            trvs::currTask
+          );
+          std::remove(filepath);
+        }
+      }
+    }
+    std::remove((cache_prefix + ".summary").c_str());
+  }
+
+  return nfailed;
+}
+
+/**
+ * @brief Check that power spectrum wedges are consistent with the
+ *        monopole measured in the same pass.
+ *
+ * Wedges partition the modes of each wavenumber bin, so their
+ * mode-weighted average reproduces the monopole.
+ *
+ * @param meas Power spectrum monopole measurements.
+ * @param wedges Power spectrum wedge measurements.
+ * @param num_bins Number of wavenumber bins.
+ * @param num_mu_bins Number of wedge bins.
+ * @returns Number of failed checks.
+ */
+int check_wedges_against_monopole(
+  const trv::PowspecMeasurements& meas,
+  const trv::PowspecWedgeMeasurements& wedges,
+  int num_bins, int num_mu_bins
+) {
+  const int nbins = num_bins * num_mu_bins;
+  if (int(wedges.nmodes.size()) != nbins
+      || int(wedges.pk_raw.size()) != nbins) {
+    std::fprintf(stderr, "Mismatched number of wedge bins.\n");
+    return 1;
+  }
+
+  const double scale = max_abs(meas.pk_raw);
+
+  int nfailed = 0;
+  for (int ibin = 0; ibin < num_bins; ibin++) {
+    int nmodes = 0;
+    double keff = 0.;
+    std::complex<double> pk_raw = 0., pk_shot = 0.;
+    for (int imu = 0; imu < num_mu_bins; imu++) {
+      const int iwedge = ibin * num_mu_bins + imu;
+      const int nmodes_wedge = wedges.nmodes[iwedge];
+
+      nmodes += nmodes_wedge;
+      keff += nmodes_wedge * wedges.keff[iwedge];
+      pk_raw += double(nmodes_wedge) * wedges.pk_raw[iwedge];
+      pk_shot += double(nmodes_wedge) * wedges.pk_shot[iwedge];
+
+      if (nmodes_wedge > 0 && (
+        wedges.mueff[iwedge] < double(imu) / num_mu_bins - TOL
+        || wedges.mueff[iwedge] > double(imu + 1) / num_mu_bins + TOL
+      )) {
+        std::fprintf(stderr, "Wedge |mu| lies outside its bin.\n");
+        nfailed++;
+      }
+    }
+
+    if (nmodes != meas.nmodes[ibin]) {
+      std::fprintf(stderr, "Wedge mode counts do not sum up.\n");
+      nfailed++;
+      continue;
+    }
+    if (nmodes == 0) {continue;}
+
+    keff /= nmodes;
+    pk_raw /= double(nmodes);
+    pk_shot /= double(nmodes);
+
+    if (std::fabs(keff - meas.keff[ibin]) > TOL * meas.keff[ibin]
+        || std::abs(pk_raw - meas.pk_raw[ibin]) > TOL * scale
+        || std::abs(pk_shot - meas.pk_shot[ibin]) > TOL * scale) {
+      std::fprintf(
+        stderr, "Wedges do not average to the monopole in bin %d "
+        "(%d wedge bins).\n", ibin, num_mu_bins
+      );
+      nfailed++;
+    }
+  }
+
+  return nfailed;
+}
+
+/**
+ * @brief Check that power spectrum wedges in a periodic box are
+ *        consistent with the monopole measured in the same pass.
+ *
+ * @returns Number of failed checks.
+ */
+int test_powspec_wedges() {
+  int nfailed = 0;
+  for (int num_mu_bins : {1, 4}) {
+    trv::ParameterSet params = set_params("powspec", 0);
+    params.catalogue_type = "sim";
+    params.num_mu_bins = num_mu_bins;
+    params.validate();
+
+    trv::Binning binning(params);
+    binning.set_bins();
+
+    trv::ParticleCatalogue catalogue;
+    load_box_catalogue(catalogue, NDATA, 42);
+
+    double norm_factor = params.volume / std::pow(double(NDATA), 2);
+
+    trv::PowspecWedgeMeasurements wedges;
+    trv::PowspecMeasurements meas = trv::compute_powspec_in_gpp_box(
+      catalogue, params, binning, norm_factor, &wedges
+    );
+
+    nfailed += check_wedges_against_monopole(
+      meas, wedges, params.num_bins, num_mu_bins
+    );
+  }
+
+  return nfailed;
+}
+
+/**
+ * @brief Check that power spectrum wedges from survey-type catalogues
+ *        with a global line of sight are consistent with the monopole
+ *        and binned with respect to the given axis.
+ *
+ * Swapping the x- and z-coordinates of the catalogues and the
+ * line-of-sight axis with them leaves the wedges unchanged.
+ *
+ * @returns Number of failed checks.
+ */
+int test_powspec_wedges_global_los() {
+  const int num_mu_bins = 4;
+
+  trv::ParameterSet params = set_params("powspec", 0);
+  params.num_mu_bins = num_mu_bins;
+  params.validate();
+
+  trv::Binning binning(params);
+  binning.set_bins();
+
+  int nfailed = 0;
+
+  trv::PowspecWedgeMeasurements wedges_axes[2];
+  for (int iaxis : {2, 0}) {
+    trv::ParticleCatalogue catalogue_data, catalogue_rand;
+    catalogue_data.load_catalogue_file(test_data_file, test_catalogue_columns);
+    catalogue_rand.load_catalogue_file(test_rand_file, test_catalogue_columns);
+
+    if (iaxis == 0) {
+      for (trv::ParticleCatalogue* catalogue : {
+        &catalogue_data, &catalogue_rand
+      }) {
+        for (int pid = 0; pid < catalogue->ntotal; pid++) {
+          std::swap(
+            catalogue->pdata[pid].pos[0], catalogue->pdata[pid].pos[2]
+          );
+        }
+        catalogue->calc_pos_min_and_max();
+      }
+    }
+
+    trv::ParticleCatalogue::centre_in_box(
+      catalogue_data, catalogue_rand, params.boxsize
+    );
+
+    double axis[3] = {0., 0., 0.};
+    axis[iaxis] = 1.;
+    trv::GlobalLineOfSight los(axis);
+
+    double alpha = catalogue_data.wtotal / catalogue_rand.wtotal;
+    double norm_factor =
+      trv::calc_powspec_normalisation_from_particles(catalogue_rand, alpha);
+
+    trv::PowspecWedgeMeasurements& wedges = wedges_axes[iaxis / 2];
+    trv::PowspecMeasurements meas = trv::compute_powspec(
+      catalogue_data, catalogue_rand, los, los,
+      params, binning, norm_factor, &wedges
+    );
+
+    nfailed += check_wedges_against_monopole(
+      meas, wedges, params.num_bins, num_mu_bins
+    );
+  }
+
+  const trv::PowspecWedgeMeasurements& wedges_z = wedges_axes[1];
+  const trv::PowspecWedgeMeasurements& wedges_x = wedges_axes[0];
+  if (wedges_x.nmodes != wedges_z.nmodes) {
+    std::fprintf(stderr, "Wedge mode counts depend on the axis.\n");
+    nfailed++;
+  } else {
+    double scale = max_abs(wedges_z.pk_raw);
+    nfailed += count_mismatches(
+      wedges_x.pk_raw, wedges_z.pk_raw, scale, "pkmu_raw"
+    );
+    nfailed += count_mismatches(
+      wedges_x.pk_shot, wedges_z.pk_shot, scale, "pkmu_shot"
+    );
+  }
+
+  /// Wedges are not defined with respect to radial lines of sight.
+  trv::ParticleCatalogue catalogue_data, catalogue_rand;
+  catalogue_data.load_catalogue_file(test_data_file, test_catalogue_columns);
+  catalogue_rand.load_catalogue_file(test_rand_file, test_catalogue_columns);
+  trv::ParticleCatalogue::centre_in_box(
+    catalogue_data, catalogue_rand, params.boxsize
+  );
+
+  trv::PowspecWedgeMeasurements wedges;
+  try {
+    trv::compute_powspec(
+      catalogue_data, catalogue_rand,
+      trv::RadialLineOfSight(catalogue_data.pos_observer),
+      trv::RadialLineOfSight(catalogue_rand.pos_observer),
+      params, binning, 1., &wedges
+    );
+    std::fprintf(stderr, "Wedges with radial lines of sight accepted.\n");
+    nfailed++;
+  } catch (const trvs::InvalidParameter&) {}
+
+  return nfailed;
+}
+
+/**
+ * @brief Check that subsampling Fourier-space modes at high wavenumbers
+ *        keeps mode counts exact and leaves lower bins unchanged.
+ *
+ * @returns Number of failed checks.
+ */
+int test_powspec_subsampling() {
+  trv::ParameterSet params = set_params("powspec", 0);
+  params.catalogue_type = "sim";
+  params.validate();
+
+  trv::Binning binning(params);
+  binning.set_bins();
+
+  trv::ParticleCatalogue catalogue;
+  load_box_catalogue(catalogue, NDATA, 42);
+
+  double norm_factor = params.volume / std::pow(double(NDATA), 2);
+
+  trv::PowspecMeasurements meas_ref = trv::compute_powspec_in_gpp_box(
+    catalogue, params, binning, norm_factor
+  );
+
+  const int ibin_sub = 2;  // first subsampled bin
+  const double scale = max_abs(meas_ref.pk_raw);
+
+  int nfailed = 0;
+  for (double frac : {1., 0.5}) {
+    trv::ParameterSet params_sub = params;
+    params_sub.subsample_kmin = binning.bin_edges[ibin_sub];
+    params_sub.subsample_frac = frac;
+    params_sub.validate();
+
+    trv::PowspecMeasurements meas = trv::compute_powspec_in_gpp_box(
+      catalogue, params_sub, binning, norm_factor
+    );
+
+    if (meas.nmodes != meas_ref.nmodes) {
+      std::fprintf(stderr, "Subsampled mode counts are not exact.\n");
+      nfailed++;
+    }
+
+    int nchanged = 0;
+    for (int ibin = 0; ibin < params.num_bins; ibin++) {
+      if (std::fabs(meas.keff[ibin] - meas_ref.keff[ibin])
+          > TOL * meas_ref.keff[ibin]) {
+        std::fprintf(stderr, "Subsampled effective wavenumber differs.\n");
+        nfailed++;
+      }
+
+      double diff = std::abs(meas.pk_raw[ibin] - meas_ref.pk_raw[ibin]);
+      if (ibin < ibin_sub || frac == 1.) {
+        /// Bins below the subsampling wavenumber, or with all modes
+        /// retained, are unchanged.
+        if (diff > TOL * scale) {
+          std::fprintf(
+            stderr, "Unsubsampled bin %d differs (fraction %g).\n",
+            ibin, frac
+          );
+          nfailed++;
+        }
+      } else {
+        /// Retained modes give an unbiased estimate of the bin average,
+        /// here bounded by three standard errors for exponentially
+        /// distributed mode powers, with Hermitian pairs counted once.
+        if (diff > TOL * scale) {nchanged++;}
+        double nmodes_indep = frac * meas_ref.nmodes[ibin] / 2.;
+        double sigma_rel = std::sqrt((1. - frac) / nmodes_indep);
+        if (diff > 3. * sigma_rel * std::abs(meas_ref.pk_raw[ibin])) {
+          std::fprintf(
+            stderr, "Subsampled bin %d is far off the full average.\n", ibin
+          );
+          nfailed++;
+        }
+      }
+    }
+
+    if (frac < 1. && nchanged == 0) {
+      std::fprintf(stderr, "Subsampling has no effect.\n");
+      nfailed++;
+    }
+  }
+
+  return nfailed;
+}
+
+/**
+ * @brief Check that mesh folding leaves bins below the stitching
+ *        wavenumber unchanged and restores the particle positions.
+ *
+ * Modes of the folded box are the modes of the unfolded box at
+ * multiples of the folding factor, so stitched bins sample the same
+ * shot-noise-dominated power with fewer modes.
+ *
+ * @returns Number of failed checks.
+ */
+int test_powspec_folding() {
+  trv::ParameterSet params = set_params("powspec", 0);
+  params.catalogue_type = "sim";
+  params.validate();
+
+  trv::Binning binning(params);
+  binning.set_bins();
+
+  trv::ParticleCatalogue catalogue;
+  load_box_catalogue(catalogue, NDATA, 42);
+
+  std::vector<double> pos_ref(3 * NDATA);
+  for (int pid = 0; pid < NDATA; pid++) {
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      pos_ref[3 * pid + iaxis] = catalogue.pdata[pid].pos[iaxis];
+    }
+  }
+
+  double norm_factor = params.volume / std::pow(double(NDATA), 2);
+
+  trv::PowspecMeasurements meas_ref = trv::compute_powspec_in_gpp_box(
+    catalogue, params, binning, norm_factor
+  );
+
+  const int ibin_stitch = 3;  // first stitched bin (with folded modes)
+  const double scale = max_abs(meas_ref.pk_raw);
+
+  int nfailed = 0;
+  for (int fold_factor : {1, 2}) {
+    trv::ParameterSet params_fold = params;
+    params_fold.fold_factor = fold_factor;
+    params_fold.fold_kstitch = binning.bin_edges[ibin_stitch];
+    params_fold.validate();
+
+    trv::PowspecMeasurements meas = trv::compute_powspec_in_gpp_box(
+      catalogue, params_fold, binning, norm_factor
+    );
+
+    int nmismatch = 0;
+    for (int pid = 0; pid < NDATA; pid++) {
+      for (int iaxis = 0; iaxis < 3; iaxis++) {
+        if (catalogue.pdata[pid].pos[iaxis] != pos_ref[3 * pid + iaxis]) {
+          nmismatch++;
+        }
+      }
+    }
+    if (nmismatch > 0) {
+      std::fprintf(stderr, "Folded particle positions are not restored.\n");
+      nfailed++;
+    }
+
+    for (int ibin = 0; ibin < params.num_bins; ibin++) {
+      double diff = std::abs(meas.pk_raw[ibin] - meas_ref.pk_raw[ibin]);
+      if (ibin < ibin_stitch || fold_factor == 1) {
+        if (meas.nmodes[ibin] != meas_ref.nmodes[ibin]
+            || meas.keff[ibin] != meas_ref.keff[ibin]
+            || diff > TOL * scale) {
+          std::fprintf(
+            stderr, "Unstitched bin %d differs (folding factor %d).\n",
+            ibin, fold_factor
+          );
+          nfailed++;
+        }
+        continue;
+      }
+
+      if (meas.nmodes[ibin] <= 0
+          || meas.nmodes[ibin] >= meas_ref.nmodes[ibin]) {
+        std::fprintf(
+          stderr, "Stitched bin %d has %d modes (unfolded: %d).\n",
+          ibin, meas.nmodes[ibin], meas_ref.nmodes[ibin]
+        );
+        nfailed++;
+        continue;
+      }
+      if (meas.keff[ibin] < binning.bin_edges[ibin]
+          || meas.keff[ibin] >= binning.bin_edges[ibin + 1]) {
+        std::fprintf(
+          stderr, "Stitched bin %d effective wavenumber is off-bin.\n", ibin
+        );
+        nfailed++;
+      }
+
+      /// Bound by three standard errors for exponentially distributed
+      /// mode powers, with Hermitian pairs counted once.
+      double sigma_rel = 1. / std::sqrt(meas.nmodes[ibin] / 2.);
+      if (diff > 3. * sigma_rel * std::abs(meas_ref.pk_raw[ibin])) {
+        std::fprintf(
+          stderr, "Stitched bin %d is far off the unfolded power.\n", ibin
+        );
+        nfailed++;
+      }
+    }
+  }
+
+  return nfailed;
+}
+
+int main() {
+  trvs::logger.reset_level(trvs::LogLevel::WARN);
+
+  write_test_catalogue(test_data_file, NDATA, 42);
+  write_test_catalogue(test_rand_file, NRAND, 43);
+
+  int nfailed = 0;
+  nfailed += test_streamed_randoms();
+  nfailed += test_random_mesh_cache();
+  nfailed += test_powspec_wedges();
+  nfailed += test_powspec_wedges_global_los();
+  nfailed += test_powspec_subsampling();
+  nfailed += test_powspec_folding();
+
+  std::remove(test_data_file);
+  std::remove(test_rand_file);
+
+  if (nfailed > 0) {
+    std::fprintf(stderr, "Two-point measurement tests failed: %d.\n", nfailed);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,269 @@
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy as np
+import pytest
+import yaml
+
+try:
+    from triumvirate.catalogue import ParticleCatalogue
+    from triumvirate.parameters import ParameterSet
+    from triumvirate.twopt import (
+        compute_powspec,
+        compute_powspec_in_gpp_box,
+        compute_powspec_multipoles,
+        compute_powspec_multipoles_in_gpp_box,
+    )
+except (ImportError, ModuleNotFoundError):
+    import os, sys
+
+    # Add to Python search path.
+    sys.path.insert(0, os.path.join(
+        os.path.dirname(os.path.abspath(__file__)), ".."
+    ))
+    sys.path.insert(0, os.path.join(
+        os.path.dirname(os.path.abspath(__file__)), "../.."
+    ))
+
+    from triumvirate.catalogue import ParticleCatalogue
+    from triumvirate.parameters import ParameterSet
+    from triumvirate.twopt import (
+        compute_powspec,
+        compute_powspec_in_gpp_box,
+        compute_powspec_multipoles,
+        compute_powspec_multipoles_in_gpp_box,
+    )
+
+
+BOXSIZE = 1000.
+NGRID = 32
+NDATA = 3000
+NRAND = 6000
+
+
+def _make_paramset(**params):
+    with open("triumvirate/tests/test_input/params/test_params.yml") as f:
+        param_dict = yaml.load(f, Loader=yaml.Loader)
+    param_dict.update({
+        'boxsize': {'x': BOXSIZE, 'y': BOXSIZE, 'z': BOXSIZE},
+        'ngrid': {'x': NGRID, 'y': NGRID, 'z': NGRID},
+        'assignment': 'cic',
+        'catalogue_type': 'survey',
+        'statistic_type': 'powspec',
+        'degrees': {'ell1': 0, 'ell2': 0, 'ELL': 2},
+        'range': [0.01, 0.09],
+        'num_bins': 4,
+        'verbose': 60,
+    })
+    param_dict.update(params)
+    return ParameterSet(param_dict=param_dict)
+
+
+def _make_catalogues(seed=42):
+    # Place survey-like catalogues in a cube away from the observer
+    # at the origin, so that lines of sight vary across the survey.
+    rng = np.random.default_rng(seed)
+
+    catalogues = []
+    for num in (NDATA, NRAND):
+        x, y, z = rng.uniform(400., 1200., size=(3, num))
+        catalogues.append(ParticleCatalogue(
+            x, y, z, nz=num/800.**3, ws=rng.uniform(0.5, 1.5, size=num)
+        ))
+
+    return catalogues
+
+
+def _assert_measurements_match(results, results_ref, msg):
+    for key in ('nmodes', 'keff', 'pk_raw', 'pk_shot'):
+        assert np.allclose(results[key], results_ref[key], rtol=1.e-10), \
+            f"{msg} ('{key}')"
+
+
+def test_radial_los_on_the_fly():
+
+    paramset = _make_paramset()
+
+    # Lines of sight stored before the catalogues are aligned in the box.
+    catalogue_data, catalogue_rand = _make_catalogues()
+    results_ref = compute_powspec(
+        catalogue_data, catalogue_rand,
+        los_data=catalogue_data.compute_los(),
+        los_rand=catalogue_rand.compute_los(),
+        paramset=paramset
+    )
+
+    # Lines of sight evaluated on the fly from the tracked observer.
+    catalogue_data, catalogue_rand = _make_catalogues()
+    results = compute_powspec(
+        catalogue_data, catalogue_rand, paramset=paramset
+    )
+
+    assert not np.allclose(results['pk_raw'], 0.)
+    _assert_measurements_match(
+        results, results_ref,
+        "Radial lines of sight on the fly differ from stored ones!"
+    )
+
+
+def test_global_los():
+
+    paramset = _make_paramset()
+    axis = np.array([0., 0., 1.])
+
+    catalogue_data, catalogue_rand = _make_catalogues()
+    results_ref = compute_powspec(
+        catalogue_data, catalogue_rand,
+        los_data=np.tile(axis, (NDATA, 1)),
+        los_rand=np.tile(axis, (NRAND, 1)),
+        paramset=paramset
+    )
+
+    catalogue_data, catalogue_rand = _make_catalogues()
+    results = compute_powspec(
+        catalogue_data, catalogue_rand,
+        los_data=axis, los_rand=axis, paramset=paramset
+    )
+
+    _assert_measurements_match(
+        results, results_ref,
+        "Global line of sight differs from stored ones!"
+    )
+
+    # Lines of sight must be specified consistently.
+    catalogue_data, catalogue_rand = _make_catalogues()
+    with pytest.raises(ValueError):
+        compute_powspec(
+            catalogue_data, catalogue_rand,
+            los_data=axis, los_rand=np.tile(axis, (NRAND, 1)),
+            paramset=paramset
+        )
+
+
+def test_powspec_wedges_global_los():
+
+    num_mu_bins = 4
+    paramset = _make_paramset(
+        degrees={'ell1': 0, 'ell2': 0, 'ELL': 0}, num_mu_bins=num_mu_bins
+    )
+    axis = np.array([0., 0., 1.])
+
+    catalogue_data, catalogue_rand = _make_catalogues()
+    results = compute_powspec(
+        catalogue_data, catalogue_rand,
+        los_data=axis, los_rand=axis, paramset=paramset
+    )
+
+    # Wedges partition the modes of each wavenumber bin, so their
+    # mode-weighted average reproduces the monopole.
+    wedges = results['wedges']
+    nmodes = wedges['nmodes'].reshape(-1, num_mu_bins)
+    assert np.array_equal(nmodes.sum(axis=1), results['nmodes'])
+    for key in ('keff', 'pk_raw', 'pk_shot'):
+        wedges_avg = np.sum(
+            nmodes * wedges[key].reshape(-1, num_mu_bins), axis=1
+        ) / nmodes.sum(axis=1)
+        assert np.allclose(
+            wedges_avg, results[key], rtol=1.e-10,
+            atol=1.e-10*np.max(np.abs(results['pk_raw']))
+        ), f"Wedges do not average to the monopole ('{key}')!"
+
+    # Wedges are not measured with radial lines of sight.
+    catalogue_data, catalogue_rand = _make_catalogues()
+    results = compute_powspec(
+        catalogue_data, catalogue_rand, paramset=paramset
+    )
+    assert 'wedges' not in results
+
+
+def test_powspec_multipoles():
+
+    paramset = _make_paramset()
+    degrees = [0, 2, 4]
+
+    catalogue_data, catalogue_rand = _make_catalogues()
+    results = compute_powspec_multipoles(
+        catalogue_data, catalogue_rand, degrees, paramset=paramset
+    )
+
+    assert sorted(results) == degrees
+    for ELL in degrees:
+        catalogue_data, catalogue_rand = _make_catalogues()
+        results_ref = compute_powspec(
+            catalogue_data, catalogue_rand,
+            paramset=_make_paramset(degrees={'ell1': 0, 'ell2': 0, 'ELL': ELL})
+        )
+        _assert_measurements_match(
+            results[ELL], results_ref,
+            f"Multipole {ELL} from shared FFTs differs from single one!"
+        )
+
+    # Multipole degrees must be non-negative.
+    catalogue_data, catalogue_rand = _make_catalogues()
+    with pytest.raises(ValueError):
+        compute_powspec_multipoles(
+            catalogue_data, catalogue_rand, [0, -2], paramset=paramset
+        )
+
+
+def test_powspec_multipoles_in_gpp_box():
+
+    paramset = _make_paramset(catalogue_type='sim', range=[0.01, 0.2])
+    degrees = [0, 2, 4]
+
+    catalogue_data, _ = _make_catalogues()
+    catalogue_data.periodise([BOXSIZE,] * 3)
+    results = compute_powspec_multipoles_in_gpp_box(
+        catalogue_data, degrees, paramset=paramset
+    )
+
+    assert sorted(results) == degrees
+    for ELL in degrees:
+        results_ref = compute_powspec_in_gpp_box(
+            catalogue_data,
+            paramset=_make_paramset(
+                catalogue_type='sim', range=[0.01, 0.2],
+                degrees={'ell1': 0, 'ell2': 0, 'ELL': ELL}
+            )
+        )
+        _assert_measurements_match(
+            results[ELL], results_ref,
+            f"Box multipole {ELL} from one FFT differs from single one!"
+        )
+
+
+def test_concurrent_measurements():
+
+    # Jobs mix catalogue types and multipole degrees, so that any
+    # state shared between concurrent measurements would be exposed.
+    jobs = [
+        ('survey', ELL, seed) for ELL in (0, 2) for seed in (42, 43)
+    ] + [
+        ('sim', ELL, 42) for ELL in (0, 2)
+    ]
+
+    def measure(catalogue_type, ELL, seed):
+        catalogue_data, catalogue_rand = _make_catalogues(seed)
+        paramset = _make_paramset(
+            catalogue_type=catalogue_type, range=[0.01, 0.2],
+            degrees={'ell1': 0, 'ell2': 0, 'ELL': ELL}
+        )
+        if catalogue_type == 'sim':
+            catalogue_data.periodise([BOXSIZE,] * 3)
+            return compute_powspec_in_gpp_box(
+                catalogue_data, paramset=paramset
+            )
+        return compute_powspec(
+            catalogue_data, catalogue_rand, paramset=paramset
+        )
+
+    results_ref = [measure(*job) for job in jobs]
+
+    with ThreadPoolExecutor(max_workers=len(jobs)) as executor:
+        futures = [executor.submit(measure, *job) for job in jobs]
+        results = [future.result() for future in futures]
+
+    for job, results_job, results_job_ref in zip(jobs, results, results_ref):
+        _assert_measurements_match(
+            results_job, results_job_ref,
+            f"Concurrent measurement {job} differs from sequential one!"
+        )
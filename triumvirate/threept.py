@@ -336,14 +336,18 @@ def _compute_3pt_stats_survey_like(threept_algofunc,
         Data-source catalogue.
     catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
         Random-source catalogue.
-    los_data : (N, 3) array of float, optional
-        Specified lines of sight for the data-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
-    los_rand : (N, 3) array of float, optional
-        Specified lines of sight for the random-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
+    los_data : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the data-source catalogue, either
+        per particle or as a fixed global axis.  If `None` (default),
+        lines of sight are radial from the observer and evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
+    los_rand : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the random-source catalogue, either
+        per particle or as a fixed global axis.  If `None` (default),
+        lines of sight are radial from the observer and evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
     paramset : :class:`~triumvirate.parameters.ParameterSet`, optional
         Full parameter set.  If `None` (default), `degrees`, `binning`,
         `form` and `params_sampling` should be provided; `idx_bin`
@@ -415,13 +419,13 @@ def _compute_3pt_stats_survey_like(threept_algofunc,
         logger.info("Binning has been initialised.")
 
     # Set up lines of sight.
-    if los_data is None:
-        los_data = catalogue_data.compute_los()
-    if los_rand is None:
-        los_rand = catalogue_rand.compute_los()
-
-    los_data = np.ascontiguousarray(los_data)
-    los_rand = np.ascontiguousarray(los_rand)
+    # If neither is specified, lines of sight are evaluated on the fly
+    # without being stored.
+    if los_data is not None or los_rand is not None:
+        if los_data is None:
+            los_data = catalogue_data.compute_los()
+        if los_rand is None:
+            los_rand = catalogue_rand.compute_los()
 
     if logger:
         logger.info("Lines of sight have been initialised.")
@@ -556,14 +560,18 @@ def compute_bispec(catalogue_data, catalogue_rand,
         Data-source catalogue.
     catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
         Random-source catalogue.
-    los_data : (N, 3) array of float, optional
-        Specified lines of sight for the data-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
-    los_rand : (N, 3) array of float, optional
-        Specified lines of sight for the random-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
+    los_data : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the data-source catalogue, either
+        per particle or as a fixed global axis.  If `None` (default),
+        lines of sight are radial from the observer and evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
+    los_rand : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the random-source catalogue, either
+        per particle or as a fixed global axis.  If `None` (default),
+        lines of sight are radial from the observer and evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
     degrees : tuple of int or str of length 3, optional
         Multipole degrees either as a tuple ('ell1', 'ell2', 'ELL') or
         as a string of length 3.  If not `None` (default), this will
@@ -646,14 +654,18 @@ def compute_3pcf(catalogue_data, catalogue_rand,
         Data-source catalogue.
     catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
         Random-source catalogue.
-    los_data : (N, 3) array of float, optional
-        Specified lines of sight for the data-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
-    los_rand : (N, 3) array of float, optional
-        Specified lines of sight for the random-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
+    los_data : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the data-source catalogue, either
+        per particle or as a fixed global axis.  If `None` (default),
+        lines of sight are radial from the observer and evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
+    los_rand : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the random-source catalogue, either
+        per particle or as a fixed global axis.  If `None` (default),
+        lines of sight are radial from the observer and evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
     degrees : tuple of int or str of length 3, optional
         Multipole degrees either as a tuple ('ell1', 'ell2', 'ELL') or
         as a string of length 3.  If not `None` (default), this will
@@ -1315,10 +1327,12 @@ def compute_3pcf_window(catalogue_rand, los_rand=None,
     ----------
     catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
         Random-source catalogue.
-    los_rand : (N, 3) array of float, optional
-        Specified lines of sight for the random-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
+    los_rand : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the random-source catalogue, either
+        per particle or as a fixed global axis.  If `None` (default),
+        lines of sight are radial from the observer and evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
     degrees : tuple of int or str of length 3, optional
         Multipole degrees either as a tuple ('ell1', 'ell2', 'ELL') or
         as a string of length 3.  If not `None` (default), this will
@@ -1397,14 +1411,6 @@ def compute_3pcf_window(catalogue_rand, los_rand=None,
     if logger:
         logger.info("Binning has been initialised.")
 
-    # Set up lines of sight.
-    if los_rand is None:
-        los_rand = catalogue_rand.compute_los()
-    los_rand = np.ascontiguousarray(los_rand)
-
-    if logger:
-        logger.info("Lines of sight have been initialised.")
-
     # Set up box alignment.
     catalogue_rand.centre(
         [paramset['boxsize'][axis] for axis in ['x', 'y', 'z']]
@@ -18,6 +18,8 @@ from triumvirate._twopt import (
     _compute_corrfunc_window,
     _compute_powspec,
     _compute_powspec_in_gpp_box,
+    _compute_powspec_multipoles,
+    _compute_powspec_multipoles_in_gpp_box,
 )
 from triumvirate.dataobjs import Binning
 from triumvirate.parameters import (
@@ -101,13 +103,16 @@ def _amalgamate_parameters(paramset=None, params_sampling=None, degree=None):
     return paramset
 
 
-def _get_measurement_filename(paramset):
+def _get_measurement_filename(paramset, wedges=False):
     """Get output measurement filename.
 
     Parameters
     ----------
     paramset : :class:`~triumvirate.parameters.ParameterSet`
         Parameter set.
+    wedges : bool, optional
+        If `True` (default is `False`), get the filename for power
+        spectrum wedge measurements.
 
     Returns
     -------
@@ -127,6 +132,8 @@ def _get_measurement_filename(paramset):
     if output_tag is None:
         output_tag = ""
 
+    if paramset['statistic_type'] == 'powspec' and wedges:
+        return "pkmu{}".format(output_tag)
     if paramset['statistic_type'] == 'powspec':
         return "pk{:d}{}".format(multipole, output_tag)
     if paramset['statistic_type'] == '2pcf':
@@ -140,7 +147,8 @@ def _get_measurement_filename(paramset):
     )
 
 
-def _print_measurement_header(paramset, norm_factor, norm_factor_alt):
+def _print_measurement_header(paramset, norm_factor, norm_factor_alt,
+                              wedges=False):
     """Print two-point statistic measurement header including
     sampling parameters, normalisation factors and data table columns.
 
@@ -150,6 +158,9 @@ def _print_measurement_header(paramset, norm_factor, norm_factor_alt):
         Parameter set.
     norm_factor, norm_factor_alt : double
         Normalisation factor used and the alternative.
+    wedges : bool, optional
+        If `True` (default is `False`), print the header for power
+        spectrum wedge measurements.
 
     Returns
     -------
@@ -175,7 +186,12 @@ def _print_measurement_header(paramset, norm_factor, norm_factor_alt):
         "`paramset` 'statistic_type' does not correspond to a "
         "recognised two-point statistic."
         )
-    if paramset['space'] == 'fourier':
+    if paramset['space'] == 'fourier' and wedges:
+        datatab_colnames = [
+            "k_cen", "mu_cen", "k_eff", "mu_eff", "nmodes",
+            "Re{pkmu_raw}", "Im{pkmu_raw}", "Re{pkmu_shot}", "Im{pkmu_shot}"
+        ]
+    elif paramset['space'] == 'fourier':
         datatab_colnames = [
             "k_cen", "k_eff", "nmodes",
             "Re{{pk{:d}_raw}}".format(paramset['degrees']['ELL']),
@@ -218,7 +234,7 @@ def _print_measurement_header(paramset, norm_factor, norm_factor_alt):
     return text_header
 
 
-def _assemble_measurement_datatab(measurements, paramset):
+def _assemble_measurement_datatab(measurements, paramset, wedges=False):
     """Assemble measurement data table.
 
     Parameters
@@ -227,6 +243,9 @@ def _assemble_measurement_datatab(measurements, paramset):
         Measurement results.
     paramset : :class:`~triumvirate.parameters.ParameterSet`
         Parameter set.
+    wedges : bool, optional
+        If `True` (default is `False`), `measurements` are power
+        spectrum wedge measurements.
 
     Returns
     -------
@@ -244,7 +263,15 @@ def _assemble_measurement_datatab(measurements, paramset):
         raise ValueError(
             "Measurement header being printed is for two-point statistics."
         )
-    if paramset['space'] == 'fourier':
+    if paramset['space'] == 'fourier' and wedges:
+        datatab = np.transpose([
+            measurements['kbin'], measurements['mubin'],
+            measurements['keff'], measurements['mueff'],
+            measurements['nmodes'],
+            measurements['pk_raw'].real, measurements['pk_raw'].imag,
+            measurements['pk_shot'].real, measurements['pk_shot'].imag,
+        ])
+    elif paramset['space'] == 'fourier':
         datatab = np.transpose([
             measurements['kbin'], measurements['keff'], measurements['nmodes'],
             measurements['pk_raw'].real, measurements['pk_raw'].imag,
@@ -259,6 +286,104 @@ def _assemble_measurement_datatab(measurements, paramset):
     return datatab
 
 
+def _save_measurements(results, paramset, catalogue_header,
+                       norm_factor, norm_factor_alt, save,
+                       degrees=None, wedges=False, logger=None):
+    """Save two-point statistic measurements.
+
+    Any power spectrum wedge measurements under the key 'wedges' are
+    saved to a separate file.
+
+    Parameters
+    ----------
+    results : dict
+        Measurement results, or a dictionary of measurement results
+        keyed by multipole degree if `degrees` is not `None`.
+    paramset : :class:`~triumvirate.parameters.ParameterSet`
+        Parameter set.
+    catalogue_header : str
+        Catalogue attributes as a header string.
+    norm_factor, norm_factor_alt : double
+        Normalisation factor used and the alternative.
+    save : {'.txt', '.npz'}
+        Save the measurements as a '.txt' file or in '.npz' format.
+    degrees : list of int, optional
+        Multipole degrees, one file being saved for each (default is
+        `None`, in which case `paramset['degrees']['ELL']` is used).
+    wedges : bool, optional
+        If `True` (default is `False`), `results` are power spectrum
+        wedge measurements.
+    logger : :class:`logging.Logger`, optional
+        Logger (default is `None`).
+
+    Raises
+    ------
+    ValueError
+        When `save` is not a recognised format.
+
+    """
+    if degrees is not None:
+        ELL = paramset['degrees']['ELL']
+        for ell in degrees:
+            paramset['degrees']['ELL'] = ell
+            _save_measurements(
+                results[ell], paramset, catalogue_header,
+                norm_factor, norm_factor_alt, save, logger=logger
+            )
+        paramset['degrees']['ELL'] = ELL
+        if 'wedges' in results:
+            _save_measurements(
+                results['wedges'], paramset, catalogue_header,
+                norm_factor, norm_factor_alt, save, wedges=True, logger=logger
+            )
+        return
+
+    if not wedges and 'wedges' in results:
+        results = dict(results)
+        _save_measurements(
+            results.pop('wedges'), paramset, catalogue_header,
+            norm_factor, norm_factor_alt, save, wedges=True, logger=logger
+        )
+
+    header = "\n".join([
+        catalogue_header,
+        _print_measurement_header(
+            paramset, norm_factor, norm_factor_alt, wedges=wedges
+        ),
+    ])
+
+    if save.lower() == '.txt':
+        datatab = _assemble_measurement_datatab(
+            results, paramset, wedges=wedges
+        )
+        ncols_float = 4 if wedges else 2
+        datafmt = '\t'.join(
+            ['%.9e'] * ncols_float + ['%10d']
+            + ['% .9e'] * (datatab.shape[-1] - ncols_float - 1)
+        )
+        ofilename = _get_measurement_filename(paramset, wedges=wedges)
+        ofilepath = Path(
+            paramset['directories']['measurements'], ofilename
+        ).with_suffix('.txt')
+        np.savetxt(
+            ofilepath, datatab, fmt=datafmt, header=header, delimiter='\t'
+        )
+    elif save.lower().endswith('.npz'):
+        results.update({'header': header})
+        ofilename = _get_measurement_filename(paramset, wedges=wedges)
+        ofilepath = Path(
+            paramset['directories']['measurements'], ofilename
+        ).with_suffix('.npz')
+        np.savez(ofilepath, **results)
+    else:
+        raise ValueError(
+            f"Unrecognised save format for measurements: {save}."
+        )
+
+    if logger:
+        logger.info("Measurements saved to %s.", ofilepath)
+
+
 # ========================================================================
 # Survey statistics
 # ========================================================================
@@ -268,7 +393,7 @@ def _compute_2pt_stats_survey_like(twopt_algofunc,
                                    los_data=None, los_rand=None,
                                    paramset=None, params_sampling=None,
                                    degree=None, binning=None,
-                                   save=False, logger=None):
+                                   save=False, logger=None, degrees=None):
     """Compute two-point statistics from survey-like data and random
     catalogues in the local plane-parallel approximation.
 
@@ -280,14 +405,18 @@ def _compute_2pt_stats_survey_like(twopt_algofunc,
         Data-source catalogue.
     catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
         Random-source catalogue.
-    los_data : (N, 3) array of float, optional
-        Specified lines of sight for the data-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
-    los_rand : (N, 3) array of float, optional
-        Specified lines of sight for the random-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
+    los_data : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the data-source catalogue, either
+        per particle or as a fixed global axis.  If `None` (default),
+        lines of sight are radial from the observer and evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
+    los_rand : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the random-source catalogue, either
+        per particle or as a fixed global axis.  If `None` (default),
+        lines of sight are radial from the observer and evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
     paramset : :class:`~triumvirate.parameters.ParameterSet`, optional
         Full parameter set.  If `None` (default), `degree`, `binning`
         and `params_sampling` must be provided.
@@ -316,11 +445,15 @@ def _compute_2pt_stats_survey_like(twopt_algofunc,
         or in '.npz' format.
     logger : :class:`logging.Logger`, optional
         Logger (default is `None`).
+    degrees : list of int, optional
+        Multipole degrees measured together.  If not `None` (default),
+        `twopt_algofunc` takes these degrees and `degree` is ignored.
 
     Returns
     -------
     results : dict of {str: :class:`numpy.ndarray`}
-        Measurement results.
+        Measurement results, or a dictionary of these keyed by
+        multipole degree if `degrees` is not `None`.
 
     Raises
     ------
@@ -335,6 +468,10 @@ def _compute_2pt_stats_survey_like(twopt_algofunc,
 
     # -- Parameters ------------------------------------------------------
 
+    if degrees is not None:
+        degrees = list(degrees)
+        degree = degrees[0]
+
     paramset = _amalgamate_parameters(
         paramset=paramset, params_sampling=params_sampling, degree=degree
     )
@@ -355,13 +492,13 @@ def _compute_2pt_stats_survey_like(twopt_algofunc,
         logger.info("Binning has been initialised.")
 
     # Set up lines of sight.
-    if los_data is None:
-        los_data = catalogue_data.compute_los()
-    if los_rand is None:
-        los_rand = catalogue_rand.compute_los()
-
-    los_data = np.ascontiguousarray(los_data)
-    los_rand = np.ascontiguousarray(los_rand)
+    # If neither is specified, lines of sight are evaluated on the fly
+    # without being stored.
+    if los_data is not None or los_rand is not None:
+        if los_data is None:
+            los_data = catalogue_data.compute_los()
+        if los_rand is None:
+            los_rand = catalogue_rand.compute_los()
 
     if logger:
         logger.info("Lines of sight have been initialised.")
@@ -438,45 +575,28 @@ def _compute_2pt_stats_survey_like(twopt_algofunc,
     if logger:
         logger.info("Measuring clustering statistics...", cpp_state='start')
 
-    results = twopt_algofunc(
-        particles_data, particles_rand, los_data, los_rand,
-        paramset, binning, norm_factor
-    )
+    if degrees is None:
+        results = twopt_algofunc(
+            particles_data, particles_rand, los_data, los_rand,
+            paramset, binning, norm_factor
+        )
+    else:
+        results = twopt_algofunc(
+            particles_data, particles_rand, los_data, los_rand,
+            paramset, degrees, binning, norm_factor
+        )
 
     if logger:
         logger.info("... measured clustering statistics.", cpp_state='end')
 
     if save:
-        header = "\n".join([
-            catalogue_data.write_attrs_as_header(catalogue_ref=catalogue_rand),
-            _print_measurement_header(paramset, norm_factor, norm_factor_alt),
-        ])
-        if save.lower() == '.txt':
-            datatab = _assemble_measurement_datatab(results, paramset)
-            datafmt = '\t'.join(
-                ['%.9e'] * 2 + ['%10d'] + ['% .9e'] * (datatab.shape[-1] - 3)
-            )
-            ofilename = _get_measurement_filename(paramset)
-            ofilepath = Path(
-                paramset['directories']['measurements'], ofilename
-            ).with_suffix('.txt')
-            np.savetxt(
-                ofilepath, datatab, fmt=datafmt, header=header, delimiter='\t'
-            )
-        elif save.lower().endswith('.npz'):
-            results.update({'header': header})
-            ofilename = _get_measurement_filename(paramset)
-            ofilepath = Path(
-                paramset['directories']['measurements'], ofilename
-            ).with_suffix('.npz')
-            np.savez(ofilepath, **results)
-        else:
-            raise ValueError(
-                f"Unrecognised save format for measurements: {save}."
-            )
-
-        if logger:
-            logger.info("Measurements saved to %s.", ofilepath)
+        catalogue_header = catalogue_data.write_attrs_as_header(
+            catalogue_ref=catalogue_rand
+        )
+        _save_measurements(
+            results, paramset, catalogue_header, norm_factor, norm_factor_alt,
+            save, degrees=degrees, logger=logger
+        )
 
     return results
 
@@ -495,14 +615,18 @@ def compute_powspec(catalogue_data, catalogue_rand,
         Data-source catalogue.
     catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
         Random-source catalogue.
-    los_data : (N, 3) array of float, optional
-        Specified lines of sight for the data-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
-    los_rand : (N, 3) array of float, optional
-        Specified lines of sight for the random-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
+    los_data : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the data-source catalogue, either
+        per particle or as a fixed global axis.  If `None` (default),
+        lines of sight are radial from the observer and evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
+    los_rand : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the random-source catalogue, either
+        per particle or as a fixed global axis.  If `None` (default),
+        lines of sight are radial from the observer and evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
     degree : int, optional
         Multipole degree.  If not `None` (default), this will override
         `paramset['degrees']['ELL']`.
@@ -536,6 +660,10 @@ def compute_powspec(catalogue_data, catalogue_rand,
     -------
     results : dict of {str: :class:`numpy.ndarray`}
         Measurement results.
+        If `paramset['num_mu_bins']` is positive and the lines of sight
+        are a fixed global axis, power spectrum wedges in (k, |μ|) bins
+        with respect to the axis are also returned under the key
+        'wedges'.
 
     Raises
     ------
@@ -568,6 +696,89 @@ def compute_powspec(catalogue_data, catalogue_rand,
     return results
 
 
+def compute_powspec_multipoles(catalogue_data, catalogue_rand,
+                               degrees, los_data=None, los_rand=None,
+                               binning=None, sampling_params=None,
+                               paramset=None,
+                               save=False, logger=None):
+    """Compute multiple power spectrum multipoles together from
+    survey-like data and random catalogues in the local plane-parallel
+    approximation.
+
+    The monopole field is shared and each spherical-harmonic-weighted
+    field is transformed only once, which is cheaper than calling
+    :func:`~triumvirate.twopt.compute_powspec` for each degree.
+
+    Parameters
+    ----------
+    catalogue_data : :class:`~triumvirate.catalogue.ParticleCatalogue`
+        Data-source catalogue.
+    catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
+        Random-source catalogue.
+    degrees : list of int
+        Multipole degrees.
+    los_data : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the data-source catalogue, either
+        per particle or as a fixed global axis.  If `None` (default),
+        lines of sight are radial from the observer and evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
+    los_rand : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the random-source catalogue, either
+        per particle or as a fixed global axis.  If `None` (default),
+        lines of sight are radial from the observer and evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
+    binning : :class:`~triumvirate.dataobjs.Binning`, optional
+        Binning for the measurements.  If `None` (default), this is
+        constructed from `paramset`.
+    sampling_params : dict, optional
+        Dictionary containing a subset of the following entries
+        for sampling parameters:
+            * 'boxalign': {'centre', 'pad'};
+            * 'boxsize': [float, float, float];
+            * 'ngrid': [int, int, int];
+            * 'assignment': {'ngp', 'cic', 'tsc', 'pcs'};
+            * 'interlace': bool;
+
+        and one and only one of the following when 'boxalign' is 'pad':
+            * 'boxpad': float;
+            * 'gridpad': float.
+
+        This will override corresponding entries in `paramset`.
+    paramset : :class:`~triumvirate.parameters.ParameterSet`, optional
+        Full parameter set (default is `None`).  This is used in lieu of
+        `binning` or `sampling_params`.
+    save : {'.txt', '.npz', False}, optional
+        If not `False` (default), save the measurements of each
+        multipole as a '.txt' file or in '.npz' format.
+    logger : :class:`logging.Logger`, optional
+        Logger (default is `None`).
+
+    Returns
+    -------
+    results : dict of {int: dict of {str: :class:`numpy.ndarray`}}
+        Measurement results keyed by multipole degree.
+
+    Raises
+    ------
+    ValueError
+        When `paramset` is `None` but `binning` or `sampling_params`
+        is also `None`.
+
+    """
+    results = _compute_2pt_stats_survey_like(
+        _compute_powspec_multipoles,
+        catalogue_data, catalogue_rand,
+        los_data=los_data, los_rand=los_rand,
+        paramset=paramset, params_sampling=sampling_params,
+        binning=binning, degrees=degrees,
+        save=save, logger=logger
+    )
+
+    return results
+
+
 def compute_corrfunc(catalogue_data, catalogue_rand,
                      los_data=None, los_rand=None,
                      degree=None, binning=None, sampling_params=None,
@@ -582,14 +793,18 @@ def compute_corrfunc(catalogue_data, catalogue_rand,
         Data-source catalogue.
     catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
         Random-source catalogue.
-    los_data : (N, 3) array of float, optional
-        Specified lines of sight for the data-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
-    los_rand : (N, 3) array of float, optional
-        Specified lines of sight for the random-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
+    los_data : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the data-source catalogue, either
+        per particle or as a fixed global axis.  If `None` (default),
+        lines of sight are radial from the observer and evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
+    los_rand : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the random-source catalogue, either
+        per particle or as a fixed global axis.  If `None` (default),
+        lines of sight are radial from the observer and evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
     degree : int, optional
         Multipole degree.  If not `None` (default), this will override
         `paramset['degrees']['ELL']`.
@@ -664,7 +879,7 @@ def compute_corrfunc(catalogue_data, catalogue_rand,
 def _compute_2pt_stats_sim_like(twopt_algofunc, catalogue_data,
                                 paramset=None, params_sampling=None,
                                 degree=None, binning=None,
-                                save=False, logger=None):
+                                save=False, logger=None, degrees=None):
     """Compute two-point statistics from a simulation-box catalogue
     in the global plane-parallel approximation.
 
@@ -702,11 +917,15 @@ def _compute_2pt_stats_sim_like(twopt_algofunc, catalogue_data,
         as a '.txt' file or in '.npz' format.
     logger : :class:`logging.Logger`, optional
         Logger (default is `None`).
+    degrees : list of int, optional
+        Multipole degrees measured together.  If not `None` (default),
+        `twopt_algofunc` takes these degrees and `degree` is ignored.
 
     Returns
     -------
     results : dict of {str: :class:`numpy.ndarray`}
-        Measurement results.
+        Measurement results, or a dictionary of these keyed by
+        multipole degree if `degrees` is not `None`.
 
     Raises
     ------
@@ -721,6 +940,10 @@ def _compute_2pt_stats_sim_like(twopt_algofunc, catalogue_data,
 
     # -- Parameters ------------------------------------------------------
 
+    if degrees is not None:
+        degrees = list(degrees)
+        degree = degrees[0]
+
     paramset = _amalgamate_parameters(
         paramset=paramset, params_sampling=params_sampling, degree=degree
     )
@@ -802,42 +1025,24 @@ def _compute_2pt_stats_sim_like(twopt_algofunc, catalogue_data,
     if logger:
         logger.info("Measuring clustering statistics...", cpp_state='start')
 
-    results = twopt_algofunc(particles_data, paramset, binning, norm_factor)
+    if degrees is None:
+        results = twopt_algofunc(
+            particles_data, paramset, binning, norm_factor
+        )
+    else:
+        results = twopt_algofunc(
+            particles_data, paramset, degrees, binning, norm_factor
+        )
 
     if logger:
         logger.info("... measured clustering statistics.", cpp_state='end')
 
     if save:
-        header = "\n".join([
-            catalogue_data.write_attrs_as_header(),
-            _print_measurement_header(paramset, norm_factor, norm_factor_alt),
-        ])
-        if save.lower() == '.txt':
-            datatab = _assemble_measurement_datatab(results, paramset)
-            datafmt = '\t'.join(
-                ['%.9e'] * 2 + ['%10d'] + ['% .9e'] * (datatab.shape[-1] - 3)
-            )
-            ofilename = _get_measurement_filename(paramset)
-            ofilepath = Path(
-                paramset['directories']['measurements'], ofilename
-            ).with_suffix('.txt')
-            np.savetxt(
-                ofilepath, datatab, fmt=datafmt, header=header, delimiter='\t'
-            )
-        elif save.lower().endswith('.npz'):
-            results.update({'header': header})
-            ofilename = _get_measurement_filename(paramset)
-            ofilepath = Path(
-                paramset['directories']['measurements'], ofilename
-            ).with_suffix('.npz')
-            np.savez(ofilepath, **results)
-        else:
-            raise ValueError(
-                f"Unrecognised save format for measurements: {save}."
-            )
-
-        if logger:
-            logger.info("Measurements saved to %s.", ofilepath)
+        catalogue_header = catalogue_data.write_attrs_as_header()
+        _save_measurements(
+            results, paramset, catalogue_header, norm_factor, norm_factor_alt,
+            save, degrees=degrees, logger=logger
+        )
 
     return results
 
@@ -886,6 +1091,9 @@ def compute_powspec_in_gpp_box(catalogue_data,
     -------
     results : dict of {str: :class:`numpy.ndarray`}
         Measurement results.
+        If `paramset['num_mu_bins']` is positive, power spectrum wedges
+        in (k, |μ|) bins with respect to the z-axis are also returned
+        under the key 'wedges'.
 
     Raises
     ------
@@ -918,6 +1126,73 @@ def compute_powspec_in_gpp_box(catalogue_data,
     return results
 
 
+def compute_powspec_multipoles_in_gpp_box(catalogue_data, degrees,
+                                          binning=None, sampling_params=None,
+                                          paramset=None,
+                                          save=False, logger=None):
+    """Compute multiple power spectrum multipoles together from
+    a simulation-box catalogue in the global plane-parallel approximation.
+
+    All multipoles are binned from the same transformed field, which is
+    cheaper than calling
+    :func:`~triumvirate.twopt.compute_powspec_in_gpp_box` for each degree.
+
+    Parameters
+    ----------
+    catalogue_data : :class:`~triumvirate.catalogue.ParticleCatalogue`
+        Data-source catalogue.
+    degrees : list of int
+        Multipole degrees.
+    binning : :class:`~triumvirate.dataobjs.Binning`, optional
+        Binning for the measurements.  If `None` (default), this is
+        constructed from `paramset`.
+    sampling_params : dict, optional
+        Dictionary containing a subset of the following entries
+        for sampling parameters:
+            * 'boxalign': {'centre', 'pad'};
+            * 'boxsize': [float, float, float];
+            * 'ngrid': [int, int, int];
+            * 'assignment': {'ngp', 'cic', 'tsc', 'pcs'};
+            * 'interlace': bool;
+
+        and one and only one of the following when 'boxalign' is 'pad':
+            * 'boxpad': float;
+            * 'gridpad': float.
+
+        This will override corresponding entries in `paramset`.
+    paramset : :class:`~triumvirate.parameters.ParameterSet`, optional
+        Full parameter set (default is `None`).  This is used in lieu of
+        `binning` or `sampling_params`.
+    save : {'.txt', '.npz', False}, optional
+        If not `False` (default), save the measurements of each
+        multipole as a '.txt' file or in '.npz' format.
+    logger : :class:`logging.Logger`, optional
+        Logger (default is `None`).
+
+    Returns
+    -------
+    results : dict of {int: dict of {str: :class:`numpy.ndarray`}}
+        Measurement results keyed by multipole degree.
+        If `paramset['num_mu_bins']` is positive, power spectrum wedges
+        are also returned under the key 'wedges'.
+
+    Raises
+    ------
+    ValueError
+        When `paramset` is `None` but `binning` or `sampling_params`
+        is also `None`.
+
+    """
+    results = _compute_2pt_stats_sim_like(
+        _compute_powspec_multipoles_in_gpp_box, catalogue_data,
+        paramset=paramset, params_sampling=sampling_params,
+        binning=binning, degrees=degrees,
+        save=save, logger=logger
+    )
+
+    return results
+
+
 def compute_corrfunc_in_gpp_box(catalogue_data,
                                 degree=None, binning=None, sampling_params=None,
                                 paramset=None,
@@ -1010,10 +1285,12 @@ def compute_corrfunc_window(catalogue_rand, los_rand=None,
     ----------
     catalogue_rand : :class:`~triumvirate.catalogue.ParticleCatalogue`
         Random-source catalogue.
-    los_rand : (N, 3) array of float, optional
-        Specified lines of sight for the random-source catalogue.
-        If `None` (default), this is automatically computed using
-        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`.
+    los_rand : (N, 3) or (3,) array of float, optional
+        Specified lines of sight for the random-source catalogue, either
+        per particle or as a fixed global axis.  If `None` (default),
+        lines of sight are radial from the observer and evaluated on
+        the fly (as in
+        :meth:`~triumvirate.catalogue.ParticleCatalogue.compute_los`).
     degree : int, optional
         Multipole degree.  If not `None` (default), this will override
         `paramset['degrees']['ELL']`.
@@ -1080,14 +1357,6 @@ def compute_corrfunc_window(catalogue_rand, los_rand=None,
     if logger:
         logger.info("Binning has been initialised.")
 
-    # Set up lines of sight.
-    if los_rand is None:
-        los_rand = catalogue_rand.compute_los()
-    los_rand = np.ascontiguousarray(los_rand)
-
-    if logger:
-        logger.info("Lines of sight have been initialised.")
-
     # Set up box alignment.
     catalogue_rand.centre(
         [paramset['boxsize'][axis] for axis in ['x', 'y', 'z']]